@@ -98,6 +98,11 @@
  */
 #define mqttconfigRX_BUFFER_SIZE               ( 1024 + 128 )
 
+/**
+ * @brief Length of the buffer used to queue data the socket cannot accept yet.
+ */
+#define mqttconfigTX_BUFFER_SIZE               ( 1024 )
+
 /**
  * @brief The maximum time in ticks for which the MQTT task is permitted to block.
  */
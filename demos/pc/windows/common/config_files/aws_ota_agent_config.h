@@ -71,4 +71,20 @@
  */
 #define otaconfigMAX_THINGNAME_LEN              64U
 
+/**
+ * @brief Include the file blocks in the signature check as they are received.
+ *
+ * The signature check then only has to be finished when the last block is received
+ * instead of reading the whole file back from the file system.
+ */
+#define otaconfigINCREMENTAL_SIGNATURE_CHECK    1
+
+/**
+ * @brief The maximum number of file blocks requested but not received yet.
+ *
+ * The file blocks are requested in a sliding window which adapts to the rate at which
+ * the blocks arrive, up to this number of blocks.
+ */
+#define otaconfigREQUEST_WINDOW_MAX_BLOCKS      32U
+
 #endif /* _AWS_OTA_AGENT_CONFIG_H_ */
@@ -150,6 +150,35 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#endif
 #endif
 
+/* When set to 1, the TCP sliding window keeps a congestion window (RFC 5681)
+which limits the outstanding data besides the peer's window.  It starts small,
+grows with slow start and congestion avoidance, and shrinks when a segment is
+lost, after which the window recovers as in NewReno (RFC 6582).  How far the
+window shrinks and how it grows in congestion avoidance is decided by a
+congestion control algorithm, which can be chosen for every socket with the
+FREERTOS_SO_TCP_CONGESTION option. */
+#ifndef ipconfigUSE_TCP_CONGESTION_CONTROL
+	#define ipconfigUSE_TCP_CONGESTION_CONTROL	0
+#endif
+
+/* The congestion control algorithm of new TCP sockets:
+0 - NewReno (RFC 6582), FREERTOS_TCP_CONGESTION_NEWRENO.
+1 - CUBIC (RFC 8312), FREERTOS_TCP_CONGESTION_CUBIC. */
+#ifndef ipconfigTCP_CONGESTION_CONTROL
+	#define ipconfigTCP_CONGESTION_CONTROL		0
+#endif
+
+/* The maximum number of blocks, 1 to 4, in the Selective ACK (SACK) option
+that is sent when data arrives out of order.  The first block reports the
+range of data that holds the segment which has just arrived, the others
+repeat the ranges that were reported most recently (RFC 2018), so that the
+peer learns about more than one missing range.  Every block above the first
+one adds 8 bytes to the space reserved for TCP options in every socket and
+network buffer. */
+#ifndef ipconfigTCP_SACK_BLOCKS
+	#define ipconfigTCP_SACK_BLOCKS				1
+#endif
+
 /*
  * For debuging/logging: check if the port number is used for telnet
  * Some events will not be logged for telnet connections
@@ -301,6 +330,41 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#define ipconfigEVENT_QUEUE_LENGTH		( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 )
 #endif
 
+/* The maximum number of events the IP-task reads from the network event queue
+at once.  Reading a batch of events costs a single access to the queue, the
+events are still processed one by one and in order. */
+#ifndef ipconfigEVENT_BATCH_LENGTH
+	#define ipconfigEVENT_BATCH_LENGTH		8
+#endif
+
+/* When set to 1, xSendNetworkBufferToIPTask() passes received frames to the
+IP-task through a lock-free SPSC ring instead of the network event queue.  Only
+a single task or interrupt of the network interface may then call
+xSendNetworkBufferToIPTask(). */
+#ifndef ipconfigUSE_NETWORK_RX_RING
+	#define ipconfigUSE_NETWORK_RX_RING		0
+#endif
+
+/* The number of received frames the SPSC ring can hold. */
+#ifndef ipconfigNETWORK_RX_RING_LENGTH
+	#define ipconfigNETWORK_RX_RING_LENGTH	ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS
+#endif
+
+/* When set to 1, bound sockets are also kept in hash tables, so the socket a
+received packet is for is found without searching through all the bound
+sockets.  TCP sockets are hashed on their local port, remote IP address and
+remote port, except listening TCP sockets, which have a table of their own and
+are hashed on their local port like UDP sockets are. */
+#ifndef ipconfigUSE_SOCKET_HASH
+	#define ipconfigUSE_SOCKET_HASH			0
+#endif
+
+/* The number of buckets of each socket hash table, which must be a power of
+2. */
+#ifndef ipconfigSOCKET_HASH_BUCKETS
+	#define ipconfigSOCKET_HASH_BUCKETS		32
+#endif
+
 #ifndef ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND
 	#define ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND 1
 #endif
@@ -495,6 +559,25 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#define ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM 0
 #endif
 
+/* Selects the routine that adds up the 32-bit words of the data in
+usGenerateChecksum() and usGenerateChecksumCopy():
+0 - A 32-bit sum which counts the carries, suitable for any 32-bit CPU.
+1 - A 64-bit sum which needs no carry counting, for CPUs with 64-bit integers.
+2 - SSE2 or NEON when the compiler targets them, otherwise the same as 1.
+3 - ulChecksumWords() and ulChecksumCopyWords() are supplied by the port. */
+#ifndef ipconfigCHECKSUM_BACKEND
+	#define ipconfigCHECKSUM_BACKEND		0
+#endif
+
+/* When set to 1, the payload of a TCP packet is checksummed while it is copied
+from the txStream into the packet, and while it is copied from the packet into
+the rxStream, so that each byte of the payload is read once only.  The copy
+into the rxStream is only combined with the checksum for payload that arrives
+in order. */
+#ifndef ipconfigUSE_CHECKSUM_COPY
+	#define ipconfigUSE_CHECKSUM_COPY		0
+#endif
+
 #ifndef ipconfigDHCP_REGISTER_HOSTNAME
 	#define ipconfigDHCP_REGISTER_HOSTNAME 0
 #endif
@@ -254,6 +254,7 @@ typedef enum
 	eSocketCloseEvent,		/* 9: Send a message to the IP-task to close a socket. */
 	eSocketSelectEvent,		/*10: Send a message to the IP-task for select(). */
 	eSocketSignalEvent,		/*11: A socket must be signalled. */
+	eNetworkRxRingEvent,	/*12: The network interface has sent received Ethernet frames to the SPSC ring. */
 } eIPEvent_t;
 
 typedef struct IP_TASK_COMMANDS
@@ -435,6 +436,23 @@ eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucE
  */
 uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t * pucNextData, size_t uxDataLengthBytes );
 
+/*
+ * Copy uxDataLengthBytes from pucSource to pucTarget, and return the same
+ * checksum as usGenerateChecksum() would return for pucSource.  The pointers do
+ * not need to be aligned.
+ */
+uint16_t usGenerateChecksumCopy( uint32_t ulSum, uint8_t * pucTarget, const uint8_t * pucSource, size_t uxDataLengthBytes );
+
+/*
+ * The checksum backend, see ipconfigCHECKSUM_BACKEND.  Add uxWords 32-bit words
+ * to the one's complement sum ulSum, and return the sum folded to 16 bits.  The
+ * words are added as they are stored in memory, i.e. the sum is in the native
+ * byte order.  ulChecksumCopyWords() also copies the words from pucSource to
+ * pucTarget, which do not need to be aligned.
+ */
+uint32_t ulChecksumWords( uint32_t ulSum, const uint32_t * pulWords, size_t uxWords );
+uint32_t ulChecksumCopyWords( uint32_t ulSum, uint8_t * pucTarget, const uint8_t * pucSource, size_t uxWords );
+
 /* Socket related private functions. */
 
 /* 
@@ -524,6 +542,10 @@ BaseType_t xIPIsNetworkTaskReady( void );
 				#if( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
 					bConnPassed : 1,	/* Connecting socket: Socket has been passed in a successful select()  */
 				#endif /* ipconfigSUPPORT_SELECT_FUNCTION */
+				#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+					bRxStaged : 1,		/* The payload of the packet being processed has been copied to rxStream at uxHead */
+					bTxSummed : 1,		/* usTxSum holds the checksum of the payload copied by prvTCPPrepareSend() */
+				#endif /* ipconfigUSE_CHECKSUM_COPY */
 				bFinAccepted : 1,	/* This socket has received (or sent) a FIN and accepted it */
 				bFinSent : 1,		/* We've sent out a FIN */
 				bFinRecv : 1,		/* We've received a FIN from our peer */
@@ -540,6 +562,10 @@ BaseType_t xIPIsNetworkTaskReady( void );
 		uint16_t usInitMSS;		/* Initial maximum segment Size */
 		uint16_t usChildCount;	/* In case of a listening socket: number of connections on this port number */
 		uint16_t usBacklog;		/* In case of a listening socket: maximum number of concurrent connections on this port number */
+		#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+			uint16_t usTxSum;		/* Checksum of the payload copied by prvTCPPrepareSend() */
+			uint16_t usTxSumLength;	/* Number of bytes of that payload */
+		#endif /* ipconfigUSE_CHECKSUM_COPY */
 		uint8_t ucRepCount;		/* Send repeat count, for retransmissions
 								 * This counter is separate from the xmitCount in the
 								 * TCP win segments */
@@ -580,6 +606,9 @@ BaseType_t xIPIsNetworkTaskReady( void );
 		uint32_t ulRxCurWinSize;	/* Constantly changing: this is the current size available for data reception */
 		size_t uxRxWinSize;	/* Fixed value: size of the TCP reception window */
 		size_t uxTxWinSize;	/* Fixed value: size of the TCP transmit window */
+		#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			uint8_t ucCongestionControl;	/* The congestion control algorithm, FREERTOS_TCP_CONGESTION_xxx */
+		#endif
 
 		TCPWindow_t xTCPWindow;
 	} IPTCPSocket_t;
@@ -618,6 +647,9 @@ typedef struct XSOCKET
 	EventGroupHandle_t xEventGroup;
 
 	ListItem_t xBoundSocketListItem; /* Used to reference the socket from a bound sockets list. */
+	#if( ipconfigUSE_SOCKET_HASH == 1 )
+		ListItem_t xHashListItem; /* Used to reference the socket from a socket hash table. */
+	#endif /* ipconfigUSE_SOCKET_HASH */
 	TickType_t xReceiveBlockTime; /* if recv[to] is called while no data is available, wait this amount of time. Unit in clock-ticks */
 	TickType_t xSendBlockTime; /* if send[to] is called while there is not enough space to send, wait this amount of time. Unit in clock-ticks */
 
@@ -664,6 +696,18 @@ typedef struct XSOCKET
 
 #endif /* ipconfigUSE_TCP */
 
+#if( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH == 1 ) )
+	/*
+	 * Move a bound TCP socket to the hash table and bucket that match its
+	 * current state, local port, remote IP address and remote port.  Must be
+	 * called after any of them changes, which vTCPStateChange() does.  When
+	 * called from another task, the IP-task moves the socket before it looks
+	 * up a socket again.
+	 */
+	void vSocketHashUpdate( FreeRTOS_Socket_t *pxSocket );
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH == 1 ) */
+
 /*
  * Look up a local socket by finding a match with the local port.
  */
@@ -683,6 +727,20 @@ void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuff
  */
 uint16_t usGenerateProtocolChecksum( const uint8_t * const pucEthernetBuffer, size_t uxBufferLength, BaseType_t xOutgoingPacket );
 
+/* Returned to indicate a valid checksum when the checksum does not need to be
+calculated. */
+#define ipCORRECT_CRC				0xffffu
+
+#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+	/*
+	 * As usGenerateProtocolChecksum(), for a packet of which the last
+	 * uxPresummedLength bytes have already been added up by
+	 * usGenerateChecksumCopy(), with the result usPresummedChecksum.
+	 */
+	uint16_t usGenerateProtocolChecksumPartial( const uint8_t * const pucEthernetBuffer, size_t uxBufferLength, BaseType_t xOutgoingPacket,
+		size_t uxPresummedLength, uint16_t usPresummedChecksum );
+#endif /* ipconfigUSE_CHECKSUM_COPY */
+
 /*
  * An Ethernet frame has been updated (maybe it was an ARP request or a PING
  * request?) and is to be sent back to its source.
@@ -755,6 +813,16 @@ BaseType_t xSendEventToIPTask( eIPEvent_t eEvent );
  */
 BaseType_t xSendEventStructToIPTask( const IPStackEvent_t *pxEvent, TickType_t xTimeout );
 
+/*
+ * Passes a received Ethernet frame to the IP-task, through the SPSC ring if
+ * ipconfigUSE_NETWORK_RX_RING is set to 1, otherwise as an eNetworkRxEvent.
+ * xTimeout is the time to wait for space in the network event queue, sending to
+ * the ring never blocks.  Returns pdFAIL if the frame could not be passed, in
+ * which case the caller still owns the network buffer.  The ring has a single
+ * producer, so only one task of the network interface may call this function.
+ */
+BaseType_t xSendNetworkBufferToIPTask( NetworkBufferDescriptor_t * const pxNetworkBuffer, TickType_t xTimeout );
+
 /*
  * Returns a pointer to the original NetworkBuffer from a pointer to a UDP
  * payload buffer.
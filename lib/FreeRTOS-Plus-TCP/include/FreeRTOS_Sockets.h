@@ -130,6 +130,14 @@ FreeRTOS_setsockopt(). */
 	#define FREERTOS_SO_WAKEUP_CALLBACK	( 17 )
 #endif
 
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	#define FREERTOS_SO_TCP_CONGESTION	( 18 )		/* Select the congestion control algorithm of a TCP socket, parameter is pointer to BaseType_t */
+#endif
+
+/* Values for the FREERTOS_SO_TCP_CONGESTION option. */
+#define FREERTOS_TCP_CONGESTION_NEWRENO	( 0 )		/* NewReno (RFC 6582) */
+#define FREERTOS_TCP_CONGESTION_CUBIC	( 1 )		/* CUBIC (RFC 8312) */
+
 
 #define FREERTOS_NOT_LAST_IN_FRAGMENTED_PACKET 	( 0x80 )  /* For internal use only, but also part of an 8-bit bitwise value. */
 #define FREERTOS_FRAGMENTED_PACKET				( 0x40 )  /* For internal use only, but also part of an 8-bit bitwise value. */
@@ -249,6 +249,33 @@ size_t uxStreamBufferAdd( StreamBuffer_t *pxBuffer, size_t uxOffset, const uint8
  */
 size_t uxStreamBufferGet( StreamBuffer_t *pxBuffer, size_t uxOffset, uint8_t *pucData, size_t uxMaxCount, BaseType_t xPeek );
 
+#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+	/*
+	 * Copy bytes to the position of uxHead, without moving any of the markers,
+	 * and return the checksum of the bytes as usGenerateChecksum() would.  The
+	 * bytes can be added later by calling uxStreamBufferAdd() with pucData
+	 * equal to NULL.
+	 *
+	 * pxBuffer -	The buffer to which the bytes will be copied.
+	 * pucData -	A pointer to the data to be copied.
+	 * uxCount -	The number of bytes to copy.
+	 * pusChecksum - Receives the checksum of the bytes copied.
+	 */
+	size_t uxStreamBufferStage( StreamBuffer_t *pxBuffer, const uint8_t *pucData, size_t uxCount, uint16_t *pusChecksum );
+
+	/*
+	 * As uxStreamBufferGet() with xPeek set to pdTRUE, and return the checksum
+	 * of the bytes read as usGenerateChecksum() would.
+	 *
+	 * pxBuffer -	The buffer from which the bytes will be read.
+	 * uxOffset -	Can be used to read data located at a certain offset from 'uxTail'.
+	 * pucData -	A pointer to the buffer into which data will be read.
+	 * uxMaxCount -	The number of bytes to read.
+	 * pusChecksum - Receives the checksum of the bytes read.
+	 */
+	size_t uxStreamBufferPeekChecksum( StreamBuffer_t *pxBuffer, size_t uxOffset, uint8_t *pucData, size_t uxMaxCount, uint16_t *pusChecksum );
+#endif /* ipconfigUSE_CHECKSUM_COPY */
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
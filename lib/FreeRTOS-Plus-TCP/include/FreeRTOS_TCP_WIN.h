@@ -55,16 +55,19 @@ typedef struct xTCP_SEGMENT
 		{
 			uint32_t
 				ucTransmitCount : 8,/* Number of times the segment has been transmitted, used to calculate the RTT */
-				ucDupAckCount : 8,	/* Counts the number of times that a higher segment was ACK'd. After 3 times a Fast Retransmission takes place */
+				ucDupAckCount : 8,	/* Counts the SACK'd segments that were sent after this one. At 3 a Fast Retransmission takes place */
 				bOutstanding : 1,	/* It the peer's turn, we're just waiting for an ACK */
 				bAcked : 1,			/* This segment has been acknowledged */
-				bIsForRx : 1;		/* pdTRUE if segment is used for reception */
+				bIsForRx : 1,		/* pdTRUE if segment is used for reception */
+				ucRxHeight : 8;		/* RX only: height of the segment in the tree of received ranges, a leaf has height 1 */
 		} bits;
 		uint32_t ulFlags;
 	} u;
 #if( ipconfigUSE_TCP_WIN != 0 )
 	struct xLIST_ITEM xQueueItem;	/* TX only: segments can be linked in one of three queues: xPriorityQueue, xTxQueue, and xWaitQueue */
 	struct xLIST_ITEM xListItem;	/* With this item the segment can be connected to a list, depending on who is owning it */
+	struct xTCP_SEGMENT *pxRxLeft;	/* RX only: the subtree of received ranges with lower sequence numbers */
+	struct xTCP_SEGMENT *pxRxRight;	/* RX only: the subtree of received ranges with higher sequence numbers */
 #endif
 } TCPSegment_t;
 
@@ -80,11 +83,38 @@ typedef struct xTCP_WINSIZE
  */
 /* Keep this as a multiple of 4 */
 #if( ipconfigUSE_TCP_WIN == 1 )
-	#define ipSIZE_TCP_OPTIONS	16u
+	#if( ipconfigTCP_SACK_BLOCKS < 1 ) || ( ipconfigTCP_SACK_BLOCKS > 4 )
+		#error ipconfigTCP_SACK_BLOCKS must be between 1 and 4
+	#endif
+	#if( ipconfigTCP_SACK_BLOCKS > 1 )
+		/* Two NOP's, the SACK code and length, and 8 bytes for every block. */
+		#define ipSIZE_TCP_OPTIONS	( 4u + ( 8u * ipconfigTCP_SACK_BLOCKS ) )
+	#else
+		#define ipSIZE_TCP_OPTIONS	16u
+	#endif
 #else
 	#define ipSIZE_TCP_OPTIONS   12u
 #endif
 
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+struct xTCP_WINDOW;
+
+/*
+ * A congestion control algorithm.  The sliding window itself does slow start
+ * and fast recovery, the algorithm decides how far the congestion window is
+ * reduced when a segment is lost, and how it grows in congestion avoidance.
+ */
+typedef struct xTCP_CONGESTION_CONTROL
+{
+	BaseType_t xAlgorithm;				/* One of the FREERTOS_TCP_CONGESTION_xxx values */
+	void ( *pxInit )( struct xTCP_WINDOW *pxWindow );	/* Clears the state of the algorithm */
+	uint32_t ( *pxSlowStartThreshold )( struct xTCP_WINDOW *pxWindow );	/* Returns the new slow start threshold after a loss */
+	void ( *pxCongestionAvoidance )( struct xTCP_WINDOW *pxWindow, uint32_t ulAckedBytes, uint32_t ulTimeMS );	/* Grows the congestion window when data is acknowledged */
+} TCPCongestionControl_t;
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 /*
  *	Every TCP connection owns a TCP window for the administration of all packets
  *	It owns two sets of segment descriptors, incoming and outgoing
@@ -98,7 +128,9 @@ typedef struct xTCP_WINDOW
 			uint32_t
 				bHasInit : 1,		/* The window structure has been initialised */
 				bSendFullSize : 1,	/* May only send packets with a size equal to MSS (for optimisation) */
-				bTimeStamps : 1;	/* Socket is supposed to use TCP time-stamps. This depends on the */
+				bTimeStamps : 1,	/* Socket is supposed to use TCP time-stamps. This depends on the */
+				bFastRecovery : 1,	/* A lost segment has been retransmitted and the congestion window is inflated */
+				bWindowProbe : 1;	/* The peer's window is closed while data waits to be sent, it is being probed */
 		} bits;						/* party which opens the connection */
 		uint32_t ulFlags;
 	} u;
@@ -126,6 +158,27 @@ typedef struct xTCP_WINDOW
 	uint32_t ulOptionsData[ipSIZE_TCP_OPTIONS/sizeof(uint32_t)];	/* Contains the options we send out */
 	List_t xTxSegments;					/* A linked list of all transmission segments, sorted on sequence number */
 	List_t xRxSegments;					/* A linked list of reception segments, order depends on sequence of arrival */
+	TCPSegment_t *pxRxRoot;				/* Root of an AVL tree of the reception segments, sorted on sequence number.  Each segment describes a range of data that has been received */
+	uint32_t ulSackHistory[ ipconfigTCP_SACK_BLOCKS ];	/* Sequence numbers within the ranges reported in the last SACK, the most recent one first */
+	UBaseType_t uxSackHistoryCount;		/* Number of valid entries in ulSackHistory[] */
+	TCPTimer_t xProbeTimer;				/* Started when the peer's window closed, and restarted at every window probe */
+	uint8_t ucProbeCount;				/* Number of window probes sent since the peer's window closed */
+	#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+		const TCPCongestionControl_t *pxCongestionControl;	/* The congestion control algorithm in use */
+		uint32_t ulCongestionWindow;		/* cwnd: the number of bytes that may be outstanding */
+		uint32_t ulSlowStartThreshold;		/* ssthresh: below it, the congestion window grows with slow start */
+		uint32_t ulAckedBytes;				/* Bytes acknowledged in congestion avoidance that have not yet grown the window */
+		uint32_t ulRecoverSequenceNumber;	/* The highest sequence number sent when the last loss was detected */
+		struct
+		{
+			uint32_t ulMaxWindow;			/* W_max: the window when the last loss was detected */
+			uint32_t ulLastMaxWindow;		/* W_max of the loss before, for fast convergence */
+			uint32_t ulOriginWindow;		/* The window at the plateau of the cubic function */
+			uint32_t ulFriendlyWindow;		/* W_est: the window standard TCP would have */
+			uint32_t ulEpochStart;			/* Time in ms at which the current epoch started, 0 when there is none */
+			uint32_t ulPlateauTime;			/* K: time in ms from the start of the epoch to the plateau */
+		} xCubic;
+	#endif
 #else
 	/* For tiny TCP, there is only 1 outstanding TX segment */
 	TCPSegment_t xTxSegment;			/* Priority queue */
@@ -199,12 +252,22 @@ BaseType_t xTCPWindowTxDone( TCPWindow_t *pxWindow );
  * apPos will point to a location with the circular data buffer: txStream */
 uint32_t ulTCPWindowTxGet( TCPWindow_t *pxWindow, uint32_t ulWindowSize, int32_t *plPosition );
 
+/* See if the peer's closed window must be probed now, because a window
+ * update may have been lost.  Returns pdTRUE when a probe must be sent */
+BaseType_t xTCPWindowTxProbe( TCPWindow_t *pxWindow, uint32_t ulWindowSize );
+
 /* Receive a normal ACK */
 uint32_t ulTCPWindowTxAck( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber );
 
 /* Receive a SACK option */
 uint32_t ulTCPWindowTxSack( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast );
 
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	/* Select the congestion control algorithm, one of the
+	 * FREERTOS_TCP_CONGESTION_xxx values.  Returns pdFAIL if it is unknown. */
+	BaseType_t xTCPWindowSetCongestionControl( TCPWindow_t *pxWindow, BaseType_t xAlgorithm );
+#endif
+
 
 #ifdef __cplusplus
 }	/* extern "C" */
@@ -33,6 +33,7 @@
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "spsc_ring.h"
 
 /* FreeRTOS+TCP includes. */
 #include "FreeRTOS_IP.h"
@@ -46,6 +47,19 @@
 #include "NetworkBufferManagement.h"
 #include "FreeRTOS_DNS.h"
 
+/* The checksum backend 2 uses SSE2 or NEON when the compiler targets them. */
+#define ipCHECKSUM_SSE2		1
+#define ipCHECKSUM_NEON		2
+
+#if( ipconfigCHECKSUM_BACKEND == 2 ) && ( defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) )
+	#include <emmintrin.h>
+	#define ipCHECKSUM_SIMD		ipCHECKSUM_SSE2
+#elif( ipconfigCHECKSUM_BACKEND == 2 ) && ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) )
+	#include <arm_neon.h>
+	#define ipCHECKSUM_SIMD		ipCHECKSUM_NEON
+#else
+	#define ipCHECKSUM_SIMD		0
+#endif
 
 /* Used to ensure the structure packing is having the desired effect.  The
 'volatile' is used to prevent compiler warnings about comparing a constant with
@@ -131,10 +145,6 @@ per ms: */
 handled.  The value is chosen simply to be easy to spot when debugging. */
 #define ipUNHANDLED_PROTOCOL		0x4321u
 
-/* Returned to indicate a valid checksum when the checksum does not need to be
-calculated. */
-#define ipCORRECT_CRC				0xffffu
-
 /* Returned as the (invalid) checksum when the length of the data being checked
 had an invalid length. */
 #define ipINVALID_LENGTH			0x1234u
@@ -176,6 +186,26 @@ typedef union _xUnionPtr
  */
 static void prvIPTask( void *pvParameters );
 
+/*
+ * Handles a single event received by the IP-task on the network event queue.
+ */
+static void prvProcessIPEvent( const IPStackEvent_t *pxEvent );
+
+#if( ipconfigUSE_NETWORK_RX_RING != 0 )
+	/*
+	 * Called by the network interface when it sends a frame to the SPSC ring
+	 * while the IP-task waits for events.  Posts an eNetworkRxRingEvent to wake
+	 * the IP-task.
+	 */
+	static void prvNetworkRxRingWakeUp( SPSCRingHandle_t xRing, BaseType_t *pxHigherPriorityTaskWoken );
+
+	/*
+	 * Processes up to ipconfigEVENT_BATCH_LENGTH of the frames waiting in the
+	 * SPSC ring.
+	 */
+	static void prvProcessNetworkRxRing( void );
+#endif /* ipconfigUSE_NETWORK_RX_RING */
+
 /*
  * Called when new data is available from the network interface.
  */
@@ -242,11 +272,25 @@ static void prvIPTimerReload( IPTimer_t *pxTimer, TickType_t xTime );
 static eFrameProcessingResult_t prvAllowIPPacket( const IPPacket_t * const pxIPPacket,
 	NetworkBufferDescriptor_t * const pxNetworkBuffer, UBaseType_t uxHeaderLength );
 
+/*
+ * The body of usGenerateProtocolChecksum(), which can also add the checksum of
+ * the payload when it has already been calculated while the payload was
+ * copied.
+ */
+static uint16_t prvGenerateProtocolChecksum( const uint8_t * const pucEthernetBuffer, size_t uxBufferLength, BaseType_t xOutgoingPacket,
+	size_t uxPresummedLength, uint16_t usPresummedChecksum );
+
 /*-----------------------------------------------------------*/
 
 /* The queue used to pass events into the IP-task for processing. */
 QueueHandle_t xNetworkEventQueue = NULL;
 
+#if( ipconfigUSE_NETWORK_RX_RING != 0 )
+	/* The ring used to pass received frames from the network interface to the
+	IP-task. */
+	static SPSCRingHandle_t xNetworkRxRing = NULL;
+#endif
+
 /*_RB_ Requires comment. */
 uint16_t usPacketIdentifier = 0U;
 
@@ -313,10 +357,9 @@ static BaseType_t xIPTaskInitialised = pdFALSE;
 
 static void prvIPTask( void *pvParameters )
 {
-IPStackEvent_t xReceivedEvent;
+IPStackEvent_t xReceivedEvents[ ipconfigEVENT_BATCH_LENGTH ];
+UBaseType_t uxEventCount, x;
 TickType_t xNextIPSleep;
-FreeRTOS_Socket_t *pxSocket;
-struct freertos_sockaddr xAddress;
 
 	/* Just to prevent compiler warnings about unused parameters. */
 	( void ) pvParameters;
@@ -354,21 +397,37 @@ struct freertos_sockaddr xAddress;
 		/* Calculate the acceptable maximum sleep time. */
 		xNextIPSleep = prvCalculateSleepTime();
 
-		/* Wait until there is something to do. If the following call exits
-		 * due to a time out rather than a message being received, set a
-		 * 'NoEvent' value. */
-		if ( xQueueReceive( xNetworkEventQueue, ( void * ) &xReceivedEvent, xNextIPSleep ) == pdFALSE ) 
+		#if( ipconfigUSE_NETWORK_RX_RING != 0 )
+		{
+			/* Have the network interface post an eNetworkRxRingEvent for the
+			next frame it receives, unless frames are waiting already. */
+			if( xSPSCRingArmWakeUp( xNetworkRxRing ) == pdFALSE )
+			{
+				xNextIPSleep = ( TickType_t ) 0;
+			}
+		}
+		#endif /* ipconfigUSE_NETWORK_RX_RING */
+
+		/* Wait until there is something to do, then take all the events that
+		are waiting, up to ipconfigEVENT_BATCH_LENGTH, in a single access to
+		the queue.  If the following call exits due to a time out rather than
+		events being received, set a single 'NoEvent' value. */
+		uxEventCount = xQueueReceiveMultiple( xNetworkEventQueue, ( void * ) xReceivedEvents, ( UBaseType_t ) ipconfigEVENT_BATCH_LENGTH, xNextIPSleep );
+
+		if( uxEventCount == 0u )
 		{
-			xReceivedEvent.eEventType = eNoEvent;
+			xReceivedEvents[ 0 ].eEventType = eNoEvent;
+			uxEventCount = 1u;
 		}
 
 		#if( ipconfigCHECK_IP_QUEUE_SPACE != 0 )
 		{
-			if( xReceivedEvent.eEventType != eNoEvent )
+			if( xReceivedEvents[ 0 ].eEventType != eNoEvent )
 			{
 			UBaseType_t uxCount;
 
-				uxCount = uxQueueSpacesAvailable( xNetworkEventQueue );
+				/* The space is measured before the events were removed. */
+				uxCount = uxQueueSpacesAvailable( xNetworkEventQueue ) - uxEventCount;
 				if( uxQueueMinimumSpace > uxCount )
 				{
 					uxQueueMinimumSpace = uxCount;
@@ -377,142 +436,213 @@ struct freertos_sockaddr xAddress;
 		}
 		#endif /* ipconfigCHECK_IP_QUEUE_SPACE */
 
-		iptraceNETWORK_EVENT_RECEIVED( xReceivedEvent.eEventType );
+		for( x = 0u; x < uxEventCount; x++ )
+		{
+			iptraceNETWORK_EVENT_RECEIVED( xReceivedEvents[ x ].eEventType );
+			prvProcessIPEvent( &( xReceivedEvents[ x ] ) );
+		}
 
-		switch( xReceivedEvent.eEventType )
+		#if( ipconfigUSE_NETWORK_RX_RING != 0 )
 		{
-			case eNetworkDownEvent :
-				/* Attempt to establish a connection. */
-				xNetworkUp = pdFALSE;
-				prvProcessNetworkDownEvent();
-				break;
+			prvProcessNetworkRxRing();
+		}
+		#endif /* ipconfigUSE_NETWORK_RX_RING */
 
-			case eNetworkRxEvent:
-				/* The network hardware driver has received a new packet.  A
-				pointer to the received buffer is located in the pvData member
-				of the received event structure. */
-				prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) ( xReceivedEvent.pvData ) );
-				break;
+		if( xNetworkDownEventPending != pdFALSE )
+		{
+			/* A network down event could not be posted to the network event
+			queue because the queue was full.  Try posting again. */
+			FreeRTOS_NetworkDown();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
 
-			case eARPTimerEvent :
-				/* The ARP timer has expired, process the ARP cache. */
-				vARPAgeCache();
-				break;
+static void prvProcessIPEvent( const IPStackEvent_t *pxEvent )
+{
+FreeRTOS_Socket_t *pxSocket;
+struct freertos_sockaddr xAddress;
 
-			case eSocketBindEvent:
-				/* FreeRTOS_bind (a user API) wants the IP-task to bind a socket
-				to a port. The port number is communicated in the socket field
-				usLocalPort. vSocketBind() will actually bind the socket and the
-				API will unblock as soon as the eSOCKET_BOUND event is
-				triggered. */
-				pxSocket = ( FreeRTOS_Socket_t * ) ( xReceivedEvent.pvData );
-				xAddress.sin_addr = 0u;	/* For the moment. */
-				xAddress.sin_port = FreeRTOS_ntohs( pxSocket->usLocalPort );
-				pxSocket->usLocalPort = 0u;
-				vSocketBind( pxSocket, &xAddress, sizeof( xAddress ), pdFALSE );
-
-				/* Before 'eSocketBindEvent' was sent it was tested that
-				( xEventGroup != NULL ) so it can be used now to wake up the
-				user. */
-				pxSocket->xEventBits |= eSOCKET_BOUND;
-				vSocketWakeUpUser( pxSocket );
-				break;
+	switch( pxEvent->eEventType )
+	{
+		case eNetworkDownEvent :
+			/* Attempt to establish a connection. */
+			xNetworkUp = pdFALSE;
+			prvProcessNetworkDownEvent();
+			break;
 
-			case eSocketCloseEvent :
-				/* The user API FreeRTOS_closesocket() has sent a message to the
-				IP-task to actually close a socket. This is handled in
-				vSocketClose().  As the socket gets closed, there is no way to
-				report back to the API, so the API won't wait for the result */
-				vSocketClose( ( FreeRTOS_Socket_t * ) ( xReceivedEvent.pvData ) );
-				break;
+		case eNetworkRxEvent:
+			/* The network hardware driver has received a new packet.  A
+			pointer to the received buffer is located in the pvData member
+			of the received event structure. */
+			prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) ( pxEvent->pvData ) );
+			break;
 
-			case eStackTxEvent :
-				/* The network stack has generated a packet to send.  A
-				pointer to the generated buffer is located in the pvData
-				member of the received event structure. */
-				vProcessGeneratedUDPPacket( ( NetworkBufferDescriptor_t * ) ( xReceivedEvent.pvData ) );
-				break;
+		case eNetworkRxRingEvent:
+			/* The network hardware driver has sent received packets to the
+			SPSC ring.  They are processed by prvProcessNetworkRxRing() once the
+			events read in the same batch have been processed. */
+			break;
 
-			case eDHCPEvent:
-				/* The DHCP state machine needs processing. */
-				#if( ipconfigUSE_DHCP == 1 )
-				{
-					vDHCPProcess( pdFALSE );
-				}
-				#endif /* ipconfigUSE_DHCP */
-				break;
+		case eARPTimerEvent :
+			/* The ARP timer has expired, process the ARP cache. */
+			vARPAgeCache();
+			break;
 
-			case eSocketSelectEvent :
-				/* FreeRTOS_select() has got unblocked by a socket event,
-				vSocketSelect() will check which sockets actually have an event
-				and update the socket field xSocketBits. */
-				#if( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-				{
-					vSocketSelect( ( SocketSelect_t * ) ( xReceivedEvent.pvData ) );
-				}
-				#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
-				break;
+		case eSocketBindEvent:
+			/* FreeRTOS_bind (a user API) wants the IP-task to bind a socket
+			to a port. The port number is communicated in the socket field
+			usLocalPort. vSocketBind() will actually bind the socket and the
+			API will unblock as soon as the eSOCKET_BOUND event is
+			triggered. */
+			pxSocket = ( FreeRTOS_Socket_t * ) ( pxEvent->pvData );
+			xAddress.sin_addr = 0u;	/* For the moment. */
+			xAddress.sin_port = FreeRTOS_ntohs( pxSocket->usLocalPort );
+			pxSocket->usLocalPort = 0u;
+			vSocketBind( pxSocket, &xAddress, sizeof( xAddress ), pdFALSE );
+
+			/* Before 'eSocketBindEvent' was sent it was tested that
+			( xEventGroup != NULL ) so it can be used now to wake up the
+			user. */
+			pxSocket->xEventBits |= eSOCKET_BOUND;
+			vSocketWakeUpUser( pxSocket );
+			break;
 
-			case eSocketSignalEvent :
-				#if( ipconfigSUPPORT_SIGNALS != 0 )
-				{
-					/* Some task wants to signal the user of this socket in
-					order to interrupt a call to recv() or a call to select(). */
-					FreeRTOS_SignalSocket( ( Socket_t ) xReceivedEvent.pvData );
-				}
-				#endif /* ipconfigSUPPORT_SIGNALS */
-				break;
+		case eSocketCloseEvent :
+			/* The user API FreeRTOS_closesocket() has sent a message to the
+			IP-task to actually close a socket. This is handled in
+			vSocketClose().  As the socket gets closed, there is no way to
+			report back to the API, so the API won't wait for the result */
+			vSocketClose( ( FreeRTOS_Socket_t * ) ( pxEvent->pvData ) );
+			break;
 
-			case eTCPTimerEvent :
-				#if( ipconfigUSE_TCP == 1 )
-				{
-					/* Simply mark the TCP timer as expired so it gets processed
-					the next time prvCheckNetworkTimers() is called. */
-					xTCPTimer.bExpired = pdTRUE_UNSIGNED;
-				}
-				#endif /* ipconfigUSE_TCP */
-				break;
+		case eStackTxEvent :
+			/* The network stack has generated a packet to send.  A
+			pointer to the generated buffer is located in the pvData
+			member of the received event structure. */
+			vProcessGeneratedUDPPacket( ( NetworkBufferDescriptor_t * ) ( pxEvent->pvData ) );
+			break;
 
-			case eTCPAcceptEvent:
-				/* The API FreeRTOS_accept() was called, the IP-task will now
-				check if the listening socket (communicated in pvData) actually
-				received a new connection. */
-				#if( ipconfigUSE_TCP == 1 )
-				{
-					pxSocket = ( FreeRTOS_Socket_t * ) ( xReceivedEvent.pvData );
+		case eDHCPEvent:
+			/* The DHCP state machine needs processing. */
+			#if( ipconfigUSE_DHCP == 1 )
+			{
+				vDHCPProcess( pdFALSE );
+			}
+			#endif /* ipconfigUSE_DHCP */
+			break;
 
-					if( xTCPCheckNewClient( pxSocket ) != pdFALSE )
-					{
-						pxSocket->xEventBits |= eSOCKET_ACCEPT;
-						vSocketWakeUpUser( pxSocket );
-					}
-				}
-				#endif /* ipconfigUSE_TCP */
-				break;
+		case eSocketSelectEvent :
+			/* FreeRTOS_select() has got unblocked by a socket event,
+			vSocketSelect() will check which sockets actually have an event
+			and update the socket field xSocketBits. */
+			#if( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+			{
+				vSocketSelect( ( SocketSelect_t * ) ( pxEvent->pvData ) );
+			}
+			#endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
+			break;
+
+		case eSocketSignalEvent :
+			#if( ipconfigSUPPORT_SIGNALS != 0 )
+			{
+				/* Some task wants to signal the user of this socket in
+				order to interrupt a call to recv() or a call to select(). */
+				FreeRTOS_SignalSocket( ( Socket_t ) pxEvent->pvData );
+			}
+			#endif /* ipconfigSUPPORT_SIGNALS */
+			break;
 
-			case eTCPNetStat:
-				/* FreeRTOS_netstat() was called to have the IP-task print an
-				overview of all sockets and their connections */
-				#if( ( ipconfigUSE_TCP == 1 ) && ( ipconfigHAS_PRINTF == 1 ) )
+		case eTCPTimerEvent :
+			#if( ipconfigUSE_TCP == 1 )
+			{
+				/* Simply mark the TCP timer as expired so it gets processed
+				the next time prvCheckNetworkTimers() is called. */
+				xTCPTimer.bExpired = pdTRUE_UNSIGNED;
+			}
+			#endif /* ipconfigUSE_TCP */
+			break;
+
+		case eTCPAcceptEvent:
+			/* The API FreeRTOS_accept() was called, the IP-task will now
+			check if the listening socket (communicated in pvData) actually
+			received a new connection. */
+			#if( ipconfigUSE_TCP == 1 )
+			{
+				pxSocket = ( FreeRTOS_Socket_t * ) ( pxEvent->pvData );
+
+				if( xTCPCheckNewClient( pxSocket ) != pdFALSE )
 				{
-					vTCPNetStat();
+					pxSocket->xEventBits |= eSOCKET_ACCEPT;
+					vSocketWakeUpUser( pxSocket );
 				}
-				#endif /* ipconfigUSE_TCP */
-				break;
+			}
+			#endif /* ipconfigUSE_TCP */
+			break;
 
-			default :
-				/* Should not get here. */
-				break;
+		case eTCPNetStat:
+			/* FreeRTOS_netstat() was called to have the IP-task print an
+			overview of all sockets and their connections */
+			#if( ( ipconfigUSE_TCP == 1 ) && ( ipconfigHAS_PRINTF == 1 ) )
+			{
+				vTCPNetStat();
+			}
+			#endif /* ipconfigUSE_TCP */
+			break;
+
+		default :
+			/* Should not get here. */
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_NETWORK_RX_RING != 0 )
+
+	static void prvNetworkRxRingWakeUp( SPSCRingHandle_t xRing, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	IPStackEvent_t xRingEvent;
+
+		( void ) xRing;
+
+		xRingEvent.eEventType = eNetworkRxRingEvent;
+		xRingEvent.pvData = NULL;
+
+		/* If the queue is full then the IP-task is not waiting, and will process
+		the frames in the ring before it waits again, so the event is not
+		needed. */
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			( void ) xQueueSendToBack( xNetworkEventQueue, &xRingEvent, ( TickType_t ) 0 );
 		}
+		else
+		{
+			( void ) xQueueSendToBackFromISR( xNetworkEventQueue, &xRingEvent, pxHigherPriorityTaskWoken );
+		}
+	}
+	/*-----------------------------------------------------------*/
 
-		if( xNetworkDownEventPending != pdFALSE )
+	static void prvProcessNetworkRxRing( void )
+	{
+	void *pvNetworkBuffer;
+	UBaseType_t x;
+
+		/* Process a limited number of frames, so the events posted to the
+		network event queue in the mean time are not delayed for too long.
+		Frames left in the ring stop the IP-task from waiting. */
+		for( x = 0u; x < ( UBaseType_t ) ipconfigEVENT_BATCH_LENGTH; x++ )
 		{
-			/* A network down event could not be posted to the network event
-			queue because the queue was full.  Try posting again. */
-			FreeRTOS_NetworkDown();
+			if( xSPSCRingReceive( xNetworkRxRing, &pvNetworkBuffer, ( TickType_t ) 0 ) == pdFAIL )
+			{
+				break;
+			}
+
+			iptraceNETWORK_EVENT_RECEIVED( eNetworkRxEvent );
+			prvHandleEthernetPacket( ( NetworkBufferDescriptor_t * ) pvNetworkBuffer );
 		}
 	}
-}
+
+#endif /* ipconfigUSE_NETWORK_RX_RING */
 /*-----------------------------------------------------------*/
 
 BaseType_t xIsCallingFromIPTask( void )
@@ -997,6 +1127,27 @@ BaseType_t xReturn = pdFALSE;
 			/* Prepare the sockets interface. */
 			xReturn = vNetworkSocketsInit();
 
+			#if( ipconfigUSE_NETWORK_RX_RING != 0 )
+			{
+				if( pdTRUE == xReturn )
+				{
+					/* Create the ring used to pass received frames to the
+					IP-task. */
+					xNetworkRxRing = xSPSCRingCreate( ( size_t ) ipconfigNETWORK_RX_RING_LENGTH );
+					configASSERT( xNetworkRxRing );
+
+					if( xNetworkRxRing != NULL )
+					{
+						vSPSCRingSetWakeUpCallback( xNetworkRxRing, prvNetworkRxRingWakeUp );
+					}
+					else
+					{
+						xReturn = pdFALSE;
+					}
+				}
+			}
+			#endif /* ipconfigUSE_NETWORK_RX_RING */
+
 			if( pdTRUE == xReturn )
 			{
 				/* Create the task that processes Ethernet and stack events. */
@@ -1214,6 +1365,40 @@ BaseType_t xReturn, xSendMessage;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xSendNetworkBufferToIPTask( NetworkBufferDescriptor_t * const pxNetworkBuffer, TickType_t xTimeout )
+{
+BaseType_t xReturn;
+
+	#if( ipconfigUSE_NETWORK_RX_RING != 0 )
+	{
+		/* Sending to the ring never blocks. */
+		( void ) xTimeout;
+
+		if( xIPIsNetworkTaskReady() == pdFALSE )
+		{
+			/* Frames are not accepted before the IP task is ready, as is the
+			case when they are passed as events. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			xReturn = xSPSCRingSend( xNetworkRxRing, ( void * ) pxNetworkBuffer );
+		}
+	}
+	#else
+	{
+	IPStackEvent_t xRxEvent;
+
+		xRxEvent.eEventType = eNetworkRxEvent;
+		xRxEvent.pvData = ( void * ) pxNetworkBuffer;
+		xReturn = xSendEventStructToIPTask( &xRxEvent, xTimeout );
+	}
+	#endif /* ipconfigUSE_NETWORK_RX_RING */
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucEthernetBuffer )
 {
 eFrameProcessingResult_t eReturn;
@@ -1491,6 +1676,13 @@ eFrameProcessingResult_t eReturn = eProcessBuffer;
 				/* Check sum in IP-header not correct. */
 				eReturn = eReleaseBuffer;
 			}
+			#if( ipconfigUSE_CHECKSUM_COPY != 0 ) && ( ipconfigUSE_TCP == 1 )
+			else if( pxIPHeader->ucProtocol == ( uint8_t ) ipPROTOCOL_TCP )
+			{
+				/* The TCP checksum is checked by xProcessReceivedTCPPacket(),
+				which adds up the payload while it copies it to the socket. */
+			}
+			#endif /* ipconfigUSE_CHECKSUM_COPY */
 			/* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
 			else if( usGenerateProtocolChecksum( ( uint8_t * )( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
 			{
@@ -1552,6 +1744,13 @@ uint8_t ucProtocol;
 			/* Fix-up new version/header length field in IP packet. */
 			pxIPHeader->ucVersionHeaderLength = ( pxIPHeader->ucVersionHeaderLength & 0xF0 ) | /* High nibble is the version. */
 												( ( ipSIZE_OF_IPv4_HEADER >> 2 ) & 0x0F ); /* Low nibble is the header size, in bytes, divided by four. */
+
+			/* The total length no longer includes the options, so that the
+			protocol checksum can still be calculated. */
+			if( FreeRTOS_ntohs( pxIPHeader->usLength ) > optlen )
+			{
+				pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( FreeRTOS_ntohs( pxIPHeader->usLength ) - optlen ) );
+			}
 		}
 
 		/* Add the IP and MAC addresses to the ARP table if they are not
@@ -1796,7 +1995,25 @@ uint8_t ucProtocol;
 
 uint16_t usGenerateProtocolChecksum( const uint8_t * const pucEthernetBuffer, size_t uxBufferLength, BaseType_t xOutgoingPacket )
 {
-uint32_t ulLength;
+	return prvGenerateProtocolChecksum( pucEthernetBuffer, uxBufferLength, xOutgoingPacket, 0u, 0u );
+}
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+
+	uint16_t usGenerateProtocolChecksumPartial( const uint8_t * const pucEthernetBuffer, size_t uxBufferLength, BaseType_t xOutgoingPacket,
+		size_t uxPresummedLength, uint16_t usPresummedChecksum )
+	{
+		return prvGenerateProtocolChecksum( pucEthernetBuffer, uxBufferLength, xOutgoingPacket, uxPresummedLength, usPresummedChecksum );
+	}
+
+#endif /* ipconfigUSE_CHECKSUM_COPY */
+/*-----------------------------------------------------------*/
+
+static uint16_t prvGenerateProtocolChecksum( const uint8_t * const pucEthernetBuffer, size_t uxBufferLength, BaseType_t xOutgoingPacket,
+	size_t uxPresummedLength, uint16_t usPresummedChecksum )
+{
+uint32_t ulLength, ulSum;
 uint16_t usChecksum, *pusChecksum;
 const IPPacket_t * pxIPPacket;
 UBaseType_t uxIPHeaderLength;
@@ -1928,6 +2145,12 @@ uint8_t ucProtocol;
 		format/length */
 		return ipINVALID_LENGTH;
 	}
+	if( ( size_t ) ulLength < uxPresummedLength )
+	{
+		/* The payload that has been added up already can not be longer than
+		the packet. */
+		return ipINVALID_LENGTH;
+	}
 	if( ucProtocol <= ( uint8_t ) ipPROTOCOL_IGMP )
 	{
 		/* ICMP/IGMP do not have a pseudo header for CRC-calculation. */
@@ -1941,10 +2164,15 @@ uint8_t ucProtocol;
 		fields */
 		usChecksum = ( uint16_t ) ( ulLength + ( ( uint16_t ) ucProtocol ) );
 
+		/* Add the sum of the last uxPresummedLength bytes, which start at an
+		even offset as the headers are a multiple of 4 bytes long. */
+		ulSum = ( uint32_t ) usChecksum + usPresummedChecksum;
+		ulSum = ( ulSum & 0xffffu ) + ( ulSum >> 16 );
+
 		/* And then continue at the IPv4 source and destination addresses. */
 		usChecksum = ( uint16_t )
-			( ~usGenerateChecksum( ( uint32_t ) usChecksum, ( uint8_t * )&( pxIPPacket->xIPHeader.ulSourceIPAddress ),
-				( 2u * sizeof( pxIPPacket->xIPHeader.ulSourceIPAddress ) + ulLength ) ) );
+			( ~usGenerateChecksum( ulSum, ( uint8_t * )&( pxIPPacket->xIPHeader.ulSourceIPAddress ),
+				( 2u * sizeof( pxIPPacket->xIPHeader.ulSourceIPAddress ) + ulLength - uxPresummedLength ) ) );
 
 		/* Sum TCP header and data. */
 	}
@@ -1997,6 +2225,253 @@ uint8_t ucProtocol;
 }
 /*-----------------------------------------------------------*/
 
+#if( ipconfigCHECKSUM_BACKEND == 0 )
+
+	uint32_t ulChecksumWords( uint32_t ulSum, const uint32_t * pulWords, size_t uxWords )
+	{
+	xUnion32 xSum2, xSum;
+	const uint32_t *pulLast = pulWords + ( uxWords & ~( ( size_t ) 3u ) );
+	uint32_t ulCarry = 0ul;
+
+		xSum.u32 = ulSum;
+
+		/* In this loop, four 32-bit additions will be done, in total 16 bytes.
+		Indexing with constants (0,1,2,3) gives faster code than using
+		post-increments. */
+		while( pulWords < pulLast )
+		{
+			/* Use a secondary Sum2, just to see if the addition produced an
+			overflow. */
+			xSum2.u32 = xSum.u32 + pulWords[ 0 ];
+			if( xSum2.u32 < xSum.u32 )
+			{
+				ulCarry++;
+			}
+
+			/* Now add the secondary sum to the major sum, and remember if there was
+			a carry. */
+			xSum.u32 = xSum2.u32 + pulWords[ 1 ];
+			if( xSum2.u32 > xSum.u32 )
+			{
+				ulCarry++;
+			}
+
+			/* And do the same trick once again for indexes 2 and 3 */
+			xSum2.u32 = xSum.u32 + pulWords[ 2 ];
+			if( xSum2.u32 < xSum.u32 )
+			{
+				ulCarry++;
+			}
+
+			xSum.u32 = xSum2.u32 + pulWords[ 3 ];
+
+			if( xSum2.u32 > xSum.u32 )
+			{
+				ulCarry++;
+			}
+
+			/* And finally advance the pointer 4 * 4 = 16 bytes. */
+			pulWords += 4;
+		}
+
+		/* The last 0 to 3 words. */
+		for( uxWords &= 3u; uxWords != 0u; uxWords-- )
+		{
+			xSum2.u32 = xSum.u32 + *pulWords;
+			if( xSum2.u32 < xSum.u32 )
+			{
+				ulCarry++;
+			}
+			xSum.u32 = xSum2.u32;
+			pulWords++;
+		}
+
+		/* Now add all carries, which may give another two 16-bit carries. */
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+
+		return xSum.u32;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulChecksumCopyWords( uint32_t ulSum, uint8_t * pucTarget, const uint8_t * pucSource, size_t uxWords )
+	{
+	xUnion32 xSum2, xSum;
+	uint32_t ulWord, ulCarry = 0ul;
+
+		xSum.u32 = ulSum;
+
+		for( ; uxWords != 0u; uxWords-- )
+		{
+			/* memcpy() of a single word compiles to a load and a store on CPUs
+			that allow unaligned access, and to byte accesses on others. */
+			memcpy( &ulWord, pucSource, sizeof( ulWord ) );
+			memcpy( pucTarget, &ulWord, sizeof( ulWord ) );
+
+			xSum2.u32 = xSum.u32 + ulWord;
+			if( xSum2.u32 < xSum.u32 )
+			{
+				ulCarry++;
+			}
+			xSum.u32 = xSum2.u32;
+
+			pucSource += sizeof( ulWord );
+			pucTarget += sizeof( ulWord );
+		}
+
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+
+		return xSum.u32;
+	}
+	/*-----------------------------------------------------------*/
+
+#elif( ipconfigCHECKSUM_BACKEND != 3 )
+
+	/* A 64-bit sum of 32-bit words can not overflow for any length that fits
+	in memory, so no carries have to be counted.  Fold it to 16 bits. */
+	static uint32_t prvChecksumFold64( uint64_t ullSum )
+	{
+	xUnion32 xSum;
+
+		xSum.u32 = ( uint32_t ) ( ullSum & 0xffffu ) + ( uint32_t ) ( ( ullSum >> 16 ) & 0xffffu ) +
+			( uint32_t ) ( ( ullSum >> 32 ) & 0xffffu ) + ( uint32_t ) ( ullSum >> 48 );
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+		xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+
+		return xSum.u32;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulChecksumWords( uint32_t ulSum, const uint32_t * pulWords, size_t uxWords )
+	{
+	uint64_t ullSum = ulSum;
+
+		#if( ipCHECKSUM_SIMD == ipCHECKSUM_SSE2 )
+		{
+		__m128i xAcc = _mm_setzero_si128();
+		const __m128i xZero = _mm_setzero_si128();
+		__m128i xData;
+		uint64_t ullLanes[ 2 ];
+
+			/* Widen each group of four words to 64 bits, and add them to two
+			64-bit lanes. */
+			while( uxWords >= 4u )
+			{
+				xData = _mm_loadu_si128( ( const __m128i * ) pulWords );
+				xAcc = _mm_add_epi64( xAcc, _mm_unpacklo_epi32( xData, xZero ) );
+				xAcc = _mm_add_epi64( xAcc, _mm_unpackhi_epi32( xData, xZero ) );
+				pulWords += 4;
+				uxWords -= 4u;
+			}
+
+			_mm_storeu_si128( ( __m128i * ) ullLanes, xAcc );
+			ullSum += ullLanes[ 0 ] + ullLanes[ 1 ];
+		}
+		#elif( ipCHECKSUM_SIMD == ipCHECKSUM_NEON )
+		{
+		uint64x2_t xAcc = vdupq_n_u64( 0u );
+
+			/* Add the words pairwise to two 64-bit lanes. */
+			while( uxWords >= 4u )
+			{
+				xAcc = vpadalq_u32( xAcc, vld1q_u32( pulWords ) );
+				pulWords += 4;
+				uxWords -= 4u;
+			}
+
+			ullSum += vgetq_lane_u64( xAcc, 0 ) + vgetq_lane_u64( xAcc, 1 );
+		}
+		#endif /* ipCHECKSUM_SIMD */
+
+		while( uxWords >= 4u )
+		{
+			ullSum += ( uint64_t ) pulWords[ 0 ] + pulWords[ 1 ] + pulWords[ 2 ] + pulWords[ 3 ];
+			pulWords += 4;
+			uxWords -= 4u;
+		}
+
+		for( ; uxWords != 0u; uxWords-- )
+		{
+			ullSum += *pulWords;
+			pulWords++;
+		}
+
+		return prvChecksumFold64( ullSum );
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulChecksumCopyWords( uint32_t ulSum, uint8_t * pucTarget, const uint8_t * pucSource, size_t uxWords )
+	{
+	uint64_t ullSum = ulSum, ullWord;
+	uint32_t ulWord;
+
+		#if( ipCHECKSUM_SIMD == ipCHECKSUM_SSE2 )
+		{
+		__m128i xAcc = _mm_setzero_si128();
+		const __m128i xZero = _mm_setzero_si128();
+		__m128i xData;
+		uint64_t ullLanes[ 2 ];
+
+			while( uxWords >= 4u )
+			{
+				xData = _mm_loadu_si128( ( const __m128i * ) pucSource );
+				_mm_storeu_si128( ( __m128i * ) pucTarget, xData );
+				xAcc = _mm_add_epi64( xAcc, _mm_unpacklo_epi32( xData, xZero ) );
+				xAcc = _mm_add_epi64( xAcc, _mm_unpackhi_epi32( xData, xZero ) );
+				pucSource += 16;
+				pucTarget += 16;
+				uxWords -= 4u;
+			}
+
+			_mm_storeu_si128( ( __m128i * ) ullLanes, xAcc );
+			ullSum += ullLanes[ 0 ] + ullLanes[ 1 ];
+		}
+		#elif( ipCHECKSUM_SIMD == ipCHECKSUM_NEON )
+		{
+		uint64x2_t xAcc = vdupq_n_u64( 0u );
+		uint8x16_t xData;
+
+			while( uxWords >= 4u )
+			{
+				xData = vld1q_u8( pucSource );
+				vst1q_u8( pucTarget, xData );
+				xAcc = vpadalq_u32( xAcc, vreinterpretq_u32_u8( xData ) );
+				pucSource += 16;
+				pucTarget += 16;
+				uxWords -= 4u;
+			}
+
+			ullSum += vgetq_lane_u64( xAcc, 0 ) + vgetq_lane_u64( xAcc, 1 );
+		}
+		#endif /* ipCHECKSUM_SIMD */
+
+		/* Copy 8 bytes at a time, and add both of their 32-bit halves. */
+		while( uxWords >= 2u )
+		{
+			memcpy( &ullWord, pucSource, sizeof( ullWord ) );
+			memcpy( pucTarget, &ullWord, sizeof( ullWord ) );
+			ullSum += ( ullWord & 0xffffffffu ) + ( ullWord >> 32 );
+			pucSource += sizeof( ullWord );
+			pucTarget += sizeof( ullWord );
+			uxWords -= 2u;
+		}
+
+		if( uxWords != 0u )
+		{
+			memcpy( &ulWord, pucSource, sizeof( ulWord ) );
+			memcpy( pucTarget, &ulWord, sizeof( ulWord ) );
+			ullSum += ulWord;
+		}
+
+		return prvChecksumFold64( ullSum );
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* ipconfigCHECKSUM_BACKEND */
+
 /**
  * This method generates a checksum for a given IPv4 header, per RFC791 (page 14).
  * The checksum algorithm is decribed as:
@@ -2014,7 +2489,8 @@ uint8_t ucProtocol;
  * This logic is optimized for microcontrollers which have limited resources, so the logic looks odd.
  * It iterates over the full range of 16-bit words, but it does so by processing several 32-bit
  * words at once whenever possible. Its first step is to align the memory pointer to a 32-bit boundary,
- * after which it runs a fast loop to process multiple 32-bit words at once and adding their 'carries'.
+ * after which the checksum backend, ulChecksumWords(), adds up the 32-bit words. The default backend
+ * runs a fast loop to process multiple 32-bit words at once and adding their 'carries'.
  * Finally, it finishes up by processing any remaining 16-bit words, and adding up all of the 'carries'.
  * With 32-bit arithmetic, the number of 16-bit 'carries' produced by sequential additions can be found
  * by looking at the 16 most-significant bits of the 32-bit integer, since a 32-bit int will continue
@@ -2032,14 +2508,14 @@ uint8_t ucProtocol;
  */
 uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t * pucNextData, size_t uxDataLengthBytes )
 {
-xUnion32 xSum2, xSum, xTerm;
+xUnion32 xSum, xTerm;
 xUnionPtr xSource;		/* Points to first byte */
 xUnionPtr xLastSource;	/* Points to last byte plus one */
-uint32_t ulAlignBits, ulCarry = 0ul;
+uint32_t ulAlignBits;
 
 	/* Small MCUs often spend up to 30% of the time doing checksum calculations
 	This function is optimised for 32-bit CPUs; Each time it will try to fetch
-	32-bits, sums it with an accumulator and counts the number of carries. */
+	32-bits, and let the checksum backend add them up. */
 
 	/* Swap the input (little endian platform only). */
 	xSum.u32 = FreeRTOS_ntohs( ulSum );
@@ -2066,52 +2542,12 @@ uint32_t ulAlignBits, ulCarry = 0ul;
 		/* Now xSource is word (32-bit) aligned. */
 	}
 
-	/* Word (32-bit) aligned, do the most part. */
-	xLastSource.u32ptr = ( xSource.u32ptr + ( uxDataLengthBytes / 4u ) ) - 3u;
-
-	/* In this loop, four 32-bit additions will be done, in total 16 bytes.
-	Indexing with constants (0,1,2,3) gives faster code than using
-	post-increments. */
-	while( xSource.u32ptr < xLastSource.u32ptr )
-	{
-		/* Use a secondary Sum2, just to see if the addition produced an
-		overflow. */
-		xSum2.u32 = xSum.u32 + xSource.u32ptr[ 0 ];
-		if( xSum2.u32 < xSum.u32 )
-		{
-			ulCarry++;
-		}
+	/* Word (32-bit) aligned, the backend does the most part and returns a
+	16-bit sum. */
+	xSum.u32 = ulChecksumWords( xSum.u32, xSource.u32ptr, uxDataLengthBytes / 4u );
+	xSource.u32ptr += uxDataLengthBytes / 4u;
 
-		/* Now add the secondary sum to the major sum, and remember if there was
-		a carry. */
-		xSum.u32 = xSum2.u32 + xSource.u32ptr[ 1 ];
-		if( xSum2.u32 > xSum.u32 )
-		{
-			ulCarry++;
-		}
-
-		/* And do the same trick once again for indexes 2 and 3 */
-		xSum2.u32 = xSum.u32 + xSource.u32ptr[ 2 ];
-		if( xSum2.u32 < xSum.u32 )
-		{
-			ulCarry++;
-		}
-
-		xSum.u32 = xSum2.u32 + xSource.u32ptr[ 3 ];
-
-		if( xSum2.u32 > xSum.u32 )
-		{
-			ulCarry++;
-		}
-
-		/* And finally advance the pointer 4 * 4 = 16 bytes. */
-		xSource.u32ptr += 4;
-	}
-
-	/* Now add all carries. */
-	xSum.u32 = ( uint32_t )xSum.u16[ 0 ] + xSum.u16[ 1 ] + ulCarry;
-
-	uxDataLengthBytes %= 16u;
+	uxDataLengthBytes %= 4u;
 	xLastSource.u8ptr = ( uint8_t * ) ( xSource.u8ptr + ( uxDataLengthBytes & ~( ( size_t ) 1 ) ) );
 
 	/* Half-word aligned. */
@@ -2146,6 +2582,49 @@ uint32_t ulAlignBits, ulCarry = 0ul;
 }
 /*-----------------------------------------------------------*/
 
+uint16_t usGenerateChecksumCopy( uint32_t ulSum, uint8_t * pucTarget, const uint8_t * pucSource, size_t uxDataLengthBytes )
+{
+xUnion32 xSum;
+size_t uxWords = uxDataLengthBytes / 4u;
+uint16_t usTerm;
+uint8_t ucTerm[ 2 ];
+
+	/* The words are loaded without aligning the pointers first, so the 16-bit
+	words are summed in the same byte lanes as usGenerateChecksum() does when
+	it swaps the sum of data that starts at an odd address. */
+	xSum.u32 = FreeRTOS_ntohs( ulSum );
+	xSum.u32 = ulChecksumCopyWords( xSum.u32, pucTarget, pucSource, uxWords );
+
+	pucSource += uxWords * 4u;
+	pucTarget += uxWords * 4u;
+	uxDataLengthBytes %= 4u;
+
+	if( uxDataLengthBytes >= 2u )
+	{
+		memcpy( &usTerm, pucSource, sizeof( usTerm ) );
+		memcpy( pucTarget, &usTerm, sizeof( usTerm ) );
+		xSum.u32 += usTerm;
+		pucSource += 2;
+		pucTarget += 2;
+	}
+
+	if( ( uxDataLengthBytes & 1u ) != 0u )
+	{
+		/* The last byte is the first byte of a 16-bit word. */
+		*pucTarget = *pucSource;
+		ucTerm[ 0 ] = *pucSource;
+		ucTerm[ 1 ] = 0u;
+		memcpy( &usTerm, ucTerm, sizeof( usTerm ) );
+		xSum.u32 += usTerm;
+	}
+
+	xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+	xSum.u32 = ( uint32_t ) xSum.u16[ 0 ] + xSum.u16[ 1 ];
+
+	return FreeRTOS_htons( ( uint16_t ) xSum.u32 );
+}
+/*-----------------------------------------------------------*/
+
 void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer, BaseType_t xReleaseAfterSend )
 {
 EthernetHeader_t *pxEthernetHeader;
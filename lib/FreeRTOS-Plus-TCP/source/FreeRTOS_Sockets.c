@@ -50,6 +50,23 @@ port number. */
 xBoundUDPSocketsList or xBoundTCPSocketsList */
 #define socketSOCKET_IS_BOUND( pxSocket )	  ( listLIST_ITEM_CONTAINER( & ( pxSocket )->xBoundSocketListItem ) != NULL )
 
+#if( ipconfigUSE_SOCKET_HASH == 1 )
+	#if( ( ipconfigSOCKET_HASH_BUCKETS & ( ipconfigSOCKET_HASH_BUCKETS - 1 ) ) != 0 )
+		#error ipconfigSOCKET_HASH_BUCKETS must be a power of 2
+	#endif
+
+	/* Map a key to a bucket of a socket hash table.  The multiplication spreads
+	the bits of the key over the bits that are used. */
+	#define socketHASH_KEY( ulKey )		( ( UBaseType_t ) ( ( ( uint32_t ) ( ( uint32_t ) ( ulKey ) * 0x9E3779B1ul ) ) >> 16 ) & ( UBaseType_t ) ( ipconfigSOCKET_HASH_BUCKETS - 1 ) )
+
+	/* The bucket of a UDP or a listening TCP socket. */
+	#define socketHASH_PORT( usPort )	socketHASH_KEY( ( uint32_t ) ( usPort ) )
+
+	/* The bucket of any other TCP socket. */
+	#define socketHASH_CONNECTION( usLocalPort, ulRemoteIP, usRemotePort ) \
+		socketHASH_KEY( ( ulRemoteIP ) ^ ( ( ( uint32_t ) ( usRemotePort ) ) << 16 ) ^ ( uint32_t ) ( usLocalPort ) )
+#endif /* ipconfigUSE_SOCKET_HASH */
+
 /* If FreeRTOS_sendto() is called on a socket that is not bound to a port
 number then, depending on the FreeRTOSIPConfig.h settings, it might be that a
 port number is automatically generated for the socket.  Automatically generated
@@ -105,6 +122,29 @@ static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol );
  */
 static const ListItem_t * pxListFindListItemWithValue( const List_t *pxList, TickType_t xWantedItemValue );
 
+#if( ipconfigUSE_SOCKET_HASH == 1 )
+	/*
+	 * Return the UDP socket bound to usPort, which is in network byte order, or
+	 * NULL if there is none.
+	 */
+	static FreeRTOS_Socket_t *prvUDPSocketHashFind( uint16_t usPort );
+
+	/*
+	 * Add a socket that has just been bound to the socket hash tables, or
+	 * remove a socket that is being closed from them.
+	 */
+	static void prvSocketHashAdd( FreeRTOS_Socket_t *pxSocket );
+	static void prvSocketHashRemove( FreeRTOS_Socket_t *pxSocket );
+
+	#if( ipconfigUSE_TCP == 1 )
+		/*
+		 * Move a bound TCP socket to the bucket that matches its state, local
+		 * port and peer.  Only called by the IP-task.
+		 */
+		static void prvTCPSocketHashMove( FreeRTOS_Socket_t *pxSocket );
+	#endif /* ipconfigUSE_TCP == 1 */
+#endif /* ipconfigUSE_SOCKET_HASH */
+
 /*
  * Return pdTRUE only if pxSocket is valid and bound, as far as can be
  * determined.
@@ -163,6 +203,23 @@ List_t xBoundUDPSocketsList;
 	List_t xBoundTCPSocketsList;
 #endif /* ipconfigUSE_TCP == 1 */
 
+#if( ipconfigUSE_SOCKET_HASH == 1 )
+	/* The bound sockets are also kept in these hash tables, see
+	ipconfigUSE_SOCKET_HASH.  Like the lists of bound sockets, the tables are
+	only changed by the IP-task. */
+	static List_t xUDPSocketHash[ ipconfigSOCKET_HASH_BUCKETS ];
+
+	#if( ipconfigUSE_TCP == 1 )
+		static List_t xTCPConnectionHash[ ipconfigSOCKET_HASH_BUCKETS ];
+		static List_t xTCPListenerHash[ ipconfigSOCKET_HASH_BUCKETS ];
+
+		/* Set when FreeRTOS_connect() or FreeRTOS_listen() changed the state
+		of a socket from an application task.  The IP-task moves the sockets to
+		their new buckets before it looks up a socket again. */
+		static volatile BaseType_t xTCPSocketHashStale = pdFALSE;
+	#endif /* ipconfigUSE_TCP == 1 */
+#endif /* ipconfigUSE_SOCKET_HASH */
+
 /*-----------------------------------------------------------*/
 
 static BaseType_t prvValidSocket( FreeRTOS_Socket_t *pxSocket, BaseType_t xProtocol, BaseType_t xIsBound )
@@ -198,6 +255,24 @@ BaseType_t vNetworkSocketsInit( void )
 	}
 	#endif  /* ipconfigUSE_TCP == 1 */
 
+	#if( ipconfigUSE_SOCKET_HASH == 1 )
+	{
+	UBaseType_t uxBucket;
+
+		for( uxBucket = 0u; uxBucket < ( UBaseType_t ) ipconfigSOCKET_HASH_BUCKETS; uxBucket++ )
+		{
+			vListInitialise( &( xUDPSocketHash[ uxBucket ] ) );
+
+			#if( ipconfigUSE_TCP == 1 )
+			{
+				vListInitialise( &( xTCPConnectionHash[ uxBucket ] ) );
+				vListInitialise( &( xTCPListenerHash[ uxBucket ] ) );
+			}
+			#endif  /* ipconfigUSE_TCP == 1 */
+		}
+	}
+	#endif /* ipconfigUSE_SOCKET_HASH */
+
 	return pdTRUE;
 }
 /*-----------------------------------------------------------*/
@@ -316,6 +391,13 @@ Socket_t xReturn;
 			vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
 			listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
 
+			#if( ipconfigUSE_SOCKET_HASH == 1 )
+			{
+				vListInitialiseItem( &( pxSocket->xHashListItem ) );
+				listSET_LIST_ITEM_OWNER( &( pxSocket->xHashListItem ), ( void * ) pxSocket );
+			}
+			#endif /* ipconfigUSE_SOCKET_HASH */
+
 			pxSocket->xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
 			pxSocket->xSendBlockTime	= ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
 			pxSocket->ucSocketOptions   = ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
@@ -342,6 +424,11 @@ Socket_t xReturn;
 						pxSocket->u.xTCP.uxTxWinSize  = 1u;
 					}
 					#endif
+					#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+					{
+						pxSocket->u.xTCP.ucCongestionControl = ( uint8_t ) ipconfigTCP_CONGESTION_CONTROL;
+					}
+					#endif
 					/* The above values are just defaults, and can be overridden by
 					calling FreeRTOS_setsockopt().  No buffers will be allocated until a
 					socket is connected and data is exchanged. */
@@ -1054,6 +1141,12 @@ List_t *pxSocketList;
 				/* Add the socket to 'xBoundUDPSocketsList' or 'xBoundTCPSocketsList' */
 				vListInsertEnd( pxSocketList, &( pxSocket->xBoundSocketListItem ) );
 
+				#if( ipconfigUSE_SOCKET_HASH == 1 )
+				{
+					prvSocketHashAdd( pxSocket );
+				}
+				#endif /* ipconfigUSE_SOCKET_HASH */
+
 				#if( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
 				{
 					xTaskResumeAll();
@@ -1187,6 +1280,12 @@ NetworkBufferDescriptor_t *pxNetworkBuffer;
 
 		uxListRemove( &( pxSocket->xBoundSocketListItem ) );
 
+		#if( ipconfigUSE_SOCKET_HASH == 1 )
+		{
+			prvSocketHashRemove( pxSocket );
+		}
+		#endif /* ipconfigUSE_SOCKET_HASH */
+
 		#if( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
 		{
 			xTaskResumeAll();
@@ -1571,6 +1670,34 @@ FreeRTOS_Socket_t *pxSocket;
 				xReturn = 0;
 				break;
 
+			#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+				case FREERTOS_SO_TCP_CONGESTION:	/* Select the congestion control algorithm */
+					{
+					BaseType_t xAlgorithm = *( ( BaseType_t * ) pvOptionValue );
+
+						if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
+						{
+							break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+						}
+
+						if( ( xAlgorithm != FREERTOS_TCP_CONGESTION_NEWRENO ) && ( xAlgorithm != FREERTOS_TCP_CONGESTION_CUBIC ) )
+						{
+							break;	/* will return -pdFREERTOS_ERRNO_EINVAL */
+						}
+
+						/* The choice is kept in the socket, because the window
+						is cleared when a listening socket is re-used. */
+						pxSocket->u.xTCP.ucCongestionControl = ( uint8_t ) xAlgorithm;
+
+						if( pxSocket->u.xTCP.xTCPWindow.u.bits.bHasInit != pdFALSE_UNSIGNED )
+						{
+							( void ) xTCPWindowSetCongestionControl( &( pxSocket->u.xTCP.xTCPWindow ), xAlgorithm );
+						}
+					}
+					xReturn = 0;
+					break;
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 			case FREERTOS_SO_STOP_RX:		/* Refuse to receive more packts */
 				{
 					if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP )
@@ -1709,26 +1836,152 @@ const ListItem_t * pxResult = NULL;
 
 FreeRTOS_Socket_t *pxUDPSocketLookup( UBaseType_t uxLocalPort )
 {
-const ListItem_t *pxListItem;
 FreeRTOS_Socket_t *pxSocket = NULL;
 
-	/* Looking up a socket is quite simple, find a match with the local port.
+	#if( ipconfigUSE_SOCKET_HASH == 1 )
+	{
+		/* Only the sockets bound to a port with the same hash are searched. */
+		if( xIPIsNetworkTaskReady() != pdFALSE )
+		{
+			pxSocket = prvUDPSocketHashFind( ( uint16_t ) uxLocalPort );
+		}
+	}
+	#else
+	{
+	const ListItem_t *pxListItem;
 
-	See if there is a list item associated with the port number on the
-	list of bound sockets. */
-	pxListItem = pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) uxLocalPort );
+		/* Looking up a socket is quite simple, find a match with the local port.
 
-	if( pxListItem != NULL )
-	{
-		/* The owner of the list item is the socket itself. */
-		pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
-		configASSERT( pxSocket != NULL );
+		See if there is a list item associated with the port number on the
+		list of bound sockets. */
+		pxListItem = pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) uxLocalPort );
+
+		if( pxListItem != NULL )
+		{
+			/* The owner of the list item is the socket itself. */
+			pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+			configASSERT( pxSocket != NULL );
+		}
 	}
+	#endif /* ipconfigUSE_SOCKET_HASH */
+
 	return pxSocket;
 }
 
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_SOCKET_HASH == 1 )
+
+	static FreeRTOS_Socket_t *prvUDPSocketHashFind( uint16_t usPort )
+	{
+	const List_t *pxBucket = &( xUDPSocketHash[ socketHASH_PORT( usPort ) ] );
+	const MiniListItem_t *pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( pxBucket );
+	const ListItem_t *pxIterator;
+	FreeRTOS_Socket_t *pxResult = NULL;
+
+		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+			 pxIterator != ( const ListItem_t * ) pxEnd;
+			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+		{
+			/* Like in 'xBoundUDPSocketsList', the item value is the port
+			number. */
+			if( listGET_LIST_ITEM_VALUE( pxIterator ) == ( TickType_t ) usPort )
+			{
+				pxResult = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+				break;
+			}
+		}
+
+		return pxResult;
+	}
+
+#endif /* ipconfigUSE_SOCKET_HASH */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_SOCKET_HASH == 1 )
+
+	static void prvSocketHashAdd( FreeRTOS_Socket_t *pxSocket )
+	{
+		#if( ipconfigUSE_TCP == 1 )
+		if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+		{
+			prvTCPSocketHashMove( pxSocket );
+		}
+		else
+		#endif /* ipconfigUSE_TCP == 1 */
+		{
+			/* Like in 'xBoundUDPSocketsList', the item value is the port
+			number. */
+			listSET_LIST_ITEM_VALUE( &( pxSocket->xHashListItem ), socketGET_SOCKET_PORT( pxSocket ) );
+			vListInsertEnd( &( xUDPSocketHash[ socketHASH_PORT( socketGET_SOCKET_PORT( pxSocket ) ) ] ), &( pxSocket->xHashListItem ) );
+		}
+	}
+
+#endif /* ipconfigUSE_SOCKET_HASH */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_SOCKET_HASH == 1 )
+
+	static void prvSocketHashRemove( FreeRTOS_Socket_t *pxSocket )
+	{
+		if( listLIST_ITEM_CONTAINER( &( pxSocket->xHashListItem ) ) != NULL )
+		{
+			( void ) uxListRemove( &( pxSocket->xHashListItem ) );
+		}
+	}
+
+#endif /* ipconfigUSE_SOCKET_HASH */
+/*-----------------------------------------------------------*/
+
+#if( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH == 1 ) )
+
+	static void prvTCPSocketHashMove( FreeRTOS_Socket_t *pxSocket )
+	{
+	List_t *pxBucket;
+
+		/* A listening socket is found by its local port alone, any other
+		socket by its local port, remote IP address and remote port. */
+		if( pxSocket->u.xTCP.ucTCPState == ( uint8_t ) eTCP_LISTEN )
+		{
+			pxBucket = &( xTCPListenerHash[ socketHASH_PORT( pxSocket->usLocalPort ) ] );
+		}
+		else
+		{
+			pxBucket = &( xTCPConnectionHash[ socketHASH_CONNECTION( pxSocket->usLocalPort, pxSocket->u.xTCP.ulRemoteIP, pxSocket->u.xTCP.usRemotePort ) ] );
+		}
+
+		/* Only bound sockets are hashed.  vSocketClose() removes the socket
+		from its bucket when it unbinds it. */
+		if( ( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE ) &&
+			( listLIST_ITEM_CONTAINER( &( pxSocket->xHashListItem ) ) != pxBucket ) )
+		{
+			prvSocketHashRemove( pxSocket );
+			vListInsertEnd( pxBucket, &( pxSocket->xHashListItem ) );
+		}
+	}
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH == 1 ) )
+
+	void vSocketHashUpdate( FreeRTOS_Socket_t *pxSocket )
+	{
+		if( xIsCallingFromIPTask() != pdFALSE )
+		{
+			prvTCPSocketHashMove( pxSocket );
+		}
+		else
+		{
+			/* The IP-task might be searching the tables, so it is left to move
+			the socket itself. */
+			xTCPSocketHashStale = pdTRUE;
+		}
+	}
+
+#endif /* ( ipconfigUSE_TCP == 1 ) && ( ipconfigUSE_SOCKET_HASH == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ipconfigINCLUDE_FULL_INET_ADDR == 1
 
 	uint32_t FreeRTOS_inet_addr( const char * pcIPAddress )
@@ -1897,7 +2150,11 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 
 		vTaskSuspendAll();
 		{
+			#if( ipconfigUSE_SOCKET_HASH == 1 )
+			if( prvUDPSocketHashFind( usPortNr ) != NULL )
+			#else
 			if( ( pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) usPortNr ) != NULL ) )
+			#endif /* ipconfigUSE_SOCKET_HASH */
 			{
 				xFound = pdTRUE;
 			}
@@ -2814,6 +3071,77 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 	 * For a socket in listening mode, the remote port and IP address are both 0
 	 */
 	FreeRTOS_Socket_t *pxTCPSocketLookup( uint32_t ulLocalIP, UBaseType_t uxLocalPort, uint32_t ulRemoteIP, UBaseType_t uxRemotePort )
+	#if( ipconfigUSE_SOCKET_HASH == 1 )
+	{
+	const ListItem_t *pxIterator;
+	const MiniListItem_t *pxEnd;
+	const List_t *pxBucket;
+	FreeRTOS_Socket_t *pxResult = NULL;
+
+		/* Parameter not yet supported. */
+		( void ) ulLocalIP;
+
+		if( xTCPSocketHashStale != pdFALSE )
+		{
+			/* A socket changed state outside of the IP-task, move all sockets
+			to the buckets that match their current state and peer. */
+			xTCPSocketHashStale = pdFALSE;
+			pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( &xBoundTCPSocketsList );
+
+			for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+				 pxIterator != ( const ListItem_t * ) pxEnd;
+				 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+			{
+				prvTCPSocketHashMove( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+			}
+		}
+
+		/* For sockets not in listening mode, find a match with xLocalPort,
+		ulRemoteIP AND xRemotePort. */
+		pxBucket = &( xTCPConnectionHash[ socketHASH_CONNECTION( ( uint16_t ) uxLocalPort, ulRemoteIP, ( uint16_t ) uxRemotePort ) ] );
+		pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( pxBucket );
+
+		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+			 pxIterator != ( const ListItem_t * ) pxEnd;
+			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+		{
+			FreeRTOS_Socket_t *pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+			if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+				( pxSocket->u.xTCP.usRemotePort == ( uint16_t ) uxRemotePort ) &&
+				( pxSocket->u.xTCP.ulRemoteIP == ulRemoteIP ) &&
+				( pxSocket->u.xTCP.ucTCPState != ( uint8_t ) eTCP_LISTEN ) )
+			{
+				pxResult = pxSocket;
+				break;
+			}
+		}
+
+		if( pxResult == NULL )
+		{
+			/* An exact match was not found, look for a socket listening to
+			uxLocalPort. */
+			pxBucket = &( xTCPListenerHash[ socketHASH_PORT( ( uint16_t ) uxLocalPort ) ] );
+			pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( pxBucket );
+
+			for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+				 pxIterator != ( const ListItem_t * ) pxEnd;
+				 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+			{
+				FreeRTOS_Socket_t *pxSocket = ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+				if( ( pxSocket->usLocalPort == ( uint16_t ) uxLocalPort ) &&
+					( pxSocket->u.xTCP.ucTCPState == ( uint8_t ) eTCP_LISTEN ) )
+				{
+					pxResult = pxSocket;
+					break;
+				}
+			}
+		}
+
+		return pxResult;
+	}
+	#else
 	{
 	ListItem_t *pxIterator;
 	FreeRTOS_Socket_t *pxResult = NULL, *pxListenSocket = NULL;
@@ -2854,6 +3182,7 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t *pxSocket )
 
 		return pxResult;
 	}
+	#endif /* ipconfigUSE_SOCKET_HASH */
 
 #endif /* ipconfigUSE_TCP */
 /*-----------------------------------------------------------*/
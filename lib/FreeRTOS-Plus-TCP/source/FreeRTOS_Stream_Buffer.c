@@ -197,3 +197,111 @@ size_t uxSize, uxCount, uxFirst, uxNextTail;
 	return uxCount;
 }
 
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+
+	/*
+	 * Copy and checksum the part of the data that starts at uxPosition, and add
+	 * it to usSum.  When the part starts at an odd position, its bytes fall in
+	 * the other lanes of the 16-bit sum, which is the same as swapping the sum
+	 * before and after adding the part.
+	 */
+	static uint16_t prvCopyChecksum( uint16_t usSum, size_t uxPosition, uint8_t *pucTarget, const uint8_t *pucSource, size_t uxCount )
+	{
+		if( ( uxPosition & 1u ) != 0u )
+		{
+			usSum = ( uint16_t ) ( ( usSum << 8 ) | ( usSum >> 8 ) );
+		}
+
+		usSum = usGenerateChecksumCopy( ( uint32_t ) usSum, pucTarget, pucSource, uxCount );
+
+		if( ( uxPosition & 1u ) != 0u )
+		{
+			usSum = ( uint16_t ) ( ( usSum << 8 ) | ( usSum >> 8 ) );
+		}
+
+		return usSum;
+	}
+	/*-----------------------------------------------------------*/
+
+	/*
+	 * uxStreamBufferStage( )
+	 * Copies data to the space at uxHead, which will be added to the stream
+	 * buffer later when uxStreamBufferAdd() is called with pucData equal to
+	 * NULL.  None of the markers is moved, so the data can still be dropped.
+	 */
+	size_t uxStreamBufferStage( StreamBuffer_t *pxBuffer, const uint8_t *pucData, size_t uxCount, uint16_t *pusChecksum )
+	{
+	size_t uxHead, uxFirst;
+	uint16_t usSum = 0u;
+
+		uxCount = FreeRTOS_min_uint32( uxStreamBufferGetSpace( pxBuffer ), uxCount );
+
+		if( uxCount != 0u )
+		{
+			uxHead = pxBuffer->uxHead;
+			uxFirst = FreeRTOS_min_uint32( pxBuffer->LENGTH - uxHead, uxCount );
+
+			usSum = prvCopyChecksum( usSum, 0u, pxBuffer->ucArray + uxHead, pucData, uxFirst );
+
+			if( uxCount > uxFirst )
+			{
+				usSum = prvCopyChecksum( usSum, uxFirst, pxBuffer->ucArray, pucData + uxFirst, uxCount - uxFirst );
+			}
+		}
+
+		*pusChecksum = usSum;
+
+		return uxCount;
+	}
+	/*-----------------------------------------------------------*/
+
+	/*
+	 * uxStreamBufferPeekChecksum( )
+	 * Reads data located at uxOffset from uxTail like uxStreamBufferGet() does
+	 * in 'peek' mode, and adds it up while it is copied.
+	 */
+	size_t uxStreamBufferPeekChecksum( StreamBuffer_t *pxBuffer, size_t uxOffset, uint8_t *pucData, size_t uxMaxCount, uint16_t *pusChecksum )
+	{
+	size_t uxSize, uxCount, uxFirst, uxNextTail;
+	uint16_t usSum = 0u;
+
+		uxSize = uxStreamBufferGetSize( pxBuffer );
+
+		if( uxSize > uxOffset )
+		{
+			uxSize -= uxOffset;
+		}
+		else
+		{
+			uxSize = 0u;
+		}
+
+		uxCount = FreeRTOS_min_uint32( uxSize, uxMaxCount );
+
+		if( uxCount > 0u )
+		{
+			uxNextTail = pxBuffer->uxTail + uxOffset;
+
+			if( uxNextTail >= pxBuffer->LENGTH )
+			{
+				uxNextTail -= pxBuffer->LENGTH;
+			}
+
+			uxFirst = FreeRTOS_min_uint32( pxBuffer->LENGTH - uxNextTail, uxCount );
+
+			usSum = prvCopyChecksum( usSum, 0u, pucData, pxBuffer->ucArray + uxNextTail, uxFirst );
+
+			if( uxCount > uxFirst )
+			{
+				usSum = prvCopyChecksum( usSum, uxFirst, pucData + uxFirst, pxBuffer->ucArray, uxCount - uxFirst );
+			}
+		}
+
+		*pusChecksum = usSum;
+
+		return uxCount;
+	}
+
+#endif /* ipconfigUSE_CHECKSUM_COPY */
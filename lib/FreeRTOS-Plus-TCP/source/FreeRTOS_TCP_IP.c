@@ -312,6 +312,15 @@ static BaseType_t prvTCPHandleState( FreeRTOS_Socket_t *pxSocket, NetworkBufferD
  */
 static BaseType_t prvTCPSendReset( NetworkBufferDescriptor_t *pxNetworkBuffer );
 
+#if( ipconfigUSE_CHECKSUM_COPY != 0 ) && ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+	/*
+	 * Check the checksum of a received packet.  When the payload is the next
+	 * data that an established connection expects, it is copied to the rxStream
+	 * while it is added up, and prvStoreRxData() only has to advance uxHead.
+	 */
+	static BaseType_t prvTCPCheckChecksum( FreeRTOS_Socket_t *pxSocket, NetworkBufferDescriptor_t *pxNetworkBuffer );
+#endif /* ipconfigUSE_CHECKSUM_COPY */
+
 /*
  * Set the initial value for MSS (Maximum Segment Size) to be used.
  */
@@ -810,20 +819,20 @@ NetworkBufferDescriptor_t xTempBuffer;
 			highest sequence number minus 1 that the socket will accept. */
 			pxSocket->u.xTCP.ulHighestRxAllowed = pxTCPWindow->rx.ulCurrentSequenceNumber + ulSpace;
 
-			#if( ipconfigTCP_KEEP_ALIVE == 1 )
-				if( pxSocket->u.xTCP.bits.bSendKeepAlive != pdFALSE_UNSIGNED )
-				{
-					/* Sending a keep-alive packet, send the current sequence number
-					minus 1, which will	be recognised as a keep-alive packet an
-					responded to by acknowledging the last byte. */
-					pxSocket->u.xTCP.bits.bSendKeepAlive = pdFALSE_UNSIGNED;
-					pxSocket->u.xTCP.bits.bWaitKeepAlive = pdTRUE_UNSIGNED;
-
-					pxTCPPacket->xTCPHeader.ulSequenceNumber = pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber - 1UL;
-					pxTCPPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( pxTCPPacket->xTCPHeader.ulSequenceNumber );
-				}
-				else
-			#endif
+			/* Keep-alive messages are also used to probe a closed window, so
+			they are sent whether or not ipconfigTCP_KEEP_ALIVE is defined. */
+			if( pxSocket->u.xTCP.bits.bSendKeepAlive != pdFALSE_UNSIGNED )
+			{
+				/* Sending a keep-alive packet, send the current sequence number
+				minus 1, which will	be recognised as a keep-alive packet an
+				responded to by acknowledging the last byte. */
+				pxSocket->u.xTCP.bits.bSendKeepAlive = pdFALSE_UNSIGNED;
+				pxSocket->u.xTCP.bits.bWaitKeepAlive = pdTRUE_UNSIGNED;
+
+				pxTCPPacket->xTCPHeader.ulSequenceNumber = pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber - 1UL;
+				pxTCPPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( pxTCPPacket->xTCPHeader.ulSequenceNumber );
+			}
+			else
 			{
 				pxTCPPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber );
 
@@ -884,7 +893,27 @@ NetworkBufferDescriptor_t xTempBuffer;
 			pxIPHeader->usHeaderChecksum = ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
 
 			/* calculate the TCP checksum for an outgoing packet. */
-			usGenerateProtocolChecksum( (uint8_t*)pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+			#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+				if( ( pxSocket != NULL ) && ( pxSocket->u.xTCP.bits.bTxSummed != pdFALSE_UNSIGNED ) &&
+					( ( ulLen - ipSIZE_OF_IPv4_HEADER - ( ( pxTCPPacket->xTCPHeader.ucTCPOffset & VALID_BITS_IN_TCP_OFFSET_BYTE ) >> 2 ) ) == pxSocket->u.xTCP.usTxSumLength ) )
+				{
+					/* prvTCPPrepareSend() has added up the payload while it
+					copied it, only the headers have to be added. */
+					usGenerateProtocolChecksumPartial( (uint8_t*)pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE,
+						( size_t ) pxSocket->u.xTCP.usTxSumLength, pxSocket->u.xTCP.usTxSum );
+				}
+				else
+			#endif /* ipconfigUSE_CHECKSUM_COPY */
+			{
+				usGenerateProtocolChecksum( (uint8_t*)pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+			}
+
+			#if( ipconfigUSE_CHECKSUM_COPY != 0 )
+				if( pxSocket != NULL )
+				{
+					pxSocket->u.xTCP.bits.bTxSummed = pdFALSE_UNSIGNED;
+				}
+			#endif /* ipconfigUSE_CHECKSUM_COPY */
 
 			/* A calculated checksum of 0 must be inverted as 0 means the checksum
 			is disabled. */
@@ -964,6 +993,12 @@ static void prvTCPCreateWindow( FreeRTOS_Socket_t *pxSocket )
 		pxSocket->u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber,
 		pxSocket->u.xTCP.xTCPWindow.ulOurSequenceNumber,
 		( uint32_t ) pxSocket->u.xTCP.usInitMSS );
+
+	#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	{
+		( void ) xTCPWindowSetCongestionControl( &pxSocket->u.xTCP.xTCPWindow, ( BaseType_t ) pxSocket->u.xTCP.ucCongestionControl );
+	}
+	#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 }
 /*-----------------------------------------------------------*/
 
@@ -1568,6 +1603,14 @@ BaseType_t bAfter  = ( BaseType_t ) NOW_CONNECTED( eTCPState );						/* Is it co
 	/* Fill in the new state. */
 	pxSocket->u.xTCP.ucTCPState = ( uint8_t ) eTCPState;
 
+	#if( ipconfigUSE_SOCKET_HASH == 1 )
+	{
+		/* A listening socket is looked up by its port, any other socket by its
+		port and peer. */
+		vSocketHashUpdate( pxSocket );
+	}
+	#endif
+
 	/* touch the alive timers because moving to another state. */
 	prvTCPTouchSocket( pxSocket );
 
@@ -1730,7 +1773,20 @@ int32_t lStreamPos;
 
 				/* Here data is copied from the txStream in 'peek' mode.  Only
 				when the packets are acked, the tail marker will be updated. */
-				ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE );
+				#if( ipconfigUSE_CHECKSUM_COPY != 0 ) && ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+				{
+					/* The payload is added up while it is copied, so that
+					prvTCPReturnPacket() only has to add up the headers. */
+					ulDataGot = ( uint32_t ) uxStreamBufferPeekChecksum( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen,
+						&( pxSocket->u.xTCP.usTxSum ) );
+					pxSocket->u.xTCP.usTxSumLength = ( uint16_t ) ulDataGot;
+					pxSocket->u.xTCP.bits.bTxSummed = pdTRUE_UNSIGNED;
+				}
+				#else
+				{
+					ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE );
+				}
+				#endif /* ipconfigUSE_CHECKSUM_COPY */
 
 				#if( ipconfigHAS_DEBUG_PRINTF != 0 )
 				{
@@ -1830,6 +1886,20 @@ int32_t lStreamPos;
 		#endif /* ipconfigTCP_KEEP_ALIVE */
 	}
 
+	#if( ipconfigUSE_TCP_WIN == 1 )
+	{
+		if( ( lDataLen == 0 ) &&
+			( pxSocket->u.xTCP.ucTCPState >= eESTABLISHED ) &&
+			( xTCPWindowTxProbe( pxTCPWindow, pxSocket->u.xTCP.ulWindowSize ) != pdFALSE ) )
+		{
+			/* The peer's window is closed while data waits.  Probe it with a
+			keep-alive message: the peer answers with an ACK that advertises
+			its current window. */
+			pxSocket->u.xTCP.bits.bSendKeepAlive = pdTRUE_UNSIGNED;
+		}
+	}
+	#endif /* ipconfigUSE_TCP_WIN */
+
 	/* Anything to send, a change of the advertised window size, or maybe send a
 	keep-alive message? */
 	if( ( lDataLen > 0 ) ||
@@ -1887,10 +1957,11 @@ TickType_t ulDelayMs = ( TickType_t ) tcpMAXIMUM_TCP_WAKEUP_TIME_MS;
 			pxSocket->u.xTCP.ucRepCount, ulDelayMs ) );
 		pxSocket->u.xTCP.usTimeout = ( uint16_t )pdMS_TO_MIN_TICKS( ulDelayMs );
 	}
-	else if( pxSocket->u.xTCP.usTimeout == 0u )
+	else
 	{
 		/* Let the sliding window mechanism decide what time-out is appropriate. */
 		BaseType_t xResult = xTCPWindowTxHasData( &pxSocket->u.xTCP.xTCPWindow, pxSocket->u.xTCP.ulWindowSize, &ulDelayMs );
+		uint16_t usWindowTimeout;
 		if( ulDelayMs == 0u )
 		{
 			if( xResult != ( BaseType_t )0 )
@@ -1906,12 +1977,15 @@ TickType_t ulDelayMs = ( TickType_t ) tcpMAXIMUM_TCP_WAKEUP_TIME_MS;
 		{
 			/* ulDelayMs contains the time to wait before a re-transmission. */
 		}
-		pxSocket->u.xTCP.usTimeout = ( uint16_t )pdMS_TO_MIN_TICKS( ulDelayMs );
-	}
-	else
-	{
-		/* field '.usTimeout' has already been set (by the
-		keep-alive/delayed-ACK mechanism). */
+		usWindowTimeout = ( uint16_t )pdMS_TO_MIN_TICKS( ulDelayMs );
+
+		/* Field '.usTimeout' may have been set already, by the keep-alive or
+		delayed-ACK mechanism, or when nothing was to be sent.  Data sent since
+		then must still be retransmitted in time. */
+		if( ( pxSocket->u.xTCP.usTimeout == 0u ) || ( usWindowTimeout < pxSocket->u.xTCP.usTimeout ) )
+		{
+			pxSocket->u.xTCP.usTimeout = usWindowTimeout;
+		}
 	}
 
 	/* Return the number of clock ticks before the timer expires. */
@@ -2158,6 +2232,18 @@ BaseType_t xResult = 0;
 			if the head marker in rxStream may be advanced,	only if lOffset == 0.
 			In case the low-water mark is reached, bLowWater will be set
 			"low-water" here stands for "little space". */
+			#if( ipconfigUSE_CHECKSUM_COPY != 0 ) && ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+			{
+				if( ( lOffset == 0 ) && ( pxSocket->u.xTCP.bits.bRxStaged != pdFALSE_UNSIGNED ) )
+				{
+					/* prvTCPCheckChecksum() has copied the data to the position
+					of the head marker already. */
+					pucRecvData = NULL;
+				}
+				pxSocket->u.xTCP.bits.bRxStaged = pdFALSE_UNSIGNED;
+			}
+			#endif /* ipconfigUSE_CHECKSUM_COPY */
+
 			lStored = lTCPAddRxdata( pxSocket, ( uint32_t ) lOffset, pucRecvData, ulReceiveLength );
 
 			if( lStored != ( int32_t ) ulReceiveLength )
@@ -2862,6 +2948,59 @@ static BaseType_t prvTCPSendReset( NetworkBufferDescriptor_t *pxNetworkBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_CHECKSUM_COPY != 0 ) && ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+
+	static BaseType_t prvTCPCheckChecksum( FreeRTOS_Socket_t *pxSocket, NetworkBufferDescriptor_t *pxNetworkBuffer )
+	{
+	TCPPacket_t *pxTCPPacket = ( TCPPacket_t * ) ( pxNetworkBuffer->pucEthernetBuffer );
+	StreamBuffer_t *pxStream;
+	uint8_t *pucRecvData;
+	size_t uxLength, uxStaged = 0u;
+	uint16_t usStagedSum = 0u;
+	BaseType_t xResult = pdPASS;
+
+		if( pxSocket != NULL )
+		{
+			pxSocket->u.xTCP.bits.bRxStaged = pdFALSE_UNSIGNED;
+			pxStream = pxSocket->u.xTCP.rxStream;
+
+			/* Only payload that will be passed to the user at once, i.e. that
+			lTCPWindowRxCheck() will accept at offset 0 and that does not
+			overwrite out-of-order data, can be copied before the checksum is
+			known to be correct. */
+			if( ( pxSocket->u.xTCP.ucTCPState == ( uint8_t ) eESTABLISHED ) &&
+				( pxStream != NULL ) &&
+				( pxStream->uxFront == pxStream->uxHead ) &&
+				( ( pxTCPPacket->xTCPHeader.ucTCPFlags & ( ipTCP_FLAG_SYN | ipTCP_FLAG_RST | ipTCP_FLAG_URG ) ) == 0u ) &&
+				( FreeRTOS_ntohl( pxTCPPacket->xTCPHeader.ulSequenceNumber ) == pxSocket->u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber ) &&
+				( pxNetworkBuffer->xDataLength >= ( ipSIZE_OF_ETH_HEADER + ( size_t ) FreeRTOS_ntohs( pxTCPPacket->xIPHeader.usLength ) ) ) )
+			{
+				uxLength = ( size_t ) prvCheckRxData( pxNetworkBuffer, &pucRecvData );
+
+				if( ( uxLength != 0u ) && ( uxStreamBufferGetSpace( pxStream ) >= uxLength ) )
+				{
+					uxStaged = uxStreamBufferStage( pxStream, pucRecvData, uxLength, &usStagedSum );
+				}
+			}
+		}
+
+		if( usGenerateProtocolChecksumPartial( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdFALSE,
+			uxStaged, usStagedSum ) != ipCORRECT_CRC )
+		{
+			/* The copied payload, if any, is not added to the rxStream. */
+			xResult = pdFAIL;
+		}
+		else if( uxStaged != 0u )
+		{
+			pxSocket->u.xTCP.bits.bRxStaged = pdTRUE_UNSIGNED;
+		}
+
+		return xResult;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_CHECKSUM_COPY */
+
 static void prvSocketSetMSS( FreeRTOS_Socket_t *pxSocket )
 {
 uint32_t ulMSS = ipconfigTCP_MSS;
@@ -2919,6 +3058,17 @@ BaseType_t xResult = pdPASS;
 		return pdFAIL;
 	}
 
+	#if( ipconfigUSE_CHECKSUM_COPY != 0 ) && ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 )
+	{
+		/* prvAllowIPPacket() has left the checksum to be checked here, before
+		anything is done with the packet. */
+		if( prvTCPCheckChecksum( pxSocket, pxNetworkBuffer ) == pdFAIL )
+		{
+			return pdFAIL;
+		}
+	}
+	#endif /* ipconfigUSE_CHECKSUM_COPY */
+
 	if( ( pxSocket == NULL ) || ( prvTCPSocketIsActive( ( UBaseType_t ) pxSocket->u.xTCP.ucTCPState ) == pdFALSE ) )
 	{
 		/* A TCP messages is received but either there is no socket with the
@@ -3176,6 +3326,12 @@ struct freertos_sockaddr xAddress;
 	pxNewSocket->u.xTCP.uxRxWinSize  = pxSocket->u.xTCP.uxRxWinSize;
 	pxNewSocket->u.xTCP.uxTxWinSize  = pxSocket->u.xTCP.uxTxWinSize;
 
+	#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	{
+		pxNewSocket->u.xTCP.ucCongestionControl = pxSocket->u.xTCP.ucCongestionControl;
+	}
+	#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 	#if( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
 	{
 		pxNewSocket->pxUserSemaphore = pxSocket->pxUserSemaphore;
@@ -63,22 +63,28 @@
 
 	#define xTCPWindowTxNew( pxWindow, ulSequenceNumber, lCount ) xTCPWindowNew( pxWindow, ulSequenceNumber, lCount, pdFALSE )
 
-	/* The code to send a single Selective ACK (SACK):
-	 * NOP (0x01), NOP (0x01), SACK (0x05), LEN (0x0a),
-	 * followed by a lower and a higher sequence number,
-	 * where LEN is 2 + 2*4 = 10 bytes. */
+	/* The code to send a Selective ACK (SACK) with 'uxBlocks' blocks:
+	 * NOP (0x01), NOP (0x01), SACK (0x05), LEN,
+	 * followed by a lower and a higher sequence number for every block,
+	 * where LEN is 2 + uxBlocks*8 bytes, 0x0a for a single block. */
 	#if( ipconfigBYTE_ORDER == pdFREERTOS_BIG_ENDIAN )
-		#define OPTION_CODE_SINGLE_SACK		( 0x0101050aUL )
+		#define OPTION_CODE_SACK( uxBlocks )	( 0x01010500UL | ( 2UL + ( 8UL * ( uint32_t ) ( uxBlocks ) ) ) )
 	#else
-		#define OPTION_CODE_SINGLE_SACK		( 0x0a050101UL )
+		#define OPTION_CODE_SACK( uxBlocks )	( 0x00050101UL | ( ( 2UL + ( 8UL * ( uint32_t ) ( uxBlocks ) ) ) << 24 ) )
 	#endif
 
+	/* The sequence number that follows the range of data described by a
+	reception segment, and the height of a subtree of received ranges. */
+	#define winRX_RANGE_END( pxSegment )	( ( pxSegment )->ulSequenceNumber + ( uint32_t ) ( pxSegment )->lDataLength )
+	#define winRX_HEIGHT( pxSegment )		( ( ( pxSegment ) != NULL ) ? ( BaseType_t ) ( pxSegment )->u.bits.ucRxHeight : 0 )
+
 	/* Normal retransmission:
 	 * A packet will be retransmitted after a Retransmit Time-Out (RTO).
 	 * Fast retransmission:
-	 * When 3 packets with a higher sequence number have been acknowledged
-	 * by the peer, it is very unlikely a current packet will ever arrive.
-	 * It will be retransmitted far before the RTO.
+	 * When 3 packets with a higher sequence number, which were sent after the
+	 * packet was last sent, have been acknowledged by the peer, it is very
+	 * unlikely the packet will ever arrive.  It will be retransmitted far
+	 * before the RTO.
 	 */
 	#define	DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT		( 3u )
 
@@ -87,7 +93,38 @@
 	 */
 	#define MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW		( 4u )
 
+	/* When the peer's window is closed while data waits to be sent, it will be
+	 * probed after 1, 2, 4, ... times the SRTT.  The time is doubled at most
+	 * this many times.
+	 */
+	#define MAX_WINDOW_PROBE_BACKOFF					( 7u )
+
 #endif /* configUSE_TCP_WIN */
+
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	/* The initial congestion window, 2 to 4 segments depending on the MSS
+	(RFC 5681, section 3.1). */
+	#define winINITIAL_CONGESTION_WINDOW( ulMSS )	\
+		( ( ( ulMSS ) > 2190UL ) ? ( 2UL * ( ulMSS ) ) : ( ( ( ulMSS ) > 1095UL ) ? ( 3UL * ( ulMSS ) ) : ( 4UL * ( ulMSS ) ) ) )
+
+	/* During slow start, an ACK grows the congestion window by at most 2 * MSS,
+	however much data it acknowledges (RFC 3465). */
+	#define winSLOW_START_LIMIT						( 2UL )
+
+	/* CUBIC multiplies the window by beta = 0.7 when a segment is lost. */
+	#define winCUBIC_BETA_NUMERATOR					( 7UL )
+	#define winCUBIC_BETA_DENOMINATOR				( 10UL )
+
+	/* The cubic function grows C = 0.4 segments per second cubed.  With the
+	time in ms this is one segment per 2.5e9 ms cubed. */
+	#define winCUBIC_MS3_PER_SEGMENT				( 2500000000ULL )
+
+	/* The distance in ms to the plateau of the cubic function is capped, so
+	that its cube times the MSS fits in 64 bits. */
+	#define winCUBIC_MAX_DISTANCE_MS				( 50000UL )
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 /*-----------------------------------------------------------*/
 
 extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewListItem, MiniListItem_t * const pxWhere );
@@ -105,11 +142,66 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
- * Find a segment with a given sequence number in the list of received
- * segments: 'pxWindow->xRxSegments'.
+ * Received data that could not be passed to the user yet is described by
+ * reception segments, each covering a range of data that has arrived.  The
+ * ranges never overlap or touch, and they are kept in an AVL tree sorted on
+ * sequence number: 'pxWindow->pxRxRoot'.  Find the range with the highest
+ * sequence number not above 'ulSequenceNumber'.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static TCPSegment_t *xTCPWindowRxFindRange( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * Find the received range with the lowest sequence number above
+ * 'ulSequenceNumber'.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static TCPSegment_t *xTCPWindowRxFindNext( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * Add a range to, or remove one from, the tree of received ranges with root
+ * 'pxNode'.  Both return the new root of the tree.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static TCPSegment_t *prvRxTreeInsert( TCPSegment_t *pxNode, TCPSegment_t *pxNew );
+	static TCPSegment_t *prvRxTreeRemove( TCPSegment_t *pxNode, const TCPSegment_t *pxSegment );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * Helpers of prvRxTreeInsert() and prvRxTreeRemove(): detach the lowest
+ * range of a subtree, rotate a subtree, and restore the balance of a subtree
+ * after one of its children has grown or shrunk.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static TCPSegment_t *prvRxTreeRemoveLowest( TCPSegment_t *pxNode, TCPSegment_t **ppxLowest );
+	static TCPSegment_t *prvRxTreeRotate( TCPSegment_t *pxNode, BaseType_t xToLeft );
+	static TCPSegment_t *prvRxTreeBalance( TCPSegment_t *pxNode );
+	static void prvRxTreeSetHeight( TCPSegment_t *pxNode );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * Take a received range out of the tree and return it to the segment pool.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static void prvTCPWindowRxRelease( TCPWindow_t *pxWindow, TCPSegment_t *pxSegment );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * The range 'pxRange' has grown: absorb the ranges that it now overlaps or
+ * touches.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static void prvTCPWindowRxMerge( TCPWindow_t *pxWindow, TCPSegment_t *pxRange );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/*
+ * Prepare the SACK option, reporting 'pxRange' followed by the ranges that
+ * were reported most recently.
  */
 #if( ipconfigUSE_TCP_WIN == 1 )
-	static TCPSegment_t *xTCPWindowRxFind( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber );
+	static void prvTCPWindowRxSack( TCPWindow_t *pxWindow, const TCPSegment_t *pxRange );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
 /*
@@ -153,18 +245,6 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 	static void vTCPWindowFree( TCPSegment_t *pxSegment );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
-/*
- * A segment has been received with sequence number 'ulSequenceNumber', where
- * 'ulCurrentSequenceNumber == ulSequenceNumber', which means that exactly this
- * segment was expected.  xTCPWindowRxConfirm() will check if there is already
- * another segment with a sequence number between (ulSequenceNumber) and
- * (ulSequenceNumber+xLength).  Normally none will be found, because the next Rx
- * segment should have a sequence number equal to '(ulSequenceNumber+xLength)'.
- */
-#if( ipconfigUSE_TCP_WIN == 1 )
-	static TCPSegment_t *xTCPWindowRxConfirm( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber, uint32_t ulLength );
-#endif /* ipconfigUSE_TCP_WIN == 1 */
-
 /*
  * FreeRTOS+TCP stores data in circular buffers.  Calculate the next position to
  * store.
@@ -181,6 +261,14 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 	static BaseType_t prvTCPWindowTxHasSpace( TCPWindow_t *pxWindow, uint32_t ulWindowSize );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
+/*
+ * The peer's window is closed while data waits to be sent.  Returns the number
+ * of ms until the window must be probed, zero when the probe is due.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 )
+	static uint32_t prvTCPWindowProbeDelay( TCPWindow_t *pxWindow );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
 /*
  * An acknowledge was received.  See if some outstanding data may be removed
  * from the transmission queue(s).
@@ -191,12 +279,52 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 
 /*
  * A higher Tx block has been acknowledged.  Now iterate through the xWaitQueue
- * to find a possible condition for a FAST retransmission.
+ * to find the segments that are lost, and move them to the priority queue for
+ * a FAST retransmission.
  */
 #if( ipconfigUSE_TCP_WIN == 1 )
-	static uint32_t prvTCPWindowFastRetransmit( TCPWindow_t *pxWindow, uint32_t ulFirst );
+	static uint32_t prvTCPWindowFastRetransmit( TCPWindow_t *pxWindow );
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 
+/*
+ * Data has been acknowledged: 'ulConfirmed' bytes at the left side of the
+ * transmission window, and 'ulSacked' bytes to the right of it by a selective
+ * ACK.  Grow the congestion window, or during fast recovery, inflate it and
+ * retransmit the next segment after a partial ACK.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	static void prvTCPWindowCongestionAck( TCPWindow_t *pxWindow, uint32_t ulConfirmed, uint32_t ulSacked );
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+/*
+ * A segment is retransmitted by a fast retransmission: start fast recovery,
+ * unless the loss belongs to a window of data that has been reduced already.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	static void prvTCPWindowCongestionLoss( TCPWindow_t *pxWindow );
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+/*
+ * A segment is retransmitted because its retransmission timer expired: the
+ * congestion window falls back to a single segment.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	static void prvTCPWindowCongestionTimeout( TCPWindow_t *pxWindow );
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+/*
+ * The congestion control algorithms: NewReno and CUBIC.
+ */
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	static void prvNewRenoInit( TCPWindow_t *pxWindow );
+	static uint32_t prvNewRenoSlowStartThreshold( TCPWindow_t *pxWindow );
+	static void prvNewRenoCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulAckedBytes, uint32_t ulTimeMS );
+	static void prvCubicInit( TCPWindow_t *pxWindow );
+	static uint32_t prvCubicSlowStartThreshold( TCPWindow_t *pxWindow );
+	static void prvCubicCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulAckedBytes, uint32_t ulTimeMS );
+	static uint32_t prvCubeRoot( uint64_t ullValue );
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 /*-----------------------------------------------------------*/
 
 /* TCP segment pool. */
@@ -212,6 +340,15 @@ extern void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewL
 /* Logging verbosity level. */
 BaseType_t xTCPWindowLoggingLevel = 0;
 
+/* The congestion control algorithms that can be selected. */
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	static const TCPCongestionControl_t xCongestionControls[] =
+	{
+		{ FREERTOS_TCP_CONGESTION_NEWRENO, prvNewRenoInit, prvNewRenoSlowStartThreshold, prvNewRenoCongestionAvoidance },
+		{ FREERTOS_TCP_CONGESTION_CUBIC, prvCubicInit, prvCubicSlowStartThreshold, prvCubicCongestionAvoidance }
+	};
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 #if( ipconfigUSE_TCP_WIN == 1 )
 	/* Some 32-bit arithmetic: comparing sequence numbers */
 	static portINLINE BaseType_t xSequenceLessThanOrEqual( uint32_t a, uint32_t b );
@@ -343,27 +480,50 @@ void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewListItem
 
 #if( ipconfigUSE_TCP_WIN == 1 )
 
-	static TCPSegment_t *xTCPWindowRxFind( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber )
+	static TCPSegment_t *xTCPWindowRxFindRange( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber )
 	{
-	const ListItem_t *pxIterator;
-	const MiniListItem_t* pxEnd;
-	TCPSegment_t *pxSegment, *pxReturn = NULL;
+	TCPSegment_t *pxNode = pxWindow->pxRxRoot, *pxReturn = NULL;
 
-		/* Find a segment with a given sequence number in the list of received
-		segments. */
+		/* Find the received range with the highest sequence number not above
+		'ulSequenceNumber'.  If it ends after 'ulSequenceNumber', it holds
+		that byte. */
+		while( pxNode != NULL )
+		{
+			if( xSequenceGreaterThan( pxNode->ulSequenceNumber, ulSequenceNumber ) != pdFALSE )
+			{
+				pxNode = pxNode->pxRxLeft;
+			}
+			else
+			{
+				pxReturn = pxNode;
+				pxNode = pxNode->pxRxRight;
+			}
+		}
 
-		pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( &pxWindow->xRxSegments );
+		return pxReturn;
+	}
 
-		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
-			 pxIterator != ( const ListItem_t * ) pxEnd;
-			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
-		{
-			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static TCPSegment_t *xTCPWindowRxFindNext( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber )
+	{
+	TCPSegment_t *pxNode = pxWindow->pxRxRoot, *pxReturn = NULL;
 
-			if( pxSegment->ulSequenceNumber == ulSequenceNumber )
+		/* Find the received range with the lowest sequence number above
+		'ulSequenceNumber'. */
+		while( pxNode != NULL )
+		{
+			if( xSequenceGreaterThan( pxNode->ulSequenceNumber, ulSequenceNumber ) != pdFALSE )
 			{
-				pxReturn = pxSegment;
-				break;
+				pxReturn = pxNode;
+				pxNode = pxNode->pxRxLeft;
+			}
+			else
+			{
+				pxNode = pxNode->pxRxRight;
 			}
 		}
 
@@ -373,6 +533,274 @@ void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewListItem
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static void prvRxTreeSetHeight( TCPSegment_t *pxNode )
+	{
+	BaseType_t xLeft = winRX_HEIGHT( pxNode->pxRxLeft );
+	BaseType_t xRight = winRX_HEIGHT( pxNode->pxRxRight );
+
+		pxNode->u.bits.ucRxHeight = ( uint32_t ) ( ( xLeft > xRight ) ? xLeft : xRight ) + 1u;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static TCPSegment_t *prvRxTreeRotate( TCPSegment_t *pxNode, BaseType_t xToLeft )
+	{
+	TCPSegment_t *pxChild;
+
+		if( xToLeft != pdFALSE )
+		{
+			/* The right child takes the place of 'pxNode', which becomes its
+			left child. */
+			pxChild = pxNode->pxRxRight;
+			pxNode->pxRxRight = pxChild->pxRxLeft;
+			pxChild->pxRxLeft = pxNode;
+		}
+		else
+		{
+			/* The left child takes the place of 'pxNode', which becomes its
+			right child. */
+			pxChild = pxNode->pxRxLeft;
+			pxNode->pxRxLeft = pxChild->pxRxRight;
+			pxChild->pxRxRight = pxNode;
+		}
+
+		prvRxTreeSetHeight( pxNode );
+		prvRxTreeSetHeight( pxChild );
+
+		return pxChild;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static TCPSegment_t *prvRxTreeBalance( TCPSegment_t *pxNode )
+	{
+	BaseType_t xBalance;
+
+		/* The heights of the two subtrees of 'pxNode' differ by 2 at most.
+		If they do, one or two rotations make them differ by 1 at most. */
+		prvRxTreeSetHeight( pxNode );
+		xBalance = winRX_HEIGHT( pxNode->pxRxLeft ) - winRX_HEIGHT( pxNode->pxRxRight );
+
+		if( xBalance > 1 )
+		{
+			if( winRX_HEIGHT( pxNode->pxRxLeft->pxRxLeft ) < winRX_HEIGHT( pxNode->pxRxLeft->pxRxRight ) )
+			{
+				pxNode->pxRxLeft = prvRxTreeRotate( pxNode->pxRxLeft, pdTRUE );
+			}
+
+			pxNode = prvRxTreeRotate( pxNode, pdFALSE );
+		}
+		else if( xBalance < -1 )
+		{
+			if( winRX_HEIGHT( pxNode->pxRxRight->pxRxRight ) < winRX_HEIGHT( pxNode->pxRxRight->pxRxLeft ) )
+			{
+				pxNode->pxRxRight = prvRxTreeRotate( pxNode->pxRxRight, pdFALSE );
+			}
+
+			pxNode = prvRxTreeRotate( pxNode, pdTRUE );
+		}
+
+		return pxNode;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static TCPSegment_t *prvRxTreeInsert( TCPSegment_t *pxNode, TCPSegment_t *pxNew )
+	{
+		/* The recursion is as deep as the tree is high, which is less than
+		1.45 * log2( ipconfigTCP_WIN_SEG_COUNT + 2 ). */
+		if( pxNode == NULL )
+		{
+			pxNew->pxRxLeft = NULL;
+			pxNew->pxRxRight = NULL;
+			pxNew->u.bits.ucRxHeight = 1u;
+			pxNode = pxNew;
+		}
+		else
+		{
+			if( xSequenceLessThan( pxNew->ulSequenceNumber, pxNode->ulSequenceNumber ) != pdFALSE )
+			{
+				pxNode->pxRxLeft = prvRxTreeInsert( pxNode->pxRxLeft, pxNew );
+			}
+			else
+			{
+				pxNode->pxRxRight = prvRxTreeInsert( pxNode->pxRxRight, pxNew );
+			}
+
+			pxNode = prvRxTreeBalance( pxNode );
+		}
+
+		return pxNode;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static TCPSegment_t *prvRxTreeRemoveLowest( TCPSegment_t *pxNode, TCPSegment_t **ppxLowest )
+	{
+		if( pxNode->pxRxLeft == NULL )
+		{
+			*ppxLowest = pxNode;
+			pxNode = pxNode->pxRxRight;
+		}
+		else
+		{
+			pxNode->pxRxLeft = prvRxTreeRemoveLowest( pxNode->pxRxLeft, ppxLowest );
+			pxNode = prvRxTreeBalance( pxNode );
+		}
+
+		return pxNode;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static TCPSegment_t *prvRxTreeRemove( TCPSegment_t *pxNode, const TCPSegment_t *pxSegment )
+	{
+	TCPSegment_t *pxLowest, *pxRight;
+
+		configASSERT( pxNode != NULL );
+
+		if( pxNode == pxSegment )
+		{
+			if( pxNode->pxRxRight == NULL )
+			{
+				pxNode = pxNode->pxRxLeft;
+			}
+			else
+			{
+				/* The lowest range of the right subtree takes its place. */
+				pxRight = prvRxTreeRemoveLowest( pxNode->pxRxRight, &pxLowest );
+				pxLowest->pxRxLeft = pxNode->pxRxLeft;
+				pxLowest->pxRxRight = pxRight;
+				pxNode = prvRxTreeBalance( pxLowest );
+			}
+		}
+		else
+		{
+			if( xSequenceLessThan( pxSegment->ulSequenceNumber, pxNode->ulSequenceNumber ) != pdFALSE )
+			{
+				pxNode->pxRxLeft = prvRxTreeRemove( pxNode->pxRxLeft, pxSegment );
+			}
+			else
+			{
+				pxNode->pxRxRight = prvRxTreeRemove( pxNode->pxRxRight, pxSegment );
+			}
+
+			pxNode = prvRxTreeBalance( pxNode );
+		}
+
+		return pxNode;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static void prvTCPWindowRxRelease( TCPWindow_t *pxWindow, TCPSegment_t *pxSegment )
+	{
+		pxWindow->pxRxRoot = prvRxTreeRemove( pxWindow->pxRxRoot, pxSegment );
+		vTCPWindowFree( pxSegment );
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static void prvTCPWindowRxMerge( TCPWindow_t *pxWindow, TCPSegment_t *pxRange )
+	{
+	TCPSegment_t *pxNext;
+	uint32_t ulLast = winRX_RANGE_END( pxRange );
+
+		/* The ranges that start within 'pxRange', or right after it, are
+		absorbed.  Every range is absorbed only once, so the cost of merging
+		is spread over the insertions. */
+		while( ( ( pxNext = xTCPWindowRxFindNext( pxWindow, pxRange->ulSequenceNumber ) ) != NULL ) &&
+			   ( xSequenceGreaterThan( pxNext->ulSequenceNumber, ulLast ) == pdFALSE ) )
+		{
+			if( xSequenceGreaterThan( winRX_RANGE_END( pxNext ), ulLast ) != pdFALSE )
+			{
+				ulLast = winRX_RANGE_END( pxNext );
+			}
+
+			prvTCPWindowRxRelease( pxWindow, pxNext );
+		}
+
+		pxRange->lDataLength = ( int32_t ) ( ulLast - pxRange->ulSequenceNumber );
+		pxRange->lMaxLength = pxRange->lDataLength;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static void prvTCPWindowRxSack( TCPWindow_t *pxWindow, const TCPSegment_t *pxRange )
+	{
+	const TCPSegment_t *pxBlocks[ ipconfigTCP_SACK_BLOCKS ];
+	const TCPSegment_t *pxOther;
+	UBaseType_t uxBlocks = 0u, uxIndex, uxCheck;
+
+		/* The first block reports the range that holds the segment which
+		has just arrived (RFC 2018). */
+		pxBlocks[ uxBlocks++ ] = pxRange;
+
+		/* The other blocks repeat the ranges reported most recently, unless
+		they have been passed to the user or merged into another block since.
+		Each history entry is a sequence number within such a range. */
+		for( uxIndex = 0u; ( uxIndex < pxWindow->uxSackHistoryCount ) && ( uxBlocks < ( UBaseType_t ) ipconfigTCP_SACK_BLOCKS ); uxIndex++ )
+		{
+			pxOther = xTCPWindowRxFindRange( pxWindow, pxWindow->ulSackHistory[ uxIndex ] );
+
+			if( ( pxOther != NULL ) && ( xSequenceLessThan( pxWindow->ulSackHistory[ uxIndex ], winRX_RANGE_END( pxOther ) ) != pdFALSE ) )
+			{
+				for( uxCheck = 0u; ( uxCheck < uxBlocks ) && ( pxBlocks[ uxCheck ] != pxOther ); uxCheck++ )
+				{
+				}
+
+				if( uxCheck == uxBlocks )
+				{
+					pxBlocks[ uxBlocks++ ] = pxOther;
+				}
+			}
+		}
+
+		for( uxIndex = 0u; uxIndex < uxBlocks; uxIndex++ )
+		{
+			/* The first sequence number received, and the last + 1. */
+			pxWindow->ulOptionsData[ 1u + ( 2u * uxIndex ) ] = FreeRTOS_htonl( pxBlocks[ uxIndex ]->ulSequenceNumber );
+			pxWindow->ulOptionsData[ 2u + ( 2u * uxIndex ) ] = FreeRTOS_htonl( winRX_RANGE_END( pxBlocks[ uxIndex ] ) );
+			pxWindow->ulSackHistory[ uxIndex ] = pxBlocks[ uxIndex ]->ulSequenceNumber;
+		}
+
+		pxWindow->uxSackHistoryCount = uxBlocks;
+
+		/* Code OPTION_CODE_SACK() is already in network byte order.  A single
+		block makes 12 (3*4) option bytes, every other block adds 8. */
+		pxWindow->ulOptionsData[ 0 ] = OPTION_CODE_SACK( uxBlocks );
+		pxWindow->ucOptionLength = ( uint8_t ) ( ( 1u + ( 2u * uxBlocks ) ) * sizeof( pxWindow->ulOptionsData[ 0 ] ) );
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
 #if( ipconfigUSE_TCP_WIN == 1 )
 
 	static TCPSegment_t *xTCPWindowNew( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber, int32_t lCount, BaseType_t xIsForRx )
@@ -580,6 +1008,10 @@ void vListInsertGeneric( List_t * const pxList, ListItem_t * const pxNewListItem
 				}
 			}
 		}
+
+		/* All received ranges have been returned to the pool. */
+		pxWindow->pxRxRoot = NULL;
+		pxWindow->uxSackHistoryCount = 0u;
 	}
 
 #endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -599,6 +1031,8 @@ void vTCPWindowCreate( TCPWindow_t *pxWindow, uint32_t ulRxWindowLength,
 
 		vListInitialise( &pxWindow->xTxSegments );
 		vListInitialise( &pxWindow->xRxSegments );
+		pxWindow->pxRxRoot = NULL;
+		pxWindow->uxSackHistoryCount = 0u;
 
 		vListInitialise( &pxWindow->xPriorityQueue );			/* Priority queue: segments which must be sent immediately */
 		vListInitialise( &pxWindow->xTxQueue   );			/* Transmit queue: segments queued for transmission */
@@ -670,9 +1104,51 @@ const int32_t l500ms = 500;
 	/* The right-hand side of the transmit window. */
 	pxWindow->tx.ulHighestSequenceNumber = ulSequenceNumber;
 	pxWindow->ulOurSequenceNumber = ulSequenceNumber;
+
+	#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+	{
+		if( pxWindow->pxCongestionControl == NULL )
+		{
+			( void ) xTCPWindowSetCongestionControl( pxWindow, ipconfigTCP_CONGESTION_CONTROL );
+		}
+
+		/* Start in slow start, with an infinite threshold. */
+		pxWindow->ulCongestionWindow = winINITIAL_CONGESTION_WINDOW( ( uint32_t ) pxWindow->usMSS );
+		pxWindow->ulSlowStartThreshold = 0xFFFFFFFFUL;
+		pxWindow->ulAckedBytes = 0UL;
+		pxWindow->ulRecoverSequenceNumber = ulSequenceNumber;
+		pxWindow->pxCongestionControl->pxInit( pxWindow );
+	}
+	#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 }
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	BaseType_t xTCPWindowSetCongestionControl( TCPWindow_t *pxWindow, BaseType_t xAlgorithm )
+	{
+	BaseType_t xIndex;
+	BaseType_t xReturn = pdFAIL;
+
+		for( xIndex = 0; xIndex < ( BaseType_t ) ( sizeof( xCongestionControls ) / sizeof( xCongestionControls[ 0 ] ) ); xIndex++ )
+		{
+			if( xCongestionControls[ xIndex ].xAlgorithm == xAlgorithm )
+			{
+				/* The congestion window and threshold are kept, only the
+				algorithm's own state starts afresh. */
+				pxWindow->pxCongestionControl = &( xCongestionControls[ xIndex ] );
+				pxWindow->pxCongestionControl->pxInit( pxWindow );
+				xReturn = pdPASS;
+				break;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
 #if( ipconfigUSE_TCP_WIN == 1 )
 
     void vTCPSegmentCleanup( void )
@@ -705,64 +1181,6 @@ const int32_t l500ms = 500;
  *
  *=============================================================================*/
 
-#if( ipconfigUSE_TCP_WIN == 1 )
-
-	static TCPSegment_t *xTCPWindowRxConfirm( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber, uint32_t ulLength )
-	{
-	TCPSegment_t *pxBest = NULL;
-	const ListItem_t *pxIterator;
-	uint32_t ulNextSequenceNumber = ulSequenceNumber + ulLength;
-	const MiniListItem_t* pxEnd = ( const MiniListItem_t* ) listGET_END_MARKER( &pxWindow->xRxSegments );
-	TCPSegment_t *pxSegment;
-
-		/* A segment has been received with sequence number 'ulSequenceNumber',
-		where 'ulCurrentSequenceNumber == ulSequenceNumber', which means that
-		exactly this segment was expected.  xTCPWindowRxConfirm() will check if
-		there is already another segment with a sequence number between (ulSequenceNumber)
-		and (ulSequenceNumber+ulLength).  Normally none will be found, because
-		the next RX segment should have a sequence number equal to
-		'(ulSequenceNumber+ulLength)'. */
-
-		/* Iterate through all RX segments that are stored: */
-		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
-			 pxIterator != ( const ListItem_t * ) pxEnd;
-			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
-		{
-			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
-			/* And see if there is a segment for which:
-			'ulSequenceNumber' <= 'pxSegment->ulSequenceNumber' < 'ulNextSequenceNumber'
-			If there are more matching segments, the one with the lowest sequence number
-			shall be taken */
-			if( ( xSequenceGreaterThanOrEqual( pxSegment->ulSequenceNumber, ulSequenceNumber ) != 0 ) &&
-				( xSequenceLessThan( pxSegment->ulSequenceNumber, ulNextSequenceNumber ) != 0 ) )
-			{
-				if( ( pxBest == NULL ) || ( xSequenceLessThan( pxSegment->ulSequenceNumber, pxBest->ulSequenceNumber ) != 0 ) )
-				{
-					pxBest = pxSegment;
-				}
-			}
-		}
-
-		if( ( pxBest != NULL ) &&
-			( ( pxBest->ulSequenceNumber != ulSequenceNumber ) || ( pxBest->lDataLength != ( int32_t ) ulLength ) ) )
-		{
-			FreeRTOS_flush_logging();
-			FreeRTOS_debug_printf( ( "xTCPWindowRxConfirm[%u]: search %lu (+%ld=%lu) found %lu (+%ld=%lu)\n",
-				pxWindow->usPeerPortNumber,
-				ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-				ulLength,
-				ulSequenceNumber + ulLength - pxWindow->rx.ulFirstSequenceNumber,
-				pxBest->ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-				pxBest->lDataLength,
-				pxBest->ulSequenceNumber + ( ( uint32_t ) pxBest->lDataLength ) - pxWindow->rx.ulFirstSequenceNumber ) );
-		}
-
-		return pxBest;
-	}
-
-#endif /* ipconfgiUSE_TCP_WIN == 1 */
-/*-----------------------------------------------------------*/
-
 #if( ipconfigUSE_TCP_WIN == 1 )
 
 	int32_t lTCPWindowRxCheck( TCPWindow_t *pxWindow, uint32_t ulSequenceNumber, uint32_t ulLength, uint32_t ulSpace )
@@ -801,34 +1219,24 @@ const int32_t l500ms = 500;
 			{
 				ulCurrentSequenceNumber += ulLength;
 
-				if( listCURRENT_LIST_LENGTH( &( pxWindow->xRxSegments ) ) != 0 )
+				if( pxWindow->pxRxRoot != NULL )
 				{
 					ulSavedSequenceNumber = ulCurrentSequenceNumber;
 
-                    /* Clean up all sequence received between ulSequenceNumber and ulSequenceNumber + ulLength since they are duplicated.
-                    If the server is forced to retransmit packets several time in a row it might send a batch of concatenated packet for speed.
-                    So we cannot rely on the packets between ulSequenceNumber and ulSequenceNumber + ulLength to be sequential and it is better to just
-                    clean them out. */
-                    do
-                    {
-                        pxFound = xTCPWindowRxConfirm( pxWindow, ulSequenceNumber, ulLength );
-
-                        if ( pxFound != NULL )
-                        {
-                            /* Remove it because it will be passed to user directly. */
-                            vTCPWindowFree( pxFound );
-                        }
-                    } while ( pxFound );
-
-					/*  Check for following segments that are already in the
-					queue and increment ulCurrentSequenceNumber. */
-					while( ( pxFound = xTCPWindowRxFind( pxWindow, ulCurrentSequenceNumber ) ) != NULL )
+					/* The received ranges that start within this packet, or
+					right after it, may now be passed to the user as well.
+					The peer may have retransmitted several segments as one
+					packet, so a range can also lie within this packet, in
+					which case it was a duplicate.  Each range that has been
+					passed to the user can be discarded. */
+					while( ( pxFound = xTCPWindowRxFindRange( pxWindow, ulCurrentSequenceNumber ) ) != NULL )
 					{
-						ulCurrentSequenceNumber += ( uint32_t ) pxFound->lDataLength;
+						if( xSequenceGreaterThan( winRX_RANGE_END( pxFound ), ulCurrentSequenceNumber ) != pdFALSE )
+						{
+							ulCurrentSequenceNumber = winRX_RANGE_END( pxFound );
+						}
 
-						/* As all packet below this one have been passed to the
-						user it can be discarded. */
-						vTCPWindowFree( pxFound );
+						prvTCPWindowRxRelease( pxWindow, pxFound );
 					}
 
 					if( ulSavedSequenceNumber != ulCurrentSequenceNumber )
@@ -886,51 +1294,43 @@ const int32_t l500ms = 500;
 				FreeRTOS_debug_printf( ( "lTCPWindowRxCheck: Refuse %lu+%lu bytes, due to lack of space (%lu)\n", lDistance, ulLength, ulSpace ) );
 				lReturn = -1;
 			}
+			else if( xSequenceLessThan( ulSequenceNumber, ulCurrentSequenceNumber ) != pdFALSE )
+			{
+				/* The packet starts with data that has been accepted already,
+				and it can not be stored at a negative offset.  The peer will
+				retransmit the missing data from rx.ulCurrentSequenceNumber
+				on. */
+				lReturn = -1;
+			}
 			else
 			{
-				/* See if there is more data in a contiguous block to make the
-				SACK describe a longer range of data. */
+				/* Look for a range received earlier that this packet overlaps
+				or extends.  The SACK describes the whole range.
 
-				/* TODO: SACK's may also be delayed for a short period
-				 * This is useful because subsequent packets will be SACK'd with
-				 * single one message
-				 */
-				while( ( pxFound = xTCPWindowRxFind( pxWindow, ulLast ) ) != NULL )
-				{
-					ulLast += ( uint32_t ) pxFound->lDataLength;
-				}
+				TODO: SACK's may also be delayed for a short period
+				This is useful because subsequent packets will be SACK'd with
+				single one message */
+				pxFound = xTCPWindowRxFindRange( pxWindow, ulSequenceNumber );
 
-				if( xTCPWindowLoggingLevel >= 1 )
+				if( ( pxFound != NULL ) && ( xSequenceLessThan( winRX_RANGE_END( pxFound ), ulSequenceNumber ) == pdFALSE ) )
 				{
-					FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%d,%d]: seqnr %lu exp %lu (dist %ld) SACK to %lu\n",
-						pxWindow->usPeerPortNumber, pxWindow->usOurPortNumber,
-						ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-						ulCurrentSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
-						( BaseType_t ) ( ulSequenceNumber - ulCurrentSequenceNumber ),	/* want this signed */
-						ulLast - pxWindow->rx.ulFirstSequenceNumber ) );
-				}
-
-				/* Now prepare the SACK message.
-				Code OPTION_CODE_SINGLE_SACK already in network byte order. */
-				pxWindow->ulOptionsData[0] = OPTION_CODE_SINGLE_SACK;
-
-				/* First sequence number that we received. */
-				pxWindow->ulOptionsData[1] = FreeRTOS_htonl( ulSequenceNumber );
-
-				/* Last + 1 */
-				pxWindow->ulOptionsData[2] = FreeRTOS_htonl( ulLast );
-
-				/* Which make 12 (3*4) option bytes. */
-				pxWindow->ucOptionLength = 3 * sizeof( pxWindow->ulOptionsData[ 0 ] );
-
-				pxFound = xTCPWindowRxFind( pxWindow, ulSequenceNumber );
-
-				if( pxFound != NULL )
-				{
-					/* This out-of-sequence packet has been received for a
-					second time.  It is already stored but do send a SACK
-					again. */
-					lReturn = -1;
+					if( xSequenceLessThan( winRX_RANGE_END( pxFound ), ulLast ) == pdFALSE )
+					{
+						/* This out-of-sequence packet has been received for a
+						second time.  It is already stored but do send a SACK
+						again. */
+						lReturn = -1;
+					}
+					else
+					{
+						/* The range grows, and may now reach the next one. */
+						pxFound->lDataLength = ( int32_t ) ( ulLast - pxFound->ulSequenceNumber );
+						prvTCPWindowRxMerge( pxWindow, pxFound );
+
+						/* Return a positive value.  The packet may be accepted
+						and stored but an earlier packet is still missing. */
+						lReturn = ( int32_t ) ( ulSequenceNumber - ulCurrentSequenceNumber );
+					}
 				}
 				else
 				{
@@ -938,16 +1338,16 @@ const int32_t l500ms = 500;
 
 					if( pxFound == NULL )
 					{
-						/* Can not send a SACK, because the segment cannot be
-						stored. */
-						pxWindow->ucOptionLength = 0u;
-
 						/* Needs to be stored but there is no segment
-						available. */
+						available.  Can not send a SACK, because the segment
+						cannot be stored. */
 						lReturn = -1;
 					}
 					else
 					{
+						pxWindow->pxRxRoot = prvRxTreeInsert( pxWindow->pxRxRoot, pxFound );
+						prvTCPWindowRxMerge( pxWindow, pxFound );
+
 						if( xTCPWindowLoggingLevel != 0 )
 						{
 							FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%u,%u]: seqnr %lu (cnt %lu)\n",
@@ -961,6 +1361,23 @@ const int32_t l500ms = 500;
 						lReturn = ( int32_t ) ( ulSequenceNumber - ulCurrentSequenceNumber );
 					}
 				}
+
+				if( pxFound != NULL )
+				{
+					if( xTCPWindowLoggingLevel >= 1 )
+					{
+						FreeRTOS_debug_printf( ( "lTCPWindowRxCheck[%d,%d]: seqnr %lu exp %lu (dist %ld) SACK %lu to %lu\n",
+							pxWindow->usPeerPortNumber, pxWindow->usOurPortNumber,
+							ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
+							ulCurrentSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
+							( BaseType_t ) ( ulSequenceNumber - ulCurrentSequenceNumber ),	/* want this signed */
+							pxFound->ulSequenceNumber - pxWindow->rx.ulFirstSequenceNumber,
+							winRX_RANGE_END( pxFound ) - pxWindow->rx.ulFirstSequenceNumber ) );
+					}
+
+					/* Now prepare the SACK message. */
+					prvTCPWindowRxSack( pxWindow, pxFound );
+				}
 			}
 		}
 
@@ -1179,6 +1596,17 @@ const int32_t l500ms = 500;
 				xHasSpace = pdFALSE;
 			}
 
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			{
+				/* The congestion window limits the amount of data in flight,
+				but one segment may always be sent. */
+				if( ( ulTxOutstanding != 0UL ) && ( pxWindow->ulCongestionWindow < ulTxOutstanding + ( ( uint32_t ) pxSegment->lDataLength ) ) )
+				{
+					xHasSpace = pdFALSE;
+				}
+			}
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 			/* If 'xHasSpace', it looks like the peer has at least space for 1
 			more new segment of size MSS.  xSize.ulTxWindowLength is the self-imposed
 			limitation of the transmission window (in case of many resends it
@@ -1248,7 +1676,14 @@ const int32_t l500ms = 500;
 				}
 				else if( prvTCPWindowTxHasSpace( pxWindow, ulWindowSize ) == pdFALSE )
 				{
-					/* Too many outstanding messages. */
+					/* Nothing is outstanding, so the peer's window is too small
+					for the next segment.  No ACK will arrive when the update
+					that opens it gets lost: wake up to probe the window. */
+					*pulDelay = prvTCPWindowProbeDelay( pxWindow );
+					if( *pulDelay == 0u )
+					{
+						*pulDelay = 1u;
+					}
 					xReturn = pdFALSE;
 				}
 				else if( ( pxWindow->u.bits.bSendFullSize != pdFALSE_UNSIGNED ) && ( pxSegment->lDataLength < pxSegment->lMaxLength ) )
@@ -1271,6 +1706,72 @@ const int32_t l500ms = 500;
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	static uint32_t prvTCPWindowProbeDelay( TCPWindow_t *pxWindow )
+	{
+	uint32_t ulAge, ulMaxAge, ulReturn = 0u;
+
+		if( pxWindow->u.bits.bWindowProbe == pdFALSE_UNSIGNED )
+		{
+			/* The window has just been found closed, start timing. */
+			pxWindow->u.bits.bWindowProbe = pdTRUE_UNSIGNED;
+			pxWindow->ucProbeCount = 0u;
+			vTCPTimerSet( &( pxWindow->xProbeTimer ) );
+		}
+
+		/* Like a retransmission, the first probe waits '1 * lSRTT' ms, and
+		every next probe waits twice as long. */
+		ulAge = ulTimerGetAge( &( pxWindow->xProbeTimer ) );
+		ulMaxAge = ( 1u << pxWindow->ucProbeCount ) * ( ( uint32_t ) pxWindow->lSRTT );
+
+		if( ulMaxAge > ulAge )
+		{
+			ulReturn = ulMaxAge - ulAge;
+		}
+
+		return ulReturn;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 )
+
+	BaseType_t xTCPWindowTxProbe( TCPWindow_t *pxWindow, uint32_t ulWindowSize )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( listLIST_IS_EMPTY( &( pxWindow->xPriorityQueue ) ) == pdFALSE ) ||
+			( listLIST_IS_EMPTY( &( pxWindow->xWaitQueue ) ) == pdFALSE ) ||
+			( listLIST_IS_EMPTY( &( pxWindow->xTxQueue ) ) != pdFALSE ) ||
+			( prvTCPWindowTxHasSpace( pxWindow, ulWindowSize ) != pdFALSE ) )
+		{
+			/* Data is outstanding and its ACK will tell the window, or there
+			is nothing to send, or it may be sent: no need to probe. */
+			pxWindow->u.bits.bWindowProbe = pdFALSE_UNSIGNED;
+		}
+		else if( prvTCPWindowProbeDelay( pxWindow ) == 0u )
+		{
+			/* Time for a probe, the next one will wait twice as long. */
+			vTCPTimerSet( &( pxWindow->xProbeTimer ) );
+			if( pxWindow->ucProbeCount < MAX_WINDOW_PROBE_BACKOFF )
+			{
+				pxWindow->ucProbeCount++;
+			}
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			/* Wait for the time-out set by xTCPWindowTxHasData(). */
+		}
+
+		return xReturn;
+	}
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+/*-----------------------------------------------------------*/
+
 #if( ipconfigUSE_TCP_WIN == 1 )
 
 	uint32_t ulTCPWindowTxGet( TCPWindow_t *pxWindow, uint32_t ulWindowSize, int32_t *plPosition )
@@ -1306,6 +1807,12 @@ const int32_t l500ms = 500;
 					pxSegment = xTCPWindowGetHead( &( pxWindow->xWaitQueue ) );
 					pxSegment->u.bits.ucDupAckCount = pdFALSE_UNSIGNED;
 
+					#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+					{
+						prvTCPWindowCongestionTimeout( pxWindow );
+					}
+					#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 					/* Some detailed logging. */
 					if( ( xTCPWindowLoggingLevel != 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != 0 ) )
 					{
@@ -1351,6 +1858,9 @@ const int32_t l500ms = 500;
 					/* Move it out of the Tx queue. */
 					pxSegment = xTCPWindowGetHead( &( pxWindow->xTxQueue ) );
 
+					/* The peer's window is open. */
+					pxWindow->u.bits.bWindowProbe = pdFALSE_UNSIGNED;
+
 					/* Don't let pxHeadSegment point to this segment any more,
 					so no more data will be added. */
 					if( pxWindow->pxHeadSegment == pxSegment )
@@ -1409,17 +1919,22 @@ const int32_t l500ms = 500;
 			( pxSegment->u.bits.ucTransmitCount )++;
 
 			/* If there have been several retransmissions (4), decrease the
-			size of the transmission window to at most 2 times MSS. */
-			if( pxSegment->u.bits.ucTransmitCount == MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW )
+			size of the transmission window to at most 2 times MSS.  With
+			congestion control, the congestion window takes care of this. */
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL == 0 )
 			{
-				if( pxWindow->xSize.ulTxWindowLength > ( 2U * pxWindow->usMSS ) )
+				if( pxSegment->u.bits.ucTransmitCount == MAX_TRANSMIT_COUNT_USING_LARGE_WINDOW )
 				{
-					FreeRTOS_debug_printf( ( "ulTCPWindowTxGet[%u - %d]: Change Tx window: %lu -> %u\n",
-						pxWindow->usPeerPortNumber, pxWindow->usOurPortNumber,
-						pxWindow->xSize.ulTxWindowLength, 2 * pxWindow->usMSS ) );
-					pxWindow->xSize.ulTxWindowLength = ( 2UL * pxWindow->usMSS );
+					if( pxWindow->xSize.ulTxWindowLength > ( 2U * pxWindow->usMSS ) )
+					{
+						FreeRTOS_debug_printf( ( "ulTCPWindowTxGet[%u - %d]: Change Tx window: %lu -> %u\n",
+							pxWindow->usPeerPortNumber, pxWindow->usOurPortNumber,
+							pxWindow->xSize.ulTxWindowLength, 2 * pxWindow->usMSS ) );
+						pxWindow->xSize.ulTxWindowLength = ( 2UL * pxWindow->usMSS );
+					}
 				}
 			}
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 
 			/* Clear the transmit timer. */
 			vTCPTimerSet( &( pxSegment->xTransmitTimer ) );
@@ -1444,6 +1959,9 @@ const int32_t l500ms = 500;
 	static uint32_t prvTCPWindowTxCheckAck( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast )
 	{
 	uint32_t ulBytesConfirmed = 0u;
+	#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+		uint32_t ulBytesSacked = 0u;
+	#endif
 	uint32_t ulSequenceNumber = ulFirst, ulDataLength;
 	const ListItem_t *pxIterator;
 	const MiniListItem_t *pxEnd = ( const MiniListItem_t* )listGET_END_MARKER( &pxWindow->xTxSegments );
@@ -1582,9 +2100,28 @@ const int32_t l500ms = 500;
 				uxListRemove( &pxSegment->xQueueItem );
 			}
 
+			#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+			{
+				if( xDoUnlink != pdFALSE )
+				{
+					/* Selectively acknowledged, to the right of a hole. */
+					ulBytesSacked += ulDataLength;
+				}
+			}
+			#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 			ulSequenceNumber += ulDataLength;
 		}
 
+		#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+		{
+			if( ( ulBytesConfirmed != 0UL ) || ( ulBytesSacked != 0UL ) )
+			{
+				prvTCPWindowCongestionAck( pxWindow, ulBytesConfirmed, ulBytesSacked );
+			}
+		}
+		#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
 		return ulBytesConfirmed;
 	}
 #endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -1592,44 +2129,86 @@ const int32_t l500ms = 500;
 
 #if( ipconfigUSE_TCP_WIN == 1 )
 
-	static uint32_t prvTCPWindowFastRetransmit( TCPWindow_t *pxWindow, uint32_t ulFirst )
+	static uint32_t prvTCPWindowFastRetransmit( TCPWindow_t *pxWindow )
 	{
-	const ListItem_t *pxIterator;
+	const ListItem_t *pxIterator, *pxHigher;
 	const MiniListItem_t* pxEnd;
-	TCPSegment_t *pxSegment;
-	uint32_t ulCount = 0UL;
+	TCPSegment_t *pxSegment, *pxOther;
+	uint32_t ulCount = 0UL, ulSacked = 0UL, ulAfter;
+
+		/* A higher Tx block has been acknowledged.  The segments are kept in
+		xTxSegments in sequential order, together with the SACK'd segments that
+		can not be freed yet, so they form a scoreboard of what the peer has
+		received.  First count the SACK'd segments, so that the search can stop
+		as soon as too few of them remain above a segment. */
+
+		pxEnd = ( const MiniListItem_t* ) listGET_END_MARKER( &( pxWindow->xTxSegments ) );
 
-		/* A higher Tx block has been acknowledged.  Now iterate through the
-		 xWaitQueue to find a possible condition for a FAST retransmission. */
+		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
+			 pxIterator != ( const ListItem_t * ) pxEnd;
+			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
+		{
+			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
 
-		pxEnd = ( const MiniListItem_t* ) listGET_END_MARKER( &( pxWindow->xWaitQueue ) );
+			if( pxSegment->u.bits.bAcked != pdFALSE_UNSIGNED )
+			{
+				ulSacked++;
+			}
+		}
 
 		for( pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxEnd );
-			 pxIterator != ( const ListItem_t * ) pxEnd; )
+			 ( pxIterator != ( const ListItem_t * ) pxEnd ) && ( ulSacked >= DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT );
+			 pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator ) )
 		{
 			/* Get the owner, which is a TCP segment. */
 			pxSegment = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
 
-			/* Hop to the next item before the current gets unlinked. */
-			pxIterator  = ( const ListItem_t * ) listGET_NEXT( pxIterator );
+			if( pxSegment->u.bits.bAcked != pdFALSE_UNSIGNED )
+			{
+				ulSacked--;
+				continue;
+			}
+
+			/* Only segments that are waiting for an ACK may be lost.  The
+			others have not been sent yet, or are already queued for a
+			retransmission. */
+			if( listLIST_ITEM_CONTAINER( &( pxSegment->xQueueItem ) ) != ( const List_t * ) &( pxWindow->xWaitQueue ) )
+			{
+				continue;
+			}
 
 			/* Fast retransmission:
 			When 3 packets with a higher sequence number have been acknowledged
 			by the peer, it is very unlikely a current packet will ever arrive.
-			It will be retransmitted far before the RTO. */
-			if( ( pxSegment->u.bits.bAcked == pdFALSE_UNSIGNED ) &&
-				( xSequenceLessThan( pxSegment->ulSequenceNumber, ulFirst ) != pdFALSE ) &&
-				( ++( pxSegment->u.bits.ucDupAckCount ) == DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT ) )
+			Only the packets that were sent after this segment was last sent
+			are counted: SACK's for packets that were sent before a
+			retransmission tell nothing about the retransmission, but the ones
+			sent after it show that the retransmission was lost as well. */
+			ulAfter = 0UL;
+
+			for( pxHigher  = ( const ListItem_t * ) listGET_NEXT( pxIterator );
+				 ( pxHigher != ( const ListItem_t * ) pxEnd ) && ( ulAfter < DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT );
+				 pxHigher  = ( const ListItem_t * ) listGET_NEXT( pxHigher ) )
+			{
+				pxOther = ( TCPSegment_t * ) listGET_LIST_ITEM_OWNER( pxHigher );
+
+				if( ( pxOther->u.bits.bAcked != pdFALSE_UNSIGNED ) &&
+					( ( int32_t ) ( pxOther->xTransmitTimer.ulBorn - pxSegment->xTransmitTimer.ulBorn ) >= 0L ) )
+				{
+					ulAfter++;
+				}
+			}
+
+			pxSegment->u.bits.ucDupAckCount = ( uint8_t ) ulAfter;
+
+			if( ulAfter >= DUPLICATE_ACKS_BEFORE_FAST_RETRANSMIT )
 			{
 				pxSegment->u.bits.ucTransmitCount = pdFALSE_UNSIGNED;
 
-				/* Not clearing 'ucDupAckCount' yet as more SACK's might come in
-				which might lead to a second fast rexmit. */
 				if( ( xTCPWindowLoggingLevel >= 0 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
 				{
-					FreeRTOS_debug_printf( ( "prvTCPWindowFastRetransmit: Requeue sequence number %lu < %lu\n",
-						pxSegment->ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber,
-						ulFirst - pxWindow->tx.ulFirstSequenceNumber ) );
+					FreeRTOS_debug_printf( ( "prvTCPWindowFastRetransmit: Requeue sequence number %lu\n",
+						pxSegment->ulSequenceNumber - pxWindow->tx.ulFirstSequenceNumber ) );
 					FreeRTOS_flush_logging( );
 				}
 
@@ -1678,11 +2257,25 @@ const int32_t l500ms = 500;
 	uint32_t ulTCPWindowTxSack( TCPWindow_t *pxWindow, uint32_t ulFirst, uint32_t ulLast )
 	{
 	uint32_t ulAckCount = 0UL;
+	uint32_t ulRetransmitCount;
 	uint32_t ulCurrentSequenceNumber = pxWindow->tx.ulCurrentSequenceNumber;
 
 		/* Receive a SACK option. */
 		ulAckCount = prvTCPWindowTxCheckAck( pxWindow, ulFirst, ulLast );
-		prvTCPWindowFastRetransmit( pxWindow, ulFirst );
+		ulRetransmitCount = prvTCPWindowFastRetransmit( pxWindow );
+
+		#if( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+		{
+			if( ulRetransmitCount != 0UL )
+			{
+				prvTCPWindowCongestionLoss( pxWindow );
+			}
+		}
+		#else
+		{
+			( void ) ulRetransmitCount;
+		}
+		#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
 
 		if( ( xTCPWindowLoggingLevel >= 1 ) && ( xSequenceGreaterThan( ulFirst, ulCurrentSequenceNumber ) != pdFALSE ) )
 		{
@@ -1701,6 +2294,305 @@ const int32_t l500ms = 500;
 #endif /* ipconfigUSE_TCP_WIN == 1 */
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPWindowCongestionAck( TCPWindow_t *pxWindow, uint32_t ulConfirmed, uint32_t ulSacked )
+	{
+	uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+	uint32_t ulFlight;
+
+		if( pxWindow->u.bits.bFastRecovery != pdFALSE_UNSIGNED )
+		{
+			if( xSequenceGreaterThanOrEqual( pxWindow->tx.ulCurrentSequenceNumber, pxWindow->ulRecoverSequenceNumber ) != pdFALSE )
+			{
+				/* All data that was outstanding when the loss was detected has
+				been acknowledged: deflate the window to the threshold. */
+				pxWindow->u.bits.bFastRecovery = pdFALSE_UNSIGNED;
+				pxWindow->ulCongestionWindow = pxWindow->ulSlowStartThreshold;
+			}
+			else
+			{
+				/* Every segment that leaves the network lets a new one in.
+				Bytes that had been counted as SACK'd are acknowledged again by
+				a partial ACK, so they are taken off again (RFC 6582). */
+				pxWindow->ulCongestionWindow += ulSacked;
+				pxWindow->ulCongestionWindow -= FreeRTOS_min_uint32( pxWindow->ulCongestionWindow, ulConfirmed );
+
+				if( ulConfirmed >= ulMSS )
+				{
+					pxWindow->ulCongestionWindow += ulMSS;
+				}
+
+				if( pxWindow->ulCongestionWindow < ulMSS )
+				{
+					pxWindow->ulCongestionWindow = ulMSS;
+				}
+			}
+		}
+		else if( ulConfirmed != 0UL )
+		{
+			/* Only grow the window while it is being used: the data in
+			flight before this ACK must have (nearly) filled it (RFC 7661). */
+			ulFlight = ( pxWindow->tx.ulHighestSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber ) + ulConfirmed;
+
+			if( ( ulFlight + ulMSS ) >= pxWindow->ulCongestionWindow )
+			{
+				if( pxWindow->ulCongestionWindow < pxWindow->ulSlowStartThreshold )
+				{
+					/* Slow start. */
+					pxWindow->ulCongestionWindow += FreeRTOS_min_uint32( ulConfirmed, winSLOW_START_LIMIT * ulMSS );
+				}
+				else
+				{
+					pxWindow->pxCongestionControl->pxCongestionAvoidance( pxWindow, ulConfirmed, ( uint32_t ) ( xTaskGetTickCount() * portTICK_PERIOD_MS ) );
+				}
+			}
+		}
+		else
+		{
+			/* Only SACK'd data outside fast recovery, the lost segment has
+			not been retransmitted yet. */
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPWindowCongestionLoss( TCPWindow_t *pxWindow )
+	{
+		/* Losses in a window of data that was sent before the previous
+		reduction do not reduce the window again. */
+		if( ( pxWindow->u.bits.bFastRecovery == pdFALSE_UNSIGNED ) &&
+			( xSequenceGreaterThanOrEqual( pxWindow->tx.ulCurrentSequenceNumber, pxWindow->ulRecoverSequenceNumber ) != pdFALSE ) )
+		{
+			pxWindow->ulSlowStartThreshold = pxWindow->pxCongestionControl->pxSlowStartThreshold( pxWindow );
+
+			/* The 3 segments that caused the duplicate ACKs have left the
+			network. */
+			pxWindow->ulCongestionWindow = pxWindow->ulSlowStartThreshold + ( 3UL * ( uint32_t ) pxWindow->usMSS );
+			pxWindow->ulRecoverSequenceNumber = pxWindow->tx.ulHighestSequenceNumber;
+			pxWindow->u.bits.bFastRecovery = pdTRUE_UNSIGNED;
+			pxWindow->ulAckedBytes = 0UL;
+
+			if( ( xTCPWindowLoggingLevel >= 1 ) && ( ipconfigTCP_MAY_LOG_PORT( pxWindow->usOurPortNumber ) != pdFALSE ) )
+			{
+				FreeRTOS_debug_printf( ( "prvTCPWindowCongestionLoss[%u,%u]: cwnd %lu ssthresh %lu\n",
+					pxWindow->usPeerPortNumber,
+					pxWindow->usOurPortNumber,
+					pxWindow->ulCongestionWindow,
+					pxWindow->ulSlowStartThreshold ) );
+			}
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvTCPWindowCongestionTimeout( TCPWindow_t *pxWindow )
+	{
+	uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+
+		/* A repeated timeout does not lower the threshold any further. */
+		if( pxWindow->ulCongestionWindow > ulMSS )
+		{
+			pxWindow->ulSlowStartThreshold = pxWindow->pxCongestionControl->pxSlowStartThreshold( pxWindow );
+		}
+
+		pxWindow->ulCongestionWindow = ulMSS;
+		pxWindow->ulRecoverSequenceNumber = pxWindow->tx.ulHighestSequenceNumber;
+		pxWindow->u.bits.bFastRecovery = pdFALSE_UNSIGNED;
+		pxWindow->ulAckedBytes = 0UL;
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvNewRenoInit( TCPWindow_t *pxWindow )
+	{
+		/* NewReno keeps no state of its own. */
+		( void ) pxWindow;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvNewRenoSlowStartThreshold( TCPWindow_t *pxWindow )
+	{
+	uint32_t ulFlight = pxWindow->tx.ulHighestSequenceNumber - pxWindow->tx.ulCurrentSequenceNumber;
+
+		/* Half of the data in flight, but at least 2 segments. */
+		return FreeRTOS_max_uint32( ulFlight / 2UL, 2UL * ( uint32_t ) pxWindow->usMSS );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvNewRenoCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulAckedBytes, uint32_t ulTimeMS )
+	{
+		( void ) ulTimeMS;
+
+		/* Grow by one segment for every window full of data that has been
+		acknowledged, i.e. once per round trip. */
+		pxWindow->ulAckedBytes += ulAckedBytes;
+
+		if( pxWindow->ulAckedBytes >= pxWindow->ulCongestionWindow )
+		{
+			pxWindow->ulAckedBytes -= pxWindow->ulCongestionWindow;
+			pxWindow->ulCongestionWindow += ( uint32_t ) pxWindow->usMSS;
+		}
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+	static void prvCubicInit( TCPWindow_t *pxWindow )
+	{
+		memset( &( pxWindow->xCubic ), 0, sizeof( pxWindow->xCubic ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvCubicSlowStartThreshold( TCPWindow_t *pxWindow )
+	{
+	uint32_t ulWindow = pxWindow->ulCongestionWindow;
+
+		/* A new epoch starts with the next ACK. */
+		pxWindow->xCubic.ulEpochStart = 0UL;
+
+		/* Fast convergence: when the window did not reach its previous
+		maximum, another flow is competing for the bandwidth, so release some
+		more of it. */
+		if( ulWindow < pxWindow->xCubic.ulLastMaxWindow )
+		{
+			pxWindow->xCubic.ulLastMaxWindow = ulWindow;
+			pxWindow->xCubic.ulMaxWindow = ( uint32_t ) ( ( ( uint64_t ) ulWindow * ( winCUBIC_BETA_DENOMINATOR + winCUBIC_BETA_NUMERATOR ) ) / ( 2UL * winCUBIC_BETA_DENOMINATOR ) );
+		}
+		else
+		{
+			pxWindow->xCubic.ulLastMaxWindow = ulWindow;
+			pxWindow->xCubic.ulMaxWindow = ulWindow;
+		}
+
+		return FreeRTOS_max_uint32( ( ulWindow / winCUBIC_BETA_DENOMINATOR ) * winCUBIC_BETA_NUMERATOR, 2UL * ( uint32_t ) pxWindow->usMSS );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCubicCongestionAvoidance( TCPWindow_t *pxWindow, uint32_t ulAckedBytes, uint32_t ulTimeMS )
+	{
+	uint32_t ulMSS = ( uint32_t ) pxWindow->usMSS;
+	uint32_t ulWindow = pxWindow->ulCongestionWindow;
+	uint32_t ulElapsed, ulDistance;
+	uint64_t ullCube, ullOffset, ullTarget;
+
+		if( pxWindow->xCubic.ulEpochStart == 0UL )
+		{
+			/* Zero means that no epoch has started. */
+			pxWindow->xCubic.ulEpochStart = FreeRTOS_max_uint32( ulTimeMS, 1UL );
+			pxWindow->xCubic.ulFriendlyWindow = ulWindow;
+
+			if( ulWindow < pxWindow->xCubic.ulMaxWindow )
+			{
+				/* The time it takes to grow back to the previous maximum:
+				K = cbrt( ( Wmax - cwnd ) / C ). */
+				ullCube = ( ( uint64_t ) ( pxWindow->xCubic.ulMaxWindow - ulWindow ) * winCUBIC_MS3_PER_SEGMENT ) / ulMSS;
+				pxWindow->xCubic.ulPlateauTime = prvCubeRoot( ullCube );
+				pxWindow->xCubic.ulOriginWindow = pxWindow->xCubic.ulMaxWindow;
+			}
+			else
+			{
+				pxWindow->xCubic.ulPlateauTime = 0UL;
+				pxWindow->xCubic.ulOriginWindow = ulWindow;
+			}
+		}
+
+		/* The window that the cubic function reaches one round trip from now:
+		W( t ) = C * ( t - K )^3 + Wmax. */
+		ulElapsed = ( ulTimeMS - pxWindow->xCubic.ulEpochStart ) + ( uint32_t ) pxWindow->lSRTT;
+
+		if( ulElapsed >= pxWindow->xCubic.ulPlateauTime )
+		{
+			ulDistance = FreeRTOS_min_uint32( ulElapsed - pxWindow->xCubic.ulPlateauTime, winCUBIC_MAX_DISTANCE_MS );
+		}
+		else
+		{
+			ulDistance = FreeRTOS_min_uint32( pxWindow->xCubic.ulPlateauTime - ulElapsed, winCUBIC_MAX_DISTANCE_MS );
+		}
+
+		ullCube = ( uint64_t ) ulDistance * ulDistance * ulDistance;
+		ullOffset = ( ullCube * ulMSS ) / winCUBIC_MS3_PER_SEGMENT;
+
+		if( ulElapsed >= pxWindow->xCubic.ulPlateauTime )
+		{
+			ullTarget = pxWindow->xCubic.ulOriginWindow + ullOffset;
+		}
+		else if( ullOffset < pxWindow->xCubic.ulOriginWindow )
+		{
+			ullTarget = pxWindow->xCubic.ulOriginWindow - ullOffset;
+		}
+		else
+		{
+			ullTarget = 0ULL;
+		}
+
+		/* Never grow by more than half a window per round trip. */
+		if( ullTarget < ulMSS )
+		{
+			ullTarget = ulMSS;
+		}
+		else if( ullTarget > ( ( uint64_t ) ulWindow + ( ulWindow / 2UL ) ) )
+		{
+			ullTarget = ( uint64_t ) ulWindow + ( ulWindow / 2UL );
+		}
+		else
+		{
+			/* The target is within bounds. */
+		}
+
+		/* The window that standard TCP would have reached since the start of
+		the epoch: it grows by 3 * ( 1 - beta ) / ( 1 + beta ) = 9 / 17
+		segments per round trip. */
+		pxWindow->xCubic.ulFriendlyWindow += ( uint32_t ) ( ( ( uint64_t ) ulAckedBytes * ulMSS * 9ULL ) / ( 17ULL * ulWindow ) );
+
+		if( ullTarget > ulWindow )
+		{
+			pxWindow->ulCongestionWindow += ( uint32_t ) ( ( ( ullTarget - ulWindow ) * ulAckedBytes ) / ulWindow );
+		}
+
+		/* In the TCP-friendly region, grow at least as fast as standard TCP. */
+		if( pxWindow->xCubic.ulFriendlyWindow > pxWindow->ulCongestionWindow )
+		{
+			pxWindow->ulCongestionWindow = pxWindow->xCubic.ulFriendlyWindow;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvCubeRoot( uint64_t ullValue )
+	{
+	uint64_t ullRoot = 0ULL, ullBit;
+	BaseType_t xShift;
+
+		/* Bit by bit, from the most significant bit of the root. */
+		for( xShift = 63; xShift >= 0; xShift -= 3 )
+		{
+			ullRoot += ullRoot;
+			ullBit = ( 3ULL * ullRoot * ( ullRoot + 1ULL ) ) + 1ULL;
+
+			if( ( ullValue >> xShift ) >= ullBit )
+			{
+				ullValue -= ullBit << xShift;
+				ullRoot++;
+			}
+		}
+
+		return ( uint32_t ) ullRoot;
+	}
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+/*-----------------------------------------------------------*/
+
 /*
 #####   #                      #####   ####  ######
 # # #   #                      # # #  #    #  #    #
@@ -830,7 +830,6 @@ NetworkBufferDescriptor_t *pxCurDescriptor;
 NetworkBufferDescriptor_t *pxNewDescriptor = NULL;
 BaseType_t xReceivedLength, xAccepted;
 __IO ETH_DMADescTypeDef *pxDMARxDescriptor;
-xIPStackEvent_t xRxEvent = { eNetworkRxEvent, NULL };
 const TickType_t xDescriptorWaitTime = pdMS_TO_TICKS( 250 );
 uint8_t *pucBuffer;
 
@@ -904,10 +903,11 @@ uint8_t *pucBuffer;
 		if( xAccepted != pdFALSE )
 		{
 			pxCurDescriptor->xDataLength = xReceivedLength;
-			xRxEvent.pvData = ( void * ) pxCurDescriptor;
 
-			/* Pass the data to the TCP/IP task for processing. */
-			if( xSendEventStructToIPTask( &xRxEvent, xDescriptorWaitTime ) == pdFALSE )
+			/* Pass the data to the TCP/IP task for processing.  Only the EMAC
+			task passes received frames, so they can be sent through the SPSC
+			ring when ipconfigUSE_NETWORK_RX_RING is set to 1. */
+			if( xSendNetworkBufferToIPTask( pxCurDescriptor, xDescriptorWaitTime ) == pdFALSE )
 			{
 				/* Could not send the descriptor into the TCP/IP stack, it
 				must be released. */
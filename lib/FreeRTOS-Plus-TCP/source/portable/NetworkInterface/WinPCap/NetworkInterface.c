@@ -504,7 +504,6 @@ static struct pcap_pkthdr *pxHeader;
 const uint8_t *pucPacketData;
 uint8_t ucRecvBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
 NetworkBufferDescriptor_t *pxNetworkBuffer;
-IPStackEvent_t xRxEvent = { eNetworkRxEvent, NULL };
 eFrameProcessingResult_t eResult;
 
 	/* Remove compiler warnings about unused parameters. */
@@ -559,11 +558,9 @@ eFrameProcessingResult_t eResult;
 
 						if( pxNetworkBuffer != NULL )
 						{
-							xRxEvent.pvData = ( void * ) pxNetworkBuffer;
-
-							/* Data was received and stored.  Send a message to
-							the IP task to let it know. */
-							if( xSendEventStructToIPTask( &xRxEvent, ( TickType_t ) 0 ) == pdFAIL )
+							/* Data was received and stored.  Pass the buffer to
+							the IP task. */
+							if( xSendNetworkBufferToIPTask( pxNetworkBuffer, ( TickType_t ) 0 ) == pdFAIL )
 							{
 								/* The buffer could not be sent to the stack so
 								must be released again.  This is only an
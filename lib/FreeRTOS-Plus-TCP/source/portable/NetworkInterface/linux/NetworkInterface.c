@@ -0,0 +1,672 @@
+/*
+FreeRTOS+TCP V2.0.10
+Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ http://aws.amazon.com/freertos
+ http://www.FreeRTOS.org
+
+/*
+ * Network interface for the FreeRTOS POSIX (Linux) simulator.
+ *
+ * Frames are exchanged with the host through a tap device, which can be
+ * bridged or routed like any other Linux network interface.  Alternatively,
+ * if configNETWORK_INTERFACE_LOOPBACK is set to 1, no host device is used and
+ * the frames sent to the node's own MAC address, and broadcast frames, are
+ * reflected back into the stack.  The loopback mode does not need any
+ * privileges so is well suited to repeatable host-side benchmarks.  To see how
+ * the stack copes with a poor network, vNetworkInterfaceSetLoopbackImpairment()
+ * makes the loopback drop and delay IP frames.
+ *
+ * As in the WinPCap interface, host threads that are outside of the control of
+ * the scheduler perform the blocking reads and writes on the tap device and
+ * pass the frames to and from the FreeRTOS tasks through thread safe circular
+ * buffers.  A FreeRTOS task simulates the Ethernet Rx interrupt.
+ */
+
+/* Standard includes. */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/if_tun.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "NetworkBufferManagement.h"
+
+/* Thread-safe circular buffers are being used to pass data to and from the
+host threads. */
+#include "FreeRTOS_Stream_Buffer.h"
+
+/* Sizes of the thread safe circular buffers used to pass data to and from the
+host threads. */
+#define xSEND_BUFFER_SIZE  32768
+#define xRECV_BUFFER_SIZE  32768
+
+#ifndef configNETWORK_INTERFACE_NAME
+	#define configNETWORK_INTERFACE_NAME	"tap0"
+#endif
+
+#ifndef configNETWORK_INTERFACE_LOOPBACK
+	#define configNETWORK_INTERFACE_LOOPBACK	0
+#endif
+
+#ifndef configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY
+	#define configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY	( 1 )
+#endif
+
+/* If ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES is set to 1, then the Ethernet
+driver will filter incoming packets and only pass the stack those packets it
+considers need processing. */
+#if( ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES == 0 )
+	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eProcessBuffer
+#else
+	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
+#endif
+
+/* The maximum time the Tx thread waits before checking the send buffer again,
+in case a notification was missed. */
+#define niTX_THREAD_MAX_WAIT_MS		1000
+
+/*-----------------------------------------------------------*/
+
+#if( configNETWORK_INTERFACE_LOOPBACK == 0 )
+
+	/*
+	 * Host threads that are outside of the control of the FreeRTOS simulator
+	 * are used to read from and write to the tap device.
+	 */
+	static void *prvTapRecvThread( void *pvParam );
+	static void *prvTapSendThread( void *pvParam );
+
+	/*
+	 * Open the tap device named by configNETWORK_INTERFACE_NAME.
+	 */
+	static int prvOpenTapDevice( const char *pcName );
+
+	/*
+	 * Create the host threads that service the tap device.
+	 */
+	static BaseType_t prvCreateHostThreads( void );
+
+#else
+
+	/*
+	 * Returns pdTRUE if a frame sent by the stack must be reflected back to it.
+	 */
+	static BaseType_t prvIsLoopbackFrame( const uint8_t *pucEthernetBuffer );
+
+	/*
+	 * Returns pdTRUE if the loopback impairment decides to drop the frame.
+	 */
+	static BaseType_t prvIsDroppedFrame( const uint8_t *pucEthernetBuffer );
+
+	/*
+	 * Drop ulLossPerMille out of every 1000 IP frames looped back, chosen at
+	 * random, and deliver the others xDelay ticks after they were sent.  Both
+	 * are 0 by default.
+	 */
+	void vNetworkInterfaceSetLoopbackImpairment( uint32_t ulLossPerMille, TickType_t xDelay );
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+/*
+ * A function that simulates Ethernet interrupts by polling the circular buffer
+ * filled by the Rx thread (or by xNetworkInterfaceOutput() in loopback mode)
+ * for new data.
+ */
+static void prvInterruptSimulatorTask( void *pvParameters );
+
+/*
+ * Create the buffers that are used to pass data between the FreeRTOS simulator
+ * and the host threads.
+ */
+static void prvCreateThreadSafeBuffers( void );
+
+/*-----------------------------------------------------------*/
+
+#if( configNETWORK_INTERFACE_LOOPBACK == 0 )
+
+	/* The file descriptor of the opened tap device. */
+	static int iTapFd = -1;
+
+	/* Used to wake up the host thread that writes to the tap device. */
+	static sem_t xSendSemaphore;
+
+	/* Logs the send and receive failures, for viewing in the debugger only. */
+	static volatile uint32_t ulTapSendFailures = 0;
+	static volatile uint32_t ulTapRecvDrops = 0;
+
+	/* In the tap mode, only the length of a frame precedes it in the
+	buffers. */
+	#define niFRAME_HEADER_LENGTH		( sizeof( size_t ) )
+
+#else
+
+	/* The loss rate and delay set by vNetworkInterfaceSetLoopbackImpairment(). */
+	static volatile uint32_t ulLoopbackLossPerMille = 0;
+	static volatile TickType_t xLoopbackDelay = 0;
+
+	/* State of the pseudo random generator that chooses the frames to drop. */
+	static uint32_t ulLoopbackRandom = 1;
+
+	/* Counts the dropped frames, for viewing in the debugger only. */
+	static volatile uint32_t ulLoopbackDrops = 0;
+
+	/* In the loopback mode, the length of a frame and the time at which it was
+	sent precede it in the buffer. */
+	#define niFRAME_HEADER_LENGTH		( sizeof( size_t ) + sizeof( TickType_t ) )
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+/* The task that simulates the Rx interrupt. */
+static TaskHandle_t xInterruptSimulatorTask = NULL;
+
+/* Circular buffers used by the host threads. */
+static StreamBuffer_t *xSendBuffer = NULL;
+static StreamBuffer_t *xRecvBuffer = NULL;
+
+/* The MAC address initially set to the constants defined in FreeRTOSConfig.h. */
+extern uint8_t ucMACAddress[ 6 ];
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceInitialise( void )
+{
+BaseType_t xReturn = pdPASS;
+
+	/* xNetworkInterfaceInitialise() is called again each time the network
+	goes down, only set up the interface once. */
+	if( xInterruptSimulatorTask == NULL )
+	{
+		prvCreateThreadSafeBuffers();
+
+		#if( configNETWORK_INTERFACE_LOOPBACK == 0 )
+		{
+			iTapFd = prvOpenTapDevice( configNETWORK_INTERFACE_NAME );
+
+			if( iTapFd < 0 )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				xReturn = prvCreateHostThreads();
+			}
+		}
+		#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+		if( xReturn == pdPASS )
+		{
+			/* Create a task that simulates an interrupt in a real system.  This
+			will block waiting for packets, then send a message to the IP task
+			when data is available. */
+			if( xTaskCreate( prvInterruptSimulatorTask, "MAC_ISR", configMINIMAL_STACK_SIZE, NULL, configMAC_ISR_SIMULATOR_PRIORITY, &xInterruptSimulatorTask ) != pdPASS )
+			{
+				xReturn = pdFAIL;
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateThreadSafeBuffers( void )
+{
+	/* The buffer used to pass data to be transmitted from a FreeRTOS task to
+	the host thread that writes to the tap device. */
+	if( xSendBuffer == NULL )
+	{
+		xSendBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) + xSEND_BUFFER_SIZE + 1 );
+		configASSERT( xSendBuffer );
+		memset( xSendBuffer, '\0', sizeof( *xSendBuffer ) - sizeof( xSendBuffer->ucArray ) );
+		xSendBuffer->LENGTH = xSEND_BUFFER_SIZE + 1;
+	}
+
+	/* The buffer used to pass received data from the host thread that reads
+	from the tap device to the FreeRTOS task. */
+	if( xRecvBuffer == NULL )
+	{
+		xRecvBuffer = ( StreamBuffer_t * ) malloc( sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) + xRECV_BUFFER_SIZE + 1 );
+		configASSERT( xRecvBuffer );
+		memset( xRecvBuffer, '\0', sizeof( *xRecvBuffer ) - sizeof( xRecvBuffer->ucArray ) );
+		xRecvBuffer->LENGTH = xRECV_BUFFER_SIZE + 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xNetworkInterfaceOutput( NetworkBufferDescriptor_t * const pxNetworkBuffer, BaseType_t bReleaseAfterSend )
+{
+size_t xSpace;
+StreamBuffer_t *pxBuffer = xSendBuffer;
+BaseType_t xQueued = pdFALSE;
+
+	iptraceNETWORK_INTERFACE_TRANSMIT();
+	configASSERT( xIsCallingFromIPTask() == pdTRUE );
+
+	#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+	{
+		/* The frame goes straight back to the Rx path.  Frames addressed to
+		other nodes are dropped, as there is nobody to receive them. */
+		pxBuffer = xRecvBuffer;
+
+		if( prvIsLoopbackFrame( pxNetworkBuffer->pucEthernetBuffer ) == pdFALSE )
+		{
+			pxBuffer = NULL;
+		}
+		else if( prvIsDroppedFrame( pxNetworkBuffer->pucEthernetBuffer ) != pdFALSE )
+		{
+			pxBuffer = NULL;
+			ulLoopbackDrops++;
+		}
+	}
+	#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+	if( pxBuffer != NULL )
+	{
+		/* Both the length of the data being sent and the actual data being
+		sent are placed in the thread safe buffer.  Drop the packet if there is
+		insufficient space in the buffer to hold both. */
+		xSpace = uxStreamBufferGetSpace( pxBuffer );
+
+		if( ( pxNetworkBuffer->xDataLength <= ( ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ) ) &&
+			( xSpace >= ( pxNetworkBuffer->xDataLength + niFRAME_HEADER_LENGTH ) ) )
+		{
+			/* First write in the length of the data, then write in the data
+			itself. */
+			uxStreamBufferAdd( pxBuffer, 0, ( const uint8_t * ) &( pxNetworkBuffer->xDataLength ), sizeof( pxNetworkBuffer->xDataLength ) );
+
+			#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+			{
+				/* The time of sending, to delay the delivery. */
+				TickType_t xNow = xTaskGetTickCount();
+
+				uxStreamBufferAdd( pxBuffer, 0, ( const uint8_t * ) &xNow, sizeof( xNow ) );
+			}
+			#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+			uxStreamBufferAdd( pxBuffer, 0, ( const uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+			xQueued = pdTRUE;
+		}
+		else
+		{
+			FreeRTOS_debug_printf( ( "xNetworkInterfaceOutput: send buffers full to store %lu\n", ( unsigned long ) pxNetworkBuffer->xDataLength ) );
+		}
+	}
+
+	#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+	{
+		/* The interrupt simulator is a FreeRTOS task, so can be woken
+		directly. */
+		if( xQueued != pdFALSE )
+		{
+			xTaskNotifyGive( xInterruptSimulatorTask );
+		}
+	}
+	#else
+	{
+		/* Kick the Tx thread in either case in case it doesn't know the buffer
+		is full. */
+		( void ) xQueued;
+		sem_post( &xSendSemaphore );
+	}
+	#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+	/* The buffer has been sent so can be released. */
+	if( bReleaseAfterSend != pdFALSE )
+	{
+		vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+static BaseType_t prvIsLoopbackFrame( const uint8_t *pucEthernetBuffer )
+{
+const EthernetHeader_t *pxEthernetHeader = ( const EthernetHeader_t * ) pucEthernetBuffer;
+BaseType_t xReturn = pdFALSE;
+
+	if( memcmp( pxEthernetHeader->xDestinationAddress.ucBytes, ucMACAddress, sizeof( ucMACAddress ) ) == 0 )
+	{
+		xReturn = pdTRUE;
+	}
+	else if( memcmp( pxEthernetHeader->xDestinationAddress.ucBytes, xBroadcastMACAddress.ucBytes, sizeof( MACAddress_t ) ) == 0 )
+	{
+		/* Broadcast frames are reflected so that ARP requests for the node's
+		own IP address are answered. */
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsDroppedFrame( const uint8_t *pucEthernetBuffer )
+{
+const EthernetHeader_t *pxEthernetHeader = ( const EthernetHeader_t * ) pucEthernetBuffer;
+BaseType_t xReturn = pdFALSE;
+
+	/* Only IP frames are dropped, ARP must keep working. */
+	if( ( ulLoopbackLossPerMille != 0UL ) && ( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE ) )
+	{
+		/* Only called from the IP task, so the generator needs no
+		protection. */
+		ulLoopbackRandom = ( ulLoopbackRandom * 1103515245UL ) + 12345UL;
+
+		if( ( ( ulLoopbackRandom >> 16 ) % 1000UL ) < ulLoopbackLossPerMille )
+		{
+			xReturn = pdTRUE;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vNetworkInterfaceSetLoopbackImpairment( uint32_t ulLossPerMille, TickType_t xDelay )
+{
+	ulLoopbackLossPerMille = ulLossPerMille;
+	xLoopbackDelay = xDelay;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK */
+/*-----------------------------------------------------------*/
+
+#if( configNETWORK_INTERFACE_LOOPBACK == 0 )
+
+static int prvOpenTapDevice( const char *pcName )
+{
+struct ifreq xInterfaceRequest;
+int iFd;
+
+	iFd = open( "/dev/net/tun", O_RDWR );
+
+	if( iFd < 0 )
+	{
+		printf( "\nCould not open /dev/net/tun: %s\n", strerror( errno ) );
+	}
+	else
+	{
+		memset( &xInterfaceRequest, 0, sizeof( xInterfaceRequest ) );
+
+		/* Ethernet frames without the extra packet information header. */
+		xInterfaceRequest.ifr_flags = IFF_TAP | IFF_NO_PI;
+		strncpy( xInterfaceRequest.ifr_name, pcName, IFNAMSIZ - 1 );
+
+		if( ioctl( iFd, TUNSETIFF, ( void * ) &xInterfaceRequest ) < 0 )
+		{
+			printf( "\nCould not attach to tap device %s: %s\n", pcName, strerror( errno ) );
+			printf( "Create it with \"ip tuntap add dev %s mode tap user <user>\", or set\n", pcName );
+			printf( "configNETWORK_INTERFACE_LOOPBACK to 1 in FreeRTOSConfig.h.\n" );
+			close( iFd );
+			iFd = -1;
+		}
+		else
+		{
+			printf( "Attached to tap device %s.\n", xInterfaceRequest.ifr_name );
+		}
+	}
+
+	return iFd;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateHostThreads( void )
+{
+pthread_t xThread;
+BaseType_t xReturn = pdPASS;
+
+	sem_init( &xSendSemaphore, 0, 0 );
+
+	/* The host threads must never handle the simulated tick interrupt, so
+	they are created from within a critical section to inherit a signal mask
+	that blocks it. */
+	portENTER_CRITICAL();
+	{
+		if( pthread_create( &xThread, NULL, prvTapRecvThread, NULL ) != 0 )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			( void ) pthread_detach( xThread );
+		}
+
+		if( pthread_create( &xThread, NULL, prvTapSendThread, NULL ) != 0 )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			( void ) pthread_detach( xThread );
+		}
+	}
+	portEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTapRecvThread( void *pvParam )
+{
+uint8_t ucBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+ssize_t xBytesRead;
+size_t xLength;
+
+	/* THIS IS A HOST THREAD - DO NOT ATTEMPT ANY FREERTOS CALLS OR TO PRINT
+	OUT MESSAGES HERE. */
+
+	( void ) pvParam;
+
+	for( ;; )
+	{
+		xBytesRead = read( iTapFd, ucBuffer, sizeof( ucBuffer ) );
+
+		if( xBytesRead > 0 )
+		{
+			xLength = ( size_t ) xBytesRead;
+
+			/* Pass data to the FreeRTOS simulator on a thread safe circular
+			buffer. */
+			if( uxStreamBufferGetSpace( xRecvBuffer ) >= ( xLength + sizeof( xLength ) ) )
+			{
+				uxStreamBufferAdd( xRecvBuffer, 0, ( const uint8_t * ) &xLength, sizeof( xLength ) );
+				uxStreamBufferAdd( xRecvBuffer, 0, ucBuffer, xLength );
+			}
+			else
+			{
+				ulTapRecvDrops++;
+			}
+		}
+		else if( ( xBytesRead < 0 ) && ( errno != EINTR ) && ( errno != EAGAIN ) )
+		{
+			/* The device has gone away. */
+			break;
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTapSendThread( void *pvParam )
+{
+size_t xLength;
+uint8_t ucBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+struct timespec xTimeout;
+
+	/* THIS IS A HOST THREAD - DO NOT ATTEMPT ANY FREERTOS CALLS OR TO PRINT
+	OUT MESSAGES HERE. */
+
+	( void ) pvParam;
+
+	for( ;; )
+	{
+		/* Wait until notified of something to send. */
+		clock_gettime( CLOCK_REALTIME, &xTimeout );
+		xTimeout.tv_sec += niTX_THREAD_MAX_WAIT_MS / 1000;
+		( void ) sem_timedwait( &xSendSemaphore, &xTimeout );
+
+		/* Is there more than the length value stored in the circular buffer
+		used to pass data from the FreeRTOS simulator into this thread? */
+		while( uxStreamBufferGetSize( xSendBuffer ) > sizeof( xLength ) )
+		{
+			uxStreamBufferGet( xSendBuffer, 0, ( uint8_t * ) &xLength, sizeof( xLength ), pdFALSE );
+			uxStreamBufferGet( xSendBuffer, 0, ucBuffer, xLength, pdFALSE );
+
+			if( write( iTapFd, ucBuffer, xLength ) != ( ssize_t ) xLength )
+			{
+				ulTapSendFailures++;
+			}
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK */
+/*-----------------------------------------------------------*/
+
+static void prvInterruptSimulatorTask( void *pvParameters )
+{
+size_t xLength;
+uint8_t ucRecvBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+NetworkBufferDescriptor_t *pxNetworkBuffer;
+eFrameProcessingResult_t eResult;
+#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+	TickType_t xSent, xAge, xDelay;
+#endif
+
+	/* Remove compiler warnings about unused parameters. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Does the circular buffer used to pass received data into the FreeRTOS
+		simulator contain another packet? */
+		if( uxStreamBufferGetSize( xRecvBuffer ) > niFRAME_HEADER_LENGTH )
+		{
+			#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+			{
+				/* Frames are delivered in order, so the oldest frame is the
+				first one due. */
+				uxStreamBufferGet( xRecvBuffer, sizeof( xLength ), ( uint8_t * ) &xSent, sizeof( xSent ), pdTRUE );
+				xAge = xTaskGetTickCount() - xSent;
+				xDelay = xLoopbackDelay;
+
+				if( xAge < xDelay )
+				{
+					( void ) ulTaskNotifyTake( pdTRUE, xDelay - xAge );
+					continue;
+				}
+			}
+			#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+			/* Get the next packet. */
+			uxStreamBufferGet( xRecvBuffer, 0, ( uint8_t * ) &xLength, sizeof( xLength ), pdFALSE );
+
+			#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+			{
+				/* Skip the time of sending. */
+				uxStreamBufferGet( xRecvBuffer, 0, NULL, sizeof( xSent ), pdFALSE );
+			}
+			#endif /* configNETWORK_INTERFACE_LOOPBACK */
+
+			uxStreamBufferGet( xRecvBuffer, 0, ucRecvBuffer, xLength, pdFALSE );
+
+			iptraceNETWORK_INTERFACE_RECEIVE();
+
+			/* Check for minimal size. */
+			if( xLength >= sizeof( EthernetHeader_t ) )
+			{
+				eResult = ipCONSIDER_FRAME_FOR_PROCESSING( ucRecvBuffer );
+			}
+			else
+			{
+				eResult = eReleaseBuffer;
+			}
+
+			if( eResult == eProcessBuffer )
+			{
+				/* Obtain a buffer into which the data can be placed.  This is
+				only an interrupt simulator, not a real interrupt, so it is ok
+				to call the task level function here, but note that some buffer
+				implementations cannot be called from a real interrupt. */
+				pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( xLength, 0 );
+
+				if( pxNetworkBuffer != NULL )
+				{
+					memcpy( pxNetworkBuffer->pucEthernetBuffer, ucRecvBuffer, xLength );
+					pxNetworkBuffer->xDataLength = xLength;
+
+					/* Data was received and stored.  Pass the buffer to the IP
+					task. */
+					if( xSendNetworkBufferToIPTask( pxNetworkBuffer, ( TickType_t ) 0 ) == pdFAIL )
+					{
+						/* The buffer could not be sent to the stack so must be
+						released again. */
+						vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+						iptraceETHERNET_RX_EVENT_LOST();
+					}
+				}
+				else
+				{
+					iptraceETHERNET_RX_EVENT_LOST();
+				}
+			}
+		}
+		else
+		{
+			#if( configNETWORK_INTERFACE_LOOPBACK == 1 )
+			{
+				/* Woken by xNetworkInterfaceOutput() as soon as a frame is
+				looped back. */
+				( void ) ulTaskNotifyTake( pdTRUE, configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY );
+			}
+			#else
+			{
+				/* There is no real way of simulating an interrupt from a host
+				thread.  Make sure other tasks can run. */
+				vTaskDelay( configLINUX_MAC_INTERRUPT_SIMULATOR_DELAY );
+			}
+			#endif
+		}
+	}
+}
+/*-----------------------------------------------------------*/
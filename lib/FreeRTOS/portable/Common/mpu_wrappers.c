@@ -42,6 +42,7 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "event_groups.h"
 #include "stream_buffer.h"
+#include "spsc_ring.h"
 #include "mpu_prototypes.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -566,6 +567,17 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+UBaseType_t uxReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	uxReturn = xQueueSendMultiple( xQueue, pvItems, uxItemCount, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
 UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t pxQueue )
 {
 BaseType_t xRunningPrivileged = xPortRaisePrivilege();
@@ -599,6 +611,17 @@ BaseType_t xReturn;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t pxQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+UBaseType_t uxReturn;
+
+	uxReturn = xQueueReceiveMultiple( pxQueue, pvBuffer, uxMaxItems, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
 {
 BaseType_t xRunningPrivileged = xPortRaisePrivilege();
@@ -1241,6 +1264,102 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 }
 /*-----------------------------------------------------------*/
 
+size_t MPU_xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t * const pxSpans, size_t xMaxLength, TickType_t xTicksToWait )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferAcquireWrite( xStreamBuffer, pxSpans, xMaxLength, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t * const pxSpans, size_t xMaxLength )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferAcquireWriteFromISR( xStreamBuffer, pxSpans, xMaxLength );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xLength )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferCommitWrite( xStreamBuffer, xLength );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xLength, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferCommitWriteFromISR( xStreamBuffer, xLength, pxHigherPriorityTaskWoken );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t * const pxSpans, TickType_t xTicksToWait )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferPeekRead( xStreamBuffer, pxSpans, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferPeekReadFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t * const pxSpans )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferPeekReadFromISR( xStreamBuffer, pxSpans );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer, size_t xLength )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferConsumeRead( xStreamBuffer, xLength );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xLength, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferConsumeReadFromISR( xStreamBuffer, xLength, pxHigherPriorityTaskWoken );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 	StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
 	{
@@ -1269,6 +1388,112 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	SPSCRingHandle_t MPU_xSPSCRingCreate( size_t xLength )
+	{
+	SPSCRingHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xSPSCRingCreate( xLength );
+		vPortResetPrivilege( xRunningPrivileged );
+
+		return xReturn;
+	}
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	SPSCRingHandle_t MPU_xSPSCRingCreateStatic( size_t xLength, void ** const ppvStorageArea, StaticSPSCRing_t * const pxStaticSPSCRing )
+	{
+	SPSCRingHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xSPSCRingCreateStatic( xLength, ppvStorageArea, pxStaticSPSCRing );
+		vPortResetPrivilege( xRunningPrivileged );
+
+		return xReturn;
+	}
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void MPU_vSPSCRingDelete( SPSCRingHandle_t xRing )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	vSPSCRingDelete( xRing );
+	vPortResetPrivilege( xRunningPrivileged );
+}
+/*-----------------------------------------------------------*/
+
+void MPU_vSPSCRingSetWakeUpCallback( SPSCRingHandle_t xRing, SPSCRingWakeUpCallback_t pxCallback )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	vSPSCRingSetWakeUpCallback( xRing, pxCallback );
+	vPortResetPrivilege( xRunningPrivileged );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xSPSCRingSend( SPSCRingHandle_t xRing, void *pvItem )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xSPSCRingSend( xRing, pvItem );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xSPSCRingSendFromISR( SPSCRingHandle_t xRing, void *pvItem, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xSPSCRingSendFromISR( xRing, pvItem, pxHigherPriorityTaskWoken );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xSPSCRingReceive( SPSCRingHandle_t xRing, void **ppvItem, TickType_t xTicksToWait )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xSPSCRingReceive( xRing, ppvItem, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xSPSCRingArmWakeUp( SPSCRingHandle_t xRing )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xSPSCRingArmWakeUp( xRing );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xSPSCRingItemsAvailable( SPSCRingHandle_t xRing )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xSPSCRingItemsAvailable( xRing );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 
 /* Functions that the application writer wants to execute in privileged mode
 can be defined in application_defined_privileged_functions.h.  The functions
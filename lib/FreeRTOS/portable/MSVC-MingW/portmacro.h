@@ -72,6 +72,9 @@ typedef unsigned long UBaseType_t;
 	#define portBYTE_ALIGNMENT		4
 #endif
 
+/* Tasks run in Windows threads, which may be scheduled on different cores. */
+#define portMEMORY_BARRIER()		MemoryBarrier()
+
 #define portYIELD()					vPortGenerateSimulatedInterrupt( portINTERRUPT_YIELD )
 
 /* Simulated interrupts return pdFALSE if no context switch should be performed,
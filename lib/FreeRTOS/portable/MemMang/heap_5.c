@@ -79,6 +79,8 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#include "heap_stats.h"
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -95,6 +97,9 @@ typedef struct A_BLOCK_LINK
 {
 	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
 	size_t xBlockSize;						/*<< The size of the free block. */
+	#if( configUSE_HEAP_STATS_PER_TASK == 1 )
+		UBaseType_t uxOwner;				/*<< The heap statistics entry of the task that allocated the block. */
+	#endif
 } BlockLink_t;
 
 /*-----------------------------------------------------------*/
@@ -231,6 +236,8 @@ void *pvReturn = NULL;
 					by the application and has no "next" block. */
 					pxBlock->xBlockSize |= xBlockAllocatedBit;
 					pxBlock->pxNextFreeBlock = NULL;
+
+					heapSTATS_MALLOC( pxBlock, pvReturn, pxBlock->xBlockSize & ~xBlockAllocatedBit );
 				}
 				else
 				{
@@ -247,6 +254,11 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		if( ( pvReturn == NULL ) && ( xWantedSize > 0 ) )
+		{
+			heapSTATS_MALLOC_FAILED( xWantedSize );
+		}
+
 		traceMALLOC( pvReturn, xWantedSize );
 	}
 	( void ) xTaskResumeAll();
@@ -300,6 +312,7 @@ BlockLink_t *pxLink;
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE( pv, pxLink->xBlockSize );
+					heapSTATS_FREE( pxLink, pv, pxLink->xBlockSize );
 					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
 				}
 				( void ) xTaskResumeAll();
@@ -0,0 +1,809 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that, like
+ * heap_4.c, combines (coalescences) adjacent memory blocks as they are freed,
+ * but that finds a free block in constant time no matter how fragmented the
+ * heap has become.
+ *
+ * heap_4.c and heap_5.c keep a single list of free blocks in address order,
+ * and pvPortMalloc() walks that list until it finds a block that is large
+ * enough.  The longer an application runs the more blocks the list tends to
+ * hold, and so the longer pvPortMalloc() keeps the scheduler suspended.  This
+ * implementation instead uses segregated fits (the scheme known as TLSF - Two
+ * Level Segregated Fit).  Free blocks are kept in a separate list per size
+ * class.  The first level of classes is a power of two, and each first level
+ * class is split into heapSL_INDEX_COUNT second level classes.  A bitmap per
+ * level records which lists are not empty so the smallest suitable class can
+ * be found with a couple of bit scans.  Each block also records the block
+ * that precedes it in memory so a freed block can be merged with both of its
+ * neighbours without searching any list.  Both pvPortMalloc() and vPortFree()
+ * therefore execute in constant time.
+ *
+ * The trade off compared to heap_4.c is a little more RAM - an array of list
+ * heads and the bitmaps (a few hundred bytes) plus one extra pointer in the
+ * header of every allocated block - and the block returned is a good fit
+ * rather than the first fit in address order.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * If configHEAP_6_USE_HEAP_REGIONS is 0 (the default) the heap is a single
+ * array of configTOTAL_HEAP_SIZE bytes and is initialised the first time
+ * pvPortMalloc() is called, exactly as heap_4.c.  configAPPLICATION_ALLOCATED_HEAP
+ * can be used to have the application define the array.
+ *
+ * If configHEAP_6_USE_HEAP_REGIONS is 1 the heap is made of the memory regions
+ * passed to vPortDefineHeapRegions(), exactly as heap_5.c, and
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc().  See
+ * heap_5.c for a description of the HeapRegion_t array.  Blocks are never
+ * merged across two regions.
+ *
+ * No single block can be larger than ( 1 << ( heapFL_INDEX_MAX + 1 ) ) - 1
+ * bytes, so every heap region must be smaller than that.
+ */
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "heap_stats.h"
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* The number of second level size classes within each first level size class
+is ( 1 << heapSL_INDEX_COUNT_LOG2 ).  More classes make a better fit more
+likely at the cost of a larger array of free list heads. */
+#define heapSL_INDEX_COUNT_LOG2	( 3 )
+#define heapSL_INDEX_COUNT		( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all belong to the first first level
+class, which is split linearly into heapSL_INDEX_COUNT classes of
+heapSMALL_BLOCK_GRANULE bytes each.  Larger blocks belong to the first level
+class given by the position of their most significant bit. */
+#define heapSMALL_BLOCK_GRANULE_LOG2	( 3 )
+#define heapSMALL_BLOCK_GRANULE		( ( size_t ) 1 << heapSMALL_BLOCK_GRANULE_LOG2 )
+#define heapFL_INDEX_SHIFT			( heapSL_INDEX_COUNT_LOG2 + heapSMALL_BLOCK_GRANULE_LOG2 )
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The position of the most significant bit of the largest block size that can
+be managed, and the resulting number of first level size classes.  The first
+level bitmap is 32 bits wide so heapFL_INDEX_COUNT must not exceed 32. */
+#define heapFL_INDEX_MAX			( 30 )
+#define heapFL_INDEX_COUNT			( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 2 )
+
+/* Block sizes must not get too small.  A free block must be able to hold the
+whole BlockLink_t structure. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) )
+
+/* Allocate the memory for the heap. */
+#if( configHEAP_6_USE_HEAP_REGIONS == 0 )
+	#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+		/* The application writer has already defined the array used for the RTOS
+		heap - probably so it can be placed in a special segment or address. */
+		extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#else
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#endif /* configAPPLICATION_ALLOCATED_HEAP */
+#endif /* configHEAP_6_USE_HEAP_REGIONS */
+
+/* Define the block header.  The members before pxNextFreeBlock are present in
+every block, allocated or free.  The last two members are only used while the
+block is free, and occupy the start of the memory returned to the application
+while the block is allocated. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxPrevPhysBlock;	/*<< The block immediately before this one in memory, or NULL if this is the first block of a heap region. */
+	size_t xBlockSize;						/*<< The size of the block, including the header. */
+	#if( configUSE_HEAP_STATS_PER_TASK == 1 )
+		UBaseType_t uxOwner;				/*<< The heap statistics entry of the task that allocated the block. */
+	#endif
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the same size class. */
+	struct A_BLOCK_LINK *pxPrevFreeBlock;	/*<< The previous free block in the same size class. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Calculates the first and second level indexes of the size class that a free
+ * block of xBlockSize bytes is stored in.
+ */
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex );
+
+/*
+ * Calculates the first and second level indexes of the smallest size class in
+ * which every block is at least xWantedSize bytes.  The first level index is
+ * heapFL_INDEX_COUNT or more if no size class is large enough.
+ */
+static void prvMappingSearch( size_t xWantedSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex );
+
+/*
+ * Returns the first block of the first non-empty size class at or above the
+ * class given by the indexes, which are updated to the class the block was
+ * found in.  Returns NULL if all such classes are empty.
+ */
+static BlockLink_t *prvSearchSuitableBlock( UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex );
+
+/*
+ * Adds a free block to the list of its size class.  The block is not merged
+ * with its neighbours.
+ */
+static void prvInsertFreeBlock( BlockLink_t *pxBlock );
+
+/*
+ * Removes a free block from the list of its size class.
+ */
+static void prvRemoveFreeBlock( BlockLink_t *pxBlock );
+
+/*
+ * Inserts a block of memory that is being freed into the list of its size
+ * class.  The block being freed will first be merged with the block in front
+ * of it and/or the block behind it if those blocks are also free.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
+
+/*
+ * Turns a region of memory into one free block followed by an end marker.
+ * Returns the number of bytes made available.
+ */
+static size_t prvAddHeapRegion( uint8_t *pucStartAddress, size_t xSizeInBytes );
+
+/*
+ * Returns the position of the least significant set bit.  ulBitmap must not
+ * be 0.
+ */
+static UBaseType_t prvFindFirstSet( uint32_t ulBitmap );
+
+/*
+ * Returns the position of the most significant set bit.  ulValue must not be
+ * 0.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue );
+
+#if( configHEAP_6_USE_HEAP_REGIONS == 0 )
+
+	/*
+	 * Called automatically to setup the required heap structures the first time
+	 * pvPortMalloc() is called.
+	 */
+	static void prvHeapInit( void );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of the structure placed at the beginning of each
+allocated memory block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The heads of the free lists of each size class, and the bitmaps that record
+which of the lists are not empty.  Bit n of ulFLBitmap is set if any bit of
+ulSLBitmap[ n ] is set. */
+static BlockLink_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFLBitmap = 0U;
+static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application (or is the end marker of a heap region).  When the bit is free the
+block is still part of the free heap space.  It is 0 until the heap has been
+initialised. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockLink_t *pxBlock, *pxNewBlockLink;
+UBaseType_t uxFLIndex, uxSLIndex;
+void *pvReturn = NULL;
+
+	#if( configHEAP_6_USE_HEAP_REGIONS == 1 )
+	{
+		/* The heap must be initialised before the first call to
+		prvPortMalloc(). */
+		configASSERT( xBlockAllocatedBit );
+	}
+	#endif
+
+	vTaskSuspendAll();
+	{
+		#if( configHEAP_6_USE_HEAP_REGIONS == 0 )
+		{
+			/* If this is the first call to malloc then the heap will require
+			initialisation to setup the lists of free blocks. */
+			if( xBlockAllocatedBit == 0 )
+			{
+				prvHeapInit();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		/* Check the requested block size is not so large that the top bit is
+		set.  The top bit of the block size member of the BlockLink_t structure
+		is used to determine who owns the block - the application or the
+		kernel, so it must be free. */
+		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		{
+			/* The wanted size is increased so it can contain the block header
+			in addition to the requested amount of bytes. */
+			if( xWantedSize > 0 )
+			{
+				xWantedSize += xHeapStructSize;
+
+				/* Ensure that blocks are always aligned to the required number
+				of bytes. */
+				if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+				{
+					/* Byte alignment required. */
+					xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block must be able to hold the free list links once it
+				is freed again. */
+				if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+				{
+					xWantedSize = heapMINIMUM_BLOCK_SIZE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+			{
+				/* Find the smallest size class in which every block is large
+				enough, then the first non-empty class at or above it. */
+				prvMappingSearch( xWantedSize, &uxFLIndex, &uxSLIndex );
+
+				if( uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT )
+				{
+					pxBlock = prvSearchSuitableBlock( &uxFLIndex, &uxSLIndex );
+				}
+				else
+				{
+					pxBlock = NULL;
+				}
+
+				if( pxBlock != NULL )
+				{
+					/* This block is being returned for use so must be taken out
+					of the list of free blocks. */
+					prvRemoveFreeBlock( pxBlock );
+
+					/* If the block is larger than required it can be split into
+					two. */
+					if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+					{
+						/* This block is to be split into two.  Create a new
+						block following the number of bytes requested. The void
+						cast is used to prevent byte alignment warnings from the
+						compiler. */
+						pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+						/* Calculate the sizes of two blocks split from the
+						single block, and link the new block into the chain of
+						blocks in memory. */
+						pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+						pxNewBlockLink->pxPrevPhysBlock = pxBlock;
+						( ( BlockLink_t * ) ( ( ( uint8_t * ) pxNewBlockLink ) + pxNewBlockLink->xBlockSize ) )->pxPrevPhysBlock = pxNewBlockLink;
+						pxBlock->xBlockSize = xWantedSize;
+
+						/* Insert the new block into the list of free blocks.
+						The block after it cannot be free as free blocks are
+						always merged, so there is nothing to merge with. */
+						prvInsertFreeBlock( pxNewBlockLink );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The block is being returned - it is allocated and owned
+					by the application.  Return the memory space pointed to -
+					jumping over the block header at its start. */
+					pxBlock->xBlockSize |= xBlockAllocatedBit;
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+					heapSTATS_MALLOC( pxBlock, pvReturn, pxBlock->xBlockSize & ~xBlockAllocatedBit );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( pvReturn == NULL ) && ( xWantedSize > 0 ) )
+		{
+			heapSTATS_MALLOC_FAILED( xWantedSize );
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a block header immediately before
+		it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			/* The block is being returned to the heap - it is no longer
+			allocated. */
+			pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+			vTaskSuspendAll();
+			{
+				/* Add this block to the list of free blocks. */
+				xFreeBytesRemaining += pxLink->xBlockSize;
+				traceFREE( pv, pxLink->xBlockSize );
+				heapSTATS_FREE( pxLink, pv, pxLink->xBlockSize );
+				prvInsertBlockIntoFreeList( pxLink );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( uint32_t ulBitmap )
+{
+static const uint8_t ucBitPosition[ 32 ] =
+{
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+	/* Isolate the least significant set bit, then use a de Bruijn sequence to
+	turn it into an index without looping. */
+	ulBitmap &= ( uint32_t ) ( 0UL - ulBitmap );
+	return ( UBaseType_t ) ucBitPosition[ ( uint32_t ) ( ulBitmap * 0x077CB531UL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue )
+{
+static const uint8_t ucBitPosition[ 32 ] =
+{
+	0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+	8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+};
+
+	/* Set every bit below the most significant set bit, then use a de Bruijn
+	sequence to turn the result into an index without looping. */
+	ulValue |= ulValue >> 1;
+	ulValue |= ulValue >> 2;
+	ulValue |= ulValue >> 4;
+	ulValue |= ulValue >> 8;
+	ulValue |= ulValue >> 16;
+	return ( UBaseType_t ) ucBitPosition[ ( uint32_t ) ( ulValue * 0x07C4ACDDUL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex )
+{
+UBaseType_t uxFLIndex;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are split linearly into second level classes. */
+		*puxFLIndex = 0;
+		*puxSLIndex = ( UBaseType_t ) ( xBlockSize >> heapSMALL_BLOCK_GRANULE_LOG2 );
+	}
+	else
+	{
+		/* The first level class is given by the most significant bit, and the
+		second level class by the heapSL_INDEX_COUNT_LOG2 bits below it. */
+		uxFLIndex = prvFindLastSet( ( uint32_t ) xBlockSize );
+		*puxSLIndex = ( UBaseType_t ) ( xBlockSize >> ( uxFLIndex - heapSL_INDEX_COUNT_LOG2 ) ) & ( heapSL_INDEX_COUNT - 1 );
+		*puxFLIndex = uxFLIndex - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingSearch( size_t xWantedSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex )
+{
+size_t xRoundedSize;
+
+	/* Round the size up to the start of the next size class, unless it is
+	already at the start of one, so every block in the class found is large
+	enough. */
+	if( xWantedSize < heapSMALL_BLOCK_SIZE )
+	{
+		xRoundedSize = xWantedSize + ( heapSMALL_BLOCK_GRANULE - 1 );
+	}
+	else if( ( xWantedSize >> heapFL_INDEX_MAX ) == 0 )
+	{
+		xRoundedSize = xWantedSize + ( ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1 );
+	}
+	else
+	{
+		/* Larger than any block that can be managed. */
+		*puxFLIndex = heapFL_INDEX_COUNT;
+		*puxSLIndex = 0;
+		return;
+	}
+
+	prvMappingInsert( xRoundedSize, puxFLIndex, puxSLIndex );
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvSearchSuitableBlock( UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex )
+{
+UBaseType_t uxFLIndex = *puxFLIndex;
+uint32_t ulFLMap, ulSLMap;
+
+	/* Look for a non-empty class at or above the second level index within
+	the same first level class. */
+	ulSLMap = ulSLBitmap[ uxFLIndex ] & ( ( uint32_t ) 0xffffffffUL << *puxSLIndex );
+
+	if( ulSLMap == 0U )
+	{
+		/* There is none, so use the smallest class of the next non-empty first
+		level class. */
+		ulFLMap = ulFLBitmap & ( ( uint32_t ) 0xffffffffUL << ( uxFLIndex + 1 ) );
+
+		if( ulFLMap == 0U )
+		{
+			/* No block is large enough. */
+			return NULL;
+		}
+
+		uxFLIndex = prvFindFirstSet( ulFLMap );
+		ulSLMap = ulSLBitmap[ uxFLIndex ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	*puxFLIndex = uxFLIndex;
+	*puxSLIndex = prvFindFirstSet( ulSLMap );
+
+	return pxFreeLists[ uxFLIndex ][ *puxSLIndex ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t *pxBlock )
+{
+UBaseType_t uxFLIndex, uxSLIndex;
+BlockLink_t *pxHead;
+
+	prvMappingInsert( pxBlock->xBlockSize, &uxFLIndex, &uxSLIndex );
+	pxHead = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+
+	/* Insert at the head of the list of the size class. */
+	pxBlock->pxPrevFreeBlock = NULL;
+	pxBlock->pxNextFreeBlock = pxHead;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPrevFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlock;
+
+	/* Record that the list is not empty. */
+	ulFLBitmap |= ( uint32_t ) 1UL << uxFLIndex;
+	ulSLBitmap[ uxFLIndex ] |= ( uint32_t ) 1UL << uxSLIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t *pxBlock )
+{
+UBaseType_t uxFLIndex, uxSLIndex;
+
+	prvMappingInsert( pxBlock->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPrevFreeBlock != NULL )
+	{
+		pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the head of the list. */
+		configASSERT( pxFreeLists[ uxFLIndex ][ uxSLIndex ] == pxBlock );
+		pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlock->pxNextFreeBlock;
+
+		/* Clear the bitmaps if the list is now empty. */
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSLBitmap[ uxFLIndex ] &= ~( ( uint32_t ) 1UL << uxSLIndex );
+
+			if( ulSLBitmap[ uxFLIndex ] == 0U )
+			{
+				ulFLBitmap &= ~( ( uint32_t ) 1UL << uxFLIndex );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
+{
+BlockLink_t *pxPrevBlock, *pxNextBlock;
+
+	/* Is the block in front of the block being inserted free?  If so remove
+	it from its list and form one big block from the two blocks. */
+	pxPrevBlock = pxBlockToInsert->pxPrevPhysBlock;
+
+	if( ( pxPrevBlock != NULL ) && ( ( pxPrevBlock->xBlockSize & xBlockAllocatedBit ) == 0 ) )
+	{
+		prvRemoveFreeBlock( pxPrevBlock );
+		pxPrevBlock->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxPrevBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Is the block behind the block being inserted free?  The end marker of
+	each heap region is marked as allocated, so is never merged. */
+	pxNextBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pxBlockToInsert ) + pxBlockToInsert->xBlockSize );
+
+	if( ( pxNextBlock->xBlockSize & xBlockAllocatedBit ) == 0 )
+	{
+		prvRemoveFreeBlock( pxNextBlock );
+		pxBlockToInsert->xBlockSize += pxNextBlock->xBlockSize;
+		pxNextBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pxBlockToInsert ) + pxBlockToInsert->xBlockSize );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The block now following the inserted block in memory must point back
+	to it. */
+	pxNextBlock->pxPrevPhysBlock = pxBlockToInsert;
+
+	prvInsertFreeBlock( pxBlockToInsert );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAddHeapRegion( uint8_t *pucStartAddress, size_t xSizeInBytes )
+{
+BlockLink_t *pxFirstFreeBlock, *pxEnd;
+size_t xAddress, xAlignedHeap;
+
+	/* Ensure the heap region starts on a correctly aligned boundary. */
+	xAddress = ( size_t ) pucStartAddress;
+
+	if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		xAddress += ( portBYTE_ALIGNMENT - 1 );
+		xAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		/* Adjust the size for the bytes lost to alignment. */
+		xSizeInBytes -= xAddress - ( size_t ) pucStartAddress;
+	}
+
+	xAlignedHeap = xAddress;
+
+	/* The region must be able to hold at least one block and the end marker,
+	and must not be larger than the largest block that can be managed. */
+	configASSERT( xSizeInBytes >= ( heapMINIMUM_BLOCK_SIZE + xHeapStructSize + portBYTE_ALIGNMENT ) );
+	configASSERT( ( xSizeInBytes >> ( heapFL_INDEX_MAX + 1 ) ) == 0 );
+
+	/* pxEnd is used to mark the end of the heap region.  It is marked as
+	allocated so the last free block is never merged with it. */
+	xAddress = xAlignedHeap + xSizeInBytes;
+	xAddress -= xHeapStructSize;
+	xAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( BlockLink_t * ) xAddress;
+
+	/* To start with there is a single free block in this region that is sized
+	to take up the entire heap region minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+	pxFirstFreeBlock->xBlockSize = xAddress - xAlignedHeap;
+
+	pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+	pxEnd->xBlockSize = xBlockAllocatedBit;
+
+	prvInsertFreeBlock( pxFirstFreeBlock );
+
+	return pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_6_USE_HEAP_REGIONS == 0 )
+
+	static void prvHeapInit( void )
+	{
+		/* Work out the position of the top bit in a size_t variable. */
+		xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+		/* Only one block exists - and it covers the entire usable heap space. */
+		xFreeBytesRemaining = prvAddHeapRegion( ucHeap, configTOTAL_HEAP_SIZE );
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+	}
+
+#else /* configHEAP_6_USE_HEAP_REGIONS */
+
+	void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+	{
+	size_t xTotalHeapSize = 0;
+	BaseType_t xDefinedRegions = 0;
+	const HeapRegion_t *pxHeapRegion;
+
+		/* Can only call once! */
+		configASSERT( xBlockAllocatedBit == 0 );
+
+		/* Work out the position of the top bit in a size_t variable.  It is
+		needed to mark the end of each region. */
+		xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+		pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+		while( pxHeapRegion->xSizeInBytes > 0 )
+		{
+			xTotalHeapSize += prvAddHeapRegion( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+
+			/* Move onto the next HeapRegion_t structure. */
+			xDefinedRegions++;
+			pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+		}
+
+		xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+		xFreeBytesRemaining = xTotalHeapSize;
+
+		/* Check something was actually defined before it is accessed. */
+		configASSERT( xTotalHeapSize );
+	}
+
+#endif /* configHEAP_6_USE_HEAP_REGIONS */
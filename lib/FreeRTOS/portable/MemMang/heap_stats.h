@@ -0,0 +1,302 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Optional instrumentation shared by heap_4.c, heap_5.c and heap_6.c.  This
+ * file is included by those files only and defines static functions, so must
+ * not be included anywhere else.
+ *
+ * If configUSE_HEAP_STATS_PER_TASK is 1 every allocated block records which
+ * task allocated it, and the bytes in use, peak bytes, number of allocations
+ * and frees and a histogram of the block sizes are kept for each task.  The
+ * statistics are read with vPortGetHeapStatsPerTask().  The table has
+ * configHEAP_STATS_MAX_TASKS entries.  Entry 0 counts the memory allocated
+ * before the scheduler was started, and the memory allocated by any task that
+ * does not fit in the table.  The entry of a deleted task is reused once all
+ * the memory the task allocated has been freed.
+ *
+ * If configHEAP_TRACE_BUFFER_LENGTH is greater than 0 the last
+ * configHEAP_TRACE_BUFFER_LENGTH allocations, failed allocations and frees are
+ * recorded in a ring buffer, xHeapTraceBuffer.  The buffer can be read with
+ * pxPortGetHeapTraceBuffer(), or dumped with a debugger, and decoded on the
+ * host with tools/heap_trace/heap_trace_decode.py.
+ *
+ * The functions below are called with the scheduler suspended.
+ */
+
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#if( configUSE_HEAP_STATS_PER_TASK == 1 )
+
+	#include <string.h>
+
+	#if( configHEAP_STATS_MAX_TASKS < 2 )
+		#error configHEAP_STATS_MAX_TASKS must be at least 2.
+	#endif
+
+	/* The table of statistics, and the entry of the task that allocated memory
+	most recently, which avoids searching the table on every allocation. */
+	static HeapTaskStats_t xHeapTaskStats[ configHEAP_STATS_MAX_TASKS ];
+	static UBaseType_t uxLastHeapStatsEntry = 0;
+
+#endif /* configUSE_HEAP_STATS_PER_TASK */
+
+#if( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+
+	/* Not static so it can be found by a debugger. */
+	HeapTraceBuffer_t xHeapTraceBuffer =
+	{
+		portHEAP_TRACE_MAGIC,
+		portHEAP_TRACE_VERSION,
+		( uint16_t ) sizeof( HeapTraceEvent_t ),
+		configHEAP_TRACE_BUFFER_LENGTH,
+		0UL,
+		{ { 0 } }
+	};
+
+	static void prvHeapTraceRecord( uint16_t usEvent, const void *pvAddress, size_t xSize, UBaseType_t uxOwner )
+	{
+	HeapTraceEvent_t *pxEvent;
+
+		pxEvent = &( xHeapTraceBuffer.xEvents[ xHeapTraceBuffer.ulEventsWritten % ( uint32_t ) configHEAP_TRACE_BUFFER_LENGTH ] );
+		pxEvent->ulTimestamp = ( uint32_t ) xTaskGetTickCount();
+		pxEvent->ulAddress = ( uint32_t ) ( size_t ) pvAddress;
+		pxEvent->ulSize = ( uint32_t ) xSize;
+		pxEvent->usOwner = ( uint16_t ) uxOwner;
+		pxEvent->usEvent = usEvent;
+		xHeapTraceBuffer.ulEventsWritten++;
+	}
+	/*-----------------------------------------------------------*/
+
+	const HeapTraceBuffer_t *pxPortGetHeapTraceBuffer( size_t *pxBufferSize )
+	{
+		*pxBufferSize = sizeof( xHeapTraceBuffer );
+		return &xHeapTraceBuffer;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_TRACE_BUFFER_LENGTH */
+
+#if( configUSE_HEAP_STATS_PER_TASK == 1 )
+
+	static UBaseType_t prvHeapStatsCurrentEntry( void )
+	{
+	void *pvTask;
+	UBaseType_t uxEntry, uxFree = 0;
+	const char *pcName;
+
+		if( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+		{
+			return 0;
+		}
+
+		pvTask = ( void * ) xTaskGetCurrentTaskHandle();
+
+		/* Most allocations are made by the same task as the previous one. */
+		if( ( xHeapTaskStats[ uxLastHeapStatsEntry ].pvTask == pvTask ) && ( xHeapTaskStats[ uxLastHeapStatsEntry ].xTaskDeleted == pdFALSE ) )
+		{
+			return uxLastHeapStatsEntry;
+		}
+
+		for( uxEntry = 1; uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS; uxEntry++ )
+		{
+			if( ( xHeapTaskStats[ uxEntry ].pvTask == pvTask ) && ( xHeapTaskStats[ uxEntry ].xTaskDeleted == pdFALSE ) )
+			{
+				break;
+			}
+
+			/* Remember the first entry that is unused, or whose task has been
+			deleted and holds no memory any more. */
+			if( ( uxFree == 0 ) &&
+				( ( xHeapTaskStats[ uxEntry ].pvTask == NULL ) ||
+				  ( ( xHeapTaskStats[ uxEntry ].xTaskDeleted != pdFALSE ) && ( xHeapTaskStats[ uxEntry ].xCurrentBytes == 0 ) ) ) )
+			{
+				uxFree = uxEntry;
+			}
+		}
+
+		if( uxEntry == ( UBaseType_t ) configHEAP_STATS_MAX_TASKS )
+		{
+			/* The task has no entry yet.  If the table is full its memory is
+			counted in entry 0. */
+			uxEntry = uxFree;
+
+			if( uxEntry != 0 )
+			{
+				memset( &( xHeapTaskStats[ uxEntry ] ), 0x00, sizeof( HeapTaskStats_t ) );
+				xHeapTaskStats[ uxEntry ].pvTask = pvTask;
+				pcName = pcTaskGetName( NULL );
+				strncpy( xHeapTaskStats[ uxEntry ].pcTaskName, pcName, portHEAP_STATS_TASK_NAME_LEN - 1 );
+			}
+		}
+
+		uxLastHeapStatsEntry = uxEntry;
+
+		return uxEntry;
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvHeapStatsMalloc( const void *pvAddress, size_t xBlockSize )
+	{
+	UBaseType_t uxEntry, uxBucket;
+	HeapTaskStats_t *pxStats;
+
+		uxEntry = prvHeapStatsCurrentEntry();
+		pxStats = &( xHeapTaskStats[ uxEntry ] );
+
+		pxStats->xCurrentBytes += xBlockSize;
+		pxStats->ulAllocations++;
+
+		if( pxStats->xCurrentBytes > pxStats->xPeakBytes )
+		{
+			pxStats->xPeakBytes = pxStats->xCurrentBytes;
+		}
+
+		for( uxBucket = 0; uxBucket < ( portHEAP_STATS_HISTOGRAM_BUCKETS - 1 ); uxBucket++ )
+		{
+			if( xBlockSize <= ( ( size_t ) 16 << uxBucket ) )
+			{
+				break;
+			}
+		}
+
+		pxStats->ulSizeHistogram[ uxBucket ]++;
+
+		#if( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+		{
+			prvHeapTraceRecord( portHEAP_TRACE_EVENT_MALLOC, pvAddress, xBlockSize, uxEntry );
+		}
+		#else
+		{
+			( void ) pvAddress;
+		}
+		#endif
+
+		return uxEntry;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvHeapStatsFree( const void *pvAddress, size_t xBlockSize, UBaseType_t uxEntry )
+	{
+		configASSERT( uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS );
+		configASSERT( xHeapTaskStats[ uxEntry ].xCurrentBytes >= xBlockSize );
+
+		xHeapTaskStats[ uxEntry ].xCurrentBytes -= xBlockSize;
+		xHeapTaskStats[ uxEntry ].ulFrees++;
+
+		#if( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+		{
+			prvHeapTraceRecord( portHEAP_TRACE_EVENT_FREE, pvAddress, xBlockSize, uxEntry );
+		}
+		#else
+		{
+			( void ) pvAddress;
+		}
+		#endif
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvHeapStatsFailed( size_t xWantedSize )
+	{
+	UBaseType_t uxEntry;
+
+		uxEntry = prvHeapStatsCurrentEntry();
+		xHeapTaskStats[ uxEntry ].ulFailedAllocations++;
+
+		#if( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+		{
+			prvHeapTraceRecord( portHEAP_TRACE_EVENT_FAILED, NULL, xWantedSize, uxEntry );
+		}
+		#else
+		{
+			( void ) xWantedSize;
+		}
+		#endif
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetHeapStatsPerTask( HeapTaskStats_t *pxTaskStats, UBaseType_t *puxArraySize )
+	{
+	UBaseType_t uxEntry, uxWritten = 0;
+
+		vTaskSuspendAll();
+		{
+			for( uxEntry = 0; ( uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS ) && ( uxWritten < *puxArraySize ); uxEntry++ )
+			{
+				/* Entry 0 is always reported, the others once they are used. */
+				if( ( uxEntry == 0 ) || ( xHeapTaskStats[ uxEntry ].pvTask != NULL ) )
+				{
+					pxTaskStats[ uxWritten ] = xHeapTaskStats[ uxEntry ];
+					uxWritten++;
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		*puxArraySize = uxWritten;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHeapStatsTaskDeleted( void *pvTask )
+	{
+	UBaseType_t uxEntry;
+
+		for( uxEntry = 1; uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS; uxEntry++ )
+		{
+			if( ( xHeapTaskStats[ uxEntry ].pvTask == pvTask ) && ( xHeapTaskStats[ uxEntry ].xTaskDeleted == pdFALSE ) )
+			{
+				xHeapTaskStats[ uxEntry ].xTaskDeleted = pdTRUE;
+				break;
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	/* Called when pvPortMalloc() returns pxBlock, which holds xBlockSize bytes
+	including its header, and when it fails to allocate xWantedSize bytes. */
+	#define heapSTATS_MALLOC( pxBlock, pvAddress, xBlockSize )	( pxBlock )->uxOwner = prvHeapStatsMalloc( ( pvAddress ), ( xBlockSize ) )
+	#define heapSTATS_MALLOC_FAILED( xWantedSize )				prvHeapStatsFailed( xWantedSize )
+
+	/* Called when vPortFree() frees pxBlock. */
+	#define heapSTATS_FREE( pxBlock, pvAddress, xBlockSize )	prvHeapStatsFree( ( pvAddress ), ( xBlockSize ), ( pxBlock )->uxOwner )
+
+#elif( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+
+	#define heapSTATS_MALLOC( pxBlock, pvAddress, xBlockSize )	prvHeapTraceRecord( portHEAP_TRACE_EVENT_MALLOC, ( pvAddress ), ( xBlockSize ), portHEAP_TRACE_NO_OWNER )
+	#define heapSTATS_MALLOC_FAILED( xWantedSize )				prvHeapTraceRecord( portHEAP_TRACE_EVENT_FAILED, NULL, ( xWantedSize ), portHEAP_TRACE_NO_OWNER )
+	#define heapSTATS_FREE( pxBlock, pvAddress, xBlockSize )	prvHeapTraceRecord( portHEAP_TRACE_EVENT_FREE, ( pvAddress ), ( xBlockSize ), portHEAP_TRACE_NO_OWNER )
+
+#else
+
+	#define heapSTATS_MALLOC( pxBlock, pvAddress, xBlockSize )
+	#define heapSTATS_MALLOC_FAILED( xWantedSize )
+	#define heapSTATS_FREE( pxBlock, pvAddress, xBlockSize )
+
+#endif /* configUSE_HEAP_STATS_PER_TASK */
+
+#endif /* HEAP_STATS_H */
@@ -0,0 +1,807 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX (Linux)
+ * simulator.
+ *
+ * Each task has a pthread which runs the task's code.  A thread is only
+ * allowed to run while its task is the one selected by the scheduler, all
+ * other task threads wait on their own condition variable.  A context switch
+ * resumes the thread of the task being switched in and then suspends the
+ * thread of the task being switched out.
+ *
+ * The tick interrupt is generated with setitimer() and delivered as SIGALRM.
+ * "Disabling interrupts" blocks all signals (except SIGINT so the
+ * application can still be interrupted) in the calling thread.  Threads that
+ * are not running a FreeRTOS task, such as the threads a network driver
+ * uses to talk to the host, must be created with all signals blocked (for
+ * example from within a critical section) so the tick is never handled on
+ * them.
+ *
+ * As with the Windows simulator the FreeRTOS task stack is not used to run
+ * the task, each pthread has a stack allocated by the host.  The FreeRTOS
+ * stack only holds the Thread_t structure below, so configMINIMAL_STACK_SIZE
+ * can be kept small.
+ *
+ * When configNUM_CORES is greater than 1 the thread of the task selected for
+ * each core runs, so up to configNUM_CORES task threads run at once.  A
+ * thread learns the core it stands in for when it is resumed.  The tick is
+ * handled by whichever running thread the host delivers SIGALRM to, and a
+ * core is made to yield by sending portSIG_YIELD_CORE to the thread of the
+ * task running on it.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The signal used to wake up the main thread when the scheduler ends. */
+#define portSIG_RESUME					SIGUSR1
+
+/* The signal used to make another core yield. */
+#define portSIG_YIELD_CORE				SIGUSR2
+
+#define portNO_CRITICAL_NESTING 		( ( UBaseType_t ) 0 )
+
+#if( configNUM_CORES > 1 )
+	/* Several task threads run at once, so the variables that describe the
+	running task are kept per thread. */
+	#define portTHREAD_LOCAL			__thread
+
+	/* The owner of a kernel lock that is not held. */
+	#define portLOCK_NOT_OWNED			( ( BaseType_t ) -1 )
+#else
+	#define portTHREAD_LOCAL
+#endif
+
+/*
+ * Used to suspend and resume a task thread.  A separate flag is used because
+ * condition variables can wake up spuriously.
+ */
+typedef struct Event
+{
+	pthread_mutex_t xMutex;
+	pthread_cond_t xCond;
+	BaseType_t xSignalled;
+} Event_t;
+
+/*
+ * The per task data the port needs.  It is stored at the top of the task's
+ * FreeRTOS stack, where it can be found from the TCB's pxTopOfStack member.
+ */
+typedef struct Thread
+{
+	pthread_t xPthread;
+	TaskFunction_t pxCode;
+	void *pvParams;
+	volatile BaseType_t xDying;
+	Event_t xEvent;
+	#if( configNUM_CORES > 1 )
+		BaseType_t xCoreID;		/* Written by the thread that resumes this one. */
+	#endif
+} Thread_t;
+
+#if( configNUM_CORES > 1 )
+
+	/*
+	 * A spinlock that can be taken again by the core that holds it.
+	 */
+	typedef struct CoreLock
+	{
+		volatile BaseType_t xOwner;
+		UBaseType_t uxCount;
+	} CoreLock_t;
+
+#endif
+
+/*
+ * Set up the signal handlers and block all signals in the thread that
+ * creates the first task, so every task thread inherits the blocked mask.
+ */
+static void prvSetupSignalsAndSchedulerPolicy( void );
+
+/*
+ * Start the periodic timer that generates SIGALRM at configTICK_RATE_HZ.
+ */
+static void prvSetupTimerInterrupt( void );
+
+/*
+ * Entry point of every task thread.  Waits until the scheduler switches to
+ * the task for the first time before calling the task function.
+ */
+static void *prvWaitForStart( void *pvParams );
+
+/*
+ * The tick interrupt handler.
+ */
+static void prvSystemTickHandler( int iSignal );
+
+/*
+ * Handler for portSIG_RESUME.  The signal is consumed by sigwait(), but it
+ * must not be ignored or it would be discarded when it is generated.
+ */
+static void prvResumeSignalHandler( int iSignal );
+
+#if( configNUM_CORES > 1 )
+
+	/*
+	 * Handler for portSIG_YIELD_CORE, the simulated inter-core interrupt.
+	 */
+	static void prvYieldCoreHandler( int iSignal );
+
+	static void prvGetLock( CoreLock_t *pxLock );
+	static void prvReleaseLock( CoreLock_t *pxLock );
+
+#endif
+
+/*
+ * Make pxThreadToResume the running thread and suspend the calling thread,
+ * which must be pxThreadToSuspend.
+ */
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend );
+
+/*
+ * Suspend the calling thread until prvResumeThread() is called for it.
+ */
+static void prvSuspendSelf( Thread_t *pxThread );
+
+/*
+ * Resume a thread suspended in prvSuspendSelf().
+ */
+static void prvResumeThread( Thread_t *pxThread );
+
+/*
+ * Thread_t of a task.
+ */
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask );
+
+/*
+ * Exits the process if a pthread call failed, there is no way to recover.
+ */
+static void prvFatalError( const char *pcCall, int iErrno );
+
+/*-----------------------------------------------------------*/
+
+static pthread_once_t xSigSetupOnce = PTHREAD_ONCE_INIT;
+static sigset_t xAllSignals;
+static sigset_t xSchedulerOriginalSignalMask;
+static pthread_t xMainThread;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+
+/* The critical nesting count of the running task.  The value of the task
+being switched out is saved on its pthread's stack in prvSwitchThread(). */
+static portTHREAD_LOCAL volatile UBaseType_t uxCriticalNesting = portNO_CRITICAL_NESTING;
+
+#if( configNUM_CORES > 1 )
+
+	/* The core the calling thread runs on.  Threads that do not run a task,
+	including the thread that starts the scheduler, are core 0. */
+	static portTHREAD_LOCAL BaseType_t xThisCoreID = 0;
+
+	static CoreLock_t xTaskLock = { portLOCK_NOT_OWNED, 0 };
+	static CoreLock_t xISRLock = { portLOCK_NOT_OWNED, 0 };
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvEventInit( Event_t *pxEvent )
+{
+	pthread_mutex_init( &( pxEvent->xMutex ), NULL );
+	pthread_cond_init( &( pxEvent->xCond ), NULL );
+	pxEvent->xSignalled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventDelete( Event_t *pxEvent )
+{
+	pthread_cond_destroy( &( pxEvent->xCond ) );
+	pthread_mutex_destroy( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventUnlock( void *pvMutex )
+{
+	pthread_mutex_unlock( ( pthread_mutex_t * ) pvMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( Event_t *pxEvent )
+{
+	pthread_mutex_lock( &( pxEvent->xMutex ) );
+
+	/* pthread_cond_wait() is a cancellation point, make sure the mutex is
+	released if the thread is cancelled by vPortCancelThread(). */
+	pthread_cleanup_push( prvEventUnlock, &( pxEvent->xMutex ) );
+
+	while( pxEvent->xSignalled == pdFALSE )
+	{
+		pthread_cond_wait( &( pxEvent->xCond ), &( pxEvent->xMutex ) );
+	}
+
+	pxEvent->xSignalled = pdFALSE;
+
+	pthread_cleanup_pop( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSignal( Event_t *pxEvent )
+{
+	pthread_mutex_lock( &( pxEvent->xMutex ) );
+	pxEvent->xSignalled = pdTRUE;
+	pthread_cond_signal( &( pxEvent->xCond ) );
+	pthread_mutex_unlock( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xThreadAttributes;
+sigset_t xOriginalSignalMask;
+int iRet;
+
+	( void ) pthread_once( &xSigSetupOnce, prvSetupSignalsAndSchedulerPolicy );
+
+	/* Store the additional thread data at the top of the stack.  pxTopOfStack
+	points to the last usable word of the stack. */
+	pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xDying = pdFALSE;
+	prvEventInit( &( pxThread->xEvent ) );
+
+	pthread_attr_init( &xThreadAttributes );
+
+	/* Create the thread with signals blocked so the tick is not handled on a
+	thread that is not running. */
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xOriginalSignalMask );
+	iRet = pthread_create( &( pxThread->xPthread ), &xThreadAttributes, prvWaitForStart, pxThread );
+	( void ) pthread_sigmask( SIG_SETMASK, &xOriginalSignalMask, NULL );
+
+	pthread_attr_destroy( &xThreadAttributes );
+
+	if( iRet != 0 )
+	{
+		prvFatalError( "pthread_create", iRet );
+	}
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+int iSignal;
+sigset_t xSignals;
+
+	xMainThread = pthread_self();
+
+	/* Start the timer that generates the tick.  Interrupts are already
+	disabled at this point. */
+	prvSetupTimerInterrupt();
+
+	/* Start the first task. */
+	#if( configNUM_CORES > 1 )
+	{
+	BaseType_t xCoreID;
+	Thread_t *pxThread;
+
+		/* Start the task selected for each core. */
+		for( xCoreID = 0; xCoreID < configNUM_CORES; xCoreID++ )
+		{
+			pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+			pxThread->xCoreID = xCoreID;
+			prvResumeThread( pxThread );
+		}
+	}
+	#else
+	{
+		prvResumeThread( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+	}
+	#endif
+
+	/* The main thread is not used to run tasks, wait until signalled by
+	vPortEndScheduler(). */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSIG_RESUME );
+
+	while( xSchedulerEnd == pdFALSE )
+	{
+		( void ) sigwait( &xSignals, &iSignal );
+	}
+
+	/* Restore the signal mask the application had before the first task was
+	created. */
+	( void ) pthread_sigmask( SIG_SETMASK, &xSchedulerOriginalSignalMask, NULL );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+struct sigaction xSigTick;
+
+	/* Stop the timer and ignore any pending SIGALRM that would otherwise be
+	handled on the main thread once it restores its signal mask. */
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	memset( &xSigTick, 0, sizeof( xSigTick ) );
+	xSigTick.sa_handler = SIG_IGN;
+	sigemptyset( &xSigTick.sa_mask );
+	( void ) sigaction( SIGALRM, &xSigTick, NULL );
+
+	/* Signal the main thread to return from xPortStartScheduler(). */
+	xSchedulerEnd = pdTRUE;
+	( void ) pthread_kill( xMainThread, portSIG_RESUME );
+
+	/* The calling task never runs again. */
+	prvSuspendSelf( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+	{
+		vPortDisableInterrupts();
+	}
+
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting > portNO_CRITICAL_NESTING );
+
+	uxCriticalNesting--;
+
+	/* If we have reached 0 then re-enable the interrupts. */
+	if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldFromCritical( void )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	vTaskSwitchContext();
+
+	pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	vPortEnterCritical();
+	{
+		prvYieldFromCritical();
+	}
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	UBaseType_t xPortSetInterruptMask( void )
+	{
+	sigset_t xPreviousSignalMask;
+
+		/* The kernel masks interrupts to stop the calling task being moved to
+		another core, so the mask must be real and must nest.  The return value
+		is pdTRUE if interrupts were already masked. */
+		( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignalMask );
+
+		return ( sigismember( &xPreviousSignalMask, SIGALRM ) == 1 ) ? pdTRUE : pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortClearInterruptMask( UBaseType_t uxMask )
+	{
+		if( uxMask == pdFALSE )
+		{
+			vPortEnableInterrupts();
+		}
+	}
+
+#else
+
+	UBaseType_t xPortSetInterruptMask( void )
+	{
+		/* Interrupts are always disabled inside simulated interrupts (signal
+		handlers), and the FromISR API functions are otherwise only called from
+		tasks. */
+		return pdTRUE;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortClearInterruptMask( UBaseType_t uxMask )
+	{
+		( void ) uxMask;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	( void ) pxPendYield;
+
+	/* The thread exits when the task yields away for the last time at the
+	end of vTaskDelete(). */
+	pxThread->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	/* The thread is either suspended in prvSuspendSelf() or has already
+	exited, in both cases it is safe to cancel it and reclaim its resources. */
+	( void ) pthread_cancel( pxThread->xPthread );
+	( void ) pthread_join( pxThread->xPthread, NULL );
+	prvEventDelete( &( pxThread->xEvent ) );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForStart( void *pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	prvSuspendSelf( pxThread );
+
+	#if( configNUM_CORES > 1 )
+	{
+		xThisCoreID = pxThread->xCoreID;
+	}
+	#endif
+
+	/* Resumed for the first time, the task starts with interrupts enabled. */
+	uxCriticalNesting = portNO_CRITICAL_NESTING;
+	vPortEnableInterrupts();
+
+	pxThread->pxCode( pxThread->pvParams );
+
+	/* A function that implements a task must not exit or attempt to return to
+	its caller as there is nothing to return to.  If a task wants to exit it
+	should instead call vTaskDelete( NULL ). */
+	configASSERT( pdFALSE );
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+UBaseType_t uxSavedCriticalNesting;
+
+	if( pxThreadToSuspend != pxThreadToResume )
+	{
+		/* Save the critical nesting of the task being switched out, the
+		global is overwritten by the task being switched in. */
+		uxSavedCriticalNesting = uxCriticalNesting;
+
+		#if( configNUM_CORES > 1 )
+		{
+			/* Hand this core over to the thread being resumed.  The core of
+			the calling thread is not read from its Thread_t, as another core
+			may already have selected its task and written to it. */
+			pxThreadToResume->xCoreID = xThisCoreID;
+		}
+		#endif
+
+		prvResumeThread( pxThreadToResume );
+
+		if( pxThreadToSuspend->xDying != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+
+		prvSuspendSelf( pxThreadToSuspend );
+
+		#if( configNUM_CORES > 1 )
+		{
+			xThisCoreID = pxThreadToSuspend->xCoreID;
+		}
+		#endif
+
+		uxCriticalNesting = uxSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSystemTickHandler( int iSignal )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+
+	( void ) iSignal;
+
+	/* Signals are blocked while the handler runs. */
+	uxCriticalNesting++;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	if( xTaskIncrementTick() != pdFALSE )
+	{
+		/* Select the next task. */
+		vTaskSwitchContext();
+
+		pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+		prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+	}
+
+	uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeSignalHandler( int iSignal )
+{
+	( void ) iSignal;
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	static void prvYieldCoreHandler( int iSignal )
+	{
+	Thread_t *pxThreadToSuspend;
+	Thread_t *pxThreadToResume;
+
+		( void ) iSignal;
+
+		/* As for the tick, signals are blocked while the handler runs. */
+		uxCriticalNesting++;
+
+		pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+		vTaskSwitchContext();
+
+		pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+		prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+
+		uxCriticalNesting--;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xPortGetCoreID( void )
+	{
+		return xThisCoreID;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortYieldCore( BaseType_t xCoreID )
+	{
+		/* Called with the kernel locks held, so the task running on the core
+		cannot change.  If the thread has signals blocked the signal is held
+		pending until it unblocks them. */
+		( void ) pthread_kill( prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) )->xPthread, portSIG_YIELD_CORE );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvGetLock( CoreLock_t *pxLock )
+	{
+	BaseType_t xExpected;
+
+		/* Only the calling core can have set the owner to its own number, so
+		reading it without synchronisation is safe. */
+		if( __atomic_load_n( &( pxLock->xOwner ), __ATOMIC_RELAXED ) != xThisCoreID )
+		{
+			for( ;; )
+			{
+				xExpected = portLOCK_NOT_OWNED;
+
+				if( __atomic_compare_exchange_n( &( pxLock->xOwner ), &xExpected, xThisCoreID, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+				{
+					break;
+				}
+
+				/* The host may have fewer CPUs than there are simulated cores,
+				let the owner run. */
+				( void ) sched_yield();
+			}
+		}
+
+		pxLock->uxCount++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseLock( CoreLock_t *pxLock )
+	{
+		configASSERT( ( pxLock->xOwner == xThisCoreID ) && ( pxLock->uxCount > 0U ) );
+
+		pxLock->uxCount--;
+
+		if( pxLock->uxCount == 0U )
+		{
+			__atomic_store_n( &( pxLock->xOwner ), portLOCK_NOT_OWNED, __ATOMIC_RELEASE );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetTaskLock( void )
+	{
+		prvGetLock( &xTaskLock );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortReleaseTaskLock( void )
+	{
+		prvReleaseLock( &xTaskLock );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetISRLock( void )
+	{
+		prvGetLock( &xISRLock );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortReleaseISRLock( void )
+	{
+		prvReleaseLock( &xISRLock );
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configNUM_CORES */
+
+static void prvSuspendSelf( Thread_t *pxThread )
+{
+	prvEventWait( &( pxThread->xEvent ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeThread( Thread_t *pxThread )
+{
+	prvEventSignal( &( pxThread->xEvent ) );
+}
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	/* pxTopOfStack is the first member of the TCB and is never changed by
+	this port, the Thread_t is directly above it. */
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignalsAndSchedulerPolicy( void )
+{
+struct sigaction xSigTick;
+struct sigaction xSigResume;
+
+	/* All signals but SIGINT are blocked while interrupts are disabled. */
+	sigfillset( &xAllSignals );
+	sigdelset( &xAllSignals, SIGINT );
+
+	/* Block all signals in the calling thread (and therefore in every thread
+	it creates) until the scheduler runs the tasks. */
+	( void ) pthread_sigmask( SIG_SETMASK, &xAllSignals, &xSchedulerOriginalSignalMask );
+
+	memset( &xSigResume, 0, sizeof( xSigResume ) );
+	xSigResume.sa_handler = prvResumeSignalHandler;
+	sigfillset( &xSigResume.sa_mask );
+
+	memset( &xSigTick, 0, sizeof( xSigTick ) );
+	xSigTick.sa_handler = prvSystemTickHandler;
+	sigfillset( &xSigTick.sa_mask );
+
+	if( sigaction( portSIG_RESUME, &xSigResume, NULL ) != 0 )
+	{
+		prvFatalError( "sigaction", errno );
+	}
+
+	if( sigaction( SIGALRM, &xSigTick, NULL ) != 0 )
+	{
+		prvFatalError( "sigaction", errno );
+	}
+
+	#if( configNUM_CORES > 1 )
+	{
+	struct sigaction xSigYieldCore;
+
+		memset( &xSigYieldCore, 0, sizeof( xSigYieldCore ) );
+		xSigYieldCore.sa_handler = prvYieldCoreHandler;
+		sigfillset( &xSigYieldCore.sa_mask );
+
+		if( sigaction( portSIG_YIELD_CORE, &xSigYieldCore, NULL ) != 0 )
+		{
+			prvFatalError( "sigaction", errno );
+		}
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xTimer;
+
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+	xTimer.it_value = xTimer.it_interval;
+
+	if( setitimer( ITIMER_REAL, &xTimer, NULL ) != 0 )
+	{
+		prvFatalError( "setitimer", errno );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char *pcCall, int iErrno )
+{
+	fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+	abort();
+}
+/*-----------------------------------------------------------*/
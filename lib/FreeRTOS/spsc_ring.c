@@ -0,0 +1,478 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_ring.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* Bits stored in the ucFlags field of the ring. */
+#define srFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 1 ) /* Set if the ring was created using statically allocated memory. */
+
+/*-----------------------------------------------------------*/
+
+/* Structure that holds state information on the ring.  xHead and
+uxWakeUpsSent are only written by the producer, xTail, xTaskWaitingToReceive
+and uxWakeUpsRequested are only written by the consumer.  That is what allows
+the ring to be used without a critical section. */
+typedef struct xSPSC_RING /*lint !e9058 Style convention uses tag. */
+{
+	volatile size_t xHead;				/* Index of the next entry to write within the storage area. */
+	volatile size_t xTail;				/* Index of the next entry to read within the storage area. */
+	size_t xLength;						/* The number of entries in the storage area, one more than the number of items the ring can hold. */
+	void * volatile *ppvStorage;		/* Points to the storage area - the array of pointers passed through the ring. */
+	volatile TaskHandle_t xTaskWaitingToReceive; /* The handle of the task that last blocked in xSPSCRingReceive(). */
+	SPSCRingWakeUpCallback_t pxWakeUpCallback; /* Called in place of notifying xTaskWaitingToReceive, if not NULL. */
+	volatile UBaseType_t uxWakeUpsRequested;	/* Incremented each time the consumer arms the wake up. */
+	volatile UBaseType_t uxWakeUpsSent;		/* Set to uxWakeUpsRequested each time the producer wakes the consumer. */
+	uint8_t ucFlags;
+} SPSCRing_t;
+
+/*
+ * Called by both xSPSCRingCreate() and xSPSCRingCreateStatic() to initialise
+ * the members of the newly created ring structure.
+ */
+static void prvInitialiseNewSPSCRing( SPSCRing_t * const pxRing,
+									  void ** const ppvStorage,
+									  size_t xLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes pvItem to the ring if it is not full.  Called by the producer.
+ */
+static BaseType_t prvWriteItemToRing( SPSCRing_t * const pxRing, void *pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakes the consumer if it armed the wake up since it was last woken.  Called
+ * by the producer after it sent an item.  pxHigherPriorityTaskWoken is NULL if
+ * the producer is a task.
+ */
+static void prvWakeUpConsumer( SPSCRing_t * const pxRing, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	SPSCRingHandle_t xSPSCRingCreate( size_t xLength )
+	{
+	uint8_t *pucAllocatedMemory;
+	size_t xStorageLength;
+
+		configASSERT( xLength > ( size_t ) 0 );
+
+		/* A ring requires an SPSCRing_t structure and a storage area.  Both are
+		allocated in a single call to pvPortMalloc().  The SPSCRing_t structure
+		is placed at the start of the allocated memory and the storage area
+		follows immediately after.  The storage area holds one entry more than
+		the number of items requested, see xSPSCRingCreateStatic(). */
+		xStorageLength = xLength + ( size_t ) 1;
+		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( SPSCRing_t ) + ( xStorageLength * sizeof( void * ) ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pucAllocatedMemory != NULL )
+		{
+			prvInitialiseNewSPSCRing( ( SPSCRing_t * ) pucAllocatedMemory, /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+									  ( void ** ) ( pucAllocatedMemory + sizeof( SPSCRing_t ) ), /* Storage area follows. */ /*lint !e9087 !e826 The structure size is a multiple of the pointer size. */
+									  xStorageLength );
+
+			traceSPSC_RING_CREATE( ( ( SPSCRing_t * ) pucAllocatedMemory ) );
+		}
+		else
+		{
+			traceSPSC_RING_CREATE_FAILED();
+		}
+
+		return ( SPSCRingHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	SPSCRingHandle_t xSPSCRingCreateStatic( size_t xLength,
+											void ** const ppvStorageArea,
+											StaticSPSCRing_t * const pxStaticSPSCRing )
+	{
+	SPSCRing_t * const pxRing = ( SPSCRing_t * ) pxStaticSPSCRing; /*lint !e740 !e9087 Safe cast as StaticSPSCRing_t is opaque SPSCRing_t. */
+	SPSCRingHandle_t xReturn;
+
+		configASSERT( xLength > ( size_t ) 0 );
+		configASSERT( ppvStorageArea );
+		configASSERT( pxStaticSPSCRing );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticSPSCRing_t equals the size of the real ring
+			structure. */
+			volatile size_t xSize = sizeof( StaticSPSCRing_t );
+			configASSERT( xSize == sizeof( SPSCRing_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( ( ppvStorageArea != NULL ) && ( pxStaticSPSCRing != NULL ) )
+		{
+			/* One entry of the storage area is always left unused, so xHead
+			only equals xTail when the ring is empty. */
+			prvInitialiseNewSPSCRing( pxRing, ppvStorageArea, xLength + ( size_t ) 1 );
+
+			/* Remember this was statically allocated in case it is ever
+			deleted again. */
+			pxRing->ucFlags |= srFLAGS_IS_STATICALLY_ALLOCATED;
+
+			traceSPSC_RING_CREATE( pxRing );
+
+			xReturn = ( SPSCRingHandle_t ) pxStaticSPSCRing; /*lint !e9087 Data hiding requires cast to opaque type. */
+		}
+		else
+		{
+			xReturn = NULL;
+			traceSPSC_RING_CREATE_STATIC_FAILED( xReturn );
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vSPSCRingDelete( SPSCRingHandle_t xRing )
+{
+SPSCRing_t * pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+
+	configASSERT( pxRing );
+
+	traceSPSC_RING_DELETE( xRing );
+
+	if( ( pxRing->ucFlags & srFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the storage area were allocated using a
+			single call to pvPortMalloc(), hence only one call to vPortFree() is
+			required. */
+			vPortFree( ( void * ) pxRing ); /*lint !e9087 Standard free() semantics require void *, plus pxRing was allocated by pvPortMalloc(). */
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt.
+			Force an assert. */
+			configASSERT( xRing == ( SPSCRingHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and storage area were not allocated dynamically and
+		cannot be freed - just scrub the structure so future use will assert. */
+		memset( pxRing, 0x00, sizeof( SPSCRing_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vSPSCRingSetWakeUpCallback( SPSCRingHandle_t xRing,
+								 SPSCRingWakeUpCallback_t pxCallback )
+{
+SPSCRing_t * const pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+
+	configASSERT( pxRing );
+
+	pxRing->pxWakeUpCallback = pxCallback;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingSend( SPSCRingHandle_t xRing, void *pvItem )
+{
+SPSCRing_t * const pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+BaseType_t xReturn;
+
+	configASSERT( pxRing );
+
+	xReturn = prvWriteItemToRing( pxRing, pvItem );
+
+	if( xReturn != pdFAIL )
+	{
+		prvWakeUpConsumer( pxRing, NULL );
+	}
+	else
+	{
+		traceSPSC_RING_SEND_FAILED( xRing );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingSendFromISR( SPSCRingHandle_t xRing,
+								 void *pvItem,
+								 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+SPSCRing_t * const pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+BaseType_t xReturn, xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( pxRing );
+
+	xReturn = prvWriteItemToRing( pxRing, pvItem );
+
+	if( xReturn != pdFAIL )
+	{
+		prvWakeUpConsumer( pxRing, &xHigherPriorityTaskWoken );
+
+		if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+	else
+	{
+		traceSPSC_RING_SEND_FAILED( xRing );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingReceive( SPSCRingHandle_t xRing,
+							 void **ppvItem,
+							 TickType_t xTicksToWait )
+{
+SPSCRing_t * const pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+BaseType_t xReturn = pdFAIL, xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+size_t xTail, xNextTail;
+
+	configASSERT( pxRing );
+	configASSERT( ppvItem );
+
+	/* The task that installed a callback waits by some other means. */
+	configASSERT( ( xTicksToWait == ( TickType_t ) 0 ) || ( pxRing->pxWakeUpCallback == NULL ) );
+
+	for( ;; )
+	{
+		xTail = pxRing->xTail;
+
+		if( xTail != pxRing->xHead )
+		{
+			/* Read the item only after the index that published it, then
+			release the entry only after the item was read. */
+			portMEMORY_BARRIER();
+			*ppvItem = pxRing->ppvStorage[ xTail ];
+			portMEMORY_BARRIER();
+
+			xNextTail = xTail + ( size_t ) 1;
+
+			if( xNextTail == pxRing->xLength )
+			{
+				xNextTail = ( size_t ) 0;
+			}
+
+			pxRing->xTail = xNextTail;
+			xReturn = pdPASS;
+			break;
+		}
+
+		if( xTicksToWait == ( TickType_t ) 0 )
+		{
+			break;
+		}
+
+		/* The ring is empty.  Ask the producer for a notification, and only
+		wait if the ring is still empty once the request is visible to the
+		producer.  A notification that arrives after an item was received
+		without waiting is harmless - the next wait returns early, finds the
+		ring empty, and waits again. */
+		if( xEntryTimeSet == pdFALSE )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+			xEntryTimeSet = pdTRUE;
+		}
+
+		pxRing->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+
+		if( xSPSCRingArmWakeUp( xRing ) != pdFALSE )
+		{
+			traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+		}
+
+		/* On a timeout xTicksToWait is set to 0, so the ring is checked one
+		last time before returning. */
+		( void ) xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingArmWakeUp( SPSCRingHandle_t xRing )
+{
+SPSCRing_t * const pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+BaseType_t xReturn;
+
+	configASSERT( pxRing );
+
+	/* The request must be visible to the producer before the indexes are read
+	again, otherwise an item sent in between would neither be seen here nor
+	wake the consumer. */
+	portMEMORY_BARRIER();
+	pxRing->uxWakeUpsRequested++;
+	portMEMORY_BARRIER();
+
+	if( pxRing->xHead == pxRing->xTail )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xSPSCRingItemsAvailable( SPSCRingHandle_t xRing )
+{
+const SPSCRing_t * const pxRing = ( SPSCRing_t * ) xRing; /*lint !e9087 !e9079 Safe cast as SPSCRingHandle_t is opaque SPSCRing_t. */
+size_t xHead, xTail, xCount;
+
+	configASSERT( pxRing );
+
+	xHead = pxRing->xHead;
+	xTail = pxRing->xTail;
+
+	if( xHead >= xTail )
+	{
+		xCount = xHead - xTail;
+	}
+	else
+	{
+		xCount = ( pxRing->xLength - xTail ) + xHead;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItemToRing( SPSCRing_t * const pxRing, void *pvItem )
+{
+size_t xHead, xNextHead;
+BaseType_t xReturn;
+
+	xHead = pxRing->xHead;
+	xNextHead = xHead + ( size_t ) 1;
+
+	if( xNextHead == pxRing->xLength )
+	{
+		xNextHead = ( size_t ) 0;
+	}
+
+	if( xNextHead != pxRing->xTail )
+	{
+		/* Write the item before publishing it by moving the head. */
+		pxRing->ppvStorage[ xHead ] = pvItem;
+		portMEMORY_BARRIER();
+		pxRing->xHead = xNextHead;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeUpConsumer( SPSCRing_t * const pxRing, BaseType_t *pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxWakeUpsRequested;
+TaskHandle_t xTaskToNotify;
+
+	/* The new head must be visible to the consumer before the request is read,
+	the counterpart of the barriers in xSPSCRingArmWakeUp(). */
+	portMEMORY_BARRIER();
+	uxWakeUpsRequested = pxRing->uxWakeUpsRequested;
+
+	if( uxWakeUpsRequested != pxRing->uxWakeUpsSent )
+	{
+		/* Wake the consumer once, however many items are sent before it arms
+		the wake up again. */
+		pxRing->uxWakeUpsSent = uxWakeUpsRequested;
+		portMEMORY_BARRIER();
+
+		if( pxRing->pxWakeUpCallback != NULL )
+		{
+			pxRing->pxWakeUpCallback( ( SPSCRingHandle_t ) pxRing, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			xTaskToNotify = pxRing->xTaskWaitingToReceive;
+
+			if( xTaskToNotify != NULL )
+			{
+				if( pxHigherPriorityTaskWoken == NULL )
+				{
+					( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+				}
+				else
+				{
+					( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+				}
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSPSCRing( SPSCRing_t * const pxRing,
+									  void ** const ppvStorage,
+									  size_t xLength )
+{
+	memset( ( void * ) pxRing, 0x00, sizeof( SPSCRing_t ) ); /*lint !e9087 memset() requires void *. */
+	pxRing->ppvStorage = ( void * volatile * ) ppvStorage;
+	pxRing->xLength = xLength;
+}
+/*-----------------------------------------------------------*/
@@ -74,7 +74,7 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();		\
 		{																				\
 			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
 			{																			\
@@ -85,7 +85,7 @@ that uses task notifications. */
 				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
 			}																			\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );					\
 	}
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -112,7 +112,7 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();		\
 		{																				\
 			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
 			{																			\
@@ -123,7 +123,7 @@ that uses task notifications. */
 				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
 			}																			\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );					\
 	}
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 /*lint -restore (9026) */
@@ -202,6 +202,57 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ); PRIVILEGED_FUNCTION
 
+/*
+ * Blocks the calling task for up to xTicksToWait ticks until there are at
+ * least xRequiredSpace bytes free in the buffer, then returns the number of
+ * bytes free.
+ */
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+							   size_t xRequiredSpace,
+							   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task for up to xTicksToWait ticks until there are more
+ * than xBytesToStoreMessageLength bytes in the buffer, then returns the number
+ * of bytes in the buffer.
+ */
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+							  size_t xBytesToStoreMessageLength,
+							  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describes the xCount bytes of the buffer's data storage area that start at
+ * index xStart as one or, if they wrap past the end of the storage area, two
+ * contiguous spans.
+ */
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+						 size_t xStart,
+						 size_t xCount,
+						 StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the xCount bytes that start at index xStart of the buffer's data
+ * storage area to pucData, without removing them from the buffer.
+ */
+static void prvPeekBytesFromBuffer( const StreamBuffer_t * const pxStreamBuffer,
+									size_t xStart,
+									uint8_t *pucData,
+									size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Implement the zero copy API functions that are common to tasks and
+ * interrupts.  See stream_buffer.h.
+ */
+static size_t prvAcquireWrite( const StreamBuffer_t * const pxStreamBuffer,
+							   StreamBufferSpans_t * const pxSpans,
+							   size_t xMaxLength,
+							   size_t xSpace ) PRIVILEGED_FUNCTION;
+static size_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer, size_t xLength ) PRIVILEGED_FUNCTION;
+static size_t prvPeekRead( const StreamBuffer_t * const pxStreamBuffer,
+						   StreamBufferSpans_t * const pxSpans,
+						   size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+static size_t prvConsumeRead( StreamBuffer_t * const pxStreamBuffer, size_t xLength ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -490,9 +541,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
 						  TickType_t xTicksToWait )
 {
 StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
-size_t xReturn, xSpace = 0;
+size_t xReturn, xSpace;
 size_t xRequiredSpace = xDataLengthBytes;
-TimeOut_t xTimeOut;
 
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
@@ -510,54 +560,7 @@ TimeOut_t xTimeOut;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
-	{
-		vTaskSetTimeOutState( &xTimeOut );
-
-		do
-		{
-			/* Wait until the required number of bytes are free in the message
-			buffer. */
-			taskENTER_CRITICAL();
-			{
-				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-				if( xSpace < xRequiredSpace )
-				{
-					/* Clear notification state as going to wait for space. */
-					( void ) xTaskNotifyStateClear( NULL );
-
-					/* Should only be one writer. */
-					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-				}
-				else
-				{
-					taskEXIT_CRITICAL();
-					break;
-				}
-			}
-			taskEXIT_CRITICAL();
-
-			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToSend = NULL;
-
-		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
-
-	if( xSpace == ( size_t ) 0 )
-	{
-		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
 
 	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
@@ -713,54 +716,7 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xBytesToStoreMessageLength = 0;
 	}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
-	{
-		/* Checking if there is data and clearing the notification state must be
-		performed atomically. */
-		taskENTER_CRITICAL();
-		{
-			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-			/* If this function was invoked by a message buffer read then
-			xBytesToStoreMessageLength holds the number of bytes used to hold
-			the length of the next discrete message.  If this function was
-			invoked by a stream buffer read then xBytesToStoreMessageLength will
-			be 0. */
-			if( xBytesAvailable <= xBytesToStoreMessageLength )
-			{
-				/* Clear notification state as going to wait for data. */
-				( void ) xTaskNotifyStateClear( NULL );
-
-				/* Should only be one reader. */
-				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		taskEXIT_CRITICAL();
-
-		if( xBytesAvailable <= xBytesToStoreMessageLength )
-		{
-			/* Wait for data to be available. */
-			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToReceive = NULL;
-
-			/* Recheck the data available after blocking. */
-			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-	}
-	else
-	{
-		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-	}
+	xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
 
 	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
 	holds the number of bytes used to store the message length) or a stream of
@@ -899,6 +855,200 @@ size_t xOriginalTail, xReceivedLength, xNextMessageLength;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+								  StreamBufferSpans_t * const pxSpans,
+								  size_t xMaxLength,
+								  TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xSpace, xRequiredSpace = xMaxLength;
+
+	configASSERT( pxSpans );
+	configASSERT( pxStreamBuffer );
+
+	/* Wait for the same space xStreamBufferSend() would wait for. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+	return prvAcquireWrite( pxStreamBuffer, pxSpans, xMaxLength, xSpace );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										 StreamBufferSpans_t * const pxSpans,
+										 size_t xMaxLength )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+	configASSERT( pxSpans );
+	configASSERT( pxStreamBuffer );
+
+	return prvAcquireWrite( pxStreamBuffer, pxSpans, xMaxLength, xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xLength )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitWrite( pxStreamBuffer, xLength );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xLength,
+										BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitWrite( pxStreamBuffer, xLength );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer,
+							  StreamBufferSpans_t * const pxSpans,
+							  TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xBytesAvailable, xBytesToStoreMessageLength;
+
+	configASSERT( pxSpans );
+	configASSERT( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+	return prvPeekRead( pxStreamBuffer, pxSpans, xBytesAvailable );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekReadFromISR( StreamBufferHandle_t xStreamBuffer,
+									 StreamBufferSpans_t * const pxSpans )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+	configASSERT( pxSpans );
+	configASSERT( pxStreamBuffer );
+
+	return prvPeekRead( pxStreamBuffer, pxSpans, prvBytesInBuffer( pxStreamBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer, size_t xLength )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReceivedLength;
+
+	configASSERT( pxStreamBuffer );
+
+	xReceivedLength = prvConsumeRead( pxStreamBuffer, xLength );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReceivedLength != ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xLength,
+										BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReceivedLength;
+
+	configASSERT( pxStreamBuffer );
+
+	xReceivedLength = prvConsumeRead( pxStreamBuffer, xLength );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReceivedLength != ( size_t ) 0 )
+	{
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
 {
 const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
@@ -965,7 +1115,7 @@ UBaseType_t uxSavedInterruptStatus;
 
 	configASSERT( pxStreamBuffer );
 
-	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
 		{
@@ -981,7 +1131,7 @@ UBaseType_t uxSavedInterruptStatus;
 			xReturn = pdFALSE;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -995,7 +1145,7 @@ UBaseType_t uxSavedInterruptStatus;
 
 	configASSERT( pxStreamBuffer );
 
-	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
 		{
@@ -1011,12 +1161,131 @@ UBaseType_t uxSavedInterruptStatus;
 			xReturn = pdFALSE;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+							   size_t xRequiredSpace,
+							   TickType_t xTicksToWait )
+{
+size_t xSpace = 0;
+TimeOut_t xTimeOut;
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Wait until the required number of bytes are free in the message
+			buffer. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+				if( xSpace < xRequiredSpace )
+				{
+					/* Clear notification state as going to wait for space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one writer. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xSpace == ( size_t ) 0 )
+	{
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+							  size_t xBytesToStoreMessageLength,
+							  TickType_t xTicksToWait )
+{
+size_t xBytesAvailable;
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		/* Checking if there is data and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			/* If this function was invoked by a message buffer read then
+			xBytesToStoreMessageLength holds the number of bytes used to hold
+			the length of the next discrete message.  If this function was
+			invoked by a stream buffer read then xBytesToStoreMessageLength will
+			be 0. */
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			/* Wait for data to be available. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck the data available after blocking. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+
+	return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
 {
 size_t xNextHead, xFirstLength;
@@ -1138,6 +1407,233 @@ size_t xCount;
 }
 /*-----------------------------------------------------------*/
 
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+						 size_t xStart,
+						 size_t xCount,
+						 StreamBufferSpans_t * const pxSpans )
+{
+size_t xFirstLength;
+
+	configASSERT( xStart < pxStreamBuffer->xLength );
+	configASSERT( xCount < pxStreamBuffer->xLength );
+
+	/* The span from xStart to the end of the storage area, and the rest of the
+	bytes from the start of the storage area. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xCount );
+
+	pxSpans->pucFirst = ( xFirstLength > ( size_t ) 0 ) ? &( pxStreamBuffer->pucBuffer[ xStart ] ) : NULL;
+	pxSpans->xFirstLength = xFirstLength;
+	pxSpans->pucSecond = ( xCount > xFirstLength ) ? pxStreamBuffer->pucBuffer : NULL;
+	pxSpans->xSecondLength = xCount - xFirstLength;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeekBytesFromBuffer( const StreamBuffer_t * const pxStreamBuffer,
+									size_t xStart,
+									uint8_t *pucData,
+									size_t xCount )
+{
+StreamBufferSpans_t xSpans;
+
+	prvGetSpans( pxStreamBuffer, xStart, xCount, &xSpans );
+
+	memcpy( ( void * ) pucData, ( const void * ) xSpans.pucFirst, xSpans.xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	if( xSpans.xSecondLength > ( size_t ) 0 )
+	{
+		memcpy( ( void * ) &( pucData[ xSpans.xFirstLength ] ), ( const void * ) xSpans.pucSecond, xSpans.xSecondLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAcquireWrite( const StreamBuffer_t * const pxStreamBuffer,
+							   StreamBufferSpans_t * const pxSpans,
+							   size_t xMaxLength,
+							   size_t xSpace )
+{
+size_t xStart, xLength;
+
+	xStart = pxStreamBuffer->xHead;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+	{
+		/* A stream buffer - make as much of the free space available as
+		possible. */
+		xLength = configMIN( xMaxLength, xSpace );
+	}
+	else if( xSpace >= ( xMaxLength + sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+	{
+		/* A message buffer with enough space for the whole message.  The
+		length of the message is written in front of the message when it is
+		committed, so the message itself starts after it. */
+		xLength = xMaxLength;
+		xStart += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+		if( xStart >= pxStreamBuffer->xLength )
+		{
+			xStart -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* A message buffer without enough space. */
+		xLength = 0;
+	}
+
+	prvGetSpans( pxStreamBuffer, xStart, xLength, pxSpans );
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer, size_t xLength )
+{
+size_t xNextHead;
+
+	if( xLength > ( size_t ) 0 )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* The space was checked when it was acquired, and can only have
+			grown since. */
+			configASSERT( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= ( xLength + sbBYTES_TO_STORE_MESSAGE_LENGTH ) );
+
+			/* As in prvWriteMessageToBuffer(), the length is written first.
+			A reader does not consider a message to be in the buffer until
+			there are more bytes than the length in the buffer. */
+			( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		else
+		{
+			configASSERT( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= xLength );
+		}
+
+		/* The data is already in place, so only the head has to move. */
+		xNextHead = pxStreamBuffer->xHead + xLength;
+
+		if( xNextHead >= pxStreamBuffer->xLength )
+		{
+			xNextHead -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xHead = xNextHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvPeekRead( const StreamBuffer_t * const pxStreamBuffer,
+						   StreamBufferSpans_t * const pxSpans,
+						   size_t xBytesAvailable )
+{
+size_t xStart, xLength;
+
+	xStart = pxStreamBuffer->xTail;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+	{
+		/* A stream buffer - make all the bytes in the buffer available. */
+		xLength = xBytesAvailable;
+	}
+	else if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+	{
+		/* A message buffer - make the next message available.  The length is
+		read without moving the tail, so the writer does not see the space it
+		occupies as free. */
+		prvPeekBytesFromBuffer( pxStreamBuffer, xStart, ( uint8_t * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		configASSERT( xLength <= ( xBytesAvailable - sbBYTES_TO_STORE_MESSAGE_LENGTH ) );
+
+		xStart += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+		if( xStart >= pxStreamBuffer->xLength )
+		{
+			xStart -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xLength = 0;
+	}
+
+	prvGetSpans( pxStreamBuffer, xStart, xLength, pxSpans );
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConsumeRead( StreamBuffer_t * const pxStreamBuffer, size_t xLength )
+{
+size_t xBytesAvailable, xNextTail, xBytesToRemove;
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+	{
+		xLength = configMIN( xLength, xBytesAvailable ); /*lint !e9044 Function parameter modified to ensure it is capped to the bytes available. */
+		xBytesToRemove = xLength;
+	}
+	else if( ( xLength > ( size_t ) 0 ) && ( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+	{
+	size_t xNextMessageLength;
+
+		/* A message is always removed as a whole, so xLength must be the
+		length returned by the peek. */
+		prvPeekBytesFromBuffer( pxStreamBuffer, pxStreamBuffer->xTail, ( uint8_t * ) &xNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		configASSERT( xLength == xNextMessageLength );
+		xLength = xNextMessageLength; /*lint !e9044 Function parameter modified to the length of the message actually removed. */
+		xBytesToRemove = xLength + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xLength = 0; /*lint !e9044 Function parameter modified as nothing is removed. */
+		xBytesToRemove = 0;
+	}
+
+	if( xBytesToRemove > ( size_t ) 0 )
+	{
+		xNextTail = pxStreamBuffer->xTail + xBytesToRemove;
+
+		if( xNextTail >= pxStreamBuffer->xLength )
+		{
+			xNextTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xTail = xNextTail;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  uint8_t * const pucBuffer,
 										  size_t xBufferSizeBytes,
@@ -210,21 +210,52 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
-																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
-																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* The number of slots in each level of the delayed task wheel, and the
+	number of levels needed to span every possible time to wake. */
+	#define taskDELAYED_WHEEL_SLOTS			( ( UBaseType_t ) 1U << configDELAYED_TASK_WHEEL_SLOT_BITS )
+	#define taskDELAYED_WHEEL_SLOT_MASK		( taskDELAYED_WHEEL_SLOTS - ( UBaseType_t ) 1U )
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#define taskDELAYED_WHEEL_LEVELS	( ( 16 + configDELAYED_TASK_WHEEL_SLOT_BITS - 1 ) / configDELAYED_TASK_WHEEL_SLOT_BITS )
+	#else
+		#define taskDELAYED_WHEEL_LEVELS	( ( 32 + configDELAYED_TASK_WHEEL_SLOT_BITS - 1 ) / configDELAYED_TASK_WHEEL_SLOT_BITS )
+	#endif
+
+	/* The delayed task wheel only uses times relative to the wheel time, so
+	there are no lists to switch when the tick count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		xNumOfOverflows++;																			\
+	}
+
+	/* Is pxList one of the slots of the delayed task wheel? */
+	#define taskIS_DELAYED_TASK_LIST( pxList )																		\
+		( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ][ 0 ] ) ) &&														\
+		  ( ( pxList ) <= &( xDelayedTaskWheel[ taskDELAYED_WHEEL_LEVELS - 1 ][ taskDELAYED_WHEEL_SLOTS - 1 ] ) ) )	/*lint !e946 Pointers to the same array. */
+
+#else
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
+	count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																	\
+	{																									\
+		List_t *pxTemp;																					\
+																										\
+		/* The delayed tasks list should be empty when the lists are switched. */						\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+																										\
+		pxTemp = pxDelayedTaskList;																		\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;													\
+		pxOverflowDelayedTaskList = pxTemp;																\
+		xNumOfOverflows++;																				\
+		prvResetNextTaskUnblockTime();																	\
+	}
+
+	/* Is pxList one of the delayed task lists? */
+	#define taskIS_DELAYED_TASK_LIST( pxList ) ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 /*-----------------------------------------------------------*/
 
@@ -284,7 +315,7 @@ typedef struct tskTaskControlBlock
 		StackType_t		*pxEndOfStack;		/*< Points to the highest valid address for the stack. */
 	#endif
 
-	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+	#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) || ( configNUM_CORES > 1 ) )
 		UBaseType_t		uxCriticalNesting;	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
 	#endif
 
@@ -340,6 +371,11 @@ typedef struct tskTaskControlBlock
 		int iTaskErrno;
 	#endif
 
+	#if( configNUM_CORES > 1 )
+		volatile BaseType_t	xTaskRunState;		/*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+		UBaseType_t		uxCoreAffinityMask;	/*< Bit N is set if the task can run on core N. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -349,14 +385,42 @@ typedef tskTCB TCB_t;
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if( configNUM_CORES == 1 )
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+	/* The task running on each core. */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUM_CORES ] = { NULL };
+#endif
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* The hierarchical timing wheel that holds the delayed tasks, laid out as
+	the timer wheel in timers.c.  Each slot of level 0 holds the tasks that
+	wake on one tick, and each slot of level N spans all the slots of level
+	N - 1.  A task is placed in the lowest level that spans the time until it
+	wakes, so blocking with a timeout does not depend on the number of tasks
+	that are already blocked.  The slots are ordinary lists, so a task that
+	leaves the Blocked state for any other reason is removed with
+	uxListRemove() as before.  The occupancy bit of a slot is only cleared
+	when the slot is processed, so a set bit means the slot might hold
+	tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskWheel[ taskDELAYED_WHEEL_LEVELS ][ taskDELAYED_WHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelOccupied[ taskDELAYED_WHEEL_LEVELS ];
+
+	/* The tick count up to which the wheel has been processed.  No task in the
+	wheel wakes at or before this time unless it was delayed for 0 ticks. */
+	PRIVILEGED_DATA static TickType_t xDelayedTaskWheelTime = ( TickType_t ) 0U;
+
+#else
+
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -385,7 +449,11 @@ PRIVILEGED_DATA static volatile TickType_t xIdleTickCount 			= ( TickType_t ) co
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+#if( configNUM_CORES == 1 )
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending 		= pdFALSE;
+#else
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUM_CORES ] = { pdFALSE };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
@@ -403,7 +471,11 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#if( configNUM_CORES == 1 )
+		PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#else
+		PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTimes[ configNUM_CORES ] = { 0UL };	/*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+	#endif
 	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
@@ -412,6 +484,52 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES == 1 )
+
+	/* Is the task referenced by pxTCB in the Running state? */
+	#define taskTASK_IS_RUNNING( pxTCB ) ( ( pxTCB ) == pxCurrentTCB )
+
+	/* Is the scheduler suspended by the calling task? */
+	#define taskSCHEDULER_SUSPENDED_BY_CALLER() ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+
+	/* Called after pxTCB has left the Blocked or Suspended state.  Evaluates to
+	pdTRUE if pxTCB should preempt the running task.  When
+	xPreemptEqualPriority is pdTRUE a task of the same priority as the running
+	task preempts it too. */
+	#define prvYieldForTask( pxTCB, xPreemptEqualPriority )												\
+		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||											\
+		  ( ( ( xPreemptEqualPriority ) != pdFALSE ) && ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) ) )
+
+#else
+
+	/* The value of xTaskRunState while a task is not running on any core. */
+	#define taskTASK_NOT_RUNNING	( ( BaseType_t ) -1 )
+
+	#define taskTASK_IS_RUNNING( pxTCB ) ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+	/* uxSchedulerSuspended is also non-zero while a task on another core has
+	the scheduler suspended, so it is only read while holding the task lock. */
+	#define taskSCHEDULER_SUSPENDED_BY_CALLER() ( prvGetSchedulerSuspended() != ( UBaseType_t ) pdFALSE )
+
+	/* The calling task could be switched to another core between reading the
+	core number and indexing pxCurrentTCBs, so pxCurrentTCB is read with
+	interrupts masked.  Code that already runs with interrupts masked uses
+	pxCurrentTCBs[ portGET_CORE_ID() ] directly. */
+	#define pxCurrentTCB	( ( TCB_t * ) xTaskGetCurrentTaskHandle() )
+
+	/* Each core holds its own pending yield.  Only accessed with interrupts
+	masked or with the scheduler suspended, when the calling task cannot move
+	to another core. */
+	#define xYieldPending	xYieldPendings[ portGET_CORE_ID() ]
+
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		#define ulTaskSwitchedInTime	ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+	#endif
+
+#endif /* configNUM_CORES */
+
+/*-----------------------------------------------------------*/
+
 /* Callback function prototypes. --------------------------*/
 #if(  configCHECK_FOR_STACK_OVERFLOW > 0 )
 
@@ -429,6 +547,12 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 
+	#if( configNUM_CORES > 1 )
+		/* xPassiveIdleTaskIndex is 0 for the idle task of core 1, 1 for the
+		idle task of core 2, and so on. */
+		extern void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex );
+	#endif
+
 #endif
 
 /* File private functions. --------------------------------*/
@@ -545,6 +669,30 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/*
+	 * Insert the task into the slot of the delayed task wheel that holds its
+	 * wake time, relative to the current wheel time.  Returns the time at which
+	 * the slot must next be processed.
+	 */
+	static TickType_t prvInsertTaskInDelayedTaskWheel( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the next time at which a slot of the delayed task wheel must be
+	 * processed.  *pxWheelIsEmpty is set to pdTRUE if no slot is occupied.
+	 */
+	static TickType_t prvGetNextDelayedTaskWheelTime( BaseType_t * const pxWheelIsEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from the tick interrupt.  Processes the slots of the delayed task
+	 * wheel that are due up to xConstTickCount, moving the tasks that wake to
+	 * the ready lists.  Returns pdTRUE if a context switch is required.
+	 */
+	static BaseType_t prvUnblockDelayedTasks( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -574,6 +722,65 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if( configNUM_CORES > 1 )
+
+	/*
+	 * Called with the kernel locks held after pxTCB has been made ready.
+	 * Yields the core running the lowest priority task that pxTCB is allowed
+	 * to preempt, and returns pdTRUE if that is the calling core.  When
+	 * xPreemptEqualPriority is pdTRUE the task running on the calling core is
+	 * also preempted by a task of the same priority.
+	 */
+	static BaseType_t prvYieldForTask( const TCB_t * const pxTCB, const BaseType_t xPreemptEqualPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called with the kernel locks held to make another core perform a
+	 * context switch.
+	 */
+	static void prvYieldCore( const BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Takes the task lock and the ISR lock for the calling task.  Called with
+	 * interrupts masked.
+	 */
+	static void prvGetKernelLocks( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Selects the task core xCoreID runs next and sets pxCurrentTCBs[ xCoreID ]
+	 * to it.  Called with the kernel locks held.
+	 */
+	static void prvSelectHighestPriorityTask( const BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Reads uxSchedulerSuspended while holding the kernel locks.
+	 */
+	static UBaseType_t prvGetSchedulerSuspended( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Creates an idle task for each core other than core 0, which runs the
+	 * idle task created by vTaskStartScheduler().
+	 */
+	static BaseType_t prvCreatePassiveIdleTasks( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The idle task of each core other than core 0.  Unlike prvIdleTask() it
+	 * does not free the memory of deleted tasks.
+	 */
+	static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters );
+
+	#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+		/*
+		 * Called by the tick with the ISR lock held.  Yields every other core
+		 * that must give up its time slice to a task of the same priority, and
+		 * returns pdTRUE if the calling core must do so too.
+		 */
+		static BaseType_t prvTimeSliceCores( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configNUM_CORES */
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -950,12 +1157,19 @@ UBaseType_t x;
 	listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 	listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
-	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+	#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) || ( configNUM_CORES > 1 ) )
 	{
 		pxNewTCB->uxCriticalNesting = ( UBaseType_t ) 0U;
 	}
 	#endif /* portCRITICAL_NESTING_IN_TCB */
 
+	#if( configNUM_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+		pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+	}
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 	{
 		pxNewTCB->pxTaskTag = NULL;
@@ -1037,11 +1251,27 @@ UBaseType_t x;
 
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 {
+#if( configNUM_CORES > 1 )
+	BaseType_t xYieldRequired = pdFALSE;
+#endif
+
 	/* Ensure interrupts don't access the task lists while the lists are being
 	updated. */
 	taskENTER_CRITICAL();
 	{
 		uxCurrentNumberOfTasks++;
+		#if( configNUM_CORES > 1 )
+		/* The task each core runs first is selected when the scheduler is
+		started, so pxCurrentTCBs is not touched here. */
+		if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+		{
+			prvInitialiseTaskLists();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		#else
 		if( pxCurrentTCB == NULL )
 		{
 			/* There are no other tasks, or all the other tasks are in
@@ -1081,6 +1311,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configNUM_CORES */
 
 		uxTaskNumber++;
 
@@ -1095,6 +1326,17 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
+
+		#if( configNUM_CORES > 1 )
+		{
+			/* The tasks running on the other cores can only be inspected while
+			the kernel locks are held. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				xYieldRequired = prvYieldForTask( pxNewTCB, pdFALSE );
+			}
+		}
+		#endif
 	}
 	taskEXIT_CRITICAL();
 
@@ -1102,7 +1344,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 		/* If the created task is of a higher priority than the current task
 		then it should run now. */
+		#if( configNUM_CORES > 1 )
+		if( xYieldRequired != pdFALSE )
+		#else
 		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		#endif
 		{
 			taskYIELD_IF_USING_PREEMPTION();
 		}
@@ -1156,7 +1402,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			not return. */
 			uxTaskNumber++;
 
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				/* A task is deleting itself.  This cannot complete within the
 				task itself, as a context switch to another task is required.
@@ -1176,6 +1422,17 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				hence xYieldPending is used to latch that a context switch is
 				required. */
 				portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+
+				#if( configNUM_CORES > 1 )
+				{
+					/* The task is running on another core, which must switch
+					away from it before the idle task can free it. */
+					if( pxTCB->xTaskRunState != portGET_CORE_ID() )
+					{
+						prvYieldCore( pxTCB->xTaskRunState );
+					}
+				}
+				#endif
 			}
 			else
 			{
@@ -1197,7 +1454,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		{
 			if( pxTCB == pxCurrentTCB )
 			{
-				configASSERT( uxSchedulerSuspended == 0 );
+				configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
 				portYIELD_WITHIN_API();
 			}
 			else
@@ -1219,7 +1476,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxPreviousWakeTime );
 		configASSERT( ( xTimeIncrement > 0U ) );
-		configASSERT( uxSchedulerSuspended == 0 );
+		configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
 
 		vTaskSuspendAll();
 		{
@@ -1303,7 +1560,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		/* A delay time of zero just forces a reschedule. */
 		if( xTicksToDelay > ( TickType_t ) 0U )
 		{
-			configASSERT( uxSchedulerSuspended == 0 );
+			configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
 			vTaskSuspendAll();
 			{
 				traceTASK_DELAY();
@@ -1349,9 +1606,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
-		if( pxTCB == pxCurrentTCB )
+		if( taskTASK_IS_RUNNING( pxTCB ) )
 		{
-			/* The task calling this function is querying its own state. */
+			/* The task calling this function is querying its own state, or
+			the task is running on another core. */
 			eReturn = eRunning;
 		}
 		else
@@ -1362,7 +1620,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			if( taskIS_DELAYED_TASK_LIST( pxStateList ) )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1457,14 +1715,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
 		{
 			/* If null is passed in here then it is the priority of the calling
 			task that is being queried. */
 			pxTCB = prvGetTCBFromHandle( xTask );
 			uxReturn = pxTCB->uxPriority;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
 		return uxReturn;
 	}
@@ -1616,6 +1874,40 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				#if( configNUM_CORES > 1 )
+				{
+					/* Whether a yield is required depends on the tasks running
+					on every core, not only on the calling task. */
+					xYieldRequired = pdFALSE;
+
+					if( taskTASK_IS_RUNNING( pxTCB ) )
+					{
+						if( pxTCB->uxPriority < uxPriorityUsedOnEntry )
+						{
+							/* A ready task may now have a higher priority than
+							the task being lowered, so its core must select
+							again. */
+							if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								prvYieldCore( pxTCB->xTaskRunState );
+							}
+						}
+					}
+					else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						xYieldRequired = prvYieldForTask( pxTCB, pdTRUE );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUM_CORES */
+
 				if( xYieldRequired != pdFALSE )
 				{
 					taskYIELD_IF_USING_PREEMPTION();
@@ -1636,6 +1928,90 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the affinity of the calling
+			task that is being changed. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					/* The task must move if it can no longer run on the core
+					it is running on.  The core finds it another core once it
+					has switched it out. */
+					if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << pxTCB->xTaskRunState ) ) == 0U )
+					{
+						if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							prvYieldCore( pxTCB->xTaskRunState );
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* The task may now be able to run on a core it could not
+					run on before. */
+					xYieldRequired = prvYieldForTask( pxTCB, pdFALSE );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask )
+	{
+	const TCB_t *pxTCB;
+	UBaseType_t uxCoreAffinityMask;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxCoreAffinityMask;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
 	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -1683,6 +2059,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			}
 			#endif
+
+			#if( configNUM_CORES > 1 )
+			{
+				/* A task running on another core stops running when that core
+				switches away from it. */
+				if( ( taskTASK_IS_RUNNING( pxTCB ) ) && ( pxTCB->xTaskRunState != portGET_CORE_ID() ) )
+				{
+					prvYieldCore( pxTCB->xTaskRunState );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
 		}
 		taskEXIT_CRITICAL();
 
@@ -1706,14 +2097,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			if( xSchedulerRunning != pdFALSE )
 			{
 				/* The current task has just been suspended. */
-				configASSERT( uxSchedulerSuspended == 0 );
+				configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
 				portYIELD_WITHIN_API();
 			}
 			else
 			{
+				#if( configNUM_CORES == 1 )
 				/* The scheduler is not running, but the task that was pointed
 				to by pxCurrentTCB has just been suspended and pxCurrentTCB
-				must be adjusted to point to a different task. */
+				must be adjusted to point to a different task.  With more than
+				one core no task is current until the scheduler is started. */
 				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks )
 				{
 					/* No other tasks are ready, so set pxCurrentTCB back to
@@ -1726,6 +2119,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					vTaskSwitchContext();
 				}
+				#endif /* configNUM_CORES */
 			}
 		}
 		else
@@ -1808,7 +2202,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( prvYieldForTask( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1865,7 +2259,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
 			{
@@ -1876,7 +2270,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( prvYieldForTask( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1901,7 +2295,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xYieldRequired;
 	}
@@ -1952,6 +2346,22 @@ BaseType_t xReturn;
 	}
 	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
+	#if( configNUM_CORES > 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			/* The idle task created above runs on core 0, and is the only one
+			that frees the memory of deleted tasks. */
+			( ( TCB_t * ) xIdleTaskHandle )->uxCoreAffinityMask = ( UBaseType_t ) 1U;
+			xReturn = prvCreatePassiveIdleTasks();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configNUM_CORES */
+
 	#if ( configUSE_TIMERS == 1 )
 	{
 		if( xReturn == pdPASS )
@@ -1991,6 +2401,19 @@ BaseType_t xReturn;
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
+		#if( configNUM_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Select the task each core runs first.  The scheduler is not yet
+			running, so the kernel locks are not required. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif /* configNUM_CORES */
+
 		xNextTaskUnblockTime = portMAX_DELAY;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( TickType_t ) 0U;
@@ -2042,11 +2465,36 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	BaseType_t.  Please read Richard Barry's reply in the following link to a
-	post in the FreeRTOS support forum before reporting this as a bug! -
-	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
+	#if( configNUM_CORES > 1 )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* Interrupts are masked so the calling task cannot be moved to
+			another core while it takes the task lock, which it then holds
+			until xTaskResumeAll().  The ISR lock orders the increment with a
+			tick being processed on another core. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			prvGetKernelLocks();
+			++uxSchedulerSuspended;
+			portRELEASE_ISR_LOCK();
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			++uxSchedulerSuspended;
+		}
+	}
+	#else
+	{
+		/* A critical section is not required as the variable is of type
+		BaseType_t.  Please read Richard Barry's reply in the following link to
+		a post in the FreeRTOS support forum before reporting this as a bug! -
+		http://goo.gl/wu4acr */
+		++uxSchedulerSuspended;
+	}
+	#endif /* configNUM_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -2131,6 +2579,22 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if( configNUM_CORES > 1 )
+		{
+			/* Release the task lock taken by vTaskSuspendAll().  The critical
+			section still holds it, so no core can select a task until the
+			pending ready list has been processed below. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				portRELEASE_TASK_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUM_CORES */
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2146,7 +2610,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( prvYieldForTask( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2423,15 +2887,26 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				for( uxQueue = ( UBaseType_t ) 0; ( uxQueue < ( UBaseType_t ) ( taskDELAYED_WHEEL_LEVELS * taskDELAYED_WHEEL_SLOTS ) ) && ( pxTCB == NULL ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxQueue / taskDELAYED_WHEEL_SLOTS ][ uxQueue & taskDELAYED_WHEEL_SLOT_MASK ] ), pcNameToQuery );
+				}
 			}
-
-			if( pxTCB == NULL )
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2483,8 +2958,19 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+				{
+					for( uxQueue = ( UBaseType_t ) 0; uxQueue < ( UBaseType_t ) ( taskDELAYED_WHEEL_LEVELS * taskDELAYED_WHEEL_SLOTS ); uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxQueue / taskDELAYED_WHEEL_SLOTS ][ uxQueue & taskDELAYED_WHEEL_SLOT_MASK ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2559,7 +3045,16 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		/* Correct the tick count value after a period during which the tick
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			/* xNextTaskUnblockTime can be after the tick count overflows. */
+			configASSERT( xTicksToJump <= ( TickType_t ) ( xNextTaskUnblockTime - xTickCount ) );
+		}
+		#else
+		{
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		}
+		#endif
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
@@ -2617,7 +3112,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( prvYieldForTask( pxTCB, pdFALSE ) != pdFALSE )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2645,13 +3140,25 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 
 BaseType_t xTaskIncrementTick( void )
 {
-TCB_t * pxTCB;
-TickType_t xItemValue;
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	TCB_t * pxTCB;
+	TickType_t xItemValue;
+#endif
+#if( configNUM_CORES > 1 )
+	UBaseType_t uxSavedInterruptStatus;
+#endif
 BaseType_t xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
+	#if( configNUM_CORES > 1 )
+	{
+		/* The other cores can access the lists while the tick is processed. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	}
+	#endif
+
 	traceTASK_INCREMENT_TICK( xTickCount );
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
@@ -2672,6 +3179,29 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			/* See if this tick has reached the next time at which a slot of
+			the delayed task wheel must be processed.  The times are compared
+			relative to the wheel time, as xNextTaskUnblockTime can be after
+			the tick count overflows. */
+			if( ( TickType_t ) ( xNextTaskUnblockTime - xDelayedTaskWheelTime ) <= ( TickType_t ) ( xConstTickCount - xDelayedTaskWheelTime ) )
+			{
+				if( prvUnblockDelayedTasks( xConstTickCount ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
 		has been found whose block time has not expired there is no need to
@@ -2740,7 +3270,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 						only be performed if the unblocked task has a
 						priority that is equal to or higher than the
 						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						if( prvYieldForTask( pxTCB, pdTRUE ) != pdFALSE )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2753,13 +3283,18 @@ BaseType_t xSwitchRequired = pdFALSE;
 				}
 			}
 		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
+			#if( configNUM_CORES > 1 )
+			if( prvTimeSliceCores() != pdFALSE )
+			#else
 			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#endif
 			{
 				xSwitchRequired = pdTRUE;
 			}
@@ -2811,6 +3346,12 @@ BaseType_t xSwitchRequired = pdFALSE;
 	}
 	#endif /* configUSE_PREEMPTION */
 
+	#if( configNUM_CORES > 1 )
+	{
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	#endif
+
 	return xSwitchRequired;
 }
 /*-----------------------------------------------------------*/
@@ -2905,8 +3446,239 @@ BaseType_t xSwitchRequired = pdFALSE;
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	static void prvYieldCore( const BaseType_t xCoreID )
+	{
+		/* The interrupt is not taken while the task running on the core waits
+		for the kernel locks with interrupts masked, so the yield is also held
+		pending for it to find once it has the locks.  That stops a task that
+		has just been deleted or suspended from entering the kernel again. */
+		xYieldPendings[ xCoreID ] = pdTRUE;
+		portYIELD_CORE( xCoreID );
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvYieldForTask( const TCB_t * const pxTCB, const BaseType_t xPreemptEqualPriority )
+	{
+	const BaseType_t xCurrentCoreID = portGET_CORE_ID();
+	BaseType_t xCoreID, xLowestPriorityCoreID = taskTASK_NOT_RUNNING, xYieldCurrentCore = pdFALSE;
+	UBaseType_t uxCorePriority, uxLowestPriority = pxTCB->uxPriority, uxCoresToYield = 0U;
+
+		if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) )
+		{
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				uxCorePriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+
+				if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << xCoreID ) ) != 0U )
+				{
+					/* Look for the core running the lowest priority task below
+					the priority of pxTCB.  A task of the same priority is only
+					preempted on the calling core, and only if requested. */
+					if( uxCorePriority < uxLowestPriority )
+					{
+						uxLowestPriority = uxCorePriority;
+						xLowestPriorityCoreID = xCoreID;
+					}
+					else if( ( xCoreID == xCurrentCoreID ) &&
+							 ( xPreemptEqualPriority != pdFALSE ) &&
+							 ( uxCorePriority == pxTCB->uxPriority ) &&
+							 ( xLowestPriorityCoreID == taskTASK_NOT_RUNNING ) )
+					{
+						xLowestPriorityCoreID = xCoreID;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+				{
+					/* Only tasks of the highest ready priority can run at the
+					same time as each other, other than the idle tasks. */
+					if( ( uxCorePriority < pxTCB->uxPriority ) && ( uxCorePriority > tskIDLE_PRIORITY ) )
+					{
+						uxCoresToYield |= ( UBaseType_t ) 1U << xCoreID;
+					}
+				}
+				#endif /* configRUN_MULTIPLE_PRIORITIES */
+			}
+
+			if( xLowestPriorityCoreID != taskTASK_NOT_RUNNING )
+			{
+				uxCoresToYield |= ( UBaseType_t ) 1U << xLowestPriorityCoreID;
+			}
+
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				if( ( uxCoresToYield & ( ( UBaseType_t ) 1U << xCoreID ) ) != 0U )
+				{
+					if( xCoreID == xCurrentCoreID )
+					{
+						xYieldCurrentCore = pdTRUE;
+					}
+					else
+					{
+						prvYieldCore( xCoreID );
+					}
+				}
+			}
+		}
+
+		return xYieldCurrentCore;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSelectHighestPriorityTask( const BaseType_t xCoreID )
+	{
+	UBaseType_t uxTopPriority, uxCurrentPriority, uxTasksToCheck;
+	List_t *pxReadyList;
+	TCB_t *pxTCB;
+	TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+	BaseType_t xTaskScheduled = pdFALSE;
+
+		/* The task this core was running can now be selected by any core,
+		including this one, if it is still ready. */
+		if( pxPreviousTCB != NULL )
+		{
+			pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+		}
+
+		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		{
+			uxTopPriority = uxTopReadyPriority;
+
+			/* Find the highest priority queue that contains ready tasks. */
+			while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) )
+			{
+				configASSERT( uxTopPriority );
+				--uxTopPriority;
+			}
+
+			uxTopReadyPriority = uxTopPriority;
+		}
+		#else
+		{
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+		}
+		#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+		uxCurrentPriority = uxTopPriority;
+
+		for( ;; )
+		{
+			#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+			if( ( uxCurrentPriority == uxTopPriority ) || ( uxCurrentPriority == tskIDLE_PRIORITY ) )
+			#endif
+			{
+				pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+
+				/* Continue from the task after the one last selected at this
+				priority so tasks of equal priority share the cores in turn.
+				Tasks running on other cores, and tasks not allowed to run on
+				this core, are passed over. */
+				for( uxTasksToCheck = listCURRENT_LIST_LENGTH( pxReadyList ); uxTasksToCheck > 0U; uxTasksToCheck-- )
+				{
+					listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxReadyList );
+
+					if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) &&
+						( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << xCoreID ) ) != 0U ) )
+					{
+						pxTCB->xTaskRunState = xCoreID;
+						pxCurrentTCBs[ xCoreID ] = pxTCB;
+						xTaskScheduled = pdTRUE;
+						break;
+					}
+				}
+			}
+
+			if( xTaskScheduled != pdFALSE )
+			{
+				break;
+			}
+
+			/* The idle task of each core can only run on that core, so a task
+			is always found by the idle priority. */
+			configASSERT( uxCurrentPriority > tskIDLE_PRIORITY );
+			uxCurrentPriority--;
+		}
+
+		/* The other cores were not yielded for a ready task that was switched
+		out because its affinity changed while it was running, as it was still
+		running at the time. */
+		if( ( pxPreviousTCB != NULL ) &&
+			( ( pxPreviousTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << xCoreID ) ) == 0U ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			( void ) prvYieldForTask( pxPreviousTCB, pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+		static BaseType_t prvTimeSliceCores( void )
+		{
+		const BaseType_t xCurrentCoreID = portGET_CORE_ID();
+		BaseType_t xCoreID, xYieldCurrentCore = pdFALSE;
+		const List_t *pxReadyList;
+		const ListItem_t *pxIterator;
+		const TCB_t *pxTCB;
+
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				/* A core gives up its time slice if a task of the same priority
+				as the task it is running is ready, is not running on another
+				core, and is allowed to run on this one. */
+				pxReadyList = &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] );
+
+				for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) )
+				{
+					pxTCB = ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+					if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) &&
+						( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << xCoreID ) ) != 0U ) )
+					{
+						if( xCoreID == xCurrentCoreID )
+						{
+							xYieldCurrentCore = pdTRUE;
+						}
+						else
+						{
+							prvYieldCore( xCoreID );
+						}
+
+						break;
+					}
+				}
+			}
+
+			return xYieldCurrentCore;
+		}
+
+	#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 void vTaskSwitchContext( void )
 {
+	#if( configNUM_CORES > 1 )
+	{
+		/* Called by the core that is switching, with interrupts masked.  The
+		task lock waits for a task on another core that has suspended the
+		scheduler to resume it. */
+		portGET_TASK_LOCK();
+		portGET_ISR_LOCK();
+	}
+	#endif /* configNUM_CORES */
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2957,7 +3729,11 @@ void vTaskSwitchContext( void )
 
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK();
+		#if( configNUM_CORES > 1 )
+			prvSelectHighestPriorityTask( portGET_CORE_ID() );
+		#else
+			taskSELECT_HIGHEST_PRIORITY_TASK();
+		#endif
 		traceTASK_SWITCHED_IN();
 
 		/* After the new task is switched in, update the global errno. */
@@ -2975,6 +3751,13 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
+
+	#if( configNUM_CORES > 1 )
+	{
+		portRELEASE_ISR_LOCK();
+		portRELEASE_TASK_LOCK();
+	}
+	#endif /* configNUM_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -3086,7 +3869,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( prvYieldForTask( pxUnblockedTCB, pdFALSE ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3143,7 +3926,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( prvYieldForTask( pxUnblockedTCB, pdFALSE ) != pdFALSE )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3329,10 +4112,11 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			timeslice.
 
 			A critical region is not required here as we are just reading from
-			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			the list, and an occasional incorrect value will not matter.  Each
+			core has its own idle task, so if the ready list at the idle
+			priority contains more tasks than there are cores then a task other
+			than an idle task is ready to execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
 			{
 				taskYIELD();
 			}
@@ -3378,7 +4162,11 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 					/* Now the scheduler is suspended, the expected idle
 					time can be sampled again, and this time its value can
 					be used. */
-					configASSERT( xNextTaskUnblockTime >= xTickCount );
+					#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+					{
+						configASSERT( xNextTaskUnblockTime >= xTickCount );
+					}
+					#endif
 					xExpectedIdleTime = prvGetExpectedIdleTime();
 
 					/* Define the following macro to set xExpectedIdleTime to 0
@@ -3409,6 +4197,109 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	static BaseType_t prvCreatePassiveIdleTasks( void )
+	{
+	BaseType_t xReturn = pdPASS, xCoreID;
+	TaskHandle_t xPassiveIdleTask = NULL;
+	char cIdleName[ configMAX_TASK_NAME_LEN ];
+	size_t x;
+
+		/* Each passive idle task is named after the idle task followed by the
+		number of its core. */
+		for( x = 0; ( x < ( size_t ) ( configMAX_TASK_NAME_LEN - 2 ) ) && ( configIDLE_TASK_NAME[ x ] != ( char ) 0x00 ); x++ )
+		{
+			cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+		}
+		cIdleName[ x + 1U ] = ( char ) 0x00;
+
+		for( xCoreID = 1; ( xCoreID < ( BaseType_t ) configNUM_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			cIdleName[ x ] = ( char ) ( '0' + xCoreID );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+				StackType_t *pxIdleTaskStackBuffer = NULL;
+				uint32_t ulIdleTaskStackSize;
+
+				vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - 1 );
+				xPassiveIdleTask = xTaskCreateStatic(	prvPassiveIdleTask,
+														cIdleName,
+														ulIdleTaskStackSize,
+														( void * ) NULL, /*lint !e961.  The cast is not redundant for all compilers. */
+														( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+														pxIdleTaskStackBuffer,
+														pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+				xReturn = ( xPassiveIdleTask != NULL ) ? pdPASS : pdFAIL;
+			}
+			#else
+			{
+				xReturn = xTaskCreate(	prvPassiveIdleTask,
+										cIdleName,
+										configMINIMAL_STACK_SIZE,
+										( void * ) NULL,
+										( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+										&xPassiveIdleTask ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			if( xReturn == pdPASS )
+			{
+				/* The scheduler is not running yet, so the affinity can be set
+				directly. */
+				( ( TCB_t * ) xPassiveIdleTask )->uxCoreAffinityMask = ( UBaseType_t ) 1U << xCoreID;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+	{
+		/* Stop warnings. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			#if ( configIDLE_SHOULD_YIELD == 1 )
+			{
+				/* As in prvIdleTask(), give way to a task that shares the idle
+				priority. */
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
+				{
+					taskYIELD();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configIDLE_SHOULD_YIELD */
+
+			#if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+			{
+				extern void vApplicationPassiveIdleHook( void );
+
+				/* Called on every core other than core 0.  As with
+				vApplicationIdleHook() it must not call a function that might
+				block. */
+				vApplicationPassiveIdleHook();
+			}
+			#endif /* configUSE_PASSIVE_IDLE_HOOK */
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TICKLESS_IDLE != 0 )
 
 	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3513,8 +4404,26 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+	UBaseType_t uxLevel, uxSlot;
+
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) taskDELAYED_WHEEL_LEVELS; uxLevel++ )
+		{
+			for( uxSlot = ( UBaseType_t ) 0U; uxSlot < taskDELAYED_WHEEL_SLOTS; uxSlot++ )
+			{
+				vListInitialise( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) );
+			}
+
+			ulDelayedTaskWheelOccupied[ uxLevel ] = 0UL;
+		}
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_DELAYED_TASK_WHEEL */
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3529,10 +4438,14 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+		using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3552,12 +4465,41 @@ static void prvCheckTasksWaitingTermination( void )
 			taskENTER_CRITICAL();
 			{
 				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+
+				#if( configNUM_CORES > 1 )
+				{
+					/* A task deleted while running on another core cannot be
+					freed until that core has switched away from it. */
+					if( taskTASK_IS_RUNNING( pxTCB ) )
+					{
+						pxTCB = NULL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUM_CORES */
+
+				if( pxTCB != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			taskEXIT_CRITICAL();
 
+			if( pxTCB == NULL )
+			{
+				/* Try again the next time the idle task runs. */
+				break;
+			}
+
 			prvDeleteTCB( pxTCB );
 		}
 	}
@@ -3605,7 +4547,7 @@ static void prvCheckTasksWaitingTermination( void )
 		state is just set to whatever is passed in. */
 		if( eState != eInvalid )
 		{
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				pxTaskStatus->eCurrentState = eRunning;
 			}
@@ -3792,51 +4734,326 @@ static void prvCheckTasksWaitingTermination( void )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static void prvResetNextTaskUnblockTime( void )
+	{
+	TickType_t xTime;
+	BaseType_t xWheelIsEmpty;
+
+		xTime = prvGetNextDelayedTaskWheelTime( &xWheelIsEmpty );
+
+		if( xWheelIsEmpty != pdFALSE )
+		{
+			/* As with the delayed lists, set xNextTaskUnblockTime to the
+			maximum possible value while no task is delayed. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			xNextTaskUnblockTime = xTime;
+		}
+	}
+
+#else
+
+	static void prvResetNextTaskUnblockTime( void )
+	{
+	TCB_t *pxTCB;
+
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		{
+			/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+			the maximum possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is an item in the delayed list. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			/* The new current delayed list is not empty, get the value of
+			the item at the head of the delayed list.  This is the time at
+			which the task at the head of the delayed list should be removed
+			from the Blocked state. */
+			( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		}
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static TickType_t prvInsertTaskInDelayedTaskWheel( TCB_t * const pxTCB )
+	{
+	const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+	const TickType_t xTicksToWake = ( TickType_t ) ( xTimeToWake - xDelayedTaskWheelTime );
+	UBaseType_t uxLevel = ( UBaseType_t ) 0, uxShift = ( UBaseType_t ) 0, uxSlot;
+
+		/* Find the lowest level that spans the time to wake.  The top level
+		spans any time that can be represented by a TickType_t. */
+		while( ( uxLevel < ( UBaseType_t ) ( taskDELAYED_WHEEL_LEVELS - 1 ) ) && ( ( xTicksToWake >> ( uxShift + ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS ) ) != ( TickType_t ) 0U ) )
+		{
+			uxLevel++;
+			uxShift += ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS;
+		}
+
+		/* The order of the tasks within a slot does not matter, so the task is
+		simply added to the end. */
+		uxSlot = ( UBaseType_t ) ( xTimeToWake >> uxShift ) & taskDELAYED_WHEEL_SLOT_MASK;
+		vListInsertEnd( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), &( pxTCB->xStateListItem ) );
+		ulDelayedTaskWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+
+		/* The slot is processed when the wheel time reaches its start - which
+		for level 0 is the wake time itself. */
+		return xTimeToWake & ( TickType_t ) ~( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U );
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static TickType_t prvGetNextDelayedTaskWheelTime( BaseType_t * const pxWheelIsEmpty )
+	{
+	TickType_t xTimeToSlot, xTimeToNext = portMAX_DELAY, xTimeIntoSlot;
+	UBaseType_t uxLevel, uxShift, uxSlot, uxSlotsToNext;
+	BaseType_t xWheelIsEmpty = pdTRUE;
+	uint32_t ulOccupied;
+
+		/* As prvGetNextExpireTime() in timers.c.  The next time of interest is
+		the earliest of the wake times of the tasks in level 0 and the times at
+		which the occupied slots of the other levels must be cascaded.  The
+		slot that holds the wheel time is only due now if the wheel time is at
+		its start, otherwise it is not reached again until the level has turned
+		full circle. */
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < ( UBaseType_t ) taskDELAYED_WHEEL_LEVELS; uxLevel++ )
+		{
+			ulOccupied = ulDelayedTaskWheelOccupied[ uxLevel ];
+
+			if( ulOccupied != 0UL )
+			{
+				xWheelIsEmpty = pdFALSE;
+				uxShift = uxLevel * ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS;
+				uxSlot = ( UBaseType_t ) ( xDelayedTaskWheelTime >> uxShift ) & taskDELAYED_WHEEL_SLOT_MASK;
+				xTimeIntoSlot = xDelayedTaskWheelTime & ( TickType_t ) ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U );
+
+				if( ( ( ulOccupied & ( 1UL << uxSlot ) ) != 0UL ) && ( xTimeIntoSlot == ( TickType_t ) 0U ) )
+				{
+					uxSlotsToNext = ( UBaseType_t ) 0;
+				}
+				else
+				{
+					for( uxSlotsToNext = ( UBaseType_t ) 1; uxSlotsToNext < taskDELAYED_WHEEL_SLOTS; uxSlotsToNext++ )
+					{
+						if( ( ulOccupied & ( 1UL << ( ( uxSlot + uxSlotsToNext ) & taskDELAYED_WHEEL_SLOT_MASK ) ) ) != 0UL )
+						{
+							break;
+						}
+					}
+				}
+
+				xTimeToSlot = ( TickType_t ) ( ( TickType_t ) ( ( TickType_t ) uxSlotsToNext << uxShift ) - xTimeIntoSlot );
+
+				if( xTimeToSlot < xTimeToNext )
+				{
+					xTimeToNext = xTimeToSlot;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		*pxWheelIsEmpty = xWheelIsEmpty;
+
+		return xDelayedTaskWheelTime + xTimeToNext;
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static BaseType_t prvUnblockDelayedTasks( const TickType_t xConstTickCount )
+	{
+	TCB_t *pxTCB;
+	List_t *pxSlot;
+	TickType_t xTime;
+	UBaseType_t uxLevel, uxShift, uxSlot;
+	BaseType_t xWheelIsEmpty, xSwitchRequired = pdFALSE;
+
+		for( ;; )
+		{
+			xTime = prvGetNextDelayedTaskWheelTime( &xWheelIsEmpty );
+
+			if( xWheelIsEmpty != pdFALSE )
+			{
+				/* The wheel is empty.  As with the delayed lists, set
+				xNextTaskUnblockTime to the maximum possible value. */
+				xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				break;
+			}
+			else if( ( TickType_t ) ( xTime - xDelayedTaskWheelTime ) > ( TickType_t ) ( xConstTickCount - xDelayedTaskWheelTime ) )
+			{
+				/* The next slot is not due yet. */
+				xNextTaskUnblockTime = xTime;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Move the wheel time on to xTime and cascade the tasks held in
+			any slots that start at xTime down to the lower levels.  Work down
+			from the top level, as the tasks cascaded from one slot can land in
+			the slot of the level below that starts at the same time.  The bit
+			of each slot processed is cleared, as the slot is now empty. */
+			xDelayedTaskWheelTime = xTime;
+
+			for( uxLevel = ( UBaseType_t ) ( taskDELAYED_WHEEL_LEVELS - 1 ); uxLevel > ( UBaseType_t ) 0; uxLevel-- )
+			{
+				uxShift = uxLevel * ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS;
+
+				if( ( xTime & ( TickType_t ) ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+				{
+					uxSlot = ( UBaseType_t ) ( xTime >> uxShift ) & taskDELAYED_WHEEL_SLOT_MASK;
+					pxSlot = &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] );
+
+					while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+					{
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						( void ) prvInsertTaskInDelayedTaskWheel( pxTCB );
+					}
+
+					ulDelayedTaskWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* Every task in the level 0 slot of xTime wakes now. */
+			uxSlot = ( UBaseType_t ) xTime & taskDELAYED_WHEEL_SLOT_MASK;
+			pxSlot = &( xDelayedTaskWheel[ 0 ][ uxSlot ] );
+
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove it from
+				the event list. */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Place the unblocked task into the appropriate ready list. */
+				prvAddTaskToReadyList( pxTCB );
+
+				/* A task being unblocked cannot cause an immediate context
+				switch if preemption is turned off. */
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					/* Preemption is on, but a context switch should only be
+					performed if the unblocked task has a priority that is
+					equal to or higher than the currently executing task. */
+					if( prvYieldForTask( pxTCB, pdTRUE ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+
+			ulDelayedTaskWheelOccupied[ 0 ] &= ~( 1UL << uxSlot );
+		}
+
+		/* Every slot due up to the tick count has been processed. */
+		xDelayedTaskWheelTime = xConstTickCount;
+
+		return xSwitchRequired;
 	}
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUM_CORES > 1 ) )
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
+	TaskHandle_t xTaskGetCurrentTaskHandle( void )
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	TaskHandle_t xReturn;
+
+		#if( configNUM_CORES > 1 )
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* Interrupts are masked so the calling task cannot be moved to
+			another core between reading the core number and using it. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#else
+		{
+			/* A critical section is not required as this is not called from
+			an interrupt and the current TCB will always be the same for any
+			individual execution thread. */
+			xReturn = pxCurrentTCB;
+		}
+		#endif
+
+		return xReturn;
 	}
-}
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUM_CORES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if( configNUM_CORES > 1 )
 
-	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
 	{
-	TaskHandle_t xReturn;
+	TaskHandle_t xReturn = NULL;
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+		if( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUM_CORES ) )
+		{
+			xReturn = pxCurrentTCBs[ xCoreID ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
 		return xReturn;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* configNUM_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -3851,14 +5068,24 @@ TCB_t *pxTCB;
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-			{
-				xReturn = taskSCHEDULER_RUNNING;
-			}
-			else
+			/* With more than one core the scheduler can be suspended by a task
+			on another core, so the state is read while holding the locks. */
+			#if( configNUM_CORES > 1 )
+				taskENTER_CRITICAL();
+			#endif
 			{
-				xReturn = taskSCHEDULER_SUSPENDED;
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					xReturn = taskSCHEDULER_RUNNING;
+				}
+				else
+				{
+					xReturn = taskSCHEDULER_SUSPENDED;
+				}
 			}
+			#if( configNUM_CORES > 1 )
+				taskEXIT_CRITICAL();
+			#endif
 		}
 
 		return xReturn;
@@ -3867,6 +5094,24 @@ TCB_t *pxTCB;
 #endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	static UBaseType_t prvGetSchedulerSuspended( void )
+	{
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			uxReturn = uxSchedulerSuspended;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
@@ -3912,6 +5157,15 @@ TCB_t *pxTCB;
 					/* Inherit the priority before being moved into the new list. */
 					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
 					prvAddTaskToReadyList( pxMutexHolderTCB );
+
+					#if( configNUM_CORES > 1 )
+					{
+						/* The holder may now preempt a task on another core.
+						The calling task is about to block, so whether its
+						own core must yield is not needed. */
+						( void ) prvYieldForTask( pxMutexHolderTCB, pdFALSE );
+					}
+					#endif /* configNUM_CORES */
 				}
 				else
 				{
@@ -4116,6 +5370,22 @@ TCB_t *pxTCB;
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+
+					#if( configNUM_CORES > 1 )
+					{
+						/* The mutex holder may be running on another core, which
+						must now check whether a task of higher priority is
+						ready. */
+						if( taskTASK_IS_RUNNING( pxTCB ) )
+						{
+							prvYieldCore( pxTCB->xTaskRunState );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configNUM_CORES */
 				}
 				else
 				{
@@ -4136,7 +5406,7 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configNUM_CORES == 1 ) )
 
 	void vTaskEnterCritical( void )
 	{
@@ -4166,7 +5436,7 @@ TCB_t *pxTCB;
 #endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configNUM_CORES == 1 ) )
 
 	void vTaskExitCritical( void )
 	{
@@ -4199,6 +5469,194 @@ TCB_t *pxTCB;
 #endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	static void prvGetKernelLocks( void )
+	{
+		for( ;; )
+		{
+			portGET_TASK_LOCK();
+			portGET_ISR_LOCK();
+
+			if( ( xYieldPendings[ portGET_CORE_ID() ] == pdFALSE ) ||
+				( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE ) ||
+				( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting != 0U ) )
+			{
+				break;
+			}
+
+			/* Another core requested a yield, for example because it deleted
+			or suspended the calling task, while this core waited for the locks
+			with interrupts masked.  The yield is performed before the task can
+			continue. */
+			portRELEASE_ISR_LOCK();
+			portRELEASE_TASK_LOCK();
+			portENABLE_INTERRUPTS();
+			portYIELD();
+			portDISABLE_INTERRUPTS();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskEnterCritical( void )
+	{
+	TCB_t *pxTCB;
+
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+			/* The outermost critical section takes the task lock, so no other
+			core can select a task or suspend the scheduler, and then the ISR
+			lock, so no other core can run kernel code from an interrupt. */
+			if( pxTCB->uxCriticalNesting == 0U )
+			{
+				prvGetKernelLocks();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( pxTCB->uxCriticalNesting )++;
+
+			/* As in the single core version, only assert on the outermost
+			critical section. */
+			if( pxTCB->uxCriticalNesting == 1U )
+			{
+				portASSERT_IF_IN_ISR();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskExitCritical( void )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xYieldCurrentTask;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+			if( pxTCB->uxCriticalNesting > 0U )
+			{
+				( pxTCB->uxCriticalNesting )--;
+
+				if( pxTCB->uxCriticalNesting == 0U )
+				{
+					/* A yield requested from within the critical section by
+					portYIELD_WITHIN_API() is performed now, unless the calling
+					task has also suspended the scheduler. */
+					xYieldCurrentTask = ( ( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) ) ? pdTRUE : pdFALSE;
+
+					portRELEASE_ISR_LOCK();
+					portRELEASE_TASK_LOCK();
+					portENABLE_INTERRUPTS();
+
+					if( xYieldCurrentTask != pdFALSE )
+					{
+						portYIELD();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskEnterCriticalFromISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+		/* Only the ISR lock is taken, so an interrupt can run while a task on
+		another core has suspended the scheduler. */
+		if( xSchedulerRunning != pdFALSE )
+		{
+			portGET_ISR_LOCK();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxSavedInterruptStatus;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			portRELEASE_ISR_LOCK();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskYieldWithinAPI( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xYieldNow = pdTRUE;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* The kernel yields from within critical sections.  The yield
+			cannot happen while the calling task holds the kernel locks, so it
+			is held pending until the outermost critical section is exited. */
+			if( ( xSchedulerRunning != pdFALSE ) && ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting > 0U ) )
+			{
+				xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+				xYieldNow = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xYieldNow != pdFALSE )
+		{
+			portYIELD();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName )
@@ -4711,7 +6169,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( prvYieldForTask( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4766,7 +6224,7 @@ TickType_t uxReturn;
 
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
@@ -4829,7 +6287,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( prvYieldForTask( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4851,7 +6309,7 @@ TickType_t uxReturn;
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xReturn;
 	}
@@ -4889,7 +6347,7 @@ TickType_t uxReturn;
 
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			ucOriginalNotifyState = pxTCB->ucNotifyState;
 			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
@@ -4919,7 +6377,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( prvYieldForTask( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4941,7 +6399,7 @@ TickType_t uxReturn;
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 	}
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -4983,6 +6441,9 @@ TickType_t uxReturn;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	TickType_t xTimeToProcess;
+#endif
 const TickType_t xConstTickCount = xTickCount;
 
 	#if( INCLUDE_xTaskAbortDelay == 1 )
@@ -5026,6 +6487,26 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+				/* Every slot of the wheel that was due up to the tick count
+				has been processed, so the wheel time can be moved on to the
+				tick count before the task is inserted. */
+				xDelayedTaskWheelTime = xConstTickCount;
+				xTimeToProcess = prvInsertTaskInDelayedTaskWheel( pxCurrentTCB );
+
+				/* If the slot the task was placed in is due before any other
+				then xNextTaskUnblockTime needs to be updated too. */
+				if( ( TickType_t ) ( xTimeToProcess - xConstTickCount ) < ( TickType_t ) ( xNextTaskUnblockTime - xConstTickCount ) )
+				{
+					xNextTaskUnblockTime = xTimeToProcess;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
 			if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
@@ -5050,6 +6531,7 @@ const TickType_t xConstTickCount = xTickCount;
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -5062,6 +6544,26 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			/* Every slot of the wheel that was due up to the tick count
+			has been processed, so the wheel time can be moved on to the
+			tick count before the task is inserted. */
+			xDelayedTaskWheelTime = xConstTickCount;
+			xTimeToProcess = prvInsertTaskInDelayedTaskWheel( pxCurrentTCB );
+
+			/* If the slot the task was placed in is due before any other
+			then xNextTaskUnblockTime needs to be updated too. */
+			if( ( TickType_t ) ( xTimeToProcess - xConstTickCount ) < ( TickType_t ) ( xNextTaskUnblockTime - xConstTickCount ) )
+			{
+				xNextTaskUnblockTime = xTimeToProcess;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
@@ -5084,6 +6586,7 @@ const TickType_t xConstTickCount = xTickCount;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;
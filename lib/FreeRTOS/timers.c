@@ -125,13 +125,49 @@ typedef struct tmrTimerQueueMessage
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* The number of slots in each level of the timer wheel, and the number of
+	levels needed to span every possible time to expiry. */
+	#define tmrWHEEL_SLOTS			( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK		( tmrWHEEL_SLOTS - ( UBaseType_t ) 1U )
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#define tmrWHEEL_LEVELS		( ( 16 + configTIMER_WHEEL_SLOT_BITS - 1 ) / configTIMER_WHEEL_SLOT_BITS )
+	#else
+		#define tmrWHEEL_LEVELS		( ( 32 + configTIMER_WHEEL_SLOT_BITS - 1 ) / configTIMER_WHEEL_SLOT_BITS )
+	#endif
+
+	/* The hierarchical timing wheel in which active timers are stored.  Each
+	slot of level 0 holds the timers that expire on one tick, and each slot of
+	level N spans all the slots of level N - 1.  A timer is placed in the lowest
+	level that spans the time until it expires, in the slot that holds its
+	expiry time, so starting and stopping a timer does not depend on the
+	number of active timers.  When the wheel time reaches the start of a slot
+	in a level above 0 the timers in that slot are cascaded down to the lower
+	levels, so every timer is in level 0 by the time it expires.  Only times
+	relative to the wheel time are used, so the tick count overflowing needs no
+	special handling.  Only the timer service task is allowed to access the
+	wheel. */
+	PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+
+	/* A bit per slot of each level, set when the slot is not empty. */
+	PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ tmrWHEEL_LEVELS ];
+
+	/* The next tick to be processed.  No timer in the wheel expires before
+	this time. */
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime;
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -176,6 +212,28 @@ static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the timer from the list or timer wheel slot that references it.
+ */
+static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Insert the timer into the slot of the timer wheel that holds its expire
+	 * time, relative to the current wheel time.
+	 */
+	static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the wheel time on to xTime, then cascade the timers held in any
+	 * slots that start at xTime down to the lower levels of the wheel.  No
+	 * timer may expire before xTime.
+	 */
+	static void prvAdvanceTimerWheel( const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto reload timer, then call its callback.
@@ -186,7 +244,9 @@ static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const Tick
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+#if( configUSE_TIMER_WHEEL == 0 )
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -198,7 +258,8 @@ static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched
  * If the timer list contains any active timers then return the expire time of
  * the timer that will expire first and set *pxListWasEmpty to false.  If the
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
- * to pdTRUE.
+ * to pdTRUE.  When the timer wheel is used the time returned can instead be
+ * the time at which timers have to be cascaded down the wheel.
  */
 static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
 
@@ -462,11 +523,15 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+#if( configUSE_TIMER_WHEEL == 1 )
+	Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xTimerWheel[ 0 ][ ( UBaseType_t ) xNextExpireTime & tmrWHEEL_SLOT_MASK ] ) );
+#else
+	Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+#endif
 
 	/* Remove the timer from the list of active timers.  A check has already
 	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	prvRemoveTimerFromActiveList( pxTimer );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
@@ -538,7 +603,7 @@ BaseType_t xListWasEmpty;
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
-BaseType_t xTimerListsWereSwitched;
+BaseType_t xTimerListsWereSwitched, xTimerHasExpired;
 
 	vTaskSuspendAll();
 	{
@@ -551,10 +616,42 @@ BaseType_t xTimerListsWereSwitched;
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			#if( configUSE_TIMER_WHEEL == 1 )
 			{
+				/* Compare the times relative to the wheel time, which is not
+				later than xTimeNow + 1, so the tick count overflowing does not
+				matter. */
+				xTimerHasExpired = ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) < ( TickType_t ) ( ( xTimeNow + ( TickType_t ) 1 ) - xTimerWheelTime ) ) ? pdTRUE : pdFALSE;
+			}
+			#else
+			{
+				xTimerHasExpired = ( xNextExpireTime <= xTimeNow ) ? pdTRUE : pdFALSE;
+			}
+			#endif
+
+			if( ( xListWasEmpty == pdFALSE ) && ( xTimerHasExpired != pdFALSE ) )
+			{
+				#if( configUSE_TIMER_WHEEL == 1 )
+				{
+					/* The time reached is either the expire time of the timers
+					in a slot of level 0, or the time at which the timers in a
+					higher level slot must be cascaded down the wheel, in which
+					case there might not be a timer to process yet. */
+					prvAdvanceTimerWheel( xNextExpireTime );
+					xListWasEmpty = listLIST_IS_EMPTY( &( xTimerWheel[ 0 ][ ( UBaseType_t ) xNextExpireTime & tmrWHEEL_SLOT_MASK ] ) );
+				}
+				#endif
+
 				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+				if( xListWasEmpty == pdFALSE )
+				{
+					prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
@@ -564,12 +661,23 @@ BaseType_t xTimerListsWereSwitched;
 				received - whichever comes first.  The following line cannot
 				be reached unless xNextExpireTime > xTimeNow, except in the
 				case when the current timer list is empty. */
-				if( xListWasEmpty != pdFALSE )
+				#if( configUSE_TIMER_WHEEL == 1 )
 				{
-					/* The current timer list is empty - is the overflow list
-					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					/* Nothing in the wheel is due before xTimeNow + 1, so the
+					wheel time can move on to it.  This keeps the wheel time
+					close to the tick count. */
+					xTimerWheelTime = xTimeNow + ( TickType_t ) 1;
 				}
+				#else
+				{
+					if( xListWasEmpty != pdFALSE )
+					{
+						/* The current timer list is empty - is the overflow list
+						also empty? */
+						xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					}
+				}
+				#endif
 
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
@@ -599,23 +707,90 @@ static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
 
-	/* Timers are listed in expiry time order, with the head of the list
-	referencing the task that will expire first.  Obtain the time at which
-	the timer with the nearest expiry time will expire.  If there are no
-	active timers then just set the next expire time to 0.  That will cause
-	this task to unblock when the tick count overflows, at which point the
-	timer lists will be switched and the next expiry time can be
-	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	TickType_t xTimeToSlot, xTimeToNext = portMAX_DELAY, xTimeIntoSlot;
+	UBaseType_t uxLevel, uxShift, uxSlot, uxSlotsToNext;
+	uint32_t ulOccupied;
+
+		/* The next time of interest is the earliest of the expire time of the
+		timers in level 0 and the times at which the occupied slots of the
+		other levels must be cascaded.  In each level that is the start of the
+		first occupied slot after the one that holds the wheel time.  The slot
+		that holds the wheel time is only due now if the wheel time is at its
+		start, otherwise it is not reached again until the level has turned
+		full circle. */
+		*pxListWasEmpty = pdTRUE;
+
+		for( uxLevel = ( UBaseType_t ) 0; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+		{
+			ulOccupied = ulTimerWheelOccupied[ uxLevel ];
+
+			if( ulOccupied != 0UL )
+			{
+				*pxListWasEmpty = pdFALSE;
+				uxShift = uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS;
+				uxSlot = ( UBaseType_t ) ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK;
+				xTimeIntoSlot = xTimerWheelTime & ( TickType_t ) ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U );
+
+				if( ( ( ulOccupied & ( 1UL << uxSlot ) ) != 0UL ) && ( xTimeIntoSlot == ( TickType_t ) 0U ) )
+				{
+					uxSlotsToNext = ( UBaseType_t ) 0;
+				}
+				else
+				{
+					for( uxSlotsToNext = ( UBaseType_t ) 1; uxSlotsToNext < tmrWHEEL_SLOTS; uxSlotsToNext++ )
+					{
+						if( ( ulOccupied & ( 1UL << ( ( uxSlot + uxSlotsToNext ) & tmrWHEEL_SLOT_MASK ) ) ) != 0UL )
+						{
+							break;
+						}
+					}
+				}
+
+				/* Unsigned arithmetic wraps at the same point as the tick
+				count, which gives the right result for the top level, where
+				only some of the slots are used. */
+				xTimeToSlot = ( TickType_t ) ( ( TickType_t ) ( ( TickType_t ) uxSlotsToNext << uxShift ) - xTimeIntoSlot );
+
+				if( xTimeToSlot < xTimeToNext )
+				{
+					xTimeToNext = xTimeToSlot;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		xNextExpireTime = xTimerWheelTime + xTimeToNext;
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+		/* Timers are listed in expiry time order, with the head of the list
+		referencing the task that will expire first.  Obtain the time at which
+		the timer with the nearest expiry time will expire.  If there are no
+		active timers then just set the next expire time to 0.  That will cause
+		this task to unblock when the tick count overflows, at which point the
+		timer lists will be switched and the next expiry time can be
+		re-assessed.  */
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -624,21 +799,32 @@ TickType_t xNextExpireTime;
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
+		/* The timer wheel does not need to know when the tick count
+		overflows. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
+	#else
+	{
+	PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
-	xLastTime = xTimeNow;
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists();
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+
+		xLastTime = xTimeNow;
+	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xTimeNow;
 }
@@ -663,7 +849,16 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				/* The expiry time is after the tick count overflows. */
+				prvInsertTimerInWheel( pxTimer );
+			}
+			#else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif
 		}
 	}
 	else
@@ -677,7 +872,15 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				prvInsertTimerInWheel( pxTimer );
+			}
+			#else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif
 		}
 	}
 
@@ -685,6 +888,98 @@ BaseType_t xProcessTimerNow = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+{
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+	const List_t * const pxSlot = ( const List_t * ) listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+	UBaseType_t uxIndex;
+
+		if( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0 )
+		{
+			/* The slot is now empty.  Work out which one it is from its
+			position in the wheel. */
+			uxIndex = ( UBaseType_t ) ( pxSlot - &( xTimerWheel[ 0 ][ 0 ] ) ); /*lint !e946 !e947 Pointers to the same array. */
+			ulTimerWheelOccupied[ uxIndex / tmrWHEEL_SLOTS ] &= ~( 1UL << ( uxIndex & tmrWHEEL_SLOT_MASK ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+	{
+	const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	const TickType_t xTimeToExpiry = ( TickType_t ) ( xExpiryTime - xTimerWheelTime );
+	UBaseType_t uxLevel = ( UBaseType_t ) 0, uxShift = ( UBaseType_t ) 0, uxSlot;
+
+		/* Find the lowest level that spans the time to expiry.  The top level
+		spans any time that can be represented by a TickType_t. */
+		while( ( uxLevel < ( UBaseType_t ) ( tmrWHEEL_LEVELS - 1 ) ) && ( ( xTimeToExpiry >> ( uxShift + ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS ) ) != ( TickType_t ) 0U ) )
+		{
+			uxLevel++;
+			uxShift += ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS;
+		}
+
+		/* The order of the timers within a slot does not matter, so the timer
+		is simply added to the end. */
+		uxSlot = ( UBaseType_t ) ( xExpiryTime >> uxShift ) & tmrWHEEL_SLOT_MASK;
+		vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+		ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvAdvanceTimerWheel( const TickType_t xTime )
+	{
+	UBaseType_t uxLevel, uxShift;
+	List_t *pxSlot;
+	Timer_t *pxTimer;
+
+		xTimerWheelTime = xTime;
+
+		/* Work down from the top level, as the timers cascaded from one slot
+		can land in the slot of the level below that starts at the same
+		time.  A cascaded timer always lands in a lower level, so the slot
+		being emptied does not get refilled. */
+		for( uxLevel = ( UBaseType_t ) ( tmrWHEEL_LEVELS - 1 ); uxLevel > ( UBaseType_t ) 0; uxLevel-- )
+		{
+			uxShift = uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS;
+
+			if( ( xTime & ( TickType_t ) ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+			{
+				pxSlot = &( xTimerWheel[ uxLevel ][ ( UBaseType_t ) ( xTime >> uxShift ) & tmrWHEEL_SLOT_MASK ] );
+
+				while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+				{
+					pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+					prvRemoveTimerFromActiveList( pxTimer );
+					prvInsertTimerInWheel( pxTimer );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
@@ -727,7 +1022,7 @@ TickType_t xTimeNow;
 			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
 			{
 				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				prvRemoveTimerFromActiveList( pxTimer );
 			}
 			else
 			{
@@ -832,6 +1127,8 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -889,6 +1186,8 @@ BaseType_t xResult;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -900,10 +1199,30 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				for( uxLevel = ( UBaseType_t ) 0; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = ( UBaseType_t ) 0; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+
+					ulTimerWheelOccupied[ uxLevel ] = 0UL;
+				}
+
+				xTimerWheelTime = xTaskGetTickCount();
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -0,0 +1,487 @@
+/*
+ * Amazon FreeRTOS Buffer Pool V1.0.0
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/**
+ * @file aws_bufferpool_static_size_classed.c
+ * @brief A thread safe, size classed implementation of the BufferPool interface.
+ *
+ * Drop-in replacement for aws_bufferpool_static_thread_safe.c. The statically
+ * allocated buffers are split into up to three size classes:
+ * - Small buffers - bufferpoolconfigNUM_SMALL_BUFFERS buffers of
+ *   bufferpoolconfigSMALL_BUFFER_SIZE bytes each.
+ * - Medium buffers - bufferpoolconfigNUM_MEDIUM_BUFFERS buffers of
+ *   bufferpoolconfigMEDIUM_BUFFER_SIZE bytes each.
+ * - Large buffers - bufferpoolconfigNUM_BUFFERS buffers of
+ *   bufferpoolconfigBUFFER_SIZE bytes each.
+ *
+ * The small and medium classes are optional (they are disabled if their number
+ * of buffers is zero, which is the default), so an existing aws_bufferpool_config.h
+ * gives the same pool as aws_bufferpool_static_thread_safe.c.
+ *
+ * A request is served from the smallest class large enough to hold it and falls
+ * back to the larger classes if that class is exhausted. The free buffers of each
+ * class are kept in a free list so that getting and returning a buffer takes
+ * constant time. If the compiler provides lock free atomic compare-and-swap, the
+ * free lists are updated without disabling interrupts, otherwise each update is
+ * done in one short critical section.
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* BufferPool includes. */
+#include "aws_bufferpool.h"
+#include "aws_bufferpool_config.h"
+
+/* Make sure that proper config options are defined. */
+#ifndef bufferpoolconfigNUM_BUFFERS
+    #error bufferpoolconfigNUM_BUFFERS must be defined in BufferPoolConfig.h
+#endif
+
+#ifndef bufferpoolconfigBUFFER_SIZE
+    #error bufferpoolconfigBUFFER_SIZE must be defined in BufferPoolConfig.h
+#endif
+
+/* The small and medium size classes are disabled unless configured. */
+#ifndef bufferpoolconfigNUM_SMALL_BUFFERS
+    #define bufferpoolconfigNUM_SMALL_BUFFERS    ( 0 )
+#endif
+
+#ifndef bufferpoolconfigSMALL_BUFFER_SIZE
+    #define bufferpoolconfigSMALL_BUFFER_SIZE    ( 128 )
+#endif
+
+#ifndef bufferpoolconfigNUM_MEDIUM_BUFFERS
+    #define bufferpoolconfigNUM_MEDIUM_BUFFERS    ( 0 )
+#endif
+
+#ifndef bufferpoolconfigMEDIUM_BUFFER_SIZE
+    #define bufferpoolconfigMEDIUM_BUFFER_SIZE    ( 512 )
+#endif
+
+/* Use compare-and-swap if the compiler guarantees that it is lock free on
+ * this architecture. */
+#ifndef bufferpoolconfigUSE_ATOMIC_CAS
+    #if defined( __GNUC__ ) && defined( __GCC_ATOMIC_INT_LOCK_FREE ) && ( __GCC_ATOMIC_INT_LOCK_FREE == 2 )
+        #define bufferpoolconfigUSE_ATOMIC_CAS    ( 1 )
+    #else
+        #define bufferpoolconfigUSE_ATOMIC_CAS    ( 0 )
+    #endif
+#endif
+
+#if ( bufferpoolconfigNUM_SMALL_BUFFERS > 0 ) && ( bufferpoolconfigNUM_MEDIUM_BUFFERS > 0 ) && ( bufferpoolconfigSMALL_BUFFER_SIZE >= bufferpoolconfigMEDIUM_BUFFER_SIZE )
+    #error bufferpoolconfigSMALL_BUFFER_SIZE must be smaller than bufferpoolconfigMEDIUM_BUFFER_SIZE
+#endif
+
+#if ( bufferpoolconfigNUM_SMALL_BUFFERS > 0 ) && ( bufferpoolconfigSMALL_BUFFER_SIZE >= bufferpoolconfigBUFFER_SIZE )
+    #error bufferpoolconfigSMALL_BUFFER_SIZE must be smaller than bufferpoolconfigBUFFER_SIZE
+#endif
+
+#if ( bufferpoolconfigNUM_MEDIUM_BUFFERS > 0 ) && ( bufferpoolconfigMEDIUM_BUFFER_SIZE >= bufferpoolconfigBUFFER_SIZE )
+    #error bufferpoolconfigMEDIUM_BUFFER_SIZE must be smaller than bufferpoolconfigBUFFER_SIZE
+#endif
+
+/**
+ * @brief Total number of buffers in all the size classes.
+ */
+#define bufferpoolsizeclassedTOTAL_BUFFERS    ( bufferpoolconfigNUM_SMALL_BUFFERS + bufferpoolconfigNUM_MEDIUM_BUFFERS + bufferpoolconfigNUM_BUFFERS )
+
+#if ( bufferpoolsizeclassedTOTAL_BUFFERS >= 0xFFFF )
+    #error The total number of buffers must be less than 65535
+#endif
+
+/**
+ * @brief The maximum number of size classes.
+ */
+#define bufferpoolsizeclassedMAX_SIZE_CLASSES    ( 3 )
+
+/**
+ * @brief Marks the end of a free list.
+ */
+#define bufferpoolsizeclassedFREE_LIST_END       ( ( uint32_t ) 0xFFFF )
+
+/**
+ * @brief Rounds the given size up to a multiple of portBYTE_ALIGNMENT.
+ *
+ * @param[in] ulSize The given size.
+ */
+#define bufferpoolsizeclassedALIGN_SIZE( ulSize )    ( ( ( ulSize ) + ( portBYTE_ALIGNMENT - 1 ) ) & ~( ( uint32_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * @brief Moves the given pointer ahead by the number of bytes required to
+ * properly align it as specified by portBYTE_ALIGNMENT.
+ *
+ * @param[in] pucPtr The given pointer to be aligned.
+ */
+#define bufferpoolsizeclassedALIGN_POINTER( pucPtr )    ( ( uint8_t * ) ( ( ( size_t ) ( pucPtr + ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) )
+
+/**
+ * @brief The free list head is a buffer index in the lower 16 bits and a
+ * modification count in the upper 16 bits. The modification count changes on
+ * every update so that a compare-and-swap fails if the list was popped and
+ * pushed back to the same head in between (the ABA problem).
+ */
+#define bufferpoolsizeclassedHEAD_INDEX( ulHead )                ( ( ulHead ) & ( uint32_t ) 0xFFFF )
+#define bufferpoolsizeclassedHEAD_MAKE( ulOldHead, ulIndex )    ( ( ( ( ulOldHead ) + ( uint32_t ) 0x10000 ) & ( uint32_t ) 0xFFFF0000 ) | ( ulIndex ) )
+
+/**
+ * @brief Size of the memory backing all the buffers.
+ */
+#define bufferpoolsizeclassedMEMORY_SIZE                                                                      \
+    ( ( bufferpoolconfigNUM_SMALL_BUFFERS * bufferpoolsizeclassedALIGN_SIZE( bufferpoolconfigSMALL_BUFFER_SIZE ) ) +   \
+      ( bufferpoolconfigNUM_MEDIUM_BUFFERS * bufferpoolsizeclassedALIGN_SIZE( bufferpoolconfigMEDIUM_BUFFER_SIZE ) ) + \
+      ( bufferpoolconfigNUM_BUFFERS * bufferpoolsizeclassedALIGN_SIZE( bufferpoolconfigBUFFER_SIZE ) ) )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A set of equally sized buffers.
+ */
+typedef struct SizeClass
+{
+    uint8_t * pucFirstBuffer;          /**< The first buffer of this class. The buffers are contiguous. */
+    uint32_t ulBufferSize;             /**< The size of each buffer as returned to the user. */
+    uint32_t ulBufferStride;           /**< The distance between two consecutive buffers. */
+    uint32_t ulNumBuffers;             /**< The number of buffers in this class. */
+    uint32_t ulFirstIndex;             /**< The index of the first buffer of this class in usNextFree. */
+    volatile uint32_t ulFreeListHead;  /**< The first free buffer. @see bufferpoolsizeclassedHEAD_INDEX. */
+    volatile uint32_t ulInUse;         /**< The number of buffers currently in use. */
+    volatile uint32_t ulHighWaterMark; /**< The maximum number of buffers which were in use at the same time. */
+    volatile uint32_t ulFailedRequests; /**< The number of requests for which this was the best fitting class and no buffer was available. */
+} SizeClass_t;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The memory backing all the buffers, with room to align the first one.
+ */
+static uint8_t ucBufferPoolMemory[ bufferpoolsizeclassedMEMORY_SIZE + ( portBYTE_ALIGNMENT - 1 ) ];
+
+/**
+ * @brief The next free buffer for each buffer on a free list.
+ *
+ * Indexes are relative to the first buffer of the size class.
+ */
+static uint16_t usNextFree[ bufferpoolsizeclassedTOTAL_BUFFERS ];
+
+/**
+ * @brief The configured size classes in the increasing order of buffer size.
+ */
+static SizeClass_t xSizeClasses[ bufferpoolsizeclassedMAX_SIZE_CLASSES ];
+
+/**
+ * @brief The number of configured size classes.
+ */
+static uint32_t ulNumSizeClasses = 0;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Adds a size class, if it has any buffers, after the ones already added.
+ *
+ * @param[in] ulBufferSize The size of each buffer in the class.
+ * @param[in] ulNumBuffers The number of buffers in the class.
+ * @param[in,out] ppucNextBuffer The memory to carve the buffers from. Moved
+ * past the buffers of the class.
+ */
+static void prvAddSizeClass( uint32_t ulBufferSize,
+                             uint32_t ulNumBuffers,
+                             uint8_t ** ppucNextBuffer );
+
+/**
+ * @brief Removes the first buffer from the free list of the given class.
+ *
+ * @param[in] pxSizeClass The size class.
+ *
+ * @return The buffer if the class has a free buffer, NULL otherwise.
+ */
+static uint8_t * prvPopFreeBuffer( SizeClass_t * pxSizeClass );
+
+/**
+ * @brief Adds the given buffer to the free list of the given class.
+ *
+ * @param[in] pxSizeClass The size class the buffer belongs to.
+ * @param[in] ulIndex The index of the buffer within its class.
+ */
+static void prvPushFreeBuffer( SizeClass_t * pxSizeClass,
+                               uint32_t ulIndex );
+/*-----------------------------------------------------------*/
+
+static void prvAddSizeClass( uint32_t ulBufferSize,
+                             uint32_t ulNumBuffers,
+                             uint8_t ** ppucNextBuffer )
+{
+    SizeClass_t * pxSizeClass;
+    uint32_t x, ulFirstIndex = 0;
+
+    if( ulNumBuffers > ( uint32_t ) 0 )
+    {
+        if( ulNumSizeClasses > ( uint32_t ) 0 )
+        {
+            ulFirstIndex = xSizeClasses[ ulNumSizeClasses - 1 ].ulFirstIndex + xSizeClasses[ ulNumSizeClasses - 1 ].ulNumBuffers;
+        }
+
+        pxSizeClass = &( xSizeClasses[ ulNumSizeClasses ] );
+        pxSizeClass->pucFirstBuffer = *ppucNextBuffer;
+        pxSizeClass->ulBufferSize = ulBufferSize;
+        pxSizeClass->ulBufferStride = bufferpoolsizeclassedALIGN_SIZE( ulBufferSize );
+        pxSizeClass->ulNumBuffers = ulNumBuffers;
+        pxSizeClass->ulFirstIndex = ulFirstIndex;
+        pxSizeClass->ulInUse = 0;
+        pxSizeClass->ulHighWaterMark = 0;
+        pxSizeClass->ulFailedRequests = 0;
+
+        /* Chain all the buffers of the class in the free list in
+         * address order. */
+        for( x = 0; x < ulNumBuffers; x++ )
+        {
+            usNextFree[ ulFirstIndex + x ] = ( uint16_t ) ( ( x + ( uint32_t ) 1 < ulNumBuffers ) ? ( x + ( uint32_t ) 1 ) : bufferpoolsizeclassedFREE_LIST_END );
+        }
+
+        pxSizeClass->ulFreeListHead = 0;
+
+        *ppucNextBuffer += pxSizeClass->ulBufferStride * ulNumBuffers;
+        ulNumSizeClasses++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvPopFreeBuffer( SizeClass_t * pxSizeClass )
+{
+    uint32_t ulHead, ulIndex, ulInUse;
+    uint8_t * pucBuffer = NULL;
+
+    #if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 )
+        uint32_t ulHighWaterMark;
+    #endif
+
+    #if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 )
+        ulHead = __atomic_load_n( &( pxSizeClass->ulFreeListHead ), __ATOMIC_ACQUIRE );
+
+        do
+        {
+            ulIndex = bufferpoolsizeclassedHEAD_INDEX( ulHead );
+
+            if( ulIndex == bufferpoolsizeclassedFREE_LIST_END )
+            {
+                break;
+            }
+
+            /* usNextFree may be stale if another task popped this buffer
+             * meanwhile, in which case the modification count in the head
+             * has changed and the compare-and-swap fails. */
+        } while( __atomic_compare_exchange_n( &( pxSizeClass->ulFreeListHead ),
+                                              &ulHead,
+                                              bufferpoolsizeclassedHEAD_MAKE( ulHead, ( uint32_t ) __atomic_load_n( &( usNextFree[ pxSizeClass->ulFirstIndex + ulIndex ] ), __ATOMIC_RELAXED ) ),
+                                              pdFALSE,
+                                              __ATOMIC_ACQ_REL,
+                                              __ATOMIC_ACQUIRE ) == pdFALSE );
+
+        if( ulIndex != bufferpoolsizeclassedFREE_LIST_END )
+        {
+            /* Track the high water mark. */
+            ulInUse = __atomic_add_fetch( &( pxSizeClass->ulInUse ), 1, __ATOMIC_RELAXED );
+            ulHighWaterMark = __atomic_load_n( &( pxSizeClass->ulHighWaterMark ), __ATOMIC_RELAXED );
+
+            while( ( ulInUse > ulHighWaterMark ) &&
+                   ( __atomic_compare_exchange_n( &( pxSizeClass->ulHighWaterMark ), &ulHighWaterMark, ulInUse, pdFALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) == pdFALSE ) )
+            {
+            }
+
+            pucBuffer = &( pxSizeClass->pucFirstBuffer[ ulIndex * pxSizeClass->ulBufferStride ] );
+        }
+    #else /* if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 ) */
+        taskENTER_CRITICAL();
+        {
+            ulHead = pxSizeClass->ulFreeListHead;
+            ulIndex = bufferpoolsizeclassedHEAD_INDEX( ulHead );
+
+            if( ulIndex != bufferpoolsizeclassedFREE_LIST_END )
+            {
+                pxSizeClass->ulFreeListHead = bufferpoolsizeclassedHEAD_MAKE( ulHead, ( uint32_t ) usNextFree[ pxSizeClass->ulFirstIndex + ulIndex ] );
+
+                ulInUse = pxSizeClass->ulInUse + ( uint32_t ) 1;
+                pxSizeClass->ulInUse = ulInUse;
+
+                if( ulInUse > pxSizeClass->ulHighWaterMark )
+                {
+                    pxSizeClass->ulHighWaterMark = ulInUse;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ulIndex != bufferpoolsizeclassedFREE_LIST_END )
+        {
+            pucBuffer = &( pxSizeClass->pucFirstBuffer[ ulIndex * pxSizeClass->ulBufferStride ] );
+        }
+    #endif /* if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 ) */
+
+    return pucBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPushFreeBuffer( SizeClass_t * pxSizeClass,
+                               uint32_t ulIndex )
+{
+    uint32_t ulHead;
+
+    #if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 )
+
+        /* Decrement the in use count before the buffer can be taken
+         * again so that the count never exceeds the number of buffers. */
+        ( void ) __atomic_sub_fetch( &( pxSizeClass->ulInUse ), 1, __ATOMIC_RELAXED );
+
+        ulHead = __atomic_load_n( &( pxSizeClass->ulFreeListHead ), __ATOMIC_RELAXED );
+
+        do
+        {
+            __atomic_store_n( &( usNextFree[ pxSizeClass->ulFirstIndex + ulIndex ] ), ( uint16_t ) bufferpoolsizeclassedHEAD_INDEX( ulHead ), __ATOMIC_RELAXED );
+        } while( __atomic_compare_exchange_n( &( pxSizeClass->ulFreeListHead ),
+                                              &ulHead,
+                                              bufferpoolsizeclassedHEAD_MAKE( ulHead, ulIndex ),
+                                              pdFALSE,
+                                              __ATOMIC_RELEASE,
+                                              __ATOMIC_RELAXED ) == pdFALSE );
+    #else
+        taskENTER_CRITICAL();
+        {
+            ulHead = pxSizeClass->ulFreeListHead;
+            usNextFree[ pxSizeClass->ulFirstIndex + ulIndex ] = ( uint16_t ) bufferpoolsizeclassedHEAD_INDEX( ulHead );
+            pxSizeClass->ulFreeListHead = bufferpoolsizeclassedHEAD_MAKE( ulHead, ulIndex );
+            pxSizeClass->ulInUse--;
+        }
+        taskEXIT_CRITICAL();
+    #endif /* if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 ) */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t BUFFERPOOL_Init( void )
+{
+    uint8_t * pucNextBuffer;
+
+    /* This function is supposed to be called exactly once
+     * and hence no thread safety is ensured. */
+    ulNumSizeClasses = 0;
+    pucNextBuffer = bufferpoolsizeclassedALIGN_POINTER( ucBufferPoolMemory );
+
+    /* Add the classes in the increasing order of buffer size. */
+    prvAddSizeClass( bufferpoolconfigSMALL_BUFFER_SIZE, bufferpoolconfigNUM_SMALL_BUFFERS, &pucNextBuffer );
+    prvAddSizeClass( bufferpoolconfigMEDIUM_BUFFER_SIZE, bufferpoolconfigNUM_MEDIUM_BUFFERS, &pucNextBuffer );
+    prvAddSizeClass( bufferpoolconfigBUFFER_SIZE, bufferpoolconfigNUM_BUFFERS, &pucNextBuffer );
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t * BUFFERPOOL_GetFreeBuffer( uint32_t * pulBufferLength )
+{
+    uint32_t x, ulBestFit = ulNumSizeClasses;
+    uint8_t * pucFreeBuffer = NULL;
+
+    /* Try the smallest class which is large enough first and
+     * fall back to the larger ones if it is exhausted. */
+    for( x = 0; ( x < ulNumSizeClasses ) && ( pucFreeBuffer == NULL ); x++ )
+    {
+        if( *pulBufferLength <= xSizeClasses[ x ].ulBufferSize )
+        {
+            if( ulBestFit == ulNumSizeClasses )
+            {
+                ulBestFit = x;
+            }
+
+            pucFreeBuffer = prvPopFreeBuffer( &( xSizeClasses[ x ] ) );
+
+            if( pucFreeBuffer != NULL )
+            {
+                /* Return the actual buffer size to the user. */
+                *pulBufferLength = xSizeClasses[ x ].ulBufferSize;
+            }
+        }
+    }
+
+    /* Count the failure against the class which should have
+     * served the request. Requests larger than any buffer are not
+     * counted. */
+    if( ( pucFreeBuffer == NULL ) && ( ulBestFit < ulNumSizeClasses ) )
+    {
+        #if ( bufferpoolconfigUSE_ATOMIC_CAS == 1 )
+            ( void ) __atomic_add_fetch( &( xSizeClasses[ ulBestFit ].ulFailedRequests ), 1, __ATOMIC_RELAXED );
+        #else
+            taskENTER_CRITICAL();
+            xSizeClasses[ ulBestFit ].ulFailedRequests++;
+            taskEXIT_CRITICAL();
+        #endif
+    }
+
+    return pucFreeBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void BUFFERPOOL_ReturnBuffer( uint8_t * const pucBuffer )
+{
+    uint32_t x, ulOffset;
+    SizeClass_t * pxSizeClass;
+
+    /* Find the class the buffer was carved from. */
+    for( x = 0; x < ulNumSizeClasses; x++ )
+    {
+        pxSizeClass = &( xSizeClasses[ x ] );
+
+        if( ( pucBuffer >= pxSizeClass->pucFirstBuffer ) &&
+            ( pucBuffer < &( pxSizeClass->pucFirstBuffer[ pxSizeClass->ulBufferStride * pxSizeClass->ulNumBuffers ] ) ) )
+        {
+            ulOffset = ( uint32_t ) ( pucBuffer - pxSizeClass->pucFirstBuffer );
+            configASSERT( ( ulOffset % pxSizeClass->ulBufferStride ) == 0 );
+
+            prvPushFreeBuffer( pxSizeClass, ulOffset / pxSizeClass->ulBufferStride );
+
+            break;
+        }
+    }
+
+    /* The buffer must be one from the pool. */
+    configASSERT( x < ulNumSizeClasses );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t BUFFERPOOL_GetStats( uint32_t ulSizeClass,
+                                BufferPoolStats_t * const pxStats )
+{
+    BaseType_t xResult = pdFAIL;
+
+    if( ulSizeClass < ulNumSizeClasses )
+    {
+        pxStats->ulBufferSize = xSizeClasses[ ulSizeClass ].ulBufferSize;
+        pxStats->ulNumBuffers = xSizeClasses[ ulSizeClass ].ulNumBuffers;
+        pxStats->ulInUse = xSizeClasses[ ulSizeClass ].ulInUse;
+        pxStats->ulHighWaterMark = xSizeClasses[ ulSizeClass ].ulHighWaterMark;
+        pxStats->ulFailedRequests = xSizeClasses[ ulSizeClass ].ulFailedRequests;
+
+        xResult = pdPASS;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
@@ -112,6 +112,13 @@ typedef struct BufferMetadata
  * to store the metadata and to ensure alignment.
  */
 static uint8_t ucBufferPool[ bufferpoolconfigNUM_BUFFERS ][ sizeof( BufferMetadata_t ) + bufferpoolconfigBUFFER_SIZE + ( portBYTE_ALIGNMENT - 1 ) ];
+
+/**
+ * @brief Usage statistics of the buffer pool.
+ *
+ * This implementation has only one size class.
+ */
+static BufferPoolStats_t xBufferPoolStats;
 /*-----------------------------------------------------------*/
 
 BaseType_t BUFFERPOOL_Init( void )
@@ -126,6 +133,12 @@ BaseType_t BUFFERPOOL_Init( void )
         bufferpoolstaticBUFFER_IN_USE( ucBufferPool[ x ] ) = 0;
     }
 
+    xBufferPoolStats.ulBufferSize = bufferpoolconfigBUFFER_SIZE;
+    xBufferPoolStats.ulNumBuffers = bufferpoolconfigNUM_BUFFERS;
+    xBufferPoolStats.ulInUse = 0;
+    xBufferPoolStats.ulHighWaterMark = 0;
+    xBufferPoolStats.ulFailedRequests = 0;
+
     return pdPASS;
 }
 /*-----------------------------------------------------------*/
@@ -151,6 +164,14 @@ uint8_t * BUFFERPOOL_GetFreeBuffer( uint32_t * pulBufferLength )
                 /* Mark the buffer as "in-use". */
                 bufferpoolstaticBUFFER_IN_USE( ucBufferPool[ x ] ) = 1;
 
+                /* Update the statistics. */
+                xBufferPoolStats.ulInUse++;
+
+                if( xBufferPoolStats.ulInUse > xBufferPoolStats.ulHighWaterMark )
+                {
+                    xBufferPoolStats.ulHighWaterMark = xBufferPoolStats.ulInUse;
+                }
+
                 /* End critical section. The further operations in this
                  * if branch do not modify the buffer and hence the critical
                  * section is not needed hereafter. */
@@ -172,6 +193,13 @@ uint8_t * BUFFERPOOL_GetFreeBuffer( uint32_t * pulBufferLength )
                 taskEXIT_CRITICAL();
             }
         }
+
+        if( pucFreeBuffer == NULL )
+        {
+            taskENTER_CRITICAL();
+            xBufferPoolStats.ulFailedRequests++;
+            taskEXIT_CRITICAL();
+        }
     }
 
     return pucFreeBuffer;
@@ -187,8 +215,24 @@ void BUFFERPOOL_ReturnBuffer( uint8_t * const pucBuffer )
      * location in the actual buffer (because we gave the data location
      * to the user). */
     bufferpoolstaticBUFFER_IN_USE_FROM_DATA_LOCATION( pucBuffer ) = 0;
+    xBufferPoolStats.ulInUse--;
 
     /* End critical section. */
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
+
+BaseType_t BUFFERPOOL_GetStats( uint32_t ulSizeClass,
+                                BufferPoolStats_t * const pxStats )
+{
+    BaseType_t xResult = pdFAIL;
+
+    if( ulSizeClass == ( uint32_t ) 0 )
+    {
+        *pxStats = xBufferPoolStats;
+        xResult = pdPASS;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
@@ -492,6 +492,13 @@ extern "C" {
 	#define traceTASK_CREATE_FAILED()
 #endif
 
+#if( configUSE_HEAP_STATS_PER_TASK == 1 )
+	#ifndef traceTASK_DELETE
+		/* Lets the heap reuse the statistics entry of a deleted task. */
+		#define traceTASK_DELETE( pxTaskToDelete ) vPortHeapStatsTaskDeleted( ( void * ) ( pxTaskToDelete ) )
+	#endif
+#endif
+
 #ifndef traceTASK_DELETE
 	#define traceTASK_DELETE( pxTaskToDelete )
 #endif
@@ -688,6 +695,30 @@ extern "C" {
 	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceSPSC_RING_CREATE_FAILED
+	#define traceSPSC_RING_CREATE_FAILED()
+#endif
+
+#ifndef traceSPSC_RING_CREATE_STATIC_FAILED
+	#define traceSPSC_RING_CREATE_STATIC_FAILED( xReturn )
+#endif
+
+#ifndef traceSPSC_RING_CREATE
+	#define traceSPSC_RING_CREATE( pxRing )
+#endif
+
+#ifndef traceSPSC_RING_DELETE
+	#define traceSPSC_RING_DELETE( xRing )
+#endif
+
+#ifndef traceSPSC_RING_SEND_FAILED
+	#define traceSPSC_RING_SEND_FAILED( xRing )
+#endif
+
+#ifndef traceBLOCKING_ON_SPSC_RING_RECEIVE
+	#define traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -718,6 +749,48 @@ extern "C" {
 	#define portPRIVILEGE_BIT ( ( UBaseType_t ) 0x00 )
 #endif
 
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+#ifndef configRUN_MULTIPLE_PRIORITIES
+	#define configRUN_MULTIPLE_PRIORITIES 0
+#endif
+
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+	#define configUSE_PASSIVE_IDLE_HOOK 0
+#endif
+
+#if( configNUM_CORES > 1 )
+
+	/* The scheduler needs the following from a port that runs it on more than
+	one core.  portGET_CORE_ID() returns the number of the calling core, from 0
+	to configNUM_CORES - 1.  portYIELD_CORE() interrupts another core so it
+	performs a context switch, the cross-core equivalent of portYIELD().  The
+	task lock is held while the scheduler is suspended and the ISR lock while
+	the kernel lists are updated.  Both are spinlocks that can be taken again
+	by the core that already holds them. */
+	#ifndef portGET_CORE_ID
+		#error portGET_CORE_ID() must be defined by the port when configNUM_CORES is greater than 1.
+	#endif
+
+	#ifndef portYIELD_CORE
+		#error portYIELD_CORE() must be defined by the port when configNUM_CORES is greater than 1.
+	#endif
+
+	#if( !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK ) )
+		#error portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() must be defined by the port when configNUM_CORES is greater than 1.
+	#endif
+
+	#ifndef portYIELD_WITHIN_API
+		/* A task must not be switched out while it holds the kernel locks, so
+		a yield requested from within a critical section is held pending until
+		the critical section is exited. */
+		#define portYIELD_WITHIN_API vTaskYieldWithinAPI
+	#endif
+
+#endif /* configNUM_CORES */
+
 #ifndef portYIELD_WITHIN_API
 	#define portYIELD_WITHIN_API portYIELD
 #endif
@@ -802,6 +875,50 @@ extern "C" {
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+#ifndef configHEAP_6_USE_HEAP_REGIONS
+	#define configHEAP_6_USE_HEAP_REGIONS 0
+#endif
+
+#ifndef configUSE_HEAP_STATS_PER_TASK
+	#define configUSE_HEAP_STATS_PER_TASK 0
+#endif
+
+#ifndef configHEAP_STATS_MAX_TASKS
+	#define configHEAP_STATS_MAX_TASKS 16
+#endif
+
+#ifndef configHEAP_TRACE_BUFFER_LENGTH
+	#define configHEAP_TRACE_BUFFER_LENGTH 0
+#endif
+
+#if( ( configUSE_HEAP_STATS_PER_TASK == 1 ) && ( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) || ( INCLUDE_xTaskGetSchedulerState != 1 ) ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle and INCLUDE_xTaskGetSchedulerState must be set to 1 in FreeRTOSConfig.h when configUSE_HEAP_STATS_PER_TASK is 1.
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+	#define configTIMER_WHEEL_SLOT_BITS 5
+#endif
+
+#if( ( configUSE_TIMER_WHEEL == 1 ) && ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) ) )
+	#error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5.
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+	#define configDELAYED_TASK_WHEEL_SLOT_BITS 5
+#endif
+
+#if( ( configUSE_DELAYED_TASK_WHEEL == 1 ) && ( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 5 ) ) )
+	#error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 5.
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
@@ -814,6 +931,14 @@ extern "C" {
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
 
+#ifndef portMEMORY_BARRIER
+	/* Orders the memory accesses made before the barrier before those made
+	after it, as seen by other cores and bus masters.  Nothing is needed on a
+	single core, where the volatile accesses made by SPSC rings are already
+	performed in program order. */
+	#define portMEMORY_BARRIER()
+#endif
+
 #ifndef configSUPPORT_STATIC_ALLOCATION
 	/* Defaults to 0 for backward compatibility. */
 	#define configSUPPORT_STATIC_ALLOCATION 0
@@ -845,6 +970,20 @@ extern "C" {
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( configNUM_CORES > 1 )
+	#if( configUSE_PREEMPTION == 0 )
+		#error configUSE_PREEMPTION must be set to 1 when configNUM_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be set to 0 when configNUM_CORES is greater than 1.
+	#endif
+
+	#if( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_POSIX_ERRNO == 1 ) )
+		#error configUSE_NEWLIB_REENTRANT and configUSE_POSIX_ERRNO select a single global errno, so must be set to 0 when configNUM_CORES is greater than 1.
+	#endif
+#endif /* configNUM_CORES */
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -998,7 +1137,7 @@ typedef struct xSTATIC_TCB
 	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
 		void			*pxDummy8;
 	#endif
-	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+	#if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) || ( configNUM_CORES > 1 ) )
 		UBaseType_t		uxDummy9;
 	#endif
 	#if ( configUSE_TRACE_FACILITY == 1 )
@@ -1032,6 +1171,10 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int             iDummy22;
 	#endif
+	#if ( configNUM_CORES > 1 )
+		BaseType_t		xDummy23;
+		UBaseType_t		uxDummy24;
+	#endif
 } StaticTask_t;
 
 /*
@@ -1165,6 +1308,21 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+* In line with software engineering best practice, FreeRTOS implements a strict
+* data hiding policy, so the real SPSC ring structure is not accessible to the
+* application.  The StaticSPSCRing_t structure below has the same size and
+* alignment requirements as the real structure, so it can be used to statically
+* allocate an SPSC ring with xSPSCRingCreateStatic().
+*/
+typedef struct xSTATIC_SPSC_RING
+{
+	size_t uxDummy1[ 3 ];
+	void * pvDummy2[ 3 ];
+	UBaseType_t uxDummy3[ 2 ];
+	uint8_t ucDummy4;
+} StaticSPSCRing_t;
+
 #ifdef __cplusplus
 }
 #endif
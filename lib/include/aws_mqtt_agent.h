@@ -76,8 +76,10 @@ typedef enum
  */
 typedef enum
 {
-    eMQTTAgentPublish,   /**< A Publish message was received from the broker. */
-    eMQTTAgentDisconnect /**< The connection to the broker got disconnected. */
+    eMQTTAgentPublish,             /**< A Publish message was received from the broker. */
+    eMQTTAgentDisconnect,          /**< The connection to the broker got disconnected. */
+    eMQTTAgentPublishStreamHeader, /**< The header of a streamed Publish message was received from the broker. Reported only if mqttconfigENABLE_STREAMING_PUBLISH is 1. */
+    eMQTTAgentPublishStreamChunk   /**< A part of the payload of a streamed Publish message was received from the broker. Reported only if mqttconfigENABLE_STREAMING_PUBLISH is 1. */
 } MQTTAgentEvent_t;
 
 /**
@@ -93,7 +95,10 @@ typedef struct MQTTAgentCallbackParams
     /* This union is here for future support. */
     union
     {
-        MQTTPublishData_t xPublishData; /**< Publish data. Meaningful only in case of eMQTTAgentPublish event. */
+        MQTTPublishData_t xPublishData; /**< Publish data. Meaningful only in case of eMQTTAgentPublish and eMQTTAgentPublishStreamHeader events. */
+        #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+            MQTTPublishChunkData_t xPublishChunkData; /**< Streamed publish payload data. Meaningful only in case of eMQTTAgentPublishStreamChunk event. The payload points into the receive buffer of the MQTT task and is valid only during the callback. */
+        #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
     } u;
 } MQTTAgentCallbackParams_t;
 
@@ -122,6 +127,19 @@ typedef struct MQTTAgentCallbackParams
 typedef BaseType_t ( * MQTTAgentCallback_t ) ( void * pvUserData,
                                                const MQTTAgentCallbackParams_t * const pxCallbackParams );
 
+/**
+ * @brief Signature of the callback invoked when a publish started with MQTT_AGENT_PublishAsync completes.
+ *
+ * The callback runs in the context of the MQTT task and therefore must not block. It may call
+ * MQTT_AGENT_PublishAsync to keep the in-flight window full, but no other MQTT agent API.
+ *
+ * @param[in] pvCallbackContext The context as provided to MQTT_AGENT_PublishAsync.
+ * @param[in] xResult eMQTTAgentSuccess if the QoS0 message was sent or the PUBACK of the QoS1 message
+ * was received, eMQTTAgentTimeout if the operation did not complete in time, eMQTTAgentFailure otherwise.
+ */
+typedef void ( * MQTTAgentPublishCompleteCallback_t ) ( void * pvCallbackContext,
+                                                        MQTTAgentReturnCode_t xResult );
+
 /**
 * @brief Flags for the MQTT agent connect params.
 */
@@ -339,6 +357,68 @@ MQTTAgentReturnCode_t MQTT_AGENT_Publish( MQTTAgentHandle_t xMQTTHandle,
                                           const MQTTAgentPublishParams_t * const pxPublishParams,
                                           TickType_t xTimeoutTicks );
 
+/**
+ * @brief Publishes a number of messages with one request to the MQTT task.
+ *
+ * All the messages are handed to the MQTT task in one command and are sent back-to-back,
+ * which saves the context switches incurred by calling MQTT_AGENT_Publish for each of them.
+ * The calling task is unblocked once, after all the QoS0 messages have been sent and all the
+ * QoS1 messages have been acknowledged, have timed out or have failed.
+ *
+ * @note This function alters the calling task's notification state and value. If xTimeoutTicks
+ * is short the calling task's notification state and value may be updated after MQTT_AGENT_PublishBatch()
+ * has returned.
+ *
+ * @param[in] xMQTTHandle The opaque handle as returned from MQTT_AGENT_Create.
+ * @param[in] pxPublishParams Array of ulNumPublishes publish parameters.
+ * @param[out] pxPublishResults Array of ulNumPublishes entries receiving the result of each publish
+ * operation: eMQTTAgentSuccess, eMQTTAgentTimeout or eMQTTAgentFailure.
+ * @param[in] ulNumPublishes The number of messages to publish. Must not be more than
+ * mqttconfigMAX_PUBLISH_BATCH_SIZE.
+ * @param[in] xTimeoutTicks Maximum time in ticks after which the operation should fail. Use pdMS_TO_TICKS
+ * macro to convert milliseconds to ticks.
+ *
+ * @return eMQTTAgentSuccess if all the publish operations succeed, otherwise an error code explaining
+ * the reason of the failure is returned and pxPublishResults tells which of the messages failed.
+ */
+MQTTAgentReturnCode_t MQTT_AGENT_PublishBatch( MQTTAgentHandle_t xMQTTHandle,
+                                               const MQTTAgentPublishParams_t * const pxPublishParams,
+                                               MQTTAgentReturnCode_t * const pxPublishResults,
+                                               uint32_t ulNumPublishes,
+                                               TickType_t xTimeoutTicks );
+
+/**
+ * @brief Starts publishing a message to a given topic without waiting for the result.
+ *
+ * The calling task is not blocked until the message is acknowledged, so that a single task can
+ * have up to mqttconfigMAX_ASYNC_PUBLISHES QoS1 messages in flight per connection and is not
+ * limited to one message per broker round trip. The result of each publish is reported to
+ * xCompleteCallback. This function does not alter the calling task's notification state.
+ *
+ * @note Unlike MQTT_AGENT_Publish, the topic and the data in pxPublishParams are not copied
+ * before the MQTT task processes the request and must therefore remain valid until
+ * xCompleteCallback is invoked. The publish parameters structure itself is copied. If
+ * mqttconfigENABLE_ZERO_COPY_PUBLISH is 1, the data is not copied into a buffer from the pool
+ * either and is therefore not limited by the size of the pool buffers.
+ *
+ * @param[in] xMQTTHandle The opaque handle as returned from MQTT_AGENT_Create.
+ * @param[in] pxPublishParams Publish parameters.
+ * @param[in] xCompleteCallback The callback invoked when the publish completes. May be NULL.
+ * @param[in] pvCallbackContext Passed as it is to xCompleteCallback.
+ * @param[in] xTimeoutTicks Maximum time in ticks after which the operation should fail. Use pdMS_TO_TICKS
+ * macro to convert milliseconds to ticks.
+ *
+ * @return eMQTTAgentSuccess if the publish was started, in which case xCompleteCallback is invoked
+ * exactly once. eMQTTAgentFailure if mqttconfigMAX_ASYNC_PUBLISHES publishes are already in flight
+ * (always the case if mqttconfigMAX_ASYNC_PUBLISHES is 0) and eMQTTAgentTimeout if the request could not be posted to the MQTT task within xTimeoutTicks,
+ * in which cases xCompleteCallback is not invoked.
+ */
+MQTTAgentReturnCode_t MQTT_AGENT_PublishAsync( MQTTAgentHandle_t xMQTTHandle,
+                                               const MQTTAgentPublishParams_t * const pxPublishParams,
+                                               MQTTAgentPublishCompleteCallback_t xCompleteCallback,
+                                               void * pvCallbackContext,
+                                               TickType_t xTimeoutTicks );
+
 /**
  * @brief Returns the buffer provided in the publish callback.
  *
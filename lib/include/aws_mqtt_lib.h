@@ -101,12 +101,14 @@ typedef enum
  * @brief The action taken on the message being received.
  *
  * If a large enough buffer is available to store the message, it
- * is stored, otherwise it is dropped.
+ * is stored, otherwise it is dropped. If mqttconfigENABLE_STREAMING_PUBLISH
+ * is 1, a publish message which cannot be stored is streamed instead.
  */
 typedef enum
 {
     eMQTTRxMessageStore, /**< The message being received is being stored. */
-    eMQTTRxMessageDrop   /**< The message being received is being dropped. */
+    eMQTTRxMessageDrop,  /**< The message being received is being dropped. */
+    eMQTTRxMessageStream /**< The publish message being received is being streamed to the user. Used only if mqttconfigENABLE_STREAMING_PUBLISH is 1. */
 } MQTTRxMessageAction_t;
 
 /**
@@ -118,19 +120,21 @@ typedef enum
  */
 typedef enum
 {
-    eMQTTPublish,            /**< Publish message received from the broker. */
-    eMQTTConnACK,            /**< CONNACK received. */
-    eMQTTUnexpectedConnACK,  /**< Unexpected CONNACK received. */
-    eMQTTPubACK,             /**< PUBACK received. */
-    eMQTTUnexpectedPubACK,   /**< Unexpected PUBACK received. */
-    eMQTTSubACK,             /**< SUBACK received. */
-    eMQTTUnexpectedSubACK,   /**< Unexpected SUBACK received. */
-    eMQTTUnSubACK,           /**< UNSUBACK received. */
-    eMQTTUnexpectedUnSubACK, /**< Unexpected UNSUBACK received. */
-    eMQTTClientDisconnected, /**< Client has been disconnected. The user must re-connect before carrying out any other operation. */
-    eMQTTPacketDropped,      /**< A packet was dropped because a large enough buffer was not available to store it. */
-    eMQTTTimeout,            /**< Timeout detected - An expected ACK was not received within the specified time. */
-    eMQTTPingTimeout         /**< A PINGRESP was not received within the expected time. */
+    eMQTTPublish,             /**< Publish message received from the broker. */
+    eMQTTConnACK,             /**< CONNACK received. */
+    eMQTTUnexpectedConnACK,   /**< Unexpected CONNACK received. */
+    eMQTTPubACK,              /**< PUBACK received. */
+    eMQTTUnexpectedPubACK,    /**< Unexpected PUBACK received. */
+    eMQTTSubACK,              /**< SUBACK received. */
+    eMQTTUnexpectedSubACK,    /**< Unexpected SUBACK received. */
+    eMQTTUnSubACK,            /**< UNSUBACK received. */
+    eMQTTUnexpectedUnSubACK,  /**< Unexpected UNSUBACK received. */
+    eMQTTClientDisconnected,  /**< Client has been disconnected. The user must re-connect before carrying out any other operation. */
+    eMQTTPacketDropped,       /**< A packet was dropped because a large enough buffer was not available to store it. */
+    eMQTTTimeout,             /**< Timeout detected - An expected ACK was not received within the specified time. */
+    eMQTTPingTimeout,         /**< A PINGRESP was not received within the expected time. */
+    eMQTTPublishStreamHeader, /**< The header of a streamed publish message received from the broker. Reported only if mqttconfigENABLE_STREAMING_PUBLISH is 1. */
+    eMQTTPublishStreamChunk   /**< A part of the payload of a streamed publish message. Reported only if mqttconfigENABLE_STREAMING_PUBLISH is 1. */
 } MQTTEventType_t;
 
 /**
@@ -243,6 +247,9 @@ typedef struct MQTTUnSubACKData
 typedef struct MQTTPubACKData
 {
     uint16_t usPacketIdentifier; /**< Packet identifier which the user can use to match the PUBACK with the Publish request. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        const void * pvData;     /**< The payload passed to MQTT_PublishZeroCopy which is no longer referenced by the library, NULL if the message was published using MQTT_Publish. */
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
 } MQTTPubACKData_t;
 
 /**
@@ -259,6 +266,30 @@ typedef struct MQTTPublishData
     MQTTBufferHandle_t xBuffer; /**< The buffer containing the whole MQTT message. Both pcTopic and pvData are pointers to the locations in this buffer. */
 } MQTTPublishData_t;
 
+/**
+ * @brief The data sent by the MQTT library in the user supplied callback
+ * when a part of the payload of a streamed publish message is received.
+ *
+ * The chunks of one message are reported in order, the first one having
+ * ulChunkOffset 0. The last chunk is the one for which ulChunkOffset plus
+ * ulChunkLength equals ulDataLength. A message with an empty payload is
+ * reported as a single chunk of length zero.
+ */
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+    typedef struct MQTTPublishChunkData
+    {
+        MQTTQoS_t xQos;           /**< Quality of Service (QoS). */
+        const uint8_t * pucTopic; /**< The topic on which the message is received. */
+        uint16_t usTopicLength;   /**< Length of the topic. */
+        const void * pvChunk;     /**< This part of the payload. Points into the data passed to MQTT_ParseReceivedData and is valid only during the callback. */
+        uint32_t ulChunkLength;   /**< Length of this part of the payload. */
+        uint32_t ulChunkOffset;   /**< Offset of this part within the payload. */
+        uint32_t ulDataLength;    /**< Length of the whole payload. */
+    } MQTTPublishChunkData_t;
+
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
 /**
  * @brief The data sent by the MQTT library in the user supplied callback
  * when an operation times out.
@@ -266,6 +297,9 @@ typedef struct MQTTPublishData
 typedef struct MQTTTimeoutData
 {
     uint16_t usPacketIdentifier; /**< Packet identifier which the user can use to identify which operation timed out. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        const void * pvData;     /**< The payload passed to MQTT_PublishZeroCopy which is no longer referenced by the library, NULL for any other operation. */
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
 } MQTTTimeoutData_t;
 
 /**
@@ -293,6 +327,9 @@ typedef struct MQTTCallbackParams
         MQTTUnSubACKData_t xMQTTUnSubACKData; /**< UNSUBACK data. */
         MQTTPubACKData_t xMQTTPubACKData;     /**< PUBACK data. */
         MQTTPublishData_t xPublishData;       /**< Publish data. */
+        #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+            MQTTPublishChunkData_t xPublishChunkData; /**< Streamed publish payload data. */
+        #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
         MQTTTimeoutData_t xTimeoutData;       /**< Timeout data. */
         MQTTDisconnectData_t xDisconnectData; /**< Disconnect data. */
     } u;
@@ -369,6 +406,42 @@ typedef uint32_t ( * MQTTSend_t ) ( void * pvSendContext,
                                     const uint8_t * const pucData,
                                     uint32_t ulDataLength );
 
+/**
+ * @brief One of the pieces of data transmitted using the vectored send callback.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+    typedef struct MQTTSendVector
+    {
+        const uint8_t * pucData; /**< The data to transmit. */
+        uint32_t ulDataLength;   /**< The length of the data. */
+    } MQTTSendVector_t;
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+/**
+ * @brief Signature of the optional user supplied callback to transmit data
+ * scattered over multiple memory regions.
+ *
+ * The library uses this callback, if registered, to transmit the packet header
+ * and the user payload of a zero-copy publish in one call so that the transport
+ * can coalesce them (for example into one TLS record). The pieces must be
+ * transmitted in the order in which they appear in the array.
+ *
+ * @param[in] pvSendContext The send context as supplied by the user in Init parameters.
+ * @param[in] pxVectors The pieces of data to transmit.
+ * @param[in] ulVectorCount The number of entries in pxVectors.
+ *
+ * @return The total number of bytes actually transmitted.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+    typedef uint32_t ( * MQTTSendv_t ) ( void * pvSendContext,
+                                         const MQTTSendVector_t * const pxVectors,
+                                         uint32_t ulVectorCount );
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
 /**
  * @brief Signature of the callback to get the current tick count.
  *
@@ -423,10 +496,71 @@ typedef void ( * MQTTReturnBuffer_t ) ( uint8_t * pucBuffer );
         MQTTPublishCallback_t pxPublishCallback;                                  /**< The callback associated with this subscription. */
         MQTTBool_t xInUse;                                                        /**< Tracks whether the subscription entry is in-use. */
         MQTTTopicFilterType_t xTopicFilterType;                                   /**< The type of the topic filter. */
+        #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+            uint16_t usIndexNode;                                                 /**< The topic index node this subscription entry is attached to. */
+            uint16_t usNextSubscription;                                          /**< The next subscription entry attached to the same topic index node. */
+        #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
     } MQTTSubscription_t;
 
 #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
 
+/**
+ * @brief Represents one topic level in the topic index.
+ *
+ * A node does not store the text of the topic level but only its hash and
+ * length. Two different levels which collide are therefore stored in the
+ * same node and every subscription found through the index is matched against
+ * the topic before its callback is invoked.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    typedef struct MQTTTopicIndexNode
+    {
+        uint32_t ulLevelHash;               /**< The hash of the topic level this node represents. */
+        uint16_t usLevelLength;             /**< The length of the topic level this node represents. */
+        uint16_t usParent;                  /**< The parent node. */
+        uint16_t usNext;                    /**< The next node in the same hash bucket, or in the free list if the node is not in use. */
+        uint16_t usPlusChild;               /**< The child node for the single-level wild-card '+'. */
+        uint16_t usSubscriptions;           /**< The subscription entries whose topic filter ends at this node. */
+        uint16_t usMultiLevelSubscriptions; /**< The subscription entries whose topic filter ends with '#' after this node. */
+        uint16_t usReferenceCount;          /**< The number of stored topic filters which pass through this node. */
+    } MQTTTopicIndexNode_t;
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Used to walk the topic index while matching a topic.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    typedef struct MQTTTopicIndexCursor
+    {
+        uint32_t ulTopicOffset; /**< The offset of the next topic level to match, or one past the topic length if all the levels are matched. */
+        uint16_t usNode;        /**< The node which matched the topic so far. */
+    } MQTTTopicIndexCursor_t;
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief The trie of topic levels used to index the subscription manager.
+ *
+ * The child nodes reached through a regular topic level are found through a
+ * hash table keyed on the parent node and the level hash, so the lookup cost
+ * does not grow with the number of children.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    typedef struct MQTTTopicIndex
+    {
+        MQTTTopicIndexNode_t xNodes[ mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES ];      /**< The node pool. The first node is the root. */
+        uint16_t usBuckets[ mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_BUCKETS ];             /**< The heads of the hash buckets. */
+        MQTTTopicIndexCursor_t xCursors[ mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES ]; /**< The stack used while matching a topic. */
+        uint16_t usFreeNodes;                                                                 /**< The head of the free node list. */
+        uint16_t usFreeNodeCount;                                                             /**< The number of nodes in the free node list. */
+    } MQTTTopicIndex_t;
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
 /**
  * @brief The subscription manager used to keep track of user subscriptions
  * and topic specific callbacks.
@@ -437,6 +571,9 @@ typedef void ( * MQTTReturnBuffer_t ) ( uint8_t * pucBuffer );
     {
         MQTTSubscription_t xSubscriptions[ mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS ]; /**< User subscriptions. */
         uint32_t ulInUseSubscriptions;                                                         /**< Number of subscription entries currently in use. */
+        #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+            MQTTTopicIndex_t xTopicIndex;                                                      /**< The topic trie used to find the subscriptions matching a topic. */
+        #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
     } MQTTSubscriptionManager_t;
 
 #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
@@ -462,6 +599,10 @@ typedef struct MQTTRxMessageState
     MQTTRxMessageAction_t xRxMessageAction; /**< Whether the current Rx message is being stored or dropped. Valid only after the fixed header has been received i.e. xRxNextByte is eMQTTRxNextByteMessage. @see MQTTRxMessageAction_t. */
     uint8_t ucRemaingingLengthFieldBytes;   /**< The number of bytes the "Remaining Length" field spans. Valid only after the fixed header has been received i.e. xRxNextByte is eMQTTRxNextByteMessage. */
     uint32_t ulTotalMessageLength;          /**< The total length of the message. Valid only after the fixed header has been received i.e. xRxNextByte is eMQTTRxNextByteMessage. */
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        uint16_t usStreamTopicLength;       /**< The topic length of the publish message being streamed. Valid only if xRxMessageAction is eMQTTRxMessageStream. */
+        uint32_t ulStreamHeaderLength;      /**< The length of the part of the publish message being streamed which precedes the payload. Zero until the topic length has been received. */
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 } MQTTRxMessageState_t;
 
 /**
@@ -481,6 +622,9 @@ typedef struct MQTTContext
     MQTTEventCallback_t pxCallback;                             /**< Callback supplied  by the user to get notified of various events. */
     void * pvSendContext;                                       /**< As supplied by the user in Init parameters. */
     MQTTSend_t pxMQTTSendFxn;                                   /**< Callback supplied by the user to transmit data. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        MQTTSendv_t pxMQTTSendvFxn;                             /**< Optional callback supplied by the user to transmit scattered data. */
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
     MQTTGetTicks_t pxGetTicksFxn;                               /**< Callback supplied by the user to get current tick count. */
     MQTTBufferPoolInterface_t xBufferPoolInterface;             /**< The buffer pool interface supplied by the user. @see MQTTBufferPoolInterface_t. */
     MQTTConnectionState_t xConnectionState;                     /**< The current connection state. */
@@ -505,6 +649,9 @@ typedef struct MQTTInitParams
     MQTTEventCallback_t pxCallback;                 /**< User supplied callback to get notified of various events. Can be NULL. @see MQTTEventCallback_t.*/
     void * pvSendContext;                           /**< Passed as it is in the send callback. */
     MQTTSend_t pxMQTTSendFxn;                       /**< User supplied callback to transmit data. Must not be NULL. @see MQTTSend_t. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        MQTTSendv_t pxMQTTSendvFxn;                 /**< User supplied callback to transmit scattered data. Can be NULL, in which case pxMQTTSendFxn is called once per piece. @see MQTTSendv_t. */
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
     MQTTGetTicks_t pxGetTicksFxn;                   /**< User supplied callback to get the current tick count. Can be NULL. @see MQTTGetTicks_t. */
     MQTTBufferPoolInterface_t xBufferPoolInterface; /**< User supplied buffer pool interface. @see MQTTBufferPoolInterface_t. */
 } MQTTInitParams_t;
@@ -685,6 +832,32 @@ MQTTReturnCode_t MQTT_Unsubscribe( MQTTContext_t * pxMQTTContext,
 MQTTReturnCode_t MQTT_Publish( MQTTContext_t * pxMQTTContext,
                                const MQTTPublishParams_t * const pxPublishParams );
 
+/**
+ * @brief Initiates the Publish operation without copying the payload.
+ *
+ * Same as MQTT_Publish except that only the fixed header, the topic and the
+ * packet identifier are written to a buffer from the buffer pool. The payload
+ * (pvData in pxPublishParams) is transmitted in place, therefore its size is not
+ * limited by the size of the pool buffers.
+ *
+ * In QoS0 case, the payload is no longer referenced once this function returns.
+ * Otherwise, if this function returns eMQTTSuccess, the library keeps referencing
+ * the payload and the user must not modify or free it until the eMQTTPubACK or
+ * eMQTTTimeout event carrying it (in pvData) is received or the client is
+ * disconnected.
+ *
+ * @param[in] pxMQTTContext The initialized MQTT context.
+ * @param[in] pxPublishParams Publish parameters.
+ *
+ * @return eMQTTSuccess if everything succeeds, otherwise an error code explaining the reason of failure.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+    MQTTReturnCode_t MQTT_PublishZeroCopy( MQTTContext_t * pxMQTTContext,
+                                           const MQTTPublishParams_t * const pxPublishParams );
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
 /**
  * @brief Decodes the incoming messages.
  *
@@ -41,6 +41,11 @@
 /* Include for console serial output. */
 #include "aws_logging_task.h"
 
+/* Include for the stdio file handle used by the host simulator PALs. */
+#if WIN32 || defined( __linux__ )
+    #include <stdio.h>
+#endif
+
 /* Evaluates to the length of a constant string defined like 'static const char str[]= "xyz"; */
 #define CONST_STRLEN( s )    ( ( ( uint32_t ) sizeof( s ) ) - 1UL )
 
@@ -215,7 +220,7 @@ typedef struct {
 									
         int32_t     iFileHandle;        /*!< Device internal file pointer or handle.
 	                                     * File type is handle after file is open for write. */
-#if WIN32
+#if WIN32 || defined( __linux__ )
         FILE       *pstFile;            /*!< File type is stdio FILE structure after file is open for write. */
 #endif
 		uint8_t    *pucFile;            /*!< File type is RAM/Flash image pointer after file is open for write. */
@@ -233,6 +238,13 @@ typedef struct {
     uint8_t        *pacCertFilepath;    /*!< Pathname of the certificate file used to validate the receive file. */
     uint32_t        ulUpdaterVersion;   /*!< Used by OTA self-test detection, the version of FW that did the update. */
     bool_t          bIsInSelfTest;      /*!< True if the job is in self test mode. */
+    void           *pvSigVerifyContext; /*!< Signature check in progress while the file is received, or NULL. */
+    uint32_t        ulSigVerifiedSize;  /*!< Number of bytes from the start of the file included in the signature check. */
+    uint32_t        ulRequestWindow;    /*!< Max number of requested blocks not received yet (windowed requests only). */
+    uint32_t        ulRequestWindowThreshold; /*!< The window grows by one block per received block below this size. */
+    uint32_t        ulWindowProgress;   /*!< Blocks received since the window last grew (windowed requests only). */
+    uint32_t        ulBlocksInFlight;   /*!< Number of requested blocks not received yet (windowed requests only). */
+    uint32_t        ulNextBlockToRequest; /*!< Index of the block where the next windowed request starts looking for missing blocks. */
 
 } OTA_FileContext_t;
 
@@ -404,5 +416,52 @@ uint32_t OTA_GetPacketsProcessed( void );
  */
 uint32_t OTA_GetPacketsDropped( void );
 
+/**
+ * @brief Get the number of Get Stream requests published by the OTA agent.
+ *
+ * @note Calling OTA_AgentInit() will reset this statistic.
+ *
+ * @return The number of requests for file blocks sent to the stream service.
+ */
+uint32_t OTA_GetStreamRequests( void );
+
+/**
+ * @brief Get the number of file blocks requested by the OTA agent.
+ *
+ * @note Calling OTA_AgentInit() will reset this statistic.
+ *
+ * @return The total number of blocks asked for in all Get Stream requests.
+ * Comparing it with the number of packets processed shows how many blocks
+ * had to be requested again.
+ */
+uint32_t OTA_GetBlocksRequested( void );
+
+/**
+ * @brief Get the number of duplicate file blocks received by the OTA agent.
+ *
+ * @note Calling OTA_AgentInit() will reset this statistic.
+ *
+ * @return The number of blocks that were received more than once.
+ */
+uint32_t OTA_GetDuplicateBlocks( void );
+
+/**
+ * @brief Get the number of times the OTA agent's file request timer expired.
+ *
+ * @note Calling OTA_AgentInit() will reset this statistic.
+ *
+ * @return The number of times no block was received for otaconfigFILE_REQUEST_WAIT_MS
+ * while a file was being received.
+ */
+uint32_t OTA_GetRequestTimeouts( void );
+
+/**
+ * @brief Get the current block request window of the OTA agent.
+ *
+ * @return The maximum number of requested blocks that may be outstanding, or
+ * 0 if windowed requests are disabled (otaconfigREQUEST_WINDOW_MAX_BLOCKS is 0).
+ */
+uint32_t OTA_GetRequestWindow( void );
+
 /* _AWS_OTA_AGENT_H_ */
 #endif
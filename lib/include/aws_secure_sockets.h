@@ -189,6 +189,15 @@ typedef struct SocketsSockaddr
     uint32_t ulAddress;     /**< IP Address. Convention is to call this sin_addr. */
 } SocketsSockaddr_t;
 
+/**
+ * @brief One of the pieces of data transmitted by SOCKETS_Sendv().
+ */
+typedef struct SocketsIOVector
+{
+    const void * pvBuffer; /**< The data to be sent. */
+    size_t xDataLength;    /**< The length of the data to be sent. */
+} SocketsIOVector_t;
+
 /**
  * @brief Well-known port numbers.
  */
@@ -293,6 +302,8 @@ int32_t SOCKETS_Recv( Socket_t xSocket,
  *
  * @return
  * * On success, the number of bytes actually sent is returned.
+ * * If the socket cannot accept any data before the send timeout expires (immediately
+ *   for a non-blocking socket) then SOCKETS_EWOULDBLOCK is returned.
  * * If an error occurred, a negative value is returned. @ref SocketsErrors
  */
 int32_t SOCKETS_Send( Socket_t xSocket,
@@ -300,6 +311,33 @@ int32_t SOCKETS_Send( Socket_t xSocket,
                       size_t xDataLength,
                       uint32_t ulFlags );
 
+/**
+ * @brief Transmit data scattered over multiple buffers to the remote socket.
+ *
+ * Same as SOCKETS_Send() except that the data is taken from the pieces in
+ * pxVectors, in order, so that the caller does not have to copy them into a
+ * single buffer first. The pieces are transmitted as one stream: a piece is only
+ * started once the previous one has been sent completely.
+ *
+ * @param[in] xSocket The handle of the sending socket.
+ * @param[in] pxVectors The pieces of data to be sent.
+ * @param[in] xVectorCount The number of entries in pxVectors.
+ * @param[in] ulFlags Not currently used. Should be set to 0.
+ *
+ * @return
+ * * On success, the total number of bytes actually sent is returned. This is
+ *   less than the sum of the piece lengths if the socket could not accept all
+ *   of the data.
+ * * If the socket cannot accept any data before the send timeout expires (immediately
+ *   for a non-blocking socket) then SOCKETS_EWOULDBLOCK is returned.
+ * * If an error occurred before any data was sent, a negative value is returned.
+ *   @ref SocketsErrors
+ */
+int32_t SOCKETS_Sendv( Socket_t xSocket,
+                       const SocketsIOVector_t * pxVectors,
+                       size_t xVectorCount,
+                       uint32_t ulFlags );
+
 /**
  * @brief Closes all or part of a full-duplex connection on the socket.
  *
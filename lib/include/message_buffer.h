@@ -776,6 +776,69 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferAcquireWrite( MessageBufferHandle_t xMessageBuffer,
+                                   StreamBufferSpans_t * const pxSpans,
+                                   size_t xMessageLength,
+                                   TickType_t xTicksToWait );
+size_t xMessageBufferAcquireWriteFromISR( MessageBufferHandle_t xMessageBuffer,
+                                          StreamBufferSpans_t * const pxSpans,
+                                          size_t xMessageLength );
+size_t xMessageBufferCommitWrite( MessageBufferHandle_t xMessageBuffer, size_t xMessageLength );
+size_t xMessageBufferCommitWriteFromISR( MessageBufferHandle_t xMessageBuffer,
+                                         size_t xMessageLength,
+                                         BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero copy writes.  xMessageBufferAcquireWrite() reserves space for a message
+ * of up to xMessageLength bytes (plus the bytes used to store its length), and
+ * returns xMessageLength, or 0 if there is not enough space.  The message is
+ * then written in place to the one or two spans set in *pxSpans, and made
+ * available to the reader by xMessageBufferCommitWrite(), which is passed the
+ * actual length of the message.  See xStreamBufferAcquireWrite() and
+ * xStreamBufferCommitWrite() in stream_buffer.h.
+ *
+ * \defgroup xMessageBufferAcquireWrite xMessageBufferAcquireWrite
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferAcquireWrite( xMessageBuffer, pxSpans, xMessageLength, xTicksToWait ) xStreamBufferAcquireWrite( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans, xMessageLength, xTicksToWait )
+#define xMessageBufferAcquireWriteFromISR( xMessageBuffer, pxSpans, xMessageLength ) xStreamBufferAcquireWriteFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans, xMessageLength )
+#define xMessageBufferCommitWrite( xMessageBuffer, xMessageLength ) xStreamBufferCommitWrite( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength )
+#define xMessageBufferCommitWriteFromISR( xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken ) xStreamBufferCommitWriteFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferPeekRead( MessageBufferHandle_t xMessageBuffer,
+                               StreamBufferSpans_t * const pxSpans,
+                               TickType_t xTicksToWait );
+size_t xMessageBufferPeekReadFromISR( MessageBufferHandle_t xMessageBuffer,
+                                      StreamBufferSpans_t * const pxSpans );
+size_t xMessageBufferConsumeRead( MessageBufferHandle_t xMessageBuffer, size_t xMessageLength );
+size_t xMessageBufferConsumeReadFromISR( MessageBufferHandle_t xMessageBuffer,
+                                         size_t xMessageLength,
+                                         BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero copy reads.  xMessageBufferPeekRead() sets *pxSpans to the one or two
+ * spans that hold the next message and returns its length, or 0 if the message
+ * buffer is empty.  The message stays in the message buffer until it is
+ * removed by xMessageBufferConsumeRead(), which must be passed the length
+ * returned by the peek.  See xStreamBufferPeekRead() and
+ * xStreamBufferConsumeRead() in stream_buffer.h.
+ *
+ * \defgroup xMessageBufferPeekRead xMessageBufferPeekRead
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferPeekRead( xMessageBuffer, pxSpans, xTicksToWait ) xStreamBufferPeekRead( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans, xTicksToWait )
+#define xMessageBufferPeekReadFromISR( xMessageBuffer, pxSpans ) xStreamBufferPeekReadFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans )
+#define xMessageBufferConsumeRead( xMessageBuffer, xMessageLength ) xStreamBufferConsumeRead( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength )
+#define xMessageBufferConsumeReadFromISR( xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken ) xStreamBufferConsumeReadFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken )
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
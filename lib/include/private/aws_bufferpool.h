@@ -70,4 +70,31 @@ uint8_t * BUFFERPOOL_GetFreeBuffer( uint32_t * pulBufferLength );
  */
 void BUFFERPOOL_ReturnBuffer( uint8_t * const pucBuffer );
 
+/**
+ * @brief Usage statistics of one buffer size class.
+ */
+typedef struct BufferPoolStats
+{
+    uint32_t ulBufferSize;     /**< The size of each buffer in the class. */
+    uint32_t ulNumBuffers;     /**< The number of buffers in the class. */
+    uint32_t ulInUse;          /**< The number of buffers currently in use. */
+    uint32_t ulHighWaterMark;  /**< The maximum number of buffers which were in use at the same time. */
+    uint32_t ulFailedRequests; /**< The number of requests which could not be served because the class (and all the larger ones) had no free buffer. */
+} BufferPoolStats_t;
+
+/**
+ * @brief Gets the usage statistics of one size class of the buffer pool.
+ *
+ * Size classes are numbered from zero in the increasing order of buffer
+ * size. The statistics are a snapshot and can be out of date as soon as
+ * this function returns if other tasks are using the buffer pool.
+ *
+ * @param[in] ulSizeClass The size class to get the statistics of.
+ * @param[out] pxStats The statistics.
+ *
+ * @return pdPASS if the size class exists, pdFAIL otherwise.
+ */
+BaseType_t BUFFERPOOL_GetStats( uint32_t ulSizeClass,
+                                BufferPoolStats_t * const pxStats );
+
 #endif /* _AWS_BUFFER_POOL_H_ */
@@ -134,6 +134,29 @@
     #define mqttconfigMAX_PARALLEL_OPS    ( 5 )
 #endif
 
+/**
+ * @brief Maximum number of messages which can be published with one call to
+ * MQTT_AGENT_PublishBatch.
+ *
+ * Each message of a batch uses its own packet identifier while the batch takes
+ * up only one of the mqttconfigMAX_PARALLEL_OPS operations.
+ */
+#ifndef mqttconfigMAX_PUBLISH_BATCH_SIZE
+    #define mqttconfigMAX_PUBLISH_BATCH_SIZE    ( 16 )
+#endif
+
+/**
+ * @brief Maximum number of publishes started with MQTT_AGENT_PublishAsync which
+ * can be in flight per client.
+ *
+ * Every QoS1 message in flight holds a buffer from the buffer pool until its
+ * PUBACK is received, so the buffer pool must be sized accordingly. If set to 0,
+ * MQTT_AGENT_PublishAsync is not available.
+ */
+#ifndef mqttconfigMAX_ASYNC_PUBLISHES
+    #define mqttconfigMAX_ASYNC_PUBLISHES    ( 0 )
+#endif
+
 /**
  * @brief Time in milliseconds after which the TCP send operation should timeout.
  */
@@ -148,6 +171,21 @@
     #define mqttconfigRX_BUFFER_SIZE    ( 1024 )
 #endif
 
+/**
+ * @brief Length of the per-connection buffer holding outgoing bytes which the
+ * socket could not accept yet.
+ *
+ * If set to 0, the MQTT task waits for the socket to accept every packet in full,
+ * for up to mqttconfigTCP_SEND_TIMEOUT_MS, before it can process anything else.
+ * Otherwise the bytes which the socket cannot accept are queued in this buffer and
+ * sent when the socket wakes up the MQTT task, so that the MQTT task only waits
+ * when the buffer is full as well, and the packets queued meanwhile are sent
+ * together. Packets larger than the buffer are queued piecewise as it drains.
+ */
+#ifndef mqttconfigTX_BUFFER_SIZE
+    #define mqttconfigTX_BUFFER_SIZE    ( 0 )
+#endif
+
 /**
  * @defgroup BufferPoolInterface The functions used by the MQTT client to get and return buffers.
  *
@@ -63,6 +63,9 @@ typedef struct MQTTBufferState
     uint64_t xRecordedTickCount; /**< The time-stamp when this packet was sent. */
     uint32_t ulTimeoutTicks;     /**< The time interval after which this packet should timeout i.e. stop waiting for ACK. */
     uint16_t usPacketIdentifier; /**< Packet identifier sent with this packet. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        const void * pvPayload;  /**< The user payload referenced by a zero-copy publish packet, NULL otherwise. */
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
 } MQTTBufferState_t;
 
 /**
@@ -172,6 +175,16 @@ typedef struct MQTTBufferMetadata
  */
 #define mqttbufferGET_PACKET_TIMEOUT_TICKS( xBufferHandle )          ( ( ( MQTTBufferMetadata_t * ) ( xBufferHandle ) )->xBufferState.ulTimeoutTicks )
 
+/**
+ * @brief Given the buffer handle, extracts the user payload referenced by a
+ * zero-copy publish packet from the metadata portion of the buffer.
+ *
+ * @param[in] xBufferHandle The given buffer handle.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+    #define mqttbufferGET_PACKET_PAYLOAD( xBufferHandle )            ( ( ( MQTTBufferMetadata_t * ) ( xBufferHandle ) )->xBufferState.pvPayload )
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
 /**
  * @brief Given a list head and a buffer handle, adds the buffer to the given
  * list.
@@ -196,13 +209,24 @@ typedef struct MQTTBufferMetadata
  * @param[in] pucBuffer The given buffer.
  * @param[in] ulLength The length of the given buffer.
  */
-#define mqttbufferINIT_BUFFER( pucBuffer, ulLength )                                 \
-    {                                                                                \
-        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xLink.pxPrev = NULL;           \
-        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xLink.pxNext = NULL;           \
-        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->ulBufferLength = ( ulLength ); \
-        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->ulDataLength = 0;              \
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+    #define mqttbufferINIT_BUFFER( pucBuffer, ulLength )                                 \
+    {                                                                                    \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xLink.pxPrev = NULL;               \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xLink.pxNext = NULL;               \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->ulBufferLength = ( ulLength );     \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->ulDataLength = 0;                  \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xBufferState.pvPayload = NULL;     \
+    }
+#else
+    #define mqttbufferINIT_BUFFER( pucBuffer, ulLength )                                 \
+    {                                                                                    \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xLink.pxPrev = NULL;               \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->xLink.pxNext = NULL;               \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->ulBufferLength = ( ulLength );     \
+        ( ( MQTTBufferMetadata_t * ) ( pucBuffer ) )->ulDataLength = 0;                  \
     }
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
 
 /**
  * @brief Removes the first node from the given list.
@@ -73,6 +73,76 @@
     #define mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS    ( 8 )
 #endif
 
+/**
+ * @brief Index the subscription manager with a per-level topic trie.
+ *
+ * By default every received publish message is matched against every entry
+ * in the subscription manager, which costs O(number of subscriptions x topic
+ * length) per message. If this macro is set to 1, the topic filters are also
+ * stored in a trie keyed on topic levels so that only the subscriptions along
+ * the matching paths are examined. This is worthwhile when a large number of
+ * subscriptions is configured (see mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS)
+ * at the cost of the additional RAM needed for the trie nodes.
+ */
+#ifndef mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX
+    #define mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX    ( 0 )
+#endif
+
+/**
+ * @brief Number of nodes in the topic trie.
+ *
+ * Only used if mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX is set to 1. One
+ * node is needed for the root and one for every distinct topic level prefix
+ * among the stored topic filters ('#' levels do not need a node). Subscribe
+ * fails with eMQTTSubscriptionManagerFull if no nodes are left to store a
+ * new topic filter. Must be less than 65535.
+ */
+#ifndef mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES
+    #define mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES    ( mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS * 4 )
+#endif
+
+/**
+ * @brief Number of hash buckets used to look up the child nodes in the topic
+ * trie.
+ *
+ * Only used if mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX is set to 1.
+ */
+#ifndef mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_BUCKETS
+    #define mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_BUCKETS    ( mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS )
+#endif
+
+/**
+ * @brief Enable the zero-copy publish API.
+ *
+ * If this macro is set to 1, MQTT_PublishZeroCopy is available. It stores only
+ * the fixed header, the topic and the packet identifier in a buffer from the
+ * buffer pool and transmits the user supplied payload in place, either through
+ * the optional vectored send callback (pxMQTTSendvFxn in MQTTInitParams_t) or
+ * through two calls to the regular send callback. This avoids copying large
+ * payloads and allows publishing payloads bigger than a pool buffer.
+ */
+#ifndef mqttconfigENABLE_ZERO_COPY_PUBLISH
+    #define mqttconfigENABLE_ZERO_COPY_PUBLISH    ( 0 )
+#endif
+
+/**
+ * @brief Enable streaming delivery of received publish messages.
+ *
+ * By default a received publish message is stored in one buffer from the
+ * buffer pool and dropped (eMQTTPacketDropped) if no buffer is large enough.
+ * If this macro is set to 1, a publish message which does not fit in a pool
+ * buffer is streamed instead. Only the fixed header, the topic and the
+ * packet identifier are stored in a pool buffer. The user is first notified
+ * with an eMQTTPublishStreamHeader event and the payload is then reported in
+ * one or more eMQTTPublishStreamChunk events pointing directly into the data
+ * passed to MQTT_ParseReceivedData. This allows receiving messages of any
+ * size with constant memory. Streamed messages are always reported to the
+ * generic callback and never to the subscription specific callbacks.
+ */
+#ifndef mqttconfigENABLE_STREAMING_PUBLISH
+    #define mqttconfigENABLE_STREAMING_PUBLISH    ( 0 )
+#endif
+
 /**
  * @brief Define mqttconfigASSERT to enable asserts.
  *
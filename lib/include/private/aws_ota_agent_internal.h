@@ -39,6 +39,26 @@
 #define BITS_PER_BYTE           ( 1UL << LOG2_BITS_PER_BYTE )   /* Number of bits in a byte. This is used by the block bitmap implementation. */
 #define OTA_FILE_BLOCK_SIZE     ( 1UL << otaconfigLOG2_FILE_BLOCK_SIZE ) /* Data section size of the file data block message (excludes the header). */
 
+/* Set otaconfigINCREMENTAL_SIGNATURE_CHECK to 1 to include the file blocks in the signature
+ * check as they are received instead of reading the whole file back when it is closed. This
+ * requires the PAL to implement prvPAL_UpdateFileSignature(). */
+#ifndef otaconfigINCREMENTAL_SIGNATURE_CHECK
+    #define otaconfigINCREMENTAL_SIGNATURE_CHECK    0
+#endif
+
+/* Set otaconfigREQUEST_WINDOW_MAX_BLOCKS to a non-zero value to request the file blocks in a
+ * sliding window instead of requesting all missing blocks at once. The window is the number of
+ * requested blocks that have not been received yet. It starts at otaconfigREQUEST_WINDOW_INITIAL_BLOCKS,
+ * grows while the requested blocks keep arriving and shrinks when the request timer expires or
+ * duplicate blocks are received. More blocks are requested when half of the window was received. */
+#ifndef otaconfigREQUEST_WINDOW_MAX_BLOCKS
+    #define otaconfigREQUEST_WINDOW_MAX_BLOCKS      0
+#endif
+
+#ifndef otaconfigREQUEST_WINDOW_INITIAL_BLOCKS
+    #define otaconfigREQUEST_WINDOW_INITIAL_BLOCKS  4
+#endif
+
 typedef enum
 {
     eIngest_Result_FileComplete = -1,      /* The file transfer is complete and the signature check passed. */
@@ -113,7 +133,7 @@ typedef struct
     const bool_t bRequired; /* If true, this parameter must exist in the document. */
     union
     {
-        const uint32_t ulDestOffset;        /* Pointer or offset to where we'll store the value, if not ~0. */
+        const size_t ulDestOffset;          /* Pointer or offset to where we'll store the value, if not ~0. */
         void * const pvDestOffset;          /* Pointer or offset to where we'll store the value, if not ~0. */
     };
     const ModelParamType_t xModelParamType; /* We extract the value, if found, based on this type. */
@@ -132,7 +152,7 @@ typedef struct
  */
 typedef struct
 {
-    uint32_t ulContextBase;            /* The base address of the destination OTA context structure. */
+    size_t ulContextBase;              /* The base address of the destination OTA context structure. */
     uint32_t ulContextSize;            /* The size, in bytes, of the destination context structure. */
     const JSON_DocParam_t * pxBodyDef; /* Pointer to the document model body definition. */
     uint16_t usNumModelParams;         /* The number of entries in the document model (limited to 32). */
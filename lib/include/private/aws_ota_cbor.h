@@ -38,6 +38,24 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage(
     uint8_t **ppucPayload,
     size_t *pxPayloadSize );
 
+/**
+ * @brief Decode a Get Stream response message from AWS IoT OTA without
+ * copying the payload.
+ *
+ * Unlike OTA_CBOR_Decode_GetStreamResponseMessage(), the payload is not
+ * copied to a buffer allocated from the heap. *ppucPayload points to the
+ * payload inside pucMessageBuffer, so it is only valid as long as the
+ * message buffer is.
+ */
+BaseType_t OTA_CBOR_Decode_GetStreamResponseMessageInPlace(
+    const uint8_t *pucMessageBuffer,
+    size_t xMessageSize,
+    int32_t *plFileId,
+    int32_t *plBlockId,
+    int32_t *plBlockSize,
+    const uint8_t **ppucPayload,
+    size_t *pxPayloadSize );
+
 /**
  * @brief Create an encoded Get Stream Request message for the AWS IoT OTA
  * service.
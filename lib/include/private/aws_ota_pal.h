@@ -106,6 +106,34 @@ OTA_Err_t prvPAL_CreateFileForRx( OTA_FileContext_t * const C );
  */
 OTA_Err_t prvPAL_CloseFile( OTA_FileContext_t * const C );
 
+/**
+ * @brief Include the next part of the receive file in the signature check.
+ * 
+ * Only called by the OTA agent if otaconfigINCREMENTAL_SIGNATURE_CHECK is set to 1 and
+ * C->pvSigVerifyContext is not NULL. The PAL starts the signature check in
+ * prvPAL_CreateFileForRx() and finishes it in prvPAL_CloseFile(), which then only has
+ * to hash the part of the file not covered yet.
+ * 
+ * The data covers the ulSize bytes of the file starting at offset C->ulSigVerifiedSize.
+ * If pcData is NULL, the data was written to the file earlier (the block was received
+ * out of order) and is read back from the file. C->ulSigVerifiedSize is advanced by
+ * the number of bytes included in the signature check.
+ * 
+ * If an error occurs, the signature check context is freed and C->pvSigVerifyContext
+ * is set to NULL so that prvPAL_CloseFile() checks the whole file instead.
+ * 
+ * @param[in] C OTA file context information.
+ * @param[in] pcData Pointer to the data or NULL to read it from the file.
+ * @param[in] ulSize The number of bytes to include in the signature check.
+ * 
+ * @return The OTA PAL layer error code combined with the MCU specific error code. See OTA Agent 
+ * error codes information in aws_ota_agent.h.
+ * 
+ * kOTA_Err_None is returned on success.
+ * kOTA_Err_OutOfMemory is returned if no buffer is available to read the file.
+ */
+OTA_Err_t prvPAL_UpdateFileSignature( OTA_FileContext_t * const C, const uint8_t * const pcData, uint32_t ulSize );
+
 /**
  * @brief Write a block of data to the specified file at the given offset.
  * 
@@ -88,7 +88,9 @@ only for ports that are using the MPU. */
 
 		/* Map standard queue.h API functions to the MPU equivalents. */
 		#define xQueueGenericSend						MPU_xQueueGenericSend
+		#define xQueueSendMultiple						MPU_xQueueSendMultiple
 		#define xQueueReceive							MPU_xQueueReceive
+		#define xQueueReceiveMultiple					MPU_xQueueReceiveMultiple
 		#define xQueuePeek								MPU_xQueuePeek
 		#define xQueueSemaphoreTake						MPU_xQueueSemaphoreTake
 		#define uxQueueMessagesWaiting					MPU_uxQueueMessagesWaiting
@@ -150,9 +152,28 @@ only for ports that are using the MPU. */
 		#define xStreamBufferSpacesAvailable			MPU_xStreamBufferSpacesAvailable
 		#define xStreamBufferBytesAvailable				MPU_xStreamBufferBytesAvailable
 		#define xStreamBufferSetTriggerLevel			MPU_xStreamBufferSetTriggerLevel
+		#define xStreamBufferAcquireWrite				MPU_xStreamBufferAcquireWrite
+		#define xStreamBufferAcquireWriteFromISR		MPU_xStreamBufferAcquireWriteFromISR
+		#define xStreamBufferCommitWrite				MPU_xStreamBufferCommitWrite
+		#define xStreamBufferCommitWriteFromISR			MPU_xStreamBufferCommitWriteFromISR
+		#define xStreamBufferPeekRead					MPU_xStreamBufferPeekRead
+		#define xStreamBufferPeekReadFromISR			MPU_xStreamBufferPeekReadFromISR
+		#define xStreamBufferConsumeRead				MPU_xStreamBufferConsumeRead
+		#define xStreamBufferConsumeReadFromISR			MPU_xStreamBufferConsumeReadFromISR
 		#define xStreamBufferGenericCreate				MPU_xStreamBufferGenericCreate
 		#define xStreamBufferGenericCreateStatic		MPU_xStreamBufferGenericCreateStatic
 
+		/* Map standard spsc_ring.h API functions to the MPU equivalents. */
+		#define xSPSCRingCreate							MPU_xSPSCRingCreate
+		#define xSPSCRingCreateStatic					MPU_xSPSCRingCreateStatic
+		#define vSPSCRingDelete							MPU_vSPSCRingDelete
+		#define vSPSCRingSetWakeUpCallback				MPU_vSPSCRingSetWakeUpCallback
+		#define xSPSCRingSend							MPU_xSPSCRingSend
+		#define xSPSCRingSendFromISR					MPU_xSPSCRingSendFromISR
+		#define xSPSCRingReceive						MPU_xSPSCRingReceive
+		#define xSPSCRingArmWakeUp						MPU_xSPSCRingArmWakeUp
+		#define xSPSCRingItemsAvailable					MPU_xSPSCRingItemsAvailable
+
 
 		/* Remove the privileged function macro, but keep the PRIVILEGED_DATA
 		macro so applications can place data in privileged access sections
@@ -102,7 +102,7 @@ extern "C" {
 	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
-/* Used by heap_5.c. */
+/* Used by heap_5.c and heap_6.c. */
 typedef struct HeapRegion
 {
 	uint8_t *pucStartAddress;
@@ -110,7 +110,8 @@ typedef struct HeapRegion
 } HeapRegion_t;
 
 /*
- * Used to define multiple heap regions for use by heap_5.c.  This function
+ * Used to define multiple heap regions for use by heap_5.c (and by heap_6.c
+ * when configHEAP_6_USE_HEAP_REGIONS is 1).  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
  * queue, semaphore, mutex, software timer, event group, etc. will result in
  * pvPortMalloc being called.
@@ -132,6 +133,101 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_HEAP_STATS_PER_TASK == 1 )
+
+	/* The number of block size classes counted for each task.  Class n counts
+	the blocks of up to ( 16 << n ) bytes, and the last class all the larger
+	blocks. */
+	#define portHEAP_STATS_HISTOGRAM_BUCKETS	( 8 )
+
+	/* The number of characters of the task name stored with the statistics. */
+	#define portHEAP_STATS_TASK_NAME_LEN		( 16 )
+
+	/* Heap usage of one task, as reported by vPortGetHeapStatsPerTask().  All
+	sizes are block sizes, so include the heap's own header of each block. */
+	typedef struct xHEAP_TASK_STATS
+	{
+		void *pvTask;										/* The handle of the task, or NULL for the memory allocated before the scheduler was started (or by tasks that did not fit in the statistics table). */
+		char pcTaskName[ portHEAP_STATS_TASK_NAME_LEN ];	/* The name of the task when it first allocated memory. */
+		BaseType_t xTaskDeleted;							/* pdTRUE if the task has been deleted.  Its memory that has not been freed yet is still counted. */
+		size_t xCurrentBytes;								/* The number of bytes the task currently has allocated. */
+		size_t xPeakBytes;									/* The maximum value xCurrentBytes has had. */
+		uint32_t ulAllocations;								/* The number of successful calls to pvPortMalloc(). */
+		uint32_t ulFrees;									/* The number of blocks allocated by the task that have been freed, by any task. */
+		uint32_t ulFailedAllocations;						/* The number of calls to pvPortMalloc() that returned NULL. */
+		uint32_t ulSizeHistogram[ portHEAP_STATS_HISTOGRAM_BUCKETS ];	/* The number of successful allocations in each block size class. */
+	} HeapTaskStats_t;
+
+	/*
+	 * Copies the heap usage of every task that has allocated memory into
+	 * pxTaskStats.  *puxArraySize is the number of entries pxTaskStats can hold
+	 * on entry, and is set to the number of entries written.  At most
+	 * configHEAP_STATS_MAX_TASKS entries are reported.  The entries are in
+	 * the order the tasks first allocated memory, and the index of an entry is
+	 * the owner recorded in the heap trace.  Entry 0 is always reported.  Only
+	 * heap_4.c, heap_5.c and heap_6.c keep the statistics.
+	 */
+	void vPortGetHeapStatsPerTask( HeapTaskStats_t *pxTaskStats, UBaseType_t *puxArraySize ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the kernel when a task is deleted, through traceTASK_DELETE(),
+	 * so the statistics entry of the task can be reused once all its memory
+	 * has been freed.  An application that defines its own traceTASK_DELETE()
+	 * must call it from there.
+	 */
+	void vPortHeapStatsTaskDeleted( void *pvTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_STATS_PER_TASK */
+
+#if( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+
+	/* Identifies a heap trace buffer, and the version of its layout. */
+	#define portHEAP_TRACE_MAGIC			( 0x43525448UL )	/* "HTRC" in little endian. */
+	#define portHEAP_TRACE_VERSION			( 1U )
+
+	/* The types of the events recorded in the trace. */
+	#define portHEAP_TRACE_EVENT_MALLOC		( 1U )
+	#define portHEAP_TRACE_EVENT_FREE		( 2U )
+	#define portHEAP_TRACE_EVENT_FAILED		( 3U )
+
+	/* The owner recorded when configUSE_HEAP_STATS_PER_TASK is 0. */
+	#define portHEAP_TRACE_NO_OWNER			( 0xffffU )
+
+	/* One event of the heap trace.  The layout does not depend on the size of
+	a pointer so the trace can be decoded without knowing the target. */
+	typedef struct xHEAP_TRACE_EVENT
+	{
+		uint32_t ulTimestamp;	/* The tick count when the event happened. */
+		uint32_t ulAddress;		/* The least significant 32 bits of the address returned by pvPortMalloc(), or 0 for a failed allocation. */
+		uint32_t ulSize;		/* The size of the block including its header, also for a failed allocation. */
+		uint16_t usOwner;		/* The index, in the array filled by vPortGetHeapStatsPerTask(), of the task that allocated the block. */
+		uint16_t usEvent;		/* One of the portHEAP_TRACE_EVENT_ values. */
+	} HeapTraceEvent_t;
+
+	/* The heap trace ring buffer.  ulEventsWritten counts all the events ever
+	recorded, so once it exceeds ulLength the oldest event is at index
+	( ulEventsWritten % ulLength ), otherwise it is at index 0. */
+	typedef struct xHEAP_TRACE_BUFFER
+	{
+		uint32_t ulMagic;
+		uint16_t usVersion;
+		uint16_t usEventSize;
+		uint32_t ulLength;
+		volatile uint32_t ulEventsWritten;
+		HeapTraceEvent_t xEvents[ configHEAP_TRACE_BUFFER_LENGTH ];
+	} HeapTraceBuffer_t;
+
+	/*
+	 * Returns the ring buffer in which heap_4.c, heap_5.c and heap_6.c record
+	 * the last configHEAP_TRACE_BUFFER_LENGTH allocations and frees, and sets
+	 * *pxBufferSize to its size in bytes.  The buffer can be copied to a host
+	 * and decoded with tools/heap_trace/heap_trace_decode.py.  Suspend the
+	 * scheduler while copying it to get a consistent snapshot.
+	 */
+	const HeapTraceBuffer_t *pxPortGetHeapTraceBuffer( size_t *pxBufferSize ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_TRACE_BUFFER_LENGTH */
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -647,6 +647,73 @@ typedef void * QueueSetMemberHandle_t;
  */
 BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultiple(
+								 QueueHandle_t xQueue,
+								 const void *pvItems,
+								 UBaseType_t uxItemCount,
+								 TickType_t xTicksToWait
+							);</pre>
+ *
+ * Post up to uxItemCount items to the back of a queue.  The items are queued
+ * by copy from consecutive elements of pvItems, in order.
+ *
+ * As many of the items as there is space for are posted in a single critical
+ * section, and the tasks blocked on receiving from the queue are unblocked
+ * once for the whole batch rather than once per item.  This makes it a faster
+ * way than repeated calls to xQueueSendToBack() to post bursts of small items.
+ *
+ * This function must not be used in an interrupt service routine, nor on a
+ * semaphore or a mutex.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the first of the items to be placed on the
+ * queue.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.  The function does not wait for more space once at least one item
+ * has been posted, so the caller must check the return value and post the
+ * remaining items again if required.  The time is defined in tick periods so
+ * the constant portTICK_PERIOD_MS should be used to convert to real time if
+ * this is required.
+ *
+ * @return The number of items posted, from the start of pvItems, which is 0
+ * if the queue remained full for xTicksToWait ticks.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( uint32_t *pulValues, UBaseType_t uxCount )
+ {
+ UBaseType_t uxSent;
+
+	// Post all the values, blocking for up to 10 ticks each time the queue
+	// is full.
+	while( uxCount > 0 )
+	{
+		uxSent = xQueueSendMultiple( xQueue, pulValues, uxCount, ( TickType_t ) 10 );
+
+		if( uxSent == 0 )
+		{
+			// Timed out with the queue still full.
+			break;
+		}
+
+		pulValues += uxSent;
+		uxCount -= uxSent;
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>
@@ -865,6 +932,72 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue, void * const pvBuffer ) PRIV
  */
 BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultiple(
+								 QueueHandle_t xQueue,
+								 void *pvBuffer,
+								 UBaseType_t uxMaxItems,
+								 TickType_t xTicksToWait
+							);</pre>
+ *
+ * Receive up to uxMaxItems items from a queue.  The items are received by copy
+ * into consecutive elements of the buffer, oldest first, so the buffer must be
+ * at least uxMaxItems times the item size defined when the queue was created.
+ *
+ * All the items available at the time of the call, up to uxMaxItems, are
+ * removed in a single critical section, and the tasks blocked on sending to
+ * the queue are unblocked once for the whole batch rather than once per item.
+ * This makes it a faster way than repeated calls to xQueueReceive() for a
+ * task to drain a queue to which bursts of small items are posted.
+ *
+ * This function must not be used in an interrupt service routine, nor on a
+ * semaphore or a mutex.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will
+ * be copied.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of
+ * the call.  The function does not wait for more items once at least one
+ * item is available.  The time is defined in tick periods so the constant
+ * portTICK_PERIOD_MS should be used to convert to real time if this is
+ * required.
+ *
+ * @return The number of items received, which is 0 if the queue remained
+ * empty for xTicksToWait ticks.
+ *
+ * Example usage:
+   <pre>
+ void vAGatekeeperTask( void *pvParameters )
+ {
+ uint32_t ulValues[ 8 ];
+ UBaseType_t uxCount, x;
+
+	for( ;; )
+	{
+		// Wait for at least one value, then process everything that was
+		// queued in the meantime.
+		uxCount = xQueueReceiveMultiple( xQueue, ulValues, 8, portMAX_DELAY );
+
+		for( x = 0; x < uxCount; x++ )
+		{
+			vProcessValue( ulValues[ x ] );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue );</pre>
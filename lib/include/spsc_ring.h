@@ -0,0 +1,340 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * SPSC rings pass pointers from one task or interrupt (the producer) to one
+ * other task (the consumer), typically network buffers from a driver to the
+ * task that processes them.  Sending and receiving an item only reads and
+ * writes the ring's indexes - neither the scheduler is suspended nor are
+ * interrupts masked - so a ring is cheaper than a queue when items are passed
+ * at a high rate.
+ *
+ * ***NOTE***:  Like stream buffers, SPSC rings assume there is only one
+ * producer and only one consumer.  Unlike stream buffers, it is not safe to
+ * make the calls of several producers, or of several consumers, mutually
+ * exclusive by placing them in a critical section, because a ring's indexes
+ * are also read by the other side outside of any critical section.
+ *
+ * A task that blocks to wait for an item is woken with a direct to task
+ * notification, which leaves the task's notification value unchanged.  A
+ * consumer that also waits for other events can instead install a wake up
+ * callback with vSPSCRingSetWakeUpCallback(), and use xSPSCRingArmWakeUp()
+ * before it waits.  The producer then calls the callback at most once each
+ * time the consumer armed the wake up, however many items it sends.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include spsc_ring.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which SPSC rings are referenced.  For example, a call to
+ * xSPSCRingCreate() returns an SPSCRingHandle_t variable that can then be used
+ * as a parameter to xSPSCRingSend(), xSPSCRingReceive(), etc.
+ */
+typedef void * SPSCRingHandle_t;
+
+/**
+ * Type of the function called by the producer to wake the consumer, see
+ * vSPSCRingSetWakeUpCallback().  pxHigherPriorityTaskWoken is NULL if the item
+ * was sent from a task, and points to the variable the callback must set to
+ * pdTRUE if it unblocks a task of higher priority if the item was sent from an
+ * interrupt.
+ */
+typedef void ( *SPSCRingWakeUpCallback_t )( SPSCRingHandle_t xRing, BaseType_t *pxHigherPriorityTaskWoken );
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+SPSCRingHandle_t xSPSCRingCreate( size_t xLength );
+</pre>
+ *
+ * Creates a new SPSC ring using dynamically allocated memory.  See
+ * xSPSCRingCreateStatic() for a version that uses statically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xSPSCRingCreate() to be available.
+ *
+ * @param xLength The maximum number of items the ring can hold at any one
+ * time.
+ *
+ * @return If NULL is returned, then the ring cannot be created because there is
+ * insufficient heap memory available for FreeRTOS to allocate the ring data
+ * structures and storage area.  A non-NULL value being returned indicates that
+ * the ring has been created successfully - the returned value should be stored
+ * as the handle to the created ring.
+ *
+ * \defgroup xSPSCRingCreate xSPSCRingCreate
+ * \ingroup SPSCRingManagement
+ */
+SPSCRingHandle_t xSPSCRingCreate( size_t xLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+SPSCRingHandle_t xSPSCRingCreateStatic( size_t xLength,
+                                        void ** const ppvStorageArea,
+                                        StaticSPSCRing_t * const pxStaticSPSCRing );
+</pre>
+ *
+ * Creates a new SPSC ring using statically allocated memory.  See
+ * xSPSCRingCreate() for a version that uses dynamically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSPSCRingCreateStatic() to be available.
+ *
+ * @param xLength The maximum number of items the ring can hold at any one
+ * time.
+ *
+ * @param ppvStorageArea Must point to an array of at least xLength + 1
+ * pointers.  One entry of the array is always left unused, which is what allows
+ * a full ring to be told apart from an empty ring without a shared count.
+ *
+ * @param pxStaticSPSCRing Must point to a variable of type StaticSPSCRing_t,
+ * which will be used to hold the ring's data structure.
+ *
+ * @return If the ring is created successfully then a handle to the created ring
+ * is returned.  If either ppvStorageArea or pxStaticSPSCRing are NULL then NULL
+ * is returned.
+ *
+ * \defgroup xSPSCRingCreateStatic xSPSCRingCreateStatic
+ * \ingroup SPSCRingManagement
+ */
+SPSCRingHandle_t xSPSCRingCreateStatic( size_t xLength,
+										void ** const ppvStorageArea,
+										StaticSPSCRing_t * const pxStaticSPSCRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+void vSPSCRingDelete( SPSCRingHandle_t xRing );
+</pre>
+ *
+ * Deletes an SPSC ring that was previously created using a call to
+ * xSPSCRingCreate() or xSPSCRingCreateStatic().  The items still in the ring
+ * are not freed.
+ *
+ * A ring must not be deleted while the producer or the consumer may still use
+ * it.
+ *
+ * @param xRing The handle of the ring to be deleted.
+ *
+ * \defgroup vSPSCRingDelete vSPSCRingDelete
+ * \ingroup SPSCRingManagement
+ */
+void vSPSCRingDelete( SPSCRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+void vSPSCRingSetWakeUpCallback( SPSCRingHandle_t xRing,
+                                 SPSCRingWakeUpCallback_t pxCallback );
+</pre>
+ *
+ * Installs the function the producer calls to wake the consumer, in place of
+ * the task notification used by default.  The callback is called by the
+ * producer, from the context of the producer, after it sent an item to the
+ * ring, and at most once each time the consumer called xSPSCRingArmWakeUp().
+ * The callback must not block.
+ *
+ * xSPSCRingReceive() must be called with a block time of 0 once a callback is
+ * installed.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @param pxCallback The function to call, or NULL to use task notifications
+ * again.
+ *
+ * \defgroup vSPSCRingSetWakeUpCallback vSPSCRingSetWakeUpCallback
+ * \ingroup SPSCRingManagement
+ */
+void vSPSCRingSetWakeUpCallback( SPSCRingHandle_t xRing,
+								 SPSCRingWakeUpCallback_t pxCallback ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+BaseType_t xSPSCRingSend( SPSCRingHandle_t xRing, void *pvItem );
+</pre>
+ *
+ * Sends an item to an SPSC ring.  The call never blocks.  Use
+ * xSPSCRingSendFromISR() to send an item from an interrupt service routine.
+ *
+ * @param xRing The handle of the ring to which the item is sent.
+ *
+ * @param pvItem The item, which is a pointer.  The ring stores the pointer, not
+ * what it points to.
+ *
+ * @return pdPASS if the item was sent, or pdFAIL if the ring was full.
+ *
+ * \defgroup xSPSCRingSend xSPSCRingSend
+ * \ingroup SPSCRingManagement
+ */
+BaseType_t xSPSCRingSend( SPSCRingHandle_t xRing, void *pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+BaseType_t xSPSCRingSendFromISR( SPSCRingHandle_t xRing,
+                                 void *pvItem,
+                                 BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xSPSCRingSend() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param xRing The handle of the ring to which the item is sent.
+ *
+ * @param pvItem The item, which is a pointer.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if sending the item unblocked a task that has a priority above the priority
+ * of the currently running task, in which case a context switch should be
+ * requested before the interrupt is exited.  *pxHigherPriorityTaskWoken is
+ * never set to pdFALSE, so it should be initialised to pdFALSE before it is
+ * passed in.  pxHigherPriorityTaskWoken can be NULL.
+ *
+ * @return pdPASS if the item was sent, or pdFAIL if the ring was full.
+ *
+ * \defgroup xSPSCRingSendFromISR xSPSCRingSendFromISR
+ * \ingroup SPSCRingManagement
+ */
+BaseType_t xSPSCRingSendFromISR( SPSCRingHandle_t xRing,
+								 void *pvItem,
+								 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+BaseType_t xSPSCRingReceive( SPSCRingHandle_t xRing,
+                             void **ppvItem,
+                             TickType_t xTicksToWait );
+</pre>
+ *
+ * Receives the oldest item from an SPSC ring.  Must be called from a task.
+ *
+ * Example use:
+<pre>
+void vAConsumerTask( void *pvParameters )
+{
+SPSCRingHandle_t xRing = ( SPSCRingHandle_t ) pvParameters;
+void *pvItem;
+
+    for( ;; )
+    {
+        // Wait up to 100ms for an item.
+        if( xSPSCRingReceive( xRing, &pvItem, pdMS_TO_TICKS( 100 ) ) == pdPASS )
+        {
+            // Process the item.
+        }
+    }
+}
+</pre>
+ *
+ * @param xRing The handle of the ring from which the item is received.
+ *
+ * @param ppvItem The item is written to *ppvItem.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for an item, should the ring be empty.  Setting
+ * xTicksToWait to portMAX_DELAY will cause the task to wait indefinitely
+ * (without timing out), provided INCLUDE_vTaskSuspend is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * @return pdPASS if an item was received, or pdFAIL if the ring was still
+ * empty when the block time expired.
+ *
+ * \defgroup xSPSCRingReceive xSPSCRingReceive
+ * \ingroup SPSCRingManagement
+ */
+BaseType_t xSPSCRingReceive( SPSCRingHandle_t xRing,
+							 void **ppvItem,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+BaseType_t xSPSCRingArmWakeUp( SPSCRingHandle_t xRing );
+</pre>
+ *
+ * Called by the consumer before it waits for an item by some other means than
+ * xSPSCRingReceive(), for example on a queue the callback installed with
+ * vSPSCRingSetWakeUpCallback() posts to.  The next item sent to the ring then
+ * calls the callback.
+ *
+ * @param xRing The handle of the ring.
+ *
+ * @return pdTRUE if the ring was empty, in which case the consumer can wait.
+ * pdFALSE if the ring already holds items, in which case the consumer should
+ * receive them instead of waiting, as the callback may already have been called
+ * for them.
+ *
+ * \defgroup xSPSCRingArmWakeUp xSPSCRingArmWakeUp
+ * \ingroup SPSCRingManagement
+ */
+BaseType_t xSPSCRingArmWakeUp( SPSCRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+<pre>
+size_t xSPSCRingItemsAvailable( SPSCRingHandle_t xRing );
+</pre>
+ *
+ * Queries an SPSC ring to see how many items it holds.  The result is only
+ * exact when called by the consumer, as the producer may add items at any
+ * time.
+ *
+ * @param xRing The handle of the ring being queried.
+ *
+ * @return The number of items in the ring.
+ *
+ * \defgroup xSPSCRingItemsAvailable xSPSCRingItemsAvailable
+ * \ingroup SPSCRingManagement
+ */
+size_t xSPSCRingItemsAvailable( SPSCRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif	/* !defined( SPSC_RING_H ) */
@@ -67,6 +67,22 @@ extern "C" {
  */
 typedef void * StreamBufferHandle_t;
 
+/**
+ * Describes a region of a stream buffer's storage area that can be written or
+ * read in place by the zero copy API functions, xStreamBufferAcquireWrite(),
+ * xStreamBufferPeekRead(), etc.  The storage area is a ring, so the region is
+ * split into two spans if it wraps past the end of the storage area.  The
+ * second span then starts at the beginning of the storage area.  Unused spans
+ * have a NULL pointer and a length of 0.
+ */
+typedef struct xSTREAM_BUFFER_SPANS
+{
+	uint8_t *pucFirst;		/* The start of the first span. */
+	size_t xFirstLength;	/* The number of bytes in the first span. */
+	uint8_t *pucSecond;		/* The start of the second span, or NULL if the region does not wrap. */
+	size_t xSecondLength;	/* The number of bytes in the second span. */
+} StreamBufferSpans_t;
+
 
 /**
  * message_buffer.h
@@ -832,6 +848,269 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                  StreamBufferSpans_t * const pxSpans,
+                                  size_t xMaxLength,
+                                  TickType_t xTicksToWait );
+</pre>
+ *
+ * Reserves free space in a stream buffer so it can be written in place, for
+ * example by a DMA engine or a peripheral driver, instead of being copied in
+ * by xStreamBufferSend().  Once the data has been written, call
+ * xStreamBufferCommitWrite() to make it available to the reader.  Nothing is
+ * visible to the reader until it is committed.
+ *
+ * As with xStreamBufferSend(), only one task or interrupt can write to a
+ * stream buffer, and it must not call any other function that writes to the
+ * stream buffer between acquiring and committing space.
+ *
+ * Use xStreamBufferAcquireWrite() from a task, and
+ * xStreamBufferAcquireWriteFromISR() from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param pxSpans Set to the one or two spans of the storage area that make up
+ * the reserved space, in the order they must be filled.
+ *
+ * @param xMaxLength The number of bytes wanted.  For a stream buffer, up to
+ * xMaxLength bytes are reserved.  For a message buffer, exactly xMaxLength
+ * bytes are reserved for one message, or nothing if there is not enough space
+ * for the message and its length.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for the space xStreamBufferSend() would wait for (all
+ * xMaxLength bytes) to become free.
+ *
+ * @return The number of bytes reserved, which is the sum of the lengths of the
+ * spans.
+ *
+ * Example use:
+<pre>
+void vADMAReceiveTask( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBufferSpans_t xSpans;
+size_t xReserved, xReceived;
+
+    for( ;; )
+    {
+        // Reserve up to 64 bytes, waiting as long as necessary.
+        xReserved = xStreamBufferAcquireWrite( xStreamBuffer, &xSpans, 64, portMAX_DELAY );
+
+        // Receive straight into the stream buffer.  The data is written to
+        // xSpans.pucFirst first, then to xSpans.pucSecond if the reserved
+        // space wraps.
+        xReceived = xUARTReceiveDMA( xSpans.pucFirst, xSpans.xFirstLength,
+                                     xSpans.pucSecond, xSpans.xSecondLength );
+
+        // Make the bytes received available to the reader, and unblock the
+        // reader if the trigger level has been reached.
+        xStreamBufferCommitWrite( xStreamBuffer, xReceived );
+    }
+}
+</pre>
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+								  StreamBufferSpans_t * const pxSpans,
+								  size_t xMaxLength,
+								  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         StreamBufferSpans_t * const pxSpans,
+                                         size_t xMaxLength );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferAcquireWrite(), which never
+ * blocks.
+ *
+ * \defgroup xStreamBufferAcquireWriteFromISR xStreamBufferAcquireWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										 StreamBufferSpans_t * const pxSpans,
+										 size_t xMaxLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xLength );
+</pre>
+ *
+ * Makes the first xLength bytes of the space reserved by the last call to
+ * xStreamBufferAcquireWrite() available to the reader, and notifies a task
+ * blocked on the stream buffer exactly as xStreamBufferSend() would.
+ *
+ * Use xStreamBufferCommitWrite() from a task, and
+ * xStreamBufferCommitWriteFromISR() from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written to.
+ *
+ * @param xLength The number of bytes written, which must not be more than the
+ * number of bytes reserved.  For a message buffer this is the length of the
+ * message.  Passing 0 releases the reserved space without writing anything.
+ *
+ * @return xLength.
+ *
+ * \defgroup xStreamBufferCommitWrite xStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xLength,
+                                        BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferCommitWrite().
+ * *pxHigherPriorityTaskWoken is used as by xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferCommitWriteFromISR xStreamBufferCommitWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xLength,
+										BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer,
+                              StreamBufferSpans_t * const pxSpans,
+                              TickType_t xTicksToWait );
+</pre>
+ *
+ * Gives the reader access to the data in a stream buffer in place, instead of
+ * copying it out with xStreamBufferReceive().  The data stays in the stream
+ * buffer, and the spans stay valid, until it is removed with
+ * xStreamBufferConsumeRead().
+ *
+ * As with xStreamBufferReceive(), only one task or interrupt can read from a
+ * stream buffer, and it must not call any other function that reads from the
+ * stream buffer between peeking and consuming.
+ *
+ * Use xStreamBufferPeekRead() from a task, and xStreamBufferPeekReadFromISR()
+ * from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxSpans Set to the one or two spans of the storage area that hold the
+ * data, in order.  For a stream buffer they hold all the bytes in the buffer,
+ * for a message buffer they hold the next message.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data, as for xStreamBufferReceive().
+ *
+ * @return The number of bytes in the spans, or 0 if there is no data.
+ *
+ * Example use:
+<pre>
+void vAParserTask( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBufferSpans_t xSpans;
+size_t xAvailable, xParsed;
+
+    for( ;; )
+    {
+        xAvailable = xStreamBufferPeekRead( xStreamBuffer, &xSpans, portMAX_DELAY );
+
+        if( xAvailable > 0 )
+        {
+            // Parse in place.  Bytes that are not consumed, for example the
+            // start of an incomplete line, are returned by the next peek.
+            xParsed = xParseLines( xSpans.pucFirst, xSpans.xFirstLength,
+                                   xSpans.pucSecond, xSpans.xSecondLength );
+
+            // Free the space used by the parsed bytes, and unblock the writer
+            // if it was waiting for space.
+            xStreamBufferConsumeRead( xStreamBuffer, xParsed );
+        }
+    }
+}
+</pre>
+ * \defgroup xStreamBufferPeekRead xStreamBufferPeekRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekRead( StreamBufferHandle_t xStreamBuffer,
+							  StreamBufferSpans_t * const pxSpans,
+							  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferPeekReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                     StreamBufferSpans_t * const pxSpans );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferPeekRead(), which never blocks.
+ *
+ * \defgroup xStreamBufferPeekReadFromISR xStreamBufferPeekReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekReadFromISR( StreamBufferHandle_t xStreamBuffer,
+									 StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer, size_t xLength );
+</pre>
+ *
+ * Removes data returned by xStreamBufferPeekRead() from a stream buffer, and
+ * notifies a task blocked on the stream buffer exactly as
+ * xStreamBufferReceive() would.
+ *
+ * Use xStreamBufferConsumeRead() from a task, and
+ * xStreamBufferConsumeReadFromISR() from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read from.
+ *
+ * @param xLength For a stream buffer, the number of bytes to remove from the
+ * front of the buffer.  For a message buffer, the length of the message
+ * returned by xStreamBufferPeekRead(), which is removed as a whole.
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferConsumeRead xStreamBufferConsumeRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer, size_t xLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xLength,
+                                        BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferConsumeRead().
+ * *pxHigherPriorityTaskWoken is used as by xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferConsumeReadFromISR xStreamBufferConsumeReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xLength,
+										BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
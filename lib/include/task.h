@@ -153,6 +153,14 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+#if( configNUM_CORES > 1 )
+	/**
+	 * The core affinity mask that allows a task to run on any core.  Bit N of
+	 * a core affinity mask is set if the task can run on core N.
+	 */
+	#define tskNO_AFFINITY			( ( UBaseType_t ) -1 )
+#endif
+
 /**
  * task. h
  *
@@ -175,8 +183,15 @@ typedef enum
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()		portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#if( configNUM_CORES == 1 )
+	#define taskENTER_CRITICAL()		portENTER_CRITICAL()
+	#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+	/* On more than one core masking interrupts is not enough, the critical
+	sections also take the kernel spinlocks. */
+	#define taskENTER_CRITICAL()		vTaskEnterCritical()
+	#define taskENTER_CRITICAL_FROM_ISR() uxTaskEnterCriticalFromISR()
+#endif
 
 /**
  * task. h
@@ -190,8 +205,13 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if( configNUM_CORES == 1 )
+	#define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+	#define taskEXIT_CRITICAL()			vTaskExitCritical()
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) vTaskExitCriticalFromISR( x )
+#endif
 /**
  * task. h
  *
@@ -1003,6 +1023,66 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+#if( configNUM_CORES > 1 )
+
+/**
+ * task. h
+ * <pre>void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );</pre>
+ *
+ * Only available when configNUM_CORES is greater than 1.
+ *
+ * Set the cores a task is allowed to run on.  Bit N of uxCoreAffinityMask is
+ * set if the task can run on core N.  Tasks are created with the affinity
+ * mask tskNO_AFFINITY, so they can run on any core.
+ *
+ * If the task is running on a core that is not in the new mask it is moved
+ * to another core before the function returns, or when the calling task
+ * leaves the critical section it is in.
+ *
+ * @param xTask Handle to the task for which the affinity is being set.
+ * Passing a NULL handle results in the affinity of the calling task being set.
+ *
+ * @param uxCoreAffinityMask The cores the task can run on.  At least one of
+ * the configNUM_CORES least significant bits must be set.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( void )
+ {
+ TaskHandle_t xHandle;
+
+	 // Create a task, storing the handle.
+	 xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+
+	 // Only allow the created task to run on core 1.
+	 vTaskCoreAffinitySet( xHandle, ( 1 << 1 ) );
+ }
+   </pre>
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask );</pre>
+ *
+ * Only available when configNUM_CORES is greater than 1.
+ *
+ * Obtain the core affinity mask of any task.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the affinity of the calling task being returned.
+ *
+ * @return The cores the task can run on, see vTaskCoreAffinitySet().
+ *
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUM_CORES */
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -2264,6 +2344,37 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if( configNUM_CORES > 1 )
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
+ * THE PORT LAYER AND THE CRITICAL SECTION MACROS WHEN configNUM_CORES IS
+ * GREATER THAN 1.
+ */
+
+/*
+ * Return the handle of the task running on core xCoreID.  Must be called with
+ * interrupts disabled or from an interrupt.
+ */
+TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Critical sections that mask interrupts on the calling core and take the
+ * kernel spinlocks.  The FromISR versions only take the ISR lock.
+ */
+void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+/*
+ * portYIELD_WITHIN_API().  Yields now, or when the calling task leaves the
+ * critical section it is in.
+ */
+void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUM_CORES */
+
 /*
  * Capture the current time status for future reference.
  */
@@ -125,6 +125,30 @@
  * it to the user as an opaque handle.
  */
 #define mqttDECODE_BROKER_NUMBER( xBrokerNumber )    ( ( UBaseType_t ) xBrokerNumber - ( UBaseType_t ) 1 )
+
+/**
+ * @brief Number of entries in the packet identifier index of a connection.
+ *
+ * Twice the number of packet identifiers which can be waiting for an ACK at any
+ * one time, so that the probe sequences stay short.
+ */
+#define mqttPACKET_IDENTIFIER_INDEX_SIZE                                           \
+    ( 2 * ( ( mqttconfigMAX_PARALLEL_OPS * mqttconfigMAX_PUBLISH_BATCH_SIZE ) + \
+            mqttconfigMAX_ASYNC_PUBLISHES ) )
+
+/**
+ * @brief Returned by prvLookUpPacketIdentifier if no slot uses the packet identifier,
+ * and marks the removed entries of the packet identifier index.
+ */
+#define mqttNO_SLOT    ( ( uint16_t ) 0xFFFF )
+
+/**
+ * @brief The maximum number of pieces handed to SOCKETS_Sendv in one call.
+ *
+ * The core library sends a zero-copy publish as the buffered header followed by
+ * the user payload.
+ */
+#define mqttMAX_SEND_VECTORS    ( 2 )
 /*-----------------------------------------------------------*/
 
 /**
@@ -137,7 +161,9 @@ typedef enum
     eMQTTDisconnectRequest,  /**< Disconnect the connection to an MQTT broker. */
     eMQTTSubscribeRequest,   /**< Initiate a subscribe to a topic.  _TODO_ Currently limited to one topic per subscribe message. */
     eMQTTUnsubscribeRequest, /**< Initiate unsubscribe from a topic.  _TODO_ Currently limited to one topic per unsubscribe message. */
-    eMQTTPublishRequest      /**< Initiate a publish to a topic.  _TODO_ Currently limited to one topic per publish message. */
+    eMQTTPublishRequest,     /**< Initiate a publish to a topic.  _TODO_ Currently limited to one topic per publish message. */
+    eMQTTPublishBatchRequest, /**< Initiate a number of publishes with one command. */
+    eMQTTPublishAsyncRequest  /**< Initiate a publish without blocking the application task. */
 } MQTTAction_t;
 
 /**
@@ -177,6 +203,69 @@ typedef struct MQTTNotificationData
     uint32_t ulMessageIdentifier; /**< Used to match a request going from application task to MQTT task with response going the other way. */
 } MQTTNotificationData_t;
 
+/**
+ * @brief Parameters of a publish batch request sent by MQTT_AGENT_PublishBatch.
+ */
+typedef struct MQTTPublishBatchParams
+{
+    const MQTTAgentPublishParams_t * pxPublishParams; /**< Array of ulNumPublishes messages to publish. */
+    MQTTAgentReturnCode_t * pxPublishResults;         /**< Array of ulNumPublishes entries receiving the result of each publish. */
+    uint32_t ulNumPublishes;                          /**< The number of messages in the batch. */
+} MQTTPublishBatchParams_t;
+
+/**
+ * @brief State of a publish batch which is waiting for PUBACKs.
+ *
+ * The messages of a batch use consecutive packet identifiers, starting from the
+ * one contained in the message identifier of the corresponding notification data.
+ */
+typedef struct MQTTPublishBatch
+{
+    MQTTAgentReturnCode_t * pxPublishResults; /**< Results of the publishes in the batch, NULL if the notification data does not belong to a batch. */
+    uint16_t usNumPublishes;                  /**< The number of messages in the batch. */
+    uint16_t usPendingPUBACKs;                /**< The number of QoS1 messages still waiting for a PUBACK. */
+} MQTTPublishBatch_t;
+
+/**
+ * @brief States of a publish started with MQTT_AGENT_PublishAsync.
+ */
+typedef enum
+{
+    eMQTTAsyncPublishFree = 0,        /**< The entry is not in use. */
+    eMQTTAsyncPublishQueued,          /**< The request is in the command queue. */
+    eMQTTAsyncPublishWaitingForPUBACK /**< The QoS1 message has been sent and is waiting for the PUBACK. */
+} MQTTAsyncPublishState_t;
+
+/**
+ * @brief A publish started with MQTT_AGENT_PublishAsync.
+ *
+ * The entry is reserved by the application task and released by the MQTT task
+ * once the completion callback has been invoked.
+ */
+typedef struct MQTTAsyncPublish
+{
+    MQTTAgentPublishParams_t xPublishParams;              /**< Copy of the publish parameters. */
+    MQTTAgentPublishCompleteCallback_t xCompleteCallback; /**< The callback to invoke when the publish completes. */
+    void * pvCallbackContext;                             /**< Passed as it is to xCompleteCallback. */
+    uint16_t usPacketIdentifier;                          /**< The packet identifier of the message. */
+    MQTTAsyncPublishState_t xState;                       /**< It is accessed from application tasks (MQTT_AGENT_PublishAsync) and hence should be accessed in critical section. */
+} MQTTAsyncPublish_t;
+
+/**
+ * @brief An entry of the hash index mapping packet identifiers to the slots
+ * waiting for an ACK.
+ *
+ * Slots 0 to mqttconfigMAX_PARALLEL_OPS - 1 refer to xWaitingTasks and the
+ * following ones to xAsyncPublishes. When a packet identifier is done with,
+ * its entry is turned into a tombstone (usSlot set to mqttNO_SLOT) so that the
+ * entries following it in a probe sequence can still be found.
+ */
+typedef struct MQTTPacketIdentifierIndexEntry
+{
+    uint16_t usPacketIdentifier; /**< The packet identifier, 0 if the entry has never been used. */
+    uint16_t usSlot;             /**< The slot waiting for the packet identifier, mqttNO_SLOT for a tombstone. */
+} MQTTPacketIdentifierIndexEntry_t;
+
 /**
  * @brief Contents of the message sent from an application task to the MQTT task to
  * initiate an MQTT operation.
@@ -198,6 +287,8 @@ typedef struct MQTTEventData
         const MQTTAgentSubscribeParams_t * pxSubscribeParams;     /**< Subscribe Parameters. */
         const MQTTAgentUnsubscribeParams_t * pxUnsubscribeParams; /**< Unsubscribe Parameters. */
         const MQTTAgentPublishParams_t * pxPublishParams;         /**< Publish Parameters. */
+        const MQTTPublishBatchParams_t * pxPublishBatchParams;    /**< Publish Batch Parameters. */
+        MQTTAsyncPublish_t * pxAsyncPublish;                      /**< Asynchronous Publish. */
     } u;
 } MQTTEventData_t;
 
@@ -213,11 +304,22 @@ typedef struct MQTTBrokerConnection
     Socket_t xSocket;                                                   /**< TCP socket connected to the broker. */
     MQTTContext_t xMQTTContext;                                         /**< MQTT Core library context. */
     MQTTNotificationData_t xWaitingTasks[ mqttconfigMAX_PARALLEL_OPS ]; /**< Notification data to notify tasks which have sent commands to MQTT command queue and are waiting for results. */
+    MQTTPublishBatch_t xPublishBatches[ mqttconfigMAX_PARALLEL_OPS ];   /**< State of the publish batches, indexed like xWaitingTasks. */
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+        MQTTAsyncPublish_t xAsyncPublishes[ mqttconfigMAX_ASYNC_PUBLISHES ]; /**< Publishes started with MQTT_AGENT_PublishAsync. */
+    #endif
+    MQTTPacketIdentifierIndexEntry_t xPacketIdentifierIndex[ mqttPACKET_IDENTIFIER_INDEX_SIZE ]; /**< Finds the slot waiting for an ACK without searching all of them. */
     void * pvUserData;                                                  /**< User data to be supplied back in the callback as it is. */
     MQTTAgentCallback_t pxCallback;                                     /**< The callback to notify user of various events including the Publish messages received from the broker. */
     UBaseType_t uxFlags;                                                /**< Various properties of the connection - secured etc. */
     BaseType_t xConnectionInUse;                                        /**< Tracks whether or not the connection is in use. It is accessed from application tasks (prvGetFreeConnection and prvReturnConnection) and hence should be accessed in critical section. */
     uint8_t ucRxBuffer[ mqttconfigRX_BUFFER_SIZE ];                     /**< Buffers incoming messages. */
+    #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+        uint8_t ucTxBuffer[ mqttconfigTX_BUFFER_SIZE ];                 /**< Circular buffer holding outgoing bytes which the socket could not accept yet. */
+        uint32_t ulTxHead;                                              /**< Index of the first pending byte in ucTxBuffer. */
+        uint32_t ulTxLength;                                            /**< Number of pending bytes in ucTxBuffer. */
+        BaseType_t xTxCorked;                                           /**< Set while the messages of a publish batch are queued so that they are sent together. */
+    #endif /* mqttconfigTX_BUFFER_SIZE */
 } MQTTBrokerConnection_t;
 /*-----------------------------------------------------------*/
 
@@ -286,6 +388,65 @@ static uint32_t prvMQTTSendCallback( void * pvSendContext,
                                      const uint8_t * const pucData,
                                      uint32_t ulDataLength );
 
+/**
+ * @brief The callback registered with the core MQTT library to transmit data
+ * scattered over multiple memory regions.
+ *
+ * The pieces are handed to the socket in one SOCKETS_Sendv call if nothing is
+ * pending in the Tx buffer. Whatever the socket does not accept is then sent by
+ * prvMQTTSendCallback so that it is queued or waited for like any other data.
+ *
+ * @param[in] pvSendContext The send context is broker number in our case.
+ * @param[in] pxVectors The pieces of data to transmit.
+ * @param[in] ulVectorCount The number of entries in pxVectors.
+ *
+ * @return The total number of actually transmitted bytes.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+    static uint32_t prvMQTTSendvCallback( void * pvSendContext,
+                                          const MQTTSendVector_t * const pxVectors,
+                                          uint32_t ulVectorCount );
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+#if ( mqttconfigTX_BUFFER_SIZE > 0 )
+
+/**
+ * @brief Sends as many of the bytes pending in the Tx buffer as the socket accepts.
+ *
+ * Never blocks. The remaining bytes stay in the Tx buffer and are sent when the
+ * socket signals that it can accept more data.
+ *
+ * @param[in] pxConnection The connection whose pending bytes are to be sent.
+ *
+ * @return pdFAIL if the socket reported an error other than SOCKETS_EWOULDBLOCK,
+ * pdPASS otherwise.
+ */
+    static BaseType_t prvFlushTxBuffer( MQTTBrokerConnection_t * const pxConnection );
+
+/**
+ * @brief Sends or queues as much of the data as possible without blocking.
+ *
+ * The bytes pending in the Tx buffer are sent first so that the order of bytes on
+ * the wire is preserved. The data is then sent directly if nothing is pending any
+ * more, and whatever the socket does not accept is appended to the Tx buffer as far
+ * as it has room. Data larger than the free space, including packets larger than
+ * the whole Tx buffer, is therefore consumed piecewise over several calls as the
+ * socket drains.
+ *
+ * @param[in] pxConnection The connection to send the data on.
+ * @param[in] pucData The data to transmit.
+ * @param[in] ulDataLength Length of the data.
+ *
+ * @return The number of bytes sent or queued, which is 0 if the socket and the Tx
+ * buffer are both full, or a negative error code if the socket reported an error
+ * other than SOCKETS_EWOULDBLOCK.
+ */
+    static int32_t prvSendOrQueueData( MQTTBrokerConnection_t * const pxConnection,
+                                       const uint8_t * const pucData,
+                                       uint32_t ulDataLength );
+
+#endif /* mqttconfigTX_BUFFER_SIZE */
+
 /**
  * @brief The callback registered with the core MQTT library to receive various MQTT events.
  *
@@ -354,13 +515,82 @@ static void prvReturnConnection( UBaseType_t uxBrokerNumber );
 static MQTTNotificationData_t * prvStoreNotificationData( MQTTBrokerConnection_t * const pxConnection,
                                                           const MQTTEventData_t * const pxEventData );
 
+/**
+ * @brief Checks whether a slot is waiting for an ACK with the given packet identifier.
+ *
+ * A notification data uses the packet identifier in the top 16 bits of its message identifier, or
+ * all the packet identifiers used by the messages of a publish batch. An asynchronous publish uses its
+ * packet identifier while waiting for the PUBACK.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t the slot belongs to.
+ * @param[in] usSlot The slot as stored in the packet identifier index.
+ * @param[in] usPacketIdentifier The packet identifier.
+ *
+ * @return pdTRUE if the slot uses the packet identifier, pdFALSE otherwise.
+ */
+static BaseType_t prvSlotUsesPacketIdentifier( const MQTTBrokerConnection_t * const pxConnection,
+                                               uint16_t usSlot,
+                                               uint16_t usPacketIdentifier );
+
+/**
+ * @brief Adds a packet identifier to the packet identifier index.
+ *
+ * Uses open addressing with linear probing. An entry is reused if it has never been used, if it
+ * has been removed or if it refers to the same packet identifier.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t the slot belongs to.
+ * @param[in] usPacketIdentifier The packet identifier which the slot waits for.
+ * @param[in] usSlot The slot.
+ */
+static void prvIndexPacketIdentifier( MQTTBrokerConnection_t * const pxConnection,
+                                      uint16_t usPacketIdentifier,
+                                      uint16_t usSlot );
+
+/**
+ * @brief Finds the slot waiting for an ACK with the given packet identifier.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t
+ * @param[in] usPacketIdentifier The packet identifier.
+ *
+ * @return The slot using the packet identifier, mqttNO_SLOT if there is none.
+ */
+static uint16_t prvLookUpPacketIdentifier( const MQTTBrokerConnection_t * const pxConnection,
+                                           uint16_t usPacketIdentifier );
+
+/**
+ * @brief Removes a packet identifier from the packet identifier index.
+ *
+ * Must be called once the ACK or timeout for the packet identifier has been processed, or
+ * once it is known that none will be, so that a late or duplicate ACK is not attributed to
+ * the slot. Does nothing if the packet identifier is not in the index.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t
+ * @param[in] usPacketIdentifier The packet identifier.
+ */
+static void prvRemovePacketIdentifier( MQTTBrokerConnection_t * const pxConnection,
+                                       uint16_t usPacketIdentifier );
+
+/**
+ * @brief Returns a buffer used to store notification data without notifying the task.
+ *
+ * Used when the operation could not be started, in which case the packet identifier of the
+ * notification data is removed from the packet identifier index as well.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t the buffer belongs to.
+ * @param[in] pxNotificationData The buffer to return.
+ */
+static void prvReturnNotificationData( MQTTBrokerConnection_t * const pxConnection,
+                                       MQTTNotificationData_t * const pxNotificationData );
+
 /**
  * @brief Retrieves the notification data matching the given packet identifier.
  *
  * Whenever we receive a message from the MQTT Core library, we need to check if any task is waiting
- * for it and accordingly notify it. This functions iterates over all the waiting tasks ( i.e. xWaitingTasks )
- * in MQTTBrokerConnection_t and tries to find a notification data having message identifier with top 16
- * bits matching the received packet identifier from the Core library.
+ * for it and accordingly notify it. This function looks up the received packet identifier from the
+ * Core library in the packet identifier index of the connection, which avoids iterating over all the
+ * waiting tasks ( i.e. xWaitingTasks ) in MQTTBrokerConnection_t. The notification data of a publish
+ * batch matches all the packet identifiers used by the QoS1 messages of the batch. As only one ACK or
+ * timeout is processed per packet identifier, the packet identifier is removed from the index.
  *
  * @param[in] pxConnection The MQTTBrokerConnection_t
  * @param[in] usPacketIdentifier The packet identifier.
@@ -382,6 +612,40 @@ static MQTTNotificationData_t * prvRetrieveNotificationData( MQTTBrokerConnectio
  */
 static BaseType_t prvSetupConnection( const MQTTEventData_t * const pxEventData );
 
+/**
+ * @brief Records the outcome of one message of a publish batch.
+ *
+ * If the notification data belongs to a publish batch, stores the result of the message
+ * using the given packet identifier and notifies the application task once no message
+ * of the batch is waiting for a PUBACK anymore.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t the notification data belongs to.
+ * @param[in] pxNotificationData The notification data as returned by prvRetrieveNotificationData.
+ * @param[in] usPacketIdentifier The packet identifier of the acknowledged or timed out message.
+ * @param[in] xResult The result of the message.
+ *
+ * @return pdTRUE if the notification data belongs to a publish batch, pdFALSE otherwise.
+ */
+static BaseType_t prvUpdatePublishBatch( MQTTBrokerConnection_t * const pxConnection,
+                                         MQTTNotificationData_t * const pxNotificationData,
+                                         uint16_t usPacketIdentifier,
+                                         MQTTAgentReturnCode_t xResult );
+
+/**
+ * @brief Notifies the application task about the completion of a publish batch.
+ *
+ * The task is informed of success only if every message of the batch succeeded.
+ *
+ * @param[in] pxNotificationData The notification data of the task which initiated the batch.
+ * @param[in] pxPublishResults The results of the messages of the batch.
+ * @param[in] ulNumPublishes The number of messages in the batch.
+ * @param[in] xSuccessCode The notification code to use if every message succeeded.
+ */
+static void prvCompletePublishBatch( MQTTNotificationData_t * const pxNotificationData,
+                                     const MQTTAgentReturnCode_t * const pxPublishResults,
+                                     uint32_t ulNumPublishes,
+                                     MQTTNotifyCodes_t xSuccessCode );
+
 /**
  * @brief Gracefully terminates the connection.
  *
@@ -397,7 +661,8 @@ static void prvGracefulSocketClose( MQTTBrokerConnection_t * const pxConnection
  * @brief The callback registered with the socket to get notified of the available data to read on the socket.
  *
  * This function just posts a eMQTTServiceSocket request to the MQTT command queue to
- * unblock the MQTT task in order to ensure that the available data is read and processed.
+ * unblock the MQTT task in order to ensure that the available data is read and processed
+ * and that the bytes pending in the Tx buffer, if any, are sent.
  *
  * @param[in] pxSocket The socket on which the data is available for reading.
  */
@@ -465,6 +730,21 @@ static void prvProcessReceivedPUBACK( MQTTBrokerConnection_t * const pxConnectio
 static BaseType_t prvProcessReceivedPublish( MQTTBrokerConnection_t * const pxConnection,
                                              const MQTTEventCallbackParams_t * const pxParams );
 
+/**
+ * @brief Notifies the user about a part of a streamed Publish message.
+ *
+ * Streamed Publish messages are delivered by the MQTT Core library straight from the receive buffer of the
+ * connection, first the header and then the payload in chunks. If the user has registered a callback, invokes
+ * the callback to inform the user otherwise silently ignores the message.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t corresponding to the connection on which Publish is received.
+ * @param[in] pxParams The parameters received in the callback form the MQTT Core library containing relevant data.
+ */
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+    static void prvProcessReceivedPublishStream( MQTTBrokerConnection_t * const pxConnection,
+                                                 const MQTTEventCallbackParams_t * const pxParams );
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
 /**
  * @brief Notifies the application task about the timeout.
  *
@@ -586,6 +866,73 @@ static void prvInitiateMQTTUnSubscribe( MQTTEventData_t * const pxEventData );
  */
 static void prvInitiateMQTTPublish( MQTTEventData_t * const pxEventData );
 
+/**
+ * @brief Initiates a batch of MQTT Publish operations.
+ *
+ * Calls the MQTT_Publish function of the core MQTT library for every message of the
+ * batch, using consecutive packet identifiers starting from the one reserved by the
+ * application task. If the batch contains QoS1 messages, a single buffer is used to
+ * store the notification data for the whole batch and the application task is notified
+ * once all of them are acknowledged or timed out. Otherwise the application task is
+ * informed immediately. If mqttconfigTX_BUFFER_SIZE is not zero, the packets of the
+ * batch are queued and written to the socket together.
+ *
+ * @param[in] pxEventData The event data as posted by application task to the command queue.
+ */
+static void prvInitiateMQTTPublishBatch( MQTTEventData_t * const pxEventData );
+
+/**
+ * @brief Initiates a publish started with MQTT_AGENT_PublishAsync.
+ *
+ * Calls the MQTT_Publish function of the core MQTT library. A successful QoS1 message is
+ * added to the packet identifier index and completed when the PUBACK is received or the
+ * operation times out. Otherwise the publish is completed immediately.
+ *
+ * @param[in] pxEventData The event data as posted by application task to the command queue.
+ */
+#if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+    static void prvInitiateMQTTPublishAsync( MQTTEventData_t * const pxEventData );
+#endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+/**
+ * @brief Completes the asynchronous publish using the given packet identifier, if any.
+ *
+ * @param[in] pxConnection The MQTTBrokerConnection_t corresponding to the connection on which the ACK or Timeout event is received.
+ * @param[in] usPacketIdentifier The packet identifier of the acknowledged or timed out message.
+ * @param[in] xResult The result to report.
+ */
+#if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+    static void prvProcessAsyncPublishResult( MQTTBrokerConnection_t * const pxConnection,
+                                              uint16_t usPacketIdentifier,
+                                              MQTTAgentReturnCode_t xResult );
+#endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+/**
+ * @brief Releases an asynchronous publish and invokes its completion callback.
+ *
+ * The entry is released first so that the callback can start a new asynchronous publish.
+ *
+ * @param[in] pxAsyncPublish The asynchronous publish.
+ * @param[in] xResult The result to report.
+ */
+#if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+    static void prvCompleteAsyncPublish( MQTTAsyncPublish_t * const pxAsyncPublish,
+                                         MQTTAgentReturnCode_t xResult );
+#endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+/**
+ * @brief Reserves consecutive message identifiers.
+ *
+ * A single message identifier variable is used by all connections and therefore this
+ * function must be called from a critical section. The reserved identifiers never wrap
+ * around.
+ *
+ * @param[in] ulNumMessageIdentifiers The number of message identifiers to reserve.
+ *
+ * @return The first reserved message identifier.
+ */
+static uint32_t prvReserveMessageIdentifiers( uint32_t ulNumMessageIdentifiers );
+
 /*
  * @brief Posts the event to the command queue and waits for the notification from the MQTT task.
  *
@@ -607,10 +954,21 @@ static void prvInitiateMQTTPublish( MQTTEventData_t * const pxEventData );
  */
 static MQTTAgentReturnCode_t prvSendCommandToMQTTTask( MQTTEventData_t * pxEventData );
 
+/**
+ * @brief Processes a command read from the command queue by the MQTT task.
+ *
+ * A command which has been waiting in the queue for longer than its timeout is
+ * failed with eMQTTOperationTimedOut without being processed.
+ *
+ * @param[in] pxCommand The command to process.
+ */
+static void prvProcessCommand( MQTTEventData_t * const pxCommand );
+
 /**
  * @brief Implements the task that manages the MQTT protocol.
  *
- * This function reads messages from the command queue and processes them.
+ * This function reads the messages waiting in the command queue in one go and
+ * processes them in turn.
  * It wakes up periodically and calls prvManageConnections() in order to
  * ensure regular timeout and keep alive processing by the MQTT Core library.
  *
@@ -643,39 +1001,232 @@ static uint32_t prvMQTTSendCallback( void * pvSendContext,
      * other than SOCKETS_EWOULDBLOCK occurs. */
     while( ulBytesSent < ulDataLength )
     {
-        /* Check for timeout and if timeout has occurred, stop retrying. */
-        if( xTaskCheckForTimeOut( &( xTimestamp ), &( xTicksToWait ) ) == pdTRUE )
+        #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+            /* Whatever the socket cannot accept now is queued and sent when
+             * the socket becomes writable, so this only has to wait if the
+             * Tx buffer is full as well. */
+            lSendRetVal = prvSendOrQueueData( pxConnection,
+                                              &( pucData[ ulBytesSent ] ),
+                                              ulDataLength - ulBytesSent );
+        #else
+            /* Try sending the remaining data. */
+            lSendRetVal = SOCKETS_Send( pxConnection->xSocket,
+                                        &( pucData[ ulBytesSent ] ),               /* Only send the remaining data. */
+                                        ( size_t ) ( ulDataLength - ulBytesSent ), /* Only send the remaining data. */
+                                        0 );
+        #endif /* mqttconfigTX_BUFFER_SIZE */
+
+        if( lSendRetVal > 0 )
+        {
+            /* Update the count of sent bytes. */
+            ulBytesSent += ( uint32_t ) lSendRetVal;
+        }
+        else if( ( lSendRetVal < 0 ) && ( lSendRetVal != SOCKETS_EWOULDBLOCK ) )
         {
+            /* A negative return value other than SOCKETS_EWOULDBLOCK means
+             * some error occurred, in which case we stop re-trying. */
             break;
         }
+        else
+        {
+            /* The socket cannot accept more data now. Check for timeout and if
+             * timeout has occurred, stop retrying. */
+            if( xTaskCheckForTimeOut( &( xTimestamp ), &( xTicksToWait ) ) == pdTRUE )
+            {
+                break;
+            }
+
+            /* Block until the socket wakeup callback signals that the socket
+             * needs attention rather than spinning on the congested link. A
+             * stale notification only results in one more attempt. */
+            ( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+        }
+    }
+
+    return ulBytesSent;
+}
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+    static uint32_t prvMQTTSendvCallback( void * pvSendContext,
+                                          const MQTTSendVector_t * const pxVectors,
+                                          uint32_t ulVectorCount )
+    {
+        MQTTBrokerConnection_t * pxConnection;
+        UBaseType_t uxBrokerNumber = ( UBaseType_t ) pvSendContext; /*lint !e923 The cast is ok as we passed the index of the client before. */
+        SocketsIOVector_t xSocketVectors[ mqttMAX_SEND_VECTORS ];
+        BaseType_t xSendDirectly = pdFALSE;
+        int32_t lSendRetVal;
+        uint32_t x, ulBytesSent = 0, ulOffset, ulRemainingLength, ulPieceBytesSent;
+
+        /* Broker number must be valid. */
+        configASSERT( uxBrokerNumber < ( UBaseType_t ) mqttconfigMAX_BROKERS );
+
+        /* Get the actual connection to the broker. */
+        pxConnection = &( xMQTTConnections[ uxBrokerNumber ] );
+
+        if( ulVectorCount <= ( uint32_t ) mqttMAX_SEND_VECTORS )
+        {
+            #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+                /* Bytes queued earlier must be sent first, and the packets of a
+                 * publish batch are collected in the Tx buffer. */
+                if( ( prvFlushTxBuffer( pxConnection ) == pdPASS ) &&
+                    ( pxConnection->ulTxLength == ( uint32_t ) 0 ) &&
+                    ( pxConnection->xTxCorked == pdFALSE ) )
+                {
+                    xSendDirectly = pdTRUE;
+                }
+            #else
+                xSendDirectly = pdTRUE;
+            #endif /* mqttconfigTX_BUFFER_SIZE */
+        }
+
+        if( xSendDirectly == pdTRUE )
+        {
+            for( x = 0; x < ulVectorCount; x++ )
+            {
+                xSocketVectors[ x ].pvBuffer = pxVectors[ x ].pucData;
+                xSocketVectors[ x ].xDataLength = ( size_t ) pxVectors[ x ].ulDataLength;
+            }
+
+            lSendRetVal = SOCKETS_Sendv( pxConnection->xSocket, xSocketVectors, ( size_t ) ulVectorCount, 0 );
+
+            if( lSendRetVal > 0 )
+            {
+                ulBytesSent = ( uint32_t ) lSendRetVal;
+            }
+        }
+
+        /* Send the rest piece by piece, skipping what has already been sent. */
+        ulOffset = ulBytesSent;
+
+        for( x = 0; x < ulVectorCount; x++ )
+        {
+            if( ulOffset >= pxVectors[ x ].ulDataLength )
+            {
+                ulOffset -= pxVectors[ x ].ulDataLength;
+            }
+            else
+            {
+                ulRemainingLength = pxVectors[ x ].ulDataLength - ulOffset;
+                ulPieceBytesSent = prvMQTTSendCallback( pvSendContext, &( pxVectors[ x ].pucData[ ulOffset ] ), ulRemainingLength );
+                ulBytesSent += ulPieceBytesSent;
+                ulOffset = 0;
+
+                /* The next piece must not be started before this one is sent
+                 * completely. */
+                if( ulPieceBytesSent != ulRemainingLength )
+                {
+                    break;
+                }
+            }
+        }
 
-        /* Try sending the remaining data. */
-        lSendRetVal = SOCKETS_Send( pxConnection->xSocket,
-                                    &( pucData[ ulBytesSent ] ),               /* Only send the remaining data. */
-                                    ( size_t ) ( ulDataLength - ulBytesSent ), /* Only send the remaining data. */
-                                    0 );
+        return ulBytesSent;
+    }
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+/*-----------------------------------------------------------*/
 
-        /* A negative return value from SOCKETS_Send
-         * means some error occurred. */
-        if( lSendRetVal < 0 )
+#if ( mqttconfigTX_BUFFER_SIZE > 0 )
+
+    static BaseType_t prvFlushTxBuffer( MQTTBrokerConnection_t * const pxConnection )
+    {
+        BaseType_t xStatus = pdPASS;
+        int32_t lSendRetVal;
+        uint32_t ulContiguousLength;
+
+        while( pxConnection->ulTxLength > ( uint32_t ) 0 )
         {
-            /* Since the socket is non-blocking, send can return
-             * SOCKETS_EWOULDBLOCK, in which case we retry again until
-             * timeout. In case of any other error, we stop re-trying. */
-            if( lSendRetVal != SOCKETS_EWOULDBLOCK )
+            /* Send the pending bytes up to the end of the circular buffer. */
+            ulContiguousLength = configMIN( pxConnection->ulTxLength, ( uint32_t ) mqttconfigTX_BUFFER_SIZE - pxConnection->ulTxHead );
+
+            lSendRetVal = SOCKETS_Send( pxConnection->xSocket,
+                                        &( pxConnection->ucTxBuffer[ pxConnection->ulTxHead ] ),
+                                        ( size_t ) ulContiguousLength,
+                                        0 );
+
+            if( lSendRetVal > 0 )
             {
+                pxConnection->ulTxHead = ( pxConnection->ulTxHead + ( uint32_t ) lSendRetVal ) % ( uint32_t ) mqttconfigTX_BUFFER_SIZE;
+                pxConnection->ulTxLength -= ( uint32_t ) lSendRetVal;
+            }
+            else
+            {
+                /* The socket cannot accept more data now. Any error other than
+                 * SOCKETS_EWOULDBLOCK is reported to the caller. */
+                if( ( lSendRetVal < 0 ) && ( lSendRetVal != SOCKETS_EWOULDBLOCK ) )
+                {
+                    xStatus = pdFAIL;
+                }
+
                 break;
             }
         }
+
+        /* Start from the beginning of the buffer when it is empty so that the
+         * subsequently queued bytes are sent in as few calls as possible. */
+        if( pxConnection->ulTxLength == ( uint32_t ) 0 )
+        {
+            pxConnection->ulTxHead = 0;
+        }
+
+        return xStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    static int32_t prvSendOrQueueData( MQTTBrokerConnection_t * const pxConnection,
+                                       const uint8_t * const pucData,
+                                       uint32_t ulDataLength )
+    {
+        uint32_t ulBytesSent = 0, ulBytesToQueue, ulTail, ulContiguousLength;
+        int32_t lSendRetVal = 0;
+
+        /* Bytes queued earlier must be sent first. */
+        if( prvFlushTxBuffer( pxConnection ) == pdFAIL )
+        {
+            lSendRetVal = SOCKETS_SOCKET_ERROR;
+        }
         else
         {
-            /* Update the count of sent bytes. */
-            ulBytesSent += ( uint32_t ) lSendRetVal;
+            /* Send directly if nothing is pending, unless the packets of a
+             * publish batch are being collected. */
+            if( ( pxConnection->ulTxLength == ( uint32_t ) 0 ) && ( pxConnection->xTxCorked == pdFALSE ) )
+            {
+                lSendRetVal = SOCKETS_Send( pxConnection->xSocket, pucData, ( size_t ) ulDataLength, 0 );
+
+                if( lSendRetVal > 0 )
+                {
+                    ulBytesSent = ( uint32_t ) lSendRetVal;
+                }
+            }
+
+            /* Queue as much of what could not be sent as fits, unless an
+             * error occurred. */
+            if( ( lSendRetVal >= 0 ) || ( lSendRetVal == SOCKETS_EWOULDBLOCK ) )
+            {
+                ulBytesToQueue = configMIN( ulDataLength - ulBytesSent, ( uint32_t ) mqttconfigTX_BUFFER_SIZE - pxConnection->ulTxLength );
+
+                while( ulBytesToQueue > ( uint32_t ) 0 )
+                {
+                    ulTail = ( pxConnection->ulTxHead + pxConnection->ulTxLength ) % ( uint32_t ) mqttconfigTX_BUFFER_SIZE;
+                    ulContiguousLength = configMIN( ulBytesToQueue, ( uint32_t ) mqttconfigTX_BUFFER_SIZE - ulTail );
+
+                    memcpy( &( pxConnection->ucTxBuffer[ ulTail ] ), &( pucData[ ulBytesSent ] ), ( size_t ) ulContiguousLength );
+                    pxConnection->ulTxLength += ulContiguousLength;
+                    ulBytesSent += ulContiguousLength;
+                    ulBytesToQueue -= ulContiguousLength;
+                }
+
+                lSendRetVal = ( int32_t ) ulBytesSent;
+            }
         }
+
+        return lSendRetVal;
     }
 
-    return ulBytesSent;
-}
+#endif /* mqttconfigTX_BUFFER_SIZE */
 /*-----------------------------------------------------------*/
 static MQTTBool_t prvMQTTEventCallback( void * pvCallbackContext,
                                         const MQTTEventCallbackParams_t * const pxParams )
@@ -727,6 +1278,13 @@ static MQTTBool_t prvMQTTEventCallback( void * pvCallbackContext,
             prvProcessReceivedDisconnect( pxConnection, pxParams );
             break;
 
+        #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+            case eMQTTPublishStreamHeader:
+            case eMQTTPublishStreamChunk:
+                prvProcessReceivedPublishStream( pxConnection, pxParams );
+                break;
+        #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
         case eMQTTPacketDropped:
             mqttconfigDEBUG_LOG( ( "[WARN] MQTT Agent dropped a packet. No buffer available.\r\n" ) );
             mqttconfigDEBUG_LOG( ( "Consider adjusting parameters in aws_bufferpool_config.h.\r\n" ) );
@@ -818,6 +1376,10 @@ static MQTTNotificationData_t * prvStoreNotificationData( MQTTBrokerConnection_t
              * and return. */
             pxNotificationData = &( pxConnection->xWaitingTasks[ x ] );
             memcpy( pxNotificationData, &( pxEventData->xNotificationData ), sizeof( MQTTNotificationData_t ) );
+            pxConnection->xPublishBatches[ x ].pxPublishResults = NULL;
+            prvIndexPacketIdentifier( pxConnection,
+                                      ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( pxNotificationData->ulMessageIdentifier ) ),
+                                      ( uint16_t ) x );
             break;
         }
     }
@@ -826,27 +1388,245 @@ static MQTTNotificationData_t * prvStoreNotificationData( MQTTBrokerConnection_t
 }
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvSlotUsesPacketIdentifier( const MQTTBrokerConnection_t * const pxConnection,
+                                               uint16_t usSlot,
+                                               uint16_t usPacketIdentifier )
+{
+    BaseType_t xUsed = pdFALSE;
+    uint16_t usFirstPacketIdentifier, usNumPacketIdentifiers = 1;
+
+    if( usSlot < ( uint16_t ) mqttconfigMAX_PARALLEL_OPS )
+    {
+        if( pxConnection->xWaitingTasks[ usSlot ].xTaskToNotify != NULL )
+        {
+            /* The packet identifier constitutes of the top 16 bits of the
+             * message identifier stored in the notification data. */
+            usFirstPacketIdentifier = ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( pxConnection->xWaitingTasks[ usSlot ].ulMessageIdentifier ) );
+
+            /* The messages of a publish batch use consecutive packet
+             * identifiers, which never wrap around. */
+            if( pxConnection->xPublishBatches[ usSlot ].pxPublishResults != NULL )
+            {
+                usNumPacketIdentifiers = pxConnection->xPublishBatches[ usSlot ].usNumPublishes;
+            }
+
+            if( ( usPacketIdentifier >= usFirstPacketIdentifier ) &&
+                ( ( uint32_t ) usPacketIdentifier < ( ( uint32_t ) usFirstPacketIdentifier + ( uint32_t ) usNumPacketIdentifiers ) ) )
+            {
+                xUsed = pdTRUE;
+            }
+        }
+    }
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+        else
+        {
+            usSlot -= ( uint16_t ) mqttconfigMAX_PARALLEL_OPS;
+
+            if( ( pxConnection->xAsyncPublishes[ usSlot ].xState == eMQTTAsyncPublishWaitingForPUBACK ) &&
+                ( pxConnection->xAsyncPublishes[ usSlot ].usPacketIdentifier == usPacketIdentifier ) )
+            {
+                xUsed = pdTRUE;
+            }
+        }
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+    return xUsed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIndexPacketIdentifier( MQTTBrokerConnection_t * const pxConnection,
+                                      uint16_t usPacketIdentifier,
+                                      uint16_t usSlot )
+{
+    UBaseType_t x, uxIndex = ( UBaseType_t ) usPacketIdentifier % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+    MQTTPacketIdentifierIndexEntry_t * pxEntry;
+
+    /* There are always unused or removed entries as the index has more
+     * entries than packet identifiers can be waiting for an ACK. */
+    for( x = 0; x < ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE; x++ )
+    {
+        pxEntry = &( pxConnection->xPacketIdentifierIndex[ uxIndex ] );
+
+        if( ( pxEntry->usPacketIdentifier == ( uint16_t ) 0 ) ||
+            ( pxEntry->usSlot == mqttNO_SLOT ) ||
+            ( pxEntry->usPacketIdentifier == usPacketIdentifier ) )
+        {
+            pxEntry->usPacketIdentifier = usPacketIdentifier;
+            pxEntry->usSlot = usSlot;
+            break;
+        }
+
+        uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+    }
+
+    configASSERT( x < ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvLookUpPacketIdentifier( const MQTTBrokerConnection_t * const pxConnection,
+                                           uint16_t usPacketIdentifier )
+{
+    UBaseType_t x, uxIndex = ( UBaseType_t ) usPacketIdentifier % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+    const MQTTPacketIdentifierIndexEntry_t * pxEntry;
+    uint16_t usSlot = mqttNO_SLOT;
+
+    /* A packet identifier can only be stored before the first entry
+     * which has never been used. */
+    for( x = 0; x < ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE; x++ )
+    {
+        pxEntry = &( pxConnection->xPacketIdentifierIndex[ uxIndex ] );
+
+        if( pxEntry->usPacketIdentifier == ( uint16_t ) 0 )
+        {
+            break;
+        }
+
+        if( ( pxEntry->usPacketIdentifier == usPacketIdentifier ) && ( pxEntry->usSlot != mqttNO_SLOT ) )
+        {
+            /* Only trust the entry if the slot still waits for the packet
+             * identifier. */
+            if( prvSlotUsesPacketIdentifier( pxConnection, pxEntry->usSlot, usPacketIdentifier ) == pdTRUE )
+            {
+                usSlot = pxEntry->usSlot;
+            }
+
+            break;
+        }
+
+        uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+    }
+
+    return usSlot;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemovePacketIdentifier( MQTTBrokerConnection_t * const pxConnection,
+                                       uint16_t usPacketIdentifier )
+{
+    UBaseType_t x, uxIndex = ( UBaseType_t ) usPacketIdentifier % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+    MQTTPacketIdentifierIndexEntry_t * pxEntry;
+
+    for( x = 0; x < ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE; x++ )
+    {
+        pxEntry = &( pxConnection->xPacketIdentifierIndex[ uxIndex ] );
+
+        if( pxEntry->usPacketIdentifier == ( uint16_t ) 0 )
+        {
+            break;
+        }
+
+        if( ( pxEntry->usPacketIdentifier == usPacketIdentifier ) && ( pxEntry->usSlot != mqttNO_SLOT ) )
+        {
+            /* Leave a tombstone, so that the lookup of the packet identifiers
+             * stored after this entry does not stop here. If no probe
+             * sequence continues past this entry, it can be emptied. */
+            uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+
+            if( pxConnection->xPacketIdentifierIndex[ uxIndex ].usPacketIdentifier == ( uint16_t ) 0 )
+            {
+                pxEntry->usPacketIdentifier = 0;
+            }
+
+            pxEntry->usSlot = mqttNO_SLOT;
+            break;
+        }
+
+        uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) % ( UBaseType_t ) mqttPACKET_IDENTIFIER_INDEX_SIZE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReturnNotificationData( MQTTBrokerConnection_t * const pxConnection,
+                                       MQTTNotificationData_t * const pxNotificationData )
+{
+    prvRemovePacketIdentifier( pxConnection, ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( pxNotificationData->ulMessageIdentifier ) ) );
+    pxNotificationData->xTaskToNotify = NULL;
+}
+/*-----------------------------------------------------------*/
+
 static MQTTNotificationData_t * prvRetrieveNotificationData( MQTTBrokerConnection_t * const pxConnection,
                                                              uint16_t usPacketIdentifier )
 {
-    UBaseType_t x;
     MQTTNotificationData_t * pxNotificationData = NULL;
+    uint16_t usSlot;
 
-    /* Iterate over all the buffers to see if there is one matching the
-     * packet identifier. Note that the packet identifier constitutes of the
-     * top 16 bits of the message identifier stored in the notification data. */
-    for( x = 0; x < ( UBaseType_t ) mqttconfigMAX_PARALLEL_OPS; x++ )
+    usSlot = prvLookUpPacketIdentifier( pxConnection, usPacketIdentifier );
+
+    /* Asynchronous publishes have no notification data. */
+    if( usSlot < ( uint16_t ) mqttconfigMAX_PARALLEL_OPS )
+    {
+        pxNotificationData = &( pxConnection->xWaitingTasks[ usSlot ] );
+        prvRemovePacketIdentifier( pxConnection, usPacketIdentifier );
+    }
+
+    return pxNotificationData;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUpdatePublishBatch( MQTTBrokerConnection_t * const pxConnection,
+                                         MQTTNotificationData_t * const pxNotificationData,
+                                         uint16_t usPacketIdentifier,
+                                         MQTTAgentReturnCode_t xResult )
+{
+    BaseType_t xIsBatch = pdFALSE;
+    MQTTPublishBatch_t * pxBatch;
+    uint16_t usFirstPacketIdentifier;
+
+    /* The batch state is stored at the same index as the notification data. */
+    pxBatch = &( pxConnection->xPublishBatches[ pxNotificationData - &( pxConnection->xWaitingTasks[ 0 ] ) ] );
+
+    if( pxBatch->pxPublishResults != NULL )
     {
-        if( ( pxConnection->xWaitingTasks[ x ].xTaskToNotify != NULL ) &&
-            ( usPacketIdentifier == ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( pxConnection->xWaitingTasks[ x ].ulMessageIdentifier ) ) ) )
+        xIsBatch = pdTRUE;
+        usFirstPacketIdentifier = ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( pxNotificationData->ulMessageIdentifier ) );
+
+        pxBatch->pxPublishResults[ usPacketIdentifier - usFirstPacketIdentifier ] = xResult;
+        pxBatch->usPendingPUBACKs--;
+
+        /* Inform the task once the last QoS1 message is done with. */
+        if( pxBatch->usPendingPUBACKs == ( uint16_t ) 0 )
         {
-            /* We found the notification data, return it. */
-            pxNotificationData = &( pxConnection->xWaitingTasks[ x ] );
+            prvCompletePublishBatch( pxNotificationData, pxBatch->pxPublishResults, ( uint32_t ) pxBatch->usNumPublishes, eMQTTPUBACKReceived );
+            pxBatch->pxPublishResults = NULL;
+        }
+    }
+
+    return xIsBatch;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCompletePublishBatch( MQTTNotificationData_t * const pxNotificationData,
+                                     const MQTTAgentReturnCode_t * const pxPublishResults,
+                                     uint32_t ulNumPublishes,
+                                     MQTTNotifyCodes_t xSuccessCode )
+{
+    uint32_t x;
+    MQTTNotifyCodes_t xNotificationCode = xSuccessCode;
+    BaseType_t xStatus = pdPASS;
+
+    /* A timeout takes precedence over any other failure so that the
+     * application task can distinguish it. */
+    for( x = 0; x < ulNumPublishes; x++ )
+    {
+        if( pxPublishResults[ x ] == eMQTTAgentTimeout )
+        {
+            xNotificationCode = eMQTTOperationTimedOut;
+            xStatus = pdFAIL;
             break;
         }
+        else if( pxPublishResults[ x ] != eMQTTAgentSuccess )
+        {
+            xNotificationCode = eMQTTPUBCouldNotBeSent;
+            xStatus = pdFAIL;
+        }
+        else
+        {
+            /* This message succeeded. */
+        }
     }
 
-    return pxNotificationData;
+    prvNotifyRequestingTask( pxNotificationData, xNotificationCode, xStatus );
 }
 /*-----------------------------------------------------------*/
 
@@ -998,6 +1778,12 @@ static void prvGracefulSocketClose( MQTTBrokerConnection_t * const pxConnection
      * entered. */
     vTaskSetTimeOutState( &xTimeOut );
 
+    #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+        /* Try to send the bytes still pending, like a DISCONNECT message,
+         * before shutting down the connection. */
+        ( void ) prvFlushTxBuffer( pxConnection );
+    #endif /* mqttconfigTX_BUFFER_SIZE */
+
     /* Shutdown the connection. */
     ( void ) SOCKETS_Shutdown( pxConnection->xSocket, SOCKETS_SHUT_RDWR );
 
@@ -1020,6 +1806,12 @@ static void prvGracefulSocketClose( MQTTBrokerConnection_t * const pxConnection
     pxConnection->xSocket = SOCKETS_INVALID_SOCKET;
     mqttconfigDEBUG_LOG( ( "Socket closed.\r\n" ) );
 
+    #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+        /* Discard the bytes which could not be sent. */
+        pxConnection->ulTxHead = 0;
+        pxConnection->ulTxLength = 0;
+    #endif /* mqttconfigTX_BUFFER_SIZE */
+
     #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
         {
             /* Print the stack high watermark for the MQTT task. */
@@ -1042,6 +1834,10 @@ static void prvMQTTClientSocketWakeupCallback( Socket_t pxSocket )
      * created! */
     configASSERT( xMQTTTaskHandle );
 
+    /* Unblock the MQTT task if it is waiting in prvMQTTSendCallback() for the
+     * socket to accept more data. */
+    ( void ) xTaskNotifyGive( xMQTTTaskHandle );
+
     /* A socket used by the MQTT task may need attention.  Send an event
      * to the MQTT task to make sure the task is not blocked on xCommandQueue.
      * There is only any need to do this if there are no messages already in the
@@ -1144,10 +1940,22 @@ static void prvProcessReceivedPUBACK( MQTTBrokerConnection_t * const pxConnectio
     /* If there is no task waiting for it, ignore it. */
     if( pxNotificationData != NULL )
     {
-        /* Otherwise inform the task. */
-        mqttconfigDEBUG_LOG( ( "MQTT Publish was successful.\r\n" ) );
-        prvNotifyRequestingTask( pxNotificationData, eMQTTPUBACKReceived, pdPASS );
+        /* Otherwise inform the task, unless other messages of the same
+         * publish batch are still waiting for a PUBACK. */
+        if( prvUpdatePublishBatch( pxConnection, pxNotificationData, pxParams->u.xMQTTPubACKData.usPacketIdentifier, eMQTTAgentSuccess ) == pdFALSE )
+        {
+            mqttconfigDEBUG_LOG( ( "MQTT Publish was successful.\r\n" ) );
+            prvNotifyRequestingTask( pxNotificationData, eMQTTPUBACKReceived, pdPASS );
+        }
     }
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+        else
+        {
+            /* The PUBACK may be for an asynchronous publish. */
+            prvProcessAsyncPublishResult( pxConnection, pxParams->u.xMQTTPubACKData.usPacketIdentifier, eMQTTAgentSuccess );
+        }
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1174,6 +1982,35 @@ static BaseType_t prvProcessReceivedPublish( MQTTBrokerConnection_t * const pxCo
 }
 /*-----------------------------------------------------------*/
 
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+    static void prvProcessReceivedPublishStream( MQTTBrokerConnection_t * const pxConnection,
+                                                 const MQTTEventCallbackParams_t * const pxParams )
+    {
+        MQTTAgentCallbackParams_t xCallbackParams;
+
+        if( pxConnection->pxCallback != NULL )
+        {
+            if( pxParams->xEventType == eMQTTPublishStreamHeader )
+            {
+                xCallbackParams.xMQTTEvent = eMQTTAgentPublishStreamHeader;
+                xCallbackParams.u.xPublishData = pxParams->u.xPublishData;
+            }
+            else
+            {
+                xCallbackParams.xMQTTEvent = eMQTTAgentPublishStreamChunk;
+                xCallbackParams.u.xPublishChunkData = pxParams->u.xPublishChunkData;
+            }
+
+            /* There is no buffer to take the ownership of and therefore
+             * the return value is ignored. */
+            ( void ) pxConnection->pxCallback( pxConnection->pvUserData, &( xCallbackParams ) );
+        }
+    }
+
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+/*-----------------------------------------------------------*/
+
 static void prvProcessReceivedTimeout( MQTTBrokerConnection_t * const pxConnection,
                                        const MQTTEventCallbackParams_t * const pxParams )
 {
@@ -1187,8 +2024,19 @@ static void prvProcessReceivedTimeout( MQTTBrokerConnection_t * const pxConnecti
     if( pxNotificationData != NULL )
     {
         mqttconfigDEBUG_LOG( ( "MQTT Timeout.\r\n" ) );
-        prvNotifyRequestingTask( pxNotificationData, eMQTTOperationTimedOut, pdFAIL );
+
+        if( prvUpdatePublishBatch( pxConnection, pxNotificationData, pxParams->u.xTimeoutData.usPacketIdentifier, eMQTTAgentTimeout ) == pdFALSE )
+        {
+            prvNotifyRequestingTask( pxNotificationData, eMQTTOperationTimedOut, pdFAIL );
+        }
     }
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+        else
+        {
+            prvProcessAsyncPublishResult( pxConnection, pxParams->u.xTimeoutData.usPacketIdentifier, eMQTTAgentTimeout );
+        }
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1232,6 +2080,21 @@ static void prvProcessReceivedDisconnect( MQTTBrokerConnection_t * const pxConne
                                      pdFAIL );
         }
     }
+
+    /* Likewise fail the asynchronous publishes waiting for a PUBACK. The
+     * ones still in the command queue fail when they are processed. */
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+        for( x = 0; x < ( UBaseType_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+        {
+            if( pxConnection->xAsyncPublishes[ x ].xState == eMQTTAsyncPublishWaitingForPUBACK )
+            {
+                prvCompleteAsyncPublish( &( pxConnection->xAsyncPublishes[ x ] ), eMQTTAgentFailure );
+            }
+        }
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+    /* No slot waits for an ACK anymore. */
+    memset( pxConnection->xPacketIdentifierIndex, 0x00, sizeof( pxConnection->xPacketIdentifierIndex ) );
 }
 /*-----------------------------------------------------------*/
 
@@ -1318,6 +2181,17 @@ static TickType_t prvManageConnections( void )
                  * to call MQTT_Periodic and calculate xNextTimeoutTicks
                  * accordingly. */
             }
+
+            #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+                /* Send the bytes pending in the Tx buffer, if the socket can
+                 * accept them now. If it cannot, the socket wakeup callback
+                 * unblocks the MQTT task once it becomes writable. In case of
+                 * an error, disconnect from the broker. */
+                if( ( pxConnection->xSocket != SOCKETS_INVALID_SOCKET ) && ( prvFlushTxBuffer( pxConnection ) == pdFAIL ) )
+                {
+                    ( void ) MQTT_Disconnect( &( pxConnection->xMQTTContext ) );
+                }
+            #endif /* mqttconfigTX_BUFFER_SIZE */
         }
 
         /* Is the client connected? */
@@ -1426,7 +2300,7 @@ static void prvInitiateMQTTConnect( MQTTEventData_t * const pxEventData )
         /* If a buffer was used to store notification data, return it. */
         if( pxNotificationData != NULL )
         {
-            pxNotificationData->xTaskToNotify = NULL;
+            prvReturnNotificationData( pxConnection, pxNotificationData );
         }
     }
 }
@@ -1502,7 +2376,7 @@ static void prvInitiateMQTTSubscribe( MQTTEventData_t * const pxEventData )
         /* If a buffer was used to store notification data, return it. */
         if( pxNotificationData != NULL )
         {
-            pxNotificationData->xTaskToNotify = NULL;
+            prvReturnNotificationData( pxConnection, pxNotificationData );
         }
     }
 }
@@ -1553,7 +2427,7 @@ static void prvInitiateMQTTUnSubscribe( MQTTEventData_t * const pxEventData )
         /* If a buffer was used to store notification data, return it. */
         if( pxNotificationData != NULL )
         {
-            pxNotificationData->xTaskToNotify = NULL;
+            prvReturnNotificationData( pxConnection, pxNotificationData );
         }
     }
 }
@@ -1618,9 +2492,255 @@ static void prvInitiateMQTTPublish( MQTTEventData_t * const pxEventData )
         /* If a buffer was used to store notification data, return it. */
         if( pxNotificationData != NULL )
         {
-            pxNotificationData->xTaskToNotify = NULL;
+            prvReturnNotificationData( pxConnection, pxNotificationData );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitiateMQTTPublishBatch( MQTTEventData_t * const pxEventData )
+{
+    const MQTTPublishBatchParams_t * const pxBatchParams = pxEventData->u.pxPublishBatchParams;
+    MQTTNotificationData_t * pxNotificationData = NULL;
+    MQTTPublishBatch_t * pxBatch = NULL;
+    MQTTPublishParams_t xPublishParams;
+    MQTTBrokerConnection_t * pxConnection = &( xMQTTConnections[ pxEventData->uxBrokerNumber ] );
+    uint16_t usFirstPacketIdentifier, usNumQoS1Publishes = 0;
+    uint32_t x;
+
+    usFirstPacketIdentifier = ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( pxEventData->xNotificationData.ulMessageIdentifier ) );
+
+    for( x = 0; x < pxBatchParams->ulNumPublishes; x++ )
+    {
+        if( pxBatchParams->pxPublishParams[ x ].xQoS != eMQTTQoS0 )
+        {
+            usNumQoS1Publishes++;
+        }
+    }
+
+    /* A single buffer stores the notification data for all the QoS1
+     * messages of the batch. No need to store it if there are none. */
+    if( usNumQoS1Publishes > ( uint16_t ) 0 )
+    {
+        pxNotificationData = prvStoreNotificationData( pxConnection, pxEventData );
+
+        if( pxNotificationData != NULL )
+        {
+            pxBatch = &( pxConnection->xPublishBatches[ pxNotificationData - &( pxConnection->xWaitingTasks[ 0 ] ) ] );
+            pxBatch->pxPublishResults = pxBatchParams->pxPublishResults;
+            pxBatch->usNumPublishes = ( uint16_t ) pxBatchParams->ulNumPublishes;
+            pxBatch->usPendingPUBACKs = usNumQoS1Publishes;
+
+            /* The first packet identifier has been indexed already, but
+             * no PUBACK is expected for it if the first message is QoS0. */
+            if( pxBatchParams->pxPublishParams[ 0 ].xQoS == eMQTTQoS0 )
+            {
+                prvRemovePacketIdentifier( pxConnection, usFirstPacketIdentifier );
+            }
+
+            for( x = 1; x < pxBatchParams->ulNumPublishes; x++ )
+            {
+                if( pxBatchParams->pxPublishParams[ x ].xQoS != eMQTTQoS0 )
+                {
+                    prvIndexPacketIdentifier( pxConnection,
+                                              ( uint16_t ) ( usFirstPacketIdentifier + ( uint16_t ) x ),
+                                              ( uint16_t ) ( pxNotificationData - &( pxConnection->xWaitingTasks[ 0 ] ) ) );
+                }
+            }
+        }
+    }
+
+    if( ( pxNotificationData != NULL ) || ( usNumQoS1Publishes == ( uint16_t ) 0 ) )
+    {
+        #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+            /* Collect the packets of the batch so that they are written to
+             * the socket together rather than one small send per message. */
+            pxConnection->xTxCorked = pdTRUE;
+        #endif
+
+        for( x = 0; x < pxBatchParams->ulNumPublishes; x++ )
+        {
+            /* Setup publish parameters and call the Core library publish function. */
+            xPublishParams.pucTopic = pxBatchParams->pxPublishParams[ x ].pucTopic;
+            xPublishParams.usTopicLength = pxBatchParams->pxPublishParams[ x ].usTopicLength;
+            xPublishParams.xQos = pxBatchParams->pxPublishParams[ x ].xQoS;
+            xPublishParams.pvData = pxBatchParams->pxPublishParams[ x ].pvData;
+            xPublishParams.ulDataLength = pxBatchParams->pxPublishParams[ x ].ulDataLength;
+            xPublishParams.usPacketIdentifier = ( uint16_t ) ( usFirstPacketIdentifier + ( uint16_t ) x );
+            xPublishParams.ulTimeoutTicks = pxEventData->xTicksToWait;
+
+            if( MQTT_Publish( &( pxConnection->xMQTTContext ), &( xPublishParams ) ) == eMQTTSuccess )
+            {
+                /* QoS1 messages succeed once the PUBACK is received. */
+                if( xPublishParams.xQos == eMQTTQoS0 )
+                {
+                    pxBatchParams->pxPublishResults[ x ] = eMQTTAgentSuccess;
+                }
+            }
+            else
+            {
+                mqttconfigDEBUG_LOG( ( "MQTT_Publish failed!\r\n" ) );
+
+                /* The result remains eMQTTAgentFailure and no PUBACK is
+                 * expected for this message. */
+                if( xPublishParams.xQos != eMQTTQoS0 )
+                {
+                    pxBatch->usPendingPUBACKs--;
+                    prvRemovePacketIdentifier( pxConnection, xPublishParams.usPacketIdentifier );
+                }
+            }
+        }
+
+        #if ( mqttconfigTX_BUFFER_SIZE > 0 )
+            pxConnection->xTxCorked = pdFALSE;
+
+            /* A send error is detected again and handled by prvManageConnections. */
+            ( void ) prvFlushTxBuffer( pxConnection );
+        #endif
+
+        /* Inform the task immediately if no PUBACK is expected. PUBACKs
+         * are not processed before this function returns. */
+        if( pxBatch == NULL )
+        {
+            prvCompletePublishBatch( &( pxEventData->xNotificationData ), pxBatchParams->pxPublishResults, pxBatchParams->ulNumPublishes, eMQTTPUBSent );
+        }
+        else if( pxBatch->usPendingPUBACKs == ( uint16_t ) 0 )
+        {
+            prvCompletePublishBatch( pxNotificationData, pxBatchParams->pxPublishResults, pxBatchParams->ulNumPublishes, eMQTTPUBACKReceived );
+
+            /* Return the buffer used to store notification data. */
+            pxBatch->pxPublishResults = NULL;
+            prvReturnNotificationData( pxConnection, pxNotificationData );
+        }
+        else
+        {
+            /* The task is informed when the PUBACKs are received. */
+        }
+    }
+    else
+    {
+        mqttconfigDEBUG_LOG( ( "Could not get a buffer to store notification data. Too many parallel tasks!\r\n" ) );
+        prvNotifyRequestingTask( &( pxEventData->xNotificationData ), eMQTTPUBCouldNotBeSent, pdFAIL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+
+    static void prvInitiateMQTTPublishAsync( MQTTEventData_t * const pxEventData )
+    {
+        MQTTAsyncPublish_t * const pxAsyncPublish = pxEventData->u.pxAsyncPublish;
+        MQTTPublishParams_t xPublishParams;
+        MQTTReturnCode_t xReturnCode;
+        MQTTBrokerConnection_t * pxConnection = &( xMQTTConnections[ pxEventData->uxBrokerNumber ] );
+
+        /* Setup publish parameters and call the Core library publish function. */
+        xPublishParams.pucTopic = pxAsyncPublish->xPublishParams.pucTopic;
+        xPublishParams.usTopicLength = pxAsyncPublish->xPublishParams.usTopicLength;
+        xPublishParams.xQos = pxAsyncPublish->xPublishParams.xQoS;
+        xPublishParams.pvData = pxAsyncPublish->xPublishParams.pvData;
+        xPublishParams.ulDataLength = pxAsyncPublish->xPublishParams.ulDataLength;
+        xPublishParams.usPacketIdentifier = pxAsyncPublish->usPacketIdentifier;
+        xPublishParams.ulTimeoutTicks = pxEventData->xTicksToWait;
+
+        /* The payload stays valid until the completion callback is invoked, so
+         * it does not have to be copied into a buffer from the pool. */
+        #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+            xReturnCode = MQTT_PublishZeroCopy( &( pxConnection->xMQTTContext ), &( xPublishParams ) );
+        #else
+            xReturnCode = MQTT_Publish( &( pxConnection->xMQTTContext ), &( xPublishParams ) );
+        #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+        if( xReturnCode == eMQTTSuccess )
+        {
+            if( xPublishParams.xQos == eMQTTQoS0 )
+            {
+                /* No PUBACK is expected. */
+                prvCompleteAsyncPublish( pxAsyncPublish, eMQTTAgentSuccess );
+            }
+            else
+            {
+                /* PUBACKs are not processed before this function returns. */
+                pxAsyncPublish->xState = eMQTTAsyncPublishWaitingForPUBACK;
+                prvIndexPacketIdentifier( pxConnection,
+                                          pxAsyncPublish->usPacketIdentifier,
+                                          ( uint16_t ) ( ( pxAsyncPublish - &( pxConnection->xAsyncPublishes[ 0 ] ) ) + mqttconfigMAX_PARALLEL_OPS ) );
+            }
+        }
+        else
+        {
+            mqttconfigDEBUG_LOG( ( "MQTT_Publish failed!\r\n" ) );
+            prvCompleteAsyncPublish( pxAsyncPublish, eMQTTAgentFailure );
+        }
+    }
+
+#endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+
+    static void prvProcessAsyncPublishResult( MQTTBrokerConnection_t * const pxConnection,
+                                              uint16_t usPacketIdentifier,
+                                              MQTTAgentReturnCode_t xResult )
+    {
+        uint16_t usSlot;
+
+        usSlot = prvLookUpPacketIdentifier( pxConnection, usPacketIdentifier );
+
+        /* If nothing is waiting for it, ignore it. */
+        if( ( usSlot != mqttNO_SLOT ) && ( usSlot >= ( uint16_t ) mqttconfigMAX_PARALLEL_OPS ) )
+        {
+            prvRemovePacketIdentifier( pxConnection, usPacketIdentifier );
+            prvCompleteAsyncPublish( &( pxConnection->xAsyncPublishes[ usSlot - ( uint16_t ) mqttconfigMAX_PARALLEL_OPS ] ), xResult );
+        }
+    }
+
+#endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+
+    static void prvCompleteAsyncPublish( MQTTAsyncPublish_t * const pxAsyncPublish,
+                                         MQTTAgentReturnCode_t xResult )
+    {
+        MQTTAgentPublishCompleteCallback_t xCompleteCallback = pxAsyncPublish->xCompleteCallback;
+        void * pvCallbackContext = pxAsyncPublish->pvCallbackContext;
+
+        taskENTER_CRITICAL();
+        {
+            pxAsyncPublish->xState = eMQTTAsyncPublishFree;
+        }
+        taskEXIT_CRITICAL();
+
+        if( xCompleteCallback != NULL )
+        {
+            xCompleteCallback( pvCallbackContext, xResult );
         }
     }
+
+#endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+/*-----------------------------------------------------------*/
+
+static uint32_t prvReserveMessageIdentifiers( uint32_t ulNumMessageIdentifiers )
+{
+    uint32_t ulMessageIdentifier;
+
+    /* The identifier uses the top 16-bits of the 32-bit word, leaving the
+     * lowest 16-bits free for use by the MQTT task to return a status code. */
+    if( ( ulNumMessageIdentifiers * mqttMESSAGE_IDENTIFIER_MIN ) > ( mqttMESSAGE_IDENTIFIER_MAX - ulQueueMessageIdentifier ) )
+    {
+        ulQueueMessageIdentifier = mqttMESSAGE_IDENTIFIER_MIN;
+    }
+
+    ulMessageIdentifier = ulQueueMessageIdentifier;
+    ulQueueMessageIdentifier += ulNumMessageIdentifiers * mqttMESSAGE_IDENTIFIER_MIN;
+
+    if( ulQueueMessageIdentifier >= mqttMESSAGE_IDENTIFIER_MAX )
+    {
+        ulQueueMessageIdentifier = mqttMESSAGE_IDENTIFIER_MIN;
+    }
+
+    return ulMessageIdentifier;
 }
 /*-----------------------------------------------------------*/
 
@@ -1628,7 +2748,7 @@ static MQTTAgentReturnCode_t prvSendCommandToMQTTTask( MQTTEventData_t * pxEvent
 {
     BaseType_t xReturn;
     MQTTAgentReturnCode_t xReturnCode = eMQTTAgentFailure;
-    uint32_t ulReceivedMessageIdentifier;
+    uint32_t ulReceivedMessageIdentifier, ulNumMessageIdentifiers = 1;
 
     /* Should not try to send commands until after the MQTT task has been
      * initialized, in which case the command queue will have been created. */
@@ -1647,16 +2767,14 @@ static MQTTAgentReturnCode_t prvSendCommandToMQTTTask( MQTTEventData_t * pxEvent
         {
             /* The message identifier is used to know which message is being
              * acknowledged.  A critical region is used as a single message identifier
-             * variable is used by all connections. The identifier uses the top 16-bits
-             * of the 32-bit word, leaving the lowest 16-bits free for use by the MQTT
-             * task to return a status code. */
-            pxEventData->xNotificationData.ulMessageIdentifier = ulQueueMessageIdentifier;
-            ulQueueMessageIdentifier += mqttMESSAGE_IDENTIFIER_MIN;
-
-            if( ulQueueMessageIdentifier >= mqttMESSAGE_IDENTIFIER_MAX )
+             * variable is used by all connections. A publish batch reserves one
+             * identifier per message. */
+            if( pxEventData->xEventType == eMQTTPublishBatchRequest )
             {
-                ulQueueMessageIdentifier = mqttMESSAGE_IDENTIFIER_MIN;
+                ulNumMessageIdentifiers = pxEventData->u.pxPublishBatchParams->ulNumPublishes;
             }
+
+            pxEventData->xNotificationData.ulMessageIdentifier = prvReserveMessageIdentifiers( ulNumMessageIdentifiers );
         }
         taskEXIT_CRITICAL();
 
@@ -1741,9 +2859,91 @@ static MQTTAgentReturnCode_t prvSendCommandToMQTTTask( MQTTEventData_t * pxEvent
 }
 /*-----------------------------------------------------------*/
 
+static void prvProcessCommand( MQTTEventData_t * const pxCommand )
+{
+    mqttconfigDEBUG_LOG( ( "Received message %x from queue.\r\n", pxCommand->xNotificationData.ulMessageIdentifier ) );
+
+    /* The connection index identifies the broker to communicate with -
+     * starting from an index of 0.  Check the index is valid here so
+     * functions further down the call tree don't have to.  A check is
+     * performed before messages are sent to the command queue anyway. */
+    configASSERT( pxCommand->uxBrokerNumber < ( UBaseType_t ) mqttconfigMAX_BROKERS );
+
+    /* Check if the timeout for the event has been reached.
+     * It means that the MQTT task picked up this command for
+     * processing too late and there is no point in proceeding.
+     * Fail the operation with timeout and unblock the waiting
+     * task. */
+    if( xTaskCheckForTimeOut( &( pxCommand->xEventCreationTimestamp ), &( pxCommand->xTicksToWait ) ) == pdTRUE )
+    {
+        /* Note that in case of eMQTTServiceSocket event, the
+         * pxCommand->xNotificationData.xTaskToNotify happens to
+         * be NULL and therefore prvNotifyRequestingTask returns
+         * without doing anything. */
+        prvNotifyRequestingTask( &( pxCommand->xNotificationData ), eMQTTOperationTimedOut, pdFAIL );
+
+        /* No task waits for an asynchronous publish, so it is
+         * completed instead. */
+        #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+            if( pxCommand->xEventType == eMQTTPublishAsyncRequest )
+            {
+                prvCompleteAsyncPublish( pxCommand->u.pxAsyncPublish, eMQTTAgentTimeout );
+            }
+        #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+    }
+    else
+    {
+        /* Process the received command. Note that the xTicksToWait
+         * has been updated in the previous call to xTaskCheckForTimeout
+         * to ensure that we block only for the duration specified by the
+         * user. */
+        switch( pxCommand->xEventType )
+        {
+            case eMQTTConnectRequest:
+                prvInitiateMQTTConnect( pxCommand );
+                break;
+
+            case eMQTTDisconnectRequest:
+                prvInitiateMQTTDisconnect( pxCommand );
+                break;
+
+            case eMQTTSubscribeRequest:
+                prvInitiateMQTTSubscribe( pxCommand );
+                break;
+
+            case eMQTTUnsubscribeRequest:
+                prvInitiateMQTTUnSubscribe( pxCommand );
+                break;
+
+            case eMQTTPublishRequest:
+                prvInitiateMQTTPublish( pxCommand );
+                break;
+
+            case eMQTTPublishBatchRequest:
+                prvInitiateMQTTPublishBatch( pxCommand );
+                break;
+
+            #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+                case eMQTTPublishAsyncRequest:
+                    prvInitiateMQTTPublishAsync( pxCommand );
+                    break;
+            #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+            default:
+                /* Anything else is illegal. */
+                mqttconfigDEBUG_LOG( ( "Unknown request received on command queue.\r\n" ) );
+                break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
 static void prvMQTTTask( void * pvParameters )
 {
-    MQTTEventData_t xMQTTCommand;
+    /* The commands are copied out of the command queue in one go. The array
+     * is static so that it does not add to the stack of the MQTT task. */
+    static MQTTEventData_t xMQTTCommands[ mqttCOMMAND_QUEUE_LENGTH ];
+    UBaseType_t uxCommandCount, x;
     TickType_t xNextTimeoutTicks = 0;
 
     /* Remove compiler warnings about unused parameters. */
@@ -1751,63 +2951,11 @@ static void prvMQTTTask( void * pvParameters )
 
     for( ; ; )
     {
-        if( xQueueReceive( xCommandQueue, &xMQTTCommand, xNextTimeoutTicks ) != pdFALSE )
-        {
-            mqttconfigDEBUG_LOG( ( "Received message %x from queue.\r\n", xMQTTCommand.xNotificationData.ulMessageIdentifier ) );
+        uxCommandCount = xQueueReceiveMultiple( xCommandQueue, xMQTTCommands, mqttCOMMAND_QUEUE_LENGTH, xNextTimeoutTicks );
 
-            /* The connection index identifies the broker to communicate with -
-             * starting from an index of 0.  Check the index is valid here so
-             * functions further down the call tree don't have to.  A check is
-             * performed before messages are sent to the command queue anyway. */
-            configASSERT( xMQTTCommand.uxBrokerNumber < ( UBaseType_t ) mqttconfigMAX_BROKERS );
-
-            /* Check if the timeout for the event has been reached.
-             * It means that the MQTT task picked up this command for
-             * processing too late and there is no point in proceeding.
-             * Fail the operation with timeout and unblock the waiting
-             * task. */
-            if( xTaskCheckForTimeOut( &( xMQTTCommand.xEventCreationTimestamp ), &( xMQTTCommand.xTicksToWait ) ) == pdTRUE )
-            {
-                /* Note that in case of eMQTTServiceSocket event, the
-                 * xMQTTCommand.xNotificationData.xTaskToNotify happens to
-                 * be NULL and therefore prvNotifyRequestingTask returns
-                 * without doing anything. */
-                prvNotifyRequestingTask( &( xMQTTCommand.xNotificationData ), eMQTTOperationTimedOut, pdFAIL );
-            }
-            else
-            {
-                /* Process the received command. Note that the xTicksToWait
-                 * has been updated in the previous call to xTaskCheckForTimeout
-                 * to ensure that we block only for the duration specified by the
-                 * user. */
-                switch( xMQTTCommand.xEventType )
-                {
-                    case eMQTTConnectRequest:
-                        prvInitiateMQTTConnect( &( xMQTTCommand ) );
-                        break;
-
-                    case eMQTTDisconnectRequest:
-                        prvInitiateMQTTDisconnect( &( xMQTTCommand ) );
-                        break;
-
-                    case eMQTTSubscribeRequest:
-                        prvInitiateMQTTSubscribe( &( xMQTTCommand ) );
-                        break;
-
-                    case eMQTTUnsubscribeRequest:
-                        prvInitiateMQTTUnSubscribe( &( xMQTTCommand ) );
-                        break;
-
-                    case eMQTTPublishRequest:
-                        prvInitiateMQTTPublish( &( xMQTTCommand ) );
-                        break;
-
-                    default:
-                        /* Anything else is illegal. */
-                        mqttconfigDEBUG_LOG( ( "Unknown request received on command queue.\r\n" ) );
-                        break;
-                }
-            }
+        for( x = 0; x < uxCommandCount; x++ )
+        {
+            prvProcessCommand( &( xMQTTCommands[ x ] ) );
         }
 
         /* Process active connections each time the queue unblocks.  It might
@@ -1862,6 +3010,9 @@ BaseType_t MQTT_AGENT_Init( void )
             xInitParams.pxCallback = prvMQTTEventCallback;
             xInitParams.pvSendContext = ( void * ) x;     /*lint !e923 The cast is ok as we are passing the index of the client. */
             xInitParams.pxMQTTSendFxn = prvMQTTSendCallback;
+            #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+                xInitParams.pxMQTTSendvFxn = prvMQTTSendvCallback;
+            #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
             xInitParams.pxGetTicksFxn = prvMQTTGetTicks;
             xInitParams.xBufferPoolInterface.pxGetBufferFxn = mqttconfigGET_FREE_BUFFER_FXN;
             xInitParams.xBufferPoolInterface.pxReturnBufferFxn = mqttconfigRETURN_BUFFER_FXN;
@@ -2048,6 +3199,140 @@ MQTTAgentReturnCode_t MQTT_AGENT_Publish( MQTTAgentHandle_t xMQTTHandle,
 }
 /*-----------------------------------------------------------*/
 
+MQTTAgentReturnCode_t MQTT_AGENT_PublishBatch( MQTTAgentHandle_t xMQTTHandle,
+                                               const MQTTAgentPublishParams_t * const pxPublishParams,
+                                               MQTTAgentReturnCode_t * const pxPublishResults,
+                                               uint32_t ulNumPublishes,
+                                               TickType_t xTimeoutTicks )
+{
+    MQTTEventData_t xEventData;
+    MQTTPublishBatchParams_t xPublishBatchParams;
+    MQTTAgentReturnCode_t xReturnCode = eMQTTAgentFailure;
+    uint32_t x;
+
+    if( ( ulNumPublishes > ( uint32_t ) 0 ) && ( ulNumPublishes <= ( uint32_t ) mqttconfigMAX_PUBLISH_BATCH_SIZE ) )
+    {
+        /* Every message fails unless the MQTT task reports otherwise. */
+        for( x = 0; x < ulNumPublishes; x++ )
+        {
+            pxPublishResults[ x ] = eMQTTAgentFailure;
+        }
+
+        /* The batch parameters remain valid as the calling task is blocked
+         * until the MQTT task has completed the batch. */
+        xPublishBatchParams.pxPublishParams = pxPublishParams;
+        xPublishBatchParams.pxPublishResults = pxPublishResults;
+        xPublishBatchParams.ulNumPublishes = ulNumPublishes;
+
+        /* Setup the event to be sent to the command queue. */
+        xEventData.uxBrokerNumber = ( UBaseType_t ) mqttDECODE_BROKER_NUMBER( xMQTTHandle ); /*lint !e923 Opaque pointer. */
+        xEventData.xEventType = eMQTTPublishBatchRequest;
+        xEventData.xTicksToWait = xTimeoutTicks;
+        xEventData.u.pxPublishBatchParams = &( xPublishBatchParams );
+
+        /* Note that the notification data part of xEventData and
+         * xEventCreationTimestamp are set in the following call. */
+        xReturnCode = prvSendCommandToMQTTTask( &xEventData );
+    }
+
+    /* Return the code to the user. */
+    return xReturnCode;
+}
+/*-----------------------------------------------------------*/
+
+MQTTAgentReturnCode_t MQTT_AGENT_PublishAsync( MQTTAgentHandle_t xMQTTHandle,
+                                               const MQTTAgentPublishParams_t * const pxPublishParams,
+                                               MQTTAgentPublishCompleteCallback_t xCompleteCallback,
+                                               void * pvCallbackContext,
+                                               TickType_t xTimeoutTicks )
+{
+    MQTTAgentReturnCode_t xReturnCode = eMQTTAgentFailure;
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+        MQTTEventData_t xEventData;
+        MQTTBrokerConnection_t * pxConnection;
+        MQTTAsyncPublish_t * pxAsyncPublish = NULL;
+        TickType_t xTicksToWaitForQueue = xTimeoutTicks;
+        UBaseType_t x;
+
+        /* Should not try to send commands until after the MQTT task has been
+         * initialized, in which case the command queue will have been created. */
+        configASSERT( xCommandQueue );
+
+        xEventData.uxBrokerNumber = ( UBaseType_t ) mqttDECODE_BROKER_NUMBER( xMQTTHandle ); /*lint !e923 Opaque pointer. */
+        pxConnection = &( xMQTTConnections[ xEventData.uxBrokerNumber ] );
+
+        /* Reserve an entry of the in-flight window and a message identifier. */
+        taskENTER_CRITICAL();
+        {
+            for( x = 0; x < ( UBaseType_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+            {
+                if( pxConnection->xAsyncPublishes[ x ].xState == eMQTTAsyncPublishFree )
+                {
+                    pxAsyncPublish = &( pxConnection->xAsyncPublishes[ x ] );
+                    pxAsyncPublish->xState = eMQTTAsyncPublishQueued;
+                    xEventData.xNotificationData.ulMessageIdentifier = prvReserveMessageIdentifiers( 1 );
+                    break;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxAsyncPublish != NULL )
+        {
+            pxAsyncPublish->xPublishParams = *pxPublishParams;
+            pxAsyncPublish->xCompleteCallback = xCompleteCallback;
+            pxAsyncPublish->pvCallbackContext = pvCallbackContext;
+            pxAsyncPublish->usPacketIdentifier = ( uint16_t ) ( mqttMESSAGE_IDENTIFIER_EXTRACT( xEventData.xNotificationData.ulMessageIdentifier ) );
+
+            /* Setup the event to be sent to the command queue. No task waits
+             * for the result, which is reported to the completion callback. */
+            xEventData.xNotificationData.xTaskToNotify = NULL;
+            xEventData.xEventType = eMQTTPublishAsyncRequest;
+            xEventData.xTicksToWait = xTimeoutTicks;
+            xEventData.u.pxAsyncPublish = pxAsyncPublish;
+            vTaskSetTimeOutState( &( xEventData.xEventCreationTimestamp ) );
+
+            /* The MQTT task cannot wait for space in its own command queue,
+             * which is the case if this is called from a completion callback. */
+            if( xTaskGetCurrentTaskHandle() == xMQTTTaskHandle )
+            {
+                xTicksToWaitForQueue = 0;
+            }
+
+            if( xQueueSendToBack( xCommandQueue, &xEventData, xTicksToWaitForQueue ) != pdFALSE )
+            {
+                xReturnCode = eMQTTAgentSuccess;
+            }
+            else
+            {
+                /* Release the entry without invoking the callback. */
+                taskENTER_CRITICAL();
+                {
+                    pxAsyncPublish->xState = eMQTTAsyncPublishFree;
+                }
+                taskEXIT_CRITICAL();
+
+                xReturnCode = eMQTTAgentTimeout;
+            }
+        }
+        else
+        {
+            mqttconfigDEBUG_LOG( ( "Too many asynchronous publishes in flight!\r\n" ) );
+        }
+    #else /* if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 ) */
+        /* Remove compiler warnings about unused parameters. */
+        ( void ) xMQTTHandle;
+        ( void ) pxPublishParams;
+        ( void ) xCompleteCallback;
+        ( void ) pvCallbackContext;
+        ( void ) xTimeoutTicks;
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+    return xReturnCode;
+}
+/*-----------------------------------------------------------*/
+
 MQTTAgentReturnCode_t MQTT_AGENT_ReturnBuffer( MQTTAgentHandle_t xMQTTHandle,
                                                MQTTBufferHandle_t xBufferHandle )
 {
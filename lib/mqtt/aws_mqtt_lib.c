@@ -326,6 +326,33 @@
         ( srcIndex ) = ( uint32_t ) ( srcIndex ) + ( uint32_t ) ( byteCount );                           \
         ( dstIndex ) = ( uint32_t ) ( dstIndex ) + ( uint32_t ) ( byteCount );                           \
     }
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+/**
+ * @defgroup TopicIndex Helper macros for the topic index.
+ */
+/** @{ */
+    #define mqttTOPIC_INDEX_NONE    ( ( uint16_t ) 0xFFFF ) /**< Marks the absence of a node or a subscription entry. */
+    #define mqttTOPIC_INDEX_ROOT    ( ( uint16_t ) 0 )      /**< The root node which represents the empty topic filter. */
+/** @} */
+
+/**
+ * @brief Returns the hash bucket of the child node of the given parent
+ * node representing the topic level with the given hash.
+ *
+ * @param[in] usParent The parent node.
+ * @param[in] ulLevelHash The hash of the topic level.
+ */
+    #define mqttTOPIC_INDEX_BUCKET( usParent, ulLevelHash )                                    \
+    ( ( ( ulLevelHash ) ^ ( ( uint32_t ) ( usParent ) * ( uint32_t ) 0x9E3779B1UL ) ) % \
+      ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_BUCKETS )
+
+    #if ( mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES >= 0xFFFF ) || ( mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS >= 0xFFFF )
+        #error "mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES and mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS must be less than 65535."
+    #endif
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
 /*-----------------------------------------------------------*/
 
 /**
@@ -490,6 +517,47 @@ static MQTTReturnCode_t prvSendData( MQTTContext_t * pxMQTTContext,
                                      const uint8_t * const pucData,
                                      uint32_t ulDataLength );
 
+/**
+ * @brief Transmits the data scattered over multiple memory regions using the
+ * user supplied callbacks.
+ *
+ * Uses the vectored send callback if the user has supplied one, otherwise
+ * transmits the pieces one after another using the regular send callback. Like
+ * prvSendData, it updates the keep alive timestamps in case of a successful
+ * transmit.
+ *
+ * @param[in] pxMQTTContext The MQTT context.
+ * @param[in] pxVectors The pieces of data to transmit.
+ * @param[in] ulVectorCount The number of entries in pxVectors.
+ *
+ * @return eMQTTSuccess if send is successful, eMQTTSendFailed otherwise.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+    static MQTTReturnCode_t prvSendDataVector( MQTTContext_t * pxMQTTContext,
+                                               const MQTTSendVector_t * const pxVectors,
+                                               uint32_t ulVectorCount );
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+/**
+ * @brief Prepares and transmits a publish message.
+ *
+ * Implements both MQTT_Publish and MQTT_PublishZeroCopy. If xZeroCopy is
+ * eMQTTFalse, the payload is copied into the buffer following the topic and the
+ * packet identifier. Otherwise the buffer only holds the fixed and the variable
+ * header and the payload is transmitted in place. In non QoS0 case, the buffer
+ * is put on the waiting ACK list and, for a zero-copy publish, it records the
+ * payload so that it can be reported back in the PUBACK or timeout event.
+ *
+ * @param[in] pxMQTTContext The MQTT context.
+ * @param[in] pxPublishParams Publish parameters.
+ * @param[in] xZeroCopy Whether to transmit the payload without copying it.
+ *
+ * @return eMQTTSuccess if everything succeeds, otherwise an error code explaining the reason of failure.
+ */
+static MQTTReturnCode_t prvPublish( MQTTContext_t * pxMQTTContext,
+                                    const MQTTPublishParams_t * const pxPublishParams,
+                                    MQTTBool_t xZeroCopy );
+
 /**
  * @brief Decodes and processes the received MQTT message containing only fixed header.
  *
@@ -589,6 +657,50 @@ static void prvProcessReceivedPINGRESP( MQTTContext_t * pxMQTTContext );
  */
 static void prvProcessReceivedPublish( MQTTContext_t * pxMQTTContext );
 
+/**
+ * @brief Sends a PUBACK for a received QoS1 publish message.
+ *
+ * If the PUBACK cannot be sent, the broker sends the same publish
+ * message again.
+ *
+ * @param[in] pxMQTTContext The MQTT context for which the publish was received.
+ * @param[in] pucPacketIdentifier The two byte packet identifier of the
+ * received publish message.
+ */
+static void prvSendPUBACK( MQTTContext_t * pxMQTTContext,
+                           const uint8_t * const pucPacketIdentifier );
+
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+/**
+ * @brief Streams a received Publish message which could not be stored in a
+ * single buffer.
+ *
+ * The topic length is decoded as it is received and only the fixed header,
+ * the topic and the packet identifier are stored in a buffer of that size.
+ * Once these have been received, the user supplied callback is invoked with
+ * the eMQTTPublishStreamHeader event and then the payload is passed to the
+ * callback in eMQTTPublishStreamChunk events directly from pucReceivedData.
+ * The PUBACK for a QoS1 message is sent before the last chunk is reported.
+ * If no buffer is available for the header, the rest of the message is
+ * dropped.
+ *
+ * @param[in] pxMQTTContext The MQTT context for which the message is received.
+ * @param[in] pucReceivedData The data passed to MQTT_ParseReceivedData.
+ * @param[in] xReceivedDataLength The length of pucReceivedData.
+ * @param[in,out] pxProcessedBytes The number of bytes of pucReceivedData
+ * processed so far. It is incremented by the number of bytes consumed.
+ *
+ * @return eMQTTMalformedPacketReceived if the message is malformed in which
+ * case the client is disconnected, eMQTTSuccess otherwise.
+ */
+    static MQTTReturnCode_t prvStreamReceivedPublish( MQTTContext_t * pxMQTTContext,
+                                                      const uint8_t * pucReceivedData,
+                                                      size_t xReceivedDataLength,
+                                                      size_t * pxProcessedBytes );
+
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
 /**
  * @brief Invokes the user supplied callback.
  *
@@ -719,7 +831,8 @@ static uint8_t prvDecodeRemainingLength( const uint8_t * const pucEncodedRemaini
  *
  * Iterates over all the entries in the subscription manager and tries to find
  * the one with the matching topic. If it finds one, removes it by marking it
- * free.
+ * free. If mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX is set to 1, only
+ * the entries attached to the matching node in the topic index are examined.
  *
  * @param[in] pxMQTTContext The MQTT context for which to remove the subscription.
  * @param[in] pucTopic The topic for which the subscription entry is to be removed.
@@ -838,6 +951,178 @@ static uint8_t prvDecodeRemainingLength( const uint8_t * const pucEncodedRemaini
                                                     uint16_t usTopicFilterLength );
 
 #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
+
+/**
+ * @brief Removes all the nodes from the topic index and returns them to
+ * the free node list.
+ *
+ * @param[in] pxTopicIndex The topic index to reset.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static void prvTopicIndexReset( MQTTTopicIndex_t * pxTopicIndex );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Returns the length of the topic level starting at the given offset.
+ *
+ * A topic level extends until the next '/' character or the end of the topic.
+ *
+ * @param[in] pucTopic The topic or topic filter.
+ * @param[in] ulTopicLength The length of the topic or topic filter.
+ * @param[in] ulOffset The offset of the first character of the topic level.
+ *
+ * @return The length of the topic level, which can be zero.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint32_t prvTopicIndexGetLevelLength( const uint8_t * const pucTopic,
+                                                 uint32_t ulTopicLength,
+                                                 uint32_t ulOffset );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Calculates the hash of a topic level (32 bit FNV-1a).
+ *
+ * @param[in] pucLevel The topic level.
+ * @param[in] ulLevelLength The length of the topic level.
+ *
+ * @return The hash of the topic level.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint32_t prvTopicIndexHashLevel( const uint8_t * const pucLevel,
+                                            uint32_t ulLevelLength );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Finds the child node of the given parent node which represents
+ * the given regular (i.e. not wild-card) topic level.
+ *
+ * @param[in] pxTopicIndex The topic index to search.
+ * @param[in] usParent The parent node.
+ * @param[in] ulLevelHash The hash of the topic level.
+ * @param[in] ulLevelLength The length of the topic level.
+ *
+ * @return The child node if found, mqttTOPIC_INDEX_NONE otherwise.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint16_t prvTopicIndexFindChild( const MQTTTopicIndex_t * pxTopicIndex,
+                                            uint16_t usParent,
+                                            uint32_t ulLevelHash,
+                                            uint32_t ulLevelLength );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Finds the node for the topic filter level starting at the given
+ * offset, optionally creating it.
+ *
+ * The single-level wild-card '+' is represented by the usPlusChild of the
+ * parent node, all the other levels are looked up in the hash buckets.
+ *
+ * @param[in] pxTopicIndex The topic index to search.
+ * @param[in] usParent The parent node.
+ * @param[in] pucTopicFilter The topic filter.
+ * @param[in] ulTopicFilterLength The length of the topic filter.
+ * @param[in] ulOffset The offset of the topic level in the topic filter.
+ * @param[in] xCreate Whether to create the node if it does not exist. The
+ * caller must ensure that a free node is available.
+ *
+ * @return The node if found or created, mqttTOPIC_INDEX_NONE otherwise.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint16_t prvTopicIndexGetFilterLevelNode( MQTTTopicIndex_t * pxTopicIndex,
+                                                     uint16_t usParent,
+                                                     const uint8_t * const pucTopicFilter,
+                                                     uint32_t ulTopicFilterLength,
+                                                     uint32_t ulOffset,
+                                                     MQTTBool_t xCreate );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Unlinks the given node from its parent and returns it to the free
+ * node list.
+ *
+ * @param[in] pxTopicIndex The topic index which contains the node.
+ * @param[in] usNode The node to free.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static void prvTopicIndexFreeNode( MQTTTopicIndex_t * pxTopicIndex,
+                                       uint16_t usNode );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Adds the given subscription entry to the topic index.
+ *
+ * The subscription entry must already contain the topic filter. The nodes
+ * needed for the topic filter are counted before any of them is created so
+ * that a failure leaves the topic index unchanged.
+ *
+ * @param[in] pxSubscriptionManager The subscription manager which contains
+ * the subscription entry.
+ * @param[in] usSubscription The index of the subscription entry.
+ *
+ * @return eMQTTTrue if the subscription entry is added, eMQTTFalse if not
+ * enough free nodes are available.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static MQTTBool_t prvTopicIndexInsert( MQTTSubscriptionManager_t * pxSubscriptionManager,
+                                           uint16_t usSubscription );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Removes the subscription entry for the given topic filter from the
+ * topic index and marks it free.
+ *
+ * The nodes which are no longer used by any topic filter are freed.
+ *
+ * @param[in] pxSubscriptionManager The subscription manager from which to
+ * remove the subscription.
+ * @param[in] pucTopic The topic filter for which the subscription entry is
+ * to be removed.
+ * @param[in] usTopicLength The length of the topic filter.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static void prvTopicIndexRemove( MQTTSubscriptionManager_t * pxSubscriptionManager,
+                                     const uint8_t * const pucTopic,
+                                     uint16_t usTopicLength );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
+/**
+ * @brief Invokes the callbacks of the subscription entries in the given list
+ * which are of the given type and match the topic of the publish message.
+ *
+ * @param[in] pxMQTTContext The MQTT context for which to invoke the subscription callbacks.
+ * @param[in] usSubscription The first subscription entry in the list.
+ * @param[in] xTopicFilterType Only the subscription entries of this type are considered.
+ * @param[in] pxPublishData The publish data containing the topic and the received message.
+ * @param[out] pxSubscriptionCallbackInvoked Set to eMQTTTrue if any callback was invoked,
+ * otherwise left unchanged.
+ *
+ * @return eMQTTTrue if the user took the ownership of the MQTT buffer, eMQTTFalse otherwise.
+ */
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static MQTTBool_t prvTopicIndexInvokeCallbacks( MQTTContext_t * pxMQTTContext,
+                                                    uint16_t usSubscription,
+                                                    MQTTTopicFilterType_t xTopicFilterType,
+                                                    const MQTTPublishData_t * pxPublishData,
+                                                    MQTTBool_t * pxSubscriptionCallbackInvoked );
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
 /*-----------------------------------------------------------*/
 
 static MQTTBufferHandle_t prvGetFreeBuffer( MQTTContext_t * pxMQTTContext,
@@ -998,6 +1283,11 @@ static void prvResetRxMessageState( MQTTContext_t * pxMQTTContext )
     pxMQTTContext->xRxMessageState.xRxNextByte = eMQTTRxNextBytePacketType;
     pxMQTTContext->ulRxMessageReceivedLength = 0;
     pxMQTTContext->xRxBuffer = NULL;
+
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        pxMQTTContext->xRxMessageState.usStreamTopicLength = 0;
+        pxMQTTContext->xRxMessageState.ulStreamHeaderLength = 0;
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 }
 /*-----------------------------------------------------------*/
 
@@ -1037,6 +1327,11 @@ static void prvResetMQTTContext( MQTTContext_t * pxMQTTContext )
 
         /* Set the number of in-use subscription entries to zero. */
         pxMQTTContext->xSubscriptionManager.ulInUseSubscriptions = 0;
+
+        #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+            /* Remove all the topic filters from the topic index. */
+            prvTopicIndexReset( &( pxMQTTContext->xSubscriptionManager.xTopicIndex ) );
+        #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
     #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
 }
 /*-----------------------------------------------------------*/
@@ -1121,6 +1416,53 @@ static MQTTReturnCode_t prvSendData( MQTTContext_t * pxMQTTContext,
 }
 /*-----------------------------------------------------------*/
 
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+    static MQTTReturnCode_t prvSendDataVector( MQTTContext_t * pxMQTTContext,
+                                               const MQTTSendVector_t * const pxVectors,
+                                               uint32_t ulVectorCount )
+    {
+        MQTTReturnCode_t xReturnCode = eMQTTSuccess;
+        uint32_t x, ulTotalDataLength = 0;
+
+        if( pxMQTTContext->pxMQTTSendvFxn != NULL )
+        {
+            for( x = 0; x < ulVectorCount; x++ )
+            {
+                ulTotalDataLength += pxVectors[ x ].ulDataLength;
+            }
+
+            if( pxMQTTContext->pxMQTTSendvFxn( pxMQTTContext->pvSendContext, pxVectors, ulVectorCount ) != ulTotalDataLength )
+            {
+                xReturnCode = eMQTTSendFailed;
+            }
+        }
+        else
+        {
+            /* No vectored send available - send the pieces one after another
+             * and stop at the first one which is not transmitted completely. */
+            for( x = 0; ( x < ulVectorCount ) && ( xReturnCode == eMQTTSuccess ); x++ )
+            {
+                if( pxMQTTContext->pxMQTTSendFxn( pxMQTTContext->pvSendContext, pxVectors[ x ].pucData, pxVectors[ x ].ulDataLength ) != pxVectors[ x ].ulDataLength )
+                {
+                    xReturnCode = eMQTTSendFailed;
+                }
+            }
+        }
+
+        if( xReturnCode == eMQTTSuccess )
+        {
+            /* Reset the last sent message timestamp. See prvSendData. */
+            pxMQTTContext->xLastSentMessageTimestamp = prvGetCurrentTickCount( pxMQTTContext );
+            pxMQTTContext->ulNextPeriodicInvokeTicks = pxMQTTContext->ulKeepAliveActualIntervalTicks;
+        }
+
+        return xReturnCode;
+    }
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+/*-----------------------------------------------------------*/
+
 static void prvProcessReceivedFixedHeaderOnlyMQTTPacket( MQTTContext_t * pxMQTTContext )
 {
     MQTTEventCallbackParams_t xEventCallbackParams;
@@ -1579,6 +1921,9 @@ static void prvProcessReceivedPUBACK( MQTTContext_t * pxMQTTContext )
                 /* Inform the user about the received UNSUBACK. */
                 xEventCallbackParams.xEventType = eMQTTPubACK;
                 xEventCallbackParams.u.xMQTTPubACKData.usPacketIdentifier = usPacketIdentifier;
+                #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+                    xEventCallbackParams.u.xMQTTPubACKData.pvData = mqttbufferGET_PACKET_PAYLOAD( xPublishTxBuffer );
+                #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
                 ( void ) prvInvokeCallback( pxMQTTContext, &xEventCallbackParams );
 
                 /* Return the Tx Buffer to the pool. */
@@ -1674,13 +2019,6 @@ static void prvProcessReceivedPublish( MQTTContext_t * pxMQTTContext )
     MQTTEventCallbackParams_t xEventCallbackParams;
     uint8_t ucPacketIdentiferLength; /* Length in bytes taken by the packet identifier field in the received publish packet. */
     uint8_t ucQos;
-    static uint8_t ucPUBACKPacket[] =
-    {
-        mqttCONTROL_PUBACK | mqttFLAGS_PUBACK, /* Fixed header control packet type. */
-        2,                                     /* Fixed header remaining length - always 2 for PUBACK. */
-        0,                                     /* Packet identifier MSB. */
-        0                                      /* Packet identifier LSB. */
-    };
 
     /* A broker has sent a message to this client.  Decode it, then pass the
      * decoded message into an application defined callback. */
@@ -1735,20 +2073,11 @@ static void prvProcessReceivedPublish( MQTTContext_t * pxMQTTContext )
          * callback. */
         if( xEventCallbackParams.u.xPublishData.xQos == eMQTTQoS1 )
         {
-            /* Extract the packet identifier from the publish message
-             * to set the same in PUBACK message. */
-            ucPUBACKPacket[ mqttPUBACK_PACKET_ID_MSB_OFFSET ] = mqttbufferGET_DATA( pxMQTTContext->xRxBuffer )[ mqttADJUST_OFFSET( mqttPUBLISH_TOPIC_STRING_OFFSET,
-                                                                                                                                   pxMQTTContext->xRxMessageState.ucRemaingingLengthFieldBytes ) +
-                                                                                                                xEventCallbackParams.u.xPublishData.usTopicLength ];
-            ucPUBACKPacket[ mqttPUBACK_PACKET_ID_LSB_OFFSET ] = mqttbufferGET_DATA( pxMQTTContext->xRxBuffer )[ mqttADJUST_OFFSET( mqttPUBLISH_TOPIC_STRING_OFFSET,
-                                                                                                                                   pxMQTTContext->xRxMessageState.ucRemaingingLengthFieldBytes ) +
-                                                                                                                xEventCallbackParams.u.xPublishData.usTopicLength +
-                                                                                                                ( uint16_t ) 1 /* Packet ID LSB follows MSB. */ ];
-
-            /* Send a PUBACK to the broker confirming the receipt
-             * of the publish message. If we fail to send the PUBACK,
-             * we will receive the same publish message again. */
-            ( void ) prvSendData( pxMQTTContext, ucPUBACKPacket, ( uint32_t ) sizeof( ucPUBACKPacket ) );
+            /* The packet identifier follows the topic string. */
+            prvSendPUBACK( pxMQTTContext,
+                           &( mqttbufferGET_DATA( pxMQTTContext->xRxBuffer )[ mqttADJUST_OFFSET( mqttPUBLISH_TOPIC_STRING_OFFSET,
+                                                                                                 pxMQTTContext->xRxMessageState.ucRemaingingLengthFieldBytes ) +
+                                                                              xEventCallbackParams.u.xPublishData.usTopicLength ] ) );
         }
 
         /* If the user chooses not to take the ownership of the buffer,
@@ -1772,6 +2101,197 @@ static void prvProcessReceivedPublish( MQTTContext_t * pxMQTTContext )
 }
 /*-----------------------------------------------------------*/
 
+static void prvSendPUBACK( MQTTContext_t * pxMQTTContext,
+                           const uint8_t * const pucPacketIdentifier )
+{
+    static uint8_t ucPUBACKPacket[] =
+    {
+        mqttCONTROL_PUBACK | mqttFLAGS_PUBACK, /* Fixed header control packet type. */
+        2,                                     /* Fixed header remaining length - always 2 for PUBACK. */
+        0,                                     /* Packet identifier MSB. */
+        0                                      /* Packet identifier LSB. */
+    };
+
+    /* Set the packet identifier of the publish message in the PUBACK
+     * message. */
+    ucPUBACKPacket[ mqttPUBACK_PACKET_ID_MSB_OFFSET ] = pucPacketIdentifier[ 0 ];
+    ucPUBACKPacket[ mqttPUBACK_PACKET_ID_LSB_OFFSET ] = pucPacketIdentifier[ 1 ]; /* Packet ID LSB follows MSB. */
+
+    /* Send a PUBACK to the broker confirming the receipt
+     * of the publish message. If we fail to send the PUBACK,
+     * we will receive the same publish message again. */
+    ( void ) prvSendData( pxMQTTContext, ucPUBACKPacket, ( uint32_t ) sizeof( ucPUBACKPacket ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+    static MQTTReturnCode_t prvStreamReceivedPublish( MQTTContext_t * pxMQTTContext,
+                                                      const uint8_t * pucReceivedData,
+                                                      size_t xReceivedDataLength,
+                                                      size_t * pxProcessedBytes )
+    {
+        MQTTReturnCode_t xReturnCode = eMQTTSuccess;
+        MQTTEventCallbackParams_t xEventCallbackParams;
+        MQTTRxMessageState_t * const pxRxMessageState = &( pxMQTTContext->xRxMessageState );
+        uint32_t ulTopicOffset, ulFixedHeaderLength, ulPayloadLength;
+        size_t xExpectedBytes, xChunkLength;
+        uint8_t ucQos, * pucHeader;
+
+        /* The topic string follows the fixed header and the two bytes
+         * containing the topic length. */
+        ulTopicOffset = mqttADJUST_OFFSET( mqttPUBLISH_TOPIC_STRING_OFFSET, pxRxMessageState->ucRemaingingLengthFieldBytes );
+        ulFixedHeaderLength = ulTopicOffset - ( uint32_t ) mqttPUBLISH_TOPIC_OFFSET;
+        ucQos = mqttPUBLISH_QoS_BITS( pxMQTTContext->ucRxFixedHeaderBuffer[ mqttFIXED_HEADER_CONTROL_BYTE_OFFSET ] );
+
+        if( pxRxMessageState->ulStreamHeaderLength == ( uint32_t ) 0 )
+        {
+            /* Receiving the topic length - decode it one byte at a time
+             * as we do not have a buffer yet. */
+            pxRxMessageState->usStreamTopicLength <<= mqttBITS_PER_BYTE;
+            pxRxMessageState->usStreamTopicLength |= ( uint16_t ) pucReceivedData[ *pxProcessedBytes ];
+            ( *pxProcessedBytes )++;
+            pxMQTTContext->ulRxMessageReceivedLength++;
+
+            if( pxMQTTContext->ulRxMessageReceivedLength == ulTopicOffset )
+            {
+                /* The topic string is followed by the packet identifier. Note
+                 * that QoS0 publishes do not have packet identifier. */
+                pxRxMessageState->ulStreamHeaderLength = ulTopicOffset +
+                                                         ( uint32_t ) pxRxMessageState->usStreamTopicLength +
+                                                         ( ( ucQos == ( uint8_t ) 0 ) ? ( uint32_t ) mqttPUBLISH_QOS0_PACKET_IDENTIFER_LENGTH : ( uint32_t ) mqttPUBLISH_QOS1_PACKET_IDENTIFER_LENGTH );
+
+                /* A publish packet with QoS2 or with a topic which does not
+                 * fit in the message is considered malformed. */
+                if( ( ucQos > ( uint8_t ) 1 ) || ( pxRxMessageState->ulStreamHeaderLength > pxRxMessageState->ulTotalMessageLength ) )
+                {
+                    xReturnCode = eMQTTMalformedPacketReceived;
+                }
+                else
+                {
+                    /* Get a buffer to store everything before the payload. */
+                    pxMQTTContext->xRxBuffer = prvGetFreeBuffer( pxMQTTContext, pxRxMessageState->ulStreamHeaderLength );
+
+                    if( pxMQTTContext->xRxBuffer != NULL )
+                    {
+                        /* Copy the fixed header and the topic length in the Rx buffer. */
+                        pucHeader = mqttbufferGET_DATA( pxMQTTContext->xRxBuffer );
+                        memcpy( pucHeader, pxMQTTContext->ucRxFixedHeaderBuffer, ulFixedHeaderLength );
+                        pucHeader[ ulFixedHeaderLength ] = ( uint8_t ) ( pxRxMessageState->usStreamTopicLength >> mqttBITS_PER_BYTE );
+                        pucHeader[ ulFixedHeaderLength + ( uint32_t ) 1 ] = ( uint8_t ) ( pxRxMessageState->usStreamTopicLength & ( uint16_t ) 0xFF );
+                        mqttbufferGET_DATA_LENGTH( pxMQTTContext->xRxBuffer ) = ulTopicOffset;
+                    }
+                    else
+                    {
+                        /* Drop the rest of the message. */
+                        pxRxMessageState->xRxMessageAction = eMQTTRxMessageDrop;
+                    }
+                }
+            }
+        }
+        else
+        {
+            pucHeader = mqttbufferGET_DATA( pxMQTTContext->xRxBuffer );
+            ulPayloadLength = pxRxMessageState->ulTotalMessageLength - pxRxMessageState->ulStreamHeaderLength;
+
+            /* Receiving the topic and the packet identifier. */
+            if( mqttbufferGET_DATA_LENGTH( pxMQTTContext->xRxBuffer ) < pxRxMessageState->ulStreamHeaderLength )
+            {
+                xExpectedBytes = pxRxMessageState->ulStreamHeaderLength - mqttbufferGET_DATA_LENGTH( pxMQTTContext->xRxBuffer );
+                xChunkLength = xReceivedDataLength - *pxProcessedBytes;
+
+                if( xChunkLength > xExpectedBytes )
+                {
+                    xChunkLength = xExpectedBytes;
+                }
+
+                mqttCOPY_BYTES( pucReceivedData, *pxProcessedBytes, pucHeader, mqttbufferGET_DATA_LENGTH( pxMQTTContext->xRxBuffer ), xChunkLength );
+                pxMQTTContext->ulRxMessageReceivedLength += ( uint32_t ) xChunkLength;
+
+                /* Inform the user about the message, if the header is complete. */
+                if( mqttbufferGET_DATA_LENGTH( pxMQTTContext->xRxBuffer ) == pxRxMessageState->ulStreamHeaderLength )
+                {
+                    xEventCallbackParams.xEventType = eMQTTPublishStreamHeader;
+                    xEventCallbackParams.u.xPublishData.xQos = ( ucQos == ( uint8_t ) 0 ) ? eMQTTQoS0 : eMQTTQoS1;
+                    xEventCallbackParams.u.xPublishData.pucTopic = &( pucHeader[ ulTopicOffset ] );
+                    xEventCallbackParams.u.xPublishData.usTopicLength = pxRxMessageState->usStreamTopicLength;
+                    xEventCallbackParams.u.xPublishData.pvData = NULL;
+                    xEventCallbackParams.u.xPublishData.ulDataLength = ulPayloadLength;
+                    xEventCallbackParams.u.xPublishData.xBuffer = NULL;
+
+                    /* The buffer cannot be taken by the user, the return
+                     * value is therefore ignored. */
+                    ( void ) prvInvokeCallback( pxMQTTContext, &xEventCallbackParams );
+                }
+            }
+
+            /* Receiving the payload. */
+            if( mqttbufferGET_DATA_LENGTH( pxMQTTContext->xRxBuffer ) == pxRxMessageState->ulStreamHeaderLength )
+            {
+                xExpectedBytes = pxRxMessageState->ulTotalMessageLength - pxMQTTContext->ulRxMessageReceivedLength;
+                xChunkLength = xReceivedDataLength - *pxProcessedBytes;
+
+                if( xChunkLength > xExpectedBytes )
+                {
+                    xChunkLength = xExpectedBytes;
+                }
+
+                /* Report the received part of the payload. An empty payload
+                 * is reported as one chunk of length zero. */
+                if( ( xChunkLength > ( size_t ) 0 ) || ( xExpectedBytes == ( size_t ) 0 ) )
+                {
+                    xEventCallbackParams.xEventType = eMQTTPublishStreamChunk;
+                    xEventCallbackParams.u.xPublishChunkData.xQos = ( ucQos == ( uint8_t ) 0 ) ? eMQTTQoS0 : eMQTTQoS1;
+                    xEventCallbackParams.u.xPublishChunkData.pucTopic = &( pucHeader[ ulTopicOffset ] );
+                    xEventCallbackParams.u.xPublishChunkData.usTopicLength = pxRxMessageState->usStreamTopicLength;
+                    xEventCallbackParams.u.xPublishChunkData.pvChunk = &( pucReceivedData[ *pxProcessedBytes ] );
+                    xEventCallbackParams.u.xPublishChunkData.ulChunkLength = ( uint32_t ) xChunkLength;
+                    xEventCallbackParams.u.xPublishChunkData.ulChunkOffset = pxMQTTContext->ulRxMessageReceivedLength - pxRxMessageState->ulStreamHeaderLength;
+                    xEventCallbackParams.u.xPublishChunkData.ulDataLength = ulPayloadLength;
+
+                    *pxProcessedBytes += xChunkLength;
+                    pxMQTTContext->ulRxMessageReceivedLength += ( uint32_t ) xChunkLength;
+
+                    /* If this is the last chunk of a QoS1 publish, send the
+                     * PUBACK before invoking the callback. */
+                    if( ( pxMQTTContext->ulRxMessageReceivedLength == pxRxMessageState->ulTotalMessageLength ) && ( ucQos == ( uint8_t ) 1 ) )
+                    {
+                        /* The packet identifier follows the topic string. */
+                        prvSendPUBACK( pxMQTTContext, &( pucHeader[ ulTopicOffset + ( uint32_t ) pxRxMessageState->usStreamTopicLength ] ) );
+                    }
+
+                    ( void ) prvInvokeCallback( pxMQTTContext, &xEventCallbackParams );
+
+                    /* Complete message received, start looking for the start
+                     * of the next. */
+                    if( pxMQTTContext->ulRxMessageReceivedLength == pxRxMessageState->ulTotalMessageLength )
+                    {
+                        prvReturnBuffer( pxMQTTContext, pxMQTTContext->xRxBuffer );
+                        prvResetRxMessageState( pxMQTTContext );
+                    }
+                }
+            }
+        }
+
+        if( xReturnCode == eMQTTMalformedPacketReceived )
+        {
+            mqttconfigDEBUG_LOG( ( "Malformed publish packet received.\r\n" ) );
+
+            /* A malformed packet has been received - disconnect. */
+            prvResetMQTTContext( pxMQTTContext );
+
+            /* Inform user about the malformed packet received. */
+            xEventCallbackParams.xEventType = eMQTTClientDisconnected;
+            xEventCallbackParams.u.xDisconnectData.xDisconnectReason = eMQTTDisconnectReasonMalformedPacket;
+            ( void ) prvInvokeCallback( pxMQTTContext, &xEventCallbackParams );
+        }
+
+        return xReturnCode;
+    }
+
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+/*-----------------------------------------------------------*/
+
 static MQTTBool_t prvInvokeCallback( MQTTContext_t * pxMQTTContext,
                                      MQTTEventCallbackParams_t * pxEventCallbackParams )
 {
@@ -2022,6 +2542,21 @@ static uint8_t prvDecodeRemainingLength( const uint8_t * const pucEncodedRemaini
                             pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].pxPublishCallback = pxPublishCallback;
                             pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xTopicFilterType = xTopicFilterType;
 
+                            #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+                                {
+                                    /* Add the subscription to the topic index. */
+                                    if( prvTopicIndexInsert( &( pxMQTTContext->xSubscriptionManager ), ( uint16_t ) x ) == eMQTTFalse )
+                                    {
+                                        /* Not enough nodes left in the topic index,
+                                         * release the entry. */
+                                        pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse = eMQTTFalse;
+
+                                        mqttconfigDEBUG_LOG( ( "WARN: No space left in the topic index. Consider increasing mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES.\r\n" ) );
+                                        break;
+                                    }
+                                }
+                            #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+
                             /* Increase the in-use subscription entries count. */
                             pxMQTTContext->xSubscriptionManager.ulInUseSubscriptions += ( uint32_t ) 1;
 
@@ -2064,30 +2599,40 @@ static uint8_t prvDecodeRemainingLength( const uint8_t * const pucEncodedRemaini
                                        const uint8_t * const pucTopic,
                                        uint16_t usTopicLength )
     {
-        uint32_t x;
-
-        /* Iterate over all the subscription entries in
-         * the subscription manager and try to find the
-         * matching one. */
-        for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; x++ )
-        {
-            if( ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse == eMQTTTrue ) &&
-                ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].usTopicFilterLength == usTopicLength ) )
+        #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+            {
+                /* Find the matching subscription entry through the
+                 * topic index. */
+                prvTopicIndexRemove( &( pxMQTTContext->xSubscriptionManager ), pucTopic, usTopicLength );
+            }
+        #else
             {
-                if( memcmp( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].ucTopicFilter, pucTopic, usTopicLength ) == 0 )
+                uint32_t x;
+
+                /* Iterate over all the subscription entries in
+                 * the subscription manager and try to find the
+                 * matching one. */
+                for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; x++ )
                 {
-                    /* Found a matching subscription, mark it as free. */
-                    pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse = eMQTTFalse;
+                    if( ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse == eMQTTTrue ) &&
+                        ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].usTopicFilterLength == usTopicLength ) )
+                    {
+                        if( memcmp( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].ucTopicFilter, pucTopic, usTopicLength ) == 0 )
+                        {
+                            /* Found a matching subscription, mark it as free. */
+                            pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse = eMQTTFalse;
 
-                    /* Reduce the count of in-use subscription entries
-                     * in the subscription manager. */
-                    pxMQTTContext->xSubscriptionManager.ulInUseSubscriptions -= ( uint32_t ) 1;
+                            /* Reduce the count of in-use subscription entries
+                             * in the subscription manager. */
+                            pxMQTTContext->xSubscriptionManager.ulInUseSubscriptions -= ( uint32_t ) 1;
 
-                    /* Done. */
-                    break;
+                            /* Done. */
+                            break;
+                        }
+                    }
                 }
             }
-        }
+        #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
     }
 
 #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
@@ -2135,89 +2680,195 @@ static uint8_t prvDecodeRemainingLength( const uint8_t * const pucEncodedRemaini
                                                       MQTTBool_t * pxSubscriptionCallbackInvoked )
     {
         MQTTBool_t xBufferOwnershipTaken = eMQTTFalse;
-        MQTTSubscription_t * pxSubscription;
-        uint32_t x;
 
         /* Set the output parameter to eMQTTFalse. It will
          * be set to eMQTTTrue if any callback is invoked. */
         *pxSubscriptionCallbackInvoked = eMQTTFalse;
 
-        /* Iterate over the subscription entries containing topic filters
-         * without any wild-cards and invoke the registered callbacks. */
-        for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; x++ )
-        {
-            if( ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse == eMQTTTrue ) &&
-                ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xTopicFilterType == eMQTTTopicFilterTypeSimple ) &&
-                ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].usTopicFilterLength == pxPublishData->usTopicLength ) )
+        #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
             {
-                if( memcmp( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].ucTopicFilter, pxPublishData->pucTopic, pxPublishData->usTopicLength ) == 0 )
+                MQTTTopicIndex_t * pxTopicIndex = &( pxMQTTContext->xSubscriptionManager.xTopicIndex );
+                MQTTTopicIndexCursor_t xCursor;
+                uint32_t ulTopicLength = ( uint32_t ) pxPublishData->usTopicLength;
+                uint32_t ulTopicOffset = 0, ulLevelLength, ulCursorCount = 0;
+                uint16_t usNode = mqttTOPIC_INDEX_ROOT, usChild;
+
+                /* Follow the regular topic levels of the topic to find the
+                 * subscription entries containing topic filters without any
+                 * wild-cards which are an exact match. */
+                while( ( usNode != mqttTOPIC_INDEX_NONE ) && ( ulTopicOffset <= ulTopicLength ) )
                 {
-                    /* Found a matching subscription. */
-                    pxSubscription = &( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ] );
+                    ulLevelLength = prvTopicIndexGetLevelLength( pxPublishData->pucTopic, ulTopicLength, ulTopicOffset );
+                    usNode = prvTopicIndexFindChild( pxTopicIndex,
+                                                     usNode,
+                                                     prvTopicIndexHashLevel( &( pxPublishData->pucTopic[ ulTopicOffset ] ), ulLevelLength ),
+                                                     ulLevelLength );
+                    ulTopicOffset += ulLevelLength + ( uint32_t ) 1;
+                }
 
-                    /* If a callback is registered with the subscription,
-                     * invoke it. */
-                    if( pxSubscription->pxPublishCallback != NULL )
-                    {
-                        /* Note that a callback was invoked. */
-                        *pxSubscriptionCallbackInvoked = eMQTTTrue;
+                if( usNode != mqttTOPIC_INDEX_NONE )
+                {
+                    xBufferOwnershipTaken = prvTopicIndexInvokeCallbacks( pxMQTTContext,
+                                                                          pxTopicIndex->xNodes[ usNode ].usSubscriptions,
+                                                                          eMQTTTopicFilterTypeSimple,
+                                                                          pxPublishData,
+                                                                          pxSubscriptionCallbackInvoked );
+                }
 
-                        /* Invoke callback. */
-                        xBufferOwnershipTaken = pxSubscription->pxPublishCallback( pxSubscription->pvPublishCallbackContext, pxPublishData );
+                /* If the user has not taken the buffer ownership yet, walk
+                 * all the paths in the topic index which match the topic
+                 * and invoke the callbacks of the subscription entries
+                 * containing topic filters with wild-cards. Every node is
+                 * reached through at most one path and therefore the
+                 * cursor stack never holds more entries than there are
+                 * nodes. */
+                if( xBufferOwnershipTaken == eMQTTFalse )
+                {
+                    pxTopicIndex->xCursors[ ulCursorCount ].usNode = mqttTOPIC_INDEX_ROOT;
+                    pxTopicIndex->xCursors[ ulCursorCount ].ulTopicOffset = 0;
+                    ulCursorCount++;
+                }
 
-                        /* If the user takes the buffer ownership, do
-                         * not invoke any other callbacks. */
-                        if( xBufferOwnershipTaken == eMQTTTrue )
+                while( ( ulCursorCount > ( uint32_t ) 0 ) && ( xBufferOwnershipTaken == eMQTTFalse ) )
+                {
+                    ulCursorCount--;
+                    xCursor = pxTopicIndex->xCursors[ ulCursorCount ];
+
+                    /* A '#' after this node matches all the remaining levels
+                     * including the parent level. */
+                    xBufferOwnershipTaken = prvTopicIndexInvokeCallbacks( pxMQTTContext,
+                                                                          pxTopicIndex->xNodes[ xCursor.usNode ].usMultiLevelSubscriptions,
+                                                                          eMQTTTopicFilterTypeWildCard,
+                                                                          pxPublishData,
+                                                                          pxSubscriptionCallbackInvoked );
+
+                    if( xBufferOwnershipTaken == eMQTTFalse )
+                    {
+                        if( xCursor.ulTopicOffset > ulTopicLength )
                         {
-                            break;
+                            /* All the topic levels are matched, so the topic
+                             * filters ending at this node match. */
+                            xBufferOwnershipTaken = prvTopicIndexInvokeCallbacks( pxMQTTContext,
+                                                                                  pxTopicIndex->xNodes[ xCursor.usNode ].usSubscriptions,
+                                                                                  eMQTTTopicFilterTypeWildCard,
+                                                                                  pxPublishData,
+                                                                                  pxSubscriptionCallbackInvoked );
                         }
-                    }
-                }
-            }
-        }
+                        else
+                        {
+                            ulLevelLength = prvTopicIndexGetLevelLength( pxPublishData->pucTopic, ulTopicLength, xCursor.ulTopicOffset );
 
-        /* If the user has not taken the buffer ownership yet (which can
-         * happen if there is no exact matching entry in the subscription
-         * manager or the user does not take the ownership in the callback),
-         * iterate over the subscription entries containing topic filters
-         * with wild-cards and invoke the registered callbacks for the ones
-         * which match the topic. */
-        if( xBufferOwnershipTaken == eMQTTFalse )
-        {
-            for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; x++ )
+                            /* Continue with the child for this topic level
+                             * and the child for the '+' wild-card. */
+                            usChild = prvTopicIndexFindChild( pxTopicIndex,
+                                                              xCursor.usNode,
+                                                              prvTopicIndexHashLevel( &( pxPublishData->pucTopic[ xCursor.ulTopicOffset ] ), ulLevelLength ),
+                                                              ulLevelLength );
+
+                            if( usChild != mqttTOPIC_INDEX_NONE )
+                            {
+                                mqttconfigASSERT( ulCursorCount < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES );
+                                pxTopicIndex->xCursors[ ulCursorCount ].usNode = usChild;
+                                pxTopicIndex->xCursors[ ulCursorCount ].ulTopicOffset = xCursor.ulTopicOffset + ulLevelLength + ( uint32_t ) 1;
+                                ulCursorCount++;
+                            }
+
+                            usChild = pxTopicIndex->xNodes[ xCursor.usNode ].usPlusChild;
+
+                            if( usChild != mqttTOPIC_INDEX_NONE )
+                            {
+                                mqttconfigASSERT( ulCursorCount < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES );
+                                pxTopicIndex->xCursors[ ulCursorCount ].usNode = usChild;
+                                pxTopicIndex->xCursors[ ulCursorCount ].ulTopicOffset = xCursor.ulTopicOffset + ulLevelLength + ( uint32_t ) 1;
+                                ulCursorCount++;
+                            }
+                        }
+                    }
+                }
+            }
+        #else /* if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 ) */
             {
-                if( ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse == eMQTTTrue ) &&
-                    ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xTopicFilterType == eMQTTTopicFilterTypeWildCard ) )
+                MQTTSubscription_t * pxSubscription;
+                uint32_t x;
+
+                /* Iterate over the subscription entries containing topic filters
+                 * without any wild-cards and invoke the registered callbacks. */
+                for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; x++ )
                 {
-                    if( prvDoesTopicMatchTopicFilter( pxPublishData->pucTopic,
-                                                      pxPublishData->usTopicLength,
-                                                      pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].ucTopicFilter,
-                                                      pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].usTopicFilterLength ) == eMQTTTrue )
+                    if( ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse == eMQTTTrue ) &&
+                        ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xTopicFilterType == eMQTTTopicFilterTypeSimple ) &&
+                        ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].usTopicFilterLength == pxPublishData->usTopicLength ) )
                     {
-                        /* Found a matching subscription. */
-                        pxSubscription = &( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ] );
-
-                        /* If a callback is registered with the subscription,
-                         * invoke it. */
-                        if( pxSubscription->pxPublishCallback != NULL )
+                        if( memcmp( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].ucTopicFilter, pxPublishData->pucTopic, pxPublishData->usTopicLength ) == 0 )
                         {
-                            /* Note that a callback was invoked. */
-                            *pxSubscriptionCallbackInvoked = eMQTTTrue;
+                            /* Found a matching subscription. */
+                            pxSubscription = &( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ] );
 
-                            /* Invoke callback. */
-                            xBufferOwnershipTaken = pxSubscription->pxPublishCallback( pxSubscription->pvPublishCallbackContext, pxPublishData );
+                            /* If a callback is registered with the subscription,
+                             * invoke it. */
+                            if( pxSubscription->pxPublishCallback != NULL )
+                            {
+                                /* Note that a callback was invoked. */
+                                *pxSubscriptionCallbackInvoked = eMQTTTrue;
+
+                                /* Invoke callback. */
+                                xBufferOwnershipTaken = pxSubscription->pxPublishCallback( pxSubscription->pvPublishCallbackContext, pxPublishData );
+
+                                /* If the user takes the buffer ownership, do
+                                 * not invoke any other callbacks. */
+                                if( xBufferOwnershipTaken == eMQTTTrue )
+                                {
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
 
-                            /* If the user takes the buffer ownership, do
-                             * not invoke any other callbacks. */
-                            if( xBufferOwnershipTaken == eMQTTTrue )
+                /* If the user has not taken the buffer ownership yet (which can
+                 * happen if there is no exact matching entry in the subscription
+                 * manager or the user does not take the ownership in the callback),
+                 * iterate over the subscription entries containing topic filters
+                 * with wild-cards and invoke the registered callbacks for the ones
+                 * which match the topic. */
+                if( xBufferOwnershipTaken == eMQTTFalse )
+                {
+                    for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; x++ )
+                    {
+                        if( ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xInUse == eMQTTTrue ) &&
+                            ( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].xTopicFilterType == eMQTTTopicFilterTypeWildCard ) )
+                        {
+                            if( prvDoesTopicMatchTopicFilter( pxPublishData->pucTopic,
+                                                              pxPublishData->usTopicLength,
+                                                              pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].ucTopicFilter,
+                                                              pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ].usTopicFilterLength ) == eMQTTTrue )
                             {
-                                break;
+                                /* Found a matching subscription. */
+                                pxSubscription = &( pxMQTTContext->xSubscriptionManager.xSubscriptions[ x ] );
+
+                                /* If a callback is registered with the subscription,
+                                 * invoke it. */
+                                if( pxSubscription->pxPublishCallback != NULL )
+                                {
+                                    /* Note that a callback was invoked. */
+                                    *pxSubscriptionCallbackInvoked = eMQTTTrue;
+
+                                    /* Invoke callback. */
+                                    xBufferOwnershipTaken = pxSubscription->pxPublishCallback( pxSubscription->pvPublishCallbackContext, pxPublishData );
+
+                                    /* If the user takes the buffer ownership, do
+                                     * not invoke any other callbacks. */
+                                    if( xBufferOwnershipTaken == eMQTTTrue )
+                                    {
+                                        break;
+                                    }
+                                }
                             }
                         }
                     }
                 }
             }
-        }
+        #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
 
         /* Return whether or not the user has taken the
          * ownership of the MQTT buffer. */
@@ -2419,6 +3070,610 @@ static uint8_t prvDecodeRemainingLength( const uint8_t * const pucEncodedRemaini
 #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
 /*-----------------------------------------------------------*/
 
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static void prvTopicIndexReset( MQTTTopicIndex_t * pxTopicIndex )
+    {
+        uint32_t x;
+
+        /* Empty all the hash buckets. */
+        for( x = 0; x < ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_BUCKETS; x++ )
+        {
+            pxTopicIndex->usBuckets[ x ] = mqttTOPIC_INDEX_NONE;
+        }
+
+        /* The root node is always in use. */
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].ulLevelHash = 0;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usLevelLength = 0;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usParent = mqttTOPIC_INDEX_NONE;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usNext = mqttTOPIC_INDEX_NONE;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usPlusChild = mqttTOPIC_INDEX_NONE;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usSubscriptions = mqttTOPIC_INDEX_NONE;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usMultiLevelSubscriptions = mqttTOPIC_INDEX_NONE;
+        pxTopicIndex->xNodes[ mqttTOPIC_INDEX_ROOT ].usReferenceCount = 0;
+
+        /* Chain all the other nodes in the free node list. */
+        pxTopicIndex->usFreeNodes = mqttTOPIC_INDEX_NONE;
+        pxTopicIndex->usFreeNodeCount = 0;
+
+        for( x = ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_TOPIC_INDEX_NODES - ( uint32_t ) 1; x > ( uint32_t ) mqttTOPIC_INDEX_ROOT; x-- )
+        {
+            pxTopicIndex->xNodes[ x ].usNext = pxTopicIndex->usFreeNodes;
+            pxTopicIndex->usFreeNodes = ( uint16_t ) x;
+            pxTopicIndex->usFreeNodeCount++;
+        }
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint32_t prvTopicIndexGetLevelLength( const uint8_t * const pucTopic,
+                                                 uint32_t ulTopicLength,
+                                                 uint32_t ulOffset )
+    {
+        uint32_t x = ulOffset;
+
+        /* Consume the characters until '/' or the end of the topic. */
+        while( ( x < ulTopicLength ) && ( pucTopic[ x ] != ( uint8_t ) '/' ) )
+        {
+            x++;
+        }
+
+        return x - ulOffset;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint32_t prvTopicIndexHashLevel( const uint8_t * const pucLevel,
+                                            uint32_t ulLevelLength )
+    {
+        uint32_t ulHash = ( uint32_t ) 2166136261UL, x;
+
+        for( x = 0; x < ulLevelLength; x++ )
+        {
+            ulHash ^= ( uint32_t ) pucLevel[ x ];
+            ulHash *= ( uint32_t ) 16777619UL;
+        }
+
+        return ulHash;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint16_t prvTopicIndexFindChild( const MQTTTopicIndex_t * pxTopicIndex,
+                                            uint16_t usParent,
+                                            uint32_t ulLevelHash,
+                                            uint32_t ulLevelLength )
+    {
+        uint16_t usNode;
+
+        usNode = pxTopicIndex->usBuckets[ mqttTOPIC_INDEX_BUCKET( usParent, ulLevelHash ) ];
+
+        while( usNode != mqttTOPIC_INDEX_NONE )
+        {
+            if( ( pxTopicIndex->xNodes[ usNode ].usParent == usParent ) &&
+                ( pxTopicIndex->xNodes[ usNode ].ulLevelHash == ulLevelHash ) &&
+                ( ( uint32_t ) pxTopicIndex->xNodes[ usNode ].usLevelLength == ulLevelLength ) )
+            {
+                break;
+            }
+
+            usNode = pxTopicIndex->xNodes[ usNode ].usNext;
+        }
+
+        return usNode;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static uint16_t prvTopicIndexGetFilterLevelNode( MQTTTopicIndex_t * pxTopicIndex,
+                                                     uint16_t usParent,
+                                                     const uint8_t * const pucTopicFilter,
+                                                     uint32_t ulTopicFilterLength,
+                                                     uint32_t ulOffset,
+                                                     MQTTBool_t xCreate )
+    {
+        uint16_t usNode;
+        uint32_t ulLevelLength, ulLevelHash, ulBucket;
+        MQTTBool_t xIsPlus;
+
+        ulLevelLength = prvTopicIndexGetLevelLength( pucTopicFilter, ulTopicFilterLength, ulOffset );
+        ulLevelHash = prvTopicIndexHashLevel( &( pucTopicFilter[ ulOffset ] ), ulLevelLength );
+
+        if( ( ulLevelLength == ( uint32_t ) 1 ) && ( pucTopicFilter[ ulOffset ] == ( uint8_t ) '+' ) )
+        {
+            xIsPlus = eMQTTTrue;
+            usNode = pxTopicIndex->xNodes[ usParent ].usPlusChild;
+        }
+        else
+        {
+            xIsPlus = eMQTTFalse;
+            usNode = prvTopicIndexFindChild( pxTopicIndex, usParent, ulLevelHash, ulLevelLength );
+        }
+
+        if( ( usNode == mqttTOPIC_INDEX_NONE ) && ( xCreate == eMQTTTrue ) )
+        {
+            /* The caller must have ensured that a free node is available. */
+            mqttconfigASSERT( pxTopicIndex->usFreeNodes != mqttTOPIC_INDEX_NONE );
+
+            /* Take a node from the free node list. */
+            usNode = pxTopicIndex->usFreeNodes;
+            pxTopicIndex->usFreeNodes = pxTopicIndex->xNodes[ usNode ].usNext;
+            pxTopicIndex->usFreeNodeCount--;
+
+            pxTopicIndex->xNodes[ usNode ].ulLevelHash = ulLevelHash;
+            pxTopicIndex->xNodes[ usNode ].usLevelLength = ( uint16_t ) ulLevelLength;
+            pxTopicIndex->xNodes[ usNode ].usParent = usParent;
+            pxTopicIndex->xNodes[ usNode ].usNext = mqttTOPIC_INDEX_NONE;
+            pxTopicIndex->xNodes[ usNode ].usPlusChild = mqttTOPIC_INDEX_NONE;
+            pxTopicIndex->xNodes[ usNode ].usSubscriptions = mqttTOPIC_INDEX_NONE;
+            pxTopicIndex->xNodes[ usNode ].usMultiLevelSubscriptions = mqttTOPIC_INDEX_NONE;
+            pxTopicIndex->xNodes[ usNode ].usReferenceCount = 0;
+
+            /* Link it to the parent. */
+            if( xIsPlus == eMQTTTrue )
+            {
+                pxTopicIndex->xNodes[ usParent ].usPlusChild = usNode;
+            }
+            else
+            {
+                ulBucket = mqttTOPIC_INDEX_BUCKET( usParent, ulLevelHash );
+                pxTopicIndex->xNodes[ usNode ].usNext = pxTopicIndex->usBuckets[ ulBucket ];
+                pxTopicIndex->usBuckets[ ulBucket ] = usNode;
+            }
+        }
+
+        return usNode;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static void prvTopicIndexFreeNode( MQTTTopicIndex_t * pxTopicIndex,
+                                       uint16_t usNode )
+    {
+        uint16_t usParent = pxTopicIndex->xNodes[ usNode ].usParent;
+        uint16_t * pusLink;
+
+        if( pxTopicIndex->xNodes[ usParent ].usPlusChild == usNode )
+        {
+            /* The node represents the '+' wild-card. */
+            pxTopicIndex->xNodes[ usParent ].usPlusChild = mqttTOPIC_INDEX_NONE;
+        }
+        else
+        {
+            /* Unlink the node from its hash bucket. */
+            pusLink = &( pxTopicIndex->usBuckets[ mqttTOPIC_INDEX_BUCKET( usParent, pxTopicIndex->xNodes[ usNode ].ulLevelHash ) ] );
+
+            while( *pusLink != usNode )
+            {
+                mqttconfigASSERT( *pusLink != mqttTOPIC_INDEX_NONE );
+                pusLink = &( pxTopicIndex->xNodes[ *pusLink ].usNext );
+            }
+
+            *pusLink = pxTopicIndex->xNodes[ usNode ].usNext;
+        }
+
+        /* Return the node to the free node list. */
+        pxTopicIndex->xNodes[ usNode ].usNext = pxTopicIndex->usFreeNodes;
+        pxTopicIndex->usFreeNodes = usNode;
+        pxTopicIndex->usFreeNodeCount++;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static MQTTBool_t prvTopicIndexInsert( MQTTSubscriptionManager_t * pxSubscriptionManager,
+                                           uint16_t usSubscription )
+    {
+        MQTTTopicIndex_t * pxTopicIndex = &( pxSubscriptionManager->xTopicIndex );
+        MQTTSubscription_t * pxSubscription = &( pxSubscriptionManager->xSubscriptions[ usSubscription ] );
+        uint32_t ulTopicFilterLength = ( uint32_t ) pxSubscription->usTopicFilterLength;
+        uint32_t ulLevelsEnd, ulOffset, ulRequiredNodes = 0;
+        uint16_t usNode = mqttTOPIC_INDEX_ROOT;
+        MQTTBool_t xMultiLevel = eMQTTFalse, xInserted = eMQTTFalse;
+
+        /* A valid topic filter can only contain '#' as the last level. The
+         * subscription entry for such a filter is attached to the node of
+         * the parent level. The levels which need a node are the ones
+         * starting before ulLevelsEnd. */
+        if( ( ulTopicFilterLength > ( uint32_t ) 0 ) &&
+            ( pxSubscription->ucTopicFilter[ ulTopicFilterLength - ( uint32_t ) 1 ] == ( uint8_t ) '#' ) )
+        {
+            xMultiLevel = eMQTTTrue;
+            ulLevelsEnd = ulTopicFilterLength - ( uint32_t ) 1;
+        }
+        else
+        {
+            ulLevelsEnd = ulTopicFilterLength + ( uint32_t ) 1;
+        }
+
+        /* Count the nodes which do not exist yet. */
+        for( ulOffset = 0; ulOffset < ulLevelsEnd; )
+        {
+            if( usNode != mqttTOPIC_INDEX_NONE )
+            {
+                usNode = prvTopicIndexGetFilterLevelNode( pxTopicIndex, usNode, pxSubscription->ucTopicFilter, ulLevelsEnd - ( uint32_t ) 1, ulOffset, eMQTTFalse );
+            }
+
+            if( usNode == mqttTOPIC_INDEX_NONE )
+            {
+                ulRequiredNodes++;
+            }
+
+            ulOffset += prvTopicIndexGetLevelLength( pxSubscription->ucTopicFilter, ulLevelsEnd - ( uint32_t ) 1, ulOffset ) + ( uint32_t ) 1;
+        }
+
+        if( ulRequiredNodes <= ( uint32_t ) pxTopicIndex->usFreeNodeCount )
+        {
+            /* Create the missing nodes and take a reference on every node
+             * along the path. */
+            usNode = mqttTOPIC_INDEX_ROOT;
+
+            for( ulOffset = 0; ulOffset < ulLevelsEnd; )
+            {
+                usNode = prvTopicIndexGetFilterLevelNode( pxTopicIndex, usNode, pxSubscription->ucTopicFilter, ulLevelsEnd - ( uint32_t ) 1, ulOffset, eMQTTTrue );
+                pxTopicIndex->xNodes[ usNode ].usReferenceCount++;
+
+                ulOffset += prvTopicIndexGetLevelLength( pxSubscription->ucTopicFilter, ulLevelsEnd - ( uint32_t ) 1, ulOffset ) + ( uint32_t ) 1;
+            }
+
+            /* Attach the subscription entry to the last node. */
+            pxSubscription->usIndexNode = usNode;
+
+            if( xMultiLevel == eMQTTTrue )
+            {
+                pxSubscription->usNextSubscription = pxTopicIndex->xNodes[ usNode ].usMultiLevelSubscriptions;
+                pxTopicIndex->xNodes[ usNode ].usMultiLevelSubscriptions = usSubscription;
+            }
+            else
+            {
+                pxSubscription->usNextSubscription = pxTopicIndex->xNodes[ usNode ].usSubscriptions;
+                pxTopicIndex->xNodes[ usNode ].usSubscriptions = usSubscription;
+            }
+
+            xInserted = eMQTTTrue;
+        }
+
+        return xInserted;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static void prvTopicIndexRemove( MQTTSubscriptionManager_t * pxSubscriptionManager,
+                                     const uint8_t * const pucTopic,
+                                     uint16_t usTopicLength )
+    {
+        MQTTTopicIndex_t * pxTopicIndex = &( pxSubscriptionManager->xTopicIndex );
+        MQTTSubscription_t * pxSubscription;
+        uint32_t ulTopicFilterLength = ( uint32_t ) usTopicLength;
+        uint32_t ulLevelsEnd, ulOffset;
+        uint16_t usNode = mqttTOPIC_INDEX_ROOT, usParent;
+        uint16_t * pusLink;
+        MQTTBool_t xMultiLevel = eMQTTFalse;
+
+        /* Find the node the subscription entry would be attached to. See
+         * prvTopicIndexInsert. */
+        if( ( ulTopicFilterLength > ( uint32_t ) 0 ) &&
+            ( pucTopic[ ulTopicFilterLength - ( uint32_t ) 1 ] == ( uint8_t ) '#' ) )
+        {
+            xMultiLevel = eMQTTTrue;
+            ulLevelsEnd = ulTopicFilterLength - ( uint32_t ) 1;
+        }
+        else
+        {
+            ulLevelsEnd = ulTopicFilterLength + ( uint32_t ) 1;
+        }
+
+        for( ulOffset = 0; ( usNode != mqttTOPIC_INDEX_NONE ) && ( ulOffset < ulLevelsEnd ); )
+        {
+            usNode = prvTopicIndexGetFilterLevelNode( pxTopicIndex, usNode, pucTopic, ulLevelsEnd - ( uint32_t ) 1, ulOffset, eMQTTFalse );
+            ulOffset += prvTopicIndexGetLevelLength( pucTopic, ulLevelsEnd - ( uint32_t ) 1, ulOffset ) + ( uint32_t ) 1;
+        }
+
+        if( usNode != mqttTOPIC_INDEX_NONE )
+        {
+            if( xMultiLevel == eMQTTTrue )
+            {
+                pusLink = &( pxTopicIndex->xNodes[ usNode ].usMultiLevelSubscriptions );
+            }
+            else
+            {
+                pusLink = &( pxTopicIndex->xNodes[ usNode ].usSubscriptions );
+            }
+
+            /* Iterate over the subscription entries attached to the node
+             * and try to find the matching one. */
+            while( *pusLink != mqttTOPIC_INDEX_NONE )
+            {
+                pxSubscription = &( pxSubscriptionManager->xSubscriptions[ *pusLink ] );
+
+                if( ( pxSubscription->usTopicFilterLength == usTopicLength ) &&
+                    ( memcmp( pxSubscription->ucTopicFilter, pucTopic, usTopicLength ) == 0 ) )
+                {
+                    /* Found a matching subscription, unlink it and mark it
+                     * as free. */
+                    *pusLink = pxSubscription->usNextSubscription;
+                    pxSubscription->xInUse = eMQTTFalse;
+
+                    /* Reduce the count of in-use subscription entries
+                     * in the subscription manager. */
+                    pxSubscriptionManager->ulInUseSubscriptions -= ( uint32_t ) 1;
+
+                    /* Release the references on the path and free the nodes
+                     * which are no longer used. */
+                    while( usNode != mqttTOPIC_INDEX_ROOT )
+                    {
+                        usParent = pxTopicIndex->xNodes[ usNode ].usParent;
+                        pxTopicIndex->xNodes[ usNode ].usReferenceCount--;
+
+                        if( pxTopicIndex->xNodes[ usNode ].usReferenceCount == ( uint16_t ) 0 )
+                        {
+                            prvTopicIndexFreeNode( pxTopicIndex, usNode );
+                        }
+
+                        usNode = usParent;
+                    }
+
+                    /* Done. */
+                    break;
+                }
+
+                pusLink = &( pxSubscription->usNextSubscription );
+            }
+        }
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT == 1 ) && ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+
+    static MQTTBool_t prvTopicIndexInvokeCallbacks( MQTTContext_t * pxMQTTContext,
+                                                    uint16_t usSubscription,
+                                                    MQTTTopicFilterType_t xTopicFilterType,
+                                                    const MQTTPublishData_t * pxPublishData,
+                                                    MQTTBool_t * pxSubscriptionCallbackInvoked )
+    {
+        MQTTBool_t xBufferOwnershipTaken = eMQTTFalse, xMatch;
+        MQTTSubscription_t * pxSubscription;
+
+        while( usSubscription != mqttTOPIC_INDEX_NONE )
+        {
+            pxSubscription = &( pxMQTTContext->xSubscriptionManager.xSubscriptions[ usSubscription ] );
+            usSubscription = pxSubscription->usNextSubscription;
+
+            if( pxSubscription->xTopicFilterType == xTopicFilterType )
+            {
+                /* The topic index only narrows down the candidates, confirm
+                 * the match against the complete topic filter. */
+                if( xTopicFilterType == eMQTTTopicFilterTypeSimple )
+                {
+                    xMatch = ( ( pxSubscription->usTopicFilterLength == pxPublishData->usTopicLength ) &&
+                               ( memcmp( pxSubscription->ucTopicFilter, pxPublishData->pucTopic, pxPublishData->usTopicLength ) == 0 ) ) ? eMQTTTrue : eMQTTFalse;
+                }
+                else
+                {
+                    xMatch = prvDoesTopicMatchTopicFilter( pxPublishData->pucTopic,
+                                                           pxPublishData->usTopicLength,
+                                                           pxSubscription->ucTopicFilter,
+                                                           pxSubscription->usTopicFilterLength );
+                }
+
+                /* If a callback is registered with the matching subscription,
+                 * invoke it. */
+                if( ( xMatch == eMQTTTrue ) && ( pxSubscription->pxPublishCallback != NULL ) )
+                {
+                    /* Note that a callback was invoked. */
+                    *pxSubscriptionCallbackInvoked = eMQTTTrue;
+
+                    /* Invoke callback. */
+                    xBufferOwnershipTaken = pxSubscription->pxPublishCallback( pxSubscription->pvPublishCallbackContext, pxPublishData );
+
+                    /* If the user takes the buffer ownership, do
+                     * not invoke any other callbacks. */
+                    if( xBufferOwnershipTaken == eMQTTTrue )
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        return xBufferOwnershipTaken;
+    }
+
+#endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT && mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
+/*-----------------------------------------------------------*/
+
+static MQTTReturnCode_t prvPublish( MQTTContext_t * pxMQTTContext,
+                                    const MQTTPublishParams_t * const pxPublishParams,
+                                    MQTTBool_t xZeroCopy )
+{
+    uint8_t * pucNextByte, * pucLastByteInBuffer, ucRemainingLengthFieldBytes;
+    uint32_t ulRemainingLength, ulTotalMessageLength, ulBufferedMessageLength;
+    uint16_t usTopicLength;
+    MQTTBufferHandle_t xBuffer = NULL;
+    MQTTReturnCode_t xReturnCode = eMQTTFailure;
+
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        MQTTSendVector_t xVectors[ 2 ];
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+    /* These are checked here once and are later used without
+     * NULL checks. */
+    mqttconfigASSERT( pxMQTTContext != NULL );
+    mqttconfigASSERT( pxMQTTContext->pxMQTTSendFxn != NULL );
+    mqttconfigASSERT( pxMQTTContext->xBufferPoolInterface.pxGetBufferFxn != NULL );
+    mqttconfigASSERT( pxMQTTContext->xBufferPoolInterface.pxReturnBufferFxn != NULL );
+    mqttconfigASSERT( pxPublishParams != NULL );
+
+    mqttconfigDEBUG_LOG( ( "Initiating MQTT publish.\r\n" ) );
+
+    if( pxMQTTContext->xConnectionState != eMQTTConnected )
+    {
+        /* Fail the publish operation immediately, if
+         * MQTT client is not connected. */
+        xReturnCode = eMQTTClientNotConnected;
+    }
+    else
+    {
+        /* Length of the topic in the actual MQTT message. */
+        usTopicLength = mqttSTRLEN( pxPublishParams->usTopicLength );
+
+        /* Calculate the "Remaining Length" i.e. length of the packet excluding Fixed Header. */
+        ulRemainingLength = ( uint32_t ) usTopicLength +
+                            ( pxPublishParams->xQos == eMQTTQoS0 ? ( uint32_t ) mqttPUBLISH_QOS0_PACKET_IDENTIFER_LENGTH : ( uint32_t ) mqttPUBLISH_QOS1_PACKET_IDENTIFER_LENGTH ) +
+                            pxPublishParams->ulDataLength;
+
+        /* Calculate the number of bytes occupied by the "Remaining Length" field. */
+        ucRemainingLengthFieldBytes = prvSizeOfRemainingLength( ulRemainingLength );
+
+        /* Make sure that "Remaining Length" is within the permissible limits. */
+        if( ucRemainingLengthFieldBytes > ( uint8_t ) 0 )
+        {
+            /* Calculate total MQTT message length. */
+            ulTotalMessageLength = mqttTOTAL_MESSAGE_LENGTH( ucRemainingLengthFieldBytes, ulRemainingLength );
+
+            /* The payload is not stored in the buffer in zero-copy case. */
+            ulBufferedMessageLength = ( xZeroCopy == eMQTTTrue ) ? ( ulTotalMessageLength - pxPublishParams->ulDataLength ) : ulTotalMessageLength;
+
+            /* Try to get a buffer from the free buffer pool. */
+            xBuffer = prvGetFreeBuffer( pxMQTTContext, ulBufferedMessageLength );
+
+            if( xBuffer == NULL )
+            {
+                /* Fail the publish operation immediately, if
+                 * no free buffer is available. */
+                mqttconfigDEBUG_LOG( ( "No free buffer is available to carry out the operation. \r\n" ) );
+                xReturnCode = eMQTTNoFreeBuffer;
+            }
+            else
+            {
+                /* Add the buffer to the Tx buffer list. */
+                mqttbufferLIST_ADD( &( pxMQTTContext->xTxBufferListHead ), xBuffer );
+
+                /* To help debugging only. */
+                memset( mqttbufferGET_DATA( xBuffer ), 0x00, mqttbufferGET_EFFECTIVE_BUFFER_LENGTH( xBuffer ) );
+
+                /* Record time-stamp and store timeout. */
+                mqttbufferGET_PACKET_RECORDED_TICK_COUNT( xBuffer ) = prvGetCurrentTickCount( pxMQTTContext );
+                mqttbufferGET_PACKET_TIMEOUT_TICKS( xBuffer ) = pxPublishParams->ulTimeoutTicks;
+
+                /* Write Control Packet Type. */
+                /*_TODO_ Note!  DUP and RETAIN are all currently all set to 0. */
+                mqttbufferGET_DATA( xBuffer )[ mqttFIXED_HEADER_CONTROL_BYTE_OFFSET ] = mqttCONTROL_PUBLISH;
+
+                /* Set QoS. QoS2 is not supported.*/
+                mqttconfigASSERT( pxPublishParams->xQos == eMQTTQoS0 || pxPublishParams->xQos == eMQTTQoS1 );
+                mqttbufferGET_DATA( xBuffer )[ mqttFIXED_HEADER_CONTROL_BYTE_OFFSET ] |= ( ( ( uint8_t ) ( pxPublishParams->xQos ) ) << 1 );
+
+                /* Write encoded "Remaining Length" in the fixed header. */
+                pucNextByte = &( mqttbufferGET_DATA( xBuffer )[ mqttFIXED_HEADER_REMAINING_LENGTH_OFFSET ] );
+                pucLastByteInBuffer = &( mqttbufferGET_DATA( xBuffer )[ mqttbufferGET_EFFECTIVE_BUFFER_LENGTH( xBuffer ) - ( uint32_t ) 1 ] );
+                ucRemainingLengthFieldBytes = prvEncodeRemainingLength( ulRemainingLength, pucNextByte, pucLastByteInBuffer );
+
+                /* We should have successfully encoded the remaining length field
+                 * as we already have a large enough buffer. */
+                mqttconfigASSERT( ucRemainingLengthFieldBytes == prvSizeOfRemainingLength( ulRemainingLength ) );
+
+                /* Write the topic into the message (part of variable header). */
+                pucNextByte = &( mqttbufferGET_DATA( xBuffer )[ mqttADJUST_OFFSET( mqttPUBLISH_TOPIC_OFFSET, ucRemainingLengthFieldBytes ) ] );
+                pucNextByte = prvWriteString( pucNextByte, pucLastByteInBuffer, pxPublishParams->pucTopic, pxPublishParams->usTopicLength );
+
+                /* Write packet identifier into the message, if it is not QoS0. */
+                if( pxPublishParams->xQos != eMQTTQoS0 )
+                {
+                    /* Write MSB. */
+                    *pucNextByte = ( uint8_t ) ( ( pxPublishParams->usPacketIdentifier ) >> mqttBITS_PER_BYTE );
+                    pucNextByte++;
+
+                    /* Write LSB. */
+                    *pucNextByte = ( uint8_t ) ( pxPublishParams->usPacketIdentifier );
+                    pucNextByte++;
+                }
+
+                if( xZeroCopy == eMQTTFalse )
+                {
+                    /* Write the payload into the message. */
+                    memcpy( pucNextByte, pxPublishParams->pvData, ( size_t ) pxPublishParams->ulDataLength );
+                }
+
+                #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+                    else
+                    {
+                        /* Remember the payload so that the user can be told
+                         * when it is no longer referenced. */
+                        mqttbufferGET_PACKET_PAYLOAD( xBuffer ) = pxPublishParams->pvData;
+                    }
+                #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+                /* Store the packet identifier in TxBuffer also for matching
+                 * ACK later. */
+                mqttbufferGET_PACKET_IDENTIFIER( xBuffer ) = pxPublishParams->usPacketIdentifier;
+
+                /* Update the number of bytes written to the buffer. */
+                mqttbufferGET_DATA_LENGTH( xBuffer ) = ulBufferedMessageLength;
+
+                /* MQTT packet created. */
+                xReturnCode = eMQTTSuccess;
+            }
+        }
+    }
+
+    /* If the packet was successfully constructed, transmit it. */
+    if( xReturnCode == eMQTTSuccess )
+    {
+        #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+            if( xZeroCopy == eMQTTTrue )
+            {
+                /* Transmit the headers from the buffer followed by
+                 * the payload in place. */
+                xVectors[ 0 ].pucData = mqttbufferGET_DATA( xBuffer );
+                xVectors[ 0 ].ulDataLength = mqttbufferGET_DATA_LENGTH( xBuffer );
+                xVectors[ 1 ].pucData = ( const uint8_t * ) pxPublishParams->pvData;
+                xVectors[ 1 ].ulDataLength = pxPublishParams->ulDataLength;
+
+                xReturnCode = prvSendDataVector( pxMQTTContext, xVectors, ( uint32_t ) ( sizeof( xVectors ) / sizeof( xVectors[ 0 ] ) ) );
+            }
+            else
+        #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+        {
+            xReturnCode = prvSendData( pxMQTTContext, mqttbufferGET_DATA( xBuffer ), mqttbufferGET_DATA_LENGTH( xBuffer ) );
+        }
+    }
+
+    /* If some error occurred or QOS0 (No ACK is expected in case of QOS0),
+     * return the buffer, otherwise it will be returned upon receiving ACK
+     * or timeout. */
+    if( ( xReturnCode != eMQTTSuccess ) || ( pxPublishParams->xQos == eMQTTQoS0 ) )
+    {
+        /* Return the buffer to the free buffer pool. */
+        prvReturnBuffer( pxMQTTContext, xBuffer );
+    }
+
+    return xReturnCode;
+}
+/*-----------------------------------------------------------*/
+
 MQTTReturnCode_t MQTT_Init( MQTTContext_t * pxMQTTContext,
                             const MQTTInitParams_t * const pxInitParams )
 {
@@ -2450,6 +3705,9 @@ MQTTReturnCode_t MQTT_Init( MQTTContext_t * pxMQTTContext,
     /* Store send context and function. */
     pxMQTTContext->pvSendContext = pxInitParams->pvSendContext;
     pxMQTTContext->pxMQTTSendFxn = pxInitParams->pxMQTTSendFxn;
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        pxMQTTContext->pxMQTTSendvFxn = pxInitParams->pxMQTTSendvFxn;
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
 
     /* Store get ticks function. */
     pxMQTTContext->pxGetTicksFxn = pxInitParams->pxGetTicksFxn;
@@ -2468,6 +3726,11 @@ MQTTReturnCode_t MQTT_Init( MQTTContext_t * pxMQTTContext,
 
         /* Set the number of in-use subscription entries to zero. */
         pxMQTTContext->xSubscriptionManager.ulInUseSubscriptions = 0;
+
+        #if ( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 )
+            /* Remove all the topic filters from the topic index. */
+            prvTopicIndexReset( &( pxMQTTContext->xSubscriptionManager.xTopicIndex ) );
+        #endif /* mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX */
     #endif /* mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT */
 
     return eMQTTSuccess;
@@ -2962,135 +4225,19 @@ MQTTReturnCode_t MQTT_Unsubscribe( MQTTContext_t * pxMQTTContext,
 MQTTReturnCode_t MQTT_Publish( MQTTContext_t * pxMQTTContext,
                                const MQTTPublishParams_t * const pxPublishParams )
 {
-    uint8_t * pucNextByte, * pucLastByteInBuffer, ucRemainingLengthFieldBytes;
-    uint32_t ulRemainingLength, ulTotalMessageLength;
-    uint16_t usTopicLength;
-    MQTTBufferHandle_t xBuffer = NULL;
-    MQTTReturnCode_t xReturnCode = eMQTTFailure;
-
-    /* These are checked here once and are later used without
-     * NULL checks. */
-    mqttconfigASSERT( pxMQTTContext != NULL );
-    mqttconfigASSERT( pxMQTTContext->pxMQTTSendFxn != NULL );
-    mqttconfigASSERT( pxMQTTContext->xBufferPoolInterface.pxGetBufferFxn != NULL );
-    mqttconfigASSERT( pxMQTTContext->xBufferPoolInterface.pxReturnBufferFxn != NULL );
-    mqttconfigASSERT( pxPublishParams != NULL );
-
-    mqttconfigDEBUG_LOG( ( "Initiating MQTT publish.\r\n" ) );
-
-    if( pxMQTTContext->xConnectionState != eMQTTConnected )
-    {
-        /* Fail the publish operation immediately, if
-         * MQTT client is not connected. */
-        xReturnCode = eMQTTClientNotConnected;
-    }
-    else
-    {
-        /* Length of the topic in the actual MQTT message. */
-        usTopicLength = mqttSTRLEN( pxPublishParams->usTopicLength );
-
-        /* Calculate the "Remaining Length" i.e. length of the packet excluding Fixed Header. */
-        ulRemainingLength = ( uint32_t ) usTopicLength +
-                            ( pxPublishParams->xQos == eMQTTQoS0 ? ( uint32_t ) mqttPUBLISH_QOS0_PACKET_IDENTIFER_LENGTH : ( uint32_t ) mqttPUBLISH_QOS1_PACKET_IDENTIFER_LENGTH ) +
-                            pxPublishParams->ulDataLength;
-
-        /* Calculate the number of bytes occupied by the "Remaining Length" field. */
-        ucRemainingLengthFieldBytes = prvSizeOfRemainingLength( ulRemainingLength );
-
-        /* Make sure that "Remaining Length" is within the permissible limits. */
-        if( ucRemainingLengthFieldBytes > ( uint8_t ) 0 )
-        {
-            /* Calculate total MQTT message length. */
-            ulTotalMessageLength = mqttTOTAL_MESSAGE_LENGTH( ucRemainingLengthFieldBytes, ulRemainingLength );
-
-            /* Try to get a buffer from the free buffer pool. */
-            xBuffer = prvGetFreeBuffer( pxMQTTContext, ulTotalMessageLength );
-
-            if( xBuffer == NULL )
-            {
-                /* Fail the publish operation immediately, if
-                 * no free buffer is available. */
-                mqttconfigDEBUG_LOG( ( "No free buffer is available to carry out the operation. \r\n" ) );
-                xReturnCode = eMQTTNoFreeBuffer;
-            }
-            else
-            {
-                /* Add the buffer to the Tx buffer list. */
-                mqttbufferLIST_ADD( &( pxMQTTContext->xTxBufferListHead ), xBuffer );
-
-                /* To help debugging only. */
-                memset( mqttbufferGET_DATA( xBuffer ), 0x00, mqttbufferGET_EFFECTIVE_BUFFER_LENGTH( xBuffer ) );
-
-                /* Record time-stamp and store timeout. */
-                mqttbufferGET_PACKET_RECORDED_TICK_COUNT( xBuffer ) = prvGetCurrentTickCount( pxMQTTContext );
-                mqttbufferGET_PACKET_TIMEOUT_TICKS( xBuffer ) = pxPublishParams->ulTimeoutTicks;
-
-                /* Write Control Packet Type. */
-                /*_TODO_ Note!  DUP and RETAIN are all currently all set to 0. */
-                mqttbufferGET_DATA( xBuffer )[ mqttFIXED_HEADER_CONTROL_BYTE_OFFSET ] = mqttCONTROL_PUBLISH;
-
-                /* Set QoS. QoS2 is not supported.*/
-                mqttconfigASSERT( pxPublishParams->xQos == eMQTTQoS0 || pxPublishParams->xQos == eMQTTQoS1 );
-                mqttbufferGET_DATA( xBuffer )[ mqttFIXED_HEADER_CONTROL_BYTE_OFFSET ] |= ( ( ( uint8_t ) ( pxPublishParams->xQos ) ) << 1 );
-
-                /* Write encoded "Remaining Length" in the fixed header. */
-                pucNextByte = &( mqttbufferGET_DATA( xBuffer )[ mqttFIXED_HEADER_REMAINING_LENGTH_OFFSET ] );
-                pucLastByteInBuffer = &( mqttbufferGET_DATA( xBuffer )[ mqttbufferGET_EFFECTIVE_BUFFER_LENGTH( xBuffer ) - ( uint32_t ) 1 ] );
-                ucRemainingLengthFieldBytes = prvEncodeRemainingLength( ulRemainingLength, pucNextByte, pucLastByteInBuffer );
-
-                /* We should have successfully encoded the remaining length field
-                 * as we already have a large enough buffer. */
-                mqttconfigASSERT( ucRemainingLengthFieldBytes == prvSizeOfRemainingLength( ulRemainingLength ) );
-
-                /* Write the topic into the message (part of variable header). */
-                pucNextByte = &( mqttbufferGET_DATA( xBuffer )[ mqttADJUST_OFFSET( mqttPUBLISH_TOPIC_OFFSET, ucRemainingLengthFieldBytes ) ] );
-                pucNextByte = prvWriteString( pucNextByte, pucLastByteInBuffer, pxPublishParams->pucTopic, pxPublishParams->usTopicLength );
-
-                /* Write packet identifier into the message, if it is not QoS0. */
-                if( pxPublishParams->xQos != eMQTTQoS0 )
-                {
-                    /* Write MSB. */
-                    *pucNextByte = ( uint8_t ) ( ( pxPublishParams->usPacketIdentifier ) >> mqttBITS_PER_BYTE );
-                    pucNextByte++;
-
-                    /* Write LSB. */
-                    *pucNextByte = ( uint8_t ) ( pxPublishParams->usPacketIdentifier );
-                    pucNextByte++;
-                }
-
-                /* Write the payload into the message. */
-                memcpy( pucNextByte, pxPublishParams->pvData, ( size_t ) pxPublishParams->ulDataLength );
-
-                /* Store the packet identifier in TxBuffer also for matching
-                 * ACK later. */
-                mqttbufferGET_PACKET_IDENTIFIER( xBuffer ) = pxPublishParams->usPacketIdentifier;
-
-                /* Update the number of bytes written to the buffer. */
-                mqttbufferGET_DATA_LENGTH( xBuffer ) = ulTotalMessageLength;
-
-                /* MQTT packet created. */
-                xReturnCode = eMQTTSuccess;
-            }
-        }
-    }
+    return prvPublish( pxMQTTContext, pxPublishParams, eMQTTFalse );
+}
+/*-----------------------------------------------------------*/
 
-    /* If the packet was successfully constructed, transmit it. */
-    if( xReturnCode == eMQTTSuccess )
-    {
-        xReturnCode = prvSendData( pxMQTTContext, mqttbufferGET_DATA( xBuffer ), mqttbufferGET_DATA_LENGTH( xBuffer ) );
-    }
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
 
-    /* If some error occurred or QOS0 (No ACK is expected in case of QOS0),
-     * return the buffer, otherwise it will be returned upon receiving ACK
-     * or timeout. */
-    if( ( xReturnCode != eMQTTSuccess ) || ( pxPublishParams->xQos == eMQTTQoS0 ) )
+    MQTTReturnCode_t MQTT_PublishZeroCopy( MQTTContext_t * pxMQTTContext,
+                                           const MQTTPublishParams_t * const pxPublishParams )
     {
-        /* Return the buffer to the free buffer pool. */
-        prvReturnBuffer( pxMQTTContext, xBuffer );
+        return prvPublish( pxMQTTContext, pxPublishParams, eMQTTTrue );
     }
 
-    return xReturnCode;
-}
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
 /*-----------------------------------------------------------*/
 
 MQTTReturnCode_t MQTT_ParseReceivedData( MQTTContext_t * pxMQTTContext,
@@ -3208,6 +4355,14 @@ MQTTReturnCode_t MQTT_ParseReceivedData( MQTTContext_t * pxMQTTContext,
                         pxMQTTContext->xRxMessageState.xRxNextByte = eMQTTRxNextByteMessage;
                         pxMQTTContext->xRxMessageState.xRxMessageAction = eMQTTRxMessageStore; /*_TODO_ This needs a timeout in case the rest of the message never comes. */
                     }
+                    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+                        /* Otherwise stream the message, if it is a publish message. */
+                        else if( ( pxMQTTContext->ucRxFixedHeaderBuffer[ mqttFIXED_HEADER_CONTROL_BYTE_OFFSET ] & mqttTOP_NIBBLE_MASK ) == mqttCONTROL_PUBLISH )
+                        {
+                            pxMQTTContext->xRxMessageState.xRxNextByte = eMQTTRxNextByteMessage;
+                            pxMQTTContext->xRxMessageState.xRxMessageAction = eMQTTRxMessageStream;
+                        }
+                    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
                     else
                     {
                         /* Otherwise drop the message. */
@@ -3272,6 +4427,17 @@ MQTTReturnCode_t MQTT_ParseReceivedData( MQTTContext_t * pxMQTTContext,
                 prvResetRxMessageState( pxMQTTContext );
             }
         }
+        #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+            else if( ( pxMQTTContext->xRxMessageState.xRxNextByte == eMQTTRxNextByteMessage ) && ( pxMQTTContext->xRxMessageState.xRxMessageAction == eMQTTRxMessageStream ) )
+            {
+                xReturnCode = prvStreamReceivedPublish( pxMQTTContext, pucReceivedData, xReceivedDataLength, &( xProcessedBytes ) );
+
+                if( xReturnCode != eMQTTSuccess )
+                {
+                    break;
+                }
+            }
+        #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
         else
         {
             /* Should not reach here. */
@@ -3360,6 +4526,9 @@ uint32_t MQTT_Periodic( MQTTContext_t * pxMQTTContext,
                 /* Inform the user about the timeout. */
                 xEventCallbackParams.xEventType = eMQTTTimeout;
                 xEventCallbackParams.u.xTimeoutData.usPacketIdentifier = mqttbufferGET_PACKET_IDENTIFIER( xBuffer );
+                #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+                    xEventCallbackParams.u.xTimeoutData.pvData = mqttbufferGET_PACKET_PAYLOAD( xBuffer );
+                #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
                 ( void ) prvInvokeCallback( pxMQTTContext, &xEventCallbackParams );
 
                 /* Return the buffer back to the free buffer pool. */
@@ -198,7 +198,7 @@ typedef union MultiParmPtr {
     char**      ppcPtr;
     const char** ppccPtr;
     uint32_t*   pulPtr;
-    uint32_t    ulVal;
+    size_t      ulVal;
     bool_t*     pxBoolPtr;
     Sig256_t**  ppxSig256Ptr;
     void**      ppvPtr;
@@ -298,6 +298,14 @@ static MQTTAgentReturnCode_t prvPublishMessage(void * pvClient, const char * con
 
 static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C, const char * pcRawMsg, uint32_t ulMsgSize, OTA_Err_t * pxCloseResult );
 
+#if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 )
+
+/* Include the received blocks which continue the signed part of the file in the signature check. */
+
+static void prvUpdateFileSignature( OTA_FileContext_t * C, uint32_t ulBlockIndex, const uint8_t * pucPayload, uint32_t ulBlockSize );
+
+#endif
+
 /* Called when the OTA agent receives an OTA version message. */
 
 static OTA_FileContext_t* prvProcessOTAJobMsg(const char *pcRawMsg, uint32_t ulMsgLen);
@@ -331,6 +339,22 @@ static void prvUpdateJobStatus (OTA_FileContext_t *C, OTA_JobStatus_t eStatus, i
 
 static OTA_Err_t prvPublishGetStreamMessage (OTA_FileContext_t *C);
 
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+
+/* Select the missing blocks to request next and build the bitmap of the Get Stream message. */
+
+static uint32_t prvBuildWindowBitmap( OTA_FileContext_t * C, uint8_t * pucBitmap, uint32_t * pulBitmapLen );
+
+/* Adapt the request window to a received block and request more blocks if needed. */
+
+static OTA_Err_t prvRequestWindowBlockReceived( OTA_FileContext_t * C, IngestResult_t xResult );
+
+/* Shrink the request window and request the missing blocks again after the request timer expired. */
+
+static void prvRequestWindowTimeout( OTA_FileContext_t * C );
+
+#endif
+
 /* Internal function to set the image state including an optional reason code. */
 
 static OTA_Err_t prvSetImageStateWithReason (OTA_ImageState_t eState, uint32_t ulReason);
@@ -350,7 +374,7 @@ static DocParseErr_t prvSearchModelForTokenKey( JSON_DocModel_t *pxDocModel, con
 /* Prepare the document model for use by sanity checking the initialization parameters
  * and detecting all required parameters. */
 
-static DocParseErr_t prvInitDocModel( JSON_DocModel_t *pxDocModel, const JSON_DocParam_t *pxBodyDef, uint32_t ulContextBaseAddr, uint32_t ulContextSize, uint16_t usNumJobParams );
+static DocParseErr_t prvInitDocModel( JSON_DocModel_t *pxDocModel, const JSON_DocParam_t *pxBodyDef, size_t ulContextBaseAddr, uint32_t ulContextSize, uint16_t usNumJobParams );
 
 /* Attempt to force reset the device. Normally called by the agent when a self test rejects the update. */
 
@@ -368,6 +392,11 @@ typedef struct ota_agent_statistics {
     uint32_t ulOTA_PacketsProcessed;                        /* Number of OTA packets processed by the OTA task. */
     uint32_t ulOTA_PacketsDropped;                          /* Number of OTA packets dropped due to congestion. */
     uint32_t ulOTA_PublishFailures;                         /* Number of MQTT publish failures. */
+    uint32_t ulOTA_StreamRequests;                          /* Number of Get Stream requests published. */
+    uint32_t ulOTA_BlocksRequested;                         /* Number of blocks asked for in the Get Stream requests. */
+    uint32_t ulOTA_DuplicateBlocks;                         /* Number of duplicate blocks received. */
+    uint32_t ulOTA_RequestTimeouts;                         /* Number of request timer expirations while receiving a file. */
+    uint32_t ulOTA_RequestWindow;                           /* Current block request window (windowed requests only). */
 } OTA_AgentStatistics_t;
 
 /* The OTA agent is a singleton today. The structure keeps it nice and organized. */
@@ -498,6 +527,11 @@ OTA_State_t OTA_AgentInit(void *pvClient, const uint8_t *pcThingName, pxOTACompl
 	xOTA_Agent.xStatistics.ulOTA_PacketsQueued = 0;
 	xOTA_Agent.xStatistics.ulOTA_PacketsProcessed = 0;
 	xOTA_Agent.xStatistics.ulOTA_PublishFailures = 0;
+	xOTA_Agent.xStatistics.ulOTA_StreamRequests = 0;
+	xOTA_Agent.xStatistics.ulOTA_BlocksRequested = 0;
+	xOTA_Agent.xStatistics.ulOTA_DuplicateBlocks = 0;
+	xOTA_Agent.xStatistics.ulOTA_RequestTimeouts = 0;
+	xOTA_Agent.xStatistics.ulOTA_RequestWindow = 0;
 
 	if ( pcThingName != NULL )
 	{
@@ -607,6 +641,31 @@ uint32_t OTA_GetPacketsReceived( void )
     return xOTA_Agent.xStatistics.ulOTA_PacketsReceived;
 }
 
+uint32_t OTA_GetStreamRequests( void )
+{
+    return xOTA_Agent.xStatistics.ulOTA_StreamRequests;
+}
+
+uint32_t OTA_GetBlocksRequested( void )
+{
+    return xOTA_Agent.xStatistics.ulOTA_BlocksRequested;
+}
+
+uint32_t OTA_GetDuplicateBlocks( void )
+{
+    return xOTA_Agent.xStatistics.ulOTA_DuplicateBlocks;
+}
+
+uint32_t OTA_GetRequestTimeouts( void )
+{
+    return xOTA_Agent.xStatistics.ulOTA_RequestTimeouts;
+}
+
+uint32_t OTA_GetRequestWindow( void )
+{
+    return xOTA_Agent.xStatistics.ulOTA_RequestWindow;
+}
+
 /* Request for the next available OTA job from the job service by publishing
  * a "get next job" message to the job service. */
 
@@ -1112,14 +1171,33 @@ static OTA_Err_t prvPublishGetStreamMessage(OTA_FileContext_t *C)
 	OTA_Err_t xErr = kOTA_Err_None;
 	char pcMsg[ OTA_REQUEST_MSG_MAX_SIZE ];
 	char pcTopicBuffer[ OTA_MAX_TOPIC_LEN ];
+	uint8_t *pucBitmap;
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+	uint8_t ucWindowBitmap[ OTA_MAX_BLOCK_BITMAP_SIZE ];
+#endif
 
 	if (C != NULL)
 	{
 		if ( C->ulRequestMomentum < OTA_MAX_STREAM_REQUEST_MOMENTUM )
 		{
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+			/* Only request the missing blocks that fit in the request window. */
+			pucBitmap = ucWindowBitmap;
+			ulNumBlocks = prvBuildWindowBitmap( C, pucBitmap, &ulBitmapLen );
+
+			if ( ulNumBlocks == 0U )
+			{
+				/* The window is full or all missing blocks have been requested. Wait for them. */
+				OTA_LOG_L2( "[%s] No blocks to request, %u in flight.\r\n", OTA_METHOD_NAME, C->ulBlocksInFlight );
+			}
+			else
+#else
+			/* Request all missing blocks. */
+			pucBitmap = C->pacRxBlockBitmap;
 			ulNumBlocks = ( C->ulFileSize + (OTA_FILE_BLOCK_SIZE - 1U) ) >> otaconfigLOG2_FILE_BLOCK_SIZE;
 			ulBitmapLen = (ulNumBlocks + (BITS_PER_BYTE - 1U)) >> LOG2_BITS_PER_BYTE;
-
+			ulNumBlocks = C->ulBlocksRemaining;
+#endif
 			if ( pdTRUE == OTA_CBOR_Encode_GetStreamRequestMessage (
 				(uint8_t *)pcMsg,
 				sizeof (pcMsg),
@@ -1128,7 +1206,7 @@ static OTA_Err_t prvPublishGetStreamMessage(OTA_FileContext_t *C)
 				( int32_t ) C->ulServerFileID,
 				( int32_t ) ( OTA_FILE_BLOCK_SIZE & 0x7fffffffUL ),     /* Mask to keep lint happy. It's still a constant. */
 				0,
-				C->pacRxBlockBitmap,
+				pucBitmap,
 				ulBitmapLen ) )
 			{
                 ulMsgSizeToPublish = (uint32_t)xMsgSizeFromStream;
@@ -1162,6 +1240,8 @@ static OTA_Err_t prvPublishGetStreamMessage(OTA_FileContext_t *C)
                     else
                     {
                         OTA_LOG_L1( "[%s] OK: %s\r\n", OTA_METHOD_NAME, pcTopicBuffer);
+                        xOTA_Agent.xStatistics.ulOTA_StreamRequests++;
+                        xOTA_Agent.xStatistics.ulOTA_BlocksRequested += ulNumBlocks;
                         /* Restart the request timer to retry if we don't complete the update. */
                         prvStartRequestTimer (C);
                     }
@@ -1193,6 +1273,120 @@ static OTA_Err_t prvPublishGetStreamMessage(OTA_FileContext_t *C)
 	return xErr;
 }
 
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+
+/* Select the missing blocks to request next and build the bitmap of the Get Stream message.
+ *
+ * The blocks are requested in ascending order. The search for missing blocks continues where
+ * the previous request stopped so that blocks which are in flight are not requested again.
+ * The received block bitmap is the source of truth, so blocks that arrived in the meantime
+ * (e.g. late responses to an earlier request) are skipped. Returns the number of blocks selected.
+ */
+static uint32_t prvBuildWindowBitmap( OTA_FileContext_t * C,
+                                      uint8_t * pucBitmap,
+                                      uint32_t * pulBitmapLen )
+{
+    uint32_t ulNumBlocks = ( C->ulFileSize + ( OTA_FILE_BLOCK_SIZE - 1U ) ) >> otaconfigLOG2_FILE_BLOCK_SIZE;
+    uint32_t ulBlock;
+    uint32_t ulCount = 0U;
+    uint8_t ucBitMask;
+
+    memset( pucBitmap, 0, OTA_MAX_BLOCK_BITMAP_SIZE );
+
+    for ( ulBlock = C->ulNextBlockToRequest;
+          ( ulBlock < ulNumBlocks ) && ( ( C->ulBlocksInFlight + ulCount ) < C->ulRequestWindow );
+          ulBlock++ )
+    {
+        ucBitMask = 1U << ( ulBlock % BITS_PER_BYTE ); /*lint !e9031 The composite expression will never be greater than BITS_PER_BYTE(8). */
+
+        if ( ( C->pacRxBlockBitmap[ ulBlock >> LOG2_BITS_PER_BYTE ] & ucBitMask ) != 0U )
+        {
+            pucBitmap[ ulBlock >> LOG2_BITS_PER_BYTE ] |= ucBitMask;
+            ulCount++;
+        }
+    }
+
+    C->ulNextBlockToRequest = ulBlock;
+    C->ulBlocksInFlight += ulCount;
+
+    /* The bitmap only has to reach the last block scanned. */
+    *pulBitmapLen = ( ulCount > 0U ) ? ( ( ( ulBlock - 1U ) >> LOG2_BITS_PER_BYTE ) + 1U ) : 0U;
+
+    return ulCount;
+}
+
+
+/* Adapt the request window to a received block and request more blocks if needed.
+ *
+ * Below the threshold, the window grows by one block for every block received, which doubles
+ * it every round trip while the link keeps up. Above it, the window grows by one block for every
+ * window of blocks received. A duplicate block means that a block was requested again before it
+ * arrived, so the window stops growing quickly. More blocks are requested once half of the
+ * window has been received so that the next blocks are on their way before the window drains.
+ */
+static OTA_Err_t prvRequestWindowBlockReceived( OTA_FileContext_t * C,
+                                                IngestResult_t xResult )
+{
+    OTA_Err_t xErr = kOTA_Err_None;
+
+    if ( xResult == eIngest_Result_Accepted_Continue )
+    {
+        if ( C->ulBlocksInFlight > 0U )
+        {
+            C->ulBlocksInFlight--;
+        }
+
+        if ( C->ulRequestWindow < otaconfigREQUEST_WINDOW_MAX_BLOCKS )
+        {
+            C->ulWindowProgress++;
+
+            if ( ( C->ulRequestWindow < C->ulRequestWindowThreshold ) || ( C->ulWindowProgress >= C->ulRequestWindow ) )
+            {
+                C->ulRequestWindow++;
+                C->ulWindowProgress = 0U;
+            }
+        }
+    }
+    else
+    {
+        C->ulRequestWindowThreshold = C->ulRequestWindow;
+        C->ulWindowProgress = 0U;
+    }
+
+    xOTA_Agent.xStatistics.ulOTA_RequestWindow = C->ulRequestWindow;
+
+    if ( C->ulBlocksInFlight <= ( C->ulRequestWindow / 2U ) )
+    {
+        xErr = prvPublishGetStreamMessage( C );
+    }
+
+    return xErr;
+}
+
+
+/* Shrink the request window and request the missing blocks again after the request timer expired.
+ *
+ * The blocks in flight are assumed to be lost, so the search for missing blocks starts over from
+ * the beginning of the file. The window is only halved if blocks were in flight since the first
+ * request of a file is also sent when the request timer expires.
+ */
+static void prvRequestWindowTimeout( OTA_FileContext_t * C )
+{
+    if ( C->ulBlocksInFlight > 0U )
+    {
+        C->ulRequestWindowThreshold = ( C->ulRequestWindow > 1U ) ? ( C->ulRequestWindow / 2U ) : 1U;
+        C->ulRequestWindow = C->ulRequestWindowThreshold;
+        C->ulWindowProgress = 0U;
+    }
+
+    C->ulBlocksInFlight = 0U;
+    C->ulNextBlockToRequest = 0U;
+    xOTA_Agent.xStatistics.ulOTA_RequestWindow = C->ulRequestWindow;
+}
+
+#endif /* otaconfigREQUEST_WINDOW_MAX_BLOCKS */
+
+
 
 /* This function is called whenever we receive a MQTT publish message on one of our OTA topics. */
 
@@ -1294,6 +1488,10 @@ static void prvOTAUpdateTask( void* pvUnused )
 				{
 				    if ( C->ulBlocksRemaining > 0U )
 				    {
+	                    xOTA_Agent.xStatistics.ulOTA_RequestTimeouts++;
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+	                    prvRequestWindowTimeout( C );
+#endif
 	                    xErr = prvPublishGetStreamMessage ( C );
 	                    if ( xErr != kOTA_Err_None )
 	                    {   /* Abort the current OTA. */
@@ -1412,6 +1610,20 @@ static void prvOTAUpdateTask( void* pvUnused )
                                         /* First reset the momentum counter since we received a good block. */
                                         C->ulRequestMomentum = 0;
                                         prvUpdateJobStatus (C, eJobStatus_InProgress, ( int32_t ) eJobReason_Receiving, ( int32_t ) NULL);
+                                        if ( xResult == eIngest_Result_Duplicate_Continue )
+                                        {
+                                            xOTA_Agent.xStatistics.ulOTA_DuplicateBlocks++;
+                                        }
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+                                        /* Keep the request window filled. */
+                                        xErr = prvRequestWindowBlockReceived( C, xResult );
+                                        if ( xErr != kOTA_Err_None )
+                                        {   /* Abort the current OTA. */
+                                            ( void ) prvSetImageStateWithReason( eOTA_ImageState_Aborted, xErr );
+                                            ( void ) prvOTA_Close( C ); /* Ignore false result since we're setting the pointer to null on the next line. */
+                                            C = NULL;
+                                        }
+#endif
                                     }
                                 }
                              }
@@ -2038,7 +2250,7 @@ static DocParseErr_t prvParseJSONbyModel( const char *pcJSON, uint32_t ulMsgLen,
  * and detecting all required parameters. */
 
 static DocParseErr_t prvInitDocModel( JSON_DocModel_t *pxDocModel, const JSON_DocParam_t *pxBodyDef,
-        uint32_t ulContextBaseAddr, uint32_t ulContextSize, uint16_t usNumJobParams )
+        size_t ulContextBaseAddr, uint32_t ulContextSize, uint16_t usNumJobParams )
 {
     DEFINE_OTA_METHOD_NAME("prvInitDocModel");
 
@@ -2099,7 +2311,7 @@ static OTA_FileContext_t *prvParseJobDoc(const char *pcJSON, uint32_t ulMsgLen )
     /*lint -e{708} We intentionally do some things lint warns about but produce the proper model. */
     /* Namely union initialization and pointers converted to values. */
     static const JSON_DocParam_t xOTA_JobDocModelParamStructure[ OTA_NUM_JOB_PARAMS ] = {
-        { pcOTA_JSON_ClientTokenKey, OTA_JOB_PARAM_OPTIONAL, { (uint32_t) &xOTA_Agent.pcClientTokenFromJob }, eModelParamType_StringInDoc, JSMN_STRING }, /*lint !e9078 !e923 Get address of token as value. */
+        { pcOTA_JSON_ClientTokenKey, OTA_JOB_PARAM_OPTIONAL, { (size_t) &xOTA_Agent.pcClientTokenFromJob }, eModelParamType_StringInDoc, JSMN_STRING }, /*lint !e9078 !e923 Get address of token as value. */
         { pcOTA_JSON_ExecutionKey, OTA_JOB_PARAM_REQUIRED, { OTA_DONT_STORE_PARAM }, eModelParamType_Object, JSMN_OBJECT },
         { pcOTA_JSON_JobIDKey, OTA_JOB_PARAM_REQUIRED, { OFFSET_OF( OTA_FileContext_t, pacJobName ) }, eModelParamType_StringCopy, JSMN_STRING },
         { pcOTA_JSON_StatusDetailsKey, OTA_JOB_PARAM_OPTIONAL, { OTA_DONT_STORE_PARAM }, eModelParamType_Object, JSMN_OBJECT },
@@ -2132,7 +2344,7 @@ static OTA_FileContext_t *prvParseJobDoc(const char *pcJSON, uint32_t ulMsgLen )
         JSON_DocModel_t xOTA_JobDocModel;
         if ( prvInitDocModel( &xOTA_JobDocModel,
                               xOTA_JobDocModelParamStructure,
-                              (uint32_t) C, /*lint !e9078 !e923 Intentionally casting context pointer to a value for prvInitDocModel. */
+                              (size_t) C, /*lint !e9078 !e923 Intentionally casting context pointer to a value for prvInitDocModel. */
                               sizeof( OTA_FileContext_t ),
                               OTA_NUM_JOB_PARAMS ) != eDocParseErr_None )
         {
@@ -2340,6 +2552,14 @@ static OTA_FileContext_t* prvProcessOTAJobMsg( const char *pcRawMsg, uint32_t ul
                     ulBit >>= 1U;
                 }
                 pstUpdateFile->ulBlocksRemaining = ulNumBlocks;     /* Initialize our blocks remaining counter. */
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+                pstUpdateFile->ulRequestWindow = otaconfigREQUEST_WINDOW_INITIAL_BLOCKS;
+                pstUpdateFile->ulRequestWindowThreshold = otaconfigREQUEST_WINDOW_MAX_BLOCKS;
+                pstUpdateFile->ulWindowProgress = 0U;
+                pstUpdateFile->ulBlocksInFlight = 0U;
+                pstUpdateFile->ulNextBlockToRequest = 0U;
+                xOTA_Agent.xStatistics.ulOTA_RequestWindow = pstUpdateFile->ulRequestWindow;
+#endif
                 prvStartRequestTimer(pstUpdateFile);
 
                 /* Create/Open the OTA file on the file system. */
@@ -2368,6 +2588,59 @@ static OTA_FileContext_t* prvProcessOTAJobMsg( const char *pcRawMsg, uint32_t ul
 
 
 
+#if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 )
+
+/* prvUpdateFileSignature
+ *
+ * The signature check covers the file from its start up to the first block not received yet.
+ * If the block just received is that block, hash it from the message payload. Blocks received
+ * earlier out of order which now follow it are read back from the file by the PAL, so no more
+ * RAM than the block bitmap is needed to track them. When the last block arrives, the PAL
+ * only has to finish the signature check instead of reading the whole file again.
+ */
+static void prvUpdateFileSignature( OTA_FileContext_t * C,
+                                    uint32_t ulBlockIndex,
+                                    const uint8_t * pucPayload,
+                                    uint32_t ulBlockSize )
+{
+    uint32_t ulNextBlock;
+    uint32_t ulSize;
+    uint32_t ulVerifiedSize;
+
+    if ( ( C->pvSigVerifyContext != NULL ) && ( ( C->ulSigVerifiedSize >> otaconfigLOG2_FILE_BLOCK_SIZE ) == ulBlockIndex ) )
+    {
+        ( void ) prvPAL_UpdateFileSignature( C, pucPayload, ulBlockSize );
+    }
+
+    /* Continue with the blocks that were received out of order, if any. */
+    while ( ( C->pvSigVerifyContext != NULL ) && ( C->ulSigVerifiedSize < C->ulFileSize ) )
+    {
+        ulNextBlock = C->ulSigVerifiedSize >> otaconfigLOG2_FILE_BLOCK_SIZE;
+
+        if ( ( C->pacRxBlockBitmap[ ulNextBlock >> LOG2_BITS_PER_BYTE ] & ( 1U << ( ulNextBlock % BITS_PER_BYTE ) ) ) != 0U )
+        {
+            break;  /* The next block has not been received yet. */
+        }
+
+        ulSize = C->ulFileSize - C->ulSigVerifiedSize;
+
+        if ( ulSize > OTA_FILE_BLOCK_SIZE )
+        {
+            ulSize = OTA_FILE_BLOCK_SIZE;
+        }
+
+        ulVerifiedSize = C->ulSigVerifiedSize;
+
+        if ( ( prvPAL_UpdateFileSignature( C, NULL, ulSize ) != kOTA_Err_None ) ||
+             ( C->ulSigVerifiedSize == ulVerifiedSize ) )
+        {
+            break;  /* The PAL has dropped the context or could not read the file. The rest is checked on close. */
+        }
+    }
+}
+
+#endif /* otaconfigINCREMENTAL_SIGNATURE_CHECK */
+
 /* prvIngestDataBlock
  *
  * A block of file data was received by the application via some configured communication protocol.
@@ -2388,7 +2661,7 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
     int32_t lFileId = 0;
     uint32_t ulBlockSize = 0;
     uint32_t ulBlockIndex = 0;
-    uint8_t *pucPayload = NULL;
+    const uint8_t *pucPayload = NULL;
     size_t xPayloadSize = 0;
 
     if ( C != NULL )
@@ -2404,13 +2677,13 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
                 prvStartRequestTimer( C );
 
                 /* Decode the CBOR content. */
-                if( pdFALSE == OTA_CBOR_Decode_GetStreamResponseMessage(
+                if( pdFALSE == OTA_CBOR_Decode_GetStreamResponseMessageInPlace(
                     (const uint8_t * ) pcRawMsg,
                     ulMsgSize,
                     &lFileId,
                     (int32_t*)&ulBlockIndex,    /*lint !e9087 CBOR requires pointer to int and our block index's never exceed 31 bits. */
                     (int32_t*)&ulBlockSize,     /*lint !e9087 CBOR requires pointer to int and our block sizes never exceed 31 bits. */
-                    &pucPayload,                /* This payload gets malloc'd by OTA_CBOR_Decode_GetStreamResponseMessage(). We must free it. */
+                    &pucPayload,                /* This payload points into pcRawMsg so the block is written without copying it. */
                     ( size_t* ) &xPayloadSize ) )
                 {
                     eIngestResult = eIngest_Result_BadData;
@@ -2423,8 +2696,10 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
                     /* If the block ID is out of range, that's an error so abort. */
                     uint32_t iLastBlock = ( ( C->ulFileSize + ( OTA_FILE_BLOCK_SIZE - 1U ) ) >> otaconfigLOG2_FILE_BLOCK_SIZE ) - 1U;
 
-                    if ( ( ( ( uint32_t )ulBlockIndex < iLastBlock ) && ( ulBlockSize == OTA_FILE_BLOCK_SIZE ) ) ||
-                        ( ( ( uint32_t )ulBlockIndex == iLastBlock ) && ( ( uint32_t )ulBlockSize == ( C->ulFileSize - ( iLastBlock * OTA_FILE_BLOCK_SIZE ) ) ) ) )
+                    /* The payload MUST hold the whole block. */
+                    if ( ( ( ( ( uint32_t )ulBlockIndex < iLastBlock ) && ( ulBlockSize == OTA_FILE_BLOCK_SIZE ) ) ||
+                        ( ( ( uint32_t )ulBlockIndex == iLastBlock ) && ( ( uint32_t )ulBlockSize == ( C->ulFileSize - ( iLastBlock * OTA_FILE_BLOCK_SIZE ) ) ) ) ) &&
+                        ( xPayloadSize == ( size_t ) ulBlockSize ) )
                     {
                         OTA_LOG_L1("[%s] Received file block %u, size %u\r\n", OTA_METHOD_NAME, ulBlockIndex, ulBlockSize);
 
@@ -2445,7 +2720,7 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
                         {
                             if ( C->pucFile != NULL )
                             {
-                                int32_t iBytesWritten = prvPAL_WriteBlock( C, ( ulBlockIndex * OTA_FILE_BLOCK_SIZE ), pucPayload, ( uint32_t )ulBlockSize );
+                                int32_t iBytesWritten = prvPAL_WriteBlock( C, ( ulBlockIndex * OTA_FILE_BLOCK_SIZE ), ( uint8_t * ) pucPayload, ( uint32_t )ulBlockSize ); /*lint !e9005 The PAL does not modify the block data. */
 
                                 if ( iBytesWritten < 0 )
                                 {
@@ -2458,6 +2733,9 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
                                     C->ulBlocksRemaining--;
                                     eIngestResult = eIngest_Result_Accepted_Continue;
                                     *pxCloseResult = kOTA_Err_None;             /* This is a success path. */
+#if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 )
+                                    prvUpdateFileSignature( C, ulBlockIndex, pucPayload, ( uint32_t ) ulBlockSize );
+#endif
                                 }
                             }
                             else
@@ -2531,10 +2809,6 @@ static IngestResult_t prvIngestDataBlock( OTA_FileContext_t * C,
     else
     {
         eIngestResult = eIngest_Result_NullContext;
-    }
-	if ( NULL != pucPayload )
-    {
-        vPortFree( pucPayload );
     }
     return eIngestResult;
 }
@@ -49,26 +49,26 @@ typedef struct OTAMessageDecodeContext
 } OTAMessageDecodeContext_t, * OTAMessageDecodeContextPtr_t;
 
 /**
- * @brief Decode a Get Stream response message from AWS IoT OTA.
+ * @brief Decode the fields of a Get Stream response message from AWS IoT OTA
+ * and find the payload byte string, which is returned in pxCborValue.
  */
-BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageBuffer,
-                                                     size_t xMessageSize,
-                                                     int32_t * plFileId,
-                                                     int32_t * plBlockId,
-                                                     int32_t * plBlockSize,
-                                                     uint8_t ** ppucPayload,
-                                                     size_t * pxPayloadSize )
+static CborError prvDecodeStreamResponseFields( const uint8_t * pucMessageBuffer,
+                                                size_t xMessageSize,
+                                                CborParser * pxCborParser,
+                                                CborValue * pxCborValue,
+                                                int32_t * plFileId,
+                                                int32_t * plBlockId,
+                                                int32_t * plBlockSize )
 {
     CborError xCborResult = CborNoError;
-    CborParser xCborParser;
-    CborValue xCborValue, xCborMap;
+    CborValue xCborMap;
 
     /* Initialize the parser. */
     xCborResult = cbor_parser_init(
         pucMessageBuffer,
         xMessageSize,
         0,
-        &xCborParser,
+        pxCborParser,
         &xCborMap );
 
     /* Get the outer element and confirm that it's a "map," i.e., a set of
@@ -87,13 +87,13 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
         xCborResult = cbor_value_map_find_value(
             &xCborMap,
             OTA_CBOR_FILEID_KEY,
-            &xCborValue );
+            pxCborValue );
     }
 
     if( CborNoError == xCborResult )
     {
         if( CborIntegerType != cbor_value_get_type(
-                                     &xCborValue ) )
+                                     pxCborValue ) )
         {
             xCborResult = CborErrorIllegalType;
         }
@@ -102,7 +102,7 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
     if( CborNoError == xCborResult )
     {
         xCborResult = cbor_value_get_int(
-            &xCborValue,
+            pxCborValue,
             plFileId );
     }
 
@@ -112,13 +112,13 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
         xCborResult = cbor_value_map_find_value(
             &xCborMap,
             OTA_CBOR_BLOCKID_KEY,
-            &xCborValue );
+            pxCborValue );
     }
 
     if( CborNoError == xCborResult )
     {
         if( CborIntegerType != cbor_value_get_type(
-                                     &xCborValue ) )
+                                     pxCborValue ) )
         {
             xCborResult = CborErrorIllegalType;
         }
@@ -127,7 +127,7 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
     if( CborNoError == xCborResult )
     {
         xCborResult = cbor_value_get_int(
-            &xCborValue,
+            pxCborValue,
             plBlockId );
     }
 
@@ -137,13 +137,13 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
         xCborResult = cbor_value_map_find_value(
             &xCborMap,
             OTA_CBOR_BLOCKSIZE_KEY,
-            &xCborValue );
+            pxCborValue );
     }
 
     if( CborNoError == xCborResult )
     {
         if( CborIntegerType != cbor_value_get_type(
-                                     &xCborValue ) )
+                                     pxCborValue ) )
         {
             xCborResult = CborErrorIllegalType;
         }
@@ -152,7 +152,7 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
     if( CborNoError == xCborResult )
     {
         xCborResult = cbor_value_get_int(
-            &xCborValue,
+            pxCborValue,
             plBlockSize );
     }
 
@@ -162,18 +162,45 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
         xCborResult = cbor_value_map_find_value(
             &xCborMap,
             OTA_CBOR_BLOCKPAYLOAD_KEY,
-            &xCborValue );
+            pxCborValue );
     }
 
     if( CborNoError == xCborResult )
     {
         if( CborByteStringType != cbor_value_get_type(
-                                        &xCborValue ) )
+                                        pxCborValue ) )
         {
             xCborResult = CborErrorIllegalType;
         }
     }
 
+    return xCborResult;
+}
+
+/**
+ * @brief Decode a Get Stream response message from AWS IoT OTA.
+ */
+BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageBuffer,
+                                                     size_t xMessageSize,
+                                                     int32_t * plFileId,
+                                                     int32_t * plBlockId,
+                                                     int32_t * plBlockSize,
+                                                     uint8_t ** ppucPayload,
+                                                     size_t * pxPayloadSize )
+{
+    CborError xCborResult = CborNoError;
+    CborParser xCborParser;
+    CborValue xCborValue;
+
+    xCborResult = prvDecodeStreamResponseFields(
+        pucMessageBuffer,
+        xMessageSize,
+        &xCborParser,
+        &xCborValue,
+        plFileId,
+        plBlockId,
+        plBlockSize );
+
     if( CborNoError == xCborResult )
     {
         xCborResult = cbor_value_calculate_string_length(
@@ -203,6 +230,76 @@ BaseType_t OTA_CBOR_Decode_GetStreamResponseMessage( const uint8_t * pucMessageB
     return CborNoError == xCborResult;
 }
 
+/**
+ * @brief Decode a Get Stream response message from AWS IoT OTA without
+ * copying the payload.
+ */
+BaseType_t OTA_CBOR_Decode_GetStreamResponseMessageInPlace( const uint8_t * pucMessageBuffer,
+                                                            size_t xMessageSize,
+                                                            int32_t * plFileId,
+                                                            int32_t * plBlockId,
+                                                            int32_t * plBlockSize,
+                                                            const uint8_t ** ppucPayload,
+                                                            size_t * pxPayloadSize )
+{
+    CborError xCborResult = CborNoError;
+    CborParser xCborParser;
+    CborValue xCborValue;
+
+    xCborResult = prvDecodeStreamResponseFields(
+        pucMessageBuffer,
+        xMessageSize,
+        &xCborParser,
+        &xCborValue,
+        plFileId,
+        plBlockId,
+        plBlockSize );
+
+    /* Only a definite length byte string is stored contiguously in the
+     * message. The service does not send the payload in chunks. */
+    if( CborNoError == xCborResult )
+    {
+        if( false == cbor_value_is_length_known(
+                &xCborValue ) )
+        {
+            xCborResult = CborErrorUnknownLength;
+        }
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_value_get_string_length(
+            &xCborValue,
+            pxPayloadSize );
+    }
+
+    /* The parser does not check that the byte string fits in the message
+     * until it is read, so check it here before pointing to it. */
+    if( CborNoError == xCborResult )
+    {
+        if( *pxPayloadSize > ( size_t ) ( ( pucMessageBuffer + xMessageSize ) -
+                                          cbor_value_get_next_byte( &xCborValue ) ) )
+        {
+            xCborResult = CborErrorUnexpectedEOF;
+        }
+    }
+
+    /* Skip over the byte string. Its contents end where the next item
+     * starts. */
+    if( CborNoError == xCborResult )
+    {
+        xCborResult = cbor_value_advance(
+            &xCborValue );
+    }
+
+    if( CborNoError == xCborResult )
+    {
+        *ppucPayload = cbor_value_get_next_byte( &xCborValue ) - *pxPayloadSize;
+    }
+
+    return CborNoError == xCborResult;
+}
+
 
 
 /**
@@ -23,8 +23,10 @@
  * http://www.FreeRTOS.org
  */
 
-/* OTA PAL implementation for Windows platform. */
+/* OTA PAL implementation for Windows platform.  Only stdio is used, so the
+ * same implementation is also used by the POSIX (Linux) simulator. */
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "FreeRTOS.h"
@@ -36,6 +38,9 @@
 const char pcOTA_JSON_FileSignatureKey[ OTA_FILE_SIG_KEY_STR_MAX_LENGTH ] = "sig-sha256-ecdsa";
 
 static OTA_Err_t prvPAL_CheckFileSignature( OTA_FileContext_t * const C );
+static OTA_Err_t prvPAL_HashFileData( OTA_FileContext_t * const C,
+                                      uint32_t ulSize );
+static void prvPAL_FreeSignatureContext( OTA_FileContext_t * const C );
 static uint8_t * prvPAL_ReadAndAssumeCertificate( const uint8_t * const pucCertName,
                                                   uint32_t * const ulSignerCertSize );
 
@@ -72,6 +77,17 @@ OTA_Err_t prvPAL_CreateFileForRx( OTA_FileContext_t * const C )
             {
                 eResult = kOTA_Err_None;
                 OTA_LOG_L1( "[%s] Receive file created.\r\n", OTA_METHOD_NAME );
+
+                #if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 )
+                    /* Start the signature check now so that the blocks can be hashed as they are
+                     * received. If it cannot be started, the whole file is hashed on close. */
+                    C->ulSigVerifiedSize = 0;
+
+                    if( pdFALSE == CRYPTO_SignatureVerificationStart( &C->pvSigVerifyContext, cryptoASYMMETRIC_ALGORITHM_ECDSA, cryptoHASH_ALGORITHM_SHA256 ) )
+                    {
+                        C->pvSigVerifyContext = NULL;
+                    }
+                #endif
             }
             else
             {
@@ -110,6 +126,9 @@ OTA_Err_t prvPAL_Abort( OTA_FileContext_t * const C )
 
     if( NULL != C )
     {
+        /* Drop any signature check in progress. */
+        prvPAL_FreeSignatureContext( C );
+
         /* Close the OTA update file if it's open. */
         if( NULL != C->pstFile )
         {
@@ -214,6 +233,9 @@ OTA_Err_t prvPAL_CloseFile( OTA_FileContext_t * const C )
             eResult = kOTA_Err_SignatureCheckFailed;
         }
 
+        /* Drop the signature check started when the file was created, if it was not used. */
+        prvPAL_FreeSignatureContext( C );
+
         /* Close the file. */
         lWindowsError = fclose( C->pstFile ); /*lint !e482 !e586
                                                * C standard library call is being used for portability. */
@@ -259,64 +281,48 @@ static OTA_Err_t prvPAL_CheckFileSignature( OTA_FileContext_t * const C )
     DEFINE_OTA_METHOD_NAME( "prvPAL_CheckFileSignature" );
 
     OTA_Err_t eResult = kOTA_Err_None;
-    uint32_t ulBytesRead;
     uint32_t ulSignerCertSize;
-    uint8_t * pucBuf, * pucSignerCert;
-    void * pvSigVerifyContext;
+    uint8_t * pucSignerCert;
 
     if( prvContextValidate( C ) == pdTRUE )
     {
-        /* Verify an ECDSA-SHA256 signature. */
-        if( pdFALSE == CRYPTO_SignatureVerificationStart( &pvSigVerifyContext, cryptoASYMMETRIC_ALGORITHM_ECDSA, cryptoHASH_ALGORITHM_SHA256 ) )
+        /* Continue the signature check started when the file was created, if any, so
+         * that only the part of the file which was not hashed yet needs to be read. */
+        if( C->pvSigVerifyContext == NULL )
         {
-            eResult = kOTA_Err_SignatureCheckFailed;
+            C->ulSigVerifiedSize = 0;
+
+            /* Verify an ECDSA-SHA256 signature. */
+            if( pdFALSE == CRYPTO_SignatureVerificationStart( &C->pvSigVerifyContext, cryptoASYMMETRIC_ALGORITHM_ECDSA, cryptoHASH_ALGORITHM_SHA256 ) )
+            {
+                C->pvSigVerifyContext = NULL;
+                eResult = kOTA_Err_SignatureCheckFailed;
+            }
         }
-        else
+
+        if( eResult == kOTA_Err_None )
         {
-            OTA_LOG_L1( "[%s] Started %s signature verification, file: %s\r\n", OTA_METHOD_NAME,
-                        pcOTA_JSON_FileSignatureKey, ( const char * ) C->pacCertFilepath );
+            OTA_LOG_L1( "[%s] Started %s signature verification at offset %u, file: %s\r\n", OTA_METHOD_NAME,
+                        pcOTA_JSON_FileSignatureKey, C->ulSigVerifiedSize, ( const char * ) C->pacCertFilepath );
             pucSignerCert = prvPAL_ReadAndAssumeCertificate( ( const uint8_t * const ) C->pacCertFilepath, &ulSignerCertSize );
 
             if( pucSignerCert != NULL )
             {
-                pucBuf = pvPortMalloc( OTA_PAL_WIN_BUF_SIZE ); /*lint !e9079 Allow conversion. */
+                /* Include the rest of the received file in the signature validation. */
+                eResult = prvPAL_HashFileData( C, UINT32_MAX );
 
-                if( pucBuf != NULL )
+                if( eResult == kOTA_Err_None )
                 {
-                    /* Rewind the received file to the beginning. */
-                    if( fseek( C->pstFile, 0L, SEEK_SET ) == 0 ) /*lint !e586
-                                                                  * C standard library call is being used for portability. */
-                    {
-                        do
-                        {
-                            ulBytesRead = fread( pucBuf, 1, OTA_PAL_WIN_BUF_SIZE, C->pstFile ); /*lint !e586
-                                                                                               * C standard library call is being used for portability. */
-                            /* Include the file chunk in the signature validation. Zero size is OK. */
-                            CRYPTO_SignatureVerificationUpdate( pvSigVerifyContext, pucBuf, ulBytesRead );
-                        } while( ulBytesRead > 0UL );
-
-                        if( pdFALSE == CRYPTO_SignatureVerificationFinal( pvSigVerifyContext,
-                                                                          ( char * ) pucSignerCert,
-                                                                          ( size_t ) ulSignerCertSize,
-                                                                          C->pxSignature->ucData,
-                                                                          C->pxSignature->usSize ) ) /*lint !e732 !e9034 Allow comparison in this context. */
-                        {
-                            eResult = kOTA_Err_SignatureCheckFailed;
-                        }
-						pvSigVerifyContext = NULL;	/* The context has been freed by CRYPTO_SignatureVerificationFinal(). */
-                    }
-                    else
+                    if( pdFALSE == CRYPTO_SignatureVerificationFinal( C->pvSigVerifyContext,
+                                                                      ( char * ) pucSignerCert,
+                                                                      ( size_t ) ulSignerCertSize,
+                                                                      C->pxSignature->ucData,
+                                                                      C->pxSignature->usSize ) ) /*lint !e732 !e9034 Allow comparison in this context. */
                     {
-                        /* Nothing special to do. */
+                        eResult = kOTA_Err_SignatureCheckFailed;
                     }
 
-                    /* Free the temporary file page buffer. */
-                    vPortFree( pucBuf );
-                }
-                else
-                {
-                    OTA_LOG_L1( "[%s] ERROR - Failed to allocate buffer memory.\r\n", OTA_METHOD_NAME );
-                    eResult = kOTA_Err_OutOfMemory;
+                    C->pvSigVerifyContext = NULL; /* The context has been freed by CRYPTO_SignatureVerificationFinal(). */
                 }
 
                 /* Free the signer certificate that we now own after prvReadAndAssumeCertificate(). */
@@ -326,6 +332,9 @@ static OTA_Err_t prvPAL_CheckFileSignature( OTA_FileContext_t * const C )
             {
                 eResult = kOTA_Err_BadSignerCert;
             }
+
+            /* Free the context if the signature was not verified. */
+            prvPAL_FreeSignatureContext( C );
         }
     }
     else
@@ -340,6 +349,108 @@ static OTA_Err_t prvPAL_CheckFileSignature( OTA_FileContext_t * const C )
 }
 
 
+/* Include the next part of the received file in the signature check. */
+
+OTA_Err_t prvPAL_UpdateFileSignature( OTA_FileContext_t * const C,
+                                      const uint8_t * const pcData,
+                                      uint32_t ulSize )
+{
+    DEFINE_OTA_METHOD_NAME( "prvPAL_UpdateFileSignature" );
+
+    OTA_Err_t eResult = kOTA_Err_None;
+
+    if( ( prvContextValidate( C ) == pdTRUE ) && ( C->pvSigVerifyContext != NULL ) )
+    {
+        if( pcData != NULL )
+        {
+            CRYPTO_SignatureVerificationUpdate( C->pvSigVerifyContext, pcData, ulSize );
+            C->ulSigVerifiedSize += ulSize;
+        }
+        else
+        {
+            /* The data was received earlier and has to be read back from the file. */
+            eResult = prvPAL_HashFileData( C, ulSize );
+        }
+
+        if( eResult != kOTA_Err_None )
+        {
+            /* The whole file will be hashed again when it is closed. */
+            OTA_LOG_L1( "[%s] ERROR - Incremental signature check stopped: %d\r\n", OTA_METHOD_NAME, eResult );
+            prvPAL_FreeSignatureContext( C );
+        }
+    }
+    else
+    {
+        OTA_LOG_L1( "[%s] ERROR - No signature check in progress.\r\n", OTA_METHOD_NAME );
+        eResult = kOTA_Err_NullFilePtr;
+    }
+
+    return eResult;
+}
+
+
+/* Read up to ulSize bytes of the received file, starting from the end of the data already
+ * included in the signature check, and include them in the signature check. */
+
+static OTA_Err_t prvPAL_HashFileData( OTA_FileContext_t * const C,
+                                      uint32_t ulSize )
+{
+    DEFINE_OTA_METHOD_NAME( "prvPAL_HashFileData" );
+
+    OTA_Err_t eResult = kOTA_Err_None;
+    uint32_t ulBytesToRead, ulBytesRead;
+    uint8_t * pucBuf;
+
+    pucBuf = pvPortMalloc( OTA_PAL_WIN_BUF_SIZE ); /*lint !e9079 Allow conversion. */
+
+    if( pucBuf != NULL )
+    {
+        if( fseek( C->pstFile, ( long ) C->ulSigVerifiedSize, SEEK_SET ) == 0 ) /*lint !e586
+                                                                                 * C standard library call is being used for portability. */
+        {
+            do
+            {
+                ulBytesToRead = ( ulSize < OTA_PAL_WIN_BUF_SIZE ) ? ulSize : ( uint32_t ) OTA_PAL_WIN_BUF_SIZE;
+                ulBytesRead = fread( pucBuf, 1, ulBytesToRead, C->pstFile ); /*lint !e586
+                                                                              * C standard library call is being used for portability. */
+                /* Include the file chunk in the signature validation. Zero size is OK. */
+                CRYPTO_SignatureVerificationUpdate( C->pvSigVerifyContext, pucBuf, ulBytesRead );
+                C->ulSigVerifiedSize += ulBytesRead;
+                ulSize -= ulBytesRead;
+            } while( ( ulBytesRead == ulBytesToRead ) && ( ulSize > 0UL ) );
+        }
+        else
+        {
+            OTA_LOG_L1( "[%s] ERROR - fseek failed\r\n", OTA_METHOD_NAME );
+            eResult = kOTA_Err_SignatureCheckFailed;
+        }
+
+        /* Free the temporary file page buffer. */
+        vPortFree( pucBuf );
+    }
+    else
+    {
+        OTA_LOG_L1( "[%s] ERROR - Failed to allocate buffer memory.\r\n", OTA_METHOD_NAME );
+        eResult = kOTA_Err_OutOfMemory;
+    }
+
+    return eResult;
+}
+
+
+/* Free the signature check context, if any, without verifying the signature. */
+
+static void prvPAL_FreeSignatureContext( OTA_FileContext_t * const C )
+{
+    if( C->pvSigVerifyContext != NULL )
+    {
+        /* CRYPTO_SignatureVerificationFinal() only frees the context when called without a signature. */
+        ( void ) CRYPTO_SignatureVerificationFinal( C->pvSigVerifyContext, NULL, 0, NULL, 0 );
+        C->pvSigVerifyContext = NULL;
+    }
+}
+
+
 /* Read the specified signer certificate from the filesystem into a local buffer. The allocated
  * memory becomes the property of the caller who is responsible for freeing it.
  */
@@ -63,8 +63,19 @@ static BaseType_t prvNetworkSend( void * pvContext,
                                   size_t xDataLength )
 {
     SSOCKETContextPtr_t pxContext = ( SSOCKETContextPtr_t ) pvContext; /*lint !e9087 cast used for portability. */
+    BaseType_t xResult;
 
-    return FreeRTOS_send( pxContext->xSocket, pucData, xDataLength, pxContext->xSendFlags );
+    xResult = FreeRTOS_send( pxContext->xSocket, pucData, xDataLength, pxContext->xSendFlags );
+
+    /* FreeRTOS+TCP reports a full Tx stream as ENOSPC. Report it as
+     * SOCKETS_EWOULDBLOCK, which is what callers of a non-blocking socket
+     * (and the TLS layer) retry on. */
+    if( xResult == -pdFREERTOS_ERRNO_ENOSPC )
+    {
+        xResult = SOCKETS_EWOULDBLOCK;
+    }
+
+    return xResult;
 }
 /*-----------------------------------------------------------*/
 
@@ -461,6 +472,68 @@ int32_t SOCKETS_SetSockOpt( Socket_t xSocket,
 }
 /*-----------------------------------------------------------*/
 
+int32_t SOCKETS_Sendv( Socket_t xSocket,
+                       const SocketsIOVector_t * pxVectors,
+                       size_t xVectorCount,
+                       uint32_t ulFlags )
+{
+    int32_t lStatus = SOCKETS_ERROR_NONE;
+    int32_t lBytesSent = 0;
+    size_t x;
+    SSOCKETContextPtr_t pxContext = ( SSOCKETContextPtr_t ) xSocket; /*lint !e9087 cast used for portability. */
+
+    if( ( xSocket != SOCKETS_INVALID_SOCKET ) &&
+        ( pxVectors != NULL ) )
+    {
+        pxContext->xSendFlags = ( BaseType_t ) ulFlags;
+
+        for( x = 0; x < xVectorCount; x++ )
+        {
+            if( pxVectors[ x ].xDataLength == ( size_t ) 0 )
+            {
+                continue;
+            }
+
+            if( pdTRUE == pxContext->xRequireTLS )
+            {
+                /* Send through TLS pipe, if negotiated. */
+                lStatus = TLS_Send( pxContext->pvTLSContext, pxVectors[ x ].pvBuffer, pxVectors[ x ].xDataLength );
+            }
+            else
+            {
+                /* Send unencrypted. */
+                lStatus = prvNetworkSend( pxContext, pxVectors[ x ].pvBuffer, pxVectors[ x ].xDataLength );
+            }
+
+            if( lStatus > 0 )
+            {
+                lBytesSent += lStatus;
+            }
+
+            /* The next piece must not be started before this one is sent
+             * completely. */
+            if( ( lStatus < 0 ) || ( ( size_t ) lStatus != pxVectors[ x ].xDataLength ) )
+            {
+                break;
+            }
+        }
+
+        /* An error is only reported if nothing was sent, otherwise it is
+         * returned by the next call. */
+        if( lBytesSent > 0 )
+        {
+            lStatus = lBytesSent;
+        }
+    }
+    else
+    {
+        lStatus = SOCKETS_EINVAL;
+    }
+
+    return lStatus;
+}
+/*-----------------------------------------------------------*/
+
 int32_t SOCKETS_Shutdown( Socket_t xSocket,
                           uint32_t ulHow )
 {
@@ -537,6 +537,55 @@ int32_t SOCKETS_Send( Socket_t xSocket,
 }
 /*-----------------------------------------------------------*/
 
+int32_t SOCKETS_Sendv( Socket_t xSocket,
+                       const SocketsIOVector_t * pxVectors,
+                       size_t xVectorCount,
+                       uint32_t ulFlags )
+{
+    int32_t lStatus = SOCKETS_ERROR_NONE;
+    int32_t lBytesSent = 0;
+    size_t x;
+
+    if( pxVectors == NULL )
+    {
+        lStatus = SOCKETS_EINVAL;
+    }
+    else
+    {
+        /* Send the pieces one after another and stop at the first one
+         * which is not sent completely. */
+        for( x = 0; x < xVectorCount; x++ )
+        {
+            if( pxVectors[ x ].xDataLength == ( size_t ) 0 )
+            {
+                continue;
+            }
+
+            lStatus = SOCKETS_Send( xSocket, pxVectors[ x ].pvBuffer, pxVectors[ x ].xDataLength, ulFlags );
+
+            if( lStatus > 0 )
+            {
+                lBytesSent += lStatus;
+            }
+
+            if( ( lStatus < 0 ) || ( ( size_t ) lStatus != pxVectors[ x ].xDataLength ) )
+            {
+                break;
+            }
+        }
+
+        /* An error is only reported if nothing was sent, otherwise it is
+         * returned by the next call. */
+        if( lBytesSent > 0 )
+        {
+            lStatus = lBytesSent;
+        }
+    }
+
+    return lStatus;
+}
+/*-----------------------------------------------------------*/
+
 int32_t SOCKETS_Shutdown( Socket_t xSocket,
                           uint32_t ulHow )
 {
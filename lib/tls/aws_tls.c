@@ -27,6 +27,7 @@
 #include "FreeRTOS.h"
 #include "FreeRTOSIPConfig.h"
 #include "aws_tls.h"
+#include "aws_secure_sockets.h"
 #include "aws_crypto.h"
 #include "aws_pkcs11.h"
 #include "aws_pkcs11_config.h"
@@ -62,6 +63,9 @@
  * @param[in] xNetworkSend Callback for sending data on an open TCP socket.
  * @param[in] pvCallerContext Opaque pointer provided by caller for above callbacks.
  * @param[out] xTLSCHandshakeSuccessful Indicates whether TLS handshake was successfully completed.
+ * @param[out] xPendingWriteLength Length passed to the mbedtls_ssl_write call interrupted by
+ * MBEDTLS_ERR_SSL_WANT_WRITE, zero if there is none.
+ * @param[out] xUnreportedLength Bytes written by mbedtls_ssl_write but not yet reported by TLS_Send.
  * @param[out] xMbedSslCtx Connection context for mbedTLS.
  * @param[out] xMbedSslConfig Configuration context for mbedTLS.
  * @param[out] xMbedX509CA Server certificate context for mbedTLS.
@@ -83,6 +87,8 @@ typedef struct TLSContext
     NetworkSend_t xNetworkSend;
     void * pvCallerContext;
     BaseType_t xTLSHandshakeSuccessful;
+    size_t xPendingWriteLength;
+    size_t xUnreportedLength;
 
     /* mbedTLS. */
     mbedtls_ssl_context xMbedSslCtx;
@@ -144,8 +150,17 @@ static int prvNetworkSend( void * pvContext,
                            size_t xDataLength )
 {
     TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
+    BaseType_t xResult;
 
-    return ( int ) pxCtx->xNetworkSend( pxCtx->pvCallerContext, pucData, xDataLength );
+    xResult = pxCtx->xNetworkSend( pxCtx->pvCallerContext, pucData, xDataLength );
+
+    /* Let mbedTLS keep the record until the socket can accept it. */
+    if( SOCKETS_EWOULDBLOCK == xResult )
+    {
+        xResult = MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+
+    return ( int ) xResult;
 }
 
 /**
@@ -787,19 +802,41 @@ BaseType_t TLS_Send( void * pvContext,
     BaseType_t xResult = 0;
     TLSContext_t * pxCtx = ( TLSContext_t * ) pvContext; /*lint !e9087 !e9079 Allow casting void* to other types. */
     size_t xWritten = 0;
+    size_t xLength;
 
     if( ( NULL != pxCtx ) && ( pdTRUE == pxCtx->xTLSHandshakeSuccessful ) )
     {
+        /* Report the bytes of a record sent by an earlier call which passed
+         * fewer bytes than the record contained. */
+        xWritten = configMIN( pxCtx->xUnreportedLength, xMsgLength );
+        pxCtx->xUnreportedLength -= xWritten;
+
         while( xWritten < xMsgLength )
         {
+            /* mbedTLS must be called with the same length to finish a record
+             * interrupted by MBEDTLS_ERR_SSL_WANT_WRITE. The data is not read
+             * again as it has already been encrypted. */
+            if( 0 != pxCtx->xPendingWriteLength )
+            {
+                xLength = pxCtx->xPendingWriteLength;
+            }
+            else
+            {
+                xLength = xMsgLength - xWritten;
+            }
+
             xResult = mbedtls_ssl_write( &pxCtx->xMbedSslCtx,
                                          pucMsg + xWritten,
-                                         xMsgLength - xWritten );
+                                         xLength );
 
             if( 0 < xResult )
             {
-                /* Sent data, so update the tally and keep looping. */
-                xWritten += ( size_t ) xResult;
+                /* Sent data, so update the tally and keep looping. The caller
+                 * may have passed fewer bytes than a finished record contains. */
+                pxCtx->xPendingWriteLength = 0;
+                xLength = configMIN( ( size_t ) xResult, xMsgLength - xWritten );
+                pxCtx->xUnreportedLength = ( size_t ) xResult - xLength;
+                xWritten += xLength;
             }
             else if( 0 == xResult )
             {
@@ -808,7 +845,16 @@ BaseType_t TLS_Send( void * pvContext,
                  * flag an error. */
                 break;
             }
-            else if( MBEDTLS_ERR_SSL_WANT_WRITE != xResult )
+            else if( MBEDTLS_ERR_SSL_WANT_WRITE == xResult )
+            {
+                /* The socket cannot accept more data now. Rather than spin
+                 * until it can, return what was sent so far. The caller must
+                 * pass the unsent bytes again, starting from the first one. */
+                pxCtx->xPendingWriteLength = xLength;
+                xResult = 0;
+                break;
+            }
+            else
             {
                 /* Hard error: invalidate the context and stop. */
                 prvFreeContext( pxCtx );
@@ -0,0 +1,213 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_checksum.c
+ * @brief Benchmarks for the Internet checksum routines of FreeRTOS+TCP.
+ *
+ * Data of the sizes of typical packets, starting at every alignment within a
+ * word, is added up by usGenerateChecksum(), copied by memcpy() and then added
+ * up, as the TCP payload is without ipconfigUSE_CHECKSUM_COPY, and copied and
+ * added up at once by usGenerateChecksumCopy(). The same amount of data is
+ * processed for every size. Build with ipconfigCHECKSUM_BACKEND set to each of
+ * its values to compare the backends.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief Number of bytes processed for every size and alignment.
+ */
+#define benchmarkchecksumTOTAL_BYTES     ( 1UL << 24 )
+
+/**
+ * @brief Largest size, and number of alignments within a word.
+ */
+#define benchmarkchecksumMAX_SIZE        ( 1460U )
+#define benchmarkchecksumALIGNMENTS      ( 4U )
+
+/**
+ * @brief Length of the benchmark names.
+ */
+#define benchmarkchecksumNAME_LENGTH     ( 48 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The ways in which the data is processed.
+ */
+typedef enum
+{
+    eChecksum,     /* usGenerateChecksum() only. */
+    eCopyChecksum, /* memcpy() followed by usGenerateChecksum(). */
+    eChecksumCopy  /* usGenerateChecksumCopy(). */
+} BenchmarkChecksumMode_t;
+
+/**
+ * @brief The sizes benchmarked: a small packet, a DNS reply, the minimum
+ * datagram that IPv4 hosts accept, and a full TCP segment.
+ */
+static const uint32_t ulSizes[] = { 64U, 256U, 576U, benchmarkchecksumMAX_SIZE };
+
+/**
+ * @brief The data, and the buffer it is copied to.
+ */
+static uint32_t ulSource[ ( benchmarkchecksumMAX_SIZE + benchmarkchecksumALIGNMENTS ) / 4U + 1U ];
+static uint32_t ulTarget[ ( benchmarkchecksumMAX_SIZE + benchmarkchecksumALIGNMENTS ) / 4U + 1U ];
+
+/**
+ * @brief Written with the result of the checksums so that they are not
+ * optimised away.
+ */
+static volatile uint16_t usSink;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Processes every size of data at every alignment in the way eMode
+ * selects, and reports the time taken.
+ */
+static void prvRunChecksums( const char * pcName,
+                             BenchmarkChecksumMode_t eMode );
+/*-----------------------------------------------------------*/
+
+static void prvRunChecksums( const char * pcName,
+                             BenchmarkChecksumMode_t eMode )
+{
+    char cName[ benchmarkchecksumNAME_LENGTH ];
+    const uint8_t * pucSource;
+    uint8_t * pucTarget = ( uint8_t * ) ulTarget;
+    uint32_t ulAlignment, ulSize, ulRounds, x, ulStart, ulElapsed;
+    uint16_t usSum = 0U;
+
+    for( ulAlignment = 0; ulAlignment < benchmarkchecksumALIGNMENTS; ulAlignment++ )
+    {
+        pucSource = ( const uint8_t * ) ulSource + ulAlignment;
+        ( void ) snprintf( cName, sizeof( cName ), "%s_align%u", pcName, ( unsigned ) ulAlignment );
+
+        for( x = 0; x < ( sizeof( ulSizes ) / sizeof( ulSizes[ 0 ] ) ); x++ )
+        {
+            ulSize = ulSizes[ x ];
+            ulRounds = benchmarkchecksumTOTAL_BYTES / ulSize;
+            ulStart = benchmarkGET_TIMESTAMP();
+
+            while( ulRounds-- > 0U )
+            {
+                switch( eMode )
+                {
+                    case eChecksum:
+                        usSum += usGenerateChecksum( 0U, pucSource, ulSize );
+                        break;
+
+                    case eCopyChecksum:
+                        memcpy( pucTarget, pucSource, ulSize );
+                        usSum += usGenerateChecksum( 0U, pucTarget, ulSize );
+                        break;
+
+                    default:
+                        usSum += usGenerateChecksumCopy( 0U, pucTarget, pucSource, ulSize );
+                        break;
+                }
+            }
+
+            ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+            usSink = usSum;
+
+            benchmarkREPORT( cName, "bytes", ulSize, benchmarkchecksumTOTAL_BYTES / ulSize, ulElapsed );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Checksum_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Checksum_Benchmark )
+{
+    uint8_t * pucSource = ( uint8_t * ) ulSource;
+    uint32_t x;
+
+    for( x = 0; x < sizeof( ulSource ); x++ )
+    {
+        pucSource[ x ] = ( uint8_t ) ( ( x * 31U ) + 7U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Checksum_Benchmark )
+{
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Checksum_Benchmark )
+{
+    RUN_TEST_CASE( Full_Checksum_Benchmark, Checksum );
+    RUN_TEST_CASE( Full_Checksum_Benchmark, CopyThenChecksum );
+    RUN_TEST_CASE( Full_Checksum_Benchmark, ChecksumCopy );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Checksum_Benchmark, Checksum )
+{
+    prvRunChecksums( "checksum", eChecksum );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Checksum_Benchmark, CopyThenChecksum )
+{
+    prvRunChecksums( "checksum_memcpy", eCopyChecksum );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Checksum_Benchmark, ChecksumCopy )
+{
+    prvRunChecksums( "checksum_copy", eChecksumCopy );
+}
+/*-----------------------------------------------------------*/
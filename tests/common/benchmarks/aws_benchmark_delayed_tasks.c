@@ -0,0 +1,283 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_delayed_tasks.c
+ * @brief Benchmarks for blocking with a timeout while many tasks are delayed.
+ *
+ * A helper task waits on a queue with a randomly chosen timeout, and the test
+ * task sends it an item as soon as it has blocked, while a growing number of
+ * other tasks are delayed with timeouts from the same range. Each round trip
+ * removes the helper task from the delayed tasks and inserts it again, so the
+ * time reported includes both operations as well as two context switches.
+ * Build with configUSE_DELAYED_TASK_WHEEL set to 0 and to 1 to compare the
+ * sorted delayed task lists with the delayed task wheel.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief Name of the benchmark, which includes the delayed task
+ * implementation.
+ */
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    #define benchmarkdelayedNAME           "delayed_tasks_wheel"
+#else
+    #define benchmarkdelayedNAME           "delayed_tasks_list"
+#endif
+
+/**
+ * @brief Largest number of delayed tasks.
+ */
+#define benchmarkdelayedMAX_TASKS          ( 512 )
+
+/**
+ * @brief Number of round trips timed for every number of delayed tasks.
+ */
+#define benchmarkdelayedROUND_TRIPS        ( 4096 )
+
+/**
+ * @brief Priority of the test task while the benchmark runs, and of the
+ * helper and delayed tasks, which must preempt it.
+ */
+#define benchmarkdelayedPRIORITY           ( tskIDLE_PRIORITY + 2 )
+#define benchmarkdelayedHIGH_PRIORITY      ( benchmarkdelayedPRIORITY + 1 )
+
+/**
+ * @brief Stack size of the helper and delayed tasks.
+ */
+#define benchmarkdelayedSTACK_SIZE         ( configMINIMAL_STACK_SIZE * 2 )
+
+/**
+ * @brief Shortest and longest timeouts.
+ *
+ * They are long enough that no task wakes during the benchmark.
+ */
+#define benchmarkdelayedMIN_TIMEOUT        pdMS_TO_TICKS( 60000 )
+#define benchmarkdelayedMAX_TIMEOUT        pdMS_TO_TICKS( 120000 )
+
+/**
+ * @brief Time to wait for the helper task.
+ */
+#define benchmarkdelayedTIMEOUT            pdMS_TO_TICKS( 10000 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The delayed tasks and the helper task.
+ */
+static TaskHandle_t xDelayedTasks[ benchmarkdelayedMAX_TASKS ];
+static TaskHandle_t xHelperTask;
+
+/**
+ * @brief Priority of the test task before the benchmark changed it.
+ */
+static UBaseType_t uxTestTaskPriority;
+
+/**
+ * @brief The queue the helper task waits on.
+ */
+static QueueHandle_t xQueue;
+
+/**
+ * @brief Number of items received by the helper task, and number of times
+ * a task timed out, which must stay 0.
+ */
+static volatile uint32_t ulReceived;
+static volatile uint32_t ulTimedOut;
+
+/**
+ * @brief State of the pseudo random number generator.
+ */
+static uint32_t ulRandom;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Returns a pseudo random timeout between benchmarkdelayedMIN_TIMEOUT
+ * and benchmarkdelayedMAX_TIMEOUT.
+ */
+static TickType_t prvRandomTimeout( void );
+
+/**
+ * @brief Task that delays for a random time.
+ */
+static void prvDelayedTask( void * pvParameters );
+
+/**
+ * @brief Task that waits on xQueue with a random timeout, and counts the
+ * items it receives.
+ */
+static void prvHelperTask( void * pvParameters );
+/*-----------------------------------------------------------*/
+
+static TickType_t prvRandomTimeout( void )
+{
+    ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+
+    return benchmarkdelayedMIN_TIMEOUT + ( TickType_t ) ( ( ulRandom >> 8 ) % ( benchmarkdelayedMAX_TIMEOUT - benchmarkdelayedMIN_TIMEOUT ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayedTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( prvRandomTimeout() );
+        ulTimedOut++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHelperTask( void * pvParameters )
+{
+    uint32_t ulItem;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( xQueueReceive( xQueue, &ulItem, prvRandomTimeout() ) == pdPASS )
+        {
+            ulReceived++;
+        }
+        else
+        {
+            ulTimedOut++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Delayed_Task_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Delayed_Task_Benchmark )
+{
+    memset( xDelayedTasks, 0x00, sizeof( xDelayedTasks ) );
+    xHelperTask = NULL;
+    ulReceived = 0;
+    ulTimedOut = 0;
+    ulRandom = 1;
+
+    xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( xQueue != NULL );
+
+    uxTestTaskPriority = uxTaskPriorityGet( NULL );
+    vTaskPrioritySet( NULL, benchmarkdelayedPRIORITY );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Delayed_Task_Benchmark )
+{
+    uint32_t x;
+
+    for( x = 0; x < benchmarkdelayedMAX_TASKS; x++ )
+    {
+        if( xDelayedTasks[ x ] != NULL )
+        {
+            vTaskDelete( xDelayedTasks[ x ] );
+        }
+    }
+
+    if( xHelperTask != NULL )
+    {
+        vTaskDelete( xHelperTask );
+    }
+
+    vQueueDelete( xQueue );
+    vTaskPrioritySet( NULL, uxTestTaskPriority );
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Delayed_Task_Benchmark )
+{
+    RUN_TEST_CASE( Full_Delayed_Task_Benchmark, BlockWithTimeout );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Reports the time taken by benchmarkdelayedROUND_TRIPS round trips
+ * through the helper task for a doubling number of delayed tasks.
+ */
+TEST( Full_Delayed_Task_Benchmark, BlockWithTimeout )
+{
+    uint32_t ulDelayed, ulCreated = 0, ulStart, ulElapsed, x;
+
+    /* The helper task runs as soon as an item is sent, and has blocked again
+     * by the time xQueueSend() returns. */
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvHelperTask, "BenchHelper", benchmarkdelayedSTACK_SIZE, NULL, benchmarkdelayedHIGH_PRIORITY, &xHelperTask ) );
+
+    for( ulDelayed = 16; ulDelayed <= benchmarkdelayedMAX_TASKS; ulDelayed *= 2 )
+    {
+        /* Create the tasks that are not delayed yet.  Each one delays as soon
+         * as it is created. */
+        for( ; ulCreated < ulDelayed; ulCreated++ )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvDelayedTask, "BenchDelay", benchmarkdelayedSTACK_SIZE, NULL, benchmarkdelayedHIGH_PRIORITY, &( xDelayedTasks[ ulCreated ] ) ) );
+        }
+
+        ulReceived = 0;
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < benchmarkdelayedROUND_TRIPS; x++ )
+        {
+            ( void ) xQueueSend( xQueue, &x, benchmarkdelayedTIMEOUT );
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        TEST_ASSERT_EQUAL_UINT32( benchmarkdelayedROUND_TRIPS, ulReceived );
+        TEST_ASSERT_EQUAL_UINT32( 0, ulTimedOut );
+
+        benchmarkREPORT( benchmarkdelayedNAME, "delayed_tasks", ulDelayed, benchmarkdelayedROUND_TRIPS, ulElapsed );
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,319 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_heap.c
+ * @brief Benchmarks for the FreeRTOS heap implementations.
+ *
+ * Replays a captured trace of heap allocations and frees against
+ * pvPortMalloc() and vPortFree(), and reports the time taken and how
+ * fragmented the heap is afterwards. The replay is repeated with a growing
+ * number of small free blocks pinned between allocated blocks, which is the
+ * state a heap tends to reach after a long uptime. Build once with each heap
+ * implementation to compare them, e.g. "make HEAP=heap_4" and
+ * "make HEAP=heap_6" for the Linux test runner.
+ *
+ * The trace is in aws_benchmark_heap_trace.h. To replay a trace captured on a
+ * device, convert the console log with tools/heap_trace/heap_trace_to_c.py
+ * and define benchmarkheapTRACE_FILE to the name of the generated header.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief One operation of a heap trace.
+ */
+typedef struct HeapTraceRecord
+{
+    uint16_t usSlot; /**< The slot holding the block allocated or freed. */
+    uint32_t ulSize; /**< The number of bytes to allocate in the slot, or 0 to free the slot. */
+} HeapTraceRecord_t;
+
+/**
+ * @brief The header defining the trace that is replayed.
+ *
+ * It must define benchmarkheapTRACE_SLOTS and the xHeapTrace array.
+ */
+#ifndef benchmarkheapTRACE_FILE
+    #define benchmarkheapTRACE_FILE    "aws_benchmark_heap_trace.h"
+#endif
+#include benchmarkheapTRACE_FILE
+
+/**
+ * @brief Number of times the trace is replayed for every number of pinned
+ * free blocks.
+ */
+#define benchmarkheapREPLAY_PASSES           ( 20 )
+
+/**
+ * @brief Largest number of small free blocks pinned in the heap before the
+ * trace is replayed.
+ */
+#define benchmarkheapMAX_PINNED_BLOCKS       ( 1024 )
+
+/**
+ * @brief Size of the pinned blocks.
+ *
+ * They are too small to satisfy most of the allocations in the trace, so a
+ * first fit search has to skip them.
+ */
+#define benchmarkheapPINNED_BLOCK_SIZE       ( 24 )
+
+/**
+ * @brief Number of trace allocations that failed, which makes the replay
+ * diverge from the trace.
+ */
+static uint32_t ulFailedAllocations;
+
+/**
+ * @brief The blocks allocated in each slot of the trace.
+ */
+static uint8_t * pucSlots[ benchmarkheapTRACE_SLOTS ];
+
+/**
+ * @brief The blocks used to fragment the heap. Every other one is freed
+ * again before the trace is replayed.
+ */
+static void * pvPinnedBlocks[ 2 * benchmarkheapMAX_PINNED_BLOCKS ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Replays xHeapTrace once.
+ *
+ * The first and last byte of every block are written when it is allocated
+ * and checked when it is freed to detect blocks that overlap.
+ */
+static void prvReplayTrace( void );
+
+/**
+ * @brief Frees the blocks still allocated by the trace.
+ */
+static void prvFreeSlots( void );
+
+/**
+ * @brief Finds the largest block that can currently be allocated.
+ *
+ * @return The size of the largest block, to within 16 bytes.
+ */
+static size_t prvLargestAllocatableBlock( void );
+/*-----------------------------------------------------------*/
+
+static void prvReplayTrace( void )
+{
+    const HeapTraceRecord_t * pxRecord;
+    uint8_t * pucBlock;
+    uint8_t ucTag;
+    uint32_t x;
+
+    for( x = 0; x < sizeof( xHeapTrace ) / sizeof( xHeapTrace[ 0 ] ); x++ )
+    {
+        pxRecord = &( xHeapTrace[ x ] );
+        pucBlock = pucSlots[ pxRecord->usSlot ];
+        ucTag = ( uint8_t ) pxRecord->usSlot;
+
+        if( pxRecord->ulSize == 0 )
+        {
+            if( pucBlock != NULL )
+            {
+                TEST_ASSERT_EQUAL_UINT8( ucTag, pucBlock[ 0 ] );
+                vPortFree( pucBlock );
+                pucSlots[ pxRecord->usSlot ] = NULL;
+            }
+        }
+        else
+        {
+            /* A trace never allocates in a slot that is still in use. */
+            configASSERT( pucBlock == NULL );
+
+            pucBlock = pvPortMalloc( pxRecord->ulSize );
+
+            if( pucBlock != NULL )
+            {
+                pucBlock[ 0 ] = ucTag;
+                pucBlock[ pxRecord->ulSize - 1 ] = ucTag;
+            }
+            else
+            {
+                ulFailedAllocations++;
+            }
+
+            pucSlots[ pxRecord->usSlot ] = pucBlock;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeSlots( void )
+{
+    uint32_t x;
+
+    for( x = 0; x < benchmarkheapTRACE_SLOTS; x++ )
+    {
+        if( pucSlots[ x ] != NULL )
+        {
+            TEST_ASSERT_EQUAL_UINT8( ( uint8_t ) x, pucSlots[ x ][ 0 ] );
+            vPortFree( pucSlots[ x ] );
+            pucSlots[ x ] = NULL;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLargestAllocatableBlock( void )
+{
+    size_t xLow = 0, xHigh = xPortGetFreeHeapSize(), xSize;
+    void * pvBlock;
+
+    /* Binary search between a size known to fit and one known not to. */
+    while( ( xHigh - xLow ) > 16 )
+    {
+        xSize = xLow + ( ( xHigh - xLow ) / 2 );
+        pvBlock = pvPortMalloc( xSize );
+
+        if( pvBlock != NULL )
+        {
+            vPortFree( pvBlock );
+            xLow = xSize;
+        }
+        else
+        {
+            xHigh = xSize;
+        }
+    }
+
+    return xLow;
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Heap_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Heap_Benchmark )
+{
+    memset( pucSlots, 0x00, sizeof( pucSlots ) );
+    memset( pvPinnedBlocks, 0x00, sizeof( pvPinnedBlocks ) );
+    ulFailedAllocations = 0;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Heap_Benchmark )
+{
+    uint32_t x;
+
+    prvFreeSlots();
+
+    for( x = 0; x < ( 2 * benchmarkheapMAX_PINNED_BLOCKS ); x++ )
+    {
+        vPortFree( pvPinnedBlocks[ x ] );
+        pvPinnedBlocks[ x ] = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Heap_Benchmark )
+{
+    RUN_TEST_CASE( Full_Heap_Benchmark, TraceReplay );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Reports the time taken to replay the trace benchmarkheapREPLAY_PASSES
+ * times, and the largest block that can be allocated afterwards, for a
+ * doubling number of pinned free blocks.
+ */
+TEST( Full_Heap_Benchmark, TraceReplay )
+{
+    uint32_t ulPinned, ulStart, ulElapsed, x;
+    size_t xFreeBytes;
+
+    for( ulPinned = 0; ulPinned <= benchmarkheapMAX_PINNED_BLOCKS; ulPinned = ( ulPinned == 0 ) ? 64 : ulPinned * 2 )
+    {
+        /* Fragment the heap: allocate pairs of small blocks and free the first
+         * block of every pair, so the free blocks cannot be merged. */
+        for( x = 0; x < ( 2 * ulPinned ); x++ )
+        {
+            if( pvPinnedBlocks[ x ] == NULL )
+            {
+                pvPinnedBlocks[ x ] = pvPortMalloc( benchmarkheapPINNED_BLOCK_SIZE );
+                TEST_ASSERT_NOT_NULL( pvPinnedBlocks[ x ] );
+            }
+        }
+
+        for( x = 0; x < ( 2 * ulPinned ); x += 2 )
+        {
+            vPortFree( pvPinnedBlocks[ x ] );
+            pvPinnedBlocks[ x ] = NULL;
+        }
+
+        ulFailedAllocations = 0;
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < benchmarkheapREPLAY_PASSES; x++ )
+        {
+            prvReplayTrace();
+            prvFreeSlots();
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        /* Every allocation of the trace must fit in the test heap. */
+        TEST_ASSERT_EQUAL_UINT32( 0, ulFailedAllocations );
+
+        benchmarkREPORT( "heap_trace_replay",
+                         "pinned_free_blocks",
+                         ulPinned,
+                         benchmarkheapREPLAY_PASSES * ( sizeof( xHeapTrace ) / sizeof( xHeapTrace[ 0 ] ) ),
+                         ulElapsed );
+
+        /* Report how much of the free heap can be allocated as one block. */
+        xFreeBytes = xPortGetFreeHeapSize();
+        benchmarkREPORT_METRIC( "heap_largest_free_block_percent",
+                                "pinned_free_blocks",
+                                ulPinned,
+                                ( uint32_t ) ( ( prvLargestAllocatableBlock() * 100U ) / xFreeBytes ) );
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,681 @@
+/*
+ * Heap allocation trace replayed by aws_benchmark_heap.c.
+ *
+ * Start-up and PKCS #11 test allocations of the Linux test runner, captured with heap_3.c.
+ *
+ * Generated by tools/heap_trace/heap_trace_to_c.py - do not edit.
+ * 4000 records, 36 slots.
+ */
+
+#define benchmarkheapTRACE_SLOTS    ( 36 )
+
+static const HeapTraceRecord_t xHeapTrace[] =
+{
+    { 0, 1200 }, { 1, 160 }, { 2, 2800 }, { 3, 208 }, { 4, 160 }, { 5, 160 },
+    { 6, 192 }, { 7, 31 }, { 8, 552 }, { 8, 0 }, { 7, 0 }, { 6, 0 },
+    { 6, 560 }, { 7, 208 }, { 8, 80000 }, { 9, 208 }, { 4, 0 }, { 5, 0 },
+    { 5, 160 }, { 4, 160 }, { 10, 192 }, { 10, 0 }, { 5, 0 }, { 4, 0 },
+    { 4, 160 }, { 5, 160 }, { 10, 192 }, { 10, 0 }, { 4, 0 }, { 5, 0 },
+    { 5, 160 }, { 4, 160 }, { 10, 192 }, { 11, 1342 }, { 12, 1679 }, { 13, 949 },
+    { 14, 552 }, { 15, 949 }, { 16, 64 }, { 17, 64 }, { 18, 64 }, { 19, 64 },
+    { 20, 64 }, { 21, 64 }, { 22, 64 }, { 23, 64 }, { 24, 64 }, { 25, 64 },
+    { 26, 64 }, { 27, 64 }, { 28, 352 }, { 29, 160 }, { 30, 264 }, { 31, 8 },
+    { 31, 0 }, { 30, 0 }, { 29, 0 }, { 28, 0 }, { 16, 0 }, { 17, 0 },
+    { 18, 0 }, { 19, 0 }, { 20, 0 }, { 21, 0 }, { 22, 0 }, { 23, 0 },
+    { 24, 0 }, { 25, 0 }, { 26, 0 }, { 27, 0 }, { 15, 0 }, { 14, 0 },
+    { 13, 0 }, { 13, 1192 }, { 14, 16 }, { 15, 352 }, { 27, 160 }, { 26, 264 },
+    { 25, 8 }, { 24, 256 }, { 23, 136 }, { 22, 136 }, { 21, 128 }, { 20, 256 },
+    { 19, 128 }, { 18, 272 }, { 17, 16 }, { 16, 24 }, { 28, 264 }, { 20, 0 },
+    { 20, 136 }, { 19, 0 }, { 19, 264 }, { 20, 0 }, { 20, 16 }, { 29, 24 },
+    { 17, 0 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 144 }, { 29, 0 },
+    { 29, 264 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 128 }, { 28, 0 }, { 19, 0 }, { 18, 0 },
+    { 29, 0 }, { 16, 0 }, { 16, 256 }, { 29, 128 }, { 18, 272 }, { 19, 16 },
+    { 28, 24 }, { 17, 264 }, { 16, 0 }, { 16, 136 }, { 29, 0 }, { 29, 264 },
+    { 16, 0 }, { 16, 16 }, { 30, 24 }, { 19, 0 }, { 16, 0 }, { 16, 144 },
+    { 30, 0 }, { 30, 264 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 16 },
+    { 16, 0 }, { 16, 16 }, { 16, 0 }, { 16, 128 }, { 17, 0 }, { 29, 0 },
+    { 18, 0 }, { 30, 0 }, { 28, 0 }, { 28, 128 }, { 30, 128 }, { 18, 8 },
+    { 28, 0 }, { 30, 0 }, { 30, 128 }, { 28, 128 }, { 29, 128 }, { 17, 128 },
+    { 19, 8 }, { 31, 8 }, { 32, 8 }, { 33, 8 }, { 34, 8 }, { 34, 0 },
+    { 34, 8 }, { 35, 128 }, { 32, 0 }, { 34, 0 }, { 34, 8 }, { 32, 128 },
+    { 33, 0 }, { 34, 0 }, { 34, 8 }, { 33, 128 }, { 19, 0 }, { 34, 0 },
+    { 34, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 136 }, { 33, 0 }, { 33, 136 }, { 34, 0 }, { 34, 128 }, { 34, 0 },
+    { 34, 128 }, { 34, 0 }, { 34, 136 }, { 35, 0 }, { 35, 128 }, { 35, 0 },
+    { 35, 128 }, { 35, 0 }, { 35, 136 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 }, { 32, 128 }, { 32, 0 },
+    { 32, 128 }, { 32, 0 }, { 32, 128 }, { 30, 0 }, { 28, 0 }, { 31, 0 },
+    { 33, 0 }, { 18, 0 }, { 29, 0 }, { 17, 0 }, { 34, 0 }, { 35, 0 },
+    { 21, 0 }, { 21, 128 }, { 21, 0 }, { 21, 136 }, { 21, 0 }, { 24, 0 },
+    { 22, 0 }, { 23, 0 }, { 25, 0 }, { 26, 0 }, { 32, 0 }, { 16, 0 },
+    { 20, 0 }, { 27, 0 }, { 15, 0 }, { 14, 0 }, { 13, 0 }, { 11, 0 },
+    { 12, 0 }, { 12, 451 }, { 11, 16 }, { 13, 352 }, { 14, 160 }, { 14, 0 },
+    { 13, 0 }, { 13, 352 }, { 14, 160 }, { 15, 264 }, { 27, 8 }, { 27, 0 },
+    { 15, 0 }, { 14, 0 }, { 13, 0 }, { 11, 0 }, { 12, 0 }, { 12, 294 },
+    { 11, 352 }, { 13, 160 }, { 13, 0 }, { 11, 0 }, { 11, 352 }, { 13, 160 },
+    { 14, 264 }, { 15, 8 }, { 12, 0 }, { 12, 256 }, { 27, 256 }, { 20, 256 },
+    { 16, 272 }, { 20, 0 }, { 20, 272 }, { 32, 544 }, { 26, 8 }, { 25, 536 },
+    { 26, 0 }, { 26, 536 }, { 23, 256 }, { 22, 552 }, { 24, 16 }, { 21, 24 },
+    { 35, 264 }, { 23, 0 }, { 23, 536 }, { 35, 0 }, { 35, 16 }, { 34, 24 },
+    { 24, 0 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 272 }, { 34, 0 },
+    { 34, 536 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 }, { 35, 16 }, { 35, 0 },
+    { 26, 0 }, { 23, 0 }, { 22, 0 }, { 34, 0 }, { 21, 0 }, { 20, 0 },
+    { 32, 0 }, { 16, 0 }, { 12, 0 }, { 27, 0 }, { 25, 0 }, { 15, 0 },
+    { 14, 0 }, { 13, 0 }, { 11, 0 }, { 10, 0 }, { 5, 0 }, { 4, 0 },
+    { 4, 160 }, { 5, 160 }, { 10, 192 }, { 11, 1342 }, { 13, 1679 }, { 14, 949 },
+    { 15, 552 }, { 25, 949 }, { 27, 64 }, { 12, 64 }, { 16, 64 }, { 32, 64 },
+    { 20, 64 }, { 21, 64 }, { 34, 64 }, { 22, 64 }, { 23, 64 }, { 26, 64 },
+    { 35, 64 }, { 24, 64 }, { 17, 352 }, { 29, 160 }, { 18, 264 }, { 33, 8 },
+    { 33, 0 }, { 18, 0 }, { 29, 0 }, { 17, 0 }, { 27, 0 }, { 12, 0 },
+    { 16, 0 }, { 32, 0 }, { 20, 0 }, { 21, 0 }, { 34, 0 }, { 22, 0 },
+    { 23, 0 }, { 26, 0 }, { 35, 0 }, { 24, 0 }, { 25, 0 }, { 15, 0 },
+    { 14, 0 }, { 14, 1192 }, { 15, 16 }, { 25, 352 }, { 24, 160 }, { 35, 264 },
+    { 26, 8 }, { 23, 256 }, { 22, 136 }, { 34, 136 }, { 21, 128 }, { 20, 256 },
+    { 32, 128 }, { 16, 272 }, { 12, 16 }, { 27, 24 }, { 17, 264 }, { 20, 0 },
+    { 20, 136 }, { 32, 0 }, { 32, 264 }, { 20, 0 }, { 20, 16 }, { 29, 24 },
+    { 12, 0 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 144 }, { 29, 0 },
+    { 29, 264 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 }, { 20, 16 }, { 20, 0 },
+    { 20, 16 }, { 20, 0 }, { 20, 128 }, { 17, 0 }, { 32, 0 }, { 16, 0 },
+    { 29, 0 }, { 27, 0 }, { 27, 256 }, { 29, 128 }, { 16, 272 }, { 32, 16 },
+    { 17, 24 }, { 12, 264 }, { 27, 0 }, { 27, 136 }, { 29, 0 }, { 29, 264 },
+    { 27, 0 }, { 27, 16 }, { 18, 24 }, { 32, 0 }, { 27, 0 }, { 27, 144 },
+    { 18, 0 }, { 18, 264 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 16 },
+    { 27, 0 }, { 27, 16 }, { 27, 0 }, { 27, 128 }, { 12, 0 }, { 29, 0 },
+    { 16, 0 }, { 18, 0 }, { 17, 0 }, { 17, 128 }, { 18, 128 }, { 16, 8 },
+    { 17, 0 }, { 18, 0 }, { 18, 128 }, { 17, 128 }, { 29, 128 }, { 12, 128 },
+    { 32, 8 }, { 33, 8 }, { 31, 8 }, { 28, 8 }, { 30, 8 }, { 30, 0 },
+    { 30, 8 }, { 19, 128 }, { 31, 0 }, { 30, 0 }, { 30, 8 }, { 31, 128 },
+    { 28, 0 }, { 30, 0 }, { 30, 8 }, { 28, 128 }, { 32, 0 }, { 30, 0 },
+    { 30, 128 }, { 33, 0 }, { 33, 128 }, { 33, 0 }, { 33, 128 }, { 33, 0 },
+    { 33, 136 }, { 28, 0 }, { 28, 136 }, { 30, 0 }, { 30, 128 }, { 30, 0 },
+    { 30, 128 }, { 30, 0 }, { 30, 136 }, { 19, 0 }, { 19, 128 }, { 19, 0 },
+    { 19, 128 }, { 19, 0 }, { 19, 136 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+    { 31, 128 }, { 31, 0 }, { 31, 128 }, { 31, 0 },
+};
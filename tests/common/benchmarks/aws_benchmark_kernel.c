@@ -0,0 +1,543 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_kernel.c
+ * @brief Micro-benchmarks for the scheduler and the inter task communication
+ * primitives of the kernel.
+ *
+ * Each test times a fixed number of operations and reports the result with
+ * benchmarkREPORT(), so that regressions in tasks.c, queue.c, event_groups.c
+ * and stream_buffer.c can be tracked over time. The test task runs at
+ * benchmarkkernelPRIORITY and the helper tasks either at the same priority or
+ * one above it, so the helper tasks run as soon as they are unblocked.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief Number of operations timed by each benchmark.
+ */
+#define benchmarkkernelITERATIONS          ( 10000 )
+
+/**
+ * @brief Priority of the test task while the benchmarks run, and of the
+ * helper tasks that must preempt it.
+ */
+#define benchmarkkernelPRIORITY            ( tskIDLE_PRIORITY + 2 )
+#define benchmarkkernelHIGH_PRIORITY       ( benchmarkkernelPRIORITY + 1 )
+
+/**
+ * @brief Stack size of the helper tasks.
+ */
+#define benchmarkkernelSTACK_SIZE          ( configMINIMAL_STACK_SIZE * 4 )
+
+/**
+ * @brief Largest number of helper tasks used by a benchmark.
+ */
+#define benchmarkkernelMAX_HELPERS         ( 8 )
+
+/**
+ * @brief Length of the queues, and largest item size.
+ */
+#define benchmarkkernelQUEUE_LENGTH        ( 16 )
+#define benchmarkkernelMAX_ITEM_SIZE       ( 256 )
+
+/**
+ * @brief Size of the stream buffer.
+ */
+#define benchmarkkernelSTREAM_SIZE         ( 1024 )
+
+/**
+ * @brief The event group bits the waiters of the fan out benchmark wait for
+ * in turn.
+ */
+#define benchmarkkernelBIT_A               ( ( EventBits_t ) 0x01 )
+#define benchmarkkernelBIT_B               ( ( EventBits_t ) 0x02 )
+
+/**
+ * @brief Time to wait for a helper task.
+ */
+#define benchmarkkernelTIMEOUT             pdMS_TO_TICKS( 5000 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The helper tasks of the current benchmark, and the test task.
+ */
+static TaskHandle_t xHelperTasks[ benchmarkkernelMAX_HELPERS ];
+static TaskHandle_t xTestTask;
+
+/**
+ * @brief Priority of the test task before the benchmarks changed it.
+ */
+static UBaseType_t uxTestTaskPriority;
+
+/**
+ * @brief The objects used by the current benchmark.
+ */
+static QueueHandle_t xQueue;
+static SemaphoreHandle_t xMutex;
+static EventGroupHandle_t xEventGroup;
+static StreamBufferHandle_t xStreamBuffer;
+
+/**
+ * @brief Number of times each helper task went round its loop.
+ */
+static volatile uint32_t ulHelperCounts[ benchmarkkernelMAX_HELPERS ];
+
+/**
+ * @brief Buffers for the items and chunks sent and received.
+ */
+static uint8_t ucSendBuffer[ benchmarkkernelQUEUE_LENGTH * benchmarkkernelMAX_ITEM_SIZE ];
+static uint8_t ucReceiveBuffer[ benchmarkkernelQUEUE_LENGTH * benchmarkkernelMAX_ITEM_SIZE ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Creates helper task uxIndex, which is passed its index.
+ */
+static void prvCreateHelper( TaskFunction_t pxFunction,
+                             UBaseType_t uxIndex,
+                             UBaseType_t uxPriority );
+
+/**
+ * @brief Helper task that yields in a loop.
+ */
+static void prvYieldingTask( void * pvParameters );
+
+/**
+ * @brief Helper task that notifies the test task back each time it is
+ * notified.
+ */
+static void prvNotifiedTask( void * pvParameters );
+
+/**
+ * @brief Helper task that takes and gives back xMutex each time it is
+ * notified.
+ */
+static void prvMutexTask( void * pvParameters );
+
+/**
+ * @brief Helper task that waits for benchmarkkernelBIT_A and
+ * benchmarkkernelBIT_B of xEventGroup in turn.
+ */
+static void prvEventGroupTask( void * pvParameters );
+/*-----------------------------------------------------------*/
+
+static void prvCreateHelper( TaskFunction_t pxFunction,
+                             UBaseType_t uxIndex,
+                             UBaseType_t uxPriority )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( pxFunction, "Bench", benchmarkkernelSTACK_SIZE, ( void * ) uxIndex,
+                                            uxPriority, &( xHelperTasks[ uxIndex ] ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldingTask( void * pvParameters )
+{
+    UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+    for( ; ; )
+    {
+        ulHelperCounts[ uxIndex ]++;
+        taskYIELD();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifiedTask( void * pvParameters )
+{
+    UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ulHelperCounts[ uxIndex ]++;
+        xTaskNotifyGive( xTestTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void * pvParameters )
+{
+    UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS )
+        {
+            ulHelperCounts[ uxIndex ]++;
+            ( void ) xSemaphoreGive( xMutex );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupTask( void * pvParameters )
+{
+    UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+    EventBits_t uxBit = benchmarkkernelBIT_A;
+
+    for( ; ; )
+    {
+        ( void ) xEventGroupWaitBits( xEventGroup, uxBit, pdFALSE, pdTRUE, portMAX_DELAY );
+        ulHelperCounts[ uxIndex ]++;
+        uxBit ^= ( benchmarkkernelBIT_A | benchmarkkernelBIT_B );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Kernel_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Kernel_Benchmark )
+{
+    memset( xHelperTasks, 0x00, sizeof( xHelperTasks ) );
+    memset( ( void * ) ulHelperCounts, 0x00, sizeof( ulHelperCounts ) );
+    xQueue = NULL;
+    xMutex = NULL;
+    xEventGroup = NULL;
+    xStreamBuffer = NULL;
+
+    xTestTask = xTaskGetCurrentTaskHandle();
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+    uxTestTaskPriority = uxTaskPriorityGet( NULL );
+    vTaskPrioritySet( NULL, benchmarkkernelPRIORITY );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Kernel_Benchmark )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < benchmarkkernelMAX_HELPERS; x++ )
+    {
+        if( xHelperTasks[ x ] != NULL )
+        {
+            vTaskDelete( xHelperTasks[ x ] );
+        }
+    }
+
+    if( xQueue != NULL )
+    {
+        vQueueDelete( xQueue );
+    }
+
+    if( xMutex != NULL )
+    {
+        vSemaphoreDelete( xMutex );
+    }
+
+    if( xEventGroup != NULL )
+    {
+        vEventGroupDelete( xEventGroup );
+    }
+
+    if( xStreamBuffer != NULL )
+    {
+        vStreamBufferDelete( xStreamBuffer );
+    }
+
+    vTaskPrioritySet( NULL, uxTestTaskPriority );
+
+    /* Let the idle task free the helper tasks. */
+    vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Kernel_Benchmark )
+{
+    RUN_TEST_CASE( Full_Kernel_Benchmark, ContextSwitch );
+    RUN_TEST_CASE( Full_Kernel_Benchmark, QueueSendReceive );
+    RUN_TEST_CASE( Full_Kernel_Benchmark, NotificationRoundTrip );
+    RUN_TEST_CASE( Full_Kernel_Benchmark, MutexHandoff );
+    RUN_TEST_CASE( Full_Kernel_Benchmark, EventGroupFanOut );
+    RUN_TEST_CASE( Full_Kernel_Benchmark, StreamBufferSendReceive );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Two tasks of the same priority yield to each other, so every yield
+ * is a context switch.
+ */
+TEST( Full_Kernel_Benchmark, ContextSwitch )
+{
+    uint32_t ulStart, ulElapsed, x;
+
+    prvCreateHelper( prvYieldingTask, 0, benchmarkkernelPRIORITY );
+
+    ulStart = benchmarkGET_TIMESTAMP();
+
+    for( x = 0; x < benchmarkkernelITERATIONS; x++ )
+    {
+        taskYIELD();
+    }
+
+    ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+    TEST_ASSERT_TRUE( ulHelperCounts[ 0 ] >= ( benchmarkkernelITERATIONS - 1 ) );
+    benchmarkREPORT( "context_switch", "tasks", 2, benchmarkkernelITERATIONS * 2, ulElapsed );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fills and empties a queue, one item at a time and then a whole
+ * queue at a time, for item sizes from 4 to benchmarkkernelMAX_ITEM_SIZE
+ * bytes.
+ */
+TEST( Full_Kernel_Benchmark, QueueSendReceive )
+{
+    UBaseType_t uxItemSize, x, y;
+    uint32_t ulStart, ulElapsed;
+
+    for( uxItemSize = 4; uxItemSize <= benchmarkkernelMAX_ITEM_SIZE; uxItemSize *= 4 )
+    {
+        xQueue = xQueueCreate( benchmarkkernelQUEUE_LENGTH, uxItemSize );
+        TEST_ASSERT_NOT_NULL( xQueue );
+
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < ( benchmarkkernelITERATIONS / benchmarkkernelQUEUE_LENGTH ); x++ )
+        {
+            for( y = 0; y < benchmarkkernelQUEUE_LENGTH; y++ )
+            {
+                ( void ) xQueueSendToBack( xQueue, &( ucSendBuffer[ y * uxItemSize ] ), 0 );
+            }
+
+            for( y = 0; y < benchmarkkernelQUEUE_LENGTH; y++ )
+            {
+                ( void ) xQueueReceive( xQueue, &( ucReceiveBuffer[ y * uxItemSize ] ), 0 );
+            }
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+        benchmarkREPORT( "queue_send_receive", "item_size", uxItemSize, x * benchmarkkernelQUEUE_LENGTH, ulElapsed );
+
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < ( benchmarkkernelITERATIONS / benchmarkkernelQUEUE_LENGTH ); x++ )
+        {
+            ( void ) xQueueSendMultiple( xQueue, ucSendBuffer, benchmarkkernelQUEUE_LENGTH, 0 );
+            ( void ) xQueueReceiveMultiple( xQueue, ucReceiveBuffer, benchmarkkernelQUEUE_LENGTH, 0 );
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+        benchmarkREPORT( "queue_send_receive_multiple", "item_size", uxItemSize, x * benchmarkkernelQUEUE_LENGTH, ulElapsed );
+
+        TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+        vQueueDelete( xQueue );
+        xQueue = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The test task notifies a higher priority task, which notifies it
+ * back, so every iteration is two notifications and two context switches.
+ */
+TEST( Full_Kernel_Benchmark, NotificationRoundTrip )
+{
+    uint32_t ulStart, ulElapsed, x;
+
+    prvCreateHelper( prvNotifiedTask, 0, benchmarkkernelHIGH_PRIORITY );
+
+    ulStart = benchmarkGET_TIMESTAMP();
+
+    for( x = 0; x < benchmarkkernelITERATIONS; x++ )
+    {
+        xTaskNotifyGive( xHelperTasks[ 0 ] );
+        ( void ) ulTaskNotifyTake( pdTRUE, benchmarkkernelTIMEOUT );
+    }
+
+    ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+    TEST_ASSERT_EQUAL_UINT32( benchmarkkernelITERATIONS, ulHelperCounts[ 0 ] );
+    benchmarkREPORT( "notification_round_trip", "tasks", 2, benchmarkkernelITERATIONS, ulElapsed );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The test task holds a mutex a higher priority task blocks on, so
+ * the test task inherits the priority of the other task until it gives the
+ * mutex, which hands it to the other task.
+ */
+TEST( Full_Kernel_Benchmark, MutexHandoff )
+{
+    uint32_t ulStart, ulElapsed, x;
+
+    xMutex = xSemaphoreCreateMutex();
+    TEST_ASSERT_NOT_NULL( xMutex );
+    prvCreateHelper( prvMutexTask, 0, benchmarkkernelHIGH_PRIORITY );
+
+    /* Check that the priority is inherited before timing it. */
+    TEST_ASSERT_EQUAL( pdPASS, xSemaphoreTake( xMutex, 0 ) );
+    xTaskNotifyGive( xHelperTasks[ 0 ] );
+    TEST_ASSERT_EQUAL( benchmarkkernelHIGH_PRIORITY, uxTaskPriorityGet( NULL ) );
+    TEST_ASSERT_EQUAL( pdPASS, xSemaphoreGive( xMutex ) );
+    TEST_ASSERT_EQUAL( benchmarkkernelPRIORITY, uxTaskPriorityGet( NULL ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulHelperCounts[ 0 ] );
+
+    ulStart = benchmarkGET_TIMESTAMP();
+
+    for( x = 0; x < benchmarkkernelITERATIONS; x++ )
+    {
+        ( void ) xSemaphoreTake( xMutex, 0 );
+        xTaskNotifyGive( xHelperTasks[ 0 ] );
+        ( void ) xSemaphoreGive( xMutex );
+    }
+
+    ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+    TEST_ASSERT_EQUAL_UINT32( benchmarkkernelITERATIONS + 1, ulHelperCounts[ 0 ] );
+    benchmarkREPORT( "mutex_handoff", "tasks", 2, benchmarkkernelITERATIONS, ulElapsed );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sets an event group bit a growing number of higher priority tasks
+ * wait for, so every iteration unblocks all of them.
+ */
+TEST( Full_Kernel_Benchmark, EventGroupFanOut )
+{
+    UBaseType_t uxWaiters, x;
+    uint32_t ulStart, ulElapsed, ulRound, ulRounds;
+
+    xEventGroup = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL( xEventGroup );
+
+    for( uxWaiters = 1; uxWaiters <= benchmarkkernelMAX_HELPERS; uxWaiters *= 2 )
+    {
+        /* The waiters added for this number of waiters start by waiting for
+         * benchmarkkernelBIT_A, as the others do after an even number of
+         * rounds. */
+        for( x = 0; x < uxWaiters; x++ )
+        {
+            if( xHelperTasks[ x ] == NULL )
+            {
+                prvCreateHelper( prvEventGroupTask, x, benchmarkkernelHIGH_PRIORITY );
+            }
+
+            ulHelperCounts[ x ] = 0;
+        }
+
+        ulRounds = benchmarkkernelITERATIONS / uxWaiters;
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+        {
+            if( ( ulRound & 1UL ) == 0UL )
+            {
+                ( void ) xEventGroupClearBits( xEventGroup, benchmarkkernelBIT_B );
+                ( void ) xEventGroupSetBits( xEventGroup, benchmarkkernelBIT_A );
+            }
+            else
+            {
+                ( void ) xEventGroupClearBits( xEventGroup, benchmarkkernelBIT_A );
+                ( void ) xEventGroupSetBits( xEventGroup, benchmarkkernelBIT_B );
+            }
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        for( x = 0; x < uxWaiters; x++ )
+        {
+            TEST_ASSERT_EQUAL_UINT32( ulRounds, ulHelperCounts[ x ] );
+        }
+
+        benchmarkREPORT( "event_group_fan_out", "waiters", uxWaiters, ulRounds, ulElapsed );
+
+        /* Leave benchmarkkernelBIT_A to be set next, whatever the number of
+         * rounds. */
+        if( ( ulRounds & 1UL ) != 0UL )
+        {
+            ( void ) xEventGroupClearBits( xEventGroup, benchmarkkernelBIT_A );
+            ( void ) xEventGroupSetBits( xEventGroup, benchmarkkernelBIT_B );
+
+            for( x = 0; x < uxWaiters; x++ )
+            {
+                TEST_ASSERT_EQUAL_UINT32( ulRounds + 1, ulHelperCounts[ x ] );
+            }
+        }
+
+        ( void ) xEventGroupClearBits( xEventGroup, benchmarkkernelBIT_A | benchmarkkernelBIT_B );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Writes and reads back chunks of a growing size through a stream
+ * buffer.
+ */
+TEST( Full_Kernel_Benchmark, StreamBufferSendReceive )
+{
+    size_t xChunkSize;
+    uint32_t ulStart, ulElapsed, x;
+
+    xStreamBuffer = xStreamBufferCreate( benchmarkkernelSTREAM_SIZE, 1 );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    for( xChunkSize = 16; xChunkSize <= benchmarkkernelSTREAM_SIZE; xChunkSize *= 4 )
+    {
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < benchmarkkernelITERATIONS; x++ )
+        {
+            ( void ) xStreamBufferSend( xStreamBuffer, ucSendBuffer, xChunkSize, 0 );
+            ( void ) xStreamBufferReceive( xStreamBuffer, ucReceiveBuffer, xChunkSize, 0 );
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        TEST_ASSERT_TRUE( xStreamBufferIsEmpty( xStreamBuffer ) );
+        benchmarkREPORT( "stream_buffer_send_receive", "chunk_size", xChunkSize, benchmarkkernelITERATIONS, ulElapsed );
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,234 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_mqtt_lib.c
+ * @brief Benchmarks for the MQTT Core Library.
+ *
+ * Measures the cost of dispatching a received publish message to the
+ * subscription callbacks as the number of stored topic filters grows. Build
+ * once with mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX set to 0 and once
+ * with it set to 1 to compare the linear scan with the topic index. Raise
+ * mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS to benchmark larger
+ * numbers of topic filters.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* MQTT Lib includes. */
+#include "aws_mqtt_lib.h"
+#include "aws_mqtt_lib_test_access_declare.h"
+
+/* Bufferpool includes. */
+#include "aws_bufferpool.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief Number of publish messages dispatched for every number of
+ * topic filters.
+ */
+#define benchmarkmqttDISPATCH_ITERATIONS    ( 2000 )
+
+/**
+ * @brief Topic on which the dispatched publish messages are received.
+ *
+ * It matches exactly one of the stored topic filters.
+ */
+#define benchmarkmqttTOPIC                  "bench/device0/telemetry"
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief MQTT context used by the benchmarks.
+ */
+static MQTTContext_t xMQTTContext;
+
+/**
+ * @brief Number of times the subscription callback was invoked.
+ */
+static uint32_t ulCallbackCount;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The send callback registered with the MQTT library. Nothing is
+ * sent by the benchmarks.
+ */
+static uint32_t prvSendCallback( void * pvSendContext,
+                                 const uint8_t * const pucData,
+                                 uint32_t ulDataLength );
+
+/**
+ * @brief The publish callback registered for every stored topic filter.
+ *
+ * @return Always eMQTTFalse so that all the matching callbacks are invoked.
+ */
+static MQTTBool_t prvPublishCallback( void * pvPublishCallbackContext,
+                                      const MQTTPublishData_t * const pxPublishData );
+
+/**
+ * @brief Stores the given number of topic filters.
+ *
+ * Three out of four topic filters do not contain wild-cards, the rest use
+ * both the '+' and the '#' wild-cards. Only the first one matches
+ * benchmarkmqttTOPIC.
+ *
+ * @param[in] ulFilters The number of topic filters to store.
+ */
+static void prvStoreTopicFilters( uint32_t ulFilters );
+/*-----------------------------------------------------------*/
+
+static uint32_t prvSendCallback( void * pvSendContext,
+                                 const uint8_t * const pucData,
+                                 uint32_t ulDataLength )
+{
+    ( void ) pvSendContext;
+    ( void ) pucData;
+
+    return ulDataLength;
+}
+/*-----------------------------------------------------------*/
+
+static MQTTBool_t prvPublishCallback( void * pvPublishCallbackContext,
+                                      const MQTTPublishData_t * const pxPublishData )
+{
+    ( void ) pvPublishCallbackContext;
+    ( void ) pxPublishData;
+
+    ulCallbackCount++;
+
+    return eMQTTFalse;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStoreTopicFilters( uint32_t ulFilters )
+{
+    char cTopicFilter[ 48 ];
+    uint32_t x;
+    int lLength;
+
+    for( x = 0; x < ulFilters; x++ )
+    {
+        if( ( x % 4 ) == 3 )
+        {
+            lLength = snprintf( cTopicFilter, sizeof( cTopicFilter ), "bench/+/alerts%u/#", ( unsigned ) x );
+        }
+        else
+        {
+            lLength = snprintf( cTopicFilter, sizeof( cTopicFilter ), "bench/device%u/telemetry", ( unsigned ) x );
+        }
+
+        TEST_ASSERT_EQUAL( eMQTTTrue, Test_prvStoreSubscription( &( xMQTTContext ),
+                                                                 ( const uint8_t * ) cTopicFilter,
+                                                                 ( uint16_t ) lLength,
+                                                                 NULL,
+                                                                 prvPublishCallback ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_MQTT_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_MQTT_Benchmark )
+{
+    MQTTInitParams_t xInitParams;
+
+    memset( &( xInitParams ), 0x00, sizeof( xInitParams ) );
+    xInitParams.pxMQTTSendFxn = &( prvSendCallback );
+    xInitParams.xBufferPoolInterface.pxGetBufferFxn = BUFFERPOOL_GetFreeBuffer;
+    xInitParams.xBufferPoolInterface.pxReturnBufferFxn = BUFFERPOOL_ReturnBuffer;
+
+    TEST_ASSERT_EQUAL( eMQTTSuccess, MQTT_Init( &( xMQTTContext ), &( xInitParams ) ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_MQTT_Benchmark )
+{
+    Test_prvResetMQTTContext( &( xMQTTContext ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_MQTT_Benchmark )
+{
+    RUN_TEST_CASE( Full_MQTT_Benchmark, SubscriptionDispatch );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Reports the time taken to dispatch benchmarkmqttDISPATCH_ITERATIONS
+ * publish messages for a doubling number of stored topic filters.
+ */
+TEST( Full_MQTT_Benchmark, SubscriptionDispatch )
+{
+    MQTTPublishData_t xPublishData;
+    MQTTBool_t xCallbackInvoked;
+    uint32_t ulFilters, ulStart, ulElapsed, x;
+
+    memset( &( xPublishData ), 0x00, sizeof( xPublishData ) );
+    xPublishData.pucTopic = ( const uint8_t * ) benchmarkmqttTOPIC;
+    xPublishData.usTopicLength = ( uint16_t ) strlen( benchmarkmqttTOPIC );
+
+    for( ulFilters = 1; ulFilters <= ( uint32_t ) mqttconfigSUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS; ulFilters *= 2 )
+    {
+        Test_prvResetMQTTContext( &( xMQTTContext ) );
+        prvStoreTopicFilters( ulFilters );
+        ulCallbackCount = 0;
+
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < benchmarkmqttDISPATCH_ITERATIONS; x++ )
+        {
+            ( void ) Test_prvInvokeSubscriptionCallbacks( &( xMQTTContext ), &( xPublishData ), &( xCallbackInvoked ) );
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        /* Exactly one topic filter matches. */
+        TEST_ASSERT_EQUAL( benchmarkmqttDISPATCH_ITERATIONS, ulCallbackCount );
+
+        benchmarkREPORT( mqttconfigSUBSCRIPTION_MANAGER_USE_TOPIC_INDEX == 1 ? "mqtt_dispatch_topic_index" : "mqtt_dispatch_linear",
+                         "topic_filters",
+                         ulFilters,
+                         benchmarkmqttDISPATCH_ITERATIONS,
+                         ulElapsed );
+    }
+}
+/*-----------------------------------------------------------*/
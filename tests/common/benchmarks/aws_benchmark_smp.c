@@ -0,0 +1,262 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_smp.c
+ * @brief Benchmarks for the scaling of work across the cores.
+ *
+ * A fixed amount of work is shared between a growing number of worker tasks,
+ * from one up to configNUM_CORES, and the time taken to finish all of it is
+ * reported. The Compute benchmark does not call the kernel while it works, so
+ * it shows how well the scheduler spreads the workers across the cores. The
+ * Kernel benchmark has every worker send to and receive from its own queue,
+ * so the workers contend for the kernel locks. Build with CORES set to
+ * different values to compare.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief Total number of work items shared between the workers.
+ */
+#define benchmarksmpCOMPUTE_ITEMS      ( 1U << 24 )
+#define benchmarksmpKERNEL_ITEMS       ( 1U << 16 )
+
+/**
+ * @brief Priority of the workers, above the test task so they run on every
+ * core while the test task waits for them.
+ */
+#define benchmarksmpPRIORITY           ( tskIDLE_PRIORITY + 2 )
+
+/**
+ * @brief Stack size of the workers.
+ */
+#define benchmarksmpSTACK_SIZE         ( configMINIMAL_STACK_SIZE * 2 )
+
+/**
+ * @brief Time to wait for a worker to finish.
+ */
+#define benchmarksmpTIMEOUT            pdMS_TO_TICKS( 60000 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The workers and the queue each one uses in the Kernel benchmark.
+ */
+static TaskHandle_t xWorkers[ configNUM_CORES ];
+static QueueHandle_t xQueues[ configNUM_CORES ];
+
+/**
+ * @brief The test task, which the workers notify when they finish.
+ */
+static TaskHandle_t xTestTask;
+
+/**
+ * @brief Number of work items each worker processes.
+ */
+static uint32_t ulItemsPerWorker;
+
+/**
+ * @brief Written with the result of the work so that it is not optimised
+ * away.
+ */
+static volatile uint32_t ulSink;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Worker that computes without calling the kernel.
+ */
+static void prvComputeWorker( void * pvParameters );
+
+/**
+ * @brief Worker that sends to and receives from its own queue.
+ */
+static void prvKernelWorker( void * pvParameters );
+
+/**
+ * @brief Clears the worker handle, notifies the test task and deletes the
+ * calling worker.
+ */
+static void prvFinish( uint32_t ulIndex );
+
+/**
+ * @brief Shares ulItems work items between one to configNUM_CORES workers
+ * running pxWorker, and reports the time taken for each number of workers.
+ */
+static void prvRunScaling( const char * pcName,
+                           TaskFunction_t pxWorker,
+                           uint32_t ulItems );
+/*-----------------------------------------------------------*/
+
+static void prvComputeWorker( void * pvParameters )
+{
+    uint32_t x, ulValue = ( uint32_t ) ( size_t ) pvParameters;
+
+    for( x = 0; x < ulItemsPerWorker; x++ )
+    {
+        ulValue = ( ulValue * 1103515245UL ) + 12345UL;
+    }
+
+    ulSink = ulValue;
+    prvFinish( ( uint32_t ) ( size_t ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static void prvKernelWorker( void * pvParameters )
+{
+    uint32_t x, ulIndex = ( uint32_t ) ( size_t ) pvParameters, ulItem;
+
+    for( x = 0; x < ulItemsPerWorker; x++ )
+    {
+        ( void ) xQueueSend( xQueues[ ulIndex ], &x, 0 );
+        ( void ) xQueueReceive( xQueues[ ulIndex ], &ulItem, 0 );
+    }
+
+    ulSink = ulItem;
+    prvFinish( ulIndex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFinish( uint32_t ulIndex )
+{
+    xWorkers[ ulIndex ] = NULL;
+    xTaskNotifyGive( xTestTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunScaling( const char * pcName,
+                           TaskFunction_t pxWorker,
+                           uint32_t ulItems )
+{
+    uint32_t ulWorkers, ulStart, ulElapsed, x;
+
+    for( ulWorkers = 1; ulWorkers <= configNUM_CORES; ulWorkers++ )
+    {
+        ulItemsPerWorker = ulItems / ulWorkers;
+
+        /* Stop the workers starting until they have all been created. */
+        vTaskSuspendAll();
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < ulWorkers; x++ )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( pxWorker, "BenchSMP", benchmarksmpSTACK_SIZE, ( void * ) ( size_t ) x, benchmarksmpPRIORITY, &( xWorkers[ x ] ) ) );
+        }
+
+        ( void ) xTaskResumeAll();
+
+        for( x = 0; x < ulWorkers; x++ )
+        {
+            TEST_ASSERT_NOT_EQUAL( 0, ulTaskNotifyTake( pdFALSE, benchmarksmpTIMEOUT ) );
+        }
+
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        benchmarkREPORT( pcName, "workers", ulWorkers, ulItemsPerWorker * ulWorkers, ulElapsed );
+
+        /* Let the idle task free the workers. */
+        vTaskDelay( 2 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_SMP_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_SMP_Benchmark )
+{
+    uint32_t x;
+
+    memset( xWorkers, 0x00, sizeof( xWorkers ) );
+    xTestTask = xTaskGetCurrentTaskHandle();
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+    for( x = 0; x < configNUM_CORES; x++ )
+    {
+        xQueues[ x ] = xQueueCreate( 1, sizeof( uint32_t ) );
+        configASSERT( xQueues[ x ] != NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_SMP_Benchmark )
+{
+    uint32_t x;
+
+    for( x = 0; x < configNUM_CORES; x++ )
+    {
+        if( xWorkers[ x ] != NULL )
+        {
+            vTaskDelete( xWorkers[ x ] );
+        }
+
+        vQueueDelete( xQueues[ x ] );
+    }
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_SMP_Benchmark )
+{
+    RUN_TEST_CASE( Full_SMP_Benchmark, Compute );
+    RUN_TEST_CASE( Full_SMP_Benchmark, Kernel );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SMP_Benchmark, Compute )
+{
+    prvRunScaling( "smp_compute", prvComputeWorker, benchmarksmpCOMPUTE_ITEMS );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SMP_Benchmark, Kernel )
+{
+    prvRunScaling( "smp_kernel", prvKernelWorker, benchmarksmpKERNEL_ITEMS );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,242 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_socket_lookup.c
+ * @brief Benchmarks for finding the socket that a received packet is for.
+ *
+ * A growing number of UDP sockets, and of TCP sockets of which half listen
+ * and half are bound without a peer, like sockets waiting to be reused, are
+ * opened. For each number of sockets the time taken to look up every one of
+ * them is reported. Build with ipconfigUSE_SOCKET_HASH set to 0 and to 1 to
+ * compare the linear search of the bound sockets lists with the hash tables.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief The first local port used by the benchmarks.
+ */
+#define benchmarksocketPORT           ( 20000U )
+
+/**
+ * @brief Maximum number of sockets of each protocol.
+ */
+#define benchmarksocketMAX_SOCKETS    ( 256U )
+
+/**
+ * @brief Number of times every socket is looked up.
+ */
+#define benchmarksocketROUNDS         ( 1024U )
+
+/**
+ * @brief The peer that the TCP lookups are for, in host order.
+ */
+#define benchmarksocketREMOTE_IP      ( 0x0A0B0C0DUL )
+#define benchmarksocketREMOTE_PORT    ( 4321U )
+
+/**
+ * @brief Time for the IP task to close the sockets.
+ */
+#define benchmarksocketCLOSE_DELAY    pdMS_TO_TICKS( 500 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The sockets opened by the benchmark, closed by the tear down.
+ */
+static Socket_t xSockets[ benchmarksocketMAX_SOCKETS ];
+
+/**
+ * @brief Written with the result of the lookups so that they are not
+ * optimised away.
+ */
+static void * volatile pvSink;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Opens and binds the sockets from ulFirst up to ulLast - 1, making
+ * every other TCP socket listen.
+ */
+static void prvOpenSockets( BaseType_t xProtocol,
+                            uint32_t ulFirst,
+                            uint32_t ulLast );
+
+/**
+ * @brief Looks up all of ulCount sockets benchmarksocketROUNDS times, and
+ * reports the time taken.
+ */
+static void prvLookupSockets( const char * pcName,
+                              BaseType_t xProtocol,
+                              uint32_t ulCount );
+
+/**
+ * @brief Opens a doubling number of sockets and benchmarks the lookups for
+ * each number.
+ */
+static void prvRunLookups( const char * pcName,
+                           BaseType_t xProtocol );
+/*-----------------------------------------------------------*/
+
+static void prvOpenSockets( BaseType_t xProtocol,
+                            uint32_t ulFirst,
+                            uint32_t ulLast )
+{
+    struct freertos_sockaddr xAddress;
+    BaseType_t xType = ( xProtocol == FREERTOS_IPPROTO_TCP ) ? FREERTOS_SOCK_STREAM : FREERTOS_SOCK_DGRAM;
+    uint32_t x;
+
+    for( x = ulFirst; x < ulLast; x++ )
+    {
+        xSockets[ x ] = FreeRTOS_socket( FREERTOS_AF_INET, xType, xProtocol );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xSockets[ x ] );
+
+        memset( &xAddress, 0x00, sizeof( xAddress ) );
+        xAddress.sin_port = FreeRTOS_htons( benchmarksocketPORT + x );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_bind( xSockets[ x ], &xAddress, sizeof( xAddress ) ) );
+
+        if( ( xProtocol == FREERTOS_IPPROTO_TCP ) && ( ( x & 1U ) == 0U ) )
+        {
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xSockets[ x ], 1 ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLookupSockets( const char * pcName,
+                              BaseType_t xProtocol,
+                              uint32_t ulCount )
+{
+    uint32_t ulRound, x, ulStart, ulElapsed;
+    void * pvSocket = NULL;
+
+    ulStart = benchmarkGET_TIMESTAMP();
+
+    for( ulRound = 0; ulRound < benchmarksocketROUNDS; ulRound++ )
+    {
+        for( x = 0; x < ulCount; x++ )
+        {
+            if( xProtocol == FREERTOS_IPPROTO_TCP )
+            {
+                pvSocket = pxTCPSocketLookup( 0, benchmarksocketPORT + x, benchmarksocketREMOTE_IP, benchmarksocketREMOTE_PORT );
+            }
+            else
+            {
+                pvSocket = pxUDPSocketLookup( FreeRTOS_htons( benchmarksocketPORT + x ) );
+            }
+        }
+    }
+
+    ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+    pvSink = pvSocket;
+
+    benchmarkREPORT( pcName, "sockets", ulCount, benchmarksocketROUNDS * ulCount, ulElapsed );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunLookups( const char * pcName,
+                           BaseType_t xProtocol )
+{
+    uint32_t ulCount, ulOpen = 0;
+
+    for( ulCount = 1; ulCount <= benchmarksocketMAX_SOCKETS; ulCount *= 2U )
+    {
+        prvOpenSockets( xProtocol, ulOpen, ulCount );
+        ulOpen = ulCount;
+
+        prvLookupSockets( pcName, xProtocol, ulCount );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Socket_Lookup_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Socket_Lookup_Benchmark )
+{
+    memset( xSockets, 0x00, sizeof( xSockets ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Socket_Lookup_Benchmark )
+{
+    uint32_t x;
+
+    for( x = 0; x < benchmarksocketMAX_SOCKETS; x++ )
+    {
+        if( ( xSockets[ x ] != NULL ) && ( xSockets[ x ] != FREERTOS_INVALID_SOCKET ) )
+        {
+            ( void ) FreeRTOS_closesocket( xSockets[ x ] );
+        }
+    }
+
+    /* The IP task closes the sockets. */
+    vTaskDelay( benchmarksocketCLOSE_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Socket_Lookup_Benchmark )
+{
+    RUN_TEST_CASE( Full_Socket_Lookup_Benchmark, UDP );
+    RUN_TEST_CASE( Full_Socket_Lookup_Benchmark, TCP );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Socket_Lookup_Benchmark, UDP )
+{
+    prvRunLookups( "socket_lookup_udp", FREERTOS_IPPROTO_UDP );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Socket_Lookup_Benchmark, TCP )
+{
+    prvRunLookups( "socket_lookup_tcp", FREERTOS_IPPROTO_TCP );
+}
+/*-----------------------------------------------------------*/
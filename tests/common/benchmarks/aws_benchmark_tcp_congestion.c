@@ -0,0 +1,308 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_tcp_congestion.c
+ * @brief Benchmarks for the TCP congestion control algorithms.
+ *
+ * A fixed amount of data is sent through a TCP connection over the loopback
+ * network interface, which delays every frame and drops a growing share of
+ * them, and the time taken to receive all of it is reported for NewReno and
+ * for CUBIC.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+#if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+/**
+ * @brief Amount of data sent for each result.
+ */
+    #define benchmarkcongestionTRANSFER_LENGTH    ( 1024U * 1024U )
+
+/**
+ * @brief Delay of the frames, which sets the round trip time.
+ */
+    #define benchmarkcongestionDELAY              pdMS_TO_TICKS( 5 )
+
+/**
+ * @brief Size of the windows in segments.
+ */
+    #define benchmarkcongestionWINDOW_SEGMENTS    ( 16 )
+
+/**
+ * @brief Port of the first listening socket, a new port is used for every
+ * result.
+ */
+    #define benchmarkcongestionPORT               ( 7300U )
+
+/**
+ * @brief Time to wait for the connection and the data, and for the IP task
+ * to close the sockets.
+ */
+    #define benchmarkcongestionTIMEOUT            pdMS_TO_TICKS( 10000 )
+    #define benchmarkcongestionCLOSE_DELAY        pdMS_TO_TICKS( 200 )
+
+/**
+ * @brief Priority and stack size of the task that sends the data.
+ */
+    #define benchmarkcongestionSENDER_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+    #define benchmarkcongestionSENDER_STACK_SIZE  ( configMINIMAL_STACK_SIZE * 4 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The loss rates, in frames per 1000.
+ */
+    static const uint32_t ulLossRates[] = { 0U, 5U, 10U, 20U };
+
+/**
+ * @brief The sockets of the connection, and the task that sends the data.
+ */
+    static Socket_t xListener, xClient, xChild;
+    static TaskHandle_t xSender;
+    static volatile uint32_t ulBytesSent;
+
+/**
+ * @brief Counts the results, to give each connection its own port.
+ */
+    static uint16_t usRun;
+
+    extern void vNetworkInterfaceSetLoopbackImpairment( uint32_t ulLossPerMille,
+                                                         TickType_t xDelay );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sends benchmarkcongestionTRANSFER_LENGTH bytes from xClient.
+ */
+    static void prvSenderTask( void * pvParameters );
+
+/**
+ * @brief Closes the sockets and stops the sender.
+ */
+    static void prvCloseConnection( void );
+
+/**
+ * @brief Sends the data once for every loss rate, using the given algorithm,
+ * and reports the time taken.
+ */
+    static void prvRunLossRates( const char * pcName,
+                                 BaseType_t xAlgorithm );
+/*-----------------------------------------------------------*/
+
+    static void prvSenderTask( void * pvParameters )
+    {
+        static uint8_t ucBuffer[ 1460 ];
+        BaseType_t xSent;
+
+        ( void ) pvParameters;
+
+        while( ulBytesSent < benchmarkcongestionTRANSFER_LENGTH )
+        {
+            xSent = FreeRTOS_send( xClient, ucBuffer, FreeRTOS_min_uint32( sizeof( ucBuffer ), benchmarkcongestionTRANSFER_LENGTH - ulBytesSent ), 0 );
+
+            if( xSent <= 0 )
+            {
+                break;
+            }
+
+            ulBytesSent += ( uint32_t ) xSent;
+        }
+
+        xSender = NULL;
+        vTaskDelete( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCloseConnection( void )
+    {
+        vNetworkInterfaceSetLoopbackImpairment( 0, 0 );
+
+        if( xSender != NULL )
+        {
+            vTaskDelete( xSender );
+            xSender = NULL;
+        }
+
+        if( xChild != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xChild );
+            xChild = NULL;
+        }
+
+        if( xClient != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xClient );
+            xClient = NULL;
+        }
+
+        if( xListener != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xListener );
+            xListener = NULL;
+        }
+
+        /* The IP task closes the sockets, and the idle task frees the sender. */
+        vTaskDelay( benchmarkcongestionCLOSE_DELAY );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunLossRates( const char * pcName,
+                                 BaseType_t xAlgorithm )
+    {
+        static uint8_t ucBuffer[ 1460 ];
+        struct freertos_sockaddr xAddress;
+        socklen_t xSize = sizeof( xAddress );
+        TickType_t xTimeout = benchmarkcongestionTIMEOUT;
+        WinProperties_t xProperties;
+        uint32_t x, ulReceived, ulStart, ulElapsed;
+        BaseType_t xCount;
+
+        xProperties.lTxBufSize = 2 * benchmarkcongestionWINDOW_SEGMENTS * ipconfigTCP_MSS;
+        xProperties.lTxWinSize = benchmarkcongestionWINDOW_SEGMENTS;
+        xProperties.lRxBufSize = 2 * benchmarkcongestionWINDOW_SEGMENTS * ipconfigTCP_MSS;
+        xProperties.lRxWinSize = benchmarkcongestionWINDOW_SEGMENTS;
+
+        for( x = 0; x < ( sizeof( ulLossRates ) / sizeof( ulLossRates[ 0 ] ) ); x++ )
+        {
+            ulBytesSent = 0;
+            ulReceived = 0;
+            usRun++;
+
+            xListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+            TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xListener );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xListener, 0, FREERTOS_SO_WIN_PROPERTIES, &xProperties, sizeof( xProperties ) ) );
+            memset( &xAddress, 0x00, sizeof( xAddress ) );
+            xAddress.sin_port = FreeRTOS_htons( benchmarkcongestionPORT + usRun );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_bind( xListener, &xAddress, sizeof( xAddress ) ) );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xListener, 1 ) );
+
+            xClient = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+            TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xClient );
+            ( void ) FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_SNDTIMEO, &xTimeout, sizeof( xTimeout ) );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_WIN_PROPERTIES, &xProperties, sizeof( xProperties ) ) );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_TCP_CONGESTION, &xAlgorithm, sizeof( xAlgorithm ) ) );
+            xAddress.sin_addr = FreeRTOS_GetIPAddress();
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_connect( xClient, &xAddress, sizeof( xAddress ) ) );
+
+            xChild = FreeRTOS_accept( xListener, &xAddress, &xSize );
+            TEST_ASSERT_NOT_NULL( xChild );
+            TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xChild );
+            ( void ) FreeRTOS_setsockopt( xChild, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+
+            /* Only the transfer itself is impaired and timed. */
+            vNetworkInterfaceSetLoopbackImpairment( ulLossRates[ x ], benchmarkcongestionDELAY );
+            ulStart = benchmarkGET_TIMESTAMP();
+            TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvSenderTask, "BenchCong", benchmarkcongestionSENDER_STACK_SIZE, NULL, benchmarkcongestionSENDER_PRIORITY, &xSender ) );
+
+            while( ulReceived < benchmarkcongestionTRANSFER_LENGTH )
+            {
+                xCount = FreeRTOS_recv( xChild, ucBuffer, sizeof( ucBuffer ), 0 );
+                TEST_ASSERT_GREATER_THAN( 0, xCount );
+                ulReceived += ( uint32_t ) xCount;
+            }
+
+            ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+            benchmarkREPORT( pcName, "loss_per_mille", ulLossRates[ x ], ulReceived, ulElapsed );
+
+            prvCloseConnection();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 ) */
+
+/* Define Test Group. */
+TEST_GROUP( Full_TCP_Congestion_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_TCP_Congestion_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        xListener = NULL;
+        xClient = NULL;
+        xChild = NULL;
+        xSender = NULL;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_TCP_Congestion_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        /* Only left open when a run failed. */
+        prvCloseConnection();
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_TCP_Congestion_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        RUN_TEST_CASE( Full_TCP_Congestion_Benchmark, NewReno );
+        RUN_TEST_CASE( Full_TCP_Congestion_Benchmark, Cubic );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+    TEST( Full_TCP_Congestion_Benchmark, NewReno )
+    {
+        prvRunLossRates( "tcp_congestion_newreno", FREERTOS_TCP_CONGESTION_NEWRENO );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion_Benchmark, Cubic )
+    {
+        prvRunLossRates( "tcp_congestion_cubic", FREERTOS_TCP_CONGESTION_CUBIC );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 ) && ( configNETWORK_INTERFACE_LOOPBACK == 1 ) */
@@ -0,0 +1,235 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_tcp_rx_window.c
+ * @brief Benchmarks for storing TCP segments that arrive out of order.
+ *
+ * A growing number of MSS sized segments is given to the receive side of a
+ * TCP window, all but the first of them in reverse or in random order, before
+ * the first one fills the hole. For each number of segments the time taken to
+ * deliver all of them is reported. No TCP connection may be open while the
+ * benchmarks run, because the window borrows its segment descriptors from the
+ * pool that the IP task uses.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_TCP_WIN.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Size of the segments, and the first sequence number received.
+ */
+    #define benchmarkrxMSS             ( 1460U )
+    #define benchmarkrxFIRST           ( 0x7FFF0000UL )
+
+/**
+ * @brief Maximum number of segments in the receive window, which stays below
+ * ipconfigTCP_WIN_SEG_COUNT so that each one can be stored on its own.
+ */
+    #define benchmarkrxMAX_SEGMENTS    ( 192U )
+
+/**
+ * @brief Number of times the segments are delivered for each number of
+ * segments.
+ */
+    #define benchmarkrxROUNDS          ( 16U )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The window that receives the segments.
+ */
+    static TCPWindow_t xWindow;
+
+/**
+ * @brief The order in which the segments are delivered.
+ */
+    static uint32_t ulOrder[ benchmarkrxMAX_SEGMENTS ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fills ulOrder with the segments 1 to ulCount - 1, in reverse order or
+ * shuffled, followed by segment 0.
+ */
+    static void prvMakeOrder( uint32_t ulCount,
+                              BaseType_t xShuffle );
+
+/**
+ * @brief Delivers ulCount segments benchmarkrxROUNDS times in the order of
+ * ulOrder, and reports the time taken.
+ */
+    static void prvDeliver( const char * pcName,
+                            uint32_t ulCount );
+
+/**
+ * @brief Benchmarks the delivery of a doubling number of segments.
+ */
+    static void prvRunDeliveries( const char * pcName,
+                                  BaseType_t xShuffle );
+/*-----------------------------------------------------------*/
+
+    static void prvMakeOrder( uint32_t ulCount,
+                              BaseType_t xShuffle )
+    {
+        uint32_t x, ulOther, ulSwap, ulRandom = 12345UL;
+
+        for( x = 0; x < ulCount - 1U; x++ )
+        {
+            ulOrder[ x ] = ulCount - 1U - x;
+        }
+
+        if( xShuffle != pdFALSE )
+        {
+            for( x = ulCount - 2U; x > 0U; x-- )
+            {
+                ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+                ulOther = ( ulRandom >> 16 ) % ( x + 1U );
+                ulSwap = ulOrder[ x ];
+                ulOrder[ x ] = ulOrder[ ulOther ];
+                ulOrder[ ulOther ] = ulSwap;
+            }
+        }
+
+        ulOrder[ ulCount - 1U ] = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDeliver( const char * pcName,
+                            uint32_t ulCount )
+    {
+        uint32_t ulRound, x, ulStart, ulElapsed = 0U;
+        uint32_t ulSpace = ulCount * benchmarkrxMSS;
+
+        for( ulRound = 0; ulRound < benchmarkrxROUNDS; ulRound++ )
+        {
+            memset( &xWindow, 0x00, sizeof( xWindow ) );
+            vTCPWindowCreate( &xWindow, ulSpace, ulSpace, benchmarkrxFIRST, 0UL, benchmarkrxMSS );
+
+            vTaskSuspendAll();
+            ulStart = benchmarkGET_TIMESTAMP();
+
+            for( x = 0; x < ulCount; x++ )
+            {
+                ( void ) lTCPWindowRxCheck( &xWindow, benchmarkrxFIRST + ( ulOrder[ x ] * benchmarkrxMSS ), benchmarkrxMSS, ulSpace );
+            }
+
+            ulElapsed += benchmarkGET_TIMESTAMP() - ulStart;
+            ( void ) xTaskResumeAll();
+
+            /* The last segment filled the hole, so all of them were received. */
+            TEST_ASSERT_EQUAL_UINT32( benchmarkrxFIRST + ulSpace, xWindow.rx.ulCurrentSequenceNumber );
+            vTCPWindowDestroy( &xWindow );
+        }
+
+        benchmarkREPORT( pcName, "segments", ulCount, benchmarkrxROUNDS * ulCount, ulElapsed );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunDeliveries( const char * pcName,
+                                  BaseType_t xShuffle )
+    {
+        uint32_t ulCount;
+
+        for( ulCount = 6U; ulCount <= benchmarkrxMAX_SEGMENTS; ulCount *= 2U )
+        {
+            prvMakeOrder( ulCount, xShuffle );
+            prvDeliver( pcName, ulCount );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/* Define Test Group. */
+TEST_GROUP( Full_TCP_Rx_Window_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_TCP_Rx_Window_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        memset( &xWindow, 0x00, sizeof( xWindow ) );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_TCP_Rx_Window_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        /* Return the segments of a round that failed to the pool. */
+        vTCPWindowDestroy( &xWindow );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_TCP_Rx_Window_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        RUN_TEST_CASE( Full_TCP_Rx_Window_Benchmark, Reverse );
+        RUN_TEST_CASE( Full_TCP_Rx_Window_Benchmark, Random );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+    TEST( Full_TCP_Rx_Window_Benchmark, Reverse )
+    {
+        prvRunDeliveries( "tcp_rx_window_reverse", pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window_Benchmark, Random )
+    {
+        prvRunDeliveries( "tcp_rx_window_random", pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
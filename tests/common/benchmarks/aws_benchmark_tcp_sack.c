@@ -0,0 +1,435 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_tcp_sack.c
+ * @brief Benchmarks for the recovery of a TCP window from bursts of loss.
+ *
+ * The transmit side of one TCP window sends to the receive side of another
+ * over a simulated path with a long round trip time, which loses bursts of
+ * consecutive segments. The acknowledgements and SACK options made by the
+ * receiving window are given back to the sending window, as the IP task does.
+ * For each burst length the time taken for all the data sent up to the end of
+ * the burst to be acknowledged, and the number of segments sent again, are
+ * reported, first when only the burst is lost and then when the first
+ * retransmission is lost as well. No TCP connection may be open while the
+ * benchmarks run, because the windows borrow their segment descriptors from
+ * the pool that the IP task uses.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_TCP_WIN.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Size of the segments, and the first sequence number sent.
+ */
+    #define benchmarksackMSS               ( 1000U )
+    #define benchmarksackFIRST             ( 0x7FFF0000UL )
+
+/**
+ * @brief Size of both windows in segments, which is also the most data that
+ * may be in flight.
+ */
+    #define benchmarksackWINDOW_SEGMENTS   ( 64U )
+
+/**
+ * @brief Delay of the path in each direction, so the round trip time is
+ * twice as long.
+ */
+    #define benchmarksackDELAY             ( pdMS_TO_TICKS( 10 ) )
+
+/**
+ * @brief Number of segments sent for each result, and the segment at which
+ * the first burst starts, after slow start has opened the window.
+ */
+    #define benchmarksackSEGMENTS          ( 512U )
+    #define benchmarksackFIRST_LOSS        ( 200U )
+
+/**
+ * @brief Number of packets that the path can hold in each direction.
+ */
+    #define benchmarksackPATH_PACKETS      ( 256U )
+
+/**
+ * @brief Time after which a transfer is considered to be stuck.
+ */
+    #define benchmarksackTIMEOUT           ( pdMS_TO_TICKS( 30000 ) )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A segment or an acknowledgement on its way, and the tick at which it
+ * arrives.
+ */
+    typedef struct
+    {
+        TickType_t xArrival;
+        uint32_t ulSequenceNumber;
+        uint32_t ulLength;
+        UBaseType_t uxBlocks;
+        uint32_t ulBlocks[ 2 * ipconfigTCP_SACK_BLOCKS ];
+    } SimPacket_t;
+
+/**
+ * @brief The packets travelling in one direction of the path, in order of
+ * arrival.
+ */
+    typedef struct
+    {
+        SimPacket_t xPackets[ benchmarksackPATH_PACKETS ];
+        uint32_t ulHead;
+        uint32_t ulCount;
+    } SimPath_t;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The lengths of the bursts, in segments.
+ */
+    static const uint32_t ulBurstLengths[] = { 1U, 2U, 4U, 8U, 16U };
+
+/**
+ * @brief The window that sends the data and the window that receives it.
+ */
+    static TCPWindow_t xSender, xReceiver;
+
+/**
+ * @brief The data and the acknowledgements on their way.
+ */
+    static SimPath_t xDataPath, xAckPath;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Adds a packet that arrives after benchmarksackDELAY to pxPath, and
+ * returns it.
+ */
+    static SimPacket_t * prvPathAdd( SimPath_t * pxPath );
+
+/**
+ * @brief Returns the first packet of pxPath if it has arrived, or NULL.
+ */
+    static SimPacket_t * prvPathArrived( SimPath_t * pxPath );
+
+/**
+ * @brief Removes the first packet of pxPath.
+ */
+    static void prvPathRemove( SimPath_t * pxPath );
+
+/**
+ * @brief Gives the segment to xReceiver and sends back the acknowledgement
+ * and the SACK option that it makes.
+ */
+    static void prvReceive( const SimPacket_t * pxPacket );
+
+/**
+ * @brief Gives an acknowledgement and its SACK blocks to xSender, in the
+ * same order as the IP task does.
+ */
+    static void prvAcknowledge( const SimPacket_t * pxPacket );
+
+/**
+ * @brief Sends benchmarksackSEGMENTS segments through a path that loses
+ * ulBurstLength of them at benchmarksackFIRST_LOSS, and the first retransmission
+ * as well if xLoseRetransmission is pdTRUE. Returns the ticks taken to
+ * acknowledge the data sent up to the end of the burst, and the number of
+ * segments sent again.
+ */
+    static void prvTransfer( uint32_t ulBurstLength,
+                             BaseType_t xLoseRetransmission,
+                             TickType_t * pxTicks,
+                             uint32_t * pulRetransmissions );
+
+/**
+ * @brief Reports the results of prvTransfer() for every burst length.
+ */
+    static void prvRunBursts( const char * pcName,
+                              BaseType_t xLoseRetransmission );
+/*-----------------------------------------------------------*/
+
+    static SimPacket_t * prvPathAdd( SimPath_t * pxPath )
+    {
+        SimPacket_t * pxPacket;
+
+        TEST_ASSERT_LESS_THAN( benchmarksackPATH_PACKETS, pxPath->ulCount );
+        pxPacket = &( pxPath->xPackets[ ( pxPath->ulHead + pxPath->ulCount ) % benchmarksackPATH_PACKETS ] );
+        pxPath->ulCount++;
+
+        memset( pxPacket, 0x00, sizeof( *pxPacket ) );
+        pxPacket->xArrival = xTaskGetTickCount() + benchmarksackDELAY;
+
+        return pxPacket;
+    }
+/*-----------------------------------------------------------*/
+
+    static SimPacket_t * prvPathArrived( SimPath_t * pxPath )
+    {
+        SimPacket_t * pxPacket = NULL;
+
+        if( ( pxPath->ulCount != 0U ) &&
+            ( ( int32_t ) ( xTaskGetTickCount() - pxPath->xPackets[ pxPath->ulHead ].xArrival ) >= 0 ) )
+        {
+            pxPacket = &( pxPath->xPackets[ pxPath->ulHead ] );
+        }
+
+        return pxPacket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPathRemove( SimPath_t * pxPath )
+    {
+        pxPath->ulHead = ( pxPath->ulHead + 1U ) % benchmarksackPATH_PACKETS;
+        pxPath->ulCount--;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReceive( const SimPacket_t * pxPacket )
+    {
+        SimPacket_t * pxAck;
+        UBaseType_t x;
+
+        ( void ) lTCPWindowRxCheck( &xReceiver, pxPacket->ulSequenceNumber, pxPacket->ulLength, benchmarksackWINDOW_SEGMENTS * benchmarksackMSS );
+
+        pxAck = prvPathAdd( &xAckPath );
+        pxAck->ulSequenceNumber = xReceiver.rx.ulCurrentSequenceNumber;
+
+        /* Two NOP's, the SACK code and its length, followed by the blocks. */
+        if( xReceiver.ucOptionLength != 0U )
+        {
+            pxAck->uxBlocks = ( ( UBaseType_t ) xReceiver.ucOptionLength - 4U ) / 8U;
+
+            for( x = 0; x < 2U * pxAck->uxBlocks; x++ )
+            {
+                pxAck->ulBlocks[ x ] = FreeRTOS_ntohl( xReceiver.ulOptionsData[ 1U + x ] );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAcknowledge( const SimPacket_t * pxPacket )
+    {
+        UBaseType_t x;
+
+        /* The options are checked before the acknowledgement number. */
+        for( x = 0; x < pxPacket->uxBlocks; x++ )
+        {
+            ( void ) ulTCPWindowTxSack( &xSender, pxPacket->ulBlocks[ 2U * x ], pxPacket->ulBlocks[ ( 2U * x ) + 1U ] );
+        }
+
+        ( void ) ulTCPWindowTxAck( &xSender, pxPacket->ulSequenceNumber );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTransfer( uint32_t ulBurstLength,
+                             BaseType_t xLoseRetransmission,
+                             TickType_t * pxTicks,
+                             uint32_t * pulRetransmissions )
+    {
+        const uint32_t ulLast = benchmarksackFIRST + ( benchmarksackSEGMENTS * benchmarksackMSS );
+        uint32_t ulSent = 0U, ulAdded = 0U, ulNextNew = benchmarksackFIRST;
+        uint32_t ulLength, ulRecover = ulLast;
+        int32_t lPosition;
+        TickType_t xStart = xTaskGetTickCount(), xLoss = 0U;
+        SimPacket_t * pxPacket;
+        BaseType_t xLost;
+
+        memset( &xSender, 0x00, sizeof( xSender ) );
+        memset( &xReceiver, 0x00, sizeof( xReceiver ) );
+        memset( &xDataPath, 0x00, sizeof( xDataPath ) );
+        memset( &xAckPath, 0x00, sizeof( xAckPath ) );
+        vTCPWindowCreate( &xSender, benchmarksackWINDOW_SEGMENTS * benchmarksackMSS, benchmarksackWINDOW_SEGMENTS * benchmarksackMSS, 0UL, benchmarksackFIRST, benchmarksackMSS );
+        vTCPWindowCreate( &xReceiver, benchmarksackWINDOW_SEGMENTS * benchmarksackMSS, benchmarksackWINDOW_SEGMENTS * benchmarksackMSS, benchmarksackFIRST, 0UL, benchmarksackMSS );
+        *pulRetransmissions = 0U;
+
+        while( xSender.tx.ulCurrentSequenceNumber != ulLast )
+        {
+            TEST_ASSERT_LESS_THAN( benchmarksackTIMEOUT, xTaskGetTickCount() - xStart );
+
+            while( ( pxPacket = prvPathArrived( &xAckPath ) ) != NULL )
+            {
+                prvAcknowledge( pxPacket );
+                prvPathRemove( &xAckPath );
+            }
+
+            /* Keep a window of data queued, as a busy socket would. */
+            while( ( ulAdded < benchmarksackSEGMENTS ) &&
+                   ( ( ulAdded * benchmarksackMSS ) < ( ( xSender.tx.ulCurrentSequenceNumber - benchmarksackFIRST ) + ( 2U * benchmarksackWINDOW_SEGMENTS * benchmarksackMSS ) ) ) )
+            {
+                TEST_ASSERT_EQUAL_INT32( benchmarksackMSS, lTCPWindowTxAdd( &xSender, benchmarksackMSS, ( int32_t ) ( ulAdded * benchmarksackMSS ), ( int32_t ) ( ulLast - benchmarksackFIRST ) + 1 ) );
+                ulAdded++;
+            }
+
+            while( ( ulLength = ulTCPWindowTxGet( &xSender, benchmarksackWINDOW_SEGMENTS * benchmarksackMSS, &lPosition ) ) != 0U )
+            {
+                xLost = pdFALSE;
+
+                if( ( int32_t ) ( xSender.ulOurSequenceNumber - ulNextNew ) < 0 )
+                {
+                    ( *pulRetransmissions )++;
+
+                    if( ( xLoseRetransmission != pdFALSE ) && ( *pulRetransmissions == 1U ) )
+                    {
+                        xLost = pdTRUE;
+                    }
+                }
+                else
+                {
+                    ulNextNew = xSender.ulOurSequenceNumber + ulLength;
+                }
+
+                if( ulSent == benchmarksackFIRST_LOSS )
+                {
+                    xLoss = xTaskGetTickCount();
+                }
+
+                if( ( ulSent >= benchmarksackFIRST_LOSS ) && ( ulSent < ( benchmarksackFIRST_LOSS + ulBurstLength ) ) )
+                {
+                    xLost = pdTRUE;
+                    ulRecover = ulNextNew;
+                }
+
+                ulSent++;
+
+                if( xLost == pdFALSE )
+                {
+                    pxPacket = prvPathAdd( &xDataPath );
+                    pxPacket->ulSequenceNumber = xSender.ulOurSequenceNumber;
+                    pxPacket->ulLength = ulLength;
+                }
+            }
+
+            while( ( pxPacket = prvPathArrived( &xDataPath ) ) != NULL )
+            {
+                prvReceive( pxPacket );
+                prvPathRemove( &xDataPath );
+            }
+
+            if( ( ulRecover != ulLast ) && ( ( int32_t ) ( xSender.tx.ulCurrentSequenceNumber - ulRecover ) >= 0 ) )
+            {
+                *pxTicks = xTaskGetTickCount() - xLoss;
+                ulRecover = ulLast;
+            }
+
+            vTaskDelay( 1 );
+        }
+
+        vTCPWindowDestroy( &xSender );
+        vTCPWindowDestroy( &xReceiver );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunBursts( const char * pcName,
+                              BaseType_t xLoseRetransmission )
+    {
+        char cName[ 64 ];
+        TickType_t xTicks = 0U;
+        uint32_t x, ulRetransmissions;
+
+        for( x = 0; x < ( sizeof( ulBurstLengths ) / sizeof( ulBurstLengths[ 0 ] ) ); x++ )
+        {
+            prvTransfer( ulBurstLengths[ x ], xLoseRetransmission, &xTicks, &ulRetransmissions );
+
+            ( void ) snprintf( cName, sizeof( cName ), "%s_ticks", pcName );
+            benchmarkREPORT_METRIC( cName, "burst_segments", ulBurstLengths[ x ], xTicks );
+            ( void ) snprintf( cName, sizeof( cName ), "%s_retransmissions", pcName );
+            benchmarkREPORT_METRIC( cName, "burst_segments", ulBurstLengths[ x ], ulRetransmissions );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/* Define Test Group. */
+TEST_GROUP( Full_TCP_Sack_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_TCP_Sack_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        memset( &xSender, 0x00, sizeof( xSender ) );
+        memset( &xReceiver, 0x00, sizeof( xReceiver ) );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_TCP_Sack_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        /* Return the segments of a transfer that failed to the pool. */
+        vTCPWindowDestroy( &xSender );
+        vTCPWindowDestroy( &xReceiver );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_TCP_Sack_Benchmark )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        RUN_TEST_CASE( Full_TCP_Sack_Benchmark, SingleBurst );
+        RUN_TEST_CASE( Full_TCP_Sack_Benchmark, LostRetransmission );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+    TEST( Full_TCP_Sack_Benchmark, SingleBurst )
+    {
+        prvRunBursts( "tcp_sack_single_burst", pdFALSE );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Sack_Benchmark, LostRetransmission )
+    {
+        prvRunBursts( "tcp_sack_lost_retransmission", pdTRUE );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -0,0 +1,253 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark_timers.c
+ * @brief Benchmarks for the software timer service.
+ *
+ * Resets, stops and restarts randomly chosen timers while a growing number of
+ * timers are active, which is the pattern of per connection and per request
+ * timeouts. Each command is processed by the timer service task before the
+ * next one is sent, so the time reported includes inserting the timer into
+ * the active timers. Build with configUSE_TIMER_WHEEL set to 0 and to 1 to
+ * compare the sorted list with the timer wheel.
+ */
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Benchmark includes. */
+#include "aws_benchmark.h"
+
+/**
+ * @brief Name of the benchmark, which includes the timer implementation.
+ */
+#if ( configUSE_TIMER_WHEEL == 1 )
+    #define benchmarktimersNAME            "timer_churn_wheel"
+#else
+    #define benchmarktimersNAME            "timer_churn_list"
+#endif
+
+/**
+ * @brief Largest number of active timers.
+ */
+#define benchmarktimersMAX_TIMERS          ( 1024 )
+
+/**
+ * @brief Number of commands timed for every number of active timers.
+ */
+#define benchmarktimersCOMMANDS            ( 8192 )
+
+/**
+ * @brief Shortest and longest timer periods.
+ *
+ * They are long enough that no timer expires during the benchmark.
+ */
+#define benchmarktimersMIN_PERIOD          pdMS_TO_TICKS( 60000 )
+#define benchmarktimersMAX_PERIOD          pdMS_TO_TICKS( 120000 )
+
+/**
+ * @brief Time to wait for the timer service task.
+ */
+#define benchmarktimersTIMEOUT             pdMS_TO_TICKS( 10000 )
+
+/**
+ * @brief The timers, which are created statically so that the benchmark does
+ * not depend on the heap.
+ */
+static StaticTimer_t xTimerBuffers[ benchmarktimersMAX_TIMERS ];
+static TimerHandle_t xTimers[ benchmarktimersMAX_TIMERS ];
+
+/**
+ * @brief Number of timers that expired, which must stay 0.
+ */
+static volatile uint32_t ulExpired;
+
+/**
+ * @brief State of the pseudo random number generator.
+ */
+static uint32_t ulRandom;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Callback of the timers, which are not expected to expire.
+ */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/**
+ * @brief Returns the next pseudo random number.
+ */
+static uint32_t prvRandom( void );
+
+/**
+ * @brief Waits until the timer service task has processed all the commands
+ * sent before.
+ */
+static void prvWaitForTimerService( void );
+
+/**
+ * @brief Pended to the timer service task by prvWaitForTimerService().
+ */
+static void prvNotifyTask( void * pvTask,
+                           uint32_t ulUnused );
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    ulExpired++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+
+    return ulRandom >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyTask( void * pvTask,
+                           uint32_t ulUnused )
+{
+    ( void ) ulUnused;
+    xTaskNotifyGive( ( TaskHandle_t ) pvTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForTimerService( void )
+{
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerPendFunctionCall( prvNotifyTask, xTaskGetCurrentTaskHandle(), 0, benchmarktimersTIMEOUT ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulTaskNotifyTake( pdTRUE, benchmarktimersTIMEOUT ) );
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Timer_Benchmark );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Timer_Benchmark )
+{
+    uint32_t x;
+
+    ulRandom = 1;
+    ulExpired = 0;
+
+    for( x = 0; x < benchmarktimersMAX_TIMERS; x++ )
+    {
+        xTimers[ x ] = xTimerCreateStatic( "Bench",
+                                           benchmarktimersMIN_PERIOD + ( x % ( benchmarktimersMAX_PERIOD - benchmarktimersMIN_PERIOD ) ),
+                                           pdFALSE,
+                                           NULL,
+                                           prvTimerCallback,
+                                           &( xTimerBuffers[ x ] ) );
+        configASSERT( xTimers[ x ] != NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Timer_Benchmark )
+{
+    uint32_t x;
+
+    for( x = 0; x < benchmarktimersMAX_TIMERS; x++ )
+    {
+        ( void ) xTimerDelete( xTimers[ x ], benchmarktimersTIMEOUT );
+    }
+
+    prvWaitForTimerService();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Timer_Benchmark )
+{
+    RUN_TEST_CASE( Full_Timer_Benchmark, Churn );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Reports the time taken by benchmarktimersCOMMANDS commands for a
+ * doubling number of active timers. Three in four commands reset a timer, the
+ * others stop a timer and start it again.
+ */
+TEST( Full_Timer_Benchmark, Churn )
+{
+    uint32_t ulActive, ulStarted = 0, ulStart, ulElapsed, ulTimer, x;
+
+    for( ulActive = 16; ulActive <= benchmarktimersMAX_TIMERS; ulActive *= 2 )
+    {
+        /* Start the timers that are not active yet. */
+        for( ; ulStarted < ulActive; ulStarted++ )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ ulStarted ], benchmarktimersTIMEOUT ) );
+        }
+
+        prvWaitForTimerService();
+        ulStart = benchmarkGET_TIMESTAMP();
+
+        for( x = 0; x < benchmarktimersCOMMANDS; x++ )
+        {
+            ulTimer = prvRandom() % ulActive;
+
+            if( ( x % 4 ) == 0 )
+            {
+                ( void ) xTimerStop( xTimers[ ulTimer ], benchmarktimersTIMEOUT );
+                ( void ) xTimerStart( xTimers[ ulTimer ], benchmarktimersTIMEOUT );
+            }
+            else
+            {
+                ( void ) xTimerReset( xTimers[ ulTimer ], benchmarktimersTIMEOUT );
+            }
+        }
+
+        prvWaitForTimerService();
+        ulElapsed = benchmarkGET_TIMESTAMP() - ulStart;
+
+        for( x = 0; x < ulActive; x++ )
+        {
+            TEST_ASSERT_TRUE( xTimerIsTimerActive( xTimers[ x ] ) );
+        }
+
+        TEST_ASSERT_EQUAL_UINT32( 0, ulExpired );
+
+        benchmarkREPORT( benchmarktimersNAME, "active_timers", ulActive, benchmarktimersCOMMANDS, ulElapsed );
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,285 @@
+/*
+ * Amazon FreeRTOS MQTT AFQP V1.1.4
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_bufferpool.c
+ * @brief Tests for the buffer pool.
+ *
+ * The tests only rely on the aws_bufferpool.h interface and learn the size
+ * classes through BUFFERPOOL_GetStats, so they apply to every buffer pool
+ * implementation. Every test returns all the buffers it takes.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* Bufferpool includes. */
+#include "aws_bufferpool.h"
+
+/**
+ * @brief The maximum number of buffers the tests hold at the same time.
+ */
+#define testbufferpoolMAX_HELD_BUFFERS    ( 64 )
+
+/**
+ * @brief The maximum number of size classes the tests look at.
+ */
+#define testbufferpoolMAX_SIZE_CLASSES    ( 8 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The buffers held by the current test.
+ */
+static uint8_t * pucHeldBuffers[ testbufferpoolMAX_HELD_BUFFERS ];
+
+/**
+ * @brief The number of entries in pucHeldBuffers.
+ */
+static uint32_t ulHeldBuffers;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Gets the statistics of all the size classes.
+ *
+ * @param[out] pxStats The statistics of each size class.
+ *
+ * @return The number of size classes.
+ */
+static uint32_t prvGetAllStats( BufferPoolStats_t * pxStats );
+
+/**
+ * @brief Gets a buffer and remembers it so that it is returned at the end of
+ * the test.
+ *
+ * @param[in,out] pulBufferLength The requested length, updated to the actual
+ * length of the returned buffer.
+ *
+ * @return The buffer, NULL if none is available.
+ */
+static uint8_t * prvHoldBuffer( uint32_t * pulBufferLength );
+/*-----------------------------------------------------------*/
+
+static uint32_t prvGetAllStats( BufferPoolStats_t * pxStats )
+{
+    uint32_t ulSizeClasses = 0;
+
+    while( ( ulSizeClasses < testbufferpoolMAX_SIZE_CLASSES ) &&
+           ( BUFFERPOOL_GetStats( ulSizeClasses, &( pxStats[ ulSizeClasses ] ) ) == pdPASS ) )
+    {
+        ulSizeClasses++;
+    }
+
+    /* There must be at least one size class. */
+    TEST_ASSERT_GREATER_THAN( 0, ulSizeClasses );
+
+    return ulSizeClasses;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvHoldBuffer( uint32_t * pulBufferLength )
+{
+    uint8_t * pucBuffer;
+
+    pucBuffer = BUFFERPOOL_GetFreeBuffer( pulBufferLength );
+
+    if( pucBuffer != NULL )
+    {
+        TEST_ASSERT_LESS_THAN( testbufferpoolMAX_HELD_BUFFERS, ulHeldBuffers );
+        pucHeldBuffers[ ulHeldBuffers ] = pucBuffer;
+        ulHeldBuffers++;
+    }
+
+    return pucBuffer;
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_BufferPool );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_BufferPool )
+{
+    ulHeldBuffers = 0;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_BufferPool )
+{
+    /* Return the buffers even if the test failed half way. */
+    while( ulHeldBuffers > 0 )
+    {
+        ulHeldBuffers--;
+        BUFFERPOOL_ReturnBuffer( pucHeldBuffers[ ulHeldBuffers ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_BufferPool )
+{
+    RUN_TEST_CASE( Full_BufferPool, AFQP_BUFFERPOOL_GetFreeBuffer_BestFit );
+    RUN_TEST_CASE( Full_BufferPool, AFQP_BUFFERPOOL_GetFreeBuffer_TooLarge );
+    RUN_TEST_CASE( Full_BufferPool, AFQP_BUFFERPOOL_GetFreeBuffer_FallBackToLargerClass );
+    RUN_TEST_CASE( Full_BufferPool, AFQP_BUFFERPOOL_GetStats_HighWaterMark );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A request is served from the smallest size class large enough.
+ */
+TEST( Full_BufferPool, AFQP_BUFFERPOOL_GetFreeBuffer_BestFit )
+{
+    BufferPoolStats_t xStats[ testbufferpoolMAX_SIZE_CLASSES ];
+    uint32_t x, ulSizeClasses, ulBufferLength;
+    uint8_t * pucBuffer;
+
+    ulSizeClasses = prvGetAllStats( xStats );
+
+    for( x = 0; x < ulSizeClasses; x++ )
+    {
+        /* Size classes are in the increasing order of buffer size. */
+        if( x > 0 )
+        {
+            TEST_ASSERT_GREATER_THAN( xStats[ x - 1 ].ulBufferSize, xStats[ x ].ulBufferSize );
+        }
+
+        /* Skip the classes which are exhausted by other users of the pool. */
+        if( xStats[ x ].ulInUse < xStats[ x ].ulNumBuffers )
+        {
+            ulBufferLength = xStats[ x ].ulBufferSize;
+            pucBuffer = prvHoldBuffer( &ulBufferLength );
+
+            TEST_ASSERT_NOT_NULL( pucBuffer );
+            TEST_ASSERT_EQUAL_UINT32( xStats[ x ].ulBufferSize, ulBufferLength );
+
+            /* The whole buffer must be usable. */
+            memset( pucBuffer, 0xA5, ulBufferLength );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A request larger than the largest buffer fails.
+ */
+TEST( Full_BufferPool, AFQP_BUFFERPOOL_GetFreeBuffer_TooLarge )
+{
+    BufferPoolStats_t xStats[ testbufferpoolMAX_SIZE_CLASSES ];
+    uint32_t ulSizeClasses, ulBufferLength;
+
+    ulSizeClasses = prvGetAllStats( xStats );
+
+    ulBufferLength = xStats[ ulSizeClasses - 1 ].ulBufferSize + 1;
+    TEST_ASSERT_NULL( prvHoldBuffer( &ulBufferLength ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Once the best fitting size class is exhausted, requests are served
+ * from a larger one.
+ */
+TEST( Full_BufferPool, AFQP_BUFFERPOOL_GetFreeBuffer_FallBackToLargerClass )
+{
+    BufferPoolStats_t xStats[ testbufferpoolMAX_SIZE_CLASSES ];
+    uint32_t ulSizeClasses, ulBufferLength;
+    uint8_t * pucBuffer;
+
+    ulSizeClasses = prvGetAllStats( xStats );
+
+    if( ulSizeClasses > 1 )
+    {
+        /* Take the smallest buffers until a larger one is returned. */
+        do
+        {
+            ulBufferLength = 1;
+            pucBuffer = prvHoldBuffer( &ulBufferLength );
+            TEST_ASSERT_NOT_NULL( pucBuffer );
+        } while( ulBufferLength == xStats[ 0 ].ulBufferSize );
+
+        /* The next larger class must have served the last request and
+         * all the smallest buffers must be in use now. */
+        TEST_ASSERT_EQUAL_UINT32( xStats[ 1 ].ulBufferSize, ulBufferLength );
+        ( void ) BUFFERPOOL_GetStats( 0, &( xStats[ 0 ] ) );
+        TEST_ASSERT_EQUAL_UINT32( xStats[ 0 ].ulNumBuffers, xStats[ 0 ].ulInUse );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The statistics track the buffers in use, the high water mark and
+ * the failed requests.
+ */
+TEST( Full_BufferPool, AFQP_BUFFERPOOL_GetStats_HighWaterMark )
+{
+    BufferPoolStats_t xStats[ testbufferpoolMAX_SIZE_CLASSES ], xLargestStats;
+    uint32_t ulSizeClasses, ulLargest, ulBufferLength, ulTaken = 0;
+
+    ulSizeClasses = prvGetAllStats( xStats );
+    ulLargest = ulSizeClasses - 1;
+
+    /* Only the largest class can serve these requests - take all
+     * its buffers. */
+    for( ; ; )
+    {
+        ulBufferLength = xStats[ ulLargest ].ulBufferSize;
+
+        if( prvHoldBuffer( &ulBufferLength ) == NULL )
+        {
+            break;
+        }
+
+        ulTaken++;
+    }
+
+    TEST_ASSERT_EQUAL( pdPASS, BUFFERPOOL_GetStats( ulLargest, &xLargestStats ) );
+    TEST_ASSERT_EQUAL_UINT32( xLargestStats.ulNumBuffers, xLargestStats.ulInUse );
+    TEST_ASSERT_EQUAL_UINT32( xLargestStats.ulNumBuffers, xLargestStats.ulHighWaterMark );
+    TEST_ASSERT_EQUAL_UINT32( xStats[ ulLargest ].ulInUse + ulTaken, xLargestStats.ulInUse );
+    TEST_ASSERT_EQUAL_UINT32( xStats[ ulLargest ].ulFailedRequests + 1, xLargestStats.ulFailedRequests );
+
+    /* Returning the buffers lowers the in use count but not the
+     * high water mark. */
+    while( ulHeldBuffers > 0 )
+    {
+        ulHeldBuffers--;
+        BUFFERPOOL_ReturnBuffer( pucHeldBuffers[ ulHeldBuffers ] );
+    }
+
+    TEST_ASSERT_EQUAL( pdPASS, BUFFERPOOL_GetStats( ulLargest, &xLargestStats ) );
+    TEST_ASSERT_EQUAL_UINT32( xStats[ ulLargest ].ulInUse, xLargestStats.ulInUse );
+    TEST_ASSERT_EQUAL_UINT32( xLargestStats.ulNumBuffers, xLargestStats.ulHighWaterMark );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,536 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_checksum.c
+ * @brief Tests for the Internet checksum routines of FreeRTOS+TCP.
+ *
+ * usGenerateChecksum() and usGenerateChecksumCopy() are compared with a plain
+ * RFC 1071 sum for every length and alignment up to a few hundred bytes,
+ * whichever checksum backend is selected with ipconfigCHECKSUM_BACKEND. The
+ * stream buffer and protocol checksum functions that ipconfigUSE_CHECKSUM_COPY
+ * uses are checked against the same sum, and with the loopback network
+ * interface a stream of data is sent through a TCP connection and compared
+ * when it is received.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Stream_Buffer.h"
+
+/**
+ * @brief Longest data checked, and the largest misalignment of the data.
+ */
+#define testchecksumMAX_LENGTH          ( 300U )
+#define testchecksumMAX_OFFSET          ( 8U )
+
+/**
+ * @brief Size of the stream buffer used by the StreamBuffer test.
+ */
+#define testchecksumSTREAM_LENGTH       ( 64U )
+
+/**
+ * @brief Length of the payload of the packet built by the ProtocolChecksum
+ * test, odd so that the last 16-bit word is padded.
+ */
+#define testchecksumPAYLOAD_LENGTH      ( 101U )
+
+/**
+ * @brief Port, amount of data and largest send of the TCPTransfer test.
+ */
+#define testchecksumPORT                ( 7100U )
+#define testchecksumTRANSFER_LENGTH     ( 256U * 1024U )
+#define testchecksumMAX_SEND            ( 1537U )
+
+/**
+ * @brief Time to wait for the IP task and for the sending task.
+ */
+#define testchecksumTIMEOUT             pdMS_TO_TICKS( 5000 )
+#define testchecksumCLOSE_DELAY         pdMS_TO_TICKS( 100 )
+
+/**
+ * @brief Priority and stack size of the task that sends the data of the
+ * TCPTransfer test.
+ */
+#define testchecksumSENDER_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+#define testchecksumSENDER_STACK_SIZE   ( configMINIMAL_STACK_SIZE * 4 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The data that is added up, and the buffers it is copied to. The
+ * buffers are word aligned, and the tests add the misalignment.
+ */
+static uint32_t ulSource[ ( testchecksumMAX_LENGTH + testchecksumMAX_OFFSET + 3U ) / 4U ];
+static uint32_t ulTarget[ ( testchecksumMAX_LENGTH + testchecksumMAX_OFFSET + 3U ) / 4U + 1U ];
+
+/**
+ * @brief Space for a stream buffer with testchecksumSTREAM_LENGTH bytes.
+ */
+static union
+{
+    StreamBuffer_t xStream;
+    uint8_t ucBytes[ sizeof( StreamBuffer_t ) + testchecksumSTREAM_LENGTH ];
+} xStreamSpace;
+
+/**
+ * @brief The sockets of the TCPTransfer test, closed by the tear down.
+ */
+static Socket_t xListener, xClient, xChild;
+
+/**
+ * @brief The task sending the data of the TCPTransfer test, and the number
+ * of bytes it has sent.
+ */
+static TaskHandle_t xSender;
+static volatile uint32_t ulBytesSent;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The Internet checksum of the data as RFC 1071 describes it, i.e.
+ * the 16-bit words are big endian and the data starts at an even offset.
+ */
+static uint16_t prvReferenceChecksum( uint32_t ulSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength );
+
+/**
+ * @brief The byte at position ulPosition of the data sent by the TCPTransfer
+ * test.
+ */
+static uint8_t prvPattern( uint32_t ulPosition );
+
+/**
+ * @brief Fills ulSource with pseudo random bytes.
+ */
+static void prvFillSource( void );
+
+/**
+ * @brief Sends testchecksumTRANSFER_LENGTH bytes of the pattern through
+ * xClient, in sends of sizes that vary between 1 and testchecksumMAX_SEND.
+ */
+static void prvSenderTask( void * pvParameters );
+/*-----------------------------------------------------------*/
+
+static uint16_t prvReferenceChecksum( uint32_t ulSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength )
+{
+    size_t x;
+
+    for( x = 0; ( x + 1U ) < uxLength; x += 2U )
+    {
+        ulSum += ( ( uint32_t ) pucData[ x ] << 8 ) | pucData[ x + 1U ];
+    }
+
+    if( ( uxLength & 1U ) != 0U )
+    {
+        ulSum += ( uint32_t ) pucData[ uxLength - 1U ] << 8;
+    }
+
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xffffU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvPattern( uint32_t ulPosition )
+{
+    return ( uint8_t ) ( ( ulPosition * 7U ) + ( ulPosition >> 9 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillSource( void )
+{
+    uint8_t * pucSource = ( uint8_t * ) ulSource;
+    uint32_t x, ulValue = 0x12345678UL;
+
+    for( x = 0; x < sizeof( ulSource ); x++ )
+    {
+        ulValue = ( ulValue * 1103515245UL ) + 12345UL;
+        pucSource[ x ] = ( uint8_t ) ( ulValue >> 16 );
+    }
+
+    /* Runs of 0xff bytes give the most carries. */
+    memset( pucSource + 64, 0xff, 40 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void * pvParameters )
+{
+    uint8_t ucBuffer[ testchecksumMAX_SEND ];
+    uint32_t x, ulCount, ulSize = 1U;
+    BaseType_t xSent;
+
+    ( void ) pvParameters;
+
+    while( ulBytesSent < testchecksumTRANSFER_LENGTH )
+    {
+        /* Odd and even sizes, so that the data in the streams and in the
+         * packets starts at any alignment. */
+        ulSize = ( ( ulSize * 13U ) + 7U ) % testchecksumMAX_SEND + 1U;
+        ulCount = FreeRTOS_min_uint32( ulSize, testchecksumTRANSFER_LENGTH - ulBytesSent );
+
+        for( x = 0; x < ulCount; x++ )
+        {
+            ucBuffer[ x ] = prvPattern( ulBytesSent + x );
+        }
+
+        xSent = FreeRTOS_send( xClient, ucBuffer, ( size_t ) ulCount, 0 );
+
+        if( xSent <= 0 )
+        {
+            break;
+        }
+
+        /* A send may be cut short, the rest is sent again. */
+        ulBytesSent += ( uint32_t ) xSent;
+    }
+
+    xSender = NULL;
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Checksum );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Checksum )
+{
+    prvFillSource();
+    xListener = NULL;
+    xClient = NULL;
+    xChild = NULL;
+    xSender = NULL;
+    ulBytesSent = 0;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Checksum )
+{
+    if( xSender != NULL )
+    {
+        vTaskDelete( xSender );
+        xSender = NULL;
+    }
+
+    if( xChild != NULL )
+    {
+        ( void ) FreeRTOS_closesocket( xChild );
+    }
+
+    if( xClient != NULL )
+    {
+        ( void ) FreeRTOS_closesocket( xClient );
+    }
+
+    if( xListener != NULL )
+    {
+        ( void ) FreeRTOS_closesocket( xListener );
+    }
+
+    /* The IP task closes the sockets, and the idle task frees the sender. */
+    vTaskDelay( testchecksumCLOSE_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Checksum )
+{
+    RUN_TEST_CASE( Full_Checksum, Reference );
+    RUN_TEST_CASE( Full_Checksum, Chained );
+    RUN_TEST_CASE( Full_Checksum, Copy );
+    #if ( ipconfigUSE_CHECKSUM_COPY != 0 )
+        RUN_TEST_CASE( Full_Checksum, StreamBuffer );
+        RUN_TEST_CASE( Full_Checksum, ProtocolChecksum );
+    #endif
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        RUN_TEST_CASE( Full_Checksum, TCPTransfer );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Checksum, Reference )
+{
+    const uint8_t * pucSource;
+    size_t uxOffset, uxLength;
+
+    /* Data that starts at an odd address is still added up as if it started
+     * at an even offset. An initial sum is only carried over at an even
+     * address, as the sum of the data before it is then in the same byte
+     * order. */
+    for( uxOffset = 0; uxOffset < testchecksumMAX_OFFSET; uxOffset++ )
+    {
+        pucSource = ( const uint8_t * ) ulSource + uxOffset;
+
+        for( uxLength = 0; uxLength <= testchecksumMAX_LENGTH; uxLength++ )
+        {
+            TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0U, pucSource, uxLength ),
+                                     usGenerateChecksum( 0U, pucSource, uxLength ) );
+
+            if( ( uxOffset & 1U ) == 0U )
+            {
+                TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0x1234U, pucSource, uxLength ),
+                                         usGenerateChecksum( 0x1234U, pucSource, uxLength ) );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Checksum, Chained )
+{
+    const uint8_t * pucSource = ( const uint8_t * ) ulSource;
+    size_t uxFirst;
+    uint16_t usSum;
+
+    /* The sum of the first part is the initial sum of the second, when the
+     * first part has an even length. */
+    for( uxFirst = 0; uxFirst <= testchecksumMAX_LENGTH; uxFirst += 2U )
+    {
+        usSum = usGenerateChecksum( 0U, pucSource, uxFirst );
+        usSum = usGenerateChecksum( usSum, pucSource + uxFirst, testchecksumMAX_LENGTH - uxFirst );
+
+        TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0U, pucSource, testchecksumMAX_LENGTH ), usSum );
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Checksum, Copy )
+{
+    const uint8_t * pucSource;
+    uint8_t * pucTarget;
+    size_t uxSourceOffset, uxTargetOffset, uxLength;
+    uint16_t usSum;
+
+    for( uxSourceOffset = 0; uxSourceOffset < 4U; uxSourceOffset++ )
+    {
+        for( uxTargetOffset = 0; uxTargetOffset < 4U; uxTargetOffset++ )
+        {
+            pucSource = ( const uint8_t * ) ulSource + uxSourceOffset;
+            pucTarget = ( uint8_t * ) ulTarget + uxTargetOffset;
+
+            for( uxLength = 0; uxLength <= testchecksumMAX_LENGTH; uxLength++ )
+            {
+                memset( ulTarget, 0xa5, sizeof( ulTarget ) );
+
+                usSum = usGenerateChecksumCopy( 0x4321U, pucTarget, pucSource, uxLength );
+
+                /* The data is copied, nothing after it is written, and the
+                 * sum is the same as without the copy. */
+                TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0x4321U, pucSource, uxLength ), usSum );
+
+                if( uxLength > 0U )
+                {
+                    TEST_ASSERT_EQUAL_MEMORY( pucSource, pucTarget, uxLength );
+                }
+
+                TEST_ASSERT_EQUAL_HEX8( 0xa5, pucTarget[ uxLength ] );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_CHECKSUM_COPY != 0 )
+
+    TEST( Full_Checksum, StreamBuffer )
+    {
+        StreamBuffer_t * pxStream = &( xStreamSpace.xStream );
+        const uint8_t * pucSource = ( const uint8_t * ) ulSource;
+        uint8_t * pucTarget = ( uint8_t * ) ulTarget;
+        size_t uxStart, uxLength, uxCount;
+        uint16_t usSum;
+
+        /* Start the data at every position, so that it wraps around the end
+         * of the buffer after an odd and after an even number of bytes. */
+        for( uxStart = 0; uxStart < testchecksumSTREAM_LENGTH; uxStart++ )
+        {
+            for( uxLength = 1; uxLength < testchecksumSTREAM_LENGTH; uxLength += 3U )
+            {
+                memset( pxStream, 0x00, sizeof( xStreamSpace ) );
+                pxStream->LENGTH = testchecksumSTREAM_LENGTH;
+                pxStream->uxHead = uxStart;
+                pxStream->uxTail = uxStart;
+                pxStream->uxMid = uxStart;
+                pxStream->uxFront = uxStart;
+
+                /* Staged data is not in the buffer until it is added. */
+                uxCount = uxStreamBufferStage( pxStream, pucSource, uxLength, &usSum );
+                TEST_ASSERT_EQUAL( uxLength, uxCount );
+                TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0U, pucSource, uxLength ), usSum );
+                TEST_ASSERT_EQUAL( 0U, uxStreamBufferGetSize( pxStream ) );
+                TEST_ASSERT_EQUAL( uxStart, pxStream->uxFront );
+
+                TEST_ASSERT_EQUAL( uxLength, uxStreamBufferAdd( pxStream, 0U, NULL, uxLength ) );
+                TEST_ASSERT_EQUAL( uxLength, uxStreamBufferGetSize( pxStream ) );
+
+                /* Reading it back from an offset gives the sum of the rest. */
+                memset( ulTarget, 0x00, sizeof( ulTarget ) );
+                uxCount = uxStreamBufferPeekChecksum( pxStream, 1U, pucTarget, uxLength, &usSum );
+                TEST_ASSERT_EQUAL( uxLength - 1U, uxCount );
+
+                if( uxCount > 0U )
+                {
+                    TEST_ASSERT_EQUAL_MEMORY( pucSource + 1, pucTarget, uxCount );
+                }
+
+                TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0U, pucSource + 1, uxCount ), usSum );
+                TEST_ASSERT_EQUAL( uxLength, uxStreamBufferGetSize( pxStream ) );
+            }
+        }
+
+        /* No more than the free space is staged. */
+        memset( pxStream, 0x00, sizeof( xStreamSpace ) );
+        pxStream->LENGTH = testchecksumSTREAM_LENGTH;
+        TEST_ASSERT_EQUAL( testchecksumSTREAM_LENGTH - 1U, uxStreamBufferStage( pxStream, pucSource, testchecksumSTREAM_LENGTH, &usSum ) );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_Checksum, ProtocolChecksum )
+    {
+        TCPPacket_t * pxPacket;
+        uint8_t * pucPayload;
+        size_t uxLength = sizeof( TCPPacket_t ) + testchecksumPAYLOAD_LENGTH;
+        uint16_t usSum, usFullChecksum;
+
+        /* Build a TCP packet, with the IP header at an address that is a
+         * multiple of 4 like in a network buffer. */
+        memset( ulTarget, 0x00, sizeof( ulTarget ) );
+        pxPacket = ( TCPPacket_t * ) ( ( uint8_t * ) ulTarget + 2 );
+        pucPayload = ( uint8_t * ) pxPacket + sizeof( TCPPacket_t );
+
+        pxPacket->xIPHeader.ucVersionHeaderLength = 0x45U;
+        pxPacket->xIPHeader.usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + testchecksumPAYLOAD_LENGTH );
+        pxPacket->xIPHeader.ucProtocol = ( uint8_t ) ipPROTOCOL_TCP;
+        pxPacket->xIPHeader.ulSourceIPAddress = FreeRTOS_inet_addr_quick( 192, 168, 0, 10 );
+        pxPacket->xIPHeader.ulDestinationIPAddress = FreeRTOS_inet_addr_quick( 192, 168, 0, 200 );
+        pxPacket->xTCPHeader.usSourcePort = FreeRTOS_htons( testchecksumPORT );
+        pxPacket->xTCPHeader.usDestinationPort = FreeRTOS_htons( testchecksumPORT + 1U );
+        pxPacket->xTCPHeader.ucTCPOffset = ( uint8_t ) ( ipSIZE_OF_TCP_HEADER << 2 );
+        pxPacket->xTCPHeader.ucTCPFlags = 0x10U; /* ACK */
+
+        /* The payload is added up while it is copied into the packet, and the
+         * checksum is the same as when the whole packet is added up. */
+        usSum = usGenerateChecksumCopy( 0U, pucPayload, ( const uint8_t * ) ulSource, testchecksumPAYLOAD_LENGTH );
+
+        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxPacket, uxLength, pdTRUE );
+        usFullChecksum = pxPacket->xTCPHeader.usChecksum;
+        TEST_ASSERT_NOT_EQUAL( 0U, usFullChecksum );
+
+        ( void ) usGenerateProtocolChecksumPartial( ( uint8_t * ) pxPacket, uxLength, pdTRUE, testchecksumPAYLOAD_LENGTH, usSum );
+        TEST_ASSERT_EQUAL_HEX16( usFullChecksum, pxPacket->xTCPHeader.usChecksum );
+
+        /* The received packet is accepted, unless its payload is damaged. */
+        TEST_ASSERT_EQUAL_HEX16( ipCORRECT_CRC, usGenerateProtocolChecksumPartial( ( uint8_t * ) pxPacket, uxLength, pdFALSE, testchecksumPAYLOAD_LENGTH, usSum ) );
+
+        pucPayload[ 10 ] ^= 0x01U;
+        usSum = usGenerateChecksum( 0U, pucPayload, testchecksumPAYLOAD_LENGTH );
+        TEST_ASSERT_NOT_EQUAL( ipCORRECT_CRC, usGenerateProtocolChecksumPartial( ( uint8_t * ) pxPacket, uxLength, pdFALSE, testchecksumPAYLOAD_LENGTH, usSum ) );
+        TEST_ASSERT_NOT_EQUAL( ipCORRECT_CRC, usGenerateProtocolChecksum( ( uint8_t * ) pxPacket, uxLength, pdFALSE ) );
+
+        /* A payload longer than the packet is refused. */
+        TEST_ASSERT_NOT_EQUAL( ipCORRECT_CRC, usGenerateProtocolChecksumPartial( ( uint8_t * ) pxPacket, uxLength, pdFALSE, uxLength, usSum ) );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_CHECKSUM_COPY */
+
+#if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+    TEST( Full_Checksum, TCPTransfer )
+    {
+        struct freertos_sockaddr xAddress;
+        socklen_t xSize = sizeof( xAddress );
+        TickType_t xTimeout = testchecksumTIMEOUT;
+        uint8_t ucBuffer[ 997 ];
+        uint32_t x, ulReceived = 0;
+        BaseType_t xCount;
+
+        xListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xListener );
+        memset( &xAddress, 0x00, sizeof( xAddress ) );
+        xAddress.sin_port = FreeRTOS_htons( testchecksumPORT );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_bind( xListener, &xAddress, sizeof( xAddress ) ) );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xListener, 1 ) );
+
+        /* Connect to the listening socket of this node. */
+        xClient = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xClient );
+        ( void ) FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_SNDTIMEO, &xTimeout, sizeof( xTimeout ) );
+        xAddress.sin_addr = FreeRTOS_GetIPAddress();
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_connect( xClient, &xAddress, sizeof( xAddress ) ) );
+
+        xChild = FreeRTOS_accept( xListener, &xAddress, &xSize );
+        TEST_ASSERT_NOT_NULL( xChild );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xChild );
+        ( void ) FreeRTOS_setsockopt( xChild, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+
+        TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvSenderTask, "CsumSend", testchecksumSENDER_STACK_SIZE, NULL, testchecksumSENDER_PRIORITY, &xSender ) );
+
+        /* Every byte arrives, in order and undamaged, through packets that
+         * have been added up while they were copied. */
+        while( ulReceived < testchecksumTRANSFER_LENGTH )
+        {
+            xCount = FreeRTOS_recv( xChild, ucBuffer, sizeof( ucBuffer ), 0 );
+            TEST_ASSERT_GREATER_THAN( 0, xCount );
+
+            for( x = 0; x < ( uint32_t ) xCount; x++ )
+            {
+                TEST_ASSERT_EQUAL_HEX8( prvPattern( ulReceived + x ), ucBuffer[ x ] );
+            }
+
+            ulReceived += ( uint32_t ) xCount;
+        }
+
+        TEST_ASSERT_EQUAL( testchecksumTRANSFER_LENGTH, ulReceived );
+        TEST_ASSERT_EQUAL( testchecksumTRANSFER_LENGTH, ulBytesSent );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
@@ -0,0 +1,274 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_socket_lookup.c
+ * @brief Tests for finding the socket that a received packet is for.
+ *
+ * A UDP socket is found by its local port. A TCP socket that is connected,
+ * or connecting, is found by its local port and the remote IP address and
+ * port, and a listening TCP socket is found by its local port when no other
+ * socket matches. The tests check that the lookups follow the sockets as they
+ * are bound, connected and closed, whether or not ipconfigUSE_SOCKET_HASH is
+ * enabled. The connection test only runs with the loopback network interface,
+ * where the node can connect to itself.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+
+/**
+ * @brief The first local port used by the tests.
+ */
+#define testsocketlookupPORT          ( 7000U )
+
+/**
+ * @brief Number of UDP sockets bound by the UDPLookup test.
+ */
+#define testsocketlookupUDP_SOCKETS   ( 8U )
+
+/**
+ * @brief A remote IP address and port that no socket is connected to, in host
+ * order.
+ */
+#define testsocketlookupOTHER_IP      ( 0x0A0B0C0DUL )
+#define testsocketlookupOTHER_PORT    ( 4321U )
+
+/**
+ * @brief Time to wait for the IP task to connect, accept and close sockets.
+ */
+#define testsocketlookupTIMEOUT       pdMS_TO_TICKS( 2000 )
+#define testsocketlookupCLOSE_DELAY   pdMS_TO_TICKS( 100 )
+
+/**
+ * @brief Number of sockets the tests may have open at the same time.
+ */
+#define testsocketlookupMAX_SOCKETS   ( testsocketlookupUDP_SOCKETS + 3U )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The sockets opened by the current test, closed by the tear down.
+ */
+static Socket_t xSockets[ testsocketlookupMAX_SOCKETS ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Opens a socket of the given type, and binds it to usPort unless it
+ * is 0.
+ */
+static Socket_t prvOpen( uint32_t ulIndex,
+                         BaseType_t xType,
+                         BaseType_t xProtocol,
+                         uint16_t usPort );
+
+/**
+ * @brief Closes all the sockets and lets the IP task free them.
+ */
+static void prvCloseAll( void );
+/*-----------------------------------------------------------*/
+
+static Socket_t prvOpen( uint32_t ulIndex,
+                         BaseType_t xType,
+                         BaseType_t xProtocol,
+                         uint16_t usPort )
+{
+    struct freertos_sockaddr xAddress;
+    TickType_t xTimeout = testsocketlookupTIMEOUT;
+    Socket_t xSocket;
+
+    xSocket = FreeRTOS_socket( FREERTOS_AF_INET, xType, xProtocol );
+    TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xSocket );
+    xSockets[ ulIndex ] = xSocket;
+
+    ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+    ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_SNDTIMEO, &xTimeout, sizeof( xTimeout ) );
+
+    if( usPort != 0U )
+    {
+        memset( &xAddress, 0x00, sizeof( xAddress ) );
+        xAddress.sin_port = FreeRTOS_htons( usPort );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_bind( xSocket, &xAddress, sizeof( xAddress ) ) );
+    }
+
+    return xSocket;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCloseAll( void )
+{
+    uint32_t x;
+
+    for( x = 0; x < testsocketlookupMAX_SOCKETS; x++ )
+    {
+        if( xSockets[ x ] != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xSockets[ x ] );
+            xSockets[ x ] = NULL;
+        }
+    }
+
+    /* The IP task closes the sockets. */
+    vTaskDelay( testsocketlookupCLOSE_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Socket_Lookup );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Socket_Lookup )
+{
+    memset( xSockets, 0x00, sizeof( xSockets ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Socket_Lookup )
+{
+    prvCloseAll();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Socket_Lookup )
+{
+    RUN_TEST_CASE( Full_Socket_Lookup, UDPLookup );
+    RUN_TEST_CASE( Full_Socket_Lookup, TCPListenerLookup );
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        RUN_TEST_CASE( Full_Socket_Lookup, TCPConnectionLookup );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Socket_Lookup, UDPLookup )
+{
+    uint32_t x;
+
+    for( x = 0; x < testsocketlookupUDP_SOCKETS; x++ )
+    {
+        ( void ) prvOpen( x, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP, ( uint16_t ) ( testsocketlookupPORT + x ) );
+    }
+
+    /* Every socket is found by its own port, and no socket by another port. */
+    for( x = 0; x < testsocketlookupUDP_SOCKETS; x++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( xSockets[ x ], pxUDPSocketLookup( FreeRTOS_htons( testsocketlookupPORT + x ) ) );
+    }
+
+    TEST_ASSERT_NULL( pxUDPSocketLookup( FreeRTOS_htons( testsocketlookupPORT + testsocketlookupUDP_SOCKETS ) ) );
+
+    /* A closed socket is not found any more. */
+    ( void ) FreeRTOS_closesocket( xSockets[ 0 ] );
+    xSockets[ 0 ] = NULL;
+    vTaskDelay( testsocketlookupCLOSE_DELAY );
+
+    TEST_ASSERT_NULL( pxUDPSocketLookup( FreeRTOS_htons( testsocketlookupPORT ) ) );
+    TEST_ASSERT_EQUAL_PTR( xSockets[ 1 ], pxUDPSocketLookup( FreeRTOS_htons( testsocketlookupPORT + 1U ) ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Socket_Lookup, TCPListenerLookup )
+{
+    Socket_t xListener, xBound;
+
+    xListener = prvOpen( 0, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP, testsocketlookupPORT );
+    xBound = prvOpen( 1, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP, testsocketlookupPORT + 1U );
+
+    /* A bound socket that does not listen only matches its own, unset, peer. */
+    TEST_ASSERT_EQUAL_PTR( xBound, pxTCPSocketLookup( 0, testsocketlookupPORT + 1U, 0, 0 ) );
+    TEST_ASSERT_NULL( pxTCPSocketLookup( 0, testsocketlookupPORT + 1U, testsocketlookupOTHER_IP, testsocketlookupOTHER_PORT ) );
+    TEST_ASSERT_NULL( pxTCPSocketLookup( 0, testsocketlookupPORT, testsocketlookupOTHER_IP, testsocketlookupOTHER_PORT ) );
+
+    /* Once it listens, a socket matches any peer. */
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xListener, 1 ) );
+    TEST_ASSERT_EQUAL_PTR( xListener, pxTCPSocketLookup( 0, testsocketlookupPORT, testsocketlookupOTHER_IP, testsocketlookupOTHER_PORT ) );
+    TEST_ASSERT_NULL( pxTCPSocketLookup( 0, testsocketlookupPORT + 2U, testsocketlookupOTHER_IP, testsocketlookupOTHER_PORT ) );
+
+    /* A closed socket is not found any more. */
+    ( void ) FreeRTOS_closesocket( xListener );
+    xSockets[ 0 ] = NULL;
+    vTaskDelay( testsocketlookupCLOSE_DELAY );
+
+    TEST_ASSERT_NULL( pxTCPSocketLookup( 0, testsocketlookupPORT, testsocketlookupOTHER_IP, testsocketlookupOTHER_PORT ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+    TEST( Full_Socket_Lookup, TCPConnectionLookup )
+    {
+        Socket_t xListener, xClient, xChild;
+        struct freertos_sockaddr xAddress;
+        socklen_t xSize = sizeof( xAddress );
+        uint32_t ulIPAddress = FreeRTOS_ntohl( FreeRTOS_GetIPAddress() );
+        uint16_t usClientPort;
+
+        xListener = prvOpen( 0, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP, testsocketlookupPORT );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xListener, 1 ) );
+
+        /* Connect to the listening socket of this node. */
+        xClient = prvOpen( 1, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP, 0 );
+        memset( &xAddress, 0x00, sizeof( xAddress ) );
+        xAddress.sin_addr = FreeRTOS_GetIPAddress();
+        xAddress.sin_port = FreeRTOS_htons( testsocketlookupPORT );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_connect( xClient, &xAddress, sizeof( xAddress ) ) );
+
+        xChild = FreeRTOS_accept( xListener, &xAddress, &xSize );
+        TEST_ASSERT_NOT_NULL( xChild );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xChild );
+        xSockets[ 2 ] = xChild;
+
+        ( void ) FreeRTOS_GetLocalAddress( xClient, &xAddress );
+        usClientPort = FreeRTOS_ntohs( xAddress.sin_port );
+
+        /* Each end of the connection is found by its peer, and the listening
+         * socket by any other peer. */
+        TEST_ASSERT_EQUAL_PTR( xChild, pxTCPSocketLookup( 0, testsocketlookupPORT, ulIPAddress, usClientPort ) );
+        TEST_ASSERT_EQUAL_PTR( xClient, pxTCPSocketLookup( 0, usClientPort, ulIPAddress, testsocketlookupPORT ) );
+        TEST_ASSERT_EQUAL_PTR( xListener, pxTCPSocketLookup( 0, testsocketlookupPORT, ulIPAddress, usClientPort + 1U ) );
+        TEST_ASSERT_NULL( pxTCPSocketLookup( 0, usClientPort, ulIPAddress, testsocketlookupPORT + 1U ) );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
@@ -0,0 +1,535 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_tcp_congestion.c
+ * @brief Tests for the TCP congestion control of FreeRTOS+TCP.
+ *
+ * The NewReno and CUBIC algorithms are driven directly on a TCP window, to
+ * check the initial window, the reduction after a loss and the growth in
+ * congestion avoidance. With the loopback network interface, data is also sent
+ * through a TCP connection that drops some of its frames, with each algorithm,
+ * and compared when it is received.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_TCP_WIN.h"
+
+#if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+/**
+ * @brief MSS of the windows that are driven directly.
+ */
+    #define testcongestionMSS                ( 1460U )
+
+/**
+ * @brief Round trip time of the windows that are driven directly, in ms.
+ */
+    #define testcongestionRTT_MS             ( 100 )
+
+/**
+ * @brief Port of the listening socket, the amount of data sent through the
+ * lossy connection and the loss rate in frames per 1000.
+ */
+    #define testcongestionPORT               ( 7200U )
+    #define testcongestionTRANSFER_LENGTH    ( 512U * 1024U )
+    #define testcongestionLOSS_PER_MILLE     ( 20U )
+
+/**
+ * @brief Size of the windows of the lossy connection in segments, large
+ * enough for losses to be repaired by fast retransmissions.
+ */
+    #define testcongestionWINDOW_SEGMENTS    ( 16 )
+
+/**
+ * @brief Time to wait for the connection, and for the IP task to close the
+ * sockets.
+ */
+    #define testcongestionTIMEOUT            pdMS_TO_TICKS( 5000 )
+    #define testcongestionCLOSE_DELAY        pdMS_TO_TICKS( 100 )
+
+/**
+ * @brief Priority and stack size of the task that sends the data.
+ */
+    #define testcongestionSENDER_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+    #define testcongestionSENDER_STACK_SIZE  ( configMINIMAL_STACK_SIZE * 4 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The window driven directly by the tests.
+ */
+    static TCPWindow_t xWindow;
+
+/**
+ * @brief The sockets of the lossy connection, and the task that sends the
+ * data.
+ */
+    static Socket_t xListener, xClient, xChild;
+    static TaskHandle_t xSender;
+    static volatile uint32_t ulBytesSent;
+
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        extern void vNetworkInterfaceSetLoopbackImpairment( uint32_t ulLossPerMille,
+                                                             TickType_t xDelay );
+    #endif
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Clears xWindow and initialises it with the given MSS.
+ */
+    static void prvInitWindow( uint32_t ulMSS );
+
+/**
+ * @brief Acknowledges a congestion window of data, one MSS at a time, at time
+ * ulTimeMS.
+ */
+    static void prvAckRoundTrip( uint32_t ulTimeMS );
+
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+/**
+ * @brief The byte expected at a position of the transferred data.
+ */
+        static uint8_t prvPattern( uint32_t ulPosition );
+
+/**
+ * @brief Sends testcongestionTRANSFER_LENGTH bytes from xClient.
+ */
+        static void prvSenderTask( void * pvParameters );
+
+/**
+ * @brief Sends data through a connection that loses frames, using the given
+ * algorithm, and checks that it all arrives and that the sender reduced its
+ * window.
+ */
+        static void prvLossyTransfer( BaseType_t xAlgorithm );
+
+    #endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
+/*-----------------------------------------------------------*/
+
+    static void prvInitWindow( uint32_t ulMSS )
+    {
+        memset( &xWindow, 0x00, sizeof( xWindow ) );
+        vTCPWindowInit( &xWindow, 0U, 1000U, ulMSS );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAckRoundTrip( uint32_t ulTimeMS )
+    {
+        uint32_t x, ulSegments = xWindow.ulCongestionWindow / testcongestionMSS;
+
+        for( x = 0; x < ulSegments; x++ )
+        {
+            xWindow.pxCongestionControl->pxCongestionAvoidance( &xWindow, testcongestionMSS, ulTimeMS );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+        static uint8_t prvPattern( uint32_t ulPosition )
+        {
+            return ( uint8_t ) ( ( ulPosition * 7U ) ^ ( ulPosition >> 11 ) );
+        }
+    /*-----------------------------------------------------------*/
+
+        static void prvSenderTask( void * pvParameters )
+        {
+            uint8_t ucBuffer[ 1024 ];
+            uint32_t x, ulCount;
+            BaseType_t xSent;
+
+            ( void ) pvParameters;
+
+            while( ulBytesSent < testcongestionTRANSFER_LENGTH )
+            {
+                ulCount = FreeRTOS_min_uint32( sizeof( ucBuffer ), testcongestionTRANSFER_LENGTH - ulBytesSent );
+
+                for( x = 0; x < ulCount; x++ )
+                {
+                    ucBuffer[ x ] = prvPattern( ulBytesSent + x );
+                }
+
+                xSent = FreeRTOS_send( xClient, ucBuffer, ( size_t ) ulCount, 0 );
+
+                if( xSent <= 0 )
+                {
+                    break;
+                }
+
+                /* A send may be cut short, the rest is sent again. */
+                ulBytesSent += ( uint32_t ) xSent;
+            }
+
+            xSender = NULL;
+            vTaskDelete( NULL );
+        }
+    /*-----------------------------------------------------------*/
+
+        static void prvLossyTransfer( BaseType_t xAlgorithm )
+        {
+            struct freertos_sockaddr xAddress;
+            socklen_t xSize = sizeof( xAddress );
+            TickType_t xTimeout = testcongestionTIMEOUT;
+            uint8_t ucBuffer[ 997 ];
+            uint32_t x, ulReceived = 0;
+            BaseType_t xCount;
+            const TCPWindow_t * pxClientWindow;
+            WinProperties_t xProperties;
+
+            xProperties.lTxBufSize = 2 * testcongestionWINDOW_SEGMENTS * ipconfigTCP_MSS;
+            xProperties.lTxWinSize = testcongestionWINDOW_SEGMENTS;
+            xProperties.lRxBufSize = 2 * testcongestionWINDOW_SEGMENTS * ipconfigTCP_MSS;
+            xProperties.lRxWinSize = testcongestionWINDOW_SEGMENTS;
+
+            xListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+            TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xListener );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xListener, 0, FREERTOS_SO_WIN_PROPERTIES, &xProperties, sizeof( xProperties ) ) );
+            memset( &xAddress, 0x00, sizeof( xAddress ) );
+            xAddress.sin_port = FreeRTOS_htons( testcongestionPORT );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_bind( xListener, &xAddress, sizeof( xAddress ) ) );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xListener, 1 ) );
+
+            xClient = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+            TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xClient );
+            ( void ) FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_SNDTIMEO, &xTimeout, sizeof( xTimeout ) );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_WIN_PROPERTIES, &xProperties, sizeof( xProperties ) ) );
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_TCP_CONGESTION, &xAlgorithm, sizeof( xAlgorithm ) ) );
+            xAddress.sin_addr = FreeRTOS_GetIPAddress();
+            TEST_ASSERT_EQUAL( 0, FreeRTOS_connect( xClient, &xAddress, sizeof( xAddress ) ) );
+
+            xChild = FreeRTOS_accept( xListener, &xAddress, &xSize );
+            TEST_ASSERT_NOT_NULL( xChild );
+            TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xChild );
+            ( void ) FreeRTOS_setsockopt( xChild, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+
+            /* The connection is set up, from now on frames are lost. */
+            pxClientWindow = &( ( ( FreeRTOS_Socket_t * ) xClient )->u.xTCP.xTCPWindow );
+            TEST_ASSERT_EQUAL( xAlgorithm, pxClientWindow->pxCongestionControl->xAlgorithm );
+            vNetworkInterfaceSetLoopbackImpairment( testcongestionLOSS_PER_MILLE, 0 );
+
+            TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvSenderTask, "CongSend", testcongestionSENDER_STACK_SIZE, NULL, testcongestionSENDER_PRIORITY, &xSender ) );
+
+            /* Every byte arrives, in order, in spite of the losses. */
+            while( ulReceived < testcongestionTRANSFER_LENGTH )
+            {
+                xCount = FreeRTOS_recv( xChild, ucBuffer, sizeof( ucBuffer ), 0 );
+                TEST_ASSERT_GREATER_THAN( 0, xCount );
+
+                for( x = 0; x < ( uint32_t ) xCount; x++ )
+                {
+                    TEST_ASSERT_EQUAL_HEX8( prvPattern( ulReceived + x ), ucBuffer[ x ] );
+                }
+
+                ulReceived += ( uint32_t ) xCount;
+            }
+
+            TEST_ASSERT_EQUAL( testcongestionTRANSFER_LENGTH, ulReceived );
+
+            /* The losses made the sender leave slow start. */
+            TEST_ASSERT_NOT_EQUAL( 0xFFFFFFFFUL, pxClientWindow->ulSlowStartThreshold );
+        }
+    /*-----------------------------------------------------------*/
+
+    #endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
+
+/* Define Test Group. */
+TEST_GROUP( Full_TCP_Congestion );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_TCP_Congestion )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        xListener = NULL;
+        xClient = NULL;
+        xChild = NULL;
+        xSender = NULL;
+        ulBytesSent = 0;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_TCP_Congestion )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+            vNetworkInterfaceSetLoopbackImpairment( 0, 0 );
+        #endif
+
+        if( xSender != NULL )
+        {
+            vTaskDelete( xSender );
+            xSender = NULL;
+        }
+
+        if( xChild != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xChild );
+        }
+
+        if( xClient != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xClient );
+        }
+
+        if( xListener != NULL )
+        {
+            ( void ) FreeRTOS_closesocket( xListener );
+        }
+
+        /* The IP task closes the sockets, and the idle task frees the sender. */
+        vTaskDelay( testcongestionCLOSE_DELAY );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_TCP_Congestion )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+        RUN_TEST_CASE( Full_TCP_Congestion, InitialWindow );
+        RUN_TEST_CASE( Full_TCP_Congestion, SelectAlgorithm );
+        RUN_TEST_CASE( Full_TCP_Congestion, NewRenoThreshold );
+        RUN_TEST_CASE( Full_TCP_Congestion, NewRenoAvoidance );
+        RUN_TEST_CASE( Full_TCP_Congestion, CubicThreshold );
+        RUN_TEST_CASE( Full_TCP_Congestion, CubicAvoidance );
+        RUN_TEST_CASE( Full_TCP_Congestion, SocketOption );
+        #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+            RUN_TEST_CASE( Full_TCP_Congestion, LossyTransferNewReno );
+            RUN_TEST_CASE( Full_TCP_Congestion, LossyTransferCubic );
+        #endif
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 ) && ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+
+    TEST( Full_TCP_Congestion, InitialWindow )
+    {
+        /* 4, 3 or 2 segments, depending on the MSS (RFC 5681). */
+        prvInitWindow( 536U );
+        TEST_ASSERT_EQUAL_UINT32( 4U * 536U, xWindow.ulCongestionWindow );
+        prvInitWindow( 1460U );
+        TEST_ASSERT_EQUAL_UINT32( 3U * 1460U, xWindow.ulCongestionWindow );
+        prvInitWindow( 4000U );
+        TEST_ASSERT_EQUAL_UINT32( 2U * 4000U, xWindow.ulCongestionWindow );
+
+        /* Slow start, with the default algorithm. */
+        TEST_ASSERT_EQUAL_UINT32( 0xFFFFFFFFUL, xWindow.ulSlowStartThreshold );
+        TEST_ASSERT_NOT_NULL( xWindow.pxCongestionControl );
+        TEST_ASSERT_EQUAL( ipconfigTCP_CONGESTION_CONTROL, xWindow.pxCongestionControl->xAlgorithm );
+        TEST_ASSERT_EQUAL( pdFALSE_UNSIGNED, xWindow.u.bits.bFastRecovery );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion, SelectAlgorithm )
+    {
+        prvInitWindow( testcongestionMSS );
+
+        TEST_ASSERT_EQUAL( pdPASS, xTCPWindowSetCongestionControl( &xWindow, FREERTOS_TCP_CONGESTION_CUBIC ) );
+        TEST_ASSERT_EQUAL( FREERTOS_TCP_CONGESTION_CUBIC, xWindow.pxCongestionControl->xAlgorithm );
+
+        /* An unknown algorithm leaves the current one in place. */
+        TEST_ASSERT_EQUAL( pdFAIL, xTCPWindowSetCongestionControl( &xWindow, 7 ) );
+        TEST_ASSERT_EQUAL( FREERTOS_TCP_CONGESTION_CUBIC, xWindow.pxCongestionControl->xAlgorithm );
+
+        TEST_ASSERT_EQUAL( pdPASS, xTCPWindowSetCongestionControl( &xWindow, FREERTOS_TCP_CONGESTION_NEWRENO ) );
+        TEST_ASSERT_EQUAL( FREERTOS_TCP_CONGESTION_NEWRENO, xWindow.pxCongestionControl->xAlgorithm );
+
+        /* The choice survives a new connection on the same window. */
+        vTCPWindowInit( &xWindow, 0U, 5000U, testcongestionMSS );
+        TEST_ASSERT_EQUAL( FREERTOS_TCP_CONGESTION_NEWRENO, xWindow.pxCongestionControl->xAlgorithm );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion, NewRenoThreshold )
+    {
+        prvInitWindow( testcongestionMSS );
+        TEST_ASSERT_EQUAL( pdPASS, xTCPWindowSetCongestionControl( &xWindow, FREERTOS_TCP_CONGESTION_NEWRENO ) );
+
+        /* Half of the data in flight... */
+        xWindow.tx.ulHighestSequenceNumber = xWindow.tx.ulCurrentSequenceNumber + ( 20U * testcongestionMSS );
+        TEST_ASSERT_EQUAL_UINT32( 10U * testcongestionMSS, xWindow.pxCongestionControl->pxSlowStartThreshold( &xWindow ) );
+
+        /* ...but at least 2 segments. */
+        xWindow.tx.ulHighestSequenceNumber = xWindow.tx.ulCurrentSequenceNumber + testcongestionMSS;
+        TEST_ASSERT_EQUAL_UINT32( 2U * testcongestionMSS, xWindow.pxCongestionControl->pxSlowStartThreshold( &xWindow ) );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion, NewRenoAvoidance )
+    {
+        uint32_t x;
+
+        prvInitWindow( testcongestionMSS );
+        TEST_ASSERT_EQUAL( pdPASS, xTCPWindowSetCongestionControl( &xWindow, FREERTOS_TCP_CONGESTION_NEWRENO ) );
+        xWindow.ulCongestionWindow = 10U * testcongestionMSS;
+
+        /* One segment more once a whole window has been acknowledged. */
+        for( x = 0; x < 9U; x++ )
+        {
+            xWindow.pxCongestionControl->pxCongestionAvoidance( &xWindow, testcongestionMSS, 0U );
+            TEST_ASSERT_EQUAL_UINT32( 10U * testcongestionMSS, xWindow.ulCongestionWindow );
+        }
+
+        xWindow.pxCongestionControl->pxCongestionAvoidance( &xWindow, testcongestionMSS, 0U );
+        TEST_ASSERT_EQUAL_UINT32( 11U * testcongestionMSS, xWindow.ulCongestionWindow );
+        TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulAckedBytes );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion, CubicThreshold )
+    {
+        prvInitWindow( testcongestionMSS );
+        TEST_ASSERT_EQUAL( pdPASS, xTCPWindowSetCongestionControl( &xWindow, FREERTOS_TCP_CONGESTION_CUBIC ) );
+
+        /* The window is multiplied by 0.7, and remembered as the maximum. */
+        xWindow.ulCongestionWindow = 100U * testcongestionMSS;
+        TEST_ASSERT_EQUAL_UINT32( 70U * testcongestionMSS, xWindow.pxCongestionControl->pxSlowStartThreshold( &xWindow ) );
+        TEST_ASSERT_EQUAL_UINT32( 100U * testcongestionMSS, xWindow.xCubic.ulMaxWindow );
+        TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.xCubic.ulEpochStart );
+
+        /* Fast convergence: a loss below the previous maximum lowers the
+         * plateau to 0.85 of the window. */
+        xWindow.ulCongestionWindow = 80U * testcongestionMSS;
+        TEST_ASSERT_EQUAL_UINT32( 56U * testcongestionMSS, xWindow.pxCongestionControl->pxSlowStartThreshold( &xWindow ) );
+        TEST_ASSERT_EQUAL_UINT32( 68U * testcongestionMSS, xWindow.xCubic.ulMaxWindow );
+        TEST_ASSERT_EQUAL_UINT32( 80U * testcongestionMSS, xWindow.xCubic.ulLastMaxWindow );
+
+        /* At least 2 segments. */
+        xWindow.ulCongestionWindow = testcongestionMSS;
+        TEST_ASSERT_EQUAL_UINT32( 2U * testcongestionMSS, xWindow.pxCongestionControl->pxSlowStartThreshold( &xWindow ) );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion, CubicAvoidance )
+    {
+        uint32_t ulTimeMS, ulAfterOneSecond = 0U, ulBeforePlateau = 0U, ulAtPlateau = 0U;
+
+        prvInitWindow( testcongestionMSS );
+        TEST_ASSERT_EQUAL( pdPASS, xTCPWindowSetCongestionControl( &xWindow, FREERTOS_TCP_CONGESTION_CUBIC ) );
+        xWindow.lSRTT = testcongestionRTT_MS;
+
+        /* A loss at 100 segments. */
+        xWindow.ulCongestionWindow = 100U * testcongestionMSS;
+        xWindow.ulSlowStartThreshold = xWindow.pxCongestionControl->pxSlowStartThreshold( &xWindow );
+        xWindow.ulCongestionWindow = xWindow.ulSlowStartThreshold;
+
+        /* The plateau is reached after K = cbrt( 30 / 0.4 ) = 4.2 seconds. */
+        for( ulTimeMS = 0U; ulTimeMS <= 8000U; ulTimeMS += testcongestionRTT_MS )
+        {
+            prvAckRoundTrip( 1000U + ulTimeMS );
+
+            if( ulTimeMS == 1000U )
+            {
+                ulAfterOneSecond = xWindow.ulCongestionWindow;
+            }
+            else if( ulTimeMS == 3000U )
+            {
+                ulBeforePlateau = xWindow.ulCongestionWindow;
+            }
+            else if( ulTimeMS == 4200U )
+            {
+                ulAtPlateau = xWindow.ulCongestionWindow;
+            }
+        }
+
+        TEST_ASSERT_UINT32_WITHIN( 5U, 4217U, xWindow.xCubic.ulPlateauTime );
+
+        /* Concave: fast growth at first, slowing down towards the maximum. */
+        TEST_ASSERT_GREATER_THAN_UINT32( 80U * testcongestionMSS, ulAfterOneSecond );
+        TEST_ASSERT_LESS_THAN_UINT32( 95U * testcongestionMSS, ulAfterOneSecond );
+        TEST_ASSERT_LESS_THAN_UINT32( ulAfterOneSecond - ( 70U * testcongestionMSS ), ulAtPlateau - ulBeforePlateau );
+        TEST_ASSERT_UINT32_WITHIN( 2U * testcongestionMSS, 100U * testcongestionMSS, ulAtPlateau );
+
+        /* Convex: probing beyond the previous maximum. */
+        TEST_ASSERT_GREATER_THAN_UINT32( 110U * testcongestionMSS, xWindow.ulCongestionWindow );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Congestion, SocketOption )
+    {
+        BaseType_t xAlgorithm;
+
+        xClient = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xClient );
+        TEST_ASSERT_EQUAL( ipconfigTCP_CONGESTION_CONTROL, ( ( FreeRTOS_Socket_t * ) xClient )->u.xTCP.ucCongestionControl );
+
+        xAlgorithm = FREERTOS_TCP_CONGESTION_CUBIC;
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_TCP_CONGESTION, &xAlgorithm, sizeof( xAlgorithm ) ) );
+        TEST_ASSERT_EQUAL( FREERTOS_TCP_CONGESTION_CUBIC, ( ( FreeRTOS_Socket_t * ) xClient )->u.xTCP.ucCongestionControl );
+
+        xAlgorithm = 7;
+        TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_setsockopt( xClient, 0, FREERTOS_SO_TCP_CONGESTION, &xAlgorithm, sizeof( xAlgorithm ) ) );
+        TEST_ASSERT_EQUAL( FREERTOS_TCP_CONGESTION_CUBIC, ( ( FreeRTOS_Socket_t * ) xClient )->u.xTCP.ucCongestionControl );
+
+        /* Only TCP sockets have a congestion window. */
+        xListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xListener );
+        xAlgorithm = FREERTOS_TCP_CONGESTION_NEWRENO;
+        TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_setsockopt( xListener, 0, FREERTOS_SO_TCP_CONGESTION, &xAlgorithm, sizeof( xAlgorithm ) ) );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+        TEST( Full_TCP_Congestion, LossyTransferNewReno )
+        {
+            prvLossyTransfer( FREERTOS_TCP_CONGESTION_NEWRENO );
+        }
+    /*-----------------------------------------------------------*/
+
+        TEST( Full_TCP_Congestion, LossyTransferCubic )
+        {
+            prvLossyTransfer( FREERTOS_TCP_CONGESTION_CUBIC );
+        }
+    /*-----------------------------------------------------------*/
+
+    #endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
+
+#endif /* ipconfigUSE_TCP_CONGESTION_CONTROL */
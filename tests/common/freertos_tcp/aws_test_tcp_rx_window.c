@@ -0,0 +1,448 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_tcp_rx_window.c
+ * @brief Tests for storing TCP segments that arrive out of order.
+ *
+ * Segments are given directly to the receive side of a TCP window, whose
+ * sequence numbers wrap around zero. The tests check what is passed to the
+ * user, how the ranges of data received out of order are merged, and the
+ * blocks of the SACK option that reports them. No TCP connection may be open
+ * while the tests run, because the window borrows its segment descriptors from
+ * the pool that the IP task uses.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_TCP_WIN.h"
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief The first sequence number received, close enough to the end of the
+ * sequence space for the tests to wrap around it.
+ */
+    #define testrxFIRST                ( 0xFFFFFF00UL )
+
+/**
+ * @brief Size of the receive window.
+ */
+    #define testrxSPACE                ( 20000U )
+
+/**
+ * @brief Number and size of the segments of the Reordering and Balance
+ * tests.
+ */
+    #define testrxSEGMENTS             ( 200U )
+    #define testrxSEGMENT_LENGTH       ( 50U )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The window that receives the segments.
+ */
+    static TCPWindow_t xWindow;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Gives ulLength bytes at ulOffset from testrxFIRST to xWindow, and
+ * returns the result of lTCPWindowRxCheck().
+ */
+    static int32_t prvReceive( uint32_t ulOffset,
+                               uint32_t ulLength );
+
+/**
+ * @brief Checks that the SACK option reports the given ranges, as pairs of
+ * offsets from testrxFIRST, up to ipconfigTCP_SACK_BLOCKS of them.
+ */
+    static void prvCheckSack( const uint32_t * pulRanges,
+                              UBaseType_t uxRanges );
+
+/**
+ * @brief Returns the number of ranges stored in xWindow.
+ */
+    static UBaseType_t prvRangeCount( void );
+
+/**
+ * @brief Checks that the tree of ranges is not higher than an AVL tree with
+ * the same number of ranges can be.
+ */
+    static void prvCheckHeight( void );
+/*-----------------------------------------------------------*/
+
+    static int32_t prvReceive( uint32_t ulOffset,
+                               uint32_t ulLength )
+    {
+        return lTCPWindowRxCheck( &xWindow, testrxFIRST + ulOffset, ulLength, testrxSPACE );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckSack( const uint32_t * pulRanges,
+                              UBaseType_t uxRanges )
+    {
+        const uint8_t * pucCode = ( const uint8_t * ) &( xWindow.ulOptionsData[ 0 ] );
+        UBaseType_t uxBlocks = ( uxRanges < ipconfigTCP_SACK_BLOCKS ) ? uxRanges : ipconfigTCP_SACK_BLOCKS;
+        UBaseType_t x;
+
+        /* NOP, NOP, SACK and the length of the SACK option. */
+        TEST_ASSERT_EQUAL( 4U + ( 8U * uxBlocks ), xWindow.ucOptionLength );
+        TEST_ASSERT_EQUAL_UINT8( 1U, pucCode[ 0 ] );
+        TEST_ASSERT_EQUAL_UINT8( 1U, pucCode[ 1 ] );
+        TEST_ASSERT_EQUAL_UINT8( 5U, pucCode[ 2 ] );
+        TEST_ASSERT_EQUAL_UINT8( 2U + ( 8U * uxBlocks ), pucCode[ 3 ] );
+
+        for( x = 0; x < uxBlocks; x++ )
+        {
+            TEST_ASSERT_EQUAL_UINT32( pulRanges[ 2U * x ], FreeRTOS_ntohl( xWindow.ulOptionsData[ 1U + ( 2U * x ) ] ) - testrxFIRST );
+            TEST_ASSERT_EQUAL_UINT32( pulRanges[ ( 2U * x ) + 1U ], FreeRTOS_ntohl( xWindow.ulOptionsData[ 2U + ( 2U * x ) ] ) - testrxFIRST );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvRangeCount( void )
+    {
+        return listCURRENT_LIST_LENGTH( &( xWindow.xRxSegments ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckHeight( void )
+    {
+        UBaseType_t uxHeight = 0, uxSmallest = 0, uxPrevious = 0, uxNext;
+
+        /* uxSmallest is the smallest number of ranges in an AVL tree of height
+         * uxHeight + 1. */
+        for( ; ; )
+        {
+            uxNext = uxSmallest + uxPrevious + 1U;
+
+            if( uxNext > prvRangeCount() )
+            {
+                break;
+            }
+
+            uxPrevious = uxSmallest;
+            uxSmallest = uxNext;
+            uxHeight++;
+        }
+
+        if( xWindow.pxRxRoot == NULL )
+        {
+            TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+        }
+        else
+        {
+            TEST_ASSERT_LESS_THAN( uxHeight + 1U, xWindow.pxRxRoot->u.bits.ucRxHeight );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/* Define Test Group. */
+TEST_GROUP( Full_TCP_Rx_Window );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_TCP_Rx_Window )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        memset( &xWindow, 0x00, sizeof( xWindow ) );
+        vTCPWindowCreate( &xWindow, testrxSPACE, testrxSPACE, testrxFIRST, 0UL, 1000UL );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_TCP_Rx_Window )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        vTCPWindowDestroy( &xWindow );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_TCP_Rx_Window )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        RUN_TEST_CASE( Full_TCP_Rx_Window, InOrder );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, OutOfOrder );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, Duplicate );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, MultipleBlocks );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, Bridge );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, PartialFill );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, Refused );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, Reordering );
+        RUN_TEST_CASE( Full_TCP_Rx_Window, Balance );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+    TEST( Full_TCP_Rx_Window, InOrder )
+    {
+        /* The expected data is passed to the user at once, without a SACK. */
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 0U, 100U ) );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + 100U, xWindow.rx.ulCurrentSequenceNumber );
+        TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulUserDataLength );
+        TEST_ASSERT_EQUAL( 0, xWindow.ucOptionLength );
+
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 100U, 300U ) );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + 400U, xWindow.rx.ulCurrentSequenceNumber );
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, OutOfOrder )
+    {
+        const uint32_t ulFirst[] = { 100U, 200U };
+        const uint32_t ulJoined[] = { 100U, 300U };
+
+        /* Data after a missing segment is stored at its offset, and reported
+         * in a SACK. */
+        TEST_ASSERT_EQUAL_INT32( 100, prvReceive( 100U, 100U ) );
+        prvCheckSack( ulFirst, 1 );
+
+        /* Data that follows it joins the same range. */
+        TEST_ASSERT_EQUAL_INT32( 200, prvReceive( 200U, 100U ) );
+        prvCheckSack( ulJoined, 1 );
+        TEST_ASSERT_EQUAL( 1, prvRangeCount() );
+
+        /* When the missing segment arrives, the stored range follows it. */
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 0U, 100U ) );
+        TEST_ASSERT_EQUAL_UINT32( 200U, xWindow.ulUserDataLength );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + 300U, xWindow.rx.ulCurrentSequenceNumber );
+        TEST_ASSERT_EQUAL( 0, xWindow.ucOptionLength );
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+        TEST_ASSERT_EQUAL( pdTRUE, xTCPWindowRxEmpty( &xWindow ) );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, Duplicate )
+    {
+        const uint32_t ulRange[] = { 100U, 200U };
+
+        TEST_ASSERT_EQUAL_INT32( 100, prvReceive( 100U, 100U ) );
+
+        /* Data that has been stored already is not stored again, but the SACK
+         * is repeated. */
+        TEST_ASSERT_EQUAL_INT32( -1, prvReceive( 100U, 100U ) );
+        prvCheckSack( ulRange, 1 );
+
+        TEST_ASSERT_EQUAL_INT32( -1, prvReceive( 120U, 50U ) );
+        prvCheckSack( ulRange, 1 );
+        TEST_ASSERT_EQUAL( 1, prvRangeCount() );
+        TEST_ASSERT_EQUAL( pdFALSE, xTCPWindowRxEmpty( &xWindow ) );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, MultipleBlocks )
+    {
+        const uint32_t ulNewest[] = { 900U, 1000U, 700U, 800U, 500U, 600U, 300U, 400U };
+        const uint32_t ulRepeated[] = { 300U, 400U, 900U, 1000U, 700U, 800U, 500U, 600U };
+        const uint32_t ulMerged[] = { 300U, 600U, 900U, 1000U, 700U, 800U };
+        const uint32_t ulPassed[] = { 700U, 1000U, 300U, 600U };
+        uint32_t ulOffset;
+
+        for( ulOffset = 100U; ulOffset < 1000U; ulOffset += 200U )
+        {
+            TEST_ASSERT_EQUAL_INT32( ( int32_t ) ulOffset, prvReceive( ulOffset, 100U ) );
+        }
+
+        /* The range that has just arrived comes first, followed by the ranges
+         * reported most recently. */
+        prvCheckSack( ulNewest, 4 );
+        TEST_ASSERT_EQUAL( 5, prvRangeCount() );
+
+        TEST_ASSERT_EQUAL_INT32( -1, prvReceive( 300U, 100U ) );
+        prvCheckSack( ulRepeated, 4 );
+
+        /* A range that absorbed another one is reported once. */
+        TEST_ASSERT_EQUAL_INT32( 400, prvReceive( 400U, 100U ) );
+        prvCheckSack( ulMerged, 3 );
+        TEST_ASSERT_EQUAL( 4, prvRangeCount() );
+
+        /* Ranges that have been passed to the user are no longer reported. */
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 0U, 100U ) );
+        TEST_ASSERT_EQUAL_UINT32( 100U, xWindow.ulUserDataLength );
+        TEST_ASSERT_EQUAL_INT32( 600, prvReceive( 800U, 100U ) );
+        prvCheckSack( ulPassed, 2 );
+        TEST_ASSERT_EQUAL( 2, prvRangeCount() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, Bridge )
+    {
+        const uint32_t ulBridged[] = { 100U, 400U };
+
+        TEST_ASSERT_EQUAL_INT32( 100, prvReceive( 100U, 100U ) );
+        TEST_ASSERT_EQUAL_INT32( 300, prvReceive( 300U, 100U ) );
+        TEST_ASSERT_EQUAL( 2, prvRangeCount() );
+
+        /* A segment that overlaps both ranges merges them into one. */
+        TEST_ASSERT_EQUAL_INT32( 150, prvReceive( 150U, 200U ) );
+        prvCheckSack( ulBridged, 1 );
+        TEST_ASSERT_EQUAL( 1, prvRangeCount() );
+
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 0U, 100U ) );
+        TEST_ASSERT_EQUAL_UINT32( 300U, xWindow.ulUserDataLength );
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, PartialFill )
+    {
+        TEST_ASSERT_EQUAL_INT32( 100, prvReceive( 100U, 100U ) );
+        TEST_ASSERT_EQUAL_INT32( 300, prvReceive( 300U, 100U ) );
+
+        /* Expected data that overlaps a stored range is followed by the rest
+         * of that range, but not by the range after the next hole. */
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 0U, 150U ) );
+        TEST_ASSERT_EQUAL_UINT32( 50U, xWindow.ulUserDataLength );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + 200U, xWindow.rx.ulCurrentSequenceNumber );
+        TEST_ASSERT_EQUAL( 1, prvRangeCount() );
+
+        /* Expected data that covers a stored range completely. */
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 200U, 300U ) );
+        TEST_ASSERT_EQUAL_UINT32( 0U, xWindow.ulUserDataLength );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + 500U, xWindow.rx.ulCurrentSequenceNumber );
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, Refused )
+    {
+        TEST_ASSERT_EQUAL_INT32( 0, prvReceive( 0U, 100U ) );
+
+        /* Data that was accepted already. */
+        TEST_ASSERT_EQUAL_INT32( -1, prvReceive( 0U, 100U ) );
+
+        /* Data that starts with data that was accepted already. */
+        TEST_ASSERT_EQUAL_INT32( -1, prvReceive( 50U, 100U ) );
+
+        /* Data beyond the receive window. */
+        TEST_ASSERT_EQUAL_INT32( -1, prvReceive( 100U + testrxSPACE, 100U ) );
+
+        TEST_ASSERT_EQUAL( 0, xWindow.ucOptionLength );
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + 100U, xWindow.rx.ulCurrentSequenceNumber );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, Reordering )
+    {
+        uint32_t ulOrder[ testrxSEGMENTS ];
+        uint32_t x, ulOther, ulSwap, ulRandom = 4321UL, ulPassed = 0U, ulStart, ulEnd;
+        int32_t lResult;
+
+        for( x = 0; x < testrxSEGMENTS; x++ )
+        {
+            ulOrder[ x ] = x;
+        }
+
+        for( x = testrxSEGMENTS - 1U; x > 0U; x-- )
+        {
+            ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+            ulOther = ( ulRandom >> 16 ) % ( x + 1U );
+            ulSwap = ulOrder[ x ];
+            ulOrder[ x ] = ulOrder[ ulOther ];
+            ulOrder[ ulOther ] = ulSwap;
+        }
+
+        /* Every byte is passed to the user exactly once, whatever the order in
+         * which the segments arrive. */
+        for( x = 0; x < testrxSEGMENTS; x++ )
+        {
+            lResult = prvReceive( ulOrder[ x ] * testrxSEGMENT_LENGTH, testrxSEGMENT_LENGTH );
+
+            if( lResult == 0 )
+            {
+                ulPassed += testrxSEGMENT_LENGTH + xWindow.ulUserDataLength;
+            }
+            else
+            {
+                /* The first SACK block holds the segment. */
+                TEST_ASSERT_GREATER_THAN_INT32( 0, lResult );
+                ulStart = FreeRTOS_ntohl( xWindow.ulOptionsData[ 1 ] ) - testrxFIRST;
+                ulEnd = FreeRTOS_ntohl( xWindow.ulOptionsData[ 2 ] ) - testrxFIRST;
+                TEST_ASSERT_LESS_THAN_UINT32( ( ulOrder[ x ] * testrxSEGMENT_LENGTH ) + 1U, ulStart );
+                TEST_ASSERT_GREATER_THAN_UINT32( ( ( ulOrder[ x ] + 1U ) * testrxSEGMENT_LENGTH ) - 1U, ulEnd );
+            }
+
+            prvCheckHeight();
+        }
+
+        TEST_ASSERT_EQUAL_UINT32( testrxSEGMENTS * testrxSEGMENT_LENGTH, ulPassed );
+        TEST_ASSERT_EQUAL_UINT32( testrxFIRST + ulPassed, xWindow.rx.ulCurrentSequenceNumber );
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Rx_Window, Balance )
+    {
+        uint32_t x;
+
+        /* Ranges that arrive in ascending order, each one after a hole, keep
+         * the tree balanced. */
+        for( x = 1U; x < testrxSEGMENTS; x += 2U )
+        {
+            TEST_ASSERT_GREATER_THAN_INT32( 0, prvReceive( x * testrxSEGMENT_LENGTH, testrxSEGMENT_LENGTH ) );
+            prvCheckHeight();
+        }
+
+        TEST_ASSERT_EQUAL( testrxSEGMENTS / 2U, prvRangeCount() );
+
+        /* And so do ranges that are passed to the user one at a time. */
+        for( x = 0U; x < testrxSEGMENTS; x += 2U )
+        {
+            TEST_ASSERT_EQUAL_INT32( 0, prvReceive( x * testrxSEGMENT_LENGTH, testrxSEGMENT_LENGTH ) );
+            TEST_ASSERT_EQUAL_UINT32( testrxSEGMENT_LENGTH, xWindow.ulUserDataLength );
+            prvCheckHeight();
+        }
+
+        TEST_ASSERT_EQUAL( 0, prvRangeCount() );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
@@ -0,0 +1,242 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_tcp_sack.c
+ * @brief Tests for the retransmissions that SACK options cause in FreeRTOS+TCP.
+ *
+ * The transmit side of a TCP window is given SACK's, to check that only the
+ * segments that the peer is missing are retransmitted, that a retransmission
+ * that is lost is sent again without waiting for its timer, and that a SACK
+ * that repeats does not cause a retransmission. The SACK options made by the
+ * receive side are tested with the reception window.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_TCP_WIN.h"
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+/**
+ * @brief Size of the segments, and the first sequence number sent.
+ */
+    #define testsackMSS                ( 1000U )
+    #define testsackFIRST              ( ( uint32_t ) 0xFFFFF000UL )
+
+/**
+ * @brief Size of the window in segments.
+ */
+    #define testsackWINDOW_SEGMENTS    ( 16U )
+
+/**
+ * @brief Sequence number of segment x.
+ */
+    #define testsackSEQUENCE( x )      ( ( uint32_t ) ( testsackFIRST + ( ( uint32_t ) ( x ) * testsackMSS ) ) )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The window driven by the tests, and the number of segments added to
+ * its transmission stream.
+ */
+    static TCPWindow_t xWindow;
+    static uint32_t ulAdded;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Adds ulCount segments to xWindow and sends them.
+ */
+    static void prvSend( uint32_t ulCount );
+
+/**
+ * @brief Returns the segment that xWindow sends next, or -1 if it sends
+ * nothing.
+ */
+    static int32_t prvSendNext( void );
+/*-----------------------------------------------------------*/
+
+    static void prvSend( uint32_t ulCount )
+    {
+        uint32_t x;
+
+        /* Only the SACK's decide what is sent, not the congestion window. */
+        #if ( ipconfigUSE_TCP_CONGESTION_CONTROL != 0 )
+            xWindow.ulCongestionWindow = testsackWINDOW_SEGMENTS * testsackMSS;
+        #endif
+
+        for( x = 0; x < ulCount; x++ )
+        {
+            TEST_ASSERT_EQUAL_INT32( testsackMSS, lTCPWindowTxAdd( &xWindow, testsackMSS, ( int32_t ) ( ulAdded * testsackMSS ), ( int32_t ) ( testsackWINDOW_SEGMENTS * testsackMSS * 4U ) ) );
+            TEST_ASSERT_EQUAL_INT32( ulAdded, prvSendNext() );
+            ulAdded++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static int32_t prvSendNext( void )
+    {
+        int32_t lPosition, lSegment = -1;
+
+        if( ulTCPWindowTxGet( &xWindow, testsackWINDOW_SEGMENTS * testsackMSS, &lPosition ) != 0U )
+        {
+            lSegment = ( int32_t ) ( ( xWindow.ulOurSequenceNumber - testsackFIRST ) / testsackMSS );
+        }
+
+        return lSegment;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
+
+/* Define Test Group. */
+TEST_GROUP( Full_TCP_Sack );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_TCP_Sack )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        memset( &xWindow, 0x00, sizeof( xWindow ) );
+        vTCPWindowCreate( &xWindow, testsackWINDOW_SEGMENTS * testsackMSS, testsackWINDOW_SEGMENTS * testsackMSS, testsackFIRST, testsackFIRST, testsackMSS );
+        ulAdded = 0;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_TCP_Sack )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        /* Return the segments to the pool. */
+        vTCPWindowDestroy( &xWindow );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_TCP_Sack )
+{
+    #if ( ipconfigUSE_TCP_WIN == 1 )
+        RUN_TEST_CASE( Full_TCP_Sack, RetransmitHolesOnly );
+        RUN_TEST_CASE( Full_TCP_Sack, TooFewSacked );
+        RUN_TEST_CASE( Full_TCP_Sack, RepeatedSack );
+        RUN_TEST_CASE( Full_TCP_Sack, LostRetransmission );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_TCP_WIN == 1 )
+
+    TEST( Full_TCP_Sack, RetransmitHolesOnly )
+    {
+        prvSend( 10 );
+
+        /* Segments 1 and 5 were lost. */
+        ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 2 ), testsackSEQUENCE( 5 ) );
+        ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 6 ), testsackSEQUENCE( 10 ) );
+        ( void ) ulTCPWindowTxAck( &xWindow, testsackSEQUENCE( 1 ) );
+
+        TEST_ASSERT_EQUAL_INT32( 1, prvSendNext() );
+        TEST_ASSERT_EQUAL_INT32( 5, prvSendNext() );
+        TEST_ASSERT_EQUAL_INT32( -1, prvSendNext() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Sack, TooFewSacked )
+    {
+        prvSend( 4 );
+
+        /* Segment 1 may only be late, too few segments after it arrived. */
+        ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 2 ), testsackSEQUENCE( 4 ) );
+        ( void ) ulTCPWindowTxAck( &xWindow, testsackSEQUENCE( 1 ) );
+
+        TEST_ASSERT_EQUAL_INT32( -1, prvSendNext() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Sack, RepeatedSack )
+    {
+        uint32_t x;
+
+        prvSend( 4 );
+
+        /* The same SACK comes in every ACK and in more than one block, but
+         * it is still only two segments after segment 1. */
+        for( x = 0; x < 4U; x++ )
+        {
+            ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 2 ), testsackSEQUENCE( 3 ) );
+            ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 3 ), testsackSEQUENCE( 4 ) );
+            ( void ) ulTCPWindowTxAck( &xWindow, testsackSEQUENCE( 1 ) );
+        }
+
+        TEST_ASSERT_EQUAL_INT32( -1, prvSendNext() );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_TCP_Sack, LostRetransmission )
+    {
+        prvSend( 8 );
+        ( void ) ulTCPWindowTxAck( &xWindow, testsackSEQUENCE( 1 ) );
+        ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 2 ), testsackSEQUENCE( 5 ) );
+
+        /* Segment 1 is retransmitted later than the segments after it were
+         * sent, and its retransmission is lost as well. */
+        vTaskDelay( 2 );
+        TEST_ASSERT_EQUAL_INT32( 1, prvSendNext() );
+        TEST_ASSERT_EQUAL_INT32( -1, prvSendNext() );
+
+        /* The segments that were sent before the retransmission tell nothing
+         * about it. */
+        ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 2 ), testsackSEQUENCE( 8 ) );
+        TEST_ASSERT_EQUAL_INT32( -1, prvSendNext() );
+
+        /* Three segments sent after it arrived, long before its timer
+         * expires. */
+        prvSend( 3 );
+        ( void ) ulTCPWindowTxSack( &xWindow, testsackSEQUENCE( 2 ), testsackSEQUENCE( 11 ) );
+        TEST_ASSERT_EQUAL_INT32( 1, prvSendNext() );
+        TEST_ASSERT_EQUAL_INT32( -1, prvSendNext() );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_TCP_WIN == 1 */
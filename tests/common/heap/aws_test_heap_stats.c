@@ -0,0 +1,407 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_heap_stats.c
+ * @brief Tests for the per task heap statistics and the heap trace buffer.
+ *
+ * The tests need configUSE_HEAP_STATS_PER_TASK set to 1, and one of the heap
+ * implementations that keep the statistics (heap_4.c, heap_5.c or heap_6.c).
+ * The trace test is only built if configHEAP_TRACE_BUFFER_LENGTH is greater
+ * than 0.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Name, stack size and priority of the task that allocates memory.
+ */
+#define testheapstatsTASK_NAME          "HeapStats"
+#define testheapstatsTASK_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 4 )
+#define testheapstatsTASK_PRIORITY      ( tskIDLE_PRIORITY + 1 )
+
+/**
+ * @brief Time to wait for the task to make its allocations.
+ */
+#define testheapstatsTASK_TIMEOUT       pdMS_TO_TICKS( 5000 )
+
+/**
+ * @brief Number of blocks the task allocates, and their sizes.
+ */
+#define testheapstatsBLOCKS             ( 3 )
+static const size_t xBlockSizes[ testheapstatsBLOCKS ] = { 20, 200, 2000 };
+
+/**
+ * @brief Upper bound of the size of the header the heap adds to a block,
+ * including alignment.
+ */
+#define testheapstatsMAX_HEADER_SIZE    ( 64 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The task that allocates memory, and the task running the test.
+ */
+static TaskHandle_t xAllocatingTask;
+static TaskHandle_t xTestTask;
+
+/**
+ * @brief The blocks allocated by xAllocatingTask.
+ */
+static void * pvBlocks[ testheapstatsBLOCKS ];
+
+/**
+ * @brief Statistics read by prvFindTaskStats().  Static as the array is too
+ * large for the stack of the test task.
+ */
+static HeapTaskStats_t xTaskStats[ configHEAP_STATS_MAX_TASKS ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Allocates the testheapstatsBLOCKS blocks, then notifies the test task
+ * and waits to be deleted.
+ */
+static void prvAllocatingTask( void * pvParameters );
+
+/**
+ * @brief Creates prvAllocatingTask() and waits for its allocations.
+ */
+static void prvStartAllocatingTask( void );
+
+/**
+ * @brief Frees the blocks allocated by prvAllocatingTask().
+ */
+static void prvFreeBlocks( void );
+
+/**
+ * @brief Reads the heap statistics and finds the entry of a task.
+ *
+ * @param[in] xTask The task.
+ * @param[in] xTaskDeleted The entry of a deleted task is only found if pdTRUE.
+ * @param[out] puxIndex Set to the index of the entry if not NULL.
+ *
+ * @return The entry, or NULL if the task has no entry.
+ */
+static HeapTaskStats_t * prvFindTaskStats( TaskHandle_t xTask,
+                                           BaseType_t xTaskDeleted,
+                                           UBaseType_t * puxIndex );
+/*-----------------------------------------------------------*/
+
+static void prvAllocatingTask( void * pvParameters )
+{
+    uint32_t x;
+
+    ( void ) pvParameters;
+
+    for( x = 0; x < testheapstatsBLOCKS; x++ )
+    {
+        pvBlocks[ x ] = pvPortMalloc( xBlockSizes[ x ] );
+    }
+
+    xTaskNotifyGive( xTestTask );
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartAllocatingTask( void )
+{
+    BaseType_t xResult;
+
+    /* Clear any value left in the notification of the test task by earlier
+     * tests, e.g. by the MQTT agent, so that the count below starts at zero. */
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+    xResult = xTaskCreate( prvAllocatingTask,
+                           testheapstatsTASK_NAME,
+                           testheapstatsTASK_STACK_SIZE,
+                           NULL,
+                           testheapstatsTASK_PRIORITY,
+                           &xAllocatingTask );
+    TEST_ASSERT_EQUAL( pdPASS, xResult );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulTaskNotifyTake( pdTRUE, testheapstatsTASK_TIMEOUT ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeBlocks( void )
+{
+    uint32_t x;
+
+    for( x = 0; x < testheapstatsBLOCKS; x++ )
+    {
+        vPortFree( pvBlocks[ x ] );
+        pvBlocks[ x ] = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static HeapTaskStats_t * prvFindTaskStats( TaskHandle_t xTask,
+                                           BaseType_t xTaskDeleted,
+                                           UBaseType_t * puxIndex )
+{
+    UBaseType_t uxEntries = configHEAP_STATS_MAX_TASKS, x;
+    HeapTaskStats_t * pxStats = NULL;
+
+    vPortGetHeapStatsPerTask( xTaskStats, &uxEntries );
+
+    /* A deleted task and a task created later can have the same handle, so
+     * the last matching entry is the most recent. */
+    for( x = 1; x < uxEntries; x++ )
+    {
+        if( ( xTaskStats[ x ].pvTask == ( void * ) xTask ) &&
+            ( xTaskStats[ x ].xTaskDeleted == xTaskDeleted ) )
+        {
+            pxStats = &( xTaskStats[ x ] );
+
+            if( puxIndex != NULL )
+            {
+                *puxIndex = x;
+            }
+        }
+    }
+
+    return pxStats;
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Heap_Stats );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Heap_Stats )
+{
+    xTestTask = xTaskGetCurrentTaskHandle();
+    xAllocatingTask = NULL;
+    memset( pvBlocks, 0x00, sizeof( pvBlocks ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Heap_Stats )
+{
+    if( xAllocatingTask != NULL )
+    {
+        vTaskDelete( xAllocatingTask );
+        xAllocatingTask = NULL;
+    }
+
+    prvFreeBlocks();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Heap_Stats )
+{
+    RUN_TEST_CASE( Full_Heap_Stats, AllocationsChargedToTask );
+    RUN_TEST_CASE( Full_Heap_Stats, FreeByAnotherTask );
+    RUN_TEST_CASE( Full_Heap_Stats, DeletedTask );
+    RUN_TEST_CASE( Full_Heap_Stats, FailedAllocation );
+    RUN_TEST_CASE( Full_Heap_Stats, TraceBuffer );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Heap_Stats, AllocationsChargedToTask )
+{
+    HeapTaskStats_t * pxStats;
+    size_t xRequested = 0;
+    uint32_t ulHistogramTotal = 0, x;
+
+    prvStartAllocatingTask();
+
+    for( x = 0; x < testheapstatsBLOCKS; x++ )
+    {
+        TEST_ASSERT_NOT_NULL( pvBlocks[ x ] );
+        xRequested += xBlockSizes[ x ];
+    }
+
+    pxStats = prvFindTaskStats( xAllocatingTask, pdFALSE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    TEST_ASSERT_EQUAL_STRING( testheapstatsTASK_NAME, pxStats->pcTaskName );
+    TEST_ASSERT_EQUAL_UINT32( testheapstatsBLOCKS, pxStats->ulAllocations );
+    TEST_ASSERT_EQUAL_UINT32( 0, pxStats->ulFrees );
+    TEST_ASSERT_EQUAL_UINT32( 0, pxStats->ulFailedAllocations );
+    TEST_ASSERT_TRUE( pxStats->xCurrentBytes >= xRequested );
+    TEST_ASSERT_TRUE( pxStats->xCurrentBytes <= ( xRequested + ( testheapstatsBLOCKS * testheapstatsMAX_HEADER_SIZE ) ) );
+    TEST_ASSERT_TRUE( pxStats->xPeakBytes == pxStats->xCurrentBytes );
+
+    for( x = 0; x < portHEAP_STATS_HISTOGRAM_BUCKETS; x++ )
+    {
+        ulHistogramTotal += pxStats->ulSizeHistogram[ x ];
+    }
+
+    TEST_ASSERT_EQUAL_UINT32( testheapstatsBLOCKS, ulHistogramTotal );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Heap_Stats, FreeByAnotherTask )
+{
+    HeapTaskStats_t * pxStats;
+    size_t xPeakBytes, xTestTaskBytes;
+
+    prvStartAllocatingTask();
+
+    pxStats = prvFindTaskStats( xAllocatingTask, pdFALSE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    xPeakBytes = pxStats->xPeakBytes;
+
+    pxStats = prvFindTaskStats( xTestTask, pdFALSE, NULL );
+    xTestTaskBytes = ( pxStats != NULL ) ? pxStats->xCurrentBytes : 0;
+
+    /* The memory is returned to the task that allocated it, not to the task
+     * that frees it. */
+    prvFreeBlocks();
+
+    pxStats = prvFindTaskStats( xAllocatingTask, pdFALSE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    TEST_ASSERT_EQUAL_UINT32( 0, pxStats->xCurrentBytes );
+    TEST_ASSERT_EQUAL_UINT32( testheapstatsBLOCKS, pxStats->ulFrees );
+    TEST_ASSERT_EQUAL_UINT32( xPeakBytes, pxStats->xPeakBytes );
+
+    pxStats = prvFindTaskStats( xTestTask, pdFALSE, NULL );
+    TEST_ASSERT_EQUAL_UINT32( xTestTaskBytes, ( pxStats != NULL ) ? pxStats->xCurrentBytes : 0 );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Heap_Stats, DeletedTask )
+{
+    HeapTaskStats_t * pxStats;
+    TaskHandle_t xDeletedTask;
+
+    prvStartAllocatingTask();
+
+    xDeletedTask = xAllocatingTask;
+    vTaskDelete( xAllocatingTask );
+    xAllocatingTask = NULL;
+
+    /* The memory the task did not free is still charged to it. */
+    TEST_ASSERT_NULL( prvFindTaskStats( xDeletedTask, pdFALSE, NULL ) );
+    pxStats = prvFindTaskStats( xDeletedTask, pdTRUE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    TEST_ASSERT_TRUE( pxStats->xCurrentBytes > 0 );
+
+    prvFreeBlocks();
+
+    pxStats = prvFindTaskStats( xDeletedTask, pdTRUE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    TEST_ASSERT_EQUAL_UINT32( 0, pxStats->xCurrentBytes );
+
+    /* A new task starts with empty statistics, even if it reuses the entry
+     * or the handle of the deleted task. */
+    prvStartAllocatingTask();
+
+    pxStats = prvFindTaskStats( xAllocatingTask, pdFALSE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    TEST_ASSERT_EQUAL_UINT32( testheapstatsBLOCKS, pxStats->ulAllocations );
+    TEST_ASSERT_EQUAL_UINT32( 0, pxStats->ulFrees );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Heap_Stats, FailedAllocation )
+{
+    HeapTaskStats_t * pxStats;
+    uint32_t ulFailedAllocations;
+    void * pvBlock;
+
+    /* Make sure the test task has an entry. */
+    pvBlock = pvPortMalloc( 1 );
+    TEST_ASSERT_NOT_NULL( pvBlock );
+    vPortFree( pvBlock );
+
+    pxStats = prvFindTaskStats( xTestTask, pdFALSE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    ulFailedAllocations = pxStats->ulFailedAllocations;
+
+    pvBlock = pvPortMalloc( configTOTAL_HEAP_SIZE );
+    TEST_ASSERT_NULL( pvBlock );
+
+    pxStats = prvFindTaskStats( xTestTask, pdFALSE, NULL );
+    TEST_ASSERT_NOT_NULL( pxStats );
+    TEST_ASSERT_EQUAL_UINT32( ulFailedAllocations + 1, pxStats->ulFailedAllocations );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Heap_Stats, TraceBuffer )
+{
+    #if ( configHEAP_TRACE_BUFFER_LENGTH > 0 )
+        const HeapTraceBuffer_t * pxTrace;
+        const HeapTraceEvent_t * pxMalloc, * pxFree;
+        size_t xBufferSize;
+        uint32_t ulEventsWritten;
+        UBaseType_t uxOwner = 0;
+        void * pvBlock;
+
+        pxTrace = pxPortGetHeapTraceBuffer( &xBufferSize );
+        TEST_ASSERT_EQUAL_UINT32( portHEAP_TRACE_MAGIC, pxTrace->ulMagic );
+        TEST_ASSERT_EQUAL_UINT32( sizeof( HeapTraceBuffer_t ), xBufferSize );
+        TEST_ASSERT_EQUAL_UINT32( configHEAP_TRACE_BUFFER_LENGTH, pxTrace->ulLength );
+
+        /* No other task may use the heap between the two events. */
+        vTaskSuspendAll();
+        {
+            ulEventsWritten = pxTrace->ulEventsWritten;
+            pvBlock = pvPortMalloc( 100 );
+            vPortFree( pvBlock );
+        }
+        ( void ) xTaskResumeAll();
+
+        TEST_ASSERT_NOT_NULL( pvBlock );
+        TEST_ASSERT_EQUAL_UINT32( ulEventsWritten + 2, pxTrace->ulEventsWritten );
+
+        pxMalloc = &( pxTrace->xEvents[ ulEventsWritten % configHEAP_TRACE_BUFFER_LENGTH ] );
+        pxFree = &( pxTrace->xEvents[ ( ulEventsWritten + 1 ) % configHEAP_TRACE_BUFFER_LENGTH ] );
+
+        TEST_ASSERT_EQUAL_UINT16( portHEAP_TRACE_EVENT_MALLOC, pxMalloc->usEvent );
+        TEST_ASSERT_EQUAL_UINT16( portHEAP_TRACE_EVENT_FREE, pxFree->usEvent );
+        TEST_ASSERT_EQUAL_UINT32( ( uint32_t ) ( size_t ) pvBlock, pxMalloc->ulAddress );
+        TEST_ASSERT_EQUAL_UINT32( pxMalloc->ulAddress, pxFree->ulAddress );
+        TEST_ASSERT_EQUAL_UINT32( pxMalloc->ulSize, pxFree->ulSize );
+        TEST_ASSERT_TRUE( pxMalloc->ulSize >= 100 );
+
+        /* The owner is the index of the task in the statistics. */
+        TEST_ASSERT_NOT_NULL( prvFindTaskStats( xTestTask, pdFALSE, &uxOwner ) );
+        TEST_ASSERT_EQUAL_UINT16( uxOwner, pxMalloc->usOwner );
+        TEST_ASSERT_EQUAL_UINT16( uxOwner, pxFree->usOwner );
+    #else /* if ( configHEAP_TRACE_BUFFER_LENGTH > 0 ) */
+        TEST_IGNORE_MESSAGE( "configHEAP_TRACE_BUFFER_LENGTH is 0." );
+    #endif /* if ( configHEAP_TRACE_BUFFER_LENGTH > 0 ) */
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,83 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_benchmark.h
+ * @brief Helpers shared by the benchmarks.
+ *
+ * Benchmarks report one JSON object per line through configPRINTF so that
+ * the results can be extracted from the test log and tracked over time.
+ */
+
+#ifndef _AWS_BENCHMARK_H_
+#define _AWS_BENCHMARK_H_
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Returns the current timestamp used to time the benchmarks.
+ *
+ * The run time stats counter is used when the port provides one, as it
+ * normally has a much finer resolution than the tick count.
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #define benchmarkGET_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+    #define benchmarkTIMESTAMP_UNIT     "run_time_counts"
+#else
+    #define benchmarkGET_TIMESTAMP()    ( ( uint32_t ) xTaskGetTickCount() )
+    #define benchmarkTIMESTAMP_UNIT     "ticks"
+#endif
+
+/**
+ * @brief Reports one benchmark result.
+ *
+ * @param[in] pcBenchmark The name of the benchmark.
+ * @param[in] pcParameter The name of the parameter varied by the benchmark.
+ * @param[in] ulParameter The value of the parameter for this result.
+ * @param[in] ulIterations The number of operations timed.
+ * @param[in] ulElapsed The time taken by all the operations, in
+ * benchmarkTIMESTAMP_UNIT.
+ */
+#define benchmarkREPORT( pcBenchmark, pcParameter, ulParameter, ulIterations, ulElapsed )                                   \
+    configPRINTF( ( "{\"benchmark\":\"%s\",\"%s\":%u,\"iterations\":%u,\"elapsed\":%u,\"unit\":\"%s\"}\r\n", \
+                    ( pcBenchmark ), ( pcParameter ), ( unsigned ) ( ulParameter ),                              \
+                    ( unsigned ) ( ulIterations ), ( unsigned ) ( ulElapsed ), benchmarkTIMESTAMP_UNIT ) )
+
+/**
+ * @brief Reports one benchmark result that is not a time.
+ *
+ * @param[in] pcBenchmark The name of the benchmark.
+ * @param[in] pcParameter The name of the parameter varied by the benchmark.
+ * @param[in] ulParameter The value of the parameter for this result.
+ * @param[in] ulValue The measured value.
+ */
+#define benchmarkREPORT_METRIC( pcBenchmark, pcParameter, ulParameter, ulValue )  \
+    configPRINTF( ( "{\"benchmark\":\"%s\",\"%s\":%u,\"value\":%u}\r\n",          \
+                    ( pcBenchmark ), ( pcParameter ), ( unsigned ) ( ulParameter ), \
+                    ( unsigned ) ( ulValue ) ) )
+
+#endif /* _AWS_BENCHMARK_H_ */
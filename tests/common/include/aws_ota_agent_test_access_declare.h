@@ -51,4 +51,12 @@ DocParseErr_t TEST_OTA_prvParseJSONbyModel( const char * pcJSON,
                                             uint32_t ulMsgLen,
                                             JSON_DocModel_t * pxDocModel );
 
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+    uint32_t TEST_OTA_prvBuildWindowBitmap( OTA_FileContext_t * C,
+                                            uint8_t * pucBitmap,
+                                            uint32_t * pulBitmapLen );
+
+    void TEST_OTA_prvRequestWindowTimeout( OTA_FileContext_t * C );
+#endif
+
 #endif /* ifndef _AWS_OTA_AGENT_TEST_ACCESS_DECLARE_H_ */
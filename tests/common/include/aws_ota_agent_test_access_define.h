@@ -68,4 +68,22 @@ DocParseErr_t TEST_OTA_prvParseJSONbyModel( const char * pcJSON,
     return prvParseJSONbyModel( pcJSON, ulMsgLen, pxDocModel );
 }
 
+/*-----------------------------------------------------------*/
+
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+    uint32_t TEST_OTA_prvBuildWindowBitmap( OTA_FileContext_t * C,
+                                            uint8_t * pucBitmap,
+                                            uint32_t * pulBitmapLen )
+    {
+        return prvBuildWindowBitmap( C, pucBitmap, pulBitmapLen );
+    }
+
+/*-----------------------------------------------------------*/
+
+    void TEST_OTA_prvRequestWindowTimeout( OTA_FileContext_t * C )
+    {
+        prvRequestWindowTimeout( C );
+    }
+#endif /* if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 ) */
+
 #endif /* _AWS_OTA_AGENT_TEST_ACCESS_DEFINE_H_ */
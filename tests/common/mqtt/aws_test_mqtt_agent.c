@@ -29,6 +29,7 @@
  */
 
 /* Standard includes. */
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -36,6 +37,8 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "aws_mqtt_agent.h"
+#include "aws_mqtt_agent_config.h"
+#include "aws_mqtt_agent_config_defaults.h"
 #include "task.h"
 #include "queue.h"
 #include "event_groups.h"
@@ -44,6 +47,12 @@
 /* Unity framework includes. */
 #include "unity_fixture.h"
 
+#if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+    /* FreeRTOS+TCP includes, used to run a broker on this node. */
+    #include "FreeRTOS_IP.h"
+    #include "FreeRTOS_Sockets.h"
+#endif
+
 /* MQTT agent connection timeout. */
 #define mqttagenttestTIMEOUT       pdMS_TO_TICKS( 10000UL )
 
@@ -121,6 +130,48 @@
 #define mqttagenttestMULTI_TASK_TEST_TOPIC_NAME                ( ( const uint8_t * ) "freertos/tests/multiTask/%d" )
 #define mqttagenttestMULTI_TASK_TEST_MAX_TOPIC_NAME_SIZE       ( 30 )
 
+#if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+/* A minimal MQTT broker runs on this node so that the agent can be tested
+ * without a network connection, and so that the tests can control when
+ * the broker reads from the socket and acknowledges publishes. */
+    #define mqttagenttestBROKER_PORT               ( 7210U )
+    #define mqttagenttestBROKER_PRIORITY           ( tskIDLE_PRIORITY + 1 )
+    #define mqttagenttestBROKER_STACK_SIZE         ( configMINIMAL_STACK_SIZE * 4 )
+    #define mqttagenttestBROKER_POLL_TICKS         pdMS_TO_TICKS( 100 )
+    #define mqttagenttestBROKER_MAX_PACKET_SIZE    ( 4096U )
+
+/* Sizes of the payloads published to the broker. The larger one does not fit
+ * in the Tx buffer of the agent. */
+    #define mqttagenttestSMALL_PAYLOAD_SIZE        ( 100U )
+    #define mqttagenttestLARGE_PAYLOAD_SIZE        ( 1500U )
+
+/* Size of the payloads published without being copied, which do not fit in
+ * the buffers of the buffer pool either. */
+    #define mqttagenttestZERO_COPY_PAYLOAD_SIZE    ( 3000U )
+    #define mqttagenttestZERO_COPY_PUBLISHES       ( 2U )
+
+/* Number of messages published while the broker does not read, which must
+ * be more than the sockets at both ends can hold. */
+    #define mqttagenttestSTALLED_PUBLISHES         ( 64U )
+
+/* Time for which the broker stops reading. Shorter than
+ * mqttconfigTCP_SEND_TIMEOUT_MS, so that no send times out. */
+    #define mqttagenttestBROKER_STALL_TICKS        pdMS_TO_TICKS( 500 )
+
+/* Timeout of the publishes which the broker does not acknowledge. */
+    #define mqttagenttestPUBACK_TIMEOUT            pdMS_TO_TICKS( 2000 )
+
+/* Tasks used to keep all the parallel operations of the agent busy. */
+    #define mqttagenttestHELPER_PRIORITY           ( tskIDLE_PRIORITY + 1 )
+    #define mqttagenttestHELPER_STACK_SIZE         ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Number of asynchronous publishes of which a test records the results, enough
+ * to fill the in-flight window twice. */
+    #define mqttagenttestASYNC_PUBLISHES           ( 2U * mqttconfigMAX_ASYNC_PUBLISHES )
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
+
 
 /* Default connection parameters. */
 static const MQTTAgentConnectParams_t xDefaultConnectParameters =
@@ -325,6 +376,578 @@ static BaseType_t prvCreateClientAndConnectToBroker( BaseType_t xUseAlpn )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+/* State of the broker running on this node. */
+    static Socket_t xBrokerListener = FREERTOS_INVALID_SOCKET;
+    static Socket_t xBrokerClient = FREERTOS_INVALID_SOCKET;
+    static TaskHandle_t xBrokerTask = NULL;
+    static SemaphoreHandle_t xBrokerDone = NULL;
+    static volatile BaseType_t xBrokerStop;
+    static volatile TickType_t xBrokerStallTicks;
+    static volatile uint32_t ulBrokerPublishes;
+    static volatile uint32_t ulBrokerErrors;
+    static uint8_t ucBrokerPacket[ mqttagenttestBROKER_MAX_PACKET_SIZE ];
+
+/* Bit n set: the broker does not acknowledge the n-th publish of a test. */
+    static volatile uint32_t ulBrokerUnackedPublishes;
+
+/* Bit n set: the broker only acknowledges the n-th publish of a test when it
+ * receives the next one, and the PUBACK it holds back until then. */
+    static volatile uint32_t ulBrokerLatePublishes;
+    static uint8_t ucBrokerLatePUBACK[ 4 ];
+    static BaseType_t xBrokerLatePUBACKPending;
+
+/* Dotted decimal address of this node, used as the broker URL. */
+    static char cBrokerAddress[ 16 ];
+
+/* Buffer holding the payloads published to the broker. */
+    static uint8_t ucPayload[ mqttagenttestLARGE_PAYLOAD_SIZE ];
+
+/* Buffers holding the payloads of a publish batch, one per message. */
+    static uint8_t ucBatchPayloads[ mqttconfigMAX_PUBLISH_BATCH_SIZE ][ mqttagenttestSMALL_PAYLOAD_SIZE ];
+
+/* State of the tasks keeping the parallel operations of the agent busy. */
+    static MQTTAgentHandle_t xHelperMQTTHandle;
+    static SemaphoreHandle_t xHelpersDone = NULL;
+    static MQTTAgentReturnCode_t xHelperResults[ mqttconfigMAX_PARALLEL_OPS ];
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+
+/* Results of the asynchronous publishes, indexed by their sequence number, and
+ * the number of completion callbacks invoked. */
+        static MQTTAgentReturnCode_t xAsyncResults[ mqttagenttestASYNC_PUBLISHES ];
+        static volatile uint32_t ulAsyncCompletions;
+        static SemaphoreHandle_t xAsyncPublishesDone = NULL;
+        static StaticSemaphore_t xAsyncPublishesDoneBuffer;
+
+        #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+/* Buffers holding the payloads published without being copied. */
+            static uint8_t ucZeroCopyPayloads[ mqttagenttestZERO_COPY_PUBLISHES ][ mqttagenttestZERO_COPY_PAYLOAD_SIZE ];
+        #endif
+    #endif
+
+/**
+ * @brief Reads exactly xLength bytes from the broker's client socket.
+ */
+    static BaseType_t prvBrokerReceive( uint8_t * pucBuffer,
+                                        size_t xLength )
+    {
+        size_t xReceived = 0;
+        BaseType_t xResult = 0;
+
+        while( ( xReceived < xLength ) && ( xResult >= 0 ) && ( xBrokerStop == pdFALSE ) )
+        {
+            xResult = FreeRTOS_recv( xBrokerClient, &( pucBuffer[ xReceived ] ), xLength - xReceived, 0 );
+
+            if( xResult > 0 )
+            {
+                xReceived += ( size_t ) xResult;
+            }
+        }
+
+        return ( xReceived == xLength ) ? pdPASS : pdFAIL;
+    }
+
+/**
+ * @brief Checks the payload of a publish received by the broker.
+ *
+ * Byte x of the payload of the n-th message published in a test is ( n + x ).
+ */
+    static void prvBrokerCheckPayload( const uint8_t * pucData,
+                                       uint32_t ulLength )
+    {
+        uint32_t x;
+
+        if( ulLength == 0 )
+        {
+            ulBrokerErrors++;
+        }
+
+        for( x = 0; x < ulLength; x++ )
+        {
+            if( pucData[ x ] != ( uint8_t ) ( ulBrokerPublishes + x ) )
+            {
+                ulBrokerErrors++;
+                break;
+            }
+        }
+
+        ulBrokerPublishes++;
+    }
+
+/**
+ * @brief Returns pdTRUE if the bit of the publish being received is set in ulPublishes.
+ */
+    static BaseType_t prvBrokerPublishIsIn( uint32_t ulPublishes )
+    {
+        return ( ( ulBrokerPublishes < 32U ) && ( ( ulPublishes & ( 1UL << ulBrokerPublishes ) ) != 0U ) ) ? pdTRUE : pdFALSE;
+    }
+
+/**
+ * @brief Processes an MQTT packet received by the broker and sends the reply.
+ */
+    static void prvBrokerProcessPacket( uint8_t ucType,
+                                        uint32_t ulLength )
+    {
+        uint8_t ucReply[ 4 ];
+        size_t xReplyLength = 0;
+        uint32_t ulOffset;
+
+        switch( ucType & 0xF0U )
+        {
+            case 0x10U: /* CONNECT, accepted. */
+                ucReply[ 0 ] = 0x20U;
+                ucReply[ 1 ] = 0x02U;
+                ucReply[ 2 ] = 0x00U;
+                ucReply[ 3 ] = 0x00U;
+                xReplyLength = 4;
+                break;
+
+            case 0x30U: /* PUBLISH. */
+                ulOffset = 2U + ( ( ( uint32_t ) ucBrokerPacket[ 0 ] << 8 ) | ucBrokerPacket[ 1 ] );
+
+                /* First send the PUBACK held back for the previous publish. */
+                if( xBrokerLatePUBACKPending != pdFALSE )
+                {
+                    xBrokerLatePUBACKPending = pdFALSE;
+                    ( void ) FreeRTOS_send( xBrokerClient, ucBrokerLatePUBACK, sizeof( ucBrokerLatePUBACK ), 0 );
+                }
+
+                if( ( ( ucType & 0x06U ) != 0U ) && ( prvBrokerPublishIsIn( ulBrokerUnackedPublishes ) == pdFALSE ) )
+                {
+                    /* Acknowledge a QoS1 publish with its packet identifier. */
+                    ucReply[ 0 ] = 0x40U;
+                    ucReply[ 1 ] = 0x02U;
+                    ucReply[ 2 ] = ucBrokerPacket[ ulOffset ];
+                    ucReply[ 3 ] = ucBrokerPacket[ ulOffset + 1U ];
+                    xReplyLength = 4;
+
+                    if( prvBrokerPublishIsIn( ulBrokerLatePublishes ) == pdTRUE )
+                    {
+                        memcpy( ucBrokerLatePUBACK, ucReply, sizeof( ucBrokerLatePUBACK ) );
+                        xBrokerLatePUBACKPending = pdTRUE;
+                        xReplyLength = 0;
+                    }
+                }
+
+                if( ( ucType & 0x06U ) != 0U )
+                {
+                    ulOffset += 2U;
+                }
+
+                prvBrokerCheckPayload( &( ucBrokerPacket[ ulOffset ] ), ulLength - ulOffset );
+                break;
+
+            case 0xC0U: /* PINGREQ. */
+                ucReply[ 0 ] = 0xD0U;
+                ucReply[ 1 ] = 0x00U;
+                xReplyLength = 2;
+                break;
+
+            case 0xE0U: /* DISCONNECT. */
+                break;
+
+            default:
+                ulBrokerErrors++;
+                break;
+        }
+
+        if( xReplyLength > 0 )
+        {
+            ( void ) FreeRTOS_send( xBrokerClient, ucReply, xReplyLength, 0 );
+        }
+    }
+
+/**
+ * @brief Accepts a connection from the agent and serves it until stopped.
+ */
+    static void prvBrokerTask( void * pvParameters )
+    {
+        struct freertos_sockaddr xAddress;
+        socklen_t xSize = sizeof( xAddress );
+        TickType_t xTimeout = mqttagenttestBROKER_POLL_TICKS;
+        uint8_t ucHeader[ 2 ];
+        uint32_t ulLength, ulShift;
+        BaseType_t xStatus = pdPASS;
+
+        ( void ) pvParameters;
+
+        while( ( xBrokerClient == NULL ) || ( xBrokerClient == FREERTOS_INVALID_SOCKET ) )
+        {
+            if( xBrokerStop != pdFALSE )
+            {
+                xStatus = pdFAIL;
+                break;
+            }
+
+            xBrokerClient = FreeRTOS_accept( xBrokerListener, &xAddress, &xSize );
+        }
+
+        if( xStatus == pdPASS )
+        {
+            ( void ) FreeRTOS_setsockopt( xBrokerClient, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+        }
+
+        while( xStatus == pdPASS )
+        {
+            /* Do not read while the test wants the agent's socket to fill up. */
+            if( xBrokerStallTicks != 0 )
+            {
+                vTaskDelay( xBrokerStallTicks );
+                xBrokerStallTicks = 0;
+            }
+
+            xStatus = prvBrokerReceive( ucHeader, 1 );
+
+            /* Decode the remaining length. */
+            ulLength = 0;
+            ulShift = 0;
+
+            do
+            {
+                if( xStatus == pdPASS )
+                {
+                    xStatus = prvBrokerReceive( &( ucHeader[ 1 ] ), 1 );
+                    ulLength |= ( uint32_t ) ( ucHeader[ 1 ] & 0x7FU ) << ulShift;
+                    ulShift += 7U;
+                }
+            } while( ( xStatus == pdPASS ) && ( ( ucHeader[ 1 ] & 0x80U ) != 0U ) );
+
+            if( ( xStatus == pdPASS ) && ( ulLength > sizeof( ucBrokerPacket ) ) )
+            {
+                ulBrokerErrors++;
+                xStatus = pdFAIL;
+            }
+
+            if( xStatus == pdPASS )
+            {
+                xStatus = prvBrokerReceive( ucBrokerPacket, ( size_t ) ulLength );
+            }
+
+            if( xStatus == pdPASS )
+            {
+                prvBrokerProcessPacket( ucHeader[ 0 ], ulLength );
+            }
+        }
+
+        /* Tell the test that the broker has finished. A semaphore is used as
+         * the test task receives the notifications of the agent. */
+        ( void ) xSemaphoreGive( xBrokerDone );
+        vTaskDelete( NULL );
+    }
+
+/**
+ * @brief Starts the broker and fills in connect parameters to reach it.
+ */
+    static void prvStartBroker( MQTTAgentConnectParams_t * pxConnectParameters )
+    {
+        struct freertos_sockaddr xAddress;
+        TickType_t xTimeout = mqttagenttestBROKER_POLL_TICKS;
+
+        xBrokerStop = pdFALSE;
+        xBrokerStallTicks = 0;
+        ulBrokerPublishes = 0;
+        ulBrokerErrors = 0;
+        ulBrokerUnackedPublishes = 0;
+        ulBrokerLatePublishes = 0;
+        xBrokerLatePUBACKPending = pdFALSE;
+        xBrokerClient = FREERTOS_INVALID_SOCKET;
+        xBrokerDone = xSemaphoreCreateBinary();
+        TEST_ASSERT_NOT_NULL( xBrokerDone );
+
+        xBrokerListener = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+        TEST_ASSERT_NOT_EQUAL( FREERTOS_INVALID_SOCKET, xBrokerListener );
+        ( void ) FreeRTOS_setsockopt( xBrokerListener, 0, FREERTOS_SO_RCVTIMEO, &xTimeout, sizeof( xTimeout ) );
+        memset( &xAddress, 0x00, sizeof( xAddress ) );
+        xAddress.sin_port = FreeRTOS_htons( mqttagenttestBROKER_PORT );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_bind( xBrokerListener, &xAddress, sizeof( xAddress ) ) );
+        TEST_ASSERT_EQUAL( 0, FreeRTOS_listen( xBrokerListener, 1 ) );
+
+        TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvBrokerTask,
+                                                "Broker",
+                                                mqttagenttestBROKER_STACK_SIZE,
+                                                NULL,
+                                                mqttagenttestBROKER_PRIORITY,
+                                                &xBrokerTask ) );
+
+        FreeRTOS_inet_ntoa( FreeRTOS_GetIPAddress(), cBrokerAddress );
+        memset( pxConnectParameters, 0x00, sizeof( MQTTAgentConnectParams_t ) );
+        pxConnectParameters->pcURL = cBrokerAddress;
+        pxConnectParameters->xFlags = mqttagentURL_IS_IP_ADDRESS;
+        pxConnectParameters->usPort = mqttagenttestBROKER_PORT;
+        pxConnectParameters->pucClientId = ( const uint8_t * ) clientcredentialIOT_THING_NAME;
+        pxConnectParameters->usClientIdLength = ( uint16_t ) strlen( clientcredentialIOT_THING_NAME );
+    }
+
+/**
+ * @brief Stops the broker, if it was started, and waits for it to finish.
+ */
+    static void prvStopBroker( void )
+    {
+        if( xBrokerTask != NULL )
+        {
+            xBrokerStop = pdTRUE;
+            ( void ) xSemaphoreTake( xBrokerDone, mqttagenttestTIMEOUT );
+            xBrokerTask = NULL;
+        }
+
+        if( xBrokerDone != NULL )
+        {
+            vSemaphoreDelete( xBrokerDone );
+            xBrokerDone = NULL;
+        }
+
+        if( ( xBrokerClient != NULL ) && ( xBrokerClient != FREERTOS_INVALID_SOCKET ) )
+        {
+            ( void ) FreeRTOS_closesocket( xBrokerClient );
+        }
+
+        xBrokerClient = FREERTOS_INVALID_SOCKET;
+
+        if( xBrokerListener != FREERTOS_INVALID_SOCKET )
+        {
+            ( void ) FreeRTOS_closesocket( xBrokerListener );
+            xBrokerListener = FREERTOS_INVALID_SOCKET;
+        }
+    }
+
+/**
+ * @brief Sets up the parameters to publish the n-th message of a test to the broker.
+ */
+    static void prvSetUpPublish( MQTTAgentPublishParams_t * pxPublishParameters,
+                                 uint8_t * pucPayload,
+                                 uint32_t ulSequenceNumber,
+                                 uint32_t ulLength,
+                                 MQTTQoS_t xQoS )
+    {
+        uint32_t x;
+
+        for( x = 0; x < ulLength; x++ )
+        {
+            pucPayload[ x ] = ( uint8_t ) ( ulSequenceNumber + x );
+        }
+
+        memset( pxPublishParameters, 0x00, sizeof( MQTTAgentPublishParams_t ) );
+        pxPublishParameters->pucTopic = mqttagenttestTOPIC_NAME;
+        pxPublishParameters->usTopicLength = ( uint16_t ) strlen( ( const char * ) mqttagenttestTOPIC_NAME );
+        pxPublishParameters->pvData = pucPayload;
+        pxPublishParameters->ulDataLength = ulLength;
+        pxPublishParameters->xQoS = xQoS;
+    }
+
+/**
+ * @brief Publishes the n-th message of a test to the broker.
+ */
+    static MQTTAgentReturnCode_t prvPublishToBroker( MQTTAgentHandle_t xMQTTHandle,
+                                                     uint32_t ulSequenceNumber,
+                                                     uint32_t ulLength,
+                                                     MQTTQoS_t xQoS )
+    {
+        MQTTAgentPublishParams_t xPublishParameters;
+
+        prvSetUpPublish( &( xPublishParameters ), ucPayload, ulSequenceNumber, ulLength, xQoS );
+
+        return MQTT_AGENT_Publish( xMQTTHandle, &( xPublishParameters ), mqttagenttestTIMEOUT );
+    }
+
+/**
+ * @brief Sets up a batch of small messages to publish to the broker.
+ *
+ * Message x is the ( ulFirstSequenceNumber + x )-th message of the test and is
+ * published with QoS1 if bit x of ulQoS1Messages is set, with QoS0 otherwise.
+ */
+    static void prvSetUpPublishBatch( MQTTAgentPublishParams_t * pxPublishParameters,
+                                      uint32_t ulNumPublishes,
+                                      uint32_t ulFirstSequenceNumber,
+                                      uint32_t ulQoS1Messages )
+    {
+        uint32_t x;
+
+        for( x = 0; x < ulNumPublishes; x++ )
+        {
+            prvSetUpPublish( &( pxPublishParameters[ x ] ),
+                             ucBatchPayloads[ x % mqttconfigMAX_PUBLISH_BATCH_SIZE ],
+                             ulFirstSequenceNumber + x,
+                             mqttagenttestSMALL_PAYLOAD_SIZE,
+                             ( ( ulQoS1Messages & ( 1UL << x ) ) != 0U ) ? eMQTTQoS1 : eMQTTQoS0 );
+        }
+    }
+
+/**
+ * @brief Waits until the broker has received the given number of publishes.
+ */
+    static BaseType_t prvWaitForBrokerPublishes( uint32_t ulNumPublishes )
+    {
+        TimeOut_t xTimeOut;
+        TickType_t xTicksToWait = mqttagenttestTIMEOUT;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        while( ulBrokerPublishes < ulNumPublishes )
+        {
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                break;
+            }
+
+            vTaskDelay( 1 );
+        }
+
+        return ( ulBrokerPublishes == ulNumPublishes ) ? pdPASS : pdFAIL;
+    }
+
+/**
+ * @brief Publishes the n-th message of a test with QoS1, n being the parameter,
+ * which holds one of the parallel operations of the agent until it completes.
+ */
+    static void prvHelperTask( void * pvParameters )
+    {
+        uint32_t ulIndex = ( uint32_t ) ( uintptr_t ) pvParameters;
+        MQTTAgentPublishParams_t xPublishParameters;
+
+        prvSetUpPublish( &( xPublishParameters ), ucPayload, ulIndex, mqttagenttestSMALL_PAYLOAD_SIZE, eMQTTQoS1 );
+        xHelperResults[ ulIndex ] = MQTT_AGENT_Publish( xHelperMQTTHandle, &( xPublishParameters ), mqttagenttestPUBACK_TIMEOUT );
+
+        ( void ) xSemaphoreGive( xHelpersDone );
+        vTaskDelete( NULL );
+    }
+
+/**
+ * @brief Occupies all the parallel operations of the agent with QoS1 publishes
+ * which the broker does not acknowledge.
+ *
+ * The helper tasks are started one after the other, so that the broker
+ * receives their messages in order.
+ */
+    static void prvStartHelpers( MQTTAgentHandle_t xMQTTHandle )
+    {
+        uint32_t x;
+
+        xHelperMQTTHandle = xMQTTHandle;
+        xHelpersDone = xSemaphoreCreateCounting( mqttconfigMAX_PARALLEL_OPS, 0 );
+        TEST_ASSERT_NOT_NULL( xHelpersDone );
+        ulBrokerUnackedPublishes |= ( 1UL << mqttconfigMAX_PARALLEL_OPS ) - 1UL;
+
+        for( x = 0; x < ( uint32_t ) mqttconfigMAX_PARALLEL_OPS; x++ )
+        {
+            xHelperResults[ x ] = eMQTTAgentFailure;
+            TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvHelperTask,
+                                                    "Helper",
+                                                    mqttagenttestHELPER_STACK_SIZE,
+                                                    ( void * ) ( uintptr_t ) x,
+                                                    mqttagenttestHELPER_PRIORITY,
+                                                    NULL ) );
+            TEST_ASSERT_EQUAL( pdPASS, prvWaitForBrokerPublishes( x + 1U ) );
+        }
+    }
+
+/**
+ * @brief Waits for the helper tasks to finish.
+ */
+    static void prvWaitForHelpers( void )
+    {
+        uint32_t x;
+
+        if( xHelpersDone != NULL )
+        {
+            for( x = 0; x < ( uint32_t ) mqttconfigMAX_PARALLEL_OPS; x++ )
+            {
+                ( void ) xSemaphoreTake( xHelpersDone, mqttagenttestTIMEOUT );
+            }
+
+            vSemaphoreDelete( xHelpersDone );
+            xHelpersDone = NULL;
+        }
+    }
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+
+/**
+ * @brief Records the result of an asynchronous publish, the context being its
+ * sequence number.
+ */
+        static void prvAsyncPublishComplete( void * pvCallbackContext,
+                                             MQTTAgentReturnCode_t xResult )
+        {
+            uint32_t ulSequenceNumber = ( uint32_t ) ( uintptr_t ) pvCallbackContext;
+
+            if( ulSequenceNumber < mqttagenttestASYNC_PUBLISHES )
+            {
+                xAsyncResults[ ulSequenceNumber ] = xResult;
+            }
+
+            ulAsyncCompletions++;
+            ( void ) xSemaphoreGive( xAsyncPublishesDone );
+        }
+
+/**
+ * @brief Clears the results of the asynchronous publishes of a test.
+ */
+        static void prvResetAsyncPublishes( void )
+        {
+            uint32_t x;
+
+            for( x = 0; x < mqttagenttestASYNC_PUBLISHES; x++ )
+            {
+                xAsyncResults[ x ] = eMQTTAgentFailure;
+            }
+
+            ulAsyncCompletions = 0;
+            xAsyncPublishesDone = xSemaphoreCreateCountingStatic( mqttagenttestASYNC_PUBLISHES, 0, &xAsyncPublishesDoneBuffer );
+            TEST_ASSERT_NOT_NULL( xAsyncPublishesDone );
+        }
+
+/**
+ * @brief Starts publishing the n-th message of a test asynchronously.
+ *
+ * The payload must remain valid until the publish completes, so it is stored
+ * in one of the batch payload buffers.
+ */
+        static MQTTAgentReturnCode_t prvPublishAsyncToBroker( MQTTAgentHandle_t xMQTTHandle,
+                                                              uint32_t ulSequenceNumber,
+                                                              MQTTQoS_t xQoS,
+                                                              TickType_t xTimeoutTicks )
+        {
+            MQTTAgentPublishParams_t xPublishParameters;
+
+            prvSetUpPublish( &( xPublishParameters ),
+                             ucBatchPayloads[ ulSequenceNumber % mqttconfigMAX_PUBLISH_BATCH_SIZE ],
+                             ulSequenceNumber,
+                             mqttagenttestSMALL_PAYLOAD_SIZE,
+                             xQoS );
+
+            return MQTT_AGENT_PublishAsync( xMQTTHandle,
+                                            &( xPublishParameters ),
+                                            prvAsyncPublishComplete,
+                                            ( void * ) ( uintptr_t ) ulSequenceNumber,
+                                            xTimeoutTicks );
+        }
+
+/**
+ * @brief Waits until the given number of asynchronous publishes have completed.
+ */
+        static BaseType_t prvWaitForAsyncPublishes( uint32_t ulNumPublishes )
+        {
+            uint32_t x;
+            BaseType_t xStatus = pdPASS;
+
+            for( x = 0; ( x < ulNumPublishes ) && ( xStatus == pdPASS ); x++ )
+            {
+                if( xSemaphoreTake( xAsyncPublishesDone, mqttagenttestTIMEOUT ) != pdTRUE )
+                {
+                    xStatus = pdFAIL;
+                }
+            }
+
+            return xStatus;
+        }
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
+/*-----------------------------------------------------------*/
+
 /* Define Test Group. */
 TEST_GROUP( Full_MQTT_Agent );
 TEST_GROUP( Full_MQTT_Agent_ALPN );
@@ -351,6 +974,10 @@ TEST_SETUP( Full_MQTT_Agent_ALPN )
  */
 TEST_TEAR_DOWN( Full_MQTT_Agent )
 {
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        prvWaitForHelpers();
+        prvStopBroker();
+    #endif
 }
 TEST_TEAR_DOWN( Full_MQTT_Agent_Stress_Tests )
 {
@@ -365,8 +992,28 @@ TEST_TEAR_DOWN( Full_MQTT_Agent_ALPN )
  */
 TEST_GROUP_RUNNER( Full_MQTT_Agent )
 {
-    RUN_TEST_CASE( Full_MQTT_Agent, AFQP_MQTT_Agent_SubscribePublishDefaultPort );
-    RUN_TEST_CASE( Full_MQTT_Agent, AFQP_MQTT_Agent_InvalidCredentials );
+    /* The loopback interface cannot reach the AWS IoT broker, so the tests
+     * then use the broker running on this node instead. */
+    #if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+        RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_FullSocketKeepsConnection );
+        RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishBatchReportsEachResult );
+        RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishBatchMixedQoS );
+        RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishBatchTooLarge );
+        RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishBatchNoFreeOperation );
+        #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+            RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishAsyncCompletesOnPUBACK );
+            RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishAsyncWindowLimit );
+            RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishAsyncIgnoresLatePUBACK );
+            RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishAsyncFailsOnDisconnect );
+
+            #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+                RUN_TEST_CASE( Full_MQTT_Agent, MQTT_Agent_PublishAsyncZeroCopy );
+            #endif
+        #endif
+    #else
+        RUN_TEST_CASE( Full_MQTT_Agent, AFQP_MQTT_Agent_SubscribePublishDefaultPort );
+        RUN_TEST_CASE( Full_MQTT_Agent, AFQP_MQTT_Agent_InvalidCredentials );
+    #endif
 }
 TEST_GROUP_RUNNER( Full_MQTT_Agent_Stress_Tests )
 {
@@ -442,6 +1089,467 @@ TEST( Full_MQTT_Agent, AFQP_MQTT_Agent_InvalidCredentials )
 }
 /*-----------------------------------------------------------*/
 
+
+#if ( configNETWORK_INTERFACE_LOOPBACK == 1 )
+
+/* A socket which cannot accept more data does not break the connection, and
+ * packets smaller and larger than the Tx buffer of the agent are partially
+ * sent and queued until the broker reads again. */
+    TEST( Full_MQTT_Agent, MQTT_Agent_FullSocketKeepsConnection )
+    {
+        MQTTAgentHandle_t xMQTTHandle = NULL;
+        MQTTAgentConnectParams_t xConnectParameters;
+        TickType_t xStallStart;
+        uint32_t x;
+
+        prvStartBroker( &xConnectParameters );
+
+        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+        if( TEST_PROTECT() )
+        {
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+            /* Publish more than the sockets can hold while the broker does not
+             * read. The last messages can only be sent once it reads again. */
+            xStallStart = xTaskGetTickCount();
+            xBrokerStallTicks = mqttagenttestBROKER_STALL_TICKS;
+
+            for( x = 0; x < mqttagenttestSTALLED_PUBLISHES; x++ )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess,
+                                       prvPublishToBroker( xMQTTHandle,
+                                                           x,
+                                                           ( ( x & 1U ) == 0U ) ? mqttagenttestSMALL_PAYLOAD_SIZE : mqttagenttestLARGE_PAYLOAD_SIZE,
+                                                           eMQTTQoS0 ) );
+            }
+
+            TEST_ASSERT_TRUE( ( xTaskGetTickCount() - xStallStart ) >= mqttagenttestBROKER_STALL_TICKS );
+
+            /* The connection is still up and the broker acknowledges. */
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishToBroker( xMQTTHandle, x, mqttagenttestLARGE_PAYLOAD_SIZE, eMQTTQoS1 ) );
+            TEST_ASSERT_EQUAL_UINT32( mqttagenttestSTALLED_PUBLISHES + 1U, ulBrokerPublishes );
+            TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+        }
+
+        ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+    }
+/*-----------------------------------------------------------*/
+
+/* The result of every message of a batch is reported, and a QoS1 message
+ * which is not acknowledged does not fail the others. */
+    TEST( Full_MQTT_Agent, MQTT_Agent_PublishBatchReportsEachResult )
+    {
+        MQTTAgentHandle_t xMQTTHandle = NULL;
+        MQTTAgentConnectParams_t xConnectParameters;
+        MQTTAgentPublishParams_t xPublishParameters[ 4 ];
+        MQTTAgentReturnCode_t xResults[ 4 ];
+
+        prvStartBroker( &xConnectParameters );
+
+        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+        if( TEST_PROTECT() )
+        {
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+            /* The third message is never acknowledged. */
+            ulBrokerUnackedPublishes = 1UL << 2;
+            prvSetUpPublishBatch( xPublishParameters, 4, 0, 0xFU );
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentTimeout, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, 4, mqttagenttestPUBACK_TIMEOUT ) );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 0 ] );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 1 ] );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentTimeout, xResults[ 2 ] );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 3 ] );
+
+            /* The connection is still usable. */
+            prvSetUpPublishBatch( xPublishParameters, 2, 4, 0x3U );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, 2, mqttagenttestTIMEOUT ) );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 0 ] );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 1 ] );
+
+            TEST_ASSERT_EQUAL_UINT32( 6, ulBrokerPublishes );
+            TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+        }
+
+        ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+    }
+/*-----------------------------------------------------------*/
+
+/* A batch mixing QoS0 and QoS1 messages completes once all of them are sent
+ * and acknowledged, and a batch of QoS0 messages only completes as well. */
+    TEST( Full_MQTT_Agent, MQTT_Agent_PublishBatchMixedQoS )
+    {
+        MQTTAgentHandle_t xMQTTHandle = NULL;
+        MQTTAgentConnectParams_t xConnectParameters;
+        MQTTAgentPublishParams_t xPublishParameters[ mqttconfigMAX_PUBLISH_BATCH_SIZE ];
+        MQTTAgentReturnCode_t xResults[ mqttconfigMAX_PUBLISH_BATCH_SIZE ];
+        uint32_t x;
+
+        prvStartBroker( &xConnectParameters );
+
+        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+        if( TEST_PROTECT() )
+        {
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+            /* Every other message is QoS1, starting with a QoS0 one. */
+            prvSetUpPublishBatch( xPublishParameters, mqttconfigMAX_PUBLISH_BATCH_SIZE, 0, 0xAAAAAAAAUL );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, mqttconfigMAX_PUBLISH_BATCH_SIZE, mqttagenttestTIMEOUT ) );
+
+            for( x = 0; x < ( uint32_t ) mqttconfigMAX_PUBLISH_BATCH_SIZE; x++ )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ x ] );
+            }
+
+            TEST_ASSERT_EQUAL_UINT32( mqttconfigMAX_PUBLISH_BATCH_SIZE, ulBrokerPublishes );
+
+            /* Only QoS0 messages. */
+            prvSetUpPublishBatch( xPublishParameters, 4, mqttconfigMAX_PUBLISH_BATCH_SIZE, 0 );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, 4, mqttagenttestTIMEOUT ) );
+
+            for( x = 0; x < 4; x++ )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ x ] );
+            }
+
+            TEST_ASSERT_EQUAL( pdPASS, prvWaitForBrokerPublishes( mqttconfigMAX_PUBLISH_BATCH_SIZE + 4U ) );
+            TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+        }
+
+        ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+    }
+/*-----------------------------------------------------------*/
+
+/* A batch of more than mqttconfigMAX_PUBLISH_BATCH_SIZE messages, or of none,
+ * is rejected without publishing anything. */
+    TEST( Full_MQTT_Agent, MQTT_Agent_PublishBatchTooLarge )
+    {
+        MQTTAgentHandle_t xMQTTHandle = NULL;
+        MQTTAgentConnectParams_t xConnectParameters;
+        MQTTAgentPublishParams_t xPublishParameters[ mqttconfigMAX_PUBLISH_BATCH_SIZE + 1 ];
+        MQTTAgentReturnCode_t xResults[ mqttconfigMAX_PUBLISH_BATCH_SIZE + 1 ];
+
+        prvStartBroker( &xConnectParameters );
+
+        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+        if( TEST_PROTECT() )
+        {
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+            prvSetUpPublishBatch( xPublishParameters, mqttconfigMAX_PUBLISH_BATCH_SIZE + 1, 0, 0 );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, mqttconfigMAX_PUBLISH_BATCH_SIZE + 1, mqttagenttestTIMEOUT ) );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, 0, mqttagenttestTIMEOUT ) );
+
+            /* Nothing was published, so this is the first message of the test. */
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishToBroker( xMQTTHandle, 0, mqttagenttestSMALL_PAYLOAD_SIZE, eMQTTQoS1 ) );
+            TEST_ASSERT_EQUAL_UINT32( 1, ulBrokerPublishes );
+            TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+        }
+
+        ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+    }
+/*-----------------------------------------------------------*/
+
+/* A batch with QoS1 messages fails if all the parallel operations are in use,
+ * while a batch of QoS0 messages, which does not need one, still succeeds. */
+    TEST( Full_MQTT_Agent, MQTT_Agent_PublishBatchNoFreeOperation )
+    {
+        MQTTAgentHandle_t xMQTTHandle = NULL;
+        MQTTAgentConnectParams_t xConnectParameters;
+        MQTTAgentPublishParams_t xPublishParameters[ 2 ];
+        MQTTAgentReturnCode_t xResults[ 2 ];
+        uint32_t x;
+
+        prvStartBroker( &xConnectParameters );
+
+        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+        if( TEST_PROTECT() )
+        {
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+            prvStartHelpers( xMQTTHandle );
+
+            prvSetUpPublishBatch( xPublishParameters, 2, mqttconfigMAX_PARALLEL_OPS, 0x2U );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, 2, mqttagenttestTIMEOUT ) );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, xResults[ 0 ] );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, xResults[ 1 ] );
+
+            prvSetUpPublishBatch( xPublishParameters, 2, mqttconfigMAX_PARALLEL_OPS, 0 );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_PublishBatch( xMQTTHandle, xPublishParameters, xResults, 2, mqttagenttestTIMEOUT ) );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 0 ] );
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xResults[ 1 ] );
+
+            /* The publishes of the helpers time out. */
+            prvWaitForHelpers();
+
+            for( x = 0; x < ( uint32_t ) mqttconfigMAX_PARALLEL_OPS; x++ )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentTimeout, xHelperResults[ x ] );
+            }
+
+            TEST_ASSERT_EQUAL( pdPASS, prvWaitForBrokerPublishes( mqttconfigMAX_PARALLEL_OPS + 2U ) );
+            TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+        }
+
+        ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( mqttconfigMAX_ASYNC_PUBLISHES > 0 )
+
+/* An asynchronous QoS0 publish completes once sent, and a QoS1 publish once
+ * its PUBACK is received. */
+        TEST( Full_MQTT_Agent, MQTT_Agent_PublishAsyncCompletesOnPUBACK )
+        {
+            MQTTAgentHandle_t xMQTTHandle = NULL;
+            MQTTAgentConnectParams_t xConnectParameters;
+            uint32_t x;
+
+            prvStartBroker( &xConnectParameters );
+            prvResetAsyncPublishes();
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+            if( TEST_PROTECT() )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+                /* Every other message is QoS1, starting with a QoS1 one. */
+                for( x = 0; x < ( uint32_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess,
+                                           prvPublishAsyncToBroker( xMQTTHandle,
+                                                                    x,
+                                                                    ( ( x & 1U ) == 0U ) ? eMQTTQoS1 : eMQTTQoS0,
+                                                                    mqttagenttestTIMEOUT ) );
+                }
+
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( mqttconfigMAX_ASYNC_PUBLISHES ) );
+
+                for( x = 0; x < ( uint32_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xAsyncResults[ x ] );
+                }
+
+                TEST_ASSERT_EQUAL_UINT32( mqttconfigMAX_ASYNC_PUBLISHES, ulBrokerPublishes );
+                TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+                TEST_ASSERT_EQUAL_UINT32( mqttconfigMAX_ASYNC_PUBLISHES, ulAsyncCompletions );
+            }
+
+            ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+        }
+/*-----------------------------------------------------------*/
+
+/* No more than mqttconfigMAX_ASYNC_PUBLISHES publishes are in flight. The ones
+ * which are not acknowledged time out, after which the window is free again. */
+        TEST( Full_MQTT_Agent, MQTT_Agent_PublishAsyncWindowLimit )
+        {
+            MQTTAgentHandle_t xMQTTHandle = NULL;
+            MQTTAgentConnectParams_t xConnectParameters;
+            uint32_t x;
+
+            prvStartBroker( &xConnectParameters );
+            prvResetAsyncPublishes();
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+            if( TEST_PROTECT() )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+                ulBrokerUnackedPublishes = ( 1UL << mqttconfigMAX_ASYNC_PUBLISHES ) - 1UL;
+
+                for( x = 0; x < ( uint32_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishAsyncToBroker( xMQTTHandle, x, eMQTTQoS1, mqttagenttestPUBACK_TIMEOUT ) );
+                }
+
+                /* The window is full. */
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, prvPublishAsyncToBroker( xMQTTHandle, x, eMQTTQoS1, mqttagenttestPUBACK_TIMEOUT ) );
+
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( mqttconfigMAX_ASYNC_PUBLISHES ) );
+
+                for( x = 0; x < ( uint32_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentTimeout, xAsyncResults[ x ] );
+                }
+
+                /* The rejected publish did not reach the broker, so the next
+                 * message is acknowledged. */
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishAsyncToBroker( xMQTTHandle, x, eMQTTQoS1, mqttagenttestTIMEOUT ) );
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( 1 ) );
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xAsyncResults[ x ] );
+
+                TEST_ASSERT_EQUAL_UINT32( mqttconfigMAX_ASYNC_PUBLISHES + 1U, ulBrokerPublishes );
+                TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+                TEST_ASSERT_EQUAL_UINT32( mqttconfigMAX_ASYNC_PUBLISHES + 1U, ulAsyncCompletions );
+            }
+
+            ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+        }
+/*-----------------------------------------------------------*/
+
+/* A PUBACK received after its publish timed out completes nothing, neither
+ * the publish which now uses the same entry of the window nor a blocking one. */
+        TEST( Full_MQTT_Agent, MQTT_Agent_PublishAsyncIgnoresLatePUBACK )
+        {
+            MQTTAgentHandle_t xMQTTHandle = NULL;
+            MQTTAgentConnectParams_t xConnectParameters;
+
+            prvStartBroker( &xConnectParameters );
+            prvResetAsyncPublishes();
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+            if( TEST_PROTECT() )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+                /* The PUBACK of the first message arrives with the second one's. */
+                ulBrokerLatePublishes = 1UL;
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishAsyncToBroker( xMQTTHandle, 0, eMQTTQoS1, mqttagenttestPUBACK_TIMEOUT ) );
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( 1 ) );
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentTimeout, xAsyncResults[ 0 ] );
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishAsyncToBroker( xMQTTHandle, 1, eMQTTQoS1, mqttagenttestTIMEOUT ) );
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( 1 ) );
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xAsyncResults[ 1 ] );
+
+                /* A blocking publish is only completed by its own PUBACK. */
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishToBroker( xMQTTHandle, 2, mqttagenttestSMALL_PAYLOAD_SIZE, eMQTTQoS1 ) );
+
+                TEST_ASSERT_EQUAL_UINT32( 3, ulBrokerPublishes );
+                TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+                TEST_ASSERT_EQUAL_UINT32( 2, ulAsyncCompletions );
+            }
+
+            ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+        }
+/*-----------------------------------------------------------*/
+
+/* The publishes waiting for a PUBACK fail when the connection is closed. */
+        TEST( Full_MQTT_Agent, MQTT_Agent_PublishAsyncFailsOnDisconnect )
+        {
+            MQTTAgentHandle_t xMQTTHandle = NULL;
+            MQTTAgentConnectParams_t xConnectParameters;
+            uint32_t x;
+
+            prvStartBroker( &xConnectParameters );
+            prvResetAsyncPublishes();
+
+            TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+            if( TEST_PROTECT() )
+            {
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+                ulBrokerUnackedPublishes = ( 1UL << mqttconfigMAX_ASYNC_PUBLISHES ) - 1UL;
+
+                for( x = 0; x < ( uint32_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishAsyncToBroker( xMQTTHandle, x, eMQTTQoS1, mqttagenttestTIMEOUT ) );
+                }
+
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForBrokerPublishes( mqttconfigMAX_ASYNC_PUBLISHES ) );
+                TEST_ASSERT_EQUAL_UINT32( 0, ulAsyncCompletions );
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+                TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( mqttconfigMAX_ASYNC_PUBLISHES ) );
+
+                for( x = 0; x < ( uint32_t ) mqttconfigMAX_ASYNC_PUBLISHES; x++ )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentFailure, xAsyncResults[ x ] );
+                }
+
+                TEST_ASSERT_EQUAL_UINT32( mqttconfigMAX_ASYNC_PUBLISHES, ulAsyncCompletions );
+                TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+            }
+
+            ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+/* Asynchronous publishes are sent from the caller's payload, so they are not
+ * limited by the buffer pool, and a payload which the socket only partially
+ * accepts is sent completely and in order. */
+            TEST( Full_MQTT_Agent, MQTT_Agent_PublishAsyncZeroCopy )
+            {
+                MQTTAgentHandle_t xMQTTHandle = NULL;
+                MQTTAgentConnectParams_t xConnectParameters;
+                MQTTAgentPublishParams_t xPublishParameters;
+                uint32_t x;
+
+                prvStartBroker( &xConnectParameters );
+                prvResetAsyncPublishes();
+
+                TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Create( &xMQTTHandle ) );
+
+                if( TEST_PROTECT() )
+                {
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Connect( xMQTTHandle, &xConnectParameters, mqttagenttestTIMEOUT ) );
+
+                    /* The broker does not read while the payloads are sent. */
+                    xBrokerStallTicks = mqttagenttestBROKER_STALL_TICKS;
+
+                    for( x = 0; x < mqttagenttestZERO_COPY_PUBLISHES; x++ )
+                    {
+                        prvSetUpPublish( &( xPublishParameters ), ucZeroCopyPayloads[ x ], x, mqttagenttestZERO_COPY_PAYLOAD_SIZE, eMQTTQoS1 );
+                        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess,
+                                               MQTT_AGENT_PublishAsync( xMQTTHandle,
+                                                                        &( xPublishParameters ),
+                                                                        prvAsyncPublishComplete,
+                                                                        ( void * ) ( uintptr_t ) x,
+                                                                        mqttagenttestTIMEOUT ) );
+                    }
+
+                    TEST_ASSERT_EQUAL( pdPASS, prvWaitForAsyncPublishes( mqttagenttestZERO_COPY_PUBLISHES ) );
+
+                    for( x = 0; x < mqttagenttestZERO_COPY_PUBLISHES; x++ )
+                    {
+                        TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, xAsyncResults[ x ] );
+                    }
+
+                    /* The packets that follow are not corrupted either. */
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, prvPublishToBroker( xMQTTHandle, x, mqttagenttestSMALL_PAYLOAD_SIZE, eMQTTQoS1 ) );
+
+                    TEST_ASSERT_EQUAL_UINT32( mqttagenttestZERO_COPY_PUBLISHES + 1U, ulBrokerPublishes );
+                    TEST_ASSERT_EQUAL_UINT32( 0, ulBrokerErrors );
+
+                    TEST_ASSERT_EQUAL_INT( eMQTTAgentSuccess, MQTT_AGENT_Disconnect( xMQTTHandle, mqttagenttestTIMEOUT ) );
+                    TEST_ASSERT_EQUAL_UINT32( mqttagenttestZERO_COPY_PUBLISHES, ulAsyncCompletions );
+                }
+
+                ( void ) MQTT_AGENT_Delete( xMQTTHandle );
+            }
+/*-----------------------------------------------------------*/
+        #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+    #endif /* mqttconfigMAX_ASYNC_PUBLISHES */
+
+#endif /* configNETWORK_INTERFACE_LOOPBACK == 1 */
 /* Test for ping-ponging a message using AWS IoT MQTT broker support for port 443. */
 TEST( Full_MQTT_Agent_ALPN, MQTT_Agent_SubscribePublishAlpn )
 {
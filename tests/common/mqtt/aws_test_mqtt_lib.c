@@ -29,6 +29,7 @@
  */
 
 /* Standard includes. */
+#include <stdint.h>
 #include <string.h>
 
 /* Unity framework includes. */
@@ -41,6 +42,7 @@
 
 /* Bufferpool includes. */
 #include "aws_bufferpool.h"
+#include "aws_bufferpool_config.h"
 
 /**
  * @brief The callback context registered with the MQTT Core library.
@@ -79,6 +81,11 @@
  * @brief MQTT Control packet flags.
  */
 #define mqttFLAGS_CONNACK                     ( ( uint8_t ) 0 ) /**< Reserved. */
+
+/**
+ * @brief Packet ID of the zero-copy publish message.
+ */
+#define testmqttlibPUBLISH_PACKET_ID          ( 2 )
 /*-----------------------------------------------------------*/
 
 /**
@@ -90,7 +97,12 @@ typedef struct CallbackCounter
     uint32_t ulConnACK;           /**< Number of times the callback is invoked for CONNACK message. */
     uint32_t ulUnexpectedConnACK; /**< Number of times the callback is invoked for unexpected CONNACK messages. */
     uint32_t ulDisconnect;        /**< Number of times the callback is invoked for disconnect message. */
+    uint32_t ulPubACK;            /**< Number of times the callback is invoked for PUBACK message. */
     uint32_t ulUnidentified;      /**< Number of times the callback is invoked for un-handled events. */
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        uint32_t ulStreamHeader;  /**< Number of times the callback is invoked for the header of a streamed publish message. */
+        uint32_t ulStreamChunk;   /**< Number of times the callback is invoked for a part of a streamed publish payload. */
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 } CallbackCounter_t;
 /*-----------------------------------------------------------*/
 
@@ -99,10 +111,81 @@ typedef struct CallbackCounter
  */
 static MQTTContext_t xMQTTContext;
 
+/**
+ * @brief Number of subscription callback contexts tracked by the tests.
+ */
+#define testmqttlibSUBSCRIPTION_CONTEXTS    ( 5 )
+
+/**
+ * @brief Number of times the subscription callback is invoked for each
+ * subscription context.
+ */
+static uint32_t ulSubscriptionCallbackCount[ testmqttlibSUBSCRIPTION_CONTEXTS ];
+
+/**
+ * @brief The subscription context for which the subscription callback takes
+ * the ownership of the buffer.
+ */
+static uint32_t ulSubscriptionOwnershipContext = testmqttlibSUBSCRIPTION_CONTEXTS;
+
 /**
  * @brief Callback counter used by all the tests.
  */
 static CallbackCounter_t xCallbackCounter;
+
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+/**
+ * @brief The payload published by the zero-copy publish tests.
+ *
+ * It is larger than a buffer pool buffer to ensure that it is never copied.
+ */
+    static uint8_t ucZeroCopyPayload[ bufferpoolconfigBUFFER_SIZE * 2 ];
+
+/**
+ * @brief The payload reported in the last PUBACK event.
+ */
+    static const void * pvPubACKPayload;
+
+/**
+ * @brief Number of times the vectored send callback is invoked.
+ */
+    static uint32_t ulSendvCount;
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+/**
+ * @brief The topic of the publish messages received by the streaming tests.
+ */
+    #define testmqttlibSTREAM_TOPIC              "aws/iot/stream"
+
+/**
+ * @brief The payload length of the publish messages received by the streaming
+ * tests.
+ *
+ * It is larger than a buffer pool buffer so that the message is streamed.
+ */
+    #define testmqttlibSTREAM_PAYLOAD_LENGTH     ( bufferpoolconfigBUFFER_SIZE * 2 )
+
+/**
+ * @brief The number of bytes passed to MQTT_ParseReceivedData at a time by
+ * the streaming tests.
+ */
+    #define testmqttlibSTREAM_RECEIVE_LENGTH     ( 100 )
+
+/**
+ * @brief The number of payload bytes reported so far in
+ * eMQTTPublishStreamChunk events.
+ */
+    static uint32_t ulStreamedPayloadLength;
+
+/**
+ * @brief The last packet sent through prvSendCallback, truncated to four
+ * bytes which is enough to hold a PUBACK.
+ */
+    static uint8_t ucLastSentPacket[ 4 ];
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 /*-----------------------------------------------------------*/
 
 /**
@@ -158,6 +241,47 @@ static uint32_t prvSendFailedCallback( void * pvSendContext,
                                        const uint8_t * const pucData,
                                        uint32_t ulDataLength );
 
+/**
+ * @brief The vectored send callback registered with the MQTT library.
+ *
+ * Counts the invocations, checks that a zero-copy publish references
+ * ucZeroCopyPayload in place and mimics a successful send.
+ *
+ * @param[in] pvSendContext The send context as supplied in Init parameters.
+ * @param[in] pxVectors The pieces of data to transmit.
+ * @param[in] ulVectorCount The number of entries in pxVectors.
+ *
+ * @return The total number of bytes actually transmitted.
+ */
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+    static uint32_t prvSendvCallback( void * pvSendContext,
+                                      const MQTTSendVector_t * const pxVectors,
+                                      uint32_t ulVectorCount );
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+/**
+ * @brief The publish callback registered with the subscription manager.
+ *
+ * Counts the invocations per subscription context, which is the index into
+ * ulSubscriptionCallbackCount.
+ *
+ * @param[in] pvPublishCallbackContext The context supplied while storing the subscription.
+ * @param[in] pxPublishData The received publish data.
+ *
+ * @return eMQTTTrue if the context is ulSubscriptionOwnershipContext, eMQTTFalse otherwise.
+ */
+static MQTTBool_t prvSubscriptionCallback( void * pvPublishCallbackContext,
+                                           const MQTTPublishData_t * const pxPublishData );
+
+/**
+ * @brief Stores the subscriptions used by the prvInvokeSubscriptionCallbacks
+ * tests and resets their callback counters.
+ *
+ * The subscription context of each subscription is the index of its topic
+ * filter.
+ */
+static void prvStoreTestSubscriptions( void );
+
 /**
  * @brief Initializes the global callback counter object.
  */
@@ -184,11 +308,30 @@ static MQTTReturnCode_t prvSendMQTTConnect( void );
  * @return The return value of MQTT_ParseReceivedData.
  */
 static MQTTReturnCode_t prvReceiveMQTTConnACK( void );
+
+/**
+ * @brief Mimics receiving a publish message larger than any pool buffer by
+ * passing it to MQTT_ParseReceivedData in pieces of
+ * testmqttlibSTREAM_RECEIVE_LENGTH bytes.
+ *
+ * The topic is testmqttlibSTREAM_TOPIC and each payload byte is its offset.
+ *
+ * @param[in] ucQos The QoS bits of the publish message.
+ *
+ * @return The return value of the last call to MQTT_ParseReceivedData.
+ */
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+    static MQTTReturnCode_t prvReceiveStreamedPublish( uint8_t ucQos );
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 /*-----------------------------------------------------------*/
 
 static MQTTBool_t prvMQTTEventCallback( void * pvCallbackContext,
                                         const MQTTEventCallbackParams_t * const pxParams )
 {
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        uint32_t ulIndex;
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
     /* Ensure that the correct callback context was supplied
      * back by the library. */
     TEST_ASSERT_EQUAL( pvCallbackContext, testmqttlibCALLBACK_CONTEXT );
@@ -213,6 +356,50 @@ static MQTTBool_t prvMQTTEventCallback( void * pvCallbackContext,
 
             break;
 
+        case eMQTTPubACK:
+            xCallbackCounter.ulPubACK += 1;
+
+            /* Ensure that correct identifier was passed. */
+            TEST_ASSERT_EQUAL( pxParams->u.xMQTTPubACKData.usPacketIdentifier, testmqttlibPUBLISH_PACKET_ID );
+
+            #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+                pvPubACKPayload = pxParams->u.xMQTTPubACKData.pvData;
+            #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+            break;
+
+            #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+                case eMQTTPublishStreamHeader:
+                    xCallbackCounter.ulStreamHeader += 1;
+
+                    /* Ensure that the topic and the payload length were decoded. */
+                    TEST_ASSERT_EQUAL( strlen( testmqttlibSTREAM_TOPIC ), pxParams->u.xPublishData.usTopicLength );
+                    TEST_ASSERT_EQUAL_MEMORY( testmqttlibSTREAM_TOPIC, pxParams->u.xPublishData.pucTopic, pxParams->u.xPublishData.usTopicLength );
+                    TEST_ASSERT_EQUAL( testmqttlibSTREAM_PAYLOAD_LENGTH, pxParams->u.xPublishData.ulDataLength );
+                    TEST_ASSERT_NULL( pxParams->u.xPublishData.xBuffer );
+
+                    break;
+
+                case eMQTTPublishStreamChunk:
+                    xCallbackCounter.ulStreamChunk += 1;
+
+                    /* Ensure that the chunks are reported in order and contain
+                     * the payload pattern i.e. each byte is its offset. */
+                    TEST_ASSERT_EQUAL( ulStreamedPayloadLength, pxParams->u.xPublishChunkData.ulChunkOffset );
+                    TEST_ASSERT_EQUAL( testmqttlibSTREAM_PAYLOAD_LENGTH, pxParams->u.xPublishChunkData.ulDataLength );
+                    TEST_ASSERT_EQUAL_MEMORY( testmqttlibSTREAM_TOPIC, pxParams->u.xPublishChunkData.pucTopic, pxParams->u.xPublishChunkData.usTopicLength );
+
+                    for( ulIndex = 0; ulIndex < pxParams->u.xPublishChunkData.ulChunkLength; ulIndex++ )
+                    {
+                        TEST_ASSERT_EQUAL_HEX8( ( uint8_t ) ( ulStreamedPayloadLength + ulIndex ),
+                                                ( ( const uint8_t * ) pxParams->u.xPublishChunkData.pvChunk )[ ulIndex ] );
+                    }
+
+                    ulStreamedPayloadLength += pxParams->u.xPublishChunkData.ulChunkLength;
+
+                    break;
+            #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
         default:
             xCallbackCounter.ulUnidentified += 1;
 
@@ -232,6 +419,10 @@ static uint32_t prvSendCallback( void * pvSendContext,
     /* Ensure that the correct context was supplied by the library. */
     TEST_ASSERT_EQUAL( pvSendContext, testmqttlibSEND_CONTEXT );
 
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        memcpy( ucLastSentPacket, pucData, ( ulDataLength < sizeof( ucLastSentPacket ) ) ? ulDataLength : sizeof( ucLastSentPacket ) );
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+
     /* Mimic that everything was sent successfully. */
     return ulDataLength;
 }
@@ -249,12 +440,61 @@ static uint32_t prvSendFailedCallback( void * pvSendContext,
 }
 /*-----------------------------------------------------------*/
 
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+    static uint32_t prvSendvCallback( void * pvSendContext,
+                                      const MQTTSendVector_t * const pxVectors,
+                                      uint32_t ulVectorCount )
+    {
+        uint32_t x, ulDataLength = 0;
+
+        /* Ensure that the correct context was supplied by the library. */
+        TEST_ASSERT_EQUAL( pvSendContext, testmqttlibSEND_CONTEXT );
+
+        /* The headers are followed by the payload referenced in place. */
+        TEST_ASSERT_EQUAL( 2, ulVectorCount );
+        TEST_ASSERT_EQUAL_PTR( ucZeroCopyPayload, pxVectors[ 1 ].pucData );
+        TEST_ASSERT_EQUAL( sizeof( ucZeroCopyPayload ), pxVectors[ 1 ].ulDataLength );
+
+        for( x = 0; x < ulVectorCount; x++ )
+        {
+            ulDataLength += pxVectors[ x ].ulDataLength;
+        }
+
+        ulSendvCount += 1;
+
+        /* Mimic that everything was sent successfully. */
+        return ulDataLength;
+    }
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+/*-----------------------------------------------------------*/
+
+static MQTTBool_t prvSubscriptionCallback( void * pvPublishCallbackContext,
+                                           const MQTTPublishData_t * const pxPublishData )
+{
+    uint32_t ulContext = ( uint32_t ) ( uintptr_t ) pvPublishCallbackContext;
+
+    ( void ) pxPublishData;
+
+    TEST_ASSERT_LESS_THAN( testmqttlibSUBSCRIPTION_CONTEXTS, ulContext );
+    ulSubscriptionCallbackCount[ ulContext ] += 1;
+
+    return ( ulContext == ulSubscriptionOwnershipContext ) ? eMQTTTrue : eMQTTFalse;
+}
+/*-----------------------------------------------------------*/
+
 static void prvInitializeCallbackCounter( void )
 {
     xCallbackCounter.ulConnACK = 0;
     xCallbackCounter.ulUnexpectedConnACK = 0;
     xCallbackCounter.ulDisconnect = 0;
+    xCallbackCounter.ulPubACK = 0;
     xCallbackCounter.ulUnidentified = 0;
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        xCallbackCounter.ulStreamHeader = 0;
+        xCallbackCounter.ulStreamChunk = 0;
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 }
 /*-----------------------------------------------------------*/
 
@@ -268,6 +508,9 @@ static MQTTReturnCode_t prvInitializeMQTTContext( void )
     xInitParams.pvCallbackContext = testmqttlibCALLBACK_CONTEXT;
     xInitParams.pvSendContext = testmqttlibSEND_CONTEXT;
     xInitParams.pxMQTTSendFxn = &( prvSendCallback );
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        xInitParams.pxMQTTSendvFxn = NULL;
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
     xInitParams.pxGetTicksFxn = NULL;
     xInitParams.xBufferPoolInterface.pxGetBufferFxn = BUFFERPOOL_GetFreeBuffer;
     xInitParams.xBufferPoolInterface.pxReturnBufferFxn = BUFFERPOOL_ReturnBuffer;
@@ -323,6 +566,89 @@ static MQTTReturnCode_t prvReceiveMQTTConnACK( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+    static MQTTReturnCode_t prvReceiveStreamedPublish( uint8_t ucQos )
+    {
+        MQTTReturnCode_t xReturnCode = eMQTTSuccess;
+        static uint8_t ucPublishMessage[ 5 + 2 + sizeof( testmqttlibSTREAM_TOPIC ) + 2 + testmqttlibSTREAM_PAYLOAD_LENGTH ];
+        uint32_t ulRemainingLength, ulLength = 0, ulIndex;
+
+        ulRemainingLength = 2 + ( uint32_t ) strlen( testmqttlibSTREAM_TOPIC ) + ( ( ucQos != 0 ) ? 2 : 0 ) + testmqttlibSTREAM_PAYLOAD_LENGTH;
+
+        /* Fixed header with the encoded "Remaining Length". */
+        ucPublishMessage[ ulLength++ ] = ( uint8_t ) ( 0x30 | ( ucQos << 1 ) );
+
+        do
+        {
+            ucPublishMessage[ ulLength ] = ( uint8_t ) ( ulRemainingLength & 0x7F );
+            ulRemainingLength >>= 7;
+
+            if( ulRemainingLength > 0 )
+            {
+                ucPublishMessage[ ulLength ] |= 0x80;
+            }
+
+            ulLength++;
+        } while( ulRemainingLength > 0 );
+
+        /* Topic. */
+        ucPublishMessage[ ulLength++ ] = 0;
+        ucPublishMessage[ ulLength++ ] = ( uint8_t ) strlen( testmqttlibSTREAM_TOPIC );
+        memcpy( &( ucPublishMessage[ ulLength ] ), testmqttlibSTREAM_TOPIC, strlen( testmqttlibSTREAM_TOPIC ) );
+        ulLength += ( uint32_t ) strlen( testmqttlibSTREAM_TOPIC );
+
+        /* Packet identifier. */
+        if( ucQos != 0 )
+        {
+            ucPublishMessage[ ulLength++ ] = 0;
+            ucPublishMessage[ ulLength++ ] = testmqttlibPUBLISH_PACKET_ID;
+        }
+
+        /* Payload. */
+        for( ulIndex = 0; ulIndex < testmqttlibSTREAM_PAYLOAD_LENGTH; ulIndex++ )
+        {
+            ucPublishMessage[ ulLength++ ] = ( uint8_t ) ulIndex;
+        }
+
+        /* Receive the message in pieces. */
+        for( ulIndex = 0; ( ulIndex < ulLength ) && ( xReturnCode == eMQTTSuccess ); ulIndex += testmqttlibSTREAM_RECEIVE_LENGTH )
+        {
+            xReturnCode = MQTT_ParseReceivedData( &( xMQTTContext ),
+                                                  &( ucPublishMessage[ ulIndex ] ),
+                                                  ( ( ulLength - ulIndex ) < testmqttlibSTREAM_RECEIVE_LENGTH ) ? ( ulLength - ulIndex ) : testmqttlibSTREAM_RECEIVE_LENGTH );
+        }
+
+        return xReturnCode;
+    }
+
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+/*-----------------------------------------------------------*/
+
+static void prvStoreTestSubscriptions( void )
+{
+    static const char * const pcTopicFilters[ testmqttlibSUBSCRIPTION_CONTEXTS ] =
+    {
+        "aws/iot/exact",
+        "aws/+/exact",
+        "aws/#",
+        "#",
+        "aws/iot/other"
+    };
+    uint32_t x;
+
+    for( x = 0; x < testmqttlibSUBSCRIPTION_CONTEXTS; x++ )
+    {
+        ulSubscriptionCallbackCount[ x ] = 0;
+        TEST_ASSERT_EQUAL( eMQTTTrue, Test_prvStoreSubscription( &( xMQTTContext ),
+                                                                 ( const uint8_t * ) pcTopicFilters[ x ],
+                                                                 ( uint16_t ) strlen( pcTopicFilters[ x ] ),
+                                                                 ( void * ) ( uintptr_t ) x,
+                                                                 prvSubscriptionCallback ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
 /* Define Test Group. */
 TEST_GROUP( Full_MQTT );
 /*-----------------------------------------------------------*/
@@ -366,6 +692,9 @@ TEST_GROUP_RUNNER( Full_MQTT )
     RUN_TEST_CASE( Full_MQTT, AFQP_prvDoesTopicMatchTopicFilter_MatchCases );
     RUN_TEST_CASE( Full_MQTT, AFQP_prvDoesTopicMatchTopicFilter_NotMatchCases );
 
+    RUN_TEST_CASE( Full_MQTT, AFQP_prvInvokeSubscriptionCallbacks_MatchingFilters );
+    RUN_TEST_CASE( Full_MQTT, AFQP_prvInvokeSubscriptionCallbacks_OwnershipTaken );
+
     /* MQTT_Init tests. */
     RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_Init_HappyCase );
     RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_Init_NULLParams );
@@ -381,6 +710,18 @@ TEST_GROUP_RUNNER( Full_MQTT )
     RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_Connect_SecondConnectWhileAlreadyConnected );
     RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_Connect_SecondConnectWhileWaitingForConnACK );
     RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_Connect_NetworkSendFailed );
+
+    /* MQTT_PublishZeroCopy tests. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_PublishZeroCopy_QoS1PayloadReturnedWithPubACK );
+        RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_PublishZeroCopy_NetworkSendFailed );
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+
+    /* Streamed publish receive tests. */
+    #if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+        RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_ParseReceivedData_StreamedPublishQoS1 );
+        RUN_TEST_CASE( Full_MQTT, AFQP_MQTT_ParseReceivedData_StreamedPublishQoS2Disconnects );
+    #endif /* mqttconfigENABLE_STREAMING_PUBLISH */
 }
 /*-----------------------------------------------------------*/
 
@@ -698,6 +1039,91 @@ TEST( Full_MQTT, AFQP_prvDoesTopicMatchTopicFilter_NotMatchCases )
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Every subscription whose topic filter matches the topic is invoked
+ * exactly once and removed subscriptions are not invoked.
+ */
+TEST( Full_MQTT, AFQP_prvInvokeSubscriptionCallbacks_MatchingFilters )
+{
+    MQTTPublishData_t xPublishData;
+    MQTTBool_t xCallbackInvoked, xOwnershipTaken;
+
+    ulSubscriptionOwnershipContext = testmqttlibSUBSCRIPTION_CONTEXTS;
+    prvStoreTestSubscriptions();
+
+    memset( &( xPublishData ), 0x00, sizeof( xPublishData ) );
+    xPublishData.pucTopic = ( const uint8_t * ) "aws/iot/exact";
+    xPublishData.usTopicLength = ( uint16_t ) strlen( "aws/iot/exact" );
+
+    xOwnershipTaken = Test_prvInvokeSubscriptionCallbacks( &( xMQTTContext ), &( xPublishData ), &( xCallbackInvoked ) );
+    TEST_ASSERT_EQUAL( eMQTTFalse, xOwnershipTaken );
+    TEST_ASSERT_EQUAL( eMQTTTrue, xCallbackInvoked );
+    TEST_ASSERT_EQUAL( 1, ulSubscriptionCallbackCount[ 0 ] );
+    TEST_ASSERT_EQUAL( 1, ulSubscriptionCallbackCount[ 1 ] );
+    TEST_ASSERT_EQUAL( 1, ulSubscriptionCallbackCount[ 2 ] );
+    TEST_ASSERT_EQUAL( 1, ulSubscriptionCallbackCount[ 3 ] );
+    TEST_ASSERT_EQUAL( 0, ulSubscriptionCallbackCount[ 4 ] );
+
+    /* "aws/#" also matches the parent level "aws". */
+    xPublishData.pucTopic = ( const uint8_t * ) "aws";
+    xPublishData.usTopicLength = ( uint16_t ) strlen( "aws" );
+
+    xOwnershipTaken = Test_prvInvokeSubscriptionCallbacks( &( xMQTTContext ), &( xPublishData ), &( xCallbackInvoked ) );
+    TEST_ASSERT_EQUAL( eMQTTTrue, xCallbackInvoked );
+    TEST_ASSERT_EQUAL( 2, ulSubscriptionCallbackCount[ 2 ] );
+    TEST_ASSERT_EQUAL( 2, ulSubscriptionCallbackCount[ 3 ] );
+
+    /* Removed subscriptions must not be invoked. */
+    Test_prvRemoveSubscription( &( xMQTTContext ), ( const uint8_t * ) "aws/#", ( uint16_t ) strlen( "aws/#" ) );
+    Test_prvRemoveSubscription( &( xMQTTContext ), ( const uint8_t * ) "#", ( uint16_t ) strlen( "#" ) );
+
+    xOwnershipTaken = Test_prvInvokeSubscriptionCallbacks( &( xMQTTContext ), &( xPublishData ), &( xCallbackInvoked ) );
+    TEST_ASSERT_EQUAL( eMQTTFalse, xCallbackInvoked );
+    TEST_ASSERT_EQUAL( 2, ulSubscriptionCallbackCount[ 2 ] );
+    TEST_ASSERT_EQUAL( 2, ulSubscriptionCallbackCount[ 3 ] );
+
+    /* Removed subscriptions can be stored again. */
+    TEST_ASSERT_EQUAL( eMQTTTrue, Test_prvStoreSubscription( &( xMQTTContext ),
+                                                             ( const uint8_t * ) "aws/#",
+                                                             ( uint16_t ) strlen( "aws/#" ),
+                                                             ( void * ) 2,
+                                                             prvSubscriptionCallback ) );
+
+    xOwnershipTaken = Test_prvInvokeSubscriptionCallbacks( &( xMQTTContext ), &( xPublishData ), &( xCallbackInvoked ) );
+    TEST_ASSERT_EQUAL( eMQTTTrue, xCallbackInvoked );
+    TEST_ASSERT_EQUAL( 3, ulSubscriptionCallbackCount[ 2 ] );
+    TEST_ASSERT_EQUAL( 2, ulSubscriptionCallbackCount[ 3 ] );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Exact matches are invoked before wild-card matches and no callback
+ * is invoked once the ownership of the buffer is taken.
+ */
+TEST( Full_MQTT, AFQP_prvInvokeSubscriptionCallbacks_OwnershipTaken )
+{
+    MQTTPublishData_t xPublishData;
+    MQTTBool_t xCallbackInvoked, xOwnershipTaken;
+
+    ulSubscriptionOwnershipContext = 0;
+    prvStoreTestSubscriptions();
+
+    memset( &( xPublishData ), 0x00, sizeof( xPublishData ) );
+    xPublishData.pucTopic = ( const uint8_t * ) "aws/iot/exact";
+    xPublishData.usTopicLength = ( uint16_t ) strlen( "aws/iot/exact" );
+
+    xOwnershipTaken = Test_prvInvokeSubscriptionCallbacks( &( xMQTTContext ), &( xPublishData ), &( xCallbackInvoked ) );
+    TEST_ASSERT_EQUAL( eMQTTTrue, xOwnershipTaken );
+    TEST_ASSERT_EQUAL( eMQTTTrue, xCallbackInvoked );
+    TEST_ASSERT_EQUAL( 1, ulSubscriptionCallbackCount[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, ulSubscriptionCallbackCount[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, ulSubscriptionCallbackCount[ 2 ] );
+    TEST_ASSERT_EQUAL( 0, ulSubscriptionCallbackCount[ 3 ] );
+
+    ulSubscriptionOwnershipContext = testmqttlibSUBSCRIPTION_CONTEXTS;
+}
+/*-----------------------------------------------------------*/
+
 /**
  * @brief MQTT context initialization happy case.
  */
@@ -725,6 +1151,9 @@ TEST( Full_MQTT, AFQP_MQTT_Init_NULLParams )
     xInitParams.pvCallbackContext = testmqttlibCALLBACK_CONTEXT;
     xInitParams.pvSendContext = testmqttlibSEND_CONTEXT;
     xInitParams.pxMQTTSendFxn = NULL; /* This is a required callback and setting it to NULL will fire assert. */
+    #if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+        xInitParams.pxMQTTSendvFxn = NULL;
+    #endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
     xInitParams.pxGetTicksFxn = NULL;
     xInitParams.xBufferPoolInterface.pxGetBufferFxn = BUFFERPOOL_GetFreeBuffer;
     xInitParams.xBufferPoolInterface.pxReturnBufferFxn = BUFFERPOOL_ReturnBuffer;
@@ -1075,3 +1504,160 @@ TEST( Full_MQTT, AFQP_MQTT_Connect_NetworkSendFailed )
     TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulUnidentified );
 }
 /*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_ZERO_COPY_PUBLISH == 1 )
+
+/**
+ * @brief Zero-copy publish - QoS1 payload is referenced until PUBACK.
+ */
+    TEST( Full_MQTT, AFQP_MQTT_PublishZeroCopy_QoS1PayloadReturnedWithPubACK )
+    {
+        MQTTReturnCode_t xReturnCode;
+        MQTTPublishParams_t xPublishParams;
+        static const uint8_t ucPubACKMessage[] =
+        {
+            0x40,                             /* Fixed header control packet type. */
+            2,                                /* Fixed header remaining length - always 2 for PUBACK. */
+            0,                                /* Packet identifier MSB. */
+            testmqttlibPUBLISH_PACKET_ID      /* Packet identifier LSB. */
+        };
+
+        /* Connect to the broker. */
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvSendMQTTConnect() );
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvReceiveMQTTConnACK() );
+
+        /* Use the vectored send callback. */
+        xMQTTContext.pxMQTTSendvFxn = &( prvSendvCallback );
+        ulSendvCount = 0;
+        pvPubACKPayload = NULL;
+
+        /* Publish a payload larger than any pool buffer. */
+        xPublishParams.pucTopic = ( const uint8_t * ) "aws/iot/zerocopy";
+        xPublishParams.usTopicLength = ( uint16_t ) strlen( "aws/iot/zerocopy" );
+        xPublishParams.xQos = eMQTTQoS1;
+        xPublishParams.pvData = ucZeroCopyPayload;
+        xPublishParams.ulDataLength = ( uint32_t ) sizeof( ucZeroCopyPayload );
+        xPublishParams.usPacketIdentifier = testmqttlibPUBLISH_PACKET_ID;
+        xPublishParams.ulTimeoutTicks = testmqttlibOPERATION_TIMEOUT_TICKS;
+
+        xReturnCode = MQTT_PublishZeroCopy( &( xMQTTContext ), &( xPublishParams ) );
+
+        /* The whole message must have been sent in one vectored send. */
+        TEST_ASSERT_EQUAL( eMQTTSuccess, xReturnCode );
+        TEST_ASSERT_EQUAL( 1, ulSendvCount );
+
+        /* The packet must be waiting for PUBACK. */
+        TEST_ASSERT_FALSE( listIS_EMPTY( &( xMQTTContext.xTxBufferListHead ) ) );
+
+        /* Receive PUBACK. */
+        xReturnCode = MQTT_ParseReceivedData( &( xMQTTContext ), ucPubACKMessage, sizeof( ucPubACKMessage ) );
+        TEST_ASSERT_EQUAL( eMQTTSuccess, xReturnCode );
+
+        /* The payload must have been handed back with the PUBACK. */
+        TEST_ASSERT_EQUAL( 1, xCallbackCounter.ulPubACK );
+        TEST_ASSERT_EQUAL_PTR( ucZeroCopyPayload, pvPubACKPayload );
+        TEST_ASSERT_TRUE( listIS_EMPTY( &( xMQTTContext.xTxBufferListHead ) ) );
+
+        /* No other callback must be invoked. */
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulUnidentified );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Zero-copy publish - Network send failure without vectored send.
+ */
+    TEST( Full_MQTT, AFQP_MQTT_PublishZeroCopy_NetworkSendFailed )
+    {
+        MQTTReturnCode_t xReturnCode;
+        MQTTPublishParams_t xPublishParams;
+
+        /* Connect to the broker. */
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvSendMQTTConnect() );
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvReceiveMQTTConnACK() );
+
+        /* Change the send callback in the MQTT context. */
+        xMQTTContext.pxMQTTSendFxn = &( prvSendFailedCallback );
+
+        xPublishParams.pucTopic = ( const uint8_t * ) "aws/iot/zerocopy";
+        xPublishParams.usTopicLength = ( uint16_t ) strlen( "aws/iot/zerocopy" );
+        xPublishParams.xQos = eMQTTQoS1;
+        xPublishParams.pvData = ucZeroCopyPayload;
+        xPublishParams.ulDataLength = ( uint32_t ) sizeof( ucZeroCopyPayload );
+        xPublishParams.usPacketIdentifier = testmqttlibPUBLISH_PACKET_ID;
+        xPublishParams.ulTimeoutTicks = testmqttlibOPERATION_TIMEOUT_TICKS;
+
+        xReturnCode = MQTT_PublishZeroCopy( &( xMQTTContext ), &( xPublishParams ) );
+
+        /* Publish must have failed and the payload must not be referenced. */
+        TEST_ASSERT_EQUAL( eMQTTSendFailed, xReturnCode );
+        TEST_ASSERT_TRUE( listIS_EMPTY( &( xMQTTContext.xTxBufferListHead ) ) );
+
+        /* No callback must have been invoked. */
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulPubACK );
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulUnidentified );
+    }
+
+#endif /* mqttconfigENABLE_ZERO_COPY_PUBLISH */
+/*-----------------------------------------------------------*/
+
+#if ( mqttconfigENABLE_STREAMING_PUBLISH == 1 )
+
+/**
+ * @brief Streamed publish - Header and in-order chunks are reported and the
+ * PUBACK is sent.
+ */
+    TEST( Full_MQTT, AFQP_MQTT_ParseReceivedData_StreamedPublishQoS1 )
+    {
+        /* Connect to the broker. */
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvSendMQTTConnect() );
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvReceiveMQTTConnACK() );
+
+        ulStreamedPayloadLength = 0;
+        memset( ucLastSentPacket, 0x00, sizeof( ucLastSentPacket ) );
+
+        /* Receive a QoS1 publish larger than any pool buffer. */
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvReceiveStreamedPublish( 1 ) );
+
+        /* The header must have been reported once followed by the
+         * whole payload. */
+        TEST_ASSERT_EQUAL( 1, xCallbackCounter.ulStreamHeader );
+        TEST_ASSERT_GREATER_THAN( 1, xCallbackCounter.ulStreamChunk );
+        TEST_ASSERT_EQUAL( testmqttlibSTREAM_PAYLOAD_LENGTH, ulStreamedPayloadLength );
+
+        /* A PUBACK must have been sent for the message. */
+        TEST_ASSERT_EQUAL_HEX8( 0x40, ucLastSentPacket[ 0 ] );
+        TEST_ASSERT_EQUAL( 2, ucLastSentPacket[ 1 ] );
+        TEST_ASSERT_EQUAL( 0, ucLastSentPacket[ 2 ] );
+        TEST_ASSERT_EQUAL( testmqttlibPUBLISH_PACKET_ID, ucLastSentPacket[ 3 ] );
+
+        /* The header buffer must have been returned. */
+        TEST_ASSERT_NULL( xMQTTContext.xRxBuffer );
+        TEST_ASSERT_EQUAL( eMQTTRxNextBytePacketType, xMQTTContext.xRxMessageState.xRxNextByte );
+
+        /* No other callback must be invoked. */
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulDisconnect );
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulUnidentified );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Streamed publish - A QoS2 publish is malformed and disconnects.
+ */
+    TEST( Full_MQTT, AFQP_MQTT_ParseReceivedData_StreamedPublishQoS2Disconnects )
+    {
+        /* Connect to the broker. */
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvSendMQTTConnect() );
+        TEST_ASSERT_EQUAL( eMQTTSuccess, prvReceiveMQTTConnACK() );
+
+        TEST_ASSERT_EQUAL( eMQTTMalformedPacketReceived, prvReceiveStreamedPublish( 2 ) );
+
+        /* The client must have been disconnected without reporting
+         * any part of the message. */
+        TEST_ASSERT_EQUAL( 1, xCallbackCounter.ulDisconnect );
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulStreamHeader );
+        TEST_ASSERT_EQUAL( 0, xCallbackCounter.ulStreamChunk );
+        TEST_ASSERT_EQUAL( eMQTTNotConnected, xMQTTContext.xConnectionState );
+    }
+
+#endif /* mqttconfigENABLE_STREAMING_PUBLISH */
+/*-----------------------------------------------------------*/
@@ -176,6 +176,9 @@ TEST_GROUP_RUNNER( Full_OTA_AGENT )
     RUN_TEST_CASE( Full_OTA_AGENT, OTA_SetImageState_InvalidParams );
     RUN_TEST_CASE( Full_OTA_AGENT, prvParseJobDocFromJSONandPrvOTA_Close );
     RUN_TEST_CASE( Full_OTA_AGENT, prvParseJSONbyModel_Errors );
+    #if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+        RUN_TEST_CASE( Full_OTA_AGENT, prvBuildWindowBitmap_SlidingWindow );
+    #endif
 }
 
 TEST( Full_OTA_AGENT, OTA_SetImageState_InvalidParams )
@@ -194,6 +197,64 @@ TEST( Full_OTA_AGENT, OTA_SetImageState_InvalidParams )
     TEST_ASSERT_EQUAL( xOTAImageState, OTA_GetImageState() );
 }
 
+#if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 )
+
+/**
+ * @brief Verify that the windowed block requests only ask for missing blocks that
+ * fit in the window and that a request timeout starts over with a smaller window.
+ */
+    TEST( Full_OTA_AGENT, prvBuildWindowBitmap_SlidingWindow )
+    {
+        OTA_FileContext_t xFile = { 0 };
+        uint8_t ucRxBlockBitmap[ 3 ] = { 0xFF, 0xFF, 0x0F }; /* 20 blocks, all missing. */
+        uint8_t ucBitmap[ 128 ];
+        uint32_t ulBitmapLen = 0;
+        uint32_t ulNumBlocks;
+
+        xFile.ulFileSize = 20 * OTA_FILE_BLOCK_SIZE - 1;
+        xFile.pacRxBlockBitmap = ucRxBlockBitmap;
+        xFile.ulRequestWindow = 4;
+        xFile.ulRequestWindowThreshold = otaconfigREQUEST_WINDOW_MAX_BLOCKS;
+
+        /* Blocks 1 and 2 were already received. */
+        ucRxBlockBitmap[ 0 ] &= ~0x06;
+
+        /* The first request asks for blocks 0, 3, 4 and 5. */
+        ulNumBlocks = TEST_OTA_prvBuildWindowBitmap( &xFile, ucBitmap, &ulBitmapLen );
+        TEST_ASSERT_EQUAL_UINT32( 4, ulNumBlocks );
+        TEST_ASSERT_EQUAL_UINT32( 1, ulBitmapLen );
+        TEST_ASSERT_EQUAL_HEX8( 0x39, ucBitmap[ 0 ] );
+        TEST_ASSERT_EQUAL_UINT32( 4, xFile.ulBlocksInFlight );
+        TEST_ASSERT_EQUAL_UINT32( 6, xFile.ulNextBlockToRequest );
+
+        /* Nothing more fits in the window until blocks are received. */
+        ulNumBlocks = TEST_OTA_prvBuildWindowBitmap( &xFile, ucBitmap, &ulBitmapLen );
+        TEST_ASSERT_EQUAL_UINT32( 0, ulNumBlocks );
+
+        /* Two blocks were received and the window grew. The next request continues at block 6. */
+        ucRxBlockBitmap[ 0 ] &= ~0x09;
+        xFile.ulBlocksInFlight = 2;
+        xFile.ulRequestWindow = 8;
+        ulNumBlocks = TEST_OTA_prvBuildWindowBitmap( &xFile, ucBitmap, &ulBitmapLen );
+        TEST_ASSERT_EQUAL_UINT32( 6, ulNumBlocks );
+        TEST_ASSERT_EQUAL_UINT32( 2, ulBitmapLen );
+        TEST_ASSERT_EQUAL_HEX8( 0xC0, ucBitmap[ 0 ] );
+        TEST_ASSERT_EQUAL_HEX8( 0x0F, ucBitmap[ 1 ] );
+        TEST_ASSERT_EQUAL_UINT32( 12, xFile.ulNextBlockToRequest );
+
+        /* A timeout halves the window and requests the missing blocks from the start again. */
+        TEST_OTA_prvRequestWindowTimeout( &xFile );
+        TEST_ASSERT_EQUAL_UINT32( 4, xFile.ulRequestWindow );
+        TEST_ASSERT_EQUAL_UINT32( 0, xFile.ulBlocksInFlight );
+        ulNumBlocks = TEST_OTA_prvBuildWindowBitmap( &xFile, ucBitmap, &ulBitmapLen );
+        TEST_ASSERT_EQUAL_UINT32( 4, ulNumBlocks );
+        TEST_ASSERT_EQUAL_UINT32( 1, ulBitmapLen );
+        TEST_ASSERT_EQUAL_HEX8( 0xF0, ucBitmap[ 0 ] );
+        TEST_ASSERT_EQUAL_UINT32( 8, xFile.ulNextBlockToRequest );
+    }
+
+#endif /* if ( otaconfigREQUEST_WINDOW_MAX_BLOCKS > 0 ) */
+
 TEST( Full_OTA_AGENT, prvParseJobDocFromJSONandPrvOTA_Close )
 {
     OTA_State_t eOtaStatus;
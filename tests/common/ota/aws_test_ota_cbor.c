@@ -24,9 +24,22 @@
  */
 /* Standard includes. */
 #include <stdint.h>
-#include <Windows.h>
-#include <strsafe.h>
 #include <stdbool.h>
+#ifdef WIN32
+    #include <Windows.h>
+    #include <strsafe.h>
+#else
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <limits.h>
+    #include <unistd.h>
+
+/* Map the Win32 names used below onto their POSIX equivalents. */
+    #define MAX_PATH           PATH_MAX
+    #define CHAR               char
+    #define StringCbPrintfA    snprintf
+    #define min( a, b )        ( ( ( a ) < ( b ) ) ? ( a ) : ( b ) )
+#endif
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
@@ -47,7 +60,7 @@
 
 /* Crypto includes. */
 #include "aws_crypto.h"
-#include "mbedTLS/sha1.h"
+#include "mbedtls/sha1.h"
 
 /*-----------------------------------------------------------*/
 
@@ -56,6 +69,8 @@ MQTTPublishData_t xMsgMetaData;
 
 /*-----------------------------------------------------------*/
 
+#ifdef WIN32
+
 static void prvSaveCborTestFile( char * pcFileName,
                                  uint8_t * pucCborData,
                                  uint32_t ulCborDataSize )
@@ -166,12 +181,77 @@ static BaseType_t prvReadCborTestFile( char * pcFileName,
     return 0 == ulStatus;
 }
 
+#else /* WIN32 */
+
+static void prvSaveCborTestFile( char * pcFileName,
+                                 uint8_t * pucCborData,
+                                 uint32_t ulCborDataSize )
+{
+    FILE * pxFile = NULL;
+
+    /* Open the file. */
+    pxFile = fopen( pcFileName, "wb" );
+
+    /* Write the data. */
+    if( NULL != pxFile )
+    {
+        ( void ) fwrite( pucCborData, 1, ulCborDataSize, pxFile );
+
+        /* Clean up. */
+        fclose( pxFile );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadCborTestFile( char * pcFileName,
+                                       uint8_t ** ppucCborData,
+                                       uint32_t * pulCborDataSize )
+{
+    BaseType_t xResult = pdFALSE;
+    FILE * pxFile = NULL;
+    long lSize = 0;
+
+    /* Open the file. */
+    pxFile = fopen( pcFileName, "rb" );
+
+    if( NULL != pxFile )
+    {
+        /* Get the file size. */
+        if( ( 0 == fseek( pxFile, 0, SEEK_END ) ) &&
+            ( ( lSize = ftell( pxFile ) ) >= 0 ) &&
+            ( 0 == fseek( pxFile, 0, SEEK_SET ) ) )
+        {
+            *pulCborDataSize = ( uint32_t ) lSize;
+
+            /* Create a buffer. */
+            *ppucCborData = pvPortMalloc( *pulCborDataSize );
+
+            /* Read the file and confirm the amount of data read. */
+            if( ( NULL != *ppucCborData ) &&
+                ( *pulCborDataSize == fread( *ppucCborData, 1, *pulCborDataSize, pxFile ) ) )
+            {
+                xResult = pdTRUE;
+            }
+        }
+
+        /* Clean up. */
+        fclose( pxFile );
+    }
+
+    return xResult;
+}
+
+#endif /* WIN32 */
+
 /*-----------------------------------------------------------*/
 
 TEST_GROUP( Full_OTA_CBOR );
 
 CHAR szOriginalWorkingDirectory[ MAX_PATH ];
 
+#ifdef WIN32
+
 TEST_SETUP( Full_OTA_CBOR )
 {
     uint32_t ulStatus = 0;
@@ -217,9 +297,37 @@ TEST_TEAR_DOWN( Full_OTA_CBOR )
     }
 }
 
+#else /* WIN32 */
+
+TEST_SETUP( Full_OTA_CBOR )
+{
+    const char * pcTempDirectory = getenv( "TMPDIR" );
+
+    /* Get the current working directory. */
+    TEST_ASSERT_NOT_NULL( getcwd( szOriginalWorkingDirectory,
+                                  sizeof( szOriginalWorkingDirectory ) ) );
+
+    /* Set the working directory of the host process to $TMPDIR. */
+    if( NULL == pcTempDirectory )
+    {
+        pcTempDirectory = "/tmp";
+    }
+
+    TEST_ASSERT_EQUAL( 0, chdir( pcTempDirectory ) );
+}
+
+TEST_TEAR_DOWN( Full_OTA_CBOR )
+{
+    /* Restore the working directory. */
+    TEST_ASSERT_EQUAL( 0, chdir( szOriginalWorkingDirectory ) );
+}
+
+#endif /* WIN32 */
+
 TEST_GROUP_RUNNER( Full_OTA_CBOR )
 {
     RUN_TEST_CASE( Full_OTA_CBOR, CborOtaApi );
+    RUN_TEST_CASE( Full_OTA_CBOR, CborOtaDecodeInPlace );
     RUN_TEST_CASE( Full_OTA_CBOR, CborOtaAgentIngest );
     RUN_TEST_CASE( Full_OTA_CBOR, CborOtaServerFiles );
 }
@@ -552,6 +660,62 @@ TEST( Full_OTA_CBOR, CborOtaApi )
     }
 }
 
+TEST( Full_OTA_CBOR, CborOtaDecodeInPlace )
+{
+    BaseType_t xResult = pdFALSE;
+    uint8_t ucBlockPayload[OTA_FILE_BLOCK_SIZE] = { 0 };
+    uint8_t ucCborWork[ CBOR_TEST_MESSAGE_BUFFER_SIZE ];
+    size_t xEncodedSize = 0;
+    int lFileId = 0;
+    int lBlockIndex = 0;
+    int lBlockSize = 0;
+    const uint8_t * pucPayload = NULL;
+    size_t xPayloadSize = 0;
+
+    for( int l = 0; l < sizeof( ucBlockPayload ); l++ )
+    {
+        ucBlockPayload[ l ] = l;
+    }
+
+    xResult = prvCreateSampleGetStreamResponseMessage(
+        ucCborWork,
+        sizeof( ucCborWork ),
+        CBOR_TEST_BLOCKIDENTITY_VALUE,
+        ucBlockPayload,
+        sizeof( ucBlockPayload ),
+        &xEncodedSize );
+    TEST_ASSERT_TRUE( xResult );
+
+    /* Test OTA_CBOR_Decode_GetStreamResponseMessageInPlace( ). The payload
+     * must point into the message buffer. */
+    xResult = OTA_CBOR_Decode_GetStreamResponseMessageInPlace(
+        ucCborWork,
+        xEncodedSize,
+        &lFileId,
+        &lBlockIndex,
+        &lBlockSize,
+        &pucPayload,
+        &xPayloadSize );
+    TEST_ASSERT_TRUE( xResult );
+    TEST_ASSERT_EQUAL( CBOR_TEST_FILEIDENTITY_VALUE, lFileId );
+    TEST_ASSERT_EQUAL( CBOR_TEST_BLOCKIDENTITY_VALUE, lBlockIndex );
+    TEST_ASSERT_EQUAL( sizeof( ucBlockPayload ), xPayloadSize );
+    TEST_ASSERT_TRUE( ( pucPayload > ucCborWork ) &&
+                      ( pucPayload + xPayloadSize <= ucCborWork + xEncodedSize ) );
+    TEST_ASSERT_EQUAL_MEMORY( ucBlockPayload, pucPayload, xPayloadSize );
+
+    /* A truncated message must not return a payload beyond its end. */
+    xResult = OTA_CBOR_Decode_GetStreamResponseMessageInPlace(
+        ucCborWork,
+        xEncodedSize - 1,
+        &lFileId,
+        &lBlockIndex,
+        &lBlockSize,
+        &pucPayload,
+        &xPayloadSize );
+    TEST_ASSERT_FALSE( xResult );
+}
+
 TEST( Full_OTA_CBOR, CborOtaAgentIngest )
 {
     BaseType_t xResultBool = pdFALSE;
@@ -37,6 +37,7 @@
 #include "aws_ota_pal_test_access_declare.h"
 #include "aws_ota_pal.h"
 #include "aws_ota_agent.h"
+#include "aws_ota_agent_internal.h"
 #include "aws_pkcs11.h"
 #include "aws_ota_codesigner_certificate.h"
 #include "aws_test_ota_config.h"
@@ -55,6 +56,11 @@
  * the block write loop. */
 #define testotapalWRITE_BLOCKS_DELAY_MS    5000
 
+/* For the prvPAL_CloseFile_IncrementalSignatureCheckLatency test this is the number
+ * and size of the blocks written to the file. */
+#define testotapalBENCHMARK_NUM_BLOCKS     1024
+#define testotapalBENCHMARK_BLOCK_SIZE     4096
+
 /*
  * @brief: This dummy data is prepended by a SHA1 hash generated from the rsa-sha1-signer
  * certificate and keys in tests/common/ota/test_files.
@@ -166,6 +172,11 @@ TEST_GROUP_RUNNER( Full_OTA_PAL )
         RUN_TEST_CASE( Full_OTA_PAL, prvPAL_CloseFile_NonexistingCodeSignerCertificate );
     #endif
 
+    #if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 )
+        RUN_TEST_CASE( Full_OTA_PAL, prvPAL_CloseFile_ValidSignatureIncremental );
+        RUN_TEST_CASE( Full_OTA_PAL, prvPAL_CloseFile_IncrementalSignatureCheckLatency );
+    #endif
+
     RUN_TEST_CASE( Full_OTA_PAL, prvPAL_CreateFileForRx_CreateAnyFile );
     /* RUN_TEST_CASE( Full_OTA_PAL, prvPAL_CreateFileForRx_NullParameters ) */ /* Not supported yet. */
 
@@ -368,6 +379,128 @@ TEST( Full_OTA_PAL, prvPAL_CloseFile_ValidSignatureKeyInFlash )
  * The close is called after we have a written a block of dummy data to the file.
  * Verify the correct OTA Agent level error code is returned from prvPAL_CloseFile.
  */
+#if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 )
+
+/**
+ * @brief Test prvPAL_CloseFile with a valid signature after the blocks were included
+ * in the signature check out of order, as the OTA agent does. Verify the success.
+ */
+    TEST( Full_OTA_PAL, prvPAL_CloseFile_ValidSignatureIncremental )
+    {
+        OTA_Err_t xOtaStatus;
+        Sig256_t xSig = { 0 };
+        uint32_t ulHalfSize = sizeof( ucDummyData ) / 2;
+
+        xOtaFile.pacFilepath = ( uint8_t * ) ( "test_happy_path_image.bin" );
+        xOtaStatus = prvPAL_CreateFileForRx( &xOtaFile );
+        TEST_ASSERT_EQUAL( kOTA_Err_None, xOtaStatus );
+
+        /* We still want to close the file if the test fails somewhere here. */
+        if( TEST_PROTECT() )
+        {
+            TEST_ASSERT_NOT_NULL( xOtaFile.pvSigVerifyContext );
+
+            /* Write the second half of the data first. It cannot be hashed yet. */
+            xOtaStatus = prvPAL_WriteBlock( &xOtaFile,
+                                            ulHalfSize,
+                                            &ucDummyData[ ulHalfSize ],
+                                            sizeof( ucDummyData ) - ulHalfSize );
+            TEST_ASSERT_EQUAL( sizeof( ucDummyData ) - ulHalfSize, xOtaStatus );
+
+            /* Write and hash the first half of the data. */
+            xOtaStatus = prvPAL_WriteBlock( &xOtaFile,
+                                            0,
+                                            ucDummyData,
+                                            ulHalfSize );
+            TEST_ASSERT_EQUAL( ulHalfSize, xOtaStatus );
+
+            xOtaStatus = prvPAL_UpdateFileSignature( &xOtaFile, ucDummyData, ulHalfSize );
+            TEST_ASSERT_EQUAL_INT( kOTA_Err_None, xOtaStatus );
+            TEST_ASSERT_EQUAL_UINT32( ulHalfSize, xOtaFile.ulSigVerifiedSize );
+
+            /* Hash the second half of the data from the file. */
+            xOtaStatus = prvPAL_UpdateFileSignature( &xOtaFile, NULL, sizeof( ucDummyData ) - ulHalfSize );
+            TEST_ASSERT_EQUAL_INT( kOTA_Err_None, xOtaStatus );
+            TEST_ASSERT_EQUAL_UINT32( sizeof( ucDummyData ), xOtaFile.ulSigVerifiedSize );
+
+            xOtaFile.pxSignature = &xSig;
+            xOtaFile.pxSignature->usSize = ucValidSignatureLength;
+            memcpy( xOtaFile.pxSignature->ucData, ucValidSignature, ucValidSignatureLength );
+            xOtaFile.pacCertFilepath = ( uint8_t * ) otatestpalCERTIFICATE_FILE;
+
+            xOtaStatus = prvPAL_CloseFile( &xOtaFile );
+            TEST_ASSERT_EQUAL_INT( kOTA_Err_None, xOtaStatus );
+            TEST_ASSERT_NULL( xOtaFile.pvSigVerifyContext );
+        }
+    }
+
+/**
+ * @brief Write a large image and measure how long prvPAL_CloseFile takes when the whole
+ * file is hashed on close and when the blocks were hashed as they were written.
+ */
+    static TickType_t prvMeasureCloseFile( BaseType_t xIncremental )
+    {
+        static uint8_t ucBlock[ testotapalBENCHMARK_BLOCK_SIZE ];
+        OTA_Err_t xOtaStatus;
+        Sig256_t xSig = { 0 };
+        TickType_t xStartTime, xCloseTime = 0;
+        int16_t sNumBytesWritten;
+        uint32_t ulIndex;
+
+        for( ulIndex = 0; ulIndex < sizeof( ucBlock ); ulIndex++ )
+        {
+            ucBlock[ ulIndex ] = ucDummyData[ ulIndex % sizeof( ucDummyData ) ];
+        }
+
+        memset( &xOtaFile, 0, sizeof( xOtaFile ) );
+        xOtaFile.pacFilepath = ( uint8_t * ) otatestpalFIRMWARE_FILE;
+        xOtaStatus = prvPAL_CreateFileForRx( &xOtaFile );
+        TEST_ASSERT_EQUAL( kOTA_Err_None, xOtaStatus );
+
+        for( ulIndex = 0; ulIndex < testotapalBENCHMARK_NUM_BLOCKS; ulIndex++ )
+        {
+            sNumBytesWritten = prvPAL_WriteBlock( &xOtaFile, ulIndex * sizeof( ucBlock ), ucBlock, sizeof( ucBlock ) );
+            TEST_ASSERT_EQUAL_INT( sizeof( ucBlock ), sNumBytesWritten );
+
+            if( xIncremental == pdTRUE )
+            {
+                xOtaStatus = prvPAL_UpdateFileSignature( &xOtaFile, ucBlock, sizeof( ucBlock ) );
+                TEST_ASSERT_EQUAL_INT( kOTA_Err_None, xOtaStatus );
+            }
+        }
+
+        /* The data is not signed, so only the time taken by the check is of interest. */
+        xOtaFile.pxSignature = &xSig;
+        xOtaFile.pxSignature->usSize = ucInvalidSignatureLength;
+        memcpy( xOtaFile.pxSignature->ucData, ucInvalidSignature, ucInvalidSignatureLength );
+        xOtaFile.pacCertFilepath = ( uint8_t * ) otatestpalCERTIFICATE_FILE;
+
+        xStartTime = xTaskGetTickCount();
+        xOtaStatus = prvPAL_CloseFile( &xOtaFile );
+        xCloseTime = xTaskGetTickCount() - xStartTime;
+        TEST_ASSERT_EQUAL_INT( kOTA_Err_SignatureCheckFailed, xOtaStatus & kOTA_Main_ErrMask );
+
+        return xCloseTime;
+    }
+
+    TEST( Full_OTA_PAL, prvPAL_CloseFile_IncrementalSignatureCheckLatency )
+    {
+        TickType_t xFullCheckTime, xIncrementalCheckTime;
+
+        if( TEST_PROTECT() )
+        {
+            xFullCheckTime = prvMeasureCloseFile( pdFALSE );
+            xIncrementalCheckTime = prvMeasureCloseFile( pdTRUE );
+
+            configPRINTF( ( "prvPAL_CloseFile on a %u byte image: %u ms with the full signature check, %u ms with the incremental check.\r\n",
+                            testotapalBENCHMARK_NUM_BLOCKS * testotapalBENCHMARK_BLOCK_SIZE,
+                            ( uint32_t ) ( xFullCheckTime * portTICK_PERIOD_MS ),
+                            ( uint32_t ) ( xIncrementalCheckTime * portTICK_PERIOD_MS ) ) );
+        }
+    }
+
+#endif /* if ( otaconfigINCREMENTAL_SIGNATURE_CHECK == 1 ) */
+
 TEST( Full_OTA_PAL, prvPAL_CloseFile_InvalidSignatureBlockWritten )
 {
     OTA_Err_t xOtaStatus;
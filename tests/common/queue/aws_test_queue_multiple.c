@@ -0,0 +1,328 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_queue_multiple.c
+ * @brief Tests for xQueueSendMultiple() and xQueueReceiveMultiple().
+ *
+ * Items posted in batches are received in order, also when the storage area
+ * of the queue wraps, and interoperate with the single item API. A task
+ * blocked on the queue is unblocked by a batch and gets the whole batch.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/**
+ * @brief Number of items the queues created by the tests can hold.
+ */
+#define testqueueLENGTH            ( 8 )
+
+/**
+ * @brief Time to wait for the helper task.
+ */
+#define testqueueTIMEOUT           pdMS_TO_TICKS( 5000 )
+
+/**
+ * @brief Priority of the helper task, above the test task so it runs as soon
+ * as it is unblocked.
+ */
+#define testqueueTASK_PRIORITY     ( configMAX_PRIORITIES - 1 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The queue used by the current test.
+ */
+static QueueHandle_t xQueue;
+
+/**
+ * @brief The helper task of the current test, and the test task.
+ */
+static TaskHandle_t xHelperTask;
+static TaskHandle_t xTestTask;
+
+/**
+ * @brief Number of items the helper task transferred, and the items it
+ * received.
+ */
+static volatile UBaseType_t uxHelperResult;
+static uint32_t ulHelperItems[ testqueueLENGTH ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sets pulItems to ulFirst, ulFirst + 1, ...
+ */
+static void prvFillItems( uint32_t * pulItems,
+                          UBaseType_t uxCount,
+                          uint32_t ulFirst );
+
+/**
+ * @brief Checks that pulItems holds ulFirst, ulFirst + 1, ...
+ */
+static void prvCheckItems( const uint32_t * pulItems,
+                           UBaseType_t uxCount,
+                           uint32_t ulFirst );
+
+/**
+ * @brief Helper tasks that block in xQueueReceiveMultiple() and
+ * xQueueSendMultiple(), then record the result and notify the test task.
+ */
+static void prvReceivingTask( void * pvParameters );
+static void prvSendingTask( void * pvParameters );
+/*-----------------------------------------------------------*/
+
+static void prvFillItems( uint32_t * pulItems,
+                          UBaseType_t uxCount,
+                          uint32_t ulFirst )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < uxCount; x++ )
+    {
+        pulItems[ x ] = ulFirst + ( uint32_t ) x;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckItems( const uint32_t * pulItems,
+                           UBaseType_t uxCount,
+                           uint32_t ulFirst )
+{
+    UBaseType_t x;
+
+    for( x = 0; x < uxCount; x++ )
+    {
+        TEST_ASSERT_EQUAL_UINT32( ulFirst + ( uint32_t ) x, pulItems[ x ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceivingTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    uxHelperResult = xQueueReceiveMultiple( xQueue, ulHelperItems, testqueueLENGTH, testqueueTIMEOUT );
+    xTaskNotifyGive( xTestTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendingTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvFillItems( ulHelperItems, testqueueLENGTH, 100 );
+    uxHelperResult = xQueueSendMultiple( xQueue, ulHelperItems, testqueueLENGTH, testqueueTIMEOUT );
+    xTaskNotifyGive( xTestTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Queue_Multiple );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Queue_Multiple )
+{
+    xHelperTask = NULL;
+    uxHelperResult = 0;
+    memset( ulHelperItems, 0x00, sizeof( ulHelperItems ) );
+    xTestTask = xTaskGetCurrentTaskHandle();
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+    xQueue = xQueueCreate( testqueueLENGTH, sizeof( uint32_t ) );
+    TEST_ASSERT_NOT_NULL( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Queue_Multiple )
+{
+    if( xHelperTask != NULL )
+    {
+        vTaskDelete( xHelperTask );
+    }
+
+    if( xQueue != NULL )
+    {
+        vQueueDelete( xQueue );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Queue_Multiple )
+{
+    RUN_TEST_CASE( Full_Queue_Multiple, SendAndReceive );
+    RUN_TEST_CASE( Full_Queue_Multiple, Wrap );
+    RUN_TEST_CASE( Full_Queue_Multiple, MixedWithSingleItems );
+    RUN_TEST_CASE( Full_Queue_Multiple, Timeout );
+    RUN_TEST_CASE( Full_Queue_Multiple, SendUnblocksReceiver );
+    RUN_TEST_CASE( Full_Queue_Multiple, ReceiveUnblocksSender );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Queue_Multiple, SendAndReceive )
+{
+    uint32_t ulItems[ testqueueLENGTH * 2 ];
+
+    prvFillItems( ulItems, testqueueLENGTH * 2, 0 );
+
+    /* Only the items there is space for are posted. */
+    TEST_ASSERT_EQUAL( 5, xQueueSendMultiple( xQueue, ulItems, 5, 0 ) );
+    TEST_ASSERT_EQUAL( testqueueLENGTH - 5, xQueueSendMultiple( xQueue, &( ulItems[ 5 ] ), testqueueLENGTH, 0 ) );
+    TEST_ASSERT_EQUAL( 0, uxQueueSpacesAvailable( xQueue ) );
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, ulItems, 1, 0 ) );
+
+    /* The items are received oldest first, and no more than requested. */
+    memset( ulItems, 0xFF, sizeof( ulItems ) );
+    TEST_ASSERT_EQUAL( 3, xQueueReceiveMultiple( xQueue, ulItems, 3, 0 ) );
+    prvCheckItems( ulItems, 3, 0 );
+    TEST_ASSERT_EQUAL_UINT32( 0xFFFFFFFFUL, ulItems[ 3 ] );
+
+    TEST_ASSERT_EQUAL( testqueueLENGTH - 3, xQueueReceiveMultiple( xQueue, ulItems, testqueueLENGTH * 2, 0 ) );
+    prvCheckItems( ulItems, testqueueLENGTH - 3, 3 );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+
+    /* Nothing to transfer. */
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, ulItems, testqueueLENGTH, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, ulItems, 0, 0 ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Queue_Multiple, Wrap )
+{
+    uint32_t ulItems[ testqueueLENGTH ];
+    uint32_t ulFirst;
+
+    /* Batches of 5 in a queue of 8 wrap at a different place each time. */
+    for( ulFirst = 0; ulFirst < ( testqueueLENGTH * 5 ); ulFirst += 5 )
+    {
+        prvFillItems( ulItems, 5, ulFirst );
+        TEST_ASSERT_EQUAL( 5, xQueueSendMultiple( xQueue, ulItems, 5, 0 ) );
+
+        memset( ulItems, 0x00, sizeof( ulItems ) );
+        TEST_ASSERT_EQUAL( 5, xQueueReceiveMultiple( xQueue, ulItems, testqueueLENGTH, 0 ) );
+        prvCheckItems( ulItems, 5, ulFirst );
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Queue_Multiple, MixedWithSingleItems )
+{
+    uint32_t ulItems[ testqueueLENGTH ];
+    uint32_t ulItem;
+
+    /* An item sent to the front comes before the batch. */
+    prvFillItems( ulItems, 4, 1 );
+    TEST_ASSERT_EQUAL( 4, xQueueSendMultiple( xQueue, ulItems, 4, 0 ) );
+    ulItem = 0;
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSendToFront( xQueue, &ulItem, 0 ) );
+    ulItem = 5;
+    TEST_ASSERT_EQUAL( pdPASS, xQueueSendToBack( xQueue, &ulItem, 0 ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueReceive( xQueue, &ulItem, 0 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulItem );
+
+    memset( ulItems, 0x00, sizeof( ulItems ) );
+    TEST_ASSERT_EQUAL( 5, xQueueReceiveMultiple( xQueue, ulItems, testqueueLENGTH, 0 ) );
+    prvCheckItems( ulItems, 5, 1 );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Queue_Multiple, Timeout )
+{
+    uint32_t ulItems[ testqueueLENGTH ];
+    TickType_t xStart;
+
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, ulItems, testqueueLENGTH, pdMS_TO_TICKS( 20 ) ) );
+    TEST_ASSERT_TRUE( ( xTaskGetTickCount() - xStart ) >= pdMS_TO_TICKS( 20 ) );
+
+    prvFillItems( ulItems, testqueueLENGTH, 0 );
+    TEST_ASSERT_EQUAL( testqueueLENGTH, xQueueSendMultiple( xQueue, ulItems, testqueueLENGTH, 0 ) );
+
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, ulItems, testqueueLENGTH, pdMS_TO_TICKS( 20 ) ) );
+    TEST_ASSERT_TRUE( ( xTaskGetTickCount() - xStart ) >= pdMS_TO_TICKS( 20 ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Queue_Multiple, SendUnblocksReceiver )
+{
+    uint32_t ulItems[ testqueueLENGTH ];
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvReceivingTask, "QMRecv", configMINIMAL_STACK_SIZE * 4, NULL,
+                                            testqueueTASK_PRIORITY, &xHelperTask ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulTaskNotifyTake( pdTRUE, pdMS_TO_TICKS( 50 ) ) );
+
+    /* The receiver is unblocked once the whole batch is in the queue, so it
+     * gets all of it in one call. */
+    prvFillItems( ulItems, 6, 10 );
+    TEST_ASSERT_EQUAL( 6, xQueueSendMultiple( xQueue, ulItems, 6, 0 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulTaskNotifyTake( pdTRUE, testqueueTIMEOUT ) );
+    TEST_ASSERT_EQUAL( 6, uxHelperResult );
+    prvCheckItems( ulHelperItems, 6, 10 );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Queue_Multiple, ReceiveUnblocksSender )
+{
+    uint32_t ulItems[ testqueueLENGTH ];
+
+    prvFillItems( ulItems, testqueueLENGTH, 0 );
+    TEST_ASSERT_EQUAL( testqueueLENGTH, xQueueSendMultiple( xQueue, ulItems, testqueueLENGTH, 0 ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvSendingTask, "QMSend", configMINIMAL_STACK_SIZE * 4, NULL,
+                                            testqueueTASK_PRIORITY, &xHelperTask ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulTaskNotifyTake( pdTRUE, pdMS_TO_TICKS( 50 ) ) );
+
+    /* Receiving 3 items makes space for 3 of the items of the sender. */
+    TEST_ASSERT_EQUAL( 3, xQueueReceiveMultiple( xQueue, ulItems, 3, 0 ) );
+    prvCheckItems( ulItems, 3, 0 );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulTaskNotifyTake( pdTRUE, testqueueTIMEOUT ) );
+    TEST_ASSERT_EQUAL( 3, uxHelperResult );
+
+    TEST_ASSERT_EQUAL( testqueueLENGTH, xQueueReceiveMultiple( xQueue, ulItems, testqueueLENGTH, 0 ) );
+    prvCheckItems( ulItems, testqueueLENGTH - 3, 3 );
+    prvCheckItems( &( ulItems[ testqueueLENGTH - 3 ] ), 3, 100 );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,345 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_spsc_ring.c
+ * @brief Tests for the single producer single consumer ring.
+ *
+ * Items are received in the order they were sent, also when the storage area
+ * wraps, and a full ring rejects items. A receiver blocked on an empty ring is
+ * woken by the producer, and a wake up callback is called once per arming of
+ * the wake up, however many items are sent.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+
+/**
+ * @brief Number of items the rings created by the tests can hold.
+ */
+#define testspscLENGTH             ( 5 )
+
+/**
+ * @brief Number of items passed by the producer task.
+ */
+#define testspscSTREAM_ITEMS       ( 2000 )
+
+/**
+ * @brief Time to wait for the producer task.
+ */
+#define testspscTIMEOUT            pdMS_TO_TICKS( 5000 )
+
+/**
+ * @brief Priority of the producer task, above the test task so it runs as
+ * soon as it is unblocked.
+ */
+#define testspscTASK_PRIORITY      ( configMAX_PRIORITIES - 1 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The ring used by the current test, and the statically allocated
+ * memory of the ring.
+ */
+static SPSCRingHandle_t xRing;
+static StaticSPSCRing_t xStaticRing;
+static void * pvStorage[ testspscLENGTH + 1 ];
+
+/**
+ * @brief The producer task of the current test.
+ */
+static TaskHandle_t xProducerTask;
+
+/**
+ * @brief Number of times the wake up callback was called, and whether it was
+ * last called from an interrupt.
+ */
+static volatile uint32_t ulWakeUps;
+static volatile BaseType_t xWakeUpFromISR;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sends the item 1 after a short delay.
+ */
+static void prvDelayedProducerTask( void * pvParameters );
+
+/**
+ * @brief Sends the items 1 to testspscSTREAM_ITEMS, waiting whenever the ring
+ * is full.
+ */
+static void prvStreamProducerTask( void * pvParameters );
+
+/**
+ * @brief Counts the wake ups.
+ */
+static void prvWakeUpCallback( SPSCRingHandle_t xWokenRing,
+                               BaseType_t * pxHigherPriorityTaskWoken );
+/*-----------------------------------------------------------*/
+
+static void prvDelayedProducerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vTaskDelay( pdMS_TO_TICKS( 20 ) );
+    ( void ) xSPSCRingSend( xRing, ( void * ) 1 );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamProducerTask( void * pvParameters )
+{
+    size_t xItem;
+
+    ( void ) pvParameters;
+
+    for( xItem = 1; xItem <= testspscSTREAM_ITEMS; xItem++ )
+    {
+        while( xSPSCRingSend( xRing, ( void * ) xItem ) == pdFAIL )
+        {
+            vTaskDelay( 1 );
+        }
+
+        /* Let the consumer run sometimes while the ring is not full. */
+        if( ( xItem % 7 ) == 0 )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeUpCallback( SPSCRingHandle_t xWokenRing,
+                               BaseType_t * pxHigherPriorityTaskWoken )
+{
+    TEST_ASSERT_EQUAL_PTR( xRing, xWokenRing );
+
+    xWakeUpFromISR = ( pxHigherPriorityTaskWoken != NULL ) ? pdTRUE : pdFALSE;
+    ulWakeUps++;
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_SPSC_Ring );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_SPSC_Ring )
+{
+    xProducerTask = NULL;
+    ulWakeUps = 0;
+    xWakeUpFromISR = pdFALSE;
+
+    xRing = xSPSCRingCreateStatic( testspscLENGTH, pvStorage, &xStaticRing );
+    TEST_ASSERT_NOT_NULL( xRing );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_SPSC_Ring )
+{
+    if( xProducerTask != NULL )
+    {
+        vTaskDelete( xProducerTask );
+    }
+
+    if( xRing != NULL )
+    {
+        vSPSCRingDelete( xRing );
+    }
+
+    /* A wake up may be left pending when the item was received without
+     * waiting. */
+    ( void ) xTaskNotifyStateClear( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_SPSC_Ring )
+{
+    RUN_TEST_CASE( Full_SPSC_Ring, SendAndReceive );
+    RUN_TEST_CASE( Full_SPSC_Ring, Wrap );
+    RUN_TEST_CASE( Full_SPSC_Ring, Timeout );
+    RUN_TEST_CASE( Full_SPSC_Ring, SendUnblocksReceiver );
+    RUN_TEST_CASE( Full_SPSC_Ring, Stream );
+    RUN_TEST_CASE( Full_SPSC_Ring, WakeUpCallback );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SPSC_Ring, SendAndReceive )
+{
+    void * pvItem;
+    size_t x;
+
+    TEST_ASSERT_EQUAL( 0, xSPSCRingItemsAvailable( xRing ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+
+    /* The ring holds exactly the number of items it was created for. */
+    for( x = 0; x < testspscLENGTH; x++ )
+    {
+        TEST_ASSERT_EQUAL( pdPASS, xSPSCRingSend( xRing, ( void * ) ( x + 1 ) ) );
+    }
+
+    TEST_ASSERT_EQUAL( testspscLENGTH, xSPSCRingItemsAvailable( xRing ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xSPSCRingSend( xRing, ( void * ) 100 ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xSPSCRingSendFromISR( xRing, ( void * ) 100, NULL ) );
+
+    /* The items are received oldest first. */
+    for( x = 0; x < testspscLENGTH; x++ )
+    {
+        TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+        TEST_ASSERT_EQUAL_PTR( ( void * ) ( x + 1 ), pvItem );
+    }
+
+    TEST_ASSERT_EQUAL( 0, xSPSCRingItemsAvailable( xRing ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SPSC_Ring, Wrap )
+{
+    void * pvItem;
+    size_t xFirst, x;
+
+    /* Use a dynamically allocated ring for this test. */
+    vSPSCRingDelete( xRing );
+    xRing = xSPSCRingCreate( testspscLENGTH );
+    TEST_ASSERT_NOT_NULL( xRing );
+
+    /* Batches of 3 in a ring of 5 wrap at a different place each time. */
+    for( xFirst = 1; xFirst < ( testspscLENGTH * 9 ); xFirst += 3 )
+    {
+        for( x = 0; x < 3; x++ )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xSPSCRingSend( xRing, ( void * ) ( xFirst + x ) ) );
+        }
+
+        TEST_ASSERT_EQUAL( 3, xSPSCRingItemsAvailable( xRing ) );
+
+        for( x = 0; x < 3; x++ )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+            TEST_ASSERT_EQUAL_PTR( ( void * ) ( xFirst + x ), pvItem );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SPSC_Ring, Timeout )
+{
+    void * pvItem;
+    TickType_t xStart;
+
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( pdFAIL, xSPSCRingReceive( xRing, &pvItem, pdMS_TO_TICKS( 20 ) ) );
+    TEST_ASSERT_TRUE( ( xTaskGetTickCount() - xStart ) >= pdMS_TO_TICKS( 20 ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SPSC_Ring, SendUnblocksReceiver )
+{
+    void * pvItem = NULL;
+    TickType_t xStart;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvDelayedProducerTask, "SPSCProd", configMINIMAL_STACK_SIZE * 4, NULL,
+                                            testspscTASK_PRIORITY, &xProducerTask ) );
+
+    /* The receiver is woken as soon as the item is sent, well before its block
+     * time expires. */
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, testspscTIMEOUT ) );
+    TEST_ASSERT_EQUAL_PTR( ( void * ) 1, pvItem );
+    TEST_ASSERT_TRUE( ( xTaskGetTickCount() - xStart ) < testspscTIMEOUT );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SPSC_Ring, Stream )
+{
+    void * pvItem;
+    size_t xItem;
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvStreamProducerTask, "SPSCProd", configMINIMAL_STACK_SIZE * 4, NULL,
+                                            testspscTASK_PRIORITY, &xProducerTask ) );
+
+    /* Every item arrives once, in order, whether the ring was full or empty
+     * when it was sent. */
+    for( xItem = 1; xItem <= testspscSTREAM_ITEMS; xItem++ )
+    {
+        TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, testspscTIMEOUT ) );
+        TEST_ASSERT_EQUAL_PTR( ( void * ) xItem, pvItem );
+    }
+
+    TEST_ASSERT_EQUAL( 0, xSPSCRingItemsAvailable( xRing ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_SPSC_Ring, WakeUpCallback )
+{
+    void * pvItem;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vSPSCRingSetWakeUpCallback( xRing, prvWakeUpCallback );
+
+    /* No wake up unless it was armed. */
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingSend( xRing, ( void * ) 1 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulWakeUps );
+
+    /* Arming reports that the ring is not empty. */
+    TEST_ASSERT_EQUAL( pdFALSE, xSPSCRingArmWakeUp( xRing ) );
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+
+    /* A single wake up for a number of items. */
+    TEST_ASSERT_EQUAL( pdTRUE, xSPSCRingArmWakeUp( xRing ) );
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingSend( xRing, ( void * ) 2 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingSend( xRing, ( void * ) 3 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulWakeUps );
+    TEST_ASSERT_FALSE( xWakeUpFromISR );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+    TEST_ASSERT_EQUAL_PTR( ( void * ) 2, pvItem );
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingReceive( xRing, &pvItem, 0 ) );
+    TEST_ASSERT_EQUAL_PTR( ( void * ) 3, pvItem );
+
+    /* The callback is told when it is called from an interrupt. */
+    TEST_ASSERT_EQUAL( pdTRUE, xSPSCRingArmWakeUp( xRing ) );
+    TEST_ASSERT_EQUAL( pdPASS, xSPSCRingSendFromISR( xRing, ( void * ) 4, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL_UINT32( 2, ulWakeUps );
+    TEST_ASSERT_TRUE( xWakeUpFromISR );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,425 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_stream_buffer_zero_copy.c
+ * @brief Tests for the zero copy stream buffer and message buffer API.
+ *
+ * Data written in place is read back with the copying API and the other way
+ * round, with the buffer positioned so the regions wrap, and the tasks
+ * blocked on a stream buffer are checked to be unblocked by a commit or a
+ * consume as they are by a send or a receive.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+/**
+ * @brief Size of the buffers created by the tests.
+ */
+#define testzerocopyBUFFER_SIZE       ( 32 )
+
+/**
+ * @brief Time to wait for the helper task.
+ */
+#define testzerocopyTIMEOUT           pdMS_TO_TICKS( 5000 )
+
+/**
+ * @brief Priority of the helper task, above the test task so it runs as soon
+ * as it is unblocked.
+ */
+#define testzerocopyTASK_PRIORITY     ( configMAX_PRIORITIES - 1 )
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The stream or message buffer used by the current test.
+ */
+static StreamBufferHandle_t xBuffer;
+
+/**
+ * @brief The helper task of the current test, and the test task.
+ */
+static TaskHandle_t xHelperTask;
+static TaskHandle_t xTestTask;
+
+/**
+ * @brief Number of bytes the helper task got from the stream buffer.
+ */
+static volatile size_t xHelperResult;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Writes ucFirst, ucFirst + 1, ... to the spans.
+ */
+static void prvFillSpans( const StreamBufferSpans_t * pxSpans,
+                          uint8_t ucFirst );
+
+/**
+ * @brief Checks that the spans hold ucFirst, ucFirst + 1, ...
+ */
+static void prvCheckSpans( const StreamBufferSpans_t * pxSpans,
+                           uint8_t ucFirst );
+
+/**
+ * @brief Moves the head and tail of the empty xBuffer to xOffset, so the
+ * next region written wraps sooner.
+ */
+static void prvMoveToOffset( size_t xOffset,
+                             size_t xBytesToStoreMessageLength );
+
+/**
+ * @brief Helper tasks that block in xStreamBufferPeekRead() and
+ * xStreamBufferAcquireWrite(), then record the result and notify the test
+ * task.
+ */
+static void prvPeekingTask( void * pvParameters );
+static void prvAcquiringTask( void * pvParameters );
+/*-----------------------------------------------------------*/
+
+static void prvFillSpans( const StreamBufferSpans_t * pxSpans,
+                          uint8_t ucFirst )
+{
+    size_t x;
+
+    for( x = 0; x < pxSpans->xFirstLength; x++ )
+    {
+        pxSpans->pucFirst[ x ] = ucFirst++;
+    }
+
+    for( x = 0; x < pxSpans->xSecondLength; x++ )
+    {
+        pxSpans->pucSecond[ x ] = ucFirst++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckSpans( const StreamBufferSpans_t * pxSpans,
+                           uint8_t ucFirst )
+{
+    size_t x;
+
+    for( x = 0; x < pxSpans->xFirstLength; x++ )
+    {
+        TEST_ASSERT_EQUAL_UINT8( ucFirst++, pxSpans->pucFirst[ x ] );
+    }
+
+    for( x = 0; x < pxSpans->xSecondLength; x++ )
+    {
+        TEST_ASSERT_EQUAL_UINT8( ucFirst++, pxSpans->pucSecond[ x ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMoveToOffset( size_t xOffset,
+                             size_t xBytesToStoreMessageLength )
+{
+    uint8_t ucScratch[ testzerocopyBUFFER_SIZE ];
+
+    memset( ucScratch, 0x00, sizeof( ucScratch ) );
+    TEST_ASSERT_EQUAL( xOffset - xBytesToStoreMessageLength,
+                       xStreamBufferSend( xBuffer, ucScratch, xOffset - xBytesToStoreMessageLength, 0 ) );
+    TEST_ASSERT_EQUAL( xOffset - xBytesToStoreMessageLength,
+                       xStreamBufferReceive( xBuffer, ucScratch, sizeof( ucScratch ), 0 ) );
+    TEST_ASSERT_TRUE( xStreamBufferIsEmpty( xBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeekingTask( void * pvParameters )
+{
+    StreamBufferSpans_t xSpans;
+
+    ( void ) pvParameters;
+
+    xHelperResult = xStreamBufferPeekRead( xBuffer, &xSpans, testzerocopyTIMEOUT );
+    xTaskNotifyGive( xTestTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAcquiringTask( void * pvParameters )
+{
+    StreamBufferSpans_t xSpans;
+
+    ( void ) pvParameters;
+
+    xHelperResult = xStreamBufferAcquireWrite( xBuffer, &xSpans, 8, testzerocopyTIMEOUT );
+    xTaskNotifyGive( xTestTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_StreamBuffer_ZeroCopy );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_StreamBuffer_ZeroCopy )
+{
+    xBuffer = NULL;
+    xHelperTask = NULL;
+    xHelperResult = 0;
+    xTestTask = xTaskGetCurrentTaskHandle();
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_StreamBuffer_ZeroCopy )
+{
+    if( xHelperTask != NULL )
+    {
+        vTaskDelete( xHelperTask );
+    }
+
+    if( xBuffer != NULL )
+    {
+        vStreamBufferDelete( xBuffer );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_StreamBuffer_ZeroCopy )
+{
+    RUN_TEST_CASE( Full_StreamBuffer_ZeroCopy, StreamWrap );
+    RUN_TEST_CASE( Full_StreamBuffer_ZeroCopy, StreamPartialCommitAndConsume );
+    RUN_TEST_CASE( Full_StreamBuffer_ZeroCopy, MessageWrap );
+    RUN_TEST_CASE( Full_StreamBuffer_ZeroCopy, MessageTooLarge );
+    RUN_TEST_CASE( Full_StreamBuffer_ZeroCopy, CommitUnblocksReader );
+    RUN_TEST_CASE( Full_StreamBuffer_ZeroCopy, ConsumeUnblocksWriter );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_StreamBuffer_ZeroCopy, StreamWrap )
+{
+    StreamBufferSpans_t xSpans;
+    uint8_t ucData[ testzerocopyBUFFER_SIZE ];
+    size_t x;
+
+    xBuffer = xStreamBufferCreate( testzerocopyBUFFER_SIZE, 1 );
+    TEST_ASSERT_NOT_NULL( xBuffer );
+    prvMoveToOffset( 20, 0 );
+
+    /* The storage area is one byte longer than the size of the buffer. */
+    TEST_ASSERT_EQUAL( testzerocopyBUFFER_SIZE, xStreamBufferAcquireWrite( xBuffer, &xSpans, 100, 0 ) );
+    TEST_ASSERT_EQUAL( testzerocopyBUFFER_SIZE + 1 - 20, xSpans.xFirstLength );
+    TEST_ASSERT_EQUAL( 19, xSpans.xSecondLength );
+
+    /* Write in place, read with a copy. */
+    TEST_ASSERT_EQUAL( 20, xStreamBufferAcquireWrite( xBuffer, &xSpans, 20, 0 ) );
+    TEST_ASSERT_EQUAL( 13, xSpans.xFirstLength );
+    TEST_ASSERT_EQUAL( 7, xSpans.xSecondLength );
+    prvFillSpans( &xSpans, 1 );
+    TEST_ASSERT_EQUAL( 20, xStreamBufferCommitWrite( xBuffer, 20 ) );
+    TEST_ASSERT_EQUAL( 20, xStreamBufferBytesAvailable( xBuffer ) );
+
+    TEST_ASSERT_EQUAL( 20, xStreamBufferReceive( xBuffer, ucData, sizeof( ucData ), 0 ) );
+
+    for( x = 0; x < 20; x++ )
+    {
+        TEST_ASSERT_EQUAL_UINT8( x + 1, ucData[ x ] );
+    }
+
+    /* Write with a copy, read in place. */
+    for( x = 0; x < 20; x++ )
+    {
+        ucData[ x ] = ( uint8_t ) ( x + 50 );
+    }
+
+    TEST_ASSERT_EQUAL( 20, xStreamBufferSend( xBuffer, ucData, 20, 0 ) );
+    TEST_ASSERT_EQUAL( 20, xStreamBufferPeekRead( xBuffer, &xSpans, 0 ) );
+    TEST_ASSERT_EQUAL( 20, xSpans.xFirstLength );
+    TEST_ASSERT_NULL( xSpans.pucSecond );
+    prvCheckSpans( &xSpans, 50 );
+    TEST_ASSERT_EQUAL( 20, xStreamBufferConsumeRead( xBuffer, 20 ) );
+    TEST_ASSERT_TRUE( xStreamBufferIsEmpty( xBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_StreamBuffer_ZeroCopy, StreamPartialCommitAndConsume )
+{
+    StreamBufferSpans_t xSpans;
+
+    xBuffer = xStreamBufferCreate( testzerocopyBUFFER_SIZE, 1 );
+    TEST_ASSERT_NOT_NULL( xBuffer );
+    prvMoveToOffset( 28, 0 );
+
+    /* Nothing is visible to the reader before the commit, and only the
+     * committed part of the reserved space afterwards. */
+    TEST_ASSERT_EQUAL( 10, xStreamBufferAcquireWrite( xBuffer, &xSpans, 10, 0 ) );
+    prvFillSpans( &xSpans, 100 );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferPeekRead( xBuffer, &xSpans, 0 ) );
+    TEST_ASSERT_EQUAL( 6, xStreamBufferCommitWrite( xBuffer, 6 ) );
+
+    TEST_ASSERT_EQUAL( 6, xStreamBufferPeekRead( xBuffer, &xSpans, 0 ) );
+    TEST_ASSERT_EQUAL( 5, xSpans.xFirstLength );
+    TEST_ASSERT_EQUAL( 1, xSpans.xSecondLength );
+    prvCheckSpans( &xSpans, 100 );
+
+    /* Consuming part of the data leaves the rest to the next peek. */
+    TEST_ASSERT_EQUAL( 5, xStreamBufferConsumeRead( xBuffer, 5 ) );
+    TEST_ASSERT_EQUAL( 1, xStreamBufferPeekRead( xBuffer, &xSpans, 0 ) );
+    prvCheckSpans( &xSpans, 105 );
+
+    /* No more than the bytes available can be consumed. */
+    TEST_ASSERT_EQUAL( 1, xStreamBufferConsumeRead( xBuffer, 100 ) );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferPeekRead( xBuffer, &xSpans, 0 ) );
+    TEST_ASSERT_NULL( xSpans.pucFirst );
+
+    /* Committing nothing releases the reserved space. */
+    TEST_ASSERT_EQUAL( 10, xStreamBufferAcquireWrite( xBuffer, &xSpans, 10, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferCommitWrite( xBuffer, 0 ) );
+    TEST_ASSERT_TRUE( xStreamBufferIsEmpty( xBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_StreamBuffer_ZeroCopy, MessageWrap )
+{
+    StreamBufferSpans_t xSpans;
+    uint8_t ucData[ testzerocopyBUFFER_SIZE ];
+    size_t xOffset, x;
+
+    /* Try every position of the message, including the ones where the length
+     * stored in front of the message wraps. */
+    for( xOffset = sizeof( size_t ) + 1; xOffset < testzerocopyBUFFER_SIZE; xOffset++ )
+    {
+        xBuffer = xMessageBufferCreate( testzerocopyBUFFER_SIZE );
+        TEST_ASSERT_NOT_NULL( xBuffer );
+        prvMoveToOffset( xOffset, sizeof( size_t ) );
+
+        /* Write in place, read with a copy. */
+        TEST_ASSERT_EQUAL( 12, xMessageBufferAcquireWrite( xBuffer, &xSpans, 12, 0 ) );
+        prvFillSpans( &xSpans, 1 );
+        TEST_ASSERT_EQUAL( 9, xMessageBufferCommitWrite( xBuffer, 9 ) );
+        TEST_ASSERT_EQUAL( 9, xMessageBufferReceive( xBuffer, ucData, sizeof( ucData ), 0 ) );
+
+        for( x = 0; x < 9; x++ )
+        {
+            TEST_ASSERT_EQUAL_UINT8( x + 1, ucData[ x ] );
+        }
+
+        /* Write with a copy, read in place. */
+        for( x = 0; x < 11; x++ )
+        {
+            ucData[ x ] = ( uint8_t ) ( x + 30 );
+        }
+
+        TEST_ASSERT_EQUAL( 11, xMessageBufferSend( xBuffer, ucData, 11, 0 ) );
+        TEST_ASSERT_EQUAL( 11, xMessageBufferPeekRead( xBuffer, &xSpans, 0 ) );
+        TEST_ASSERT_EQUAL( 11, xSpans.xFirstLength + xSpans.xSecondLength );
+        prvCheckSpans( &xSpans, 30 );
+        TEST_ASSERT_EQUAL( 11, xMessageBufferConsumeRead( xBuffer, 11 ) );
+        TEST_ASSERT_TRUE( xMessageBufferIsEmpty( xBuffer ) );
+
+        vMessageBufferDelete( xBuffer );
+        xBuffer = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_StreamBuffer_ZeroCopy, MessageTooLarge )
+{
+    StreamBufferSpans_t xSpans;
+    size_t xLargest = testzerocopyBUFFER_SIZE - sizeof( size_t );
+
+    xBuffer = xMessageBufferCreate( testzerocopyBUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xBuffer );
+
+    /* A message is reserved whole or not at all. */
+    TEST_ASSERT_EQUAL( 0, xMessageBufferAcquireWrite( xBuffer, &xSpans, xLargest + 1, 0 ) );
+    TEST_ASSERT_NULL( xSpans.pucFirst );
+    TEST_ASSERT_EQUAL( xLargest, xMessageBufferAcquireWrite( xBuffer, &xSpans, xLargest, 0 ) );
+    TEST_ASSERT_EQUAL( xLargest, xMessageBufferCommitWrite( xBuffer, xLargest ) );
+    TEST_ASSERT_TRUE( xMessageBufferIsFull( xBuffer ) );
+    TEST_ASSERT_EQUAL( 0, xMessageBufferAcquireWrite( xBuffer, &xSpans, 1, 0 ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_StreamBuffer_ZeroCopy, CommitUnblocksReader )
+{
+    StreamBufferSpans_t xSpans;
+
+    xBuffer = xStreamBufferCreate( testzerocopyBUFFER_SIZE, 4 );
+    TEST_ASSERT_NOT_NULL( xBuffer );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvPeekingTask, "ZCPeek", configMINIMAL_STACK_SIZE * 4, NULL,
+                                            testzerocopyTASK_PRIORITY, &xHelperTask ) );
+
+    /* On a multi-core build the reader runs on another core, so wait for it
+     * to block before any data is written. */
+    while( eTaskGetState( xHelperTask ) != eBlocked )
+    {
+        taskYIELD();
+    }
+
+    /* Below the trigger level the reader stays blocked. */
+    TEST_ASSERT_EQUAL( 3, xStreamBufferAcquireWrite( xBuffer, &xSpans, 3, 0 ) );
+    prvFillSpans( &xSpans, 0 );
+    xStreamBufferCommitWrite( xBuffer, 3 );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulTaskNotifyTake( pdTRUE, pdMS_TO_TICKS( 50 ) ) );
+
+    TEST_ASSERT_EQUAL( 2, xStreamBufferAcquireWrite( xBuffer, &xSpans, 2, 0 ) );
+    prvFillSpans( &xSpans, 3 );
+    xStreamBufferCommitWrite( xBuffer, 2 );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulTaskNotifyTake( pdTRUE, testzerocopyTIMEOUT ) );
+    TEST_ASSERT_EQUAL( 5, xHelperResult );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_StreamBuffer_ZeroCopy, ConsumeUnblocksWriter )
+{
+    StreamBufferSpans_t xSpans;
+
+    xBuffer = xStreamBufferCreate( testzerocopyBUFFER_SIZE, 1 );
+    TEST_ASSERT_NOT_NULL( xBuffer );
+    TEST_ASSERT_EQUAL( testzerocopyBUFFER_SIZE, xStreamBufferAcquireWrite( xBuffer, &xSpans, testzerocopyBUFFER_SIZE, 0 ) );
+    xStreamBufferCommitWrite( xBuffer, testzerocopyBUFFER_SIZE );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( prvAcquiringTask, "ZCAcq", configMINIMAL_STACK_SIZE * 4, NULL,
+                                            testzerocopyTASK_PRIORITY, &xHelperTask ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulTaskNotifyTake( pdTRUE, pdMS_TO_TICKS( 50 ) ) );
+
+    /* Consuming makes space, which unblocks the writer. */
+    TEST_ASSERT_EQUAL( testzerocopyBUFFER_SIZE, xStreamBufferPeekRead( xBuffer, &xSpans, 0 ) );
+    TEST_ASSERT_EQUAL( 8, xStreamBufferConsumeRead( xBuffer, 8 ) );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulTaskNotifyTake( pdTRUE, testzerocopyTIMEOUT ) );
+    TEST_ASSERT_EQUAL( 8, xHelperResult );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,361 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_delayed_tasks.c
+ * @brief Tests for the tasks that are delayed or blocked with a timeout.
+ *
+ * The tasks wake at the tick they are due whichever delayed task
+ * implementation is selected with configUSE_DELAYED_TASK_WHEEL. The delays
+ * used span several levels of the delayed task wheel, so tasks are cascaded
+ * before they wake, and some tasks leave the Blocked state before their
+ * timeout.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/**
+ * @brief Number of helper tasks used by the tests.
+ */
+#define testdelayedNUM_TASKS          ( 24 )
+
+/**
+ * @brief Priority of the helper tasks, above the test task so they block as
+ * soon as they are created and run as soon as they wake.
+ */
+#define testdelayedPRIORITY           ( tskIDLE_PRIORITY + 2 )
+
+/**
+ * @brief Stack size of the helper tasks.
+ */
+#define testdelayedSTACK_SIZE         ( configMINIMAL_STACK_SIZE * 4 )
+
+/**
+ * @brief Number of ticks a task may wake late on a loaded host before a test
+ * fails.
+ */
+#define testdelayedTOLERANCE          ( 20 )
+
+/**
+ * @brief A delay long enough that it never expires during a test.
+ */
+#define testdelayedLONG_DELAY         pdMS_TO_TICKS( 600000 )
+
+/**
+ * @brief The helper tasks, how long each one blocks for, when it started to
+ * block and when it woke, and the result of its queue receive.
+ */
+static TaskHandle_t xTasks[ testdelayedNUM_TASKS ];
+static TickType_t xDelays[ testdelayedNUM_TASKS ];
+static volatile TickType_t xBlockedAt[ testdelayedNUM_TASKS ];
+static volatile TickType_t xWokeAt[ testdelayedNUM_TASKS ];
+static volatile BaseType_t xReceived[ testdelayedNUM_TASKS ];
+
+/**
+ * @brief The test task, which the helper tasks notify when they wake.
+ */
+static TaskHandle_t xTestTask;
+
+/**
+ * @brief The queue the helper tasks of the QueueTimeout test block on.
+ */
+static QueueHandle_t xQueue;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Helper task that delays for xDelays[ index ]. The index is passed as
+ * the task parameter.
+ */
+static void prvDelayTask( void * pvParameters );
+
+/**
+ * @brief Helper task that waits on xQueue for up to xDelays[ index ].
+ */
+static void prvReceiveTask( void * pvParameters );
+
+/**
+ * @brief Creates helper task ulIndex, which on a single core blocks before
+ * this function returns as it has a higher priority than the test task.
+ */
+static void prvCreateTask( TaskFunction_t pxFunction,
+                           uint32_t ulIndex,
+                           TickType_t xDelay );
+
+/**
+ * @brief Waits until helper task ulIndex has blocked. On a multi-core build
+ * the helper runs on another core, so it may not have blocked when
+ * prvCreateTask() returns.
+ */
+static void prvWaitForBlocked( uint32_t ulIndex );
+
+/**
+ * @brief Waits until ulCount helper tasks have woken.
+ */
+static void prvWaitForTasks( uint32_t ulCount,
+                             TickType_t xTimeout );
+/*-----------------------------------------------------------*/
+
+static void prvDelayTask( void * pvParameters )
+{
+    uint32_t ulIndex = ( uint32_t ) ( size_t ) pvParameters;
+
+    xBlockedAt[ ulIndex ] = xTaskGetTickCount();
+    vTaskDelay( xDelays[ ulIndex ] );
+    xWokeAt[ ulIndex ] = xTaskGetTickCount();
+
+    xTasks[ ulIndex ] = NULL;
+    xTaskNotifyGive( xTestTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveTask( void * pvParameters )
+{
+    uint32_t ulIndex = ( uint32_t ) ( size_t ) pvParameters;
+    uint32_t ulItem;
+
+    xBlockedAt[ ulIndex ] = xTaskGetTickCount();
+    xReceived[ ulIndex ] = xQueueReceive( xQueue, &ulItem, xDelays[ ulIndex ] );
+    xWokeAt[ ulIndex ] = xTaskGetTickCount();
+
+    xTasks[ ulIndex ] = NULL;
+    xTaskNotifyGive( xTestTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateTask( TaskFunction_t pxFunction,
+                           uint32_t ulIndex,
+                           TickType_t xDelay )
+{
+    xDelays[ ulIndex ] = xDelay;
+    TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( pxFunction, "Delayed", testdelayedSTACK_SIZE, ( void * ) ( size_t ) ulIndex, testdelayedPRIORITY, &( xTasks[ ulIndex ] ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForBlocked( uint32_t ulIndex )
+{
+    while( eTaskGetState( xTasks[ ulIndex ] ) != eBlocked )
+    {
+        taskYIELD();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForTasks( uint32_t ulCount,
+                             TickType_t xTimeout )
+{
+    uint32_t ulWoken = 0;
+
+    while( ulWoken < ulCount )
+    {
+        if( ulTaskNotifyTake( pdFALSE, xTimeout ) == 0 )
+        {
+            break;
+        }
+
+        ulWoken++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32( ulCount, ulWoken );
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Delayed_Tasks );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Delayed_Tasks )
+{
+    memset( xTasks, 0x00, sizeof( xTasks ) );
+    memset( ( void * ) xBlockedAt, 0x00, sizeof( xBlockedAt ) );
+    memset( ( void * ) xWokeAt, 0x00, sizeof( xWokeAt ) );
+    memset( ( void * ) xReceived, 0x00, sizeof( xReceived ) );
+    xTestTask = xTaskGetCurrentTaskHandle();
+    ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+    xQueue = NULL;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Delayed_Tasks )
+{
+    uint32_t x;
+
+    for( x = 0; x < testdelayedNUM_TASKS; x++ )
+    {
+        if( xTasks[ x ] != NULL )
+        {
+            vTaskDelete( xTasks[ x ] );
+        }
+    }
+
+    if( xQueue != NULL )
+    {
+        vQueueDelete( xQueue );
+    }
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Delayed_Tasks )
+{
+    RUN_TEST_CASE( Full_Delayed_Tasks, WakeOnTime );
+    RUN_TEST_CASE( Full_Delayed_Tasks, StateAndAbortDelay );
+    RUN_TEST_CASE( Full_Delayed_Tasks, QueueTimeout );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Delayed_Tasks, WakeOnTime )
+{
+    uint32_t x;
+
+    /* Delays from 1 tick to about 1.5 seconds, in an order unrelated to the
+     * order in which the tasks wake. */
+    for( x = 0; x < testdelayedNUM_TASKS; x++ )
+    {
+        prvCreateTask( prvDelayTask, x, ( TickType_t ) ( ( ( x * 7U ) % testdelayedNUM_TASKS ) * 61U ) + 1U );
+    }
+
+    prvWaitForTasks( testdelayedNUM_TASKS, ( testdelayedNUM_TASKS * 61U ) + testdelayedTOLERANCE );
+
+    for( x = 0; x < testdelayedNUM_TASKS; x++ )
+    {
+        TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ x ] - xBlockedAt[ x ] ) >= xDelays[ x ] );
+        TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ x ] - xBlockedAt[ x ] ) <= ( xDelays[ x ] + testdelayedTOLERANCE ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Delayed_Tasks, StateAndAbortDelay )
+{
+    TaskStatus_t * pxStatus;
+    UBaseType_t uxCount, x;
+    uint32_t ulFound = 0;
+
+    /* One task that is about to wake, and two that are far from it. */
+    prvCreateTask( prvDelayTask, 0, testdelayedLONG_DELAY );
+    prvCreateTask( prvDelayTask, 1, pdMS_TO_TICKS( 100 ) );
+    prvCreateTask( prvDelayTask, 2, testdelayedLONG_DELAY );
+
+    for( x = 0; x < 3; x++ )
+    {
+        prvWaitForBlocked( x );
+    }
+
+    /* The delayed tasks are reported as Blocked. */
+    TEST_ASSERT_EQUAL( eBlocked, eTaskGetState( xTasks[ 0 ] ) );
+    TEST_ASSERT_EQUAL( eBlocked, eTaskGetState( xTasks[ 2 ] ) );
+    pxStatus = pvPortMalloc( uxTaskGetNumberOfTasks() * sizeof( TaskStatus_t ) );
+    TEST_ASSERT_NOT_NULL( pxStatus );
+    uxCount = uxTaskGetSystemState( pxStatus, uxTaskGetNumberOfTasks(), NULL );
+
+    for( x = 0; x < uxCount; x++ )
+    {
+        if( ( pxStatus[ x ].xHandle == xTasks[ 0 ] ) || ( pxStatus[ x ].xHandle == xTasks[ 1 ] ) || ( pxStatus[ x ].xHandle == xTasks[ 2 ] ) )
+        {
+            TEST_ASSERT_EQUAL( eBlocked, pxStatus[ x ].eCurrentState );
+            ulFound++;
+        }
+    }
+
+    vPortFree( pxStatus );
+    TEST_ASSERT_EQUAL_UINT32( 3, ulFound );
+
+    /* Aborting the delay of one long delay does not disturb the others. */
+    TEST_ASSERT_EQUAL( pdPASS, xTaskAbortDelay( xTasks[ 2 ] ) );
+    prvWaitForTasks( 1, testdelayedTOLERANCE );
+    TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ 2 ] - xBlockedAt[ 2 ] ) < pdMS_TO_TICKS( 100 ) );
+
+    prvWaitForTasks( 1, pdMS_TO_TICKS( 100 ) + testdelayedTOLERANCE );
+    TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ 1 ] - xBlockedAt[ 1 ] ) >= pdMS_TO_TICKS( 100 ) );
+    TEST_ASSERT_EQUAL( eBlocked, eTaskGetState( xTasks[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTaskAbortDelay( xTasks[ 0 ] ) );
+    prvWaitForTasks( 1, testdelayedTOLERANCE );
+    TEST_ASSERT_EQUAL( pdFAIL, xTaskAbortDelay( xTestTask ) );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Delayed_Tasks, QueueTimeout )
+{
+    uint32_t x, ulItem = 0;
+
+    xQueue = xQueueCreate( testdelayedNUM_TASKS, sizeof( uint32_t ) );
+    TEST_ASSERT_NOT_NULL( xQueue );
+
+    /* The tasks wait in priority order, then creation order, so the first
+     * half of the tasks receive the items sent before their timeouts, which
+     * are the longest. The other half time out. */
+    for( x = 0; x < testdelayedNUM_TASKS; x++ )
+    {
+        prvCreateTask( prvReceiveTask, x, ( x < ( testdelayedNUM_TASKS / 2 ) ) ? testdelayedLONG_DELAY : ( TickType_t ) ( ( x * 17U ) + 1U ) );
+
+        /* Keep the wait order. None of the timeouts expire meanwhile. */
+        prvWaitForBlocked( x );
+    }
+
+    for( x = 0; x < ( testdelayedNUM_TASKS / 2 ); x++ )
+    {
+        TEST_ASSERT_EQUAL( pdPASS, xQueueSend( xQueue, &ulItem, 0 ) );
+    }
+
+    prvWaitForTasks( testdelayedNUM_TASKS, ( testdelayedNUM_TASKS * 17U ) + testdelayedTOLERANCE );
+
+    for( x = 0; x < testdelayedNUM_TASKS; x++ )
+    {
+        if( x < ( testdelayedNUM_TASKS / 2 ) )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xReceived[ x ] );
+            TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ x ] - xBlockedAt[ x ] ) < xDelays[ x ] );
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL( pdFALSE, xReceived[ x ] );
+            TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ x ] - xBlockedAt[ x ] ) >= xDelays[ x ] );
+            TEST_ASSERT_TRUE( ( TickType_t ) ( xWokeAt[ x ] - xBlockedAt[ x ] ) <= ( xDelays[ x ] + testdelayedTOLERANCE ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
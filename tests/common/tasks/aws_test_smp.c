@@ -0,0 +1,380 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_smp.c
+ * @brief Tests for scheduling tasks on more than one core.
+ *
+ * The tests only run when configNUM_CORES is greater than 1. They check that
+ * one task of the highest priority runs on every core at the same time, that
+ * a task only runs on the cores its affinity mask allows, and that critical
+ * sections exclude the tasks running on the other cores.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configNUM_CORES > 1 )
+
+/**
+ * @brief Priority of the test task while the tests run, and of the helper
+ * tasks.
+ */
+    #define testsmpPRIORITY          ( tskIDLE_PRIORITY + 2 )
+
+/**
+ * @brief Stack size of the helper tasks.
+ */
+    #define testsmpSTACK_SIZE        ( configMINIMAL_STACK_SIZE * 4 )
+
+/**
+ * @brief Number of times each task increments the shared counter in the
+ * CriticalSection test.
+ */
+    #define testsmpINCREMENTS        ( 2000 )
+
+/**
+ * @brief Time to wait for the helper tasks.
+ */
+    #define testsmpTIMEOUT           pdMS_TO_TICKS( 10000 )
+
+/**
+ * @brief The helper tasks, one for every core other than the one running
+ * the test task.
+ */
+    static TaskHandle_t xTasks[ configNUM_CORES - 1 ];
+
+/**
+ * @brief The test task, which the helper tasks notify when they finish.
+ */
+    static TaskHandle_t xTestTask;
+
+/**
+ * @brief Priority of the test task before the tests changed it.
+ */
+    static UBaseType_t uxTestTaskPriority;
+
+/**
+ * @brief Number of tasks that are running the ParallelRun test, and set when
+ * they can stop.
+ */
+    static volatile UBaseType_t uxArrived;
+    static volatile BaseType_t xRelease;
+
+/**
+ * @brief Counter incremented by every task in the CriticalSection test.
+ */
+    static volatile uint32_t ulCounter;
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Helper task that waits, running, until all the tasks of the
+ * ParallelRun test are running.
+ */
+    static void prvSpinningTask( void * pvParameters );
+
+/**
+ * @brief Helper task that increments ulCounter in a critical section.
+ */
+    static void prvIncrementingTask( void * pvParameters );
+
+/**
+ * @brief Increments ulCounter testsmpINCREMENTS times, reading and writing
+ * it separately so that increments are lost unless the critical section
+ * holds the other cores off.
+ */
+    static void prvIncrement( void );
+
+/**
+ * @brief Returns pdTRUE if the calling task is running on core xCoreID.
+ */
+    static BaseType_t prvRunningOnCore( BaseType_t xCoreID );
+
+/**
+ * @brief Clears the helper task handle, notifies the test task and deletes
+ * the calling helper task.
+ */
+    static void prvFinish( uint32_t ulIndex );
+
+/**
+ * @brief Creates a helper task running pxFunction for every core other than
+ * the one running the test task.
+ */
+    static void prvCreateTasks( TaskFunction_t pxFunction );
+
+/**
+ * @brief Waits until all the helper tasks have finished.
+ */
+    static void prvWaitForTasks( void );
+/*-----------------------------------------------------------*/
+
+    static void prvSpinningTask( void * pvParameters )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxArrived++;
+        }
+        taskEXIT_CRITICAL();
+
+        while( xRelease == pdFALSE )
+        {
+        }
+
+        prvFinish( ( uint32_t ) ( size_t ) pvParameters );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvIncrementingTask( void * pvParameters )
+    {
+        prvIncrement();
+        prvFinish( ( uint32_t ) ( size_t ) pvParameters );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvIncrement( void )
+    {
+        uint32_t x, ulValue;
+
+        for( x = 0; x < testsmpINCREMENTS; x++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                ulValue = ulCounter;
+                ulCounter = ulValue + 1U;
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvRunningOnCore( BaseType_t xCoreID )
+    {
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = ( xTaskGetCurrentTaskHandleForCore( xCoreID ) == xTaskGetCurrentTaskHandle() ) ? pdTRUE : pdFALSE;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFinish( uint32_t ulIndex )
+    {
+        xTasks[ ulIndex ] = NULL;
+        xTaskNotifyGive( xTestTask );
+        vTaskDelete( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCreateTasks( TaskFunction_t pxFunction )
+    {
+        uint32_t x;
+
+        for( x = 0; x < ( configNUM_CORES - 1 ); x++ )
+        {
+            TEST_ASSERT_EQUAL( pdPASS, xTaskCreate( pxFunction, "SMP", testsmpSTACK_SIZE, ( void * ) ( size_t ) x, testsmpPRIORITY, &( xTasks[ x ] ) ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWaitForTasks( void )
+    {
+        uint32_t x;
+
+        for( x = 0; x < ( configNUM_CORES - 1 ); x++ )
+        {
+            TEST_ASSERT_NOT_EQUAL( 0, ulTaskNotifyTake( pdFALSE, testsmpTIMEOUT ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNUM_CORES > 1 */
+
+/* Define Test Group. */
+TEST_GROUP( Full_SMP );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_SMP )
+{
+    #if ( configNUM_CORES > 1 )
+        memset( xTasks, 0x00, sizeof( xTasks ) );
+        uxArrived = 0;
+        xRelease = pdFALSE;
+        ulCounter = 0;
+        xTestTask = xTaskGetCurrentTaskHandle();
+        ( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+        uxTestTaskPriority = uxTaskPriorityGet( NULL );
+        vTaskPrioritySet( NULL, testsmpPRIORITY );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_SMP )
+{
+    #if ( configNUM_CORES > 1 )
+        uint32_t x;
+
+        xRelease = pdTRUE;
+
+        for( x = 0; x < ( configNUM_CORES - 1 ); x++ )
+        {
+            if( xTasks[ x ] != NULL )
+            {
+                vTaskDelete( xTasks[ x ] );
+            }
+        }
+
+        vTaskCoreAffinitySet( NULL, tskNO_AFFINITY );
+        vTaskPrioritySet( NULL, uxTestTaskPriority );
+
+        /* Let the idle task free the deleted tasks. */
+        vTaskDelay( 2 );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_SMP )
+{
+    #if ( configNUM_CORES > 1 )
+        RUN_TEST_CASE( Full_SMP, ParallelRun );
+        RUN_TEST_CASE( Full_SMP, CoreAffinity );
+        RUN_TEST_CASE( Full_SMP, CriticalSection );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_CORES > 1 )
+
+    TEST( Full_SMP, ParallelRun )
+    {
+        BaseType_t xCoreID;
+        TaskHandle_t xRunning;
+        TickType_t xStart;
+        uint32_t x;
+        UBaseType_t uxParticipants = 0;
+
+        /* The test task and the helper tasks are the highest priority tasks,
+         * and there is one of them for every core. */
+        prvCreateTasks( prvSpinningTask );
+
+        taskENTER_CRITICAL();
+        {
+            uxArrived++;
+        }
+        taskEXIT_CRITICAL();
+
+        xStart = xTaskGetTickCount();
+
+        while( ( uxArrived < configNUM_CORES ) && ( ( xTaskGetTickCount() - xStart ) < testsmpTIMEOUT ) )
+        {
+        }
+
+        TEST_ASSERT_EQUAL( configNUM_CORES, uxArrived );
+
+        /* Every core is running one of them. */
+        taskENTER_CRITICAL();
+        {
+            for( xCoreID = 0; xCoreID < configNUM_CORES; xCoreID++ )
+            {
+                xRunning = xTaskGetCurrentTaskHandleForCore( xCoreID );
+
+                if( xRunning == xTestTask )
+                {
+                    uxParticipants++;
+                }
+
+                for( x = 0; x < ( configNUM_CORES - 1 ); x++ )
+                {
+                    if( xRunning == xTasks[ x ] )
+                    {
+                        uxParticipants++;
+                    }
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        xRelease = pdTRUE;
+        TEST_ASSERT_EQUAL( configNUM_CORES, uxParticipants );
+        prvWaitForTasks();
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_SMP, CoreAffinity )
+    {
+        BaseType_t xCoreID;
+        uint32_t x;
+
+        /* The test task moves to the only core it is allowed to run on as
+         * soon as its affinity is set, and stays there. */
+        for( xCoreID = configNUM_CORES - 1; xCoreID >= 0; xCoreID-- )
+        {
+            vTaskCoreAffinitySet( NULL, ( UBaseType_t ) 1U << xCoreID );
+            TEST_ASSERT_EQUAL( ( UBaseType_t ) 1U << xCoreID, uxTaskCoreAffinityGet( NULL ) );
+
+            for( x = 0; x < 10; x++ )
+            {
+                TEST_ASSERT_TRUE( prvRunningOnCore( xCoreID ) );
+                vTaskDelay( 1 );
+            }
+        }
+
+        vTaskCoreAffinitySet( NULL, tskNO_AFFINITY );
+        TEST_ASSERT_EQUAL( tskNO_AFFINITY, uxTaskCoreAffinityGet( NULL ) );
+    }
+/*-----------------------------------------------------------*/
+
+    TEST( Full_SMP, CriticalSection )
+    {
+        /* No increment is lost while every core increments the counter. */
+        prvCreateTasks( prvIncrementingTask );
+        prvIncrement();
+        prvWaitForTasks();
+
+        TEST_ASSERT_EQUAL_UINT32( configNUM_CORES * testsmpINCREMENTS, ulCounter );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNUM_CORES > 1 */
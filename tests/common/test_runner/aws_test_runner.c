@@ -87,6 +87,10 @@ static void RunTests( void )
         RUN_TEST_GROUP( Full_Shadow );
     #endif
 
+    #if ( testrunnerFULL_BUFFERPOOL_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_BufferPool );
+    #endif
+
     #if ( testrunnerFULL_MQTT_ENABLED == 1 )
         RUN_TEST_GROUP( Full_MQTT );
     #endif
@@ -99,6 +103,98 @@ static void RunTests( void )
         RUN_TEST_GROUP( Full_MQTT_Agent );
     #endif
 
+    #if ( testrunnerFULL_HEAP_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Heap_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_HEAP_STATS_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Heap_Stats );
+    #endif
+
+    #if ( testrunnerFULL_STREAM_BUFFER_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_StreamBuffer_ZeroCopy );
+    #endif
+
+    #if ( testrunnerFULL_TIMERS_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Timers );
+    #endif
+
+    #if ( testrunnerFULL_QUEUE_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Queue_Multiple );
+    #endif
+
+    #if ( testrunnerFULL_SPSC_RING_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_SPSC_Ring );
+    #endif
+
+    #if ( testrunnerFULL_DELAYED_TASKS_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Delayed_Tasks );
+    #endif
+
+    #if ( testrunnerFULL_SMP_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_SMP );
+    #endif
+
+    #if ( testrunnerFULL_SOCKET_LOOKUP_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Socket_Lookup );
+    #endif
+
+    #if ( testrunnerFULL_CHECKSUM_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Checksum );
+    #endif
+
+    #if ( testrunnerFULL_TCP_CONGESTION_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_TCP_Congestion );
+    #endif
+
+    #if ( testrunnerFULL_TCP_RX_WINDOW_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_TCP_Rx_Window );
+    #endif
+
+    #if ( testrunnerFULL_TCP_SACK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_TCP_Sack );
+    #endif
+
+    #if ( testrunnerFULL_TIMER_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Timer_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_KERNEL_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Kernel_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_DELAYED_TASK_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Delayed_Task_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_SMP_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_SMP_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_SOCKET_LOOKUP_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Socket_Lookup_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_CHECKSUM_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_Checksum_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_TCP_CONGESTION_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_TCP_Congestion_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_TCP_RX_WINDOW_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_TCP_Rx_Window_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_TCP_SACK_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_TCP_Sack_Benchmark );
+    #endif
+
+    #if ( testrunnerFULL_MQTT_BENCHMARK_ENABLED == 1 )
+        RUN_TEST_GROUP( Full_MQTT_Benchmark );
+    #endif
+
     #if ( testrunnerFULL_MQTT_ALPN_ENABLED == 1 )
         RUN_TEST_GROUP( Full_MQTT_Agent_ALPN );
     #endif
@@ -0,0 +1,243 @@
+/*
+ * Amazon FreeRTOS
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file aws_test_timers.c
+ * @brief Tests for the software timer service.
+ *
+ * The timers expire at the tick they are due whichever timer implementation
+ * is selected with configUSE_TIMER_WHEEL. The periods used span several
+ * levels of the timer wheel, so timers are cascaded before they expire.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Unity framework includes. */
+#include "unity_fixture.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/**
+ * @brief Number of timers used by the tests.
+ */
+#define testtimersNUM_TIMERS          ( 48 )
+
+/**
+ * @brief Number of ticks a timer callback may run late on a loaded host
+ * before a test fails.
+ */
+#define testtimersTOLERANCE           ( 20 )
+
+/**
+ * @brief The timers, and the tick count at which each one last expired.
+ */
+static TimerHandle_t xTimers[ testtimersNUM_TIMERS ];
+static volatile TickType_t xExpiredAt[ testtimersNUM_TIMERS ];
+static volatile uint32_t ulExpiredCount[ testtimersNUM_TIMERS ];
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Records when the timer expired. The index of the timer is its ID.
+ */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/**
+ * @brief Creates timer ulIndex.
+ */
+static void prvCreateTimer( uint32_t ulIndex,
+                            TickType_t xPeriod,
+                            UBaseType_t uxAutoReload );
+
+/**
+ * @brief Waits until the timer task has handled the commands sent so far,
+ * which it does in order, the last of which leaves xTimer active or not as
+ * given by xActive. On a multi-core build the timer task handles them on
+ * another core.
+ */
+static void prvWaitForCommands( TimerHandle_t xTimer,
+                                BaseType_t xActive );
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    uint32_t ulIndex = ( uint32_t ) ( size_t ) pvTimerGetTimerID( xTimer );
+
+    xExpiredAt[ ulIndex ] = xTaskGetTickCount();
+    ulExpiredCount[ ulIndex ]++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateTimer( uint32_t ulIndex,
+                            TickType_t xPeriod,
+                            UBaseType_t uxAutoReload )
+{
+    xTimers[ ulIndex ] = xTimerCreate( "Test", xPeriod, uxAutoReload, ( void * ) ( size_t ) ulIndex, prvTimerCallback );
+    TEST_ASSERT_NOT_NULL( xTimers[ ulIndex ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForCommands( TimerHandle_t xTimer,
+                                BaseType_t xActive )
+{
+    while( ( xTimerIsTimerActive( xTimer ) != pdFALSE ) != ( xActive != pdFALSE ) )
+    {
+        vTaskDelay( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Define Test Group. */
+TEST_GROUP( Full_Timers );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Setup function called before each test in this group is executed.
+ */
+TEST_SETUP( Full_Timers )
+{
+    memset( xTimers, 0x00, sizeof( xTimers ) );
+    memset( ( void * ) xExpiredAt, 0x00, sizeof( xExpiredAt ) );
+    memset( ( void * ) ulExpiredCount, 0x00, sizeof( ulExpiredCount ) );
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tear down function called after each test in this group is executed.
+ */
+TEST_TEAR_DOWN( Full_Timers )
+{
+    uint32_t x;
+
+    for( x = 0; x < testtimersNUM_TIMERS; x++ )
+    {
+        if( xTimers[ x ] != NULL )
+        {
+            ( void ) xTimerDelete( xTimers[ x ], portMAX_DELAY );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Function to define which tests to execute as part of this group.
+ */
+TEST_GROUP_RUNNER( Full_Timers )
+{
+    RUN_TEST_CASE( Full_Timers, ExpireOnTime );
+    RUN_TEST_CASE( Full_Timers, ResetAndStop );
+    RUN_TEST_CASE( Full_Timers, AutoReload );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Timers, ExpireOnTime )
+{
+    TickType_t xStart, xEnd, xPeriod;
+    uint32_t x;
+
+    /* Periods from 1 tick to about 1.5 seconds, in an order unrelated to the
+     * order in which the timers expire. */
+    for( x = 0; x < testtimersNUM_TIMERS; x++ )
+    {
+        xPeriod = ( TickType_t ) ( ( ( x * 37U ) % testtimersNUM_TIMERS ) * 31U ) + 1U;
+        prvCreateTimer( x, xPeriod, pdFALSE );
+    }
+
+    xStart = xTaskGetTickCount();
+
+    for( x = 0; x < testtimersNUM_TIMERS; x++ )
+    {
+        TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ x ], portMAX_DELAY ) );
+    }
+
+    xEnd = xTaskGetTickCount();
+    vTaskDelay( ( testtimersNUM_TIMERS * 31U ) + testtimersTOLERANCE );
+
+    for( x = 0; x < testtimersNUM_TIMERS; x++ )
+    {
+        xPeriod = xTimerGetPeriod( xTimers[ x ] );
+        TEST_ASSERT_EQUAL_UINT32( 1, ulExpiredCount[ x ] );
+        TEST_ASSERT_FALSE( xTimerIsTimerActive( xTimers[ x ] ) );
+        TEST_ASSERT_TRUE( ( TickType_t ) ( xExpiredAt[ x ] - xStart ) >= xPeriod );
+        TEST_ASSERT_TRUE( ( TickType_t ) ( xExpiredAt[ x ] - xStart ) <= ( ( TickType_t ) ( xEnd - xStart ) + xPeriod + testtimersTOLERANCE ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Timers, ResetAndStop )
+{
+    TickType_t xStart;
+
+    prvCreateTimer( 0, pdMS_TO_TICKS( 200 ), pdFALSE );
+    prvCreateTimer( 1, pdMS_TO_TICKS( 200 ), pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], portMAX_DELAY ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 1 ], portMAX_DELAY ) );
+    prvWaitForCommands( xTimers[ 1 ], pdTRUE );
+    TEST_ASSERT_TRUE( xTimerIsTimerActive( xTimers[ 0 ] ) );
+
+    /* Resetting a timer moves its expiry time, stopping it cancels it. */
+    vTaskDelay( pdMS_TO_TICKS( 100 ) );
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( pdPASS, xTimerReset( xTimers[ 0 ], portMAX_DELAY ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStop( xTimers[ 1 ], portMAX_DELAY ) );
+    prvWaitForCommands( xTimers[ 1 ], pdFALSE );
+    TEST_ASSERT_TRUE( ( TickType_t ) ( xTimerGetExpiryTime( xTimers[ 0 ] ) - xStart ) >= pdMS_TO_TICKS( 200 ) );
+    TEST_ASSERT_FALSE( xTimerIsTimerActive( xTimers[ 1 ] ) );
+
+    vTaskDelay( pdMS_TO_TICKS( 150 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulExpiredCount[ 0 ] );
+
+    vTaskDelay( pdMS_TO_TICKS( 50 ) + testtimersTOLERANCE );
+    TEST_ASSERT_EQUAL_UINT32( 1, ulExpiredCount[ 0 ] );
+    TEST_ASSERT_TRUE( ( TickType_t ) ( xExpiredAt[ 0 ] - xStart ) >= pdMS_TO_TICKS( 200 ) );
+    TEST_ASSERT_EQUAL_UINT32( 0, ulExpiredCount[ 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+TEST( Full_Timers, AutoReload )
+{
+    TickType_t xStart, xElapsed;
+    uint32_t ulCount;
+
+    /* A period that does not divide the number of slots of a wheel level. */
+    prvCreateTimer( 0, 7, pdTRUE );
+
+    xStart = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], portMAX_DELAY ) );
+    vTaskDelay( pdMS_TO_TICKS( 500 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStop( xTimers[ 0 ], portMAX_DELAY ) );
+    xElapsed = xTaskGetTickCount() - xStart;
+    ulCount = ulExpiredCount[ 0 ];
+
+    /* The period is measured from the expiry time, not from when the callback
+     * ran, so late callbacks do not make the timer drift. */
+    TEST_ASSERT_TRUE( ulCount <= ( xElapsed / 7U ) );
+    TEST_ASSERT_TRUE( ulCount >= ( ( xElapsed - testtimersTOLERANCE ) / 7U ) );
+}
+/*-----------------------------------------------------------*/
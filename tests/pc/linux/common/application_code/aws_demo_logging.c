@@ -0,0 +1,180 @@
+/*
+ * Amazon FreeRTOS V1.4.6
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/*
+ * Logging utility that allows FreeRTOS tasks to log to stdout in the POSIX
+ * simulator.
+ *
+ * A task can be switched out at any point by the simulated tick interrupt.  If
+ * that happens while the task holds a lock inside the C library (for example
+ * the stdio lock taken by printf()) any other task that needs the same lock
+ * would block its pthread forever.  Messages are therefore formatted into a
+ * local buffer and written with a single write() system call from within a
+ * critical section.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include "task.h"
+
+/* Demo includes. */
+#include "aws_demo_logging.h"
+
+/*-----------------------------------------------------------*/
+
+/* Dimensions the arrays into which print messages are created. */
+#define dlMAX_PRINT_STRING_LENGTH    255
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Write a complete message to stdout.
+ */
+static void prvLogToStdout( const char * pcMessage,
+                            size_t xLength );
+
+/*-----------------------------------------------------------*/
+
+/* Stores the selected logging target passed in as a parameter to the
+ * vLoggingInit() function. */
+BaseType_t xStdoutLoggingUsed = pdTRUE;
+
+/*-----------------------------------------------------------*/
+
+void vLoggingInit( BaseType_t xLogToStdout,
+                   BaseType_t xLogToFile,
+                   BaseType_t xLogToUDP,
+                   uint32_t ulRemoteIPAddress,
+                   uint16_t usRemotePort )
+{
+    /* Only stdout is supported in the POSIX simulator. */
+    ( void ) xLogToFile;
+    ( void ) xLogToUDP;
+    ( void ) ulRemoteIPAddress;
+    ( void ) usRemotePort;
+
+    xStdoutLoggingUsed = xLogToStdout;
+}
+/*-----------------------------------------------------------*/
+
+void vLoggingPrintf( const char * pcFormat,
+                     ... )
+{
+    char cPrintString[ dlMAX_PRINT_STRING_LENGTH ];
+    int iLength = 0;
+    int iLength2;
+    static uint32_t ulMessageNumber = 0;
+    va_list args;
+    const char * pcTaskName;
+    const char * pcNoTask = "None";
+
+    if( xStdoutLoggingUsed != pdFALSE )
+    {
+        /* Additional info to place at the start of the log. */
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            pcTaskName = pcTaskGetName( NULL );
+        }
+        else
+        {
+            pcTaskName = pcNoTask;
+        }
+
+        if( strcmp( pcFormat, "\n" ) != 0 )
+        {
+            iLength = snprintf( cPrintString, dlMAX_PRINT_STRING_LENGTH, "%lu %lu [%s] ",
+                                ( unsigned long ) ulMessageNumber++,
+                                ( unsigned long ) xTaskGetTickCount(),
+                                pcTaskName );
+        }
+
+        /* There are a variable number of parameters. */
+        va_start( args, pcFormat );
+        iLength2 = vsnprintf( cPrintString + iLength,
+                              dlMAX_PRINT_STRING_LENGTH - iLength,
+                              pcFormat,
+                              args );
+        va_end( args );
+
+        if( iLength2 < 0 )
+        {
+            iLength2 = 0;
+        }
+
+        iLength += iLength2;
+
+        if( iLength >= dlMAX_PRINT_STRING_LENGTH )
+        {
+            /* The message was truncated. */
+            iLength = dlMAX_PRINT_STRING_LENGTH - 1;
+        }
+
+        prvLogToStdout( cPrintString, ( size_t ) iLength );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vLoggingPrint( const char * pcMessage )
+{
+    if( xStdoutLoggingUsed != pdFALSE )
+    {
+        prvLogToStdout( pcMessage, strlen( pcMessage ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLogToStdout( const char * pcMessage,
+                            size_t xLength )
+{
+    ssize_t xWritten;
+
+    /* The write is not interrupted by a context switch so messages from
+     * different tasks are never interleaved. */
+    portENTER_CRITICAL();
+    {
+        while( xLength > 0 )
+        {
+            xWritten = write( STDOUT_FILENO, pcMessage, xLength );
+
+            if( xWritten <= 0 )
+            {
+                break;
+            }
+
+            pcMessage += xWritten;
+            xLength -= ( size_t ) xWritten;
+        }
+    }
+    portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
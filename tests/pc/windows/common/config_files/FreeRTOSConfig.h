@@ -62,6 +62,12 @@
 #define configUSE_ALTERNATIVE_API                  0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS    3      /* FreeRTOS+FAT requires 2 pointers if a CWD is supported. */
 #define configRECORD_STACK_HIGH_ADDRESS            1
+#define configUSE_DELAYED_TASK_WHEEL               1
+
+/* Heap instrumentation, used by the heap statistics tests. */
+#define configUSE_HEAP_STATS_PER_TASK              1
+#define configHEAP_STATS_MAX_TASKS                 32
+#define configHEAP_TRACE_BUFFER_LENGTH             256
 
 /* Hook function related definitions. */
 #define configUSE_TICK_HOOK                        0
@@ -74,6 +80,7 @@
 #define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH                   5
 #define configTIMER_TASK_STACK_DEPTH               ( configMINIMAL_STACK_SIZE * 2 )
+#define configUSE_TIMER_WHEEL                      1
 
 /* Event group related definitions. */
 #define configUSE_EVENT_GROUPS                     1
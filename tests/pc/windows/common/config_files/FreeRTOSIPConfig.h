@@ -197,6 +197,29 @@ extern uint32_t ulRand();
 #define ipconfigEVENT_QUEUE_LENGTH \
     ( ipconfigNUM_NETWORK_BUFFER_DESCRIPTORS + 5 )
 
+/* Pass received frames from the network interface to the IP stack through a
+ * lock-free SPSC ring instead of the event queue. */
+#define ipconfigUSE_NETWORK_RX_RING               1
+
+/* Find the socket that a received packet is for in hash tables instead of by
+ * searching the lists of bound sockets. */
+#define ipconfigUSE_SOCKET_HASH                   1
+
+/* Add up checksums with SSE2 or NEON where the compiler targets them, and
+ * checksum the payload of TCP packets while it is copied to and from the
+ * socket streams. */
+#define ipconfigCHECKSUM_BACKEND                  2
+#define ipconfigUSE_CHECKSUM_COPY                 1
+
+/* Limit the data in flight with a congestion window, grown and reduced by
+ * NewReno or CUBIC.  Sockets use NewReno unless FREERTOS_SO_TCP_CONGESTION
+ * selects CUBIC. */
+#define ipconfigUSE_TCP_CONGESTION_CONTROL        1
+
+/* Report up to four ranges of out-of-order data in each SACK, so that the
+ * peer learns about several missing ranges at once. */
+#define ipconfigTCP_SACK_BLOCKS                   4
+
 /* The address of a socket is the combination of its IP address and its port
  * number.  FreeRTOS_bind() is used to manually allocate a port number to a socket
  * (to 'bind' the socket to a port), but manual binding is not normally necessary
@@ -41,4 +41,16 @@
  */
 #define bufferpoolconfigBUFFER_SIZE    ( 2048 )
 
+/**
+ * @brief The number and size of the small buffers, used for control packets.
+ */
+#define bufferpoolconfigNUM_SMALL_BUFFERS     ( 8 )
+#define bufferpoolconfigSMALL_BUFFER_SIZE     ( 128 )
+
+/**
+ * @brief The number and size of the medium buffers.
+ */
+#define bufferpoolconfigNUM_MEDIUM_BUFFERS    ( 4 )
+#define bufferpoolconfigMEDIUM_BUFFER_SIZE    ( 512 )
+
 #endif /* _AWS_BUFFER_POOL_CONFIG_H_ */
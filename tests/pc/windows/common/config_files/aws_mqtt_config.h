@@ -60,4 +60,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #define mqttconfigENABLE_SUBSCRIPTION_MANAGEMENT    ( 1 )
 
+/**
+ * @brief Enable the zero-copy publish API.
+ *
+ * This lets the user publish a payload without it being copied into the MQTT buffers.
+ */
+#define mqttconfigENABLE_ZERO_COPY_PUBLISH          ( 1 )
+
+/**
+ * @brief Enable streaming delivery of received publish messages.
+ *
+ * This lets the user receive messages larger than the MQTT buffers.
+ */
+#define mqttconfigENABLE_STREAMING_PUBLISH          ( 1 )
+
 #endif /* _AWS_MQTT_CONFIG_H_ */
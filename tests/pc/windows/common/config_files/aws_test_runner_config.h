@@ -37,19 +37,43 @@
 
 
 /* Supported tests. 0 = Disabled, 1 = Enabled */
+#define testrunnerFULL_BUFFERPOOL_ENABLED          0
 #define testrunnerFULL_CBOR_ENABLED                0
 #define testrunnerFULL_CRYPTO_ENABLED              0
 #define testrunnerFULL_FREERTOS_TCP_ENABLED        0
 #define testrunnerFULL_DEFENDER_ENABLED            0
 #define testrunnerFULL_GGD_ENABLED                 0
 #define testrunnerFULL_GGD_HELPER_ENABLED          0
+#define testrunnerFULL_HEAP_BENCHMARK_ENABLED      0
+#define testrunnerFULL_HEAP_STATS_ENABLED          1
 #define testrunnerFULL_MQTT_AGENT_ENABLED          0
 #define testrunnerFULL_MQTT_ALPN_ENABLED           0
 #define testrunnerFULL_MQTT_ENABLED                0
+#define testrunnerFULL_MQTT_BENCHMARK_ENABLED      0
 #define testrunnerFULL_MQTT_STRESS_TEST_ENABLED    0
 #define testrunnerFULL_PKCS11_ENABLED              0
 #define testrunnerFULL_POSIX_ENABLED               0
 #define testrunnerFULL_SHADOW_ENABLED              0
+#define testrunnerFULL_STREAM_BUFFER_ENABLED       1
+#define testrunnerFULL_TIMERS_ENABLED              1
+#define testrunnerFULL_QUEUE_ENABLED               1
+#define testrunnerFULL_SPSC_RING_ENABLED           1
+#define testrunnerFULL_DELAYED_TASKS_ENABLED       1
+#define testrunnerFULL_SMP_ENABLED                 1
+#define testrunnerFULL_SOCKET_LOOKUP_ENABLED       1
+#define testrunnerFULL_CHECKSUM_ENABLED            1
+#define testrunnerFULL_TCP_CONGESTION_ENABLED      1
+#define testrunnerFULL_TCP_RX_WINDOW_ENABLED       1
+#define testrunnerFULL_TCP_SACK_ENABLED            1
+#define testrunnerFULL_TIMER_BENCHMARK_ENABLED     0
+#define testrunnerFULL_KERNEL_BENCHMARK_ENABLED    0
+#define testrunnerFULL_DELAYED_TASK_BENCHMARK_ENABLED 0
+#define testrunnerFULL_SMP_BENCHMARK_ENABLED       0
+#define testrunnerFULL_SOCKET_LOOKUP_BENCHMARK_ENABLED 0
+#define testrunnerFULL_CHECKSUM_BENCHMARK_ENABLED  0
+#define testrunnerFULL_TCP_CONGESTION_BENCHMARK_ENABLED 0
+#define testrunnerFULL_TCP_RX_WINDOW_BENCHMARK_ENABLED 0
+#define testrunnerFULL_TCP_SACK_BENCHMARK_ENABLED  0
 #define testrunnerFULL_TCP_ENABLED                 1
 #define testrunnerFULL_TLS_ENABLED                 0
 #define testrunnerFULL_MEMORYLEAK_ENABLED          0
@@ -0,0 +1,177 @@
+#!/usr/bin/python
+"""
+Decodes the heap trace ring buffer recorded by heap_4.c, heap_5.c and heap_6.c
+when configHEAP_TRACE_BUFFER_LENGTH is greater than 0.
+
+The input is a binary dump of the xHeapTraceBuffer variable, for example
+written by a debugger:
+
+    (gdb) dump binary value heap_trace.bin xHeapTraceBuffer
+
+or by the application from the buffer returned by pxPortGetHeapTraceBuffer().
+The byte order of the target is detected from the magic number at the start of
+the buffer.
+
+By default a summary of the events held in the buffer is printed: the number
+of allocations, frees and failed allocations made by each owner, the bytes
+still allocated at the end of the trace and the peak, and a histogram of the
+block sizes. The owner is the index of the task in the table returned by
+vPortGetHeapStatsPerTask(), or "-" if per task statistics are not enabled.
+
+--events lists every event instead, and --log writes the events in the format
+read by heap_trace_to_c.py so the trace can be replayed by the heap benchmark.
+The sizes recorded include the block header, so pass the size of the header of
+the heap that recorded the trace to heap_trace_to_c.py --header-bytes.
+"""
+
+import argparse
+import collections
+import struct
+import sys
+
+MAGIC = 0x43525448
+VERSION = 1
+HEADER_FORMAT = "IHHII"
+EVENT_FORMAT = "IIIHH"
+NO_OWNER = 0xFFFF
+
+EVENT_NAMES = {1: "malloc", 2: "free", 3: "failed"}
+
+Event = collections.namedtuple("Event", "timestamp address size owner kind")
+
+
+def parse(data):
+    """Returns the events held in the buffer, oldest first, and the number of
+    events that were recorded but have since been overwritten."""
+    header_size = struct.calcsize("<" + HEADER_FORMAT)
+    if len(data) < header_size:
+        raise ValueError("buffer too short")
+
+    for order in ("<", ">"):
+        magic, version, event_size, length, written = struct.unpack_from(order + HEADER_FORMAT, data)
+        if magic == MAGIC:
+            break
+    else:
+        raise ValueError("not a heap trace buffer (bad magic number)")
+
+    if version != VERSION:
+        raise ValueError("unsupported heap trace version %u" % version)
+    if event_size != struct.calcsize(order + EVENT_FORMAT):
+        raise ValueError("unexpected event size %u" % event_size)
+    if len(data) < header_size + (length * event_size):
+        raise ValueError("buffer truncated, %u events expected" % length)
+
+    count = min(written, length)
+    first = written % length if written > length else 0
+    events = []
+
+    for index in range(count):
+        offset = header_size + (((first + index) % length) * event_size)
+        events.append(Event(*struct.unpack_from(order + EVENT_FORMAT, data, offset)))
+
+    return events, written - count
+
+
+def owner_name(owner):
+    return "-" if owner == NO_OWNER else str(owner)
+
+
+def print_events(events, out):
+    out.write("%10s  %-6s  %10s  %8s  %s\n" % ("tick", "event", "address", "size", "owner"))
+    for event in events:
+        out.write("%10u  %-6s  0x%08x  %8u  %s\n" % (event.timestamp,
+                                                     EVENT_NAMES.get(event.kind, "?%u" % event.kind),
+                                                     event.address,
+                                                     event.size,
+                                                     owner_name(event.owner)))
+
+
+def print_log(events, out):
+    for event in events:
+        if event.kind == 1:
+            out.write("heap_trace,M,0x%08x,%u\n" % (event.address, event.size))
+        elif event.kind == 2:
+            out.write("heap_trace,F,0x%08x\n" % event.address)
+        else:
+            out.write("heap_trace,M,0,%u\n" % event.size)
+
+
+def print_summary(events, lost, out):
+    owners = collections.defaultdict(lambda: [0, 0, 0, 0])  # allocations, frees, failures, net bytes
+    histogram = collections.Counter()
+    live = {}
+    live_bytes = 0
+    peak_bytes = 0
+
+    for event in events:
+        totals = owners[event.owner]
+        if event.kind == 1:
+            totals[0] += 1
+            totals[3] += event.size
+            live[event.address] = event.size
+            live_bytes += event.size
+            peak_bytes = max(peak_bytes, live_bytes)
+            histogram[max(event.size - 1, 1).bit_length()] += 1
+        elif event.kind == 2:
+            totals[1] += 1
+            totals[3] -= event.size
+            # Blocks allocated before the oldest event are not counted.
+            if live.pop(event.address, None) is not None:
+                live_bytes -= event.size
+        else:
+            totals[2] += 1
+
+    if events:
+        out.write("%u events from tick %u to tick %u, %u older events overwritten\n\n"
+                  % (len(events), events[0].timestamp, events[-1].timestamp, lost))
+    else:
+        out.write("no events recorded\n")
+        return
+
+    out.write("%-6s  %8s  %8s  %8s  %10s\n" % ("owner", "mallocs", "frees", "failed", "net bytes"))
+    for owner in sorted(owners):
+        totals = owners[owner]
+        out.write("%-6s  %8u  %8u  %8u  %10d\n" % (owner_name(owner), totals[0], totals[1], totals[2], totals[3]))
+
+    out.write("\nblocks allocated during the trace and not freed: %u (%u bytes), peak %u bytes\n"
+              % (len(live), live_bytes, peak_bytes))
+
+    out.write("\nblock size histogram:\n")
+    for bits in sorted(histogram):
+        out.write("  <= %8u  %8u\n" % (1 << bits, histogram[bits]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("dump", help="binary dump of xHeapTraceBuffer")
+    parser.add_argument("-o", "--output", help="file to write (default stdout)")
+    group = parser.add_mutually_exclusive_group()
+    group.add_argument("--events", action="store_true", help="list every event")
+    group.add_argument("--log", action="store_true",
+                       help="write the events in the format read by heap_trace_to_c.py")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as dump:
+        data = dump.read()
+
+    try:
+        events, lost = parse(data)
+    except ValueError as error:
+        sys.stderr.write("%s: %s\n" % (args.dump, error))
+        sys.exit(1)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+
+    if args.events:
+        print_events(events, out)
+    elif args.log:
+        print_log(events, out)
+    else:
+        print_summary(events, lost, out)
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+#!/usr/bin/python
+"""
+Converts a heap allocation trace captured from a running device into the C
+table replayed by tests/common/benchmarks/aws_benchmark_heap.c.
+
+The trace is captured by defining the traceMALLOC() and traceFREE() hooks in
+FreeRTOSConfig.h so that every allocation and free is logged, for example:
+
+    #define traceMALLOC( pvAddress, uiSize ) \\
+        vLoggingPrintf( "heap_trace,M,%p,%u\\n", pvAddress, ( unsigned ) ( uiSize ) )
+    #define traceFREE( pvAddress, uiSize ) \\
+        vLoggingPrintf( "heap_trace,F,%p\\n", pvAddress )
+
+Capture with heap_3.c if possible, as the other heap implementations report
+the size of the block including its header rather than the requested size
+(use --header-bytes to compensate). Lines that do not contain a heap_trace
+record are ignored, so the whole console log can be passed in.
+
+The addresses are replaced with slot numbers, reusing the slots of freed
+blocks, so the table does not depend on where the heap was located.
+"""
+
+import argparse
+import re
+import sys
+
+RECORD = re.compile(r"heap_trace,([MF]),(?:0x)?([0-9a-fA-F]+|\(nil\))(?:,(\d+))?")
+
+
+def convert(lines, header_bytes, limit):
+    live = {}
+    free_slots = []
+    slot_count = 0
+    records = []
+
+    for line in lines:
+        match = RECORD.search(line)
+        if match is None:
+            continue
+
+        op, address, size = match.groups()
+
+        if address in ("(nil)", "0") or int(address, 16) == 0:
+            # Failed allocation or free( NULL ).
+            continue
+
+        if op == "M":
+            size = max(int(size) - header_bytes, 1)
+            if address in live:
+                sys.stderr.write("warning: %s allocated twice\n" % address)
+                continue
+            if free_slots:
+                slot = free_slots.pop()
+            else:
+                slot = slot_count
+                slot_count += 1
+            live[address] = slot
+            records.append((slot, size))
+        else:
+            slot = live.pop(address, None)
+            if slot is None:
+                # Allocated before the capture started.
+                continue
+            free_slots.append(slot)
+            records.append((slot, 0))
+
+        if limit and len(records) >= limit:
+            break
+
+    return records, slot_count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("log", help="console log containing heap_trace records")
+    parser.add_argument("-o", "--output", help="header to write (default stdout)")
+    parser.add_argument("--header-bytes", type=int, default=0,
+                        help="bytes to subtract from every traced size")
+    parser.add_argument("--limit", type=int, default=0,
+                        help="maximum number of records to convert")
+    parser.add_argument("--comment", default="",
+                        help="description of the trace to put in the header")
+    args = parser.parse_args()
+
+    with open(args.log) as log:
+        records, slot_count = convert(log, args.header_bytes, args.limit)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    out.write("/*\n * Heap allocation trace replayed by aws_benchmark_heap.c.\n *\n")
+    if args.comment:
+        out.write(" * %s\n *\n" % args.comment)
+    out.write(" * Generated by tools/heap_trace/heap_trace_to_c.py - do not edit.\n"
+              " * %u records, %u slots.\n */\n\n" % (len(records), slot_count))
+    out.write("#define benchmarkheapTRACE_SLOTS    ( %u )\n\n" % slot_count)
+    out.write("static const HeapTraceRecord_t xHeapTrace[] =\n{\n")
+    for index in range(0, len(records), 6):
+        chunk = records[index:index + 6]
+        out.write("    " + " ".join("{ %u, %u }," % record for record in chunk) + "\n")
+    out.write("};\n")
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()